@@ -45,6 +45,16 @@ vec2 screenPos = gl_FragCoord.xy - ViewPos;
 vec2 screencoord = screenPos * ScreenTextureSizeInverse;
 vec2 reftexcoord = screenPos * ScreenInverse;
 
+#ifdef opt_reflection_reproject
+  // the reflection texture may be from an earlier frame, project into its screen-space instead
+  uniform mat4 reflectionViewProj;
+
+  vec2 GetReflectionScreenCoord() {
+    vec4 reflClipPos = reflectionViewProj * vec4(worldPos, 1.0);
+    return (reflClipPos.xy / reflClipPos.w) * 0.5 + 0.5;
+  }
+#endif
+
 //////////////////////////////////////////////////
 // Depth conversion
 #ifdef opt_depth
@@ -224,6 +234,10 @@ vec3 GetReflection(float angle, vec3 normal, inout float fresnel)
 {
  	vec3 reflColor = vec3(0.0, 0.0, 0.0);
 #ifdef opt_reflection
+  #ifdef opt_reflection_reproject
+	reftexcoord = GetReflectionScreenCoord();
+  #endif
+
 	// we have to mirror the Y-axis
 	reftexcoord  = vec2(reftexcoord.x, 1.0 - reftexcoord.y);
 	reftexcoord += vec2(0.0, 3.0 * ScreenInverse.y) + normal.xz * 0.09 * ReflDistortion;
@@ -53,6 +53,7 @@
 // #define opt_shorewaves
 // #define opt_depth
 // #define opt_blurreflection
+// #define opt_reflection_reproject
 // #define opt_texrect
 // #define opt_endlessocean
 
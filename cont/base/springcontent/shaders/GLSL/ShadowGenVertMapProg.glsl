@@ -10,6 +10,7 @@ in vec3 vertexPos;
 uniform sampler2D heightMapTex;
 uniform float borderMinHeight;
 uniform ivec2 texSquare;
+uniform vec4 texSquareEdgeSpacing; // L,R,T,B; zero if unused
 uniform vec4 mapSize; // mapSize, 1.0/mapSize
 
 const float SMF_TEXSQR_SIZE = 1024.0;
@@ -25,8 +26,22 @@ float HeightAtWorldPos(vec2 wxz){
 	return textureLod(heightMapTex, uvhm, 0.0).x;
 }
 
+// collapses vertices on the patch edges onto the coarser vertex grid of a
+// neighbouring patch so both draw the same edge (see CBasicMeshDrawer)
+vec2 SnapPatchEdgeVertex(vec2 pxz) {
+	vec4 s = max(texSquareEdgeSpacing, vec4(1.0));
+
+	if (pxz.x == 0.0            ) pxz.y = floor(pxz.y / s.x) * s.x;
+	if (pxz.x == SMF_TEXSQR_SIZE) pxz.y = floor(pxz.y / s.y) * s.y;
+	if (pxz.y == 0.0            ) pxz.x = floor(pxz.x / s.z) * s.z;
+	if (pxz.y == SMF_TEXSQR_SIZE) pxz.x = floor(pxz.x / s.w) * s.w;
+
+	return pxz;
+}
+
 void main() {
 	vec4 vertexWorldPos = vec4(vertexPos, 1.0);
+	vertexWorldPos.xz = SnapPatchEdgeVertex(vertexWorldPos.xz);
 	vertexWorldPos.xz += vec2(texSquare) * SMF_TEXSQR_SIZE;
 	vertexWorldPos.y = mix(borderMinHeight, HeightAtWorldPos(vertexWorldPos.xz), float(vertexWorldPos.y == 0.0));
 	/*
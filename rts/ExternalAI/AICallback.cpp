@@ -51,6 +51,7 @@
 #include "ExternalAI/EngineOutHandler.h"
 #include "System/EventHandler.h"
 #include "System/Log/ILog.h"
+#include "System/Threading/ThreadPool.h"
 #include "Net/Protocol/NetProtocol.h"
 #include "System/FileSystem/FileHandler.h"
 #include "System/FileSystem/DataDirsAccess.h"
@@ -808,19 +809,19 @@ static int FilterUnitsVector(const std::vector<CUnit*>& units, int* unitIds, int
 }
 
 
-static int myAllyTeamId = -1;
+static thread_local int myAllyTeamId = -1;
 
-/// You have to set myAllyTeamId before calling this function. NOT thread safe!
+/// You have to set myAllyTeamId (per thread) before calling this function.
 static inline bool unit_IsEnemy(const CUnit* unit) {
 	return (!teamHandler.Ally(unit->allyteam, myAllyTeamId) && !unit->IsNeutral());
 }
 
-/// You have to set myAllyTeamId before calling this function. NOT thread safe!
+/// You have to set myAllyTeamId (per thread) before calling this function.
 static inline bool unit_IsFriendly(const CUnit* unit) {
 	return (teamHandler.Ally(unit->allyteam, myAllyTeamId) && !unit->IsNeutral());
 }
 
-/// You have to set myAllyTeamId before calling this function. NOT thread safe!
+/// You have to set myAllyTeamId (per thread) before calling this function.
 static inline bool unit_IsInSensor(const CUnit* unit, const unsigned short losFlags) {
 	// Skip in-sensor-range test if the unit is allied with our team.
 	// This prevents errors where an allied unit is starting to build,
@@ -829,22 +830,22 @@ static inline bool unit_IsInSensor(const CUnit* unit, const unsigned short losFl
 	return (teamHandler.Ally(myAllyTeamId, unit->allyteam) || ((unit->losStatus[myAllyTeamId] & losFlags) != 0));
 }
 
-/// You have to set myAllyTeamId before calling this function. NOT thread safe!
+/// You have to set myAllyTeamId (per thread) before calling this function.
 static inline bool unit_IsInLos(const CUnit* unit) {
 	return unit_IsInSensor(unit, LOS_INLOS);
 }
 
-/// You have to set myAllyTeamId before calling this function. NOT thread safe!
+/// You have to set myAllyTeamId (per thread) before calling this function.
 static inline bool unit_IsEnemyAndInLos(const CUnit* unit) {
 	return (unit_IsEnemy(unit) && unit_IsInLos(unit));
 }
 
-/// You have to set myAllyTeamId before calling this function. NOT thread safe!
+/// You have to set myAllyTeamId (per thread) before calling this function.
 static inline bool unit_IsEnemyAndInLosOrRadar(const CUnit* unit) {
 	return (unit_IsEnemy(unit) && ((unit->losStatus[myAllyTeamId] & (LOS_INLOS | LOS_INRADAR)) != 0));
 }
 
-/// You have to set myAllyTeamId before calling this function. NOT thread safe!
+/// You have to set myAllyTeamId (per thread) before calling this function.
 static inline bool unit_IsNeutralAndInLosOrRadar(const CUnit* unit) {
 	return (unit->IsNeutral() && (unit_IsInSensor(unit, LOS_INLOS | LOS_INRADAR)));
 }
@@ -868,6 +869,7 @@ int CAICallback::GetEnemyUnits(int* unitIds, const float3& pos, float radius, bo
 {
 	verify();
 	QuadFieldQuery qfQuery;
+	qfQuery.threadOwner = ThreadPool::GetThreadNum();
 	quadField.GetUnitsExact(qfQuery, pos, radius, spherical);
 	myAllyTeamId = teamHandler.AllyTeam(team);
 	return FilterUnitsVector(*qfQuery.units, unitIds, unitIds_max, &unit_IsEnemyAndInLos);
@@ -886,6 +888,7 @@ int CAICallback::GetFriendlyUnits(int* unitIds, const float3& pos, float radius,
 {
 	verify();
 	QuadFieldQuery qfQuery;
+	qfQuery.threadOwner = ThreadPool::GetThreadNum();
 	quadField.GetUnitsExact(qfQuery, pos, radius, spherical);
 	myAllyTeamId = teamHandler.AllyTeam(team);
 	return FilterUnitsVector(*qfQuery.units, unitIds, unitIds_max, &unit_IsFriendly);
@@ -904,6 +907,7 @@ int CAICallback::GetNeutralUnits(int* unitIds, const float3& pos, float radius,
 {
 	verify();
 	QuadFieldQuery qfQuery;
+	qfQuery.threadOwner = ThreadPool::GetThreadNum();
 	quadField.GetUnitsExact(qfQuery, pos, radius, spherical);
 	myAllyTeamId = teamHandler.AllyTeam(team);
 	return FilterUnitsVector(*qfQuery.units, unitIds, unitIds_max, &unit_IsNeutralAndInLosOrRadar);
@@ -973,16 +977,20 @@ const float* CAICallback::GetSlopeMap()
 
 const unsigned short* CAICallback::GetLosMap()
 {
+	losHandler->WaitForUpdate();
 	return &losHandler->los.losMaps[teamHandler.AllyTeam(team)].front();
 }
 
 const unsigned short* CAICallback::GetRadarMap()
 {
+	losHandler->WaitForUpdate();
 	return &losHandler->radar.losMaps[teamHandler.AllyTeam(team)].front();
 }
 
 const unsigned short* CAICallback::GetJammerMap()
 {
+	losHandler->WaitForUpdate();
+
 	const int jammerAllyTeam = modInfo.separateJammers ? teamHandler.AllyTeam(team) : 0;
 	return &losHandler->jammer.losMaps[jammerAllyTeam].front();
 }
@@ -1235,6 +1243,7 @@ int CAICallback::GetFeatures(int* featureIds, int maxFeatureIDs, const float3& p
 
 	verify();
 	QuadFieldQuery qfQuery;
+	qfQuery.threadOwner = ThreadPool::GetThreadNum();
 	quadField.GetFeaturesExact(qfQuery, pos, radius, spherical);
 	const int allyteam = teamHandler.AllyTeam(team);
 
@@ -19,9 +19,13 @@
 #include "Sim/Units/CommandAI/Command.h"
 #include "Sim/Weapons/WeaponDef.h"
 #include "Net/Protocol/NetProtocol.h"
+#include "System/Config/ConfigHandler.h"
 #include "System/Log/ILog.h"
 #include "System/TimeProfiler.h"
 #include "System/SafeUtil.h"
+#include "System/Threading/ThreadPool.h"
+
+CONFIG(bool, ThreadedSkirmishAIs).defaultValue(false).description("Deliver Skirmish AI events in batches at frame boundaries and run the AIs in parallel on worker threads. AIs receive events up to one frame later.");
 
 
 CR_BIND(CEngineOutHandler, )
@@ -29,6 +33,9 @@ CR_REG_METADATA(CEngineOutHandler, (
 	CR_IGNORED(hostSkirmishAIs),
 	CR_IGNORED(teamSkirmishAIs),
 	CR_IGNORED(activeSkirmishAIs),
+	CR_IGNORED(dispatchTasks),
+	CR_IGNORED(callbackMutex),
+	CR_IGNORED(threadedAIs),
 
 	CR_POSTLOAD(PostLoad)
 ))
@@ -75,6 +82,11 @@ void CEngineOutHandler::Destroy() {
 	numInstances -= 1;
 }
 
+void CEngineOutHandler::Init() {
+	activeSkirmishAIs.reserve(16);
+	threadedAIs = configHandler->GetBool("ThreadedSkirmishAIs");
+}
+
 
 // This macro should be inserted at the start of each method sending AI events
 #define AI_SCOPED_TIMER()           \
@@ -127,9 +139,41 @@ void CEngineOutHandler::Save(std::ostream* s, const uint8_t skirmishAIId) {
 
 void CEngineOutHandler::Update() {
 	AI_SCOPED_TIMER();
+
+	if (threadedAIs) {
+		DispatchEvents(true);
+		return;
+	}
+
 	DO_FOR_SKIRMISH_AIS(Update(gs->frameNum))
 }
 
+void CEngineOutHandler::FlushEvents() {
+	AI_SCOPED_TIMER();
+
+	if (!threadedAIs)
+		return;
+
+	DispatchEvents(false);
+}
+
+void CEngineOutHandler::DispatchEvents(bool update) {
+	const int frameNum = gs->frameNum;
+
+	dispatchTasks.clear();
+
+	for (uint8_t aiID: activeSkirmishAIs) {
+		dispatchTasks.push_back(ThreadPool::Enqueue([this, aiID, frameNum, update]() {
+			hostSkirmishAIs[aiID].DispatchEvents(frameNum, update);
+		}));
+	}
+
+	// also rethrows any exception an AI raised
+	for (auto& task: dispatchTasks) {
+		task.get();
+	}
+}
+
 
 
 // Do only if the unit is not allied, in which case we know
@@ -554,6 +598,9 @@ void CEngineOutHandler::CreateSkirmishAI(const uint8_t skirmishAIId, bool savedG
 	if (!savedGame)
 		aiInst.PostLoad();
 
+	// initial events above are delivered directly, later ones batched per frame
+	aiInst.SetThreaded(threadedAIs);
+
 	clientNet->Send(CBaseNetProtocol::Get().SendAIStateChanged(gu->myPlayerNum, skirmishAIId, SKIRMAISTATE_ALIVE));
 }
 
@@ -5,9 +5,11 @@
 
 #include "SkirmishAIWrapper.h"
 #include "System/Object.h"
+#include "System/Threading/SpringThreading.h"
 #include "Sim/Misc/GlobalConstants.h"
 
 #include <array>
+#include <future>
 #include <vector>
 #include <string>
 
@@ -31,7 +33,7 @@ public:
 	static void Create();
 	static void Destroy();
 
-	void Init() { activeSkirmishAIs.reserve(16); }
+	void Init();
 	void Kill() {
 		PreDestroy();
 
@@ -48,6 +50,12 @@ public:
 	void PreDestroy();
 
 	void Update();
+	/// delivers queued events without Update, for frames skipped while catching up
+	void FlushEvents();
+
+	bool IsThreaded() const { return threadedAIs; }
+	/// held by callbacks that change engine state while AIs run threaded
+	spring::recursive_mutex& GetCallbackMutex() { return callbackMutex; }
 
 	/** Group should return false if it doenst want the unit for some reason. */
 	bool UnitAddedToGroup(const CUnit& unit, const CGroup& group);
@@ -106,6 +114,9 @@ public:
 	void Load(std::istream* s, const uint8_t skirmishAIId);
 	void Save(std::ostream* s, const uint8_t skirmishAIId);
 
+private:
+	void DispatchEvents(bool update);
+
 private:
 	/// Contains all local Skirmish AIs, indexed by their ID
 	std::array<CSkirmishAIWrapper, MAX_AIS > hostSkirmishAIs;
@@ -117,6 +128,19 @@ private:
 	std::array<std::vector<uint8_t>, MAX_TEAMS> teamSkirmishAIs;
 
 	std::vector<uint8_t> activeSkirmishAIs;
+
+	std::vector<std::shared_future<void>> dispatchTasks;
+
+	spring::recursive_mutex callbackMutex;
+
+	/**
+	 * If true, AI events are queued during the frame and each AI handles
+	 * its queue plus Update on a worker thread at the next frame boundary.
+	 * The sim does not advance until all AIs are done, so they all read a
+	 * consistent (frozen) engine state; orders go out over the network as
+	 * usual and take effect in a later frame.
+	 */
+	bool threadedAIs = false;
 };
 
 #define eoh CEngineOutHandler::GetInstance()
@@ -10,6 +10,22 @@ extern "C" {
 #endif
 
 
+/**
+ * Fields that can be requested in bulk through getUnitFields.
+ * Each unit gets the requested fields written in the order of their bits,
+ * ids are stored as floats, positions and velocities take three slots.
+ */
+enum UnitField {
+	UNIT_FIELD_DEF            = 1 << 0, ///< 1 slot, unit-def id or -1
+	UNIT_FIELD_TEAM           = 1 << 1, ///< 1 slot, team id or -1
+	UNIT_FIELD_POS            = 1 << 2, ///< 3 slots
+	UNIT_FIELD_VEL            = 1 << 3, ///< 3 slots
+	UNIT_FIELD_HEALTH         = 1 << 4, ///< 1 slot, -1 if unknown
+	UNIT_FIELD_MAX_HEALTH     = 1 << 5, ///< 1 slot, -1 if unknown
+	UNIT_FIELD_BUILD_PROGRESS = 1 << 6, ///< 1 slot, -1 if unknown
+};
+
+
 /**
  * @brief Skirmish AI Callback function pointers.
  * Each Skirmish AI instance will receive an instance of this struct
@@ -2256,6 +2272,25 @@ struct SSkirmishAICallback {
 
 	bool              (CALLING_CONV *Debug_GraphDrawer_isEnabled)(int skirmishAIId);
 
+	/**
+	 * Fills fields with the values selected by fieldMask (see UnitField) for
+	 * each of the given units, unit after unit. Visibility is checked the same
+	 * way the single Unit_get* functions do it, but only once per call.
+	 *
+	 * @return the number of floats written per unit,
+	 *         or -1 if fields is too small to hold all of them
+	 */
+	int               (CALLING_CONV *getUnitFields)(int skirmishAIId, int* unitIds, int unitIds_size, int fieldMask, float* fields, int fields_sizeMax);
+
+	/**
+	 * Returns all units visible to this AI whose position, health, build
+	 * progress or team changed after the given frame, or which (re)appeared
+	 * since then. Change state is sampled at most once per frame, when this
+	 * is called, so the result may contain a few units too many, but never
+	 * misses one.
+	 */
+	int               (CALLING_CONV *getUnitsChangedSince)(int skirmishAIId, int frame, int* unitIds, int unitIds_sizeMax); //$ FETCHER:MULTI:IDs:Unit:unitIds
+
 };
 
 #if	defined(__cplusplus)
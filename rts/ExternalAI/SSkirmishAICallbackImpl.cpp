@@ -3,6 +3,7 @@
 #include "ExternalAI/AICallback.h"
 #include "ExternalAI/AICheats.h"
 #include "ExternalAI/AILibraryManager.h"
+#include "ExternalAI/EngineOutHandler.h"
 #include "ExternalAI/SSkirmishAICallbackImpl.h"
 #include "ExternalAI/SkirmishAILibraryInfo.h"
 #include "ExternalAI/SkirmishAIWrapper.h"
@@ -39,6 +40,7 @@
 #include "Sim/Misc/Resource.h"
 #include "Sim/Misc/ResourceHandler.h"
 #include "Sim/Misc/ResourceMapAnalyzer.h"
+#include "Sim/Misc/GlobalSynced.h"
 #include "Sim/Misc/LosHandler.h"
 #include "Sim/Misc/TeamHandler.h"
 #include "Sim/Misc/ModInfo.h"
@@ -56,6 +58,21 @@ static std::array<std::pair<bool, bool>, MAX_AIS> AI_CHEAT_FLAGS = {{{false, fal
 static std::array<int, MAX_AIS> AI_TEAM_IDS = {{-1}};
 
 
+// last state seen by getUnitsChangedSince, indexed by unit id
+struct UnitChangeRecord {
+	float3 pos;
+
+	float health = 0.0f;
+	float buildProgress = 0.0f;
+
+	int team = -1;
+	int changedFrame = -1;
+	int lastSeenFrame = -1;
+};
+
+static std::vector<UnitChangeRecord> AI_UNIT_CHANGE_RECORDS[MAX_AIS];
+static std::array<int, MAX_AIS> AI_UNIT_CHANGE_FRAMES = {{-1}};
+
 static std::vector<PointMarker> AI_TMP_POINT_MARKERS[MAX_AIS];
 static std::vector<LineMarker> AI_TMP_LINE_MARKERS[MAX_AIS];
 
@@ -65,6 +82,15 @@ static constexpr size_t MAX_NUM_MARKERS = 16384;
 static inline CAICallback* GetCallBack(int skirmishAIId) { return &AI_LEGACY_CALLBACKS[skirmishAIId].first; }
 static inline CAICheats* GetCheatCallBack(int skirmishAIId) { return &AI_LEGACY_CALLBACKS[skirmishAIId].second; }
 
+// serializes callbacks that change engine state or use shared scratch
+// memory, AIs may call them concurrently when run on worker threads
+static inline std::unique_lock<spring::recursive_mutex> LockEngineAccess() {
+	if (!eoh->IsThreaded())
+		return {};
+
+	return std::unique_lock<spring::recursive_mutex>(eoh->GetCallbackMutex());
+}
+
 
 static void CheckSkirmishAIId(int skirmishAIId, const char* caller) {
 	if (skirmishAIId >= 0 && skirmishAIId < MAX_AIS)
@@ -645,6 +671,8 @@ EXPORT(int) skirmishAiCallback_Engine_handleCommand(
 	int commandTopic,
 	void* commandData
 ) {
+	const auto lock = LockEngineAccess();
+
 	int ret = 0;
 
 	CAICallback* clb = GetCallBack(skirmishAIId);
@@ -1395,13 +1423,8 @@ EXPORT(bool) skirmishAiCallback_DataDirs_locatePath(
 EXPORT(const char*) skirmishAiCallback_DataDirs_getWriteableDir(int skirmishAIId) {
 	CheckSkirmishAIId(skirmishAIId, __func__);
 
-	static std::vector<std::string> writeableDataDirs;
-
-	// fill up writeableDataDirs until teamId index is in there
-	// if it is not yet
-	for (size_t wdd = writeableDataDirs.size(); wdd <= (size_t)skirmishAIId; ++wdd) {
-		writeableDataDirs.emplace_back("");
-	}
+	// fixed size, AIs running threaded may fill in their entries concurrently
+	static std::array<std::string, MAX_AIS> writeableDataDirs;
 
 	if (writeableDataDirs[skirmishAIId].empty()) {
 		char tmpRes[1024];
@@ -1856,6 +1879,7 @@ EXPORT(int) skirmishAiCallback_Map_get##name##Map(int skirmishAIId,	\
 	int sensor##ValuesSize = sensor##ValuesRealSize;	\
 \
 	if (sensor##Values != NULL) {	\
+		losHandler->WaitForUpdate();	\
 		int teamId = AI_TEAM_IDS[skirmishAIId];	\
 		const unsigned short* tmpMap = &losHandler->sensor.losMaps[teamHandler.AllyTeam(teamId)].front();	\
 		sensor##ValuesSize = std::min(sensor##ValuesRealSize, sensor##ValuesMaxSize);	\
@@ -2094,6 +2118,7 @@ EXPORT(int) skirmishAiCallback_Map_getSpeedModMap(
 
 
 EXPORT(bool) skirmishAiCallback_Map_isPossibleToBuildAt(int skirmishAIId, int unitDefId, float* pos_posF3, int facing) {
+	const auto lock = LockEngineAccess();
 	return GetCallBack(skirmishAIId)->CanBuildAt(getUnitDefById(skirmishAIId, unitDefId), pos_posF3, facing);
 }
 
@@ -2106,6 +2131,7 @@ EXPORT(void) skirmishAiCallback_Map_findClosestBuildSite(
 	int facing,
 	float* return_posF3_out
 ) {
+	const auto lock = LockEngineAccess();
 	const UnitDef* unitDef = getUnitDefById(skirmishAIId, unitDefId);
 	const float3 buildPos = GetCallBack(skirmishAIId)->ClosestBuildSite(unitDef, pos_posF3, searchRadius, minDist, facing);
 
@@ -3857,6 +3883,166 @@ EXPORT(int) skirmishAiCallback_getTeamUnits(int skirmishAIId, int* unitIds, int
 	return a;
 }
 
+EXPORT(int) skirmishAiCallback_getUnitFields(
+	int skirmishAIId,
+	int* unitIds,
+	int unitIds_size,
+	int fieldMask,
+	float* fields,
+	int fields_sizeMax
+) {
+	int stride = 0;
+
+	stride += ((fieldMask & UNIT_FIELD_DEF           ) != 0) * 1;
+	stride += ((fieldMask & UNIT_FIELD_TEAM          ) != 0) * 1;
+	stride += ((fieldMask & UNIT_FIELD_POS           ) != 0) * 3;
+	stride += ((fieldMask & UNIT_FIELD_VEL           ) != 0) * 3;
+	stride += ((fieldMask & UNIT_FIELD_HEALTH        ) != 0) * 1;
+	stride += ((fieldMask & UNIT_FIELD_MAX_HEALTH    ) != 0) * 1;
+	stride += ((fieldMask & UNIT_FIELD_BUILD_PROGRESS) != 0) * 1;
+
+	if ((stride * unitIds_size) > fields_sizeMax)
+		return -1;
+
+	// resolved once for the whole batch instead of once per unit and field
+	const bool cheating = skirmishAiCallback_Cheats_isEnabled(skirmishAIId);
+	const int allyTeam = teamHandler.AllyTeam(AI_TEAM_IDS[skirmishAIId]);
+
+	constexpr unsigned short prevMask = (LOS_PREVLOS | LOS_CONTRADAR);
+
+	for (int i = 0; i < unitIds_size; i++) {
+		const CUnit* unit = getUnit(unitIds[i]);
+		float* out = &fields[i * stride];
+
+		if (unit == nullptr) {
+			std::fill(out, out + stride, -1.0f);
+			continue;
+		}
+
+		const UnitDef* unitDef = unit->unitDef;
+		const UnitDef* shownDef = unitDef;
+
+		bool allied = cheating;
+		bool inLos = cheating;
+		bool inRadar = cheating;
+		bool knownDef = cheating;
+
+		if (!cheating) {
+			const unsigned short losStatus = unit->losStatus[allyTeam];
+
+			allied = teamHandler.Ally(unit->allyteam, allyTeam);
+			inLos = allied || ((losStatus & LOS_INLOS) != 0);
+			inRadar = inLos || ((losStatus & LOS_INRADAR) != 0);
+			knownDef = inLos || ((losStatus & prevMask) == prevMask);
+
+			if (!allied && unitDef->decoyDef != nullptr)
+				shownDef = unitDef->decoyDef;
+		}
+
+		// enemy decoys report health scaled to the def they pretend to be
+		const float healthScale = allied? 1.0f: (shownDef->health / unitDef->health);
+
+		if (fieldMask & UNIT_FIELD_DEF)
+			*(out++) = knownDef? shownDef->id: -1.0f;
+		if (fieldMask & UNIT_FIELD_TEAM)
+			*(out++) = inLos? unit->team: -1.0f;
+
+		if (fieldMask & UNIT_FIELD_POS) {
+			const float3 pos = cheating? unit->midPos: (inRadar? unit->GetErrorPos(allyTeam): ZeroVector);
+
+			*(out++) = pos.x;
+			*(out++) = pos.y;
+			*(out++) = pos.z;
+		}
+		if (fieldMask & UNIT_FIELD_VEL) {
+			const float3 vel = inRadar? unit->speed: ZeroVector;
+
+			*(out++) = vel.x;
+			*(out++) = vel.y;
+			*(out++) = vel.z;
+		}
+
+		if (fieldMask & UNIT_FIELD_HEALTH)
+			*(out++) = inLos? (unit->health * healthScale): -1.0f;
+		if (fieldMask & UNIT_FIELD_MAX_HEALTH)
+			*(out++) = inLos? (unit->maxHealth * healthScale): -1.0f;
+		if (fieldMask & UNIT_FIELD_BUILD_PROGRESS)
+			*(out++) = inLos? unit->buildProgress: -1.0f;
+	}
+
+	return stride;
+}
+
+static void UpdateUnitChangeRecords(int skirmishAIId) {
+	const int curFrame = gs->frameNum;
+	const int prvFrame = AI_UNIT_CHANGE_FRAMES[skirmishAIId];
+
+	if (prvFrame == curFrame)
+		return;
+
+	const bool cheating = skirmishAiCallback_Cheats_isEnabled(skirmishAIId);
+	const int allyTeam = teamHandler.AllyTeam(AI_TEAM_IDS[skirmishAIId]);
+
+	std::vector<UnitChangeRecord>& records = AI_UNIT_CHANGE_RECORDS[skirmishAIId];
+	records.resize(unitHandler.MaxUnits());
+
+	for (const CUnit* u: unitHandler.GetActiveUnits()) {
+		if (!cheating && !teamHandler.Ally(u->allyteam, allyTeam) && (u->losStatus[allyTeam] & (LOS_INLOS | LOS_INRADAR)) == 0)
+			continue;
+
+		UnitChangeRecord& rec = records[u->id];
+
+		const float3 pos = cheating? u->midPos: u->GetErrorPos(allyTeam);
+
+		bool changed = (rec.lastSeenFrame != prvFrame);
+
+		changed |= (rec.pos != pos);
+		changed |= (rec.health != u->health);
+		changed |= (rec.buildProgress != u->buildProgress);
+		changed |= (rec.team != u->team);
+
+		rec.pos = pos;
+		rec.health = u->health;
+		rec.buildProgress = u->buildProgress;
+		rec.team = u->team;
+		rec.lastSeenFrame = curFrame;
+
+		if (changed)
+			rec.changedFrame = curFrame;
+	}
+
+	AI_UNIT_CHANGE_FRAMES[skirmishAIId] = curFrame;
+}
+
+EXPORT(int) skirmishAiCallback_getUnitsChangedSince(int skirmishAIId, int frame, int* unitIds, int unitIdsMaxSize) {
+	UpdateUnitChangeRecords(skirmishAIId);
+
+	const std::vector<UnitChangeRecord>& records = AI_UNIT_CHANGE_RECORDS[skirmishAIId];
+	const int curFrame = AI_UNIT_CHANGE_FRAMES[skirmishAIId];
+
+	int a = 0;
+
+	for (const CUnit* u: unitHandler.GetActiveUnits()) {
+		const UnitChangeRecord& rec = records[u->id];
+
+		// not visible during the last refresh
+		if (rec.lastSeenFrame != curFrame)
+			continue;
+		if (rec.changedFrame <= frame)
+			continue;
+
+		if (a >= unitIdsMaxSize)
+			break;
+
+		if (unitIds != nullptr)
+			unitIds[a] = u->id;
+
+		a++;
+	}
+
+	return a;
+}
+
 
 //########### BEGIN Team
 EXPORT(bool) skirmishAiCallback_Team_hasAIController(int skirmishAIId, int teamId) {
@@ -5525,6 +5711,8 @@ static void skirmishAiCallback_init(SSkirmishAICallback* callback) {
 	callback->Unit_Weapon_isShieldEnabled = &skirmishAiCallback_Unit_Weapon_isShieldEnabled;
 	callback->Unit_Weapon_getShieldPower = &skirmishAiCallback_Unit_Weapon_getShieldPower;
 	callback->Debug_GraphDrawer_isEnabled = &skirmishAiCallback_Debug_GraphDrawer_isEnabled;
+	callback->getUnitFields = &skirmishAiCallback_getUnitFields;
+	callback->getUnitsChangedSince = &skirmishAiCallback_getUnitsChangedSince;
 }
 
 SSkirmishAICallback* skirmishAiCallback_GetInstance(CSkirmishAIWrapper* ai)
@@ -5534,6 +5722,7 @@ SSkirmishAICallback* skirmishAiCallback_GetInstance(CSkirmishAIWrapper* ai)
 
 	AI_CHEAT_FLAGS[ai->GetSkirmishAIID()] = {false, false};
 	AI_TEAM_IDS[ai->GetSkirmishAIID()] = ai->GetTeamId();
+	AI_UNIT_CHANGE_FRAMES[ai->GetSkirmishAIID()] = -1;
 
 	skirmishAiCallback_init(&AI_CALLBACK_WRAPPERS[ai->GetSkirmishAIID()]);
 
@@ -5546,6 +5735,9 @@ void skirmishAiCallback_Release(const CSkirmishAIWrapper* ai) {
 
 	AI_CHEAT_FLAGS[ai->GetSkirmishAIID()] = {false, false};
 	AI_TEAM_IDS[ai->GetSkirmishAIID()] = -1;
+
+	AI_UNIT_CHANGE_RECORDS[ai->GetSkirmishAIID()].clear();
+	AI_UNIT_CHANGE_FRAMES[ai->GetSkirmishAIID()] = -1;
 }
 
 void skirmishAiCallback_BlockOrders(const CSkirmishAIWrapper* ai)
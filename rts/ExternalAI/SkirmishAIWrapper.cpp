@@ -51,6 +51,11 @@ CR_REG_METADATA(CSkirmishAIWrapper, (
 
 	CR_MEMBER(cheatEvents),
 	CR_MEMBER(blockEvents),
+	CR_IGNORED(threaded),
+
+	CR_IGNORED(eventQueue),
+	CR_IGNORED(dispatchQueue),
+	CR_IGNORED(eventQueueMutex),
 
 	CR_SERIALIZER(Serialize),
 	CR_POSTLOAD(PostLoad)
@@ -74,6 +79,7 @@ void CSkirmishAIWrapper::PreInit(int aiID)
 
 		cheatEvents = false;
 		blockEvents = false;
+		threaded = false;
 	}
 	{
 		const std::string& kn = key.GetShortName();
@@ -159,6 +165,10 @@ void CSkirmishAIWrapper::Kill()
 		AILibraryManager::GetInstance()->ReleaseSkirmishAILibrary(key);
 	}
 
+	{
+		std::lock_guard<spring::mutex> lock(eventQueueMutex);
+		eventQueue.clear();
+	}
 	{
 		skirmishAiCallback_Release(this);
 	}
@@ -305,21 +315,41 @@ void CSkirmishAIWrapper::Save(std::ostream* saveStream)
 
 
 void CSkirmishAIWrapper::UnitIdle(int unitId) {
+	if (DeferEvents()) {
+		QueueEvent([=, this]() { UnitIdle(unitId); });
+		return;
+	}
+
 	const SUnitIdleEvent evtData = {unitId};
 	HandleEvent(EVENT_UNIT_IDLE, &evtData);
 }
 
 void CSkirmishAIWrapper::UnitCreated(int unitId, int builderId) {
+	if (DeferEvents()) {
+		QueueEvent([=, this]() { UnitCreated(unitId, builderId); });
+		return;
+	}
+
 	const SUnitCreatedEvent evtData = {unitId, builderId};
 	HandleEvent(EVENT_UNIT_CREATED, &evtData);
 }
 
 void CSkirmishAIWrapper::UnitFinished(int unitId) {
+	if (DeferEvents()) {
+		QueueEvent([=, this]() { UnitFinished(unitId); });
+		return;
+	}
+
 	const SUnitFinishedEvent evtData = {unitId};
 	HandleEvent(EVENT_UNIT_FINISHED, &evtData);
 }
 
 void CSkirmishAIWrapper::UnitDestroyed(int unitId, int attackerUnitId, int weaponDefID) {
+	if (DeferEvents()) {
+		QueueEvent([=, this]() { UnitDestroyed(unitId, attackerUnitId, weaponDefID); });
+		return;
+	}
+
 	const SUnitDestroyedEvent evtData = {unitId, attackerUnitId, weaponDefID};
 	HandleEvent(EVENT_UNIT_DESTROYED, &evtData);
 }
@@ -332,6 +362,11 @@ void CSkirmishAIWrapper::UnitDamaged(
 	int weaponDefId,
 	bool paralyzer
 ) {
+	if (DeferEvents()) {
+		QueueEvent([=, this]() { UnitDamaged(unitId, attackerUnitId, damage, dir, weaponDefId, paralyzer); });
+		return;
+	}
+
 	float3 cpyDir = dir;
 	const SUnitDamagedEvent evtData = {unitId, attackerUnitId, damage, &cpyDir[0], weaponDefId, paralyzer};
 
@@ -339,52 +374,102 @@ void CSkirmishAIWrapper::UnitDamaged(
 }
 
 void CSkirmishAIWrapper::UnitMoveFailed(int unitId) {
+	if (DeferEvents()) {
+		QueueEvent([=, this]() { UnitMoveFailed(unitId); });
+		return;
+	}
+
 	const SUnitMoveFailedEvent evtData = {unitId};
 	HandleEvent(EVENT_UNIT_MOVE_FAILED, &evtData);
 }
 
 void CSkirmishAIWrapper::UnitGiven(int unitId, int oldTeam, int newTeam) {
+	if (DeferEvents()) {
+		QueueEvent([=, this]() { UnitGiven(unitId, oldTeam, newTeam); });
+		return;
+	}
+
 	const SUnitGivenEvent evtData = {unitId, oldTeam, newTeam};
 	HandleEvent(EVENT_UNIT_GIVEN, &evtData);
 }
 
 void CSkirmishAIWrapper::UnitCaptured(int unitId, int oldTeam, int newTeam) {
+	if (DeferEvents()) {
+		QueueEvent([=, this]() { UnitCaptured(unitId, oldTeam, newTeam); });
+		return;
+	}
+
 	const SUnitCapturedEvent evtData = {unitId, oldTeam, newTeam};
 	HandleEvent(EVENT_UNIT_CAPTURED, &evtData);
 }
 
 
 void CSkirmishAIWrapper::EnemyCreated(int unitId) {
+	if (DeferEvents()) {
+		QueueEvent([=, this]() { EnemyCreated(unitId); });
+		return;
+	}
+
 	const SEnemyCreatedEvent evtData = {unitId};
 	HandleEvent(EVENT_ENEMY_CREATED, &evtData);
 }
 
 void CSkirmishAIWrapper::EnemyFinished(int unitId) {
+	if (DeferEvents()) {
+		QueueEvent([=, this]() { EnemyFinished(unitId); });
+		return;
+	}
+
 	const SEnemyFinishedEvent evtData = {unitId};
 	HandleEvent(EVENT_ENEMY_FINISHED, &evtData);
 }
 
 void CSkirmishAIWrapper::EnemyEnterLOS(int unitId) {
+	if (DeferEvents()) {
+		QueueEvent([=, this]() { EnemyEnterLOS(unitId); });
+		return;
+	}
+
 	const SEnemyEnterLOSEvent evtData = {unitId};
 	HandleEvent(EVENT_ENEMY_ENTER_LOS, &evtData);
 }
 
 void CSkirmishAIWrapper::EnemyLeaveLOS(int unitId) {
+	if (DeferEvents()) {
+		QueueEvent([=, this]() { EnemyLeaveLOS(unitId); });
+		return;
+	}
+
 	const SEnemyLeaveLOSEvent evtData = {unitId};
 	HandleEvent(EVENT_ENEMY_LEAVE_LOS, &evtData);
 }
 
 void CSkirmishAIWrapper::EnemyEnterRadar(int unitId) {
+	if (DeferEvents()) {
+		QueueEvent([=, this]() { EnemyEnterRadar(unitId); });
+		return;
+	}
+
 	const SEnemyEnterRadarEvent evtData = {unitId};
 	HandleEvent(EVENT_ENEMY_ENTER_RADAR, &evtData);
 }
 
 void CSkirmishAIWrapper::EnemyLeaveRadar(int unitId) {
+	if (DeferEvents()) {
+		QueueEvent([=, this]() { EnemyLeaveRadar(unitId); });
+		return;
+	}
+
 	const SEnemyLeaveRadarEvent evtData = {unitId};
 	HandleEvent(EVENT_ENEMY_LEAVE_RADAR, &evtData);
 }
 
 void CSkirmishAIWrapper::EnemyDestroyed(int enemyUnitId, int attackerUnitId) {
+	if (DeferEvents()) {
+		QueueEvent([=, this]() { EnemyDestroyed(enemyUnitId, attackerUnitId); });
+		return;
+	}
+
 	const SEnemyDestroyedEvent evtData = {enemyUnitId, attackerUnitId};
 	HandleEvent(EVENT_ENEMY_DESTROYED, &evtData);
 }
@@ -397,6 +482,11 @@ void CSkirmishAIWrapper::EnemyDamaged(
 	int weaponDefId,
 	bool paralyzer
 ) {
+	if (DeferEvents()) {
+		QueueEvent([=, this]() { EnemyDamaged(enemyUnitId, attackerUnitId, damage, dir, weaponDefId, paralyzer); });
+		return;
+	}
+
 	float3 cpyDir = dir;
 	const SEnemyDamagedEvent evtData = {enemyUnitId, attackerUnitId, damage, &cpyDir[0], weaponDefId, paralyzer};
 
@@ -404,11 +494,21 @@ void CSkirmishAIWrapper::EnemyDamaged(
 }
 
 void CSkirmishAIWrapper::Update(int frame) {
+	if (DeferEvents()) {
+		QueueEvent([=, this]() { Update(frame); });
+		return;
+	}
+
 	const SUpdateEvent evtData = {frame};
 	HandleEvent(EVENT_UPDATE, &evtData);
 }
 
 void CSkirmishAIWrapper::SendChatMessage(const char* msg, int fromPlayerId) {
+	if (DeferEvents()) {
+		QueueEvent([this, str = std::string(msg), fromPlayerId]() { SendChatMessage(str.c_str(), fromPlayerId); });
+		return;
+	}
+
 	const SMessageEvent evtData = {fromPlayerId, msg};
 	HandleEvent(EVENT_MESSAGE, &evtData);
 }
@@ -419,6 +519,11 @@ void CSkirmishAIWrapper::SendLuaMessage(const char* inData, const char** outData
 }
 
 void CSkirmishAIWrapper::WeaponFired(int unitId, int weaponDefId) {
+	if (DeferEvents()) {
+		QueueEvent([=, this]() { WeaponFired(unitId, weaponDefId); });
+		return;
+	}
+
 	const SWeaponFiredEvent evtData = {unitId, weaponDefId};
 	HandleEvent(EVENT_WEAPON_FIRED, &evtData);
 }
@@ -428,6 +533,11 @@ void CSkirmishAIWrapper::PlayerCommandGiven(
 	const Command& c,
 	int playerId
 ) {
+	if (DeferEvents()) {
+		QueueEvent([=, this]() { PlayerCommandGiven(playerSelectedUnits, c, playerId); });
+		return;
+	}
+
 	std::vector<int> unitIds = playerSelectedUnits;
 
 	const int cCommandId = extractAICommandTopic(&c, unitHandler.MaxUnits());
@@ -437,6 +547,11 @@ void CSkirmishAIWrapper::PlayerCommandGiven(
 }
 
 void CSkirmishAIWrapper::CommandFinished(int unitId, int commandId, int commandTopicId) {
+	if (DeferEvents()) {
+		QueueEvent([=, this]() { CommandFinished(unitId, commandId, commandTopicId); });
+		return;
+	}
+
 	const SCommandFinishedEvent evtData = {unitId, commandId, commandTopicId};
 	HandleEvent(EVENT_COMMAND_FINISHED, &evtData);
 }
@@ -447,6 +562,11 @@ void CSkirmishAIWrapper::SeismicPing(
 	const float3& pos,
 	float strength
 ) {
+	if (DeferEvents()) {
+		QueueEvent([=, this]() { SeismicPing(allyTeam, unitId, pos, strength); });
+		return;
+	}
+
 	/*const*/ float3 cpyPos = pos;
 	const SSeismicPingEvent evtData = {&cpyPos[0], strength};
 
@@ -454,13 +574,45 @@ void CSkirmishAIWrapper::SeismicPing(
 }
 
 
+void CSkirmishAIWrapper::QueueEvent(std::function<void()>&& event) {
+	std::lock_guard<spring::mutex> lock(eventQueueMutex);
+	eventQueue.emplace_back(std::move(event));
+}
+
+void CSkirmishAIWrapper::DispatchEvents(int frame, bool update) {
+	{
+		std::lock_guard<spring::mutex> lock(eventQueueMutex);
+		std::swap(eventQueue, dispatchQueue);
+	}
+
+	// events raised for us while dispatching (e.g. by cheat commands) are handled directly
+	dispatchingAI = this;
+
+	for (const auto& event: dispatchQueue) {
+		event();
+	}
+
+	dispatchQueue.clear();
+
+	if (update)
+		Update(frame);
+
+	dispatchingAI = nullptr;
+}
+
+
 int CSkirmishAIWrapper::HandleEvent(int topic, const void* data) const {
-	ScopedTimer timer(GetTimerNameHash());
+	// to prevent log error spam, signal: OK
+	if (blockEvents && (topic != EVENT_RELEASE))
+		return 0;
 
-	if (!blockEvents || (topic == EVENT_RELEASE))
+	// the regular timers are not thread-safe
+	if (dispatchingAI == this) {
+		ScopedMtTimer timer(GetTimerNameHash());
 		return library->HandleEvent(skirmishAIId, topic, data);
+	}
 
-	// to prevent log error spam, signal: OK
-	return 0;
+	ScopedTimer timer(GetTimerNameHash());
+	return library->HandleEvent(skirmishAIId, topic, data);
 }
 
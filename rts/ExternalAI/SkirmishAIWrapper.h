@@ -4,6 +4,10 @@
 #define SKIRMISH_AI_WRAPPER_H
 
 #include "SkirmishAIKey.h"
+#include "System/Threading/SpringThreading.h"
+
+#include <functional>
+#include <vector>
 
 class CSkirmishAILibrary;
 struct SSkirmishAICallback;
@@ -72,12 +76,21 @@ public:
 	void EnemyDamaged(int enemyUnitId, int attackerUnitId, float damage, const float3& dir, int weaponDefId, bool paralyzer);
 	void Update(int frame);
 	void SendChatMessage(const char* msg, int fromPlayerId);
+	/// synchronous in both modes, the caller needs the answer
 	void SendLuaMessage(const char* inData, const char** outData);
 	void WeaponFired(int unitId, int weaponDefId);
 	void PlayerCommandGiven(const std::vector<int>& selectedUnits, const Command& c, int playerId);
 	void CommandFinished(int unitId, int commandId, int commandTopicId);
 	void SeismicPing(int allyTeam, int unitId, const float3& pos, float strength);
 
+	/**
+	 * Threaded mode: events are not handed to the AI when raised but queued
+	 * (with copies of their arguments) and delivered, followed by Update if
+	 * requested, by this method at the next frame boundary. May be called on
+	 * a worker thread, concurrently with other AIs' DispatchEvents.
+	 */
+	void DispatchEvents(int frame, bool update);
+
 	int GetSkirmishAIID() const { return skirmishAIId; }
 	int GetTeamId() const { return teamId; }
 
@@ -92,6 +105,7 @@ public:
 	 */
 	void SetBlockEvents(bool enable) { blockEvents = enable; }
 	void SetCheatEvents(bool enable) { cheatEvents = enable; }
+	void SetThreaded(bool enable) { threaded = enable; }
 
 	bool CheatEventsEnabled() const { return cheatEvents; }
 
@@ -106,6 +120,10 @@ private:
 	void SendInitEvent(bool savedGame);
 	void SendUnitEvents();
 
+	/// true if events raised now have to be queued rather than handled
+	bool DeferEvents() const { return (threaded && dispatchingAI != this); }
+	void QueueEvent(std::function<void()>&& event);
+
 	/**
 	 * CAUTION: takes C AI Interface events, not engine C++ ones!
 	 */
@@ -134,6 +152,15 @@ private:
 	bool libraryInit = false; // CSkirmishAILibrary::Init retval
 	bool cheatEvents = false;
 	bool blockEvents = false;
+	bool threaded = false;
+
+	std::vector<std::function<void()>> eventQueue;
+	std::vector<std::function<void()>> dispatchQueue;
+
+	spring::mutex eventQueueMutex;
+
+	// AI whose events the calling thread is delivering, if any
+	static inline thread_local const CSkirmishAIWrapper* dispatchingAI = nullptr;
 };
 
 #endif // SKIRMISH_AI_WRAPPER_H
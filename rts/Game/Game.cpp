@@ -5,6 +5,7 @@
 #include <Rml/Backends/RmlUi_Backend.h>
 #include <RmlUi/Core.h>
 #include "Game.h"
+#include "GameVersion.h"
 #include "Camera.h"
 #include "CameraHandler.h"
 #include "ChatMessage.h"
@@ -14,7 +15,9 @@
 #include "GameSetup.h"
 #include "GlobalUnsynced.h"
 #include "LoadScreen.h"
+#include "LoadStageGraph.h"
 #include "SelectedUnitsHandler.h"
+#include "SimBenchmark.h"
 #include "WaitCommandsAI.h"
 #include "WordCompletion.h"
 #include "IVideoCapturing.h"
@@ -45,12 +48,14 @@
 #include "Rendering/HUDDrawer.h"
 #include "Rendering/IconHandler.h"
 #include "Rendering/ModelsDataUploader.h"
+#include "Rendering/Screenshot.h"
 #include "Rendering/ShadowHandler.h"
 #include "Rendering/TeamHighlight.h"
 #include "Rendering/Units/UnitDrawer.h"
 #include "Rendering/UniformConstants.h"
 #include "Rendering/Map/InfoTexture/IInfoTextureHandler.h"
 #include "Rendering/Textures/NamedTextures.h"
+#include "Lua/LuaAllocState.h"
 #include "Lua/LuaGaia.h"
 #include "Lua/LuaHandle.h"
 #include "Lua/LuaInputReceiver.h"
@@ -119,7 +124,11 @@
 #include "System/SafeUtil.h"
 #include "System/SpringExitCode.h"
 #include "System/SpringMath.h"
+#include "System/FileSystem/ArchiveScanner.h"
+#include "System/FileSystem/DataDirsAccess.h"
+#include "System/FileSystem/FileQueryFlags.h"
 #include "System/FileSystem/FileSystem.h"
+#include "System/FileSystem/VFSHandler.h"
 #include "System/LoadSave/LoadSaveHandler.h"
 #include "System/LoadSave/DemoRecorder.h"
 #include "System/Log/ILog.h"
@@ -130,8 +139,14 @@
 #include "System/Sound/ISoundChannels.h"
 #include "System/Sync/DumpState.h"
 #include "System/TimeProfiler.h"
+#include "System/FrameArena.h"
+#include "System/FrameTelemetry.h"
+#include "System/MemPoolStats.h"
+#include "System/Threading/ThreadPool.h"
 #include "System/LoadLock.h"
+#include "lib/lua/include/LuaUser.h" // spring_lua_alloc_get_stats
 
+#include "System/Net/Connection.h"
 #include "System/Misc/TracyDefs.h"
 
 
@@ -147,6 +162,14 @@ CONFIG(int, ShowPlayerInfo).defaultValue(1).headlessValue(0);
 CONFIG(float, GuiOpacity).defaultValue(0.8f).minimumValue(0.0f).maximumValue(1.0f).description("Sets the opacity of the built-in Spring UI. Generally has no effect on LuaUI widgets. Can be set in-game using shift+, to decrease and shift+. to increase.");
 CONFIG(std::string, InputTextGeo).defaultValue("");
 
+CONFIG(bool, DefsCache).defaultValue(true).description("Cache the gamedata definition tables on disk, such that restarting or rejoining a game with the same game version and setup skips running gamedata/defs.lua.");
+
+CONFIG(bool, OverlapLoadStages).defaultValue(true).description("Run independent game loading stages (e.g. gamedata definitions and the map) concurrently.");
+
+CONFIG(int, DemoKeyframeInterval).defaultValue(0).minimumValue(0).description("Write a savegame next to the demo being recorded every N minutes of game time, such that a long game can be resumed from near any point. 0 = off.");
+
+CONFIG(float, TelemetryLagDumpThreshold).defaultValue(0.0f).minimumValue(0.0f).description("Dump the frame-telemetry ring to the telemetry/ directory whenever a sim frame takes longer than this many milliseconds (at most once per minute). 0 = off.");
+
 CONFIG(int, SmoothTimeOffset).defaultValue(0).headlessValue(0).description("Enables frametimeoffset smoothing, 0 = off (old version), -1 = forced 0.5,  1-20 smooth, recommended = 2-3");
 
 CGame* game = nullptr;
@@ -200,16 +223,21 @@ CR_REG_METADATA(CGame, (
 	CR_IGNORED(skipStartFrame),
 	CR_IGNORED(skipEndFrame),
 	CR_IGNORED(skipTotalFrames),
+	CR_IGNORED(skipProgressStep),
 	CR_IGNORED(skipSeconds),
 	CR_IGNORED(skipSoundmute),
-	CR_IGNORED(skipOldSpeed),
-	CR_IGNORED(skipOldUserSpeed),
 */
 
 	CR_MEMBER(speedControl),
 	CR_MEMBER(luaGCControl),
 
 	CR_IGNORED(jobDispatcher),
+	CR_IGNORED(simFrameStages),
+	CR_IGNORED(telemetry),
+	CR_IGNORED(telemetryNetBytesIn),
+	CR_IGNORED(telemetryNetBytesOut),
+	CR_IGNORED(telemetryLagThreshold),
+	CR_IGNORED(telemetryLagDumpTime),
 	CR_IGNORED(worldDrawer),
 	CR_IGNORED(saveFileHandler),
 	CR_IGNORED(gameInputReceiver),
@@ -246,6 +274,13 @@ CGame::CGame(const std::string& mapFileName, const std::string& modFileName, ILo
 	showSpeed = configHandler->GetBool("ShowSpeed");
 
 	speedControl = configHandler->GetInt("SpeedControl");
+	demoKeyframeInterval = configHandler->GetInt("DemoKeyframeInterval") * 60 * GAME_SPEED;
+	telemetryLagThreshold = configHandler->GetFloat("TelemetryLagDumpThreshold");
+
+	telemetry.SetCounterName(0, "units");
+	telemetry.SetCounterName(1, "projectiles");
+	telemetry.SetCounterName(2, "pathUpdates");
+	telemetry.SetCounterName(3, "luaKB");
 
 	playerRoster.SetSortTypeByCode((PlayerRoster::SortType)configHandler->GetInt("ShowPlayerInfo"));
 
@@ -337,6 +372,8 @@ void CGame::AddTimedJobs()
 
 		j.f = []() -> bool {
 			CTimeProfiler::GetInstance().Update();
+			MemPoolRegistry::Update();
+			ThreadPool::UpdateLoadStats();
 			return true;
 		};
 
@@ -348,6 +385,66 @@ void CGame::AddTimedJobs()
 	}
 }
 
+void CGame::AddSimFrameStages()
+{
+	RECOIL_DETAILED_TRACY_ZONE;
+
+	// subsystems touched by the stages; anything that may trigger
+	// (synced) Lua callins or damage can touch everything instead
+	enum : CTaskGraph::AccessMask {
+		SIM_UNITS   = 1 << 0,
+		SIM_MAP     = 1 << 1,
+		SIM_SMOOTH  = 1 << 2,
+		SIM_PATH    = 1 << 3,
+		SIM_LOS     = 1 << 4,
+		SIM_ENVRES  = 1 << 5,
+		SIM_RNG     = 1 << 6, // gsRNG
+		SIM_GHOSTS  = 1 << 7, // unsynced
+	};
+
+	constexpr CTaskGraph::AccessMask SIM_ALL = CTaskGraph::ACCESS_ALL;
+
+	simFrameStages.Clear();
+	simFrameStages.AddStage("Helper"            , SIM_ALL  , SIM_ALL               , true , []() { helper->Update(); });
+	simFrameStages.AddStage("ReadMap"           , SIM_MAP  , SIM_MAP               , true , []() { readMap->Update(); });
+	simFrameStages.AddStage("SmoothGround"      , SIM_MAP  , SIM_SMOOTH            , true , []() { smoothGround.UpdateSmoothMesh(); });
+	simFrameStages.AddStage("MapDamage"         , SIM_ALL  , SIM_ALL               , true , []() { mapDamage->Update(); });
+	simFrameStages.AddStage("Units"             , SIM_ALL  , SIM_ALL               , true , []() { unitHandler.Update(); });
+	simFrameStages.AddStage("LosAsync"          , SIM_UNITS, SIM_LOS               , true , []() { losHandler->UpdateAsync(); });
+	simFrameStages.AddStage("Path"              , SIM_MAP  , SIM_PATH              , true , []() { pathManager->Update(); });
+	simFrameStages.AddStage("Projectiles"       , SIM_ALL  , SIM_ALL               , true , []() { projectileHandler.Update(); });
+	simFrameStages.AddStage("Features"          , SIM_ALL  , SIM_ALL               , true , []() { featureHandler.Update(); });
+	simFrameStages.AddStage("Script"            , SIM_ALL  , SIM_ALL               , true , []() {
+		/* The default GAME_SPEED is 30, which doesn't divide 1000 well,
+		 * so scripts will perceive 990ms per second. But this is fine,
+		 * since doing "29th February" style of extra counting would be
+		 * disruptive to sleeps that assume a constant tick length while
+		 * not being otherwise perceptible since most animations don't
+		 * run that long. */
+		static constexpr int tickMs = 1000 / GAME_SPEED;
+
+		SCOPED_TIMER("Sim::Script");
+		unitScriptEngine->Tick(tickMs);
+
+		unitHandler.UpdatePostAnimation();
+	});
+	// wind only depends on its own state and the synced RNG, overlaps with LOS
+	simFrameStages.AddStage("EnvRes"            , 0        , SIM_ENVRES | SIM_RNG  , false, []() { envResHandler.Update(); });
+	simFrameStages.AddStage("Los"               , SIM_UNITS, SIM_LOS               , true , []() { losHandler->Update(); });
+	// dead ghosts have to be updated in sim, after los,
+	// to make sure they represent the current knowledge correctly.
+	// should probably be split from drawer
+	// (headless builds never create dead ghosts, see CUnitDrawerData)
+	#ifndef HEADLESS
+	simFrameStages.AddStage("GhostedBuildings"  , SIM_LOS  , SIM_GHOSTS            , true , []() { CUnitDrawer::UpdateGhostedBuildings(); });
+	#endif
+	simFrameStages.AddStage("Intercept"         , SIM_ALL  , SIM_ALL               , true , []() { interceptHandler.Update(false); });
+
+	for (size_t i = 0, n = std::min(simFrameStages.GetStages().size(), CFrameTelemetry::NUM_STAGES); i < n; i++) {
+		telemetry.SetStageName(i, simFrameStages.GetStages()[i].name);
+	}
+}
+
 void CGame::Load(const std::string& mapFileName)
 {
 	// NOTE:
@@ -372,9 +469,7 @@ void CGame::Load(const std::string& mapFileName)
 	try {
 		LOG("[Game::%s][1] globalQuit=%d threaded=%d", __func__, globalQuit.load(), !Threading::IsMainThread());
 
-		LoadMap(mapFileName);
-		Watchdog::ClearTimer(WDT_LOAD);
-		LoadDefs(defsParser);
+		LoadMapAndDefs(mapFileName, defsParser);
 		Watchdog::ClearTimer(WDT_LOAD);
 	} catch (const content_error& e) {
 		contentErrors.emplace_back(e.what());
@@ -513,6 +608,7 @@ void CGame::Load(const std::string& mapFileName)
 
 	Watchdog::DeregisterThread(WDT_LOAD);
 	AddTimedJobs();
+	AddSimFrameStages();
 
 	if (forcedQuit)
 		spring::exitCode = spring::EXIT_CODE_NOLOAD;
@@ -525,6 +621,35 @@ void CGame::Load(const std::string& mapFileName)
 }
 
 
+void CGame::LoadMapAndDefs(const std::string& mapFileName, LuaParser* defsParser)
+{
+	ZoneScoped;
+
+	// gamedata/defs.lua may draw from the synced RNG on a pool thread while
+	// the map loads, so synced code is entered around the whole graph here
+	ENTER_SYNCED_CODE();
+
+	CLoadStageGraph loadStages;
+
+	// the defs scripts neither touch GL nor the map, everything else stays on
+	// this thread because it does or is not thread-safe (e.g. the sound-system)
+	const bool overlapStages = configHandler->GetBool("OverlapLoadStages");
+
+	loadStages.AddStage("Map", [&]() { LoadMap(mapFileName); }, {}, true);
+	loadStages.AddStage("GameData", [&]() { LoadGameData(defsParser); }, {}, !overlapStages);
+	loadStages.AddStage("Icons", [&]() {
+		loadscreen->SetLoadMessage("Loading Radar Icons");
+		auto lock = CLoadLock::GetUniqueLock();
+		icon::iconHandler.Init();
+	}, {}, true);
+	loadStages.AddStage("SoundDefs", [&]() { LoadSoundDefs(); }, {}, true);
+
+	loadStages.Run();
+	loadStages.LogTimings("Game::LoadMapAndDefs");
+
+	LEAVE_SYNCED_CODE();
+}
+
 void CGame::LoadMap(const std::string& mapFileName)
 {
 	ENTER_SYNCED_CODE();
@@ -553,12 +678,130 @@ void CGame::LoadMap(const std::string& mapFileName)
 }
 
 
-void CGame::LoadDefs(LuaParser* defsParser)
+static constexpr uint32_t DEFS_CACHE_VERSION = 1;
+
+/**
+ * The defs tables depend on nothing but the game archive (and what it depends
+ * on), the engine and the script's modoptions, teams, players and AIs, so all
+ * of these are hashed into the key. There is one file per game version, which
+ * the most recently started setup overwrites.
+ */
+static bool GetDefsCacheKey(std::string& fileName, sha512::raw_digest& key)
 {
-	ENTER_SYNCED_CODE();
+	const sha512::raw_digest modChecksum = archiveScanner->GetArchiveCompleteChecksumBytes(archiveScanner->ArchiveFromName(gameSetup->modName));
+
+	if (modChecksum == sha512::NULL_RAW_DIGEST)
+		return false;
+
+	const std::string& engineVersion = SpringVersion::GetSync();
+	const std::string& setupText = gameSetup->setupText;
+
+	std::vector<uint8_t> keyData;
+	keyData.reserve(modChecksum.size() + engineVersion.size() + setupText.size());
+	keyData.insert(keyData.end(), modChecksum.begin(), modChecksum.end());
+	keyData.insert(keyData.end(), engineVersion.begin(), engineVersion.end());
+	keyData.insert(keyData.end(), setupText.begin(), setupText.end());
+
+	sha512::calc_digest(keyData, key);
+
+	const char sep = FileSystemAbstraction::GetNativePathSeparator();
+	const std::string dir = dataDirsAccess.LocateDir(FileSystem::GetCacheDir() + sep + "defs" + sep, FileQueryFlags::WRITE | FileQueryFlags::CREATE_DIRS);
+
+	fileName = dir + sha512::dump_digest(modChecksum).substr(0, 16) + ".bin";
+	return true;
+}
+
+static bool LoadDefsCache(LuaParser* defsParser)
+{
+	std::string fileName;
+	sha512::raw_digest key;
+
+	if (!GetDefsCacheKey(fileName, key))
+		return false;
+
+	FILE* file = fopen(fileName.c_str(), "rb");
+
+	if (file == nullptr)
+		return false;
+
+	uint32_t version = 0;
+	uint64_t size = 0;
+
+	sha512::raw_digest fileKey;
+	std::vector<uint8_t> data;
+
+	bool ret = true;
+	ret = ret && (fread(&version, sizeof(version), 1, file) == 1 && version == DEFS_CACHE_VERSION);
+	ret = ret && (fread(fileKey.data(), fileKey.size(), 1, file) == 1 && fileKey == key);
+	ret = ret && (fread(&size, sizeof(size), 1, file) == 1);
+
+	if (ret) {
+		data.resize(size);
+		ret = (size == 0 || fread(data.data(), data.size(), 1, file) == 1);
+	}
+
+	fclose(file);
+
+	if (!ret)
+		return false;
+
+	if (!defsParser->LoadSerializedRoot(data)) {
+		LOG_L(L_WARNING, "[Game::%s] ignoring corrupt defs cache \"%s\"", __func__, fileName.c_str());
+		return false;
+	}
+
+	return true;
+}
+
+static void SaveDefsCache(const LuaParser* defsParser)
+{
+	std::string fileName;
+	sha512::raw_digest key;
+	std::vector<uint8_t> data;
+
+	if (!GetDefsCacheKey(fileName, key))
+		return;
+
+	if (!defsParser->SerializeRoot(data)) {
+		LOG_L(L_WARNING, "[Game::%s] gamedata definitions can not be cached", __func__);
+		return;
+	}
+
+	const std::string tempName = fileName + ".tmp";
+	FILE* file = fopen(tempName.c_str(), "wb");
+
+	if (file == nullptr) {
+		LOG_L(L_WARNING, "[Game::%s] failed to open %s for writing", __func__, tempName.c_str());
+		return;
+	}
+
+	const uint64_t size = data.size();
+
+	bool ret = true;
+	ret = ret && (fwrite(&DEFS_CACHE_VERSION, sizeof(DEFS_CACHE_VERSION), 1, file) == 1);
+	ret = ret && (fwrite(key.data(), key.size(), 1, file) == 1);
+	ret = ret && (fwrite(&size, sizeof(size), 1, file) == 1);
+	ret = ret && (size == 0 || fwrite(data.data(), data.size(), 1, file) == 1);
+	ret = (fclose(file) == 0) && ret;
+
+	// a crash mid-write must not leave a truncated file behind under the real name
+	std::remove(fileName.c_str());
+
+	if (!ret || std::rename(tempName.c_str(), fileName.c_str()) != 0)
+		std::remove(tempName.c_str());
+}
+
+
+void CGame::LoadGameData(LuaParser* defsParser)
+{
+	{
+		SCOPED_ONCE_TIMER("Game::LoadGameData (Prefetch)");
+		// the loaders below read these one file at a time
+		vfsHandler->PrefetchFiles({"gamedata/", "units/", "weapons/", "features/", "scripts/", "objects3d/"}, CVFSHandler::Section::Mod);
+	}
 
 	{
-		SCOPED_ONCE_TIMER("Game::LoadDefs (GameData)");
+		SCOPED_ONCE_TIMER("Game::LoadGameData (Defs)");
 		loadscreen->SetLoadMessage("Loading GameData Definitions");
 
 		defsParser->SetupLua(true, true);
@@ -586,9 +829,20 @@ void CGame::LoadDefs(LuaParser* defsParser)
 		defsParser->EndTable();
 		#undef LSR_ADDFUNC
 
-		// run the parser
-		if (!defsParser->Execute())
-			throw content_error("Defs-Parser: " + defsParser->GetErrorLog());
+		const bool useDefsCache = configHandler->GetBool("DefsCache");
+
+		if (useDefsCache && LoadDefsCache(defsParser)) {
+			LOG("[Game::%s] loaded gamedata definitions from cache", __func__);
+		} else {
+			// run the parser
+			if (!defsParser->Execute())
+				throw content_error("Defs-Parser: " + defsParser->GetErrorLog());
+
+			// defs that draw from the synced RNG have to be run by every client
+			// to keep it in step, a cache hit would skip those draws
+			if (useDefsCache && !defsParser->UsedRandom())
+				SaveDefsCache(defsParser);
+		}
 
 		const LuaTable& root = defsParser->GetRoot();
 
@@ -613,27 +867,21 @@ void CGame::LoadDefs(LuaParser* defsParser)
 			throw content_error("Error loading MoveDefs");
 
 	}
+}
 
-	{
-		loadscreen->SetLoadMessage("Loading Radar Icons");
-		auto lock = CLoadLock::GetUniqueLock();
-		icon::iconHandler.Init();
-	}
-	{
-		SCOPED_ONCE_TIMER("Game::LoadDefs (Sound)");
-		loadscreen->SetLoadMessage("Loading Sound Definitions");
-
-		LuaParser soundDefsParser("gamedata/sounds.lua", SPRING_VFS_MOD_BASE, SPRING_VFS_MOD_BASE);
-		soundDefsParser.GetTable("Spring");
-		soundDefsParser.AddFunc("GetModOptions", LuaSyncedRead::GetModOptions);
-		soundDefsParser.AddFunc("GetMapOptions", LuaSyncedRead::GetMapOptions);
-		soundDefsParser.EndTable();
+void CGame::LoadSoundDefs()
+{
+	SCOPED_ONCE_TIMER("Game::LoadSoundDefs");
+	loadscreen->SetLoadMessage("Loading Sound Definitions");
 
-		sound->LoadSoundDefs(&soundDefsParser);
-		chatSound = sound->GetDefSoundId("IncomingChat");
-	}
+	LuaParser soundDefsParser("gamedata/sounds.lua", SPRING_VFS_MOD_BASE, SPRING_VFS_MOD_BASE);
+	soundDefsParser.GetTable("Spring");
+	soundDefsParser.AddFunc("GetModOptions", LuaSyncedRead::GetModOptions);
+	soundDefsParser.AddFunc("GetMapOptions", LuaSyncedRead::GetMapOptions);
+	soundDefsParser.EndTable();
 
-	LEAVE_SYNCED_CODE();
+	sound->LoadSoundDefs(&soundDefsParser);
+	chatSound = sound->GetDefSoundId("IncomingChat");
 }
 
 
@@ -673,6 +921,9 @@ void CGame::PostLoadSimulation(LuaParser* defsParser)
 		featureDefHandler->Init(defsParser);
 	}
 
+	// decode def sounds while the rest loads, instead of on their first play
+	CommonDefHandler::PreDecodeSounds();
+
 	CUnit::InitStatic();
 	CCommandAI::InitCommandDescriptionCache();
 	CUnitScriptFactory::InitStatic();
@@ -1241,13 +1492,14 @@ bool CGame::UpdateUnsynced(const spring_time currentTime)
 	}
 
 	if (skipping) {
-		// when fast-forwarding, maintain a draw-rate of 2Hz
+		// when fast-forwarding nothing is drawn and no unsynced updates
+		// run, only report progress at 2Hz until the target is reached
 		if (spring_tomsecs(currentTime - skipLastDrawTime) < 500.0f)
 			return true;
 
 		skipLastDrawTime = currentTime;
 
-		DrawSkip();
+		ReportSkipProgress();
 		return true;
 	}
 
@@ -1409,8 +1661,11 @@ bool CGame::UpdateUnsynced(const spring_time currentTime)
 	shadowHandler.Update();
 	{
 		worldDrawer.Update(newSimFrame);
+		// nothing reads the uploaded model data without a renderer
+		#ifndef HEADLESS
 		transformsUploader.Update();
 		modelUniformsUploader.Update();
+		#endif
 	}
 
 	mouse->UpdateCursorCameraDir(); // make sure mouse->dir is in sync with camera
@@ -1426,6 +1681,8 @@ bool CGame::UpdateUnsynced(const spring_time currentTime)
 bool CGame::Draw() {
 	const spring_time currentTimePreUpdate = spring_gettime();
 
+	CFrameArena::NewFrame();
+
 	if (UpdateUnsynced(currentTimePreUpdate))
 		return false;
 
@@ -1501,8 +1758,10 @@ bool CGame::Draw() {
 			FBO::Unbind();
 		camera->LoadViewport();
 
+		globalRendering->SetGLTimeStamp(CGlobalRendering::WORLD_BEG_TIME_QUERY_IDX);
 		worldDrawer.Draw();
 		worldDrawer.ResetMVPMatrices();
+		globalRendering->SetGLTimeStamp(CGlobalRendering::WORLD_END_TIME_QUERY_IDX);
 	}
 
 	{
@@ -1534,6 +1793,8 @@ bool CGame::Draw() {
 		videoCapturing->RenderFrame();
 	}
 
+	UpdateScreenshots();
+
 	SetDrawMode(gameNotDrawing);
 	CTeamHighlight::Disable();
 
@@ -1647,6 +1908,53 @@ void CGame::DrawInputText()
 }
 
 
+void CGame::UpdateTelemetry()
+{
+	CFrameTelemetry::Record record;
+	SLuaAllocState luaState = {{0}, {0}, {0}, {0}, {0}};
+
+	spring_lua_alloc_get_stats(&luaState);
+
+	const int2 pathUpdates = pathManager->GetNumQueuedUpdates();
+
+	record.frameNum = gs->frameNum;
+	record.frameTimeMs = (lastSimFrameTime - lastFrameTime).toMilliSecsf();
+
+	record.counters[0] = unitHandler.GetActiveUnits().size();
+	record.counters[1] = projectileHandler.GetActiveProjectiles(true).size() + projectileHandler.GetActiveProjectiles(false).size();
+	record.counters[2] = pathUpdates.x + pathUpdates.y;
+	record.counters[3] = luaState.allocedBytes.load() / 1024;
+
+	for (size_t i = 0, n = std::min(simFrameStages.GetStages().size(), CFrameTelemetry::NUM_STAGES); i < n; i++) {
+		record.stageTimes[i] = CFrameTelemetry::ToStageTime(simFrameStages.GetStageTime(i));
+	}
+
+	if (const netcode::CConnection* conn = clientNet->GetServerConnection(); conn != nullptr) {
+		record.netBytesIn = conn->GetDataReceived() - telemetryNetBytesIn;
+		record.netBytesOut = conn->GetDataSent() - telemetryNetBytesOut;
+
+		telemetryNetBytesIn = conn->GetDataReceived();
+		telemetryNetBytesOut = conn->GetDataSent();
+	}
+
+	telemetry.Push(record);
+
+	if (telemetryLagThreshold <= 0.0f || record.frameTimeMs <= telemetryLagThreshold)
+		return;
+	// skipping is expected to be slow
+	if (skipping)
+		return;
+	if (spring_istime(telemetryLagDumpTime) && (lastSimFrameTime - telemetryLagDumpTime) < spring_secs(60))
+		return;
+
+	telemetryLagDumpTime = lastSimFrameTime;
+
+	const std::string path = telemetry.Dump("lag");
+
+	if (!path.empty())
+		LOG_L(L_WARNING, "[Game::%s] sim-frame %d took %.1fms, telemetry written to \"%s\"", __func__, gs->frameNum, record.frameTimeMs, path.c_str());
+}
+
 void CGame::StartPlaying()
 {
 	RECOIL_DETAILED_TRACY_ZONE;
@@ -1668,6 +1976,7 @@ void CGame::StartPlaying()
 
 	if (saveFileHandler == nullptr)
 		eventHandler.GameStart();
+	CSimBenchmark::GameStart();
 }
 
 static const char* const tracingSimFrameName = "SimFrame";
@@ -1684,6 +1993,7 @@ void CGame::SimFrame() {
 
 	// note: starts at -1, first actual frame is 0
 	gs->frameNum += 1;
+	CFrameArena::NewFrame();
 #ifdef SYNC_HISTORY
 	CSyncChecker::NewGameFrame();
 #endif
@@ -1734,6 +2044,9 @@ void CGame::SimFrame() {
 		c.SendStateUpdate(/*camera->GetMovState(), mouse->buttons*/);
 
 		CTeamHighlight::Update(gs->frameNum);
+	} else {
+		// threaded AIs still need their queued events while catching up
+		eoh->FlushEvents();
 	}
 
 	// everything from here is simulation
@@ -1756,35 +2069,7 @@ void CGame::SimFrame() {
 			eventHandler.GameFrame(gs->frameNum);
 		}
 
-		helper->Update();
-		readMap->Update();
-		smoothGround.UpdateSmoothMesh();
-		mapDamage->Update();
-		unitHandler.Update();
-		pathManager->Update();
-		projectileHandler.Update();
-		featureHandler.Update();
-		{
-			/* The default GAME_SPEED is 30, which doesn't divide 1000 well,
-			 * so scripts will perceive 990ms per second. But this is fine,
-			 * since doing "29th February" style of extra counting would be
-			 * disruptive to sleeps that assume a constant tick length while
-			 * not being otherwise perceptible since most animations don't
-			 * run that long. */
-			static constexpr int tickMs = 1000 / GAME_SPEED;
-
-			SCOPED_TIMER("Sim::Script");
-			unitScriptEngine->Tick(tickMs);
-
-			unitHandler.UpdatePostAnimation();
-		}
-		envResHandler.Update();
-		losHandler->Update();
-		// dead ghosts have to be updated in sim, after los,
-		// to make sure they represent the current knowledge correctly.
-		// should probably be split from drawer
-		CUnitDrawer::UpdateGhostedBuildings();
-		interceptHandler.Update(false);
+		simFrameStages.Run();
 
 		teamHandler.GameFrame(gs->frameNum);
 		playerHandler.GameFrame(gs->frameNum);
@@ -1794,12 +2079,35 @@ void CGame::SimFrame() {
 		featureHandler.UpdatePostFrame();
 	}
 
+	// hand each finished stats-history entry to the demo as it is produced
+	// rather than copying the entire history when the game ends
+	if ((gs->frameNum % (TeamStatistics::statsPeriod * GAME_SPEED)) == 0) {
+		CDemoRecorder* record = clientNet->GetDemoRecorder();
+
+		if (record->IsValid()) {
+			for (int i = 0, n = teamHandler.ActiveTeams() - int(gs->useLuaGaia); i < n; ++i) {
+				record->SetTeamStats(i, teamHandler.Team(i)->statHistory);
+			}
+		}
+	}
+
+	// queue a savegame named after the demo being recorded; it is written between
+	// two sim frames by the main loop, a user-requested save takes precedence
+	if (demoKeyframeInterval > 0 && (gs->frameNum % demoKeyframeInterval) == 0 && !gameSetup->hostDemo && globalSaveFileData.name.empty()) {
+		const CDemoRecorder* record = clientNet->GetDemoRecorder();
+
+		if (record->IsValid())
+			Save("Saves/" + FileSystem::GetBasename(record->GetName()) + "_" + IntToString(gs->frameNum) + ".ssf", "-y");
+	}
+
 	lastSimFrameTime = spring_gettime();
 	gu->avgSimFrameTime = mix(gu->avgSimFrameTime, (lastSimFrameTime - lastFrameTime).toMilliSecsf(), 0.05f);
 	gu->avgSimFrameTime = std::max(gu->avgSimFrameTime, 0.01f);
 
 	eventHandler.DbgTimingInfo(TIMING_SIM, lastFrameTime, lastSimFrameTime);
 
+	UpdateTelemetry();
+
 	FrameMarkEnd(tracingSimFrameName);
 
 	#ifdef HEADLESS
@@ -1809,7 +2117,8 @@ void CGame::SimFrame() {
 		// multiply by 0.5 to give unsynced code some execution time (50% of our sleep-budget)
 		const float msecSleepTime = (msecMaxSimFrameTime - msecDifSimFrameTime) * 0.5f;
 
-		if (msecSleepTime > 0.0f) {
+		// benchmark runs go as fast as the sim allows
+		if (msecSleepTime > 0.0f && !CSimBenchmark::IsEnabled()) {
 			spring_sleep(spring_msecs(msecSleepTime));
 		}
 	}
@@ -1818,6 +2127,8 @@ void CGame::SimFrame() {
 	// useful for desync-debugging (enter instead of -1 start & end frame of the range you want to debug)
 	DumpState(-1, -1, 1, std::nullopt);
 
+	CSimBenchmark::SimFrame(gs->frameNum);
+
 	ASSERT_SYNCED(gsRNG.GetGenState());
 	LEAVE_SYNCED_CODE();
 }
@@ -2009,7 +2320,6 @@ void CGame::HandleChatMsg(const ChatMessage& msg)
 
 void CGame::StartSkip(int toFrame) {
 	RECOIL_DETAILED_TRACY_ZONE;
-	#if 0 // FIXME: desyncs
 	if (skipping)
 		LOG_L(L_ERROR, "skipping appears to be busted (%i)", skipping);
 
@@ -2022,68 +2332,56 @@ void CGame::StartSkip(int toFrame) {
 	}
 
 	skipTotalFrames = skipEndFrame - skipStartFrame;
+	skipProgressStep = 0;
 	skipSeconds = skipTotalFrames * INV_GAME_SPEED;
 
 	skipSoundmute = sound->IsMuted();
 	if (!skipSoundmute)
 		sound->Mute(); // no sounds
 
-	//FIXME not smart to change SYNCED values in demo playbacks etc.
-	skipOldSpeed     = gs->speedFactor;
-	skipOldUserSpeed = gs->wantedSpeedFactor;
-	const float speed = 1.0f;
-	gs->speedFactor     = speed;
-	gs->wantedSpeedFactor = speed;
-
+	// NOTE:
+	//   the speed-factors are left alone since they are synced, changing
+	//   them made skipping desync; the frame-rate is only bounded by how
+	//   fast ClientReadNet can consume the demo frames the server sends
 	skipLastDrawTime = spring_gettime();
 
 	skipping = true;
-	#endif
 }
 
 void CGame::EndSkip() {
 	RECOIL_DETAILED_TRACY_ZONE;
-	#if 0 // FIXME
+	if (!skipping)
+		return;
+
 	skipping = false;
 
 	gu->gameTime    += skipSeconds;
 	gu->modGameTime += skipSeconds;
 
-	gs->speedFactor     = skipOldSpeed;
-	gs->wantedSpeedFactor = skipOldUserSpeed;
+	// resume regular pacing, the skipped time should not count towards it
+	lastReadNetTime = spring_gettime();
+	msgProcTimeLeft = 0.0f;
 
 	if (!skipSoundmute)
 		sound->Mute(); // sounds back on
 
 	LOG("Skipped %.1f seconds", skipSeconds);
-	#endif
 }
 
 
 
-void CGame::DrawSkip(bool blackscreen) {
+void CGame::ReportSkipProgress() {
 	RECOIL_DETAILED_TRACY_ZONE;
-	#if 0
-	const int framesLeft = (skipEndFrame - gs->frameNum);
-	if (blackscreen) {
-		glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
-		glClear(GL_COLOR_BUFFER_BIT);
-	}
-	glColor3f(0.5f, 1.0f, 0.5f);
-	font->glFormat(0.5f, 0.55f, 2.5f, FONT_CENTER | FONT_SCALE | FONT_NORM, "Skipping %.1f game seconds", skipSeconds);
-	glColor3f(1.0f, 1.0f, 1.0f);
-	font->glFormat(0.5f, 0.45f, 2.0f, FONT_CENTER | FONT_SCALE | FONT_NORM, "(%i frames left)", framesLeft);
-
-	const float ff = (float)framesLeft / (float)skipTotalFrames;
-	glDisable(GL_TEXTURE_2D);
-	const float b = 0.004f; // border
-	const float yn = 0.35f;
-	const float yp = 0.38f;
-	glColor3f(0.2f, 0.2f, 1.0f);
-	glRectf(0.25f - b, yn - b, 0.75f + b, yp + b);
-	glColor3f(0.25f + (0.75f * ff), 1.0f - (0.75f * ff), 0.0f);
-	glRectf(0.5 - (0.25f * ff), yn, 0.5f + (0.25f * ff), yp);
-	#endif
+	const int framesLeft = std::max(0, skipEndFrame - gs->frameNum);
+	const int progressStep = ((skipTotalFrames - framesLeft) * 10) / skipTotalFrames;
+
+	// report in 10% steps rather than at every 2Hz update
+	if (progressStep <= skipProgressStep)
+		return;
+
+	skipProgressStep = progressStep;
+
+	LOG("Skipping: %i%% (%i frames left)", progressStep * 10, framesLeft);
 }
 
 
@@ -13,7 +13,9 @@
 #include "Rendering/WorldDrawer.h"
 #include "System/UnorderedMap.hpp"
 #include "System/creg/creg_cond.h"
+#include "System/FrameTelemetry.h"
 #include "System/Misc/SpringTime.h"
+#include "System/Threading/TaskGraph.h"
 
 class LuaParser;
 class ILoadSaveHandler;
@@ -54,9 +56,12 @@ public:
 
 private:
 	void AddTimedJobs();
+	void AddSimFrameStages();
 
+	void LoadMapAndDefs(const std::string& mapName, LuaParser* defsParser);
 	void LoadMap(const std::string& mapName);
-	void LoadDefs(LuaParser* defsParser);
+	void LoadGameData(LuaParser* defsParser);
+	void LoadSoundDefs();
 	void PreLoadSimulation(LuaParser* defsParser);
 	void PostLoadSimulation(LuaParser* defsParser);
 	void PreLoadRendering();
@@ -75,6 +80,8 @@ private:
 public:
 	bool IsDoneLoading() const { return loadDone; }
 	bool IsClientPaused() const { return paused; }
+
+	const CFrameTelemetry& GetTelemetry() const { return telemetry; }
 	bool IsSimLagging(float maxLatency = 500.0f) const;
 	bool IsSavedGame() const { return (saveFileHandler != nullptr); }
 	bool IsGameOver() const { return gameOver; }
@@ -114,7 +121,7 @@ private:
 	bool Update() override;
 	bool UpdateUnsynced(const spring_time currentTime);
 
-	void DrawSkip(bool blackscreen = true);
+	void ReportSkipProgress();
 	void DrawInputReceivers();
 	void DrawInputText();
 	void DrawInterfaceWidgets();
@@ -146,6 +153,7 @@ private:
 	void UpdateNumQueuedSimFrames();
 	void UpdateNetMessageProcessingTimeLeft();
 	void SimFrame();
+	void UpdateTelemetry();
 	void StartPlaying();
 
 public:
@@ -193,15 +201,12 @@ public:
 	float consumeSpeedMult = 1.0f; ///< How fast we should eat NETMSG_NEWFRAMEs.
 
 
-	#if 0
 	int skipStartFrame = 0;
 	int skipEndFrame = 0;
 	int skipTotalFrames = 0;
+	int skipProgressStep = 0;
 	float skipSeconds = 0.0f;
 	bool skipSoundmute = false;
-	float skipOldSpeed = 0.0f;
-	float skipOldUserSpeed = 0.0f;
-	#endif
 
 
 	/**
@@ -209,12 +214,28 @@ public:
 	 */
 	int speedControl = -1;
 
+	/// frames between two savegames written next to the recorded demo, 0 if disabled
+	int demoKeyframeInterval = 0;
+
 	// 0 := 1/f rate, 1 := 30/s rate
 	int luaGCControl = 0;
 
 private:
 	JobDispatcher jobDispatcher;
 
+	/// the per-subsystem updates of SimFrame
+	CTaskGraph simFrameStages;
+
+	/// one record per SimFrame, dumped on desync, crash and lag spikes
+	CFrameTelemetry telemetry = {"client"};
+
+	unsigned int telemetryNetBytesIn = 0;
+	unsigned int telemetryNetBytesOut = 0;
+
+	/// sim-frame time (ms) above which the telemetry ring is dumped, 0 if disabled
+	float telemetryLagThreshold = 0.0f;
+	spring_time telemetryLagDumpTime;
+
 	CWorldDrawer worldDrawer;
 
 	/// <playerID, <packetCode, total bytes> >
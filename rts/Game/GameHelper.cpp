@@ -40,6 +40,7 @@
 #include "System/EventHandler.h"
 #include "System/SpringMath.h"
 #include "System/Sound/ISoundChannels.h"
+#include "System/Threading/ThreadPool.h"
 
 #include "System/Misc/TracyDefs.h"
 
@@ -301,7 +302,11 @@ void CGameHelper::Explosion(const CExplosionParams& params) {
 			);
 		}
 	} else {
-		DamageObjectsInExplosionRadius(params, damageAOE, weaponDefID);
+		if (batchExplosions) {
+			QueueExplosionDamage(params, damageAOE, weaponDefID);
+		} else {
+			DamageObjectsInExplosionRadius(params, damageAOE, weaponDefID);
+		}
 
 		// deform the map if the explosion was above-ground
 		// (but had large enough radius to touch the ground)
@@ -355,6 +360,148 @@ void CGameHelper::Explosion(const CExplosionParams& params) {
 }
 
 
+void CGameHelper::BeginExplosionBatch()
+{
+	assert(queuedExplosions.empty());
+	batchExplosions = modInfo.explosionDamageBatching;
+}
+
+void CGameHelper::QueueExplosionDamage(const CExplosionParams& params, const float expRad, const int weaponDefID)
+{
+	// explosions in the same quad share one query over the union of their spheres
+	const int64_t cellX = static_cast<int64_t>(params.pos.x / quadField.GetQuadSizeX());
+	const int64_t cellZ = static_cast<int64_t>(params.pos.z / quadField.GetQuadSizeZ());
+	const int64_t cellKey = (cellZ << 32) ^ (cellX & 0xFFFFFFFF);
+
+	const auto it = explosionClusterIndices.find(cellKey);
+	const float3 expMins = params.pos - OnesVector * expRad;
+	const float3 expMaxs = params.pos + OnesVector * expRad;
+
+	int clusterIdx = -1;
+
+	if (it == explosionClusterIndices.end()) {
+		if (numExplosionClusters == explosionClusters.size())
+			explosionClusters.emplace_back();
+
+		ExplosionCluster& cluster = explosionClusters[clusterIdx = numExplosionClusters++];
+
+		cluster.mins = expMins;
+		cluster.maxs = expMaxs;
+		cluster.numExplosions = 0;
+		cluster.units.clear();
+		cluster.features.clear();
+
+		explosionClusterIndices[cellKey] = clusterIdx;
+	} else {
+		ExplosionCluster& cluster = explosionClusters[clusterIdx = it->second];
+
+		cluster.mins = float3::min(cluster.mins, expMins);
+		cluster.maxs = float3::max(cluster.maxs, expMaxs);
+	}
+
+	explosionClusters[clusterIdx].numExplosions += 1;
+
+	QueuedExplosion& qe = queuedExplosions.emplace_back();
+
+	qe.pos = params.pos;
+	qe.damages = params.damages;
+	qe.owner = params.owner;
+	qe.radius = expRad;
+	qe.explosionSpeed = params.explosionSpeed;
+	qe.edgeEffectiveness = params.edgeEffectiveness;
+	qe.weaponDefID = weaponDefID;
+	qe.projectileID = params.projectileID;
+	qe.cluster = clusterIdx;
+	qe.ignoreOwner = params.ignoreOwner;
+}
+
+void CGameHelper::EndExplosionBatch()
+{
+	RECOIL_DETAILED_TRACY_ZONE;
+
+	// explosions caused by the damage below (e.g. deaths) happen immediately again
+	batchExplosions = false;
+
+	static std::vector<CUnit*> clusterUnits;
+	static std::vector<CFeature*> clusterFeatures;
+
+	// one sweep per cluster; objects are not deleted before the end of the frame
+	for (size_t i = 0; i < numExplosionClusters; i++) {
+		ExplosionCluster& cluster = explosionClusters[i];
+
+		if (cluster.numExplosions == 1)
+			continue;
+
+		const float3 center = (cluster.mins + cluster.maxs) * 0.5f;
+		const float radius = center.distance(cluster.maxs);
+
+		quadField.GetUnitsAndFeaturesColVol(center, radius, clusterUnits, clusterFeatures);
+
+		for (CUnit* u: clusterUnits) {
+			cluster.units.push_back({u, u->collisionVolume.GetWorldSpacePos(u), u->collisionVolume.GetBoundingRadius()});
+		}
+		for (CFeature* f: clusterFeatures) {
+			cluster.features.push_back({f, f->collisionVolume.GetWorldSpacePos(f), f->collisionVolume.GetBoundingRadius()});
+		}
+
+		clusterUnits.clear();
+		clusterFeatures.clear();
+	}
+
+	// same filter as GetUnitsAndFeaturesColVol, per explosion and in queue order
+	const auto InSphere = [](const QueuedExplosion& qe, const auto& co) {
+		const float totRad = qe.radius + co.colVolRadius;
+		return (qe.pos.SqDistance(co.colVolPos) < (totRad * totRad));
+	};
+
+	for (const QueuedExplosion& qe: queuedExplosions) {
+		const ExplosionCluster& cluster = explosionClusters[qe.cluster];
+
+		if (cluster.numExplosions == 1) {
+			const CExplosionParams params = {
+				.pos                  = qe.pos,
+				.dir                  = ZeroVector,
+				.damages              = qe.damages,
+				.weaponDef            = nullptr,
+				.owner                = qe.owner,
+				.hitUnit              = nullptr,
+				.hitFeature           = nullptr,
+				.craterAreaOfEffect   = 0.0f,
+				.damageAreaOfEffect   = qe.radius,
+				.edgeEffectiveness    = qe.edgeEffectiveness,
+				.explosionSpeed       = qe.explosionSpeed,
+				.gfxMod               = 0.0f,
+				.maxGroundDeformation = 0.0f,
+				.impactOnly           = false,
+				.ignoreOwner          = qe.ignoreOwner,
+				.damageGround         = false,
+				.projectileID         = static_cast<unsigned int>(qe.projectileID)
+			};
+
+			DamageObjectsInExplosionRadius(params, qe.radius, qe.weaponDefID);
+			continue;
+		}
+
+		for (const ClusterObject<CUnit>& co: cluster.units) {
+			if (!InSphere(qe, co))
+				continue;
+
+			DoExplosionDamage(co.object, qe.owner, qe.pos, qe.radius, qe.explosionSpeed, qe.edgeEffectiveness, qe.ignoreOwner, qe.damages, qe.weaponDefID, qe.projectileID);
+		}
+		for (const ClusterObject<CFeature>& co: cluster.features) {
+			if (!InSphere(qe, co))
+				continue;
+
+			DoExplosionDamage(co.object, qe.owner, qe.pos, qe.radius, qe.edgeEffectiveness, qe.damages, qe.weaponDefID, qe.projectileID);
+		}
+	}
+
+	queuedExplosions.clear();
+	explosionClusterIndices.clear();
+	numExplosionClusters = 0;
+}
+
+
 
 //////////////////////////////////////////////////////////////////////
 // Spatial unit queries
@@ -380,7 +527,7 @@ template<typename TFilter, typename TQuery>
 static inline void QueryUnits(TFilter filter, TQuery& query)
 {
 	QuadFieldQuery qfQuery;
-	quadField.GetQuads(qfQuery, query.pos, query.radius);
+	quadField.GetQuads(qfQuery, query.pos, query.radius, CQuadField::QUAD_LIST_UNITS);
 	const int tempNum = gs->GetTempNum();
 
 	for (int t = 0; t < teamHandler.ActiveAllyTeams(); ++t) { //FIXME
@@ -655,10 +802,20 @@ namespace {
 
 
 
+// [0] := default, [1,2,3,4,5,6] := target is {avoidee, in bad category, crashing, last attacker, paralyzed, outside unboosted range}
+static constexpr float tgtPriorityMults[] = {1.0f, 10.0f, 100.0f, 1000.0f, 0.5f, 4.0f, 100000.0f};
+
 size_t CGameHelper::GenerateWeaponTargets(const CWeapon* weapon, const CUnit* avoidUnit, std::vector<std::pair<float, CUnit*>>& targets)
+{
+	auto& candidates = helper->targetCandidates;
+
+	GatherWeaponTargets(weapon, avoidUnit, candidates, 0);
+	return (CommitWeaponTargets(weapon, candidates, targets));
+}
+
+void CGameHelper::GatherWeaponTargets(const CWeapon* weapon, const CUnit* avoidUnit, std::vector<WeaponTargetCandidate>& candidates, int thread)
 {
 	const CUnit*  weaponOwner = weapon->owner;
-	const CUnit* lastAttacker = ((weaponOwner->lastAttackFrame + 200) <= gs->frameNum) ? weaponOwner->lastAttacker : nullptr;
 
 	const      WeaponDef* weaponDef = weapon->weaponDef;
 	const DynDamageArray* weaponDmg = weapon->damages;
@@ -682,19 +839,17 @@ size_t CGameHelper::GenerateWeaponTargets(const CWeapon* weapon, const CUnit* av
 	// const float scanRadius = weapon->GetRange2D(rangeBoost, (minMapHeight - aimPosHeight) * heightMod);
 	const float scanRadius = baseRange + rangeBoost + (aimPosHeight - minMapHeight) * heightMod;
 
-	// [0] := default, [1,2,3,4,5,6] := target is {avoidee, in bad category, crashing, last attacker, paralyzed, outside unboosted range}
-	constexpr float tgtPriorityMults[] = {1.0f, 10.0f, 100.0f, 1000.0f, 0.5f, 4.0f, 100000.0f};
-
 	const bool paralyzer = (weaponDmg->paralyzeDamageTime != 0);
 
-	// copy on purpose since the below calls lua
 	QuadFieldQuery qfQuery;
-	quadField.GetQuads(qfQuery, ownerPos, scanRadius);
+	qfQuery.threadOwner = thread;
+	quadField.GetQuads(qfQuery, ownerPos, scanRadius, CQuadField::QUAD_LIST_UNITS);
 
-	targets.clear();
-	targets.reserve(32);
+	candidates.clear();
+	candidates.reserve(32);
 
-	const int tempNum = gs->GetTempNum();
+	// per-thread marker, nothing reached from here touches Lua or unit scripts
+	const int tempNum = gs->GetMtTempNum(thread);
 
 	for (int t = 0; t < teamHandler.ActiveAllyTeams(); ++t) {
 		if (teamHandler.Ally(weaponOwner->allyteam, t))
@@ -704,15 +859,19 @@ size_t CGameHelper::GenerateWeaponTargets(const CWeapon* weapon, const CUnit* av
 			const std::vector<CUnit*>& allyTeamUnits = quadField.GetQuad(qi).teamUnits[t];
 
 			for (CUnit* targetUnit: allyTeamUnits) {
-				if (targetUnit->tempNum == tempNum)
+				if (targetUnit->mtTempNum[thread] == tempNum)
 					continue;
 
-				targetUnit->tempNum = tempNum;
+				targetUnit->mtTempNum[thread] = tempNum;
 
-				if (!weapon->TestTarget(testPos, SWeaponTarget(targetUnit)))
+				const unsigned short targetLOSState = targetUnit->losStatus[weaponOwner->allyteam];
+
+				// cheap reject of enemies the owner can not see, before the (virtual) TestTarget
+				if ((targetLOSState & (LOS_INLOS | LOS_INRADAR)) == 0)
 					continue;
 
-				const unsigned short targetLOSState = targetUnit->losStatus[weaponOwner->allyteam];
+				if (!weapon->TestTarget(testPos, SWeaponTarget(targetUnit)))
+					continue;
 
 				float targetPriority = tgtPriorityMults[(targetUnit == avoidUnit) * 1];
 				float3 targetPos;
@@ -743,7 +902,6 @@ size_t CGameHelper::GenerateWeaponTargets(const CWeapon* weapon, const CUnit* av
 
 				const float dist2D = math::sqrt(sqDist2D);
 				const float rangeMul = (dist2D * weaponDef->proximityPriority + modRange * 0.4f + 100.0f);
-				const float damageMul = std::max(0.0001f, weaponDmg->Get(targetUnit->armorType) * targetUnit->curArmorMultiple);
 
 				targetPriority *= angleMul;
 				targetPriority *= rangeMul;
@@ -754,32 +912,49 @@ size_t CGameHelper::GenerateWeaponTargets(const CWeapon* weapon, const CUnit* av
 
 					if (paralyzer && targetUnit->paralyzeDamage > (modInfo.paralyzeOnMaxHealth? targetUnit->maxHealth: targetUnit->health))
 						targetPriority *= tgtPriorityMults[5];
-
-					if (weapon->hasTargetWeight)
-						targetPriority *= weapon->TargetWeight(targetUnit);
-
 				} else {
 					targetPriority *= (secDamage + 10000.0f);
 				}
 
-				if (targetLOSState & LOS_PREVLOS) {
-					targetPriority /= (damageMul * targetUnit->power);
-					targetPriority *= tgtPriorityMults[((targetUnit->category & weapon->badTargetCategory) != 0) * 2];
-					targetPriority *= tgtPriorityMults[(targetUnit->IsCrashing()) * 3];
-					targetPriority *= tgtPriorityMults[(targetUnit == lastAttacker) * 4];
-				}
+				candidates.push_back({targetPriority, targetUnit, targetLOSState});
+			}
+		}
+	}
+}
 
-				const bool allowTarget = eventHandler.AllowWeaponTarget(weaponOwner->id, targetUnit->id, weapon->weaponNum, weaponDef->id, &targetPriority);
+size_t CGameHelper::CommitWeaponTargets(const CWeapon* weapon, const std::vector<WeaponTargetCandidate>& candidates, std::vector<std::pair<float, CUnit*>>& targets)
+{
+	const CUnit*  weaponOwner = weapon->owner;
+	const CUnit* lastAttacker = ((weaponOwner->lastAttackFrame + 200) <= gs->frameNum) ? weaponOwner->lastAttacker : nullptr;
 
-				// Lua call may have changed tempNum, so needs to be set again
-				targetUnit->tempNum = tempNum;
+	const      WeaponDef* weaponDef = weapon->weaponDef;
+	const DynDamageArray* weaponDmg = weapon->damages;
 
-				if (!allowTarget)
-					continue;
+	targets.clear();
+	targets.reserve(candidates.size());
 
-				targets.emplace_back(targetPriority, targetUnit);
-			}
+	for (const WeaponTargetCandidate& candidate: candidates) {
+		CUnit* targetUnit = candidate.unit;
+
+		float targetPriority = candidate.priority;
+
+		// script-side weighting must stay serial, and keeps its original place in the product
+		if ((candidate.losState & LOS_INLOS) && weapon->hasTargetWeight)
+			targetPriority *= weapon->TargetWeight(targetUnit);
+
+		if (candidate.losState & LOS_PREVLOS) {
+			const float damageMul = std::max(0.0001f, weaponDmg->Get(targetUnit->armorType) * targetUnit->curArmorMultiple);
+
+			targetPriority /= (damageMul * targetUnit->power);
+			targetPriority *= tgtPriorityMults[((targetUnit->category & weapon->badTargetCategory) != 0) * 2];
+			targetPriority *= tgtPriorityMults[(targetUnit->IsCrashing()) * 3];
+			targetPriority *= tgtPriorityMults[(targetUnit == lastAttacker) * 4];
 		}
+
+		if (!eventHandler.AllowWeaponTarget(weaponOwner->id, targetUnit->id, weapon->weaponNum, weaponDef->id, &targetPriority))
+			continue;
+
+		targets.emplace_back(targetPriority, targetUnit);
 	}
 
 	std::stable_sort(targets.begin(), targets.end(), [](const std::pair<float, CUnit*>& a, const std::pair<float, CUnit*>& b) { return (a.first < b.first); });
@@ -788,6 +963,73 @@ size_t CGameHelper::GenerateWeaponTargets(const CWeapon* weapon, const CUnit* av
 
 
 
+void CGameHelper::PrefetchWeaponTargets(const std::vector<CUnit*>& units, size_t idxBeg, size_t idxEnd)
+{
+	ZoneScoped;
+	ClearPrefetchedWeaponTargets();
+
+	// serial pass; decides which weapons will likely want a new target
+	// (AllowWeaponAutoTarget itself calls into Lua so only its static
+	// conditions are tested here, AutoTarget falls back on a miss)
+	for (size_t i = idxBeg; i < idxEnd; ++i) {
+		const CUnit* unit = units[i];
+
+		if (!unit->CanUpdateWeapons())
+			continue;
+		if (unit->fireState < FIRESTATE_FIREATWILL)
+			continue;
+
+		for (const CWeapon* weapon: unit->weapons) {
+			if (weapon->weaponDef->noAutoTarget || weapon->noAutoTarget)
+				continue;
+			if (weapon->slavedTo != nullptr)
+				continue;
+			if (weapon->weaponDef->interceptor)
+				continue;
+
+			if (numPrefetchedTargets == prefetchedTargets.size())
+				prefetchedTargets.emplace_back();
+
+			PrefetchedWeaponTargets& entry = prefetchedTargets[numPrefetchedTargets];
+			entry.weapon = weapon;
+			entry.avoidUnit = (weapon->avoidTarget && weapon->HaveUnitTarget()) ? weapon->GetCurrentTarget().unit : nullptr;
+			entry.consumed = false;
+
+			prefetchedTargetIndices[weapon] = numPrefetchedTargets++;
+		}
+	}
+
+	// parallel pass; reads a frozen snapshot of the sim, writes only to its own entry
+	for_mt_chunk(0, numPrefetchedTargets, [this](const int i) {
+		PrefetchedWeaponTargets& entry = prefetchedTargets[i];
+		GatherWeaponTargets(entry.weapon, entry.avoidUnit, entry.candidates, ThreadPool::GetThreadNum());
+	});
+}
+
+const std::vector<CGameHelper::WeaponTargetCandidate>* CGameHelper::GetPrefetchedWeaponTargets(const CWeapon* weapon, const CUnit* avoidUnit)
+{
+	const auto iter = prefetchedTargetIndices.find(weapon);
+
+	if (iter == prefetchedTargetIndices.end())
+		return nullptr;
+
+	PrefetchedWeaponTargets& entry = prefetchedTargets[iter->second];
+
+	if (entry.consumed || entry.avoidUnit != avoidUnit)
+		return nullptr;
+
+	entry.consumed = true;
+	return &entry.candidates;
+}
+
+void CGameHelper::ClearPrefetchedWeaponTargets()
+{
+	prefetchedTargetIndices.clear();
+	numPrefetchedTargets = 0;
+}
+
+
+
 CUnit* CGameHelper::GetClosestUnit(const float3& pos, float searchRadius)
 {
 	RECOIL_DETAILED_TRACY_ZONE;
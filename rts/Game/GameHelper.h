@@ -7,6 +7,7 @@
 #include "Sim/Units/CommandAI/Command.h"
 #include "Sim/Misc/GlobalConstants.h"
 #include "System/EventClient.h"
+#include "System/UnorderedMap.hpp"
 #include "System/float3.h"
 #include "System/float4.h"
 #include "System/type2.h"
@@ -148,7 +149,23 @@ public:
 		bool synced = false
 	);
 
+	struct WeaponTargetCandidate {
+		float priority; // excludes the TargetWeight and AllowWeaponTarget terms
+		CUnit* unit;
+		unsigned short losState;
+	};
+
 	static size_t GenerateWeaponTargets(const CWeapon* weapon, const CUnit* avoidUnit, std::vector<std::pair<float, CUnit*>>& targets);
+	/// thread-safe part of GenerateWeaponTargets: candidate gathering and engine-side scoring
+	static void GatherWeaponTargets(const CWeapon* weapon, const CUnit* avoidUnit, std::vector<WeaponTargetCandidate>& candidates, int thread);
+	/// serial part of GenerateWeaponTargets: script weights, Lua filtering and sorting
+	static size_t CommitWeaponTargets(const CWeapon* weapon, const std::vector<WeaponTargetCandidate>& candidates, std::vector<std::pair<float, CUnit*>>& targets);
+
+	/// runs GatherWeaponTargets on the thread-pool for the auto-targeting weapons of units[idxBeg, idxEnd)
+	void PrefetchWeaponTargets(const std::vector<CUnit*>& units, size_t idxBeg, size_t idxEnd);
+	/// hands out (once) the candidates prefetched for <weapon> if its avoidee did not change since
+	const std::vector<WeaponTargetCandidate>* GetPrefetchedWeaponTargets(const CWeapon* weapon, const CUnit* avoidUnit);
+	void ClearPrefetchedWeaponTargets();
 
 	void Init();
 	void Kill();
@@ -182,6 +199,17 @@ public:
 	void DamageObjectsInExplosionRadius(const CExplosionParams& params, const float expRad, const int weaponDefID);
 	void Explosion(const CExplosionParams& params);
 
+	/**
+	 * With modInfo.explosionDamageBatching, the area damage of explosions
+	 * between these calls is queued (everything else about them happens
+	 * right away) and applied by EndExplosionBatch in the same order.
+	 */
+	void BeginExplosionBatch();
+	void EndExplosionBatch();
+
+private:
+	void QueueExplosionDamage(const CExplosionParams& params, const float expRad, const int weaponDefID);
+
 private:
 	struct WaitingDamage {
 		WaitingDamage(const DamageArray& _damage, const float3& _impulse, int _attackerID, int _targetID, int _weaponID, int _projectileID)
@@ -202,12 +230,68 @@ private:
 		float3 impulse;
 	};
 	
+	struct QueuedExplosion {
+		float3 pos;
+		DamageArray damages;
+
+		CUnit* owner;
+
+		float radius;
+		float explosionSpeed;
+		float edgeEffectiveness;
+
+		int weaponDefID;
+		int projectileID;
+		int cluster;
+
+		bool ignoreOwner;
+	};
+
+	template<typename T> struct ClusterObject {
+		T* object;
+		float3 colVolPos;
+		float colVolRadius;
+	};
+
+	/// explosions starting in the same quad, their objects are gathered once
+	struct ExplosionCluster {
+		float3 mins;
+		float3 maxs;
+
+		int numExplosions;
+
+		std::vector<ClusterObject<CUnit>> units;
+		std::vector<ClusterObject<CFeature>> features;
+	};
+
+	struct PrefetchedWeaponTargets {
+		const CWeapon* weapon;
+		const CUnit* avoidUnit;
+		bool consumed;
+		std::vector<WeaponTargetCandidate> candidates;
+	};
+
 	std::array<std::vector<WaitingDamage>, 128> waitingDamages;
 	static_assert (std::has_single_bit(std::tuple_size_v <decltype(waitingDamages)>), "Size is used in bit hax and must be 2^N");
 
 public:
 	std::vector<int> targetUnitIDs; // GetEnemyUnits{NoLosTest}
 	std::vector<std::pair<float, CUnit*>> targetPairs; // GenerateWeaponTargets
+	std::vector<WeaponTargetCandidate> targetCandidates; // GenerateWeaponTargets
+
+private:
+	// entries beyond numPrefetchedTargets are kept around for their capacity
+	std::vector<PrefetchedWeaponTargets> prefetchedTargets;
+	spring::unordered_map<const CWeapon*, size_t> prefetchedTargetIndices;
+	size_t numPrefetchedTargets = 0;
+
+	// entries beyond numExplosionClusters are kept around for their capacity
+	std::vector<QueuedExplosion> queuedExplosions;
+	std::vector<ExplosionCluster> explosionClusters;
+	spring::unordered_map<int64_t, int> explosionClusterIndices;
+	size_t numExplosionClusters = 0;
+
+	bool batchExplosions = false;
 };
 
 extern CGameHelper* helper;
\ No newline at end of file
@@ -0,0 +1,182 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#include "LoadStageGraph.h"
+
+#include <cassert>
+#include <chrono>
+#include <cinttypes>
+
+#include "System/Log/ILog.h"
+#include "System/Platform/Watchdog.h"
+#include "System/Threading/SpringThreading.h"
+#include "System/Threading/ThreadPool.h"
+
+
+int CLoadStageGraph::AddStage(const char* name, StageFunc func, std::vector<int> deps, bool loadThread)
+{
+	const int id = static_cast<int>(stages.size());
+
+	for (const int dep: deps) {
+		// stages can only depend on earlier ones, which rules out cycles
+		assert(dep >= 0 && dep < id);
+	}
+
+	Stage& stage = stages.emplace_back();
+	stage.name = name;
+	stage.func = std::move(func);
+	stage.deps = std::move(deps);
+	stage.loadThread = loadThread;
+
+	return id;
+}
+
+
+CLoadStageGraph::StageState CLoadStageGraph::GetDepsState(const Stage& stage) const
+{
+	StageState state = STAGE_DONE;
+
+	for (const int dep: stage.deps) {
+		switch (stages[dep].state) {
+			case STAGE_DONE: {
+			} break;
+			case STAGE_FAILED:
+			case STAGE_SKIPPED: {
+				return STAGE_SKIPPED;
+			} break;
+			default: {
+				state = STAGE_PENDING;
+			} break;
+		}
+	}
+
+	return state;
+}
+
+
+void CLoadStageGraph::ExecStage(Stage& stage)
+{
+	stage.startTime = spring_gettime();
+
+	try {
+		stage.func();
+	} catch (...) {
+		stage.error = std::current_exception();
+	}
+
+	stage.endTime = spring_gettime();
+}
+
+void CLoadStageGraph::FinishStage(Stage& stage)
+{
+	stage.state = (stage.error == nullptr)? STAGE_DONE: STAGE_FAILED;
+	stage.job = {};
+
+	Watchdog::ClearTimer(WDT_LOAD);
+}
+
+
+bool CLoadStageGraph::WaitForJobs()
+{
+	while (true) {
+		bool running = false;
+		bool finished = false;
+
+		for (Stage& stage: stages) {
+			if (stage.state != STAGE_RUNNING)
+				continue;
+
+			running = true;
+
+			// deferred (rather than ready) if there is no thread-pool, get runs it
+			if (stage.job.wait_for(std::chrono::milliseconds(0)) == std::future_status::timeout)
+				continue;
+
+			stage.job.get();
+			FinishStage(stage);
+
+			finished = true;
+		}
+
+		if (!running || finished)
+			return running;
+
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+}
+
+
+void CLoadStageGraph::Run()
+{
+	runStartTime = spring_gettime();
+
+	while (true) {
+		Stage* loadThreadStage = nullptr;
+
+		for (Stage& stage: stages) {
+			if (stage.state != STAGE_PENDING)
+				continue;
+
+			switch (GetDepsState(stage)) {
+				case STAGE_SKIPPED: {
+					stage.state = STAGE_SKIPPED;
+				} break;
+				case STAGE_DONE: {
+					if (stage.loadThread) {
+						if (loadThreadStage == nullptr)
+							loadThreadStage = &stage;
+
+						break;
+					}
+
+					stage.state = STAGE_RUNNING;
+					stage.job = ThreadPool::Enqueue([&stage]() { ExecStage(stage); });
+				} break;
+				default: {
+				} break;
+			}
+		}
+
+		// pool jobs enqueued above run meanwhile
+		if (loadThreadStage != nullptr) {
+			loadThreadStage->state = STAGE_RUNNING;
+
+			ExecStage(*loadThreadStage);
+			FinishStage(*loadThreadStage);
+			continue;
+		}
+
+		if (!WaitForJobs())
+			break;
+	}
+
+	runEndTime = spring_gettime();
+
+	for (const Stage& stage: stages) {
+		assert(stage.state == STAGE_DONE || stage.state == STAGE_FAILED || stage.state == STAGE_SKIPPED);
+
+		if (stage.error != nullptr)
+			std::rethrow_exception(stage.error);
+	}
+}
+
+
+void CLoadStageGraph::LogTimings(const char* caller) const
+{
+	int64_t sumTime = 0;
+
+	for (const Stage& stage: stages) {
+		if (stage.state != STAGE_DONE && stage.state != STAGE_FAILED) {
+			LOG("[%s] stage \"%s\" skipped", caller, stage.name);
+			continue;
+		}
+
+		const int64_t startTime = (stage.startTime - runStartTime).toMilliSecsi();
+		const int64_t execTime = (stage.endTime - stage.startTime).toMilliSecsi();
+
+		sumTime += execTime;
+
+		LOG("[%s] stage \"%s\" took %" PRId64 "ms (started at +%" PRId64 "ms%s)", caller, stage.name, execTime, startTime, stage.loadThread? ", load-thread": "");
+	}
+
+	LOG("[%s] %u stages took %" PRId64 "ms (%" PRId64 "ms sequentially)", caller, static_cast<unsigned>(stages.size()), (runEndTime - runStartTime).toMilliSecsi(), sumTime);
+}
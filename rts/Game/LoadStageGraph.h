@@ -0,0 +1,77 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#ifndef LOAD_STAGE_GRAPH_H
+#define LOAD_STAGE_GRAPH_H
+
+#include <exception>
+#include <functional>
+#include <future>
+#include <vector>
+
+#include "System/Misc/SpringTime.h"
+
+/**
+ * @brief Runs loading stages as soon as the stages they depend on are done
+ *
+ * Stages flagged as load-thread stages (anything touching GL, or systems
+ * that are not thread-safe) run on the thread calling Run, in the order
+ * they were added; all others are handed to the thread-pool as soon as
+ * they become ready, so independent stages overlap.
+ *
+ * A stage whose dependency failed is skipped. Run returns when every stage
+ * finished or was skipped and then rethrows the first error, such that no
+ * job is still referencing the caller's state.
+ */
+class CLoadStageGraph
+{
+public:
+	typedef std::function<void()> StageFunc;
+
+	/// @param deps ids returned by earlier AddStage calls
+	/// @return the id of the new stage
+	int AddStage(const char* name, StageFunc func, std::vector<int> deps = {}, bool loadThread = false);
+
+	void Run();
+	void LogTimings(const char* caller) const;
+
+private:
+	enum StageState {
+		STAGE_PENDING = 0,
+		STAGE_RUNNING = 1,
+		STAGE_DONE    = 2,
+		STAGE_FAILED  = 3,
+		STAGE_SKIPPED = 4,
+	};
+
+	struct Stage {
+		const char* name;
+
+		StageFunc func;
+		std::vector<int> deps;
+		std::shared_future<void> job;
+		std::exception_ptr error;
+
+		spring_time startTime;
+		spring_time endTime;
+
+		StageState state = STAGE_PENDING;
+		bool loadThread = false;
+	};
+
+	/// STAGE_DONE if the stage can start, STAGE_PENDING if it has to wait or STAGE_SKIPPED
+	StageState GetDepsState(const Stage& stage) const;
+
+	static void ExecStage(Stage& stage);
+	void FinishStage(Stage& stage);
+
+	/// waits until at least one pool job finished, false if none is running
+	bool WaitForJobs();
+
+private:
+	std::vector<Stage> stages;
+
+	spring_time runStartTime;
+	spring_time runEndTime;
+};
+
+#endif // LOAD_STAGE_GRAPH_H
@@ -33,6 +33,7 @@
 #include "Sim/Misc/GlobalConstants.h"
 #include "Sim/Misc/TeamHandler.h"
 #include "System/Config/ConfigHandler.h"
+#include "System/CRC.h"
 #include "System/Exceptions.h"
 #include "System/SafeUtil.h"
 #include "System/SpringExitCode.h"
@@ -44,6 +45,7 @@
 #include "System/FileSystem/VFSHandler.h"
 #include "System/LoadSave/DemoRecorder.h"
 #include "System/LoadSave/DemoReader.h"
+#include "System/LoadSave/CregLoadSaveHandler.h"
 #include "System/LoadSave/LoadSaveHandler.h"
 #include "System/Log/ILog.h"
 #include "System/Net/RawPacket.h"
@@ -447,6 +449,58 @@ void CPreGame::UpdateClientNet()
 				);
 			} break;
 
+			case NETMSG_GAMESTATE_SNAPSHOT: {
+				// sent between NETMSG_GAMEDATA and NETMSG_SETPLAYERNUM if the
+				// game is running and the server lets us start from a snapshot
+				// taken by another client instead of replaying it from frame 0
+				try {
+					constexpr uint32_t headerSize = sizeof(uint8_t) + sizeof(uint16_t) + sizeof(uint8_t) + sizeof(int32_t) * 2 + sizeof(uint32_t) * 3;
+
+					netcode::UnpackPacket pckt(packet, sizeof(uint8_t) + sizeof(uint16_t) + sizeof(uint8_t) + sizeof(int32_t));
+
+					int32_t frameNum;
+					uint32_t checksum;
+					uint32_t totalSize;
+					uint32_t offset;
+
+					pckt >> frameNum;
+					pckt >> checksum;
+					pckt >> totalSize;
+					pckt >> offset;
+
+					if (offset != snapshotData.size() || packet->length < headerSize)
+						throw content_error("Invalid game-state snapshot received from server");
+
+					std::vector<uint8_t> chunk(packet->length - headerSize);
+					pckt >> chunk;
+
+					snapshotData.insert(snapshotData.end(), chunk.begin(), chunk.end());
+
+					if (snapshotData.size() < totalSize)
+						break;
+
+					if (CRC::CalcDigest(snapshotData.data(), snapshotData.size()) != checksum)
+						throw content_error("Corrupt game-state snapshot received from server");
+
+					CCregLoadSaveHandler* snapshotHandler = new CCregLoadSaveHandler();
+
+					if (!snapshotHandler->LoadSnapshot(snapshotData)) {
+						delete snapshotHandler;
+						throw content_error("Incompatible game-state snapshot received from server");
+					}
+
+					LOG("[PreGame::%s] received game-state snapshot for frame %d (%u bytes)", __func__, frameNum, totalSize);
+
+					// a demo without the frames before the snapshot can not be replayed
+					clientNet->ResetDemoRecorder();
+
+					saveFileHandler = snapshotHandler;
+					snapshotData = {};
+				} catch (const netcode::UnpackPacketException& ex) {
+					LOG_L(L_ERROR, "[PreGame::%s][NETMSG_GAMESTATE_SNAPSHOT] exception \"%s\"", __func__, ex.what());
+				}
+			} break;
+
 			case NETMSG_SETPLAYERNUM: {
 				// this is sent after NETMSG_GAMEDATA, to let us know which
 				// player number we have (server assigns them based on order
@@ -6,6 +6,7 @@
 #include <string>
 #include <memory>
 #include <future>
+#include <vector>
 
 #include "GameController.h"
 #include "System/Misc/SpringTime.h"
@@ -83,6 +84,9 @@ private:
 	std::string modFileName;
 	ILoadSaveHandler* saveFileHandler;
 
+	/// NETMSG_GAMESTATE_SNAPSHOT chunks received so far
+	std::vector<uint8_t> snapshotData;
+
 	spring_time connectTimer;
 
 	bool wantDemo;
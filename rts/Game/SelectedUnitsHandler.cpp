@@ -64,6 +64,8 @@ void CSelectedUnitsHandler::Init(unsigned numPlayers)
 	autoAddBuiltUnitsToSelectedGroup = configHandler->GetBool("AutoAddBuiltUnitsToSelectedGroup");
 
 	netSelected.resize(numPlayers);
+	sentUnitIDs.clear();
+	sentSelectionValid = false;
 }
 
 
@@ -760,6 +762,10 @@ void CSelectedUnitsHandler::ClearNetSelect(int playerId)
 {
 	RECOIL_DETAILED_TRACY_ZONE;
 	netSelected[playerId].clear();
+
+	// the remote copy is gone, next SendSelect has to transmit even an unchanged selection
+	if (playerId == gu->myPlayerNum)
+		sentSelectionValid = false;
 }
 
 // handles NETMSG_AICOMMAND{S}'s sent by AICallback / LuaUnsyncedCtrl (!)
@@ -1045,8 +1051,17 @@ void CSelectedUnitsHandler::SendSelect()
 		selectedUnitIDs.resize(selectedUnits.size(), 0);
 
 		std::copy(selectedUnits.begin(), selectedUnits.end(), selectedUnitIDs.begin());
+		// hash-set order depends on insertion history, sorting makes equal selections compare equal
+		std::sort(selectedUnitIDs.begin(), selectedUnitIDs.end());
+
+		// re-selecting the same units (or losing none of them) leaves the remote state unchanged
+		if (!sentSelectionValid || selectedUnitIDs != sentUnitIDs) {
+			clientNet->Send(CBaseNetProtocol::Get().SendSelect(gu->myPlayerNum, selectedUnitIDs));
+
+			sentUnitIDs = selectedUnitIDs;
+			sentSelectionValid = true;
+		}
 
-		clientNet->Send(CBaseNetProtocol::Get().SendSelect(gu->myPlayerNum, selectedUnitIDs));
 		selectionChanged = false;
 	}
 }
@@ -91,6 +91,10 @@ public:
 private:
 	// buffer for SendCommand unordered_set->vector conversion
 	std::vector<int16_t> selectedUnitIDs;
+	// last selection sent via NETMSG_SELECT, as seen by the other clients
+	std::vector<int16_t> sentUnitIDs;
+
+	bool sentSelectionValid = false;
 };
 
 extern CSelectedUnitsHandler selectedUnitsHandler;
@@ -0,0 +1,141 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+
+#include <json/json.h>
+#include <json/writer.h>
+
+#include "SimBenchmark.h"
+#include "Game.h"
+#include "GameSetup.h"
+#include "GameVersion.h"
+#include "GlobalUnsynced.h"
+#include "Net/Protocol/BaseNetProtocol.h"
+#include "Net/Protocol/NetProtocol.h"
+#include "Sim/Misc/GlobalSynced.h"
+#include "System/MemPoolStats.h"
+#include "System/StringUtil.h"
+#include "System/TimeProfiler.h"
+#include "System/Log/ILog.h"
+
+#include "System/Misc/TracyDefs.h"
+
+
+void CSimBenchmark::SetParams(int _numFrames, const std::string& _reportFile, const std::string& _commandsFile)
+{
+	numFrames = std::max(_numFrames, 0);
+	reportFile = _reportFile;
+	commandsFile = _commandsFile;
+}
+
+void CSimBenchmark::GameStart()
+{
+	RECOIL_DETAILED_TRACY_ZONE;
+	if (!IsEnabled())
+		return;
+
+	LOG("[SimBenchmark::%s] running %d frames, report goes to \"%s\"", __func__, numFrames, reportFile.c_str());
+
+	// collect all timers from here on, not just the special ones
+	CTimeProfiler& profiler = CTimeProfiler::GetInstance();
+	profiler.ResetState();
+	profiler.SetEnabled(true);
+
+	// the server clamps this to the start script's MaxSpeed
+	clientNet->Send(CBaseNetProtocol::Get().SendUserSpeed(gu->myPlayerNum, gameSetup->maxSpeed));
+
+	IssueCommands();
+
+	startFrame = gs->frameNum + 1;
+	startTime = spring_gettime();
+}
+
+void CSimBenchmark::SimFrame(int frameNum)
+{
+	if (!IsEnabled() || finished)
+		return;
+	if ((frameNum - startFrame + 1) < numFrames)
+		return;
+
+	WriteReport(frameNum - startFrame + 1);
+
+	finished = true;
+	gu->globalQuit = true;
+}
+
+
+void CSimBenchmark::IssueCommands()
+{
+	if (commandsFile.empty())
+		return;
+
+	std::ifstream file(commandsFile);
+
+	if (!file.good()) {
+		LOG_L(L_ERROR, "[SimBenchmark::%s] could not open \"%s\"", __func__, commandsFile.c_str());
+		return;
+	}
+
+	std::string line;
+
+	while (std::getline(file, line)) {
+		line = StringTrim(line);
+
+		if (line.empty() || line[0] == '#')
+			continue;
+
+		// same path as typed chat commands
+		game->ProcessCommandText((line[0] == '/')? line: ("/" + line));
+	}
+}
+
+void CSimBenchmark::WriteReport(int numSimFrames)
+{
+	const float wallTimeMs = (spring_gettime() - startTime).toMilliSecsf();
+
+	Json::Value root;
+
+	root["engine"] = SpringVersion::GetFull();
+	root["map"] = gameSetup->mapName;
+	root["game"] = gameSetup->modName;
+	root["frames"] = numSimFrames;
+	root["wallTimeMs"] = wallTimeMs;
+	root["simFramesPerSecond"] = numSimFrames * 1000.0f / std::max(wallTimeMs, 1.0f);
+
+	Json::Value& timers = root["timers"] = Json::objectValue;
+
+	for (const auto& [name, record]: CTimeProfiler::GetInstance().GetProfilesSnapshot()) {
+		Json::Value& timer = timers[name];
+
+		timer["count"] = Json::UInt64(record.count);
+		timer["totalMs"] = record.total.toMilliSecsf();
+		timer["peakMs"] = record.peak.toMilliSecsf();
+		timer["avgMs"] = record.total.toMilliSecsf() / std::max(record.count, uint64_t(1));
+		timer["perFrameMs"] = record.total.toMilliSecsf() / numSimFrames;
+	}
+
+	Json::Value& memPools = root["memPools"] = Json::objectValue;
+
+	MemPoolRegistry::Update();
+
+	for (const MemPoolStats& stats: MemPoolRegistry::GetStats()) {
+		Json::Value& pool = memPools[stats.name];
+
+		pool["liveBytes"] = Json::UInt64(stats.liveBytes);
+		pool["peakBytes"] = Json::UInt64(stats.peakBytes);
+		pool["reservedBytes"] = Json::UInt64(stats.reservedBytes);
+	}
+
+	std::ofstream file(reportFile);
+
+	if (!file.good()) {
+		LOG_L(L_ERROR, "[SimBenchmark::%s] could not write \"%s\"", __func__, reportFile.c_str());
+		return;
+	}
+
+	file << Json::StyledWriter().write(root);
+
+	LOG("[SimBenchmark::%s] %d frames in %.1fs (%.1f frames/s), report written to \"%s\"", __func__, numSimFrames, wallTimeMs * 0.001f, root["simFramesPerSecond"].asFloat(), reportFile.c_str());
+}
@@ -0,0 +1,45 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#ifndef SIM_BENCHMARK_H
+#define SIM_BENCHMARK_H
+
+#include <string>
+
+#include "System/Misc/SpringTime.h"
+
+/**
+ * Headless benchmark mode (--benchmark-frames): once the game starts the
+ * profiler is enabled for every timer, the sim is run at the maximum speed
+ * the start script allows and an optional list of actions is issued (e.g.
+ * cheat + give to set up a scenario). After the requested number of frames
+ * the per-timer statistics are written to a JSON report and the engine quits.
+ *
+ * See tools/benchmark for scenarios and the comparison script.
+ */
+class CSimBenchmark {
+public:
+	static void SetParams(int numFrames, const std::string& reportFile, const std::string& commandsFile);
+	static bool IsEnabled() { return (numFrames > 0); }
+
+	/// called by CGame::StartPlaying
+	static void GameStart();
+	/// called at the end of CGame::SimFrame
+	static void SimFrame(int frameNum);
+
+private:
+	static void IssueCommands();
+	static void WriteReport(int numSimFrames);
+
+private:
+	static inline int numFrames = 0;
+	static inline int startFrame = 0;
+
+	static inline bool finished = false;
+
+	static inline std::string reportFile;
+	static inline std::string commandsFile;
+
+	static inline spring_time startTime;
+};
+
+#endif
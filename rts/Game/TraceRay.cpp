@@ -10,6 +10,7 @@
 #include "Sim/Misc/CollisionHandler.h"
 #include "Sim/Misc/CollisionVolume.h"
 #include "Sim/Misc/GeometricObjects.h"
+#include "Sim/Misc/GlobalSynced.h"
 #include "Sim/Misc/LosHandler.h"
 #include "Sim/Misc/QuadField.h"
 #include "Sim/Misc/TeamHandler.h"
@@ -20,8 +21,11 @@
 #include "Sim/Weapons/WeaponDef.h"
 #include "System/GlobalConfig.h"
 #include "System/SpringMath.h"
+#include "System/Platform/Threading.h"
+#include "System/Threading/ThreadPool.h"
 
 #include <algorithm>
+#include <array>
 #include <vector>
 
 #include "System/Misc/TracyDefs.h"
@@ -183,6 +187,99 @@ inline static bool TestTrajectoryConeHelper(
 }
 
 
+/**
+ * the bits here and in Test*Cone are interpreted as "do not scan for {enemy,friendly,...}
+ * objects in quads" rather than "return false if ray hits an {enemy,friendly,...} object"
+ * consequently a weapon with (e.g.) avoidFriendly=true that wants to check whether it has
+ * a free line of fire should *not* set the NOFRIENDLIES bit in its trace-flags, etc
+ */
+struct SRayScanFlags {
+	SRayScanFlags(int traceFlags)
+		: enemies ((traceFlags & Collision::NOENEMIES   ) == 0)
+		, allies  ((traceFlags & Collision::NOFRIENDLIES) == 0)
+		, features((traceFlags & Collision::NOFEATURES  ) == 0)
+		, neutrals((traceFlags & Collision::NONEUTRALS  ) == 0)
+		, ground  ((traceFlags & Collision::NOGROUND    ) == 0)
+		, cloaked ((traceFlags & Collision::NOCLOAKED   ) == 0)
+	{}
+
+	bool AnyUnits() const { return (enemies || allies || neutrals || cloaked); }
+
+	bool enemies;
+	bool allies;
+	bool features;
+	bool neutrals;
+	bool ground;
+	bool cloaked;
+};
+
+inline static bool IsRayFeature(const CFeature* f)
+{
+	// NOTE:
+	//   if f is non-blocking, ProjectileHandler will not test
+	//   for collisions with projectiles so we can skip it here
+	return (f->HasCollidableStateBit(CSolidObject::CSTATE_BIT_QUADMAPRAYS));
+}
+
+inline static bool IsRayUnit(const CUnit* u, const CUnit* owner, const SRayScanFlags& scanFlags)
+{
+	if (u == owner)
+		return false;
+
+	if (!u->HasCollidableStateBit(CSolidObject::CSTATE_BIT_QUADMAPRAYS))
+		return false;
+
+	bool doHitTest = false;
+
+	doHitTest |= (scanFlags.allies   && u->allyteam == owner->allyteam);
+	doHitTest |= (scanFlags.enemies  && u->allyteam != owner->allyteam);
+	doHitTest |= (scanFlags.neutrals && u->IsNeutral());
+	doHitTest |= (scanFlags.cloaked  && u->IsCloaked());
+
+	return doHitTest;
+}
+
+/**
+ * helper for the TraceRay's
+ * @return true (and shortens traceLength) if the ray hits <o> closer than traceLength
+ */
+template<typename T>
+inline static bool TestRayHit(
+	const T* o,
+	const float3& pos,
+	const float3& dir,
+	float& traceLength,
+	CollisionQuery& cq,
+	CollisionQuery* hitColQuery
+) {
+	if (!CCollisionHandler::DetectHit(o, o->GetTransformMatrix(true), pos, pos + dir * traceLength, &cq, true))
+		return false;
+
+	const float len = cq.GetHitPosDist(pos, dir);
+
+	// we want the closest object (intersection point) on the ray
+	if (len >= traceLength)
+		return false;
+
+	traceLength = len;
+
+	*hitColQuery = cq;
+	return true;
+}
+
+inline static void TestRayGround(const float3& pos, const float3& dir, float& traceLength, CUnit*& hitUnit, CFeature*& hitFeature)
+{
+	const float groundLength = CGround::LineGroundCol(pos, pos + dir * traceLength);
+
+	if (traceLength > groundLength && groundLength > 0.0f) {
+		traceLength = groundLength;
+
+		hitUnit = nullptr;
+		hitFeature = nullptr;
+	}
+}
+
+
 
 //////////////////////////////////////////////////////////////////////
 // Raytracing
@@ -209,19 +306,7 @@ float TraceRay(
 	CollisionQuery* hitColQuery
 ) {
 	RECOIL_DETAILED_TRACY_ZONE;
-	// NOTE:
-	//   the bits here and in Test*Cone are interpreted as "do not scan for {enemy,friendly,...}
-	//   objects in quads" rather than "return false if ray hits an {enemy,friendly,...} object"
-	//   consequently a weapon with (e.g.) avoidFriendly=true that wants to check whether it has
-	//   a free line of fire should *not* set the NOFRIENDLIES bit in its trace-flags, etc
-	const bool scanForEnemies  = ((traceFlags & Collision::NOENEMIES   ) == 0);
-	const bool scanForAllies   = ((traceFlags & Collision::NOFRIENDLIES) == 0);
-	const bool scanForFeatures = ((traceFlags & Collision::NOFEATURES  ) == 0);
-	const bool scanForNeutrals = ((traceFlags & Collision::NONEUTRALS  ) == 0);
-	const bool scanForGround   = ((traceFlags & Collision::NOGROUND    ) == 0);
-	const bool scanForCloaked  = ((traceFlags & Collision::NOCLOAKED   ) == 0);
-
-	const bool scanForAnyUnits = scanForEnemies || scanForAllies || scanForNeutrals || scanForCloaked;
+	const SRayScanFlags scanFlags(traceFlags);
 
 	hitFeature = nullptr;
 	hitUnit = nullptr;
@@ -229,7 +314,7 @@ float TraceRay(
 	if (dir == ZeroVector)
 		return -1.0f;
 
-	if (scanForFeatures || scanForAnyUnits) {
+	if (scanFlags.features || scanFlags.AnyUnits()) {
 		CollisionQuery cq;
 
 		QuadFieldQuery qfQuery;
@@ -241,90 +326,159 @@ float TraceRay(
 			hitColQuery = &cq;
 
 		// feature intersection
-		if (scanForFeatures) {
+		if (scanFlags.features) {
 			for (const int quadIdx: *qfQuery.quads) {
 				const CQuadField::Quad& quad = quadField.GetQuad(quadIdx);
 
 				for (CFeature* f: quad.features) {
-					// NOTE:
-					//   if f is non-blocking, ProjectileHandler will not test
-					//   for collisions with projectiles so we can skip it here
-					if (!f->HasCollidableStateBit(CSolidObject::CSTATE_BIT_QUADMAPRAYS))
+					if (!IsRayFeature(f))
 						continue;
 
-					if (CCollisionHandler::DetectHit(f, f->GetTransformMatrix(true), pos, pos + dir * traceLength, &cq, true)) {
-						const float len = cq.GetHitPosDist(pos, dir);
-
-						// we want the closest feature (intersection point) on the ray
-						if (len >= traceLength)
-							continue;
-
-						traceLength = len;
-
+					if (TestRayHit(f, pos, dir, traceLength, cq, hitColQuery))
 						hitFeature = f;
-						*hitColQuery = cq;
-					}
 				}
 			}
 		}
 
 		// unit intersection
-		if (scanForAnyUnits) {
+		if (scanFlags.AnyUnits()) {
 			for (const int quadIdx: *qfQuery.quads) {
 				const CQuadField::Quad& quad = quadField.GetQuad(quadIdx);
 
 				for (CUnit* u: quad.units) {
-					if (u == owner)
+					if (!IsRayUnit(u, owner, scanFlags))
 						continue;
 
-					if (!u->HasCollidableStateBit(CSolidObject::CSTATE_BIT_QUADMAPRAYS))
-						continue;
+					if (TestRayHit(u, pos, dir, traceLength, cq, hitColQuery))
+						hitUnit = u;
+				}
+			}
 
-					bool doHitTest = false;
+			// units override features, so feature != null implies no unit was hit
+			if (hitUnit != nullptr)
+				hitFeature = nullptr;
 
-					doHitTest |= (scanForAllies   && u->allyteam == owner->allyteam);
-					doHitTest |= (scanForEnemies  && u->allyteam != owner->allyteam);
-					doHitTest |= (scanForNeutrals && u->IsNeutral());
-					doHitTest |= (scanForCloaked  && u->IsCloaked());
+		}
+	}
 
-					if (!doHitTest)
-						continue;
+	if (scanFlags.ground)
+		TestRayGround(pos, dir, traceLength, hitUnit, hitFeature);
 
-					if (CCollisionHandler::DetectHit(u, u->GetTransformMatrix(true), pos, pos + dir * traceLength, &cq, true)) {
-						const float len = cq.GetHitPosDist(pos, dir);
+	// no intersection if no decrease in length
+	return traceLength;
+}
 
-						// we want the closest unit (intersection point) on the ray
-						if (len >= traceLength)
-							continue;
 
-						traceLength = len;
+void GatherRayCandidates(
+	const float3& pos,
+	const float3& dir,
+	float traceLength,
+	int traceFlags,
+	const CUnit* owner,
+	SRayCandidates& candidates,
+	int threadOwner
+) {
+	RECOIL_DETAILED_TRACY_ZONE;
+	static std::array<CollisionSphereBatch, ThreadPool::MAX_THREADS> hitTestSpheres;
+	static std::array<std::vector<uint32_t>, ThreadPool::MAX_THREADS> hitTestIndices;
 
-						hitUnit = u;
-						*hitColQuery = cq;
-					}
-				}
+	const SRayScanFlags scanFlags(traceFlags);
+
+	candidates.features.clear();
+	candidates.units.clear();
+
+	if (dir == ZeroVector)
+		return;
+	if (!scanFlags.features && !scanFlags.AnyUnits())
+		return;
+
+	QuadFieldQuery qfQuery;
+	qfQuery.threadOwner = threadOwner;
+	quadField.GetQuadsOnRay(qfQuery, pos, dir, traceLength);
+
+	CollisionSphereBatch& spheres = hitTestSpheres[threadOwner];
+	std::vector<uint32_t>& indices = hitTestIndices[threadOwner];
+
+	// keeps the objects (in quad order, duplicates included) whose hit-test
+	// sphere the full-length segment touches; TraceRay only ever shortens it
+	const auto CullObjects = [&](auto& objects) {
+		spheres.Clear();
+
+		for (const auto* o: objects)
+			spheres.Add(CCollisionHandler::GetHitTestSphere(o));
+
+		const size_t numIndices = CCollisionHandler::SegmentSpheresOverlap(pos, pos + dir * traceLength, spheres, indices);
+
+		for (size_t i = 0; i < numIndices; i++)
+			objects[i] = objects[indices[i]];
+
+		objects.resize(numIndices);
+	};
+
+	if (scanFlags.features) {
+		for (const int quadIdx: *qfQuery.quads) {
+			for (CFeature* f: quadField.GetQuad(quadIdx).features) {
+				if (IsRayFeature(f))
+					candidates.features.push_back(f);
 			}
+		}
 
-			// units override features, so feature != null implies no unit was hit
-			if (hitUnit != nullptr)
-				hitFeature = nullptr;
+		CullObjects(candidates.features);
+	}
 
+	if (scanFlags.AnyUnits()) {
+		for (const int quadIdx: *qfQuery.quads) {
+			for (CUnit* u: quadField.GetQuad(quadIdx).units) {
+				if (IsRayUnit(u, owner, scanFlags))
+					candidates.units.push_back(u);
+			}
 		}
+
+		CullObjects(candidates.units);
 	}
+}
 
-	if (scanForGround) {
-		// ground intersection
-		const float groundLength = CGround::LineGroundCol(pos, pos + dir * traceLength);
+float TraceRayCandidates(
+	const float3& pos,
+	const float3& dir,
+	float traceLength,
+	int traceFlags,
+	const CUnit* owner,
+	const SRayCandidates& candidates,
+	CUnit*& hitUnit,
+	CFeature*& hitFeature,
+	CollisionQuery* hitColQuery
+) {
+	RECOIL_DETAILED_TRACY_ZONE;
+	const SRayScanFlags scanFlags(traceFlags);
 
-		if (traceLength > groundLength && groundLength > 0.0f) {
-			traceLength = groundLength;
+	CollisionQuery cq;
 
-			hitUnit = nullptr;
-			hitFeature = nullptr;
-		}
+	hitFeature = nullptr;
+	hitUnit = nullptr;
+
+	if (dir == ZeroVector)
+		return -1.0f;
+
+	if (hitColQuery == nullptr)
+		hitColQuery = &cq;
+
+	// candidates are pre-filtered, only the narrow-phase tests remain
+	for (CFeature* f: candidates.features) {
+		if (TestRayHit(f, pos, dir, traceLength, cq, hitColQuery))
+			hitFeature = f;
+	}
+	for (CUnit* u: candidates.units) {
+		if (TestRayHit(u, pos, dir, traceLength, cq, hitColQuery))
+			hitUnit = u;
 	}
 
-	// no intersection if no decrease in length
+	if (hitUnit != nullptr)
+		hitFeature = nullptr;
+
+	if (scanFlags.ground)
+		TestRayGround(pos, dir, traceLength, hitUnit, hitFeature);
+
 	return traceLength;
 }
 
@@ -368,7 +522,7 @@ void TraceRayShields(
 }
 
 
-float GuiTraceRay(
+static float GuiTraceRayImpl(
 	const float3& start,
 	const float3& dir,
 	const float length,
@@ -379,7 +533,6 @@ float GuiTraceRay(
 	bool groundOnly,
 	bool ignoreWater
 ) {
-	RECOIL_DETAILED_TRACY_ZONE;
 	hitUnit = nullptr;
 	hitFeature = nullptr;
 
@@ -523,6 +676,90 @@ float GuiTraceRay(
 	return minIngressDist;
 }
 
+float GuiTraceRay(
+	const float3& start,
+	const float3& dir,
+	const float length,
+	const CUnit* exclude,
+	const CUnit*& hitUnit,
+	const CFeature*& hitFeature,
+	bool useRadar,
+	bool groundOnly,
+	bool ignoreWater
+) {
+	RECOIL_DETAILED_TRACY_ZONE;
+
+	// the mouse and gui handlers, the uniform constants and Lua all trace the
+	// same mouse ray during a draw frame; the answer only changes with the sim
+	// state (or the viewer's allyteam), so repeated traces reuse the result
+	struct GuiTrace {
+		float3 start;
+		float3 dir;
+		float length;
+
+		const CUnit* exclude;
+		const CUnit* hitUnit;
+		const CFeature* hitFeature;
+
+		float result;
+
+		bool useRadar;
+		bool groundOnly;
+		bool ignoreWater;
+		bool spectatingFullView;
+
+		int allyTeam;
+		int simFrame = -1; // never matches before the first trace
+		unsigned int drawFrame;
+		unsigned int numQuadChanges;
+	};
+
+	static std::array<GuiTrace, 8> cachedTraces = {};
+	static size_t cachedTraceIdx = 0;
+
+	if (!Threading::IsMainThread())
+		return (GuiTraceRayImpl(start, dir, length, exclude, hitUnit, hitFeature, useRadar, groundOnly, ignoreWater));
+
+	const auto IsSameTrace = [&](const GuiTrace& t) {
+		return
+			t.drawFrame == globalRendering->drawFrame &&
+			t.simFrame == gs->frameNum &&
+			t.numQuadChanges == quadField.GetNumQuadChanges() &&
+			t.allyTeam == gu->myAllyTeam &&
+			t.spectatingFullView == gu->spectatingFullView &&
+			t.start == start && t.dir == dir && t.length == length &&
+			t.exclude == exclude &&
+			t.useRadar == useRadar && t.groundOnly == groundOnly && t.ignoreWater == ignoreWater;
+	};
+
+	if (const auto it = std::find_if(cachedTraces.begin(), cachedTraces.end(), IsSameTrace); it != cachedTraces.end()) {
+		hitUnit = it->hitUnit;
+		hitFeature = it->hitFeature;
+		return it->result;
+	}
+
+	GuiTrace& t = cachedTraces[cachedTraceIdx];
+	cachedTraceIdx = (cachedTraceIdx + 1) % cachedTraces.size();
+
+	t.start = start;
+	t.dir = dir;
+	t.length = length;
+	t.exclude = exclude;
+	t.useRadar = useRadar;
+	t.groundOnly = groundOnly;
+	t.ignoreWater = ignoreWater;
+	t.spectatingFullView = gu->spectatingFullView;
+	t.allyTeam = gu->myAllyTeam;
+	t.simFrame = gs->frameNum;
+	t.drawFrame = globalRendering->drawFrame;
+	t.numQuadChanges = quadField.GetNumQuadChanges();
+	t.result = GuiTraceRayImpl(start, dir, length, exclude, hitUnit, hitFeature, useRadar, groundOnly, ignoreWater);
+	t.hitUnit = hitUnit;
+	t.hitFeature = hitFeature;
+
+	return t.result;
+}
+
 
 bool TestCone(
 	const float3& from,
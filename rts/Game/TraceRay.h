@@ -55,6 +55,42 @@ namespace TraceRay {
 		CollisionQuery* hitColQuery
 	);
 
+	/// the objects a TraceRay call would run narrow-phase tests against
+	struct SRayCandidates {
+		std::vector<CFeature*> features;
+		std::vector<CUnit*> units;
+	};
+
+	/**
+	 * Broad-phase half of TraceRay: only reads the quadfield and the objects'
+	 * positions, so rays can be gathered from pool threads while nothing moves
+	 * (each passing its ThreadPool::GetThreadNum() as <threadOwner>).
+	 */
+	void GatherRayCandidates(
+		const float3& pos,
+		const float3& dir,
+		float traceLength,
+		int traceFlags,
+		const CUnit* owner,
+		SRayCandidates& candidates,
+		int threadOwner = 0
+	);
+	/**
+	 * Narrow-phase half of TraceRay; gives the same result as TraceRay with
+	 * the same arguments if no object moved since <candidates> was gathered.
+	 */
+	float TraceRayCandidates(
+		const float3& pos,
+		const float3& dir,
+		float traceLength,
+		int traceFlags,
+		const CUnit* owner,
+		const SRayCandidates& candidates,
+		CUnit*& hitUnit,
+		CFeature*& hitFeature,
+		CollisionQuery* hitColQuery = nullptr
+	);
+
 	void TraceRayShields(
 		const CWeapon* emitter,
 		const float3& start,
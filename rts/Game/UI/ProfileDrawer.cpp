@@ -21,6 +21,7 @@
 #include "Sim/Projectiles/ProjectileMemPool.h"
 #include "Sim/Weapons/WeaponMemPool.h"
 #include "System/EventHandler.h"
+#include "System/MemPoolStats.h"
 #include "System/TimeProfiler.h"
 #include "System/Threading/ThreadPool.h"
 #include "System/SafeUtil.h"
@@ -209,8 +210,23 @@ static void DrawThreadBarcode(TypedRenderBuffer<VA_TYPE_C   >& rb)
 		rb.AddVertex({{drawArea[0] - 10.0f * globalRendering->pixelX, drawArea[1] - 10.0f * globalRendering->pixelY, 0.0f}, barColor}); // tl
 	}
 	{
-		// title
-		font->glFormat(drawArea[0], drawArea[3], 0.7f, FONT_TOP | DBG_FONT_FLAGS | FONT_BUFFERED, "ThreadPool (%.1f seconds :: %u threads)", MAX_THREAD_HIST_TIME, numThreads);
+		// title, with the pool's average load over the last second (per-thread values are in Tracy and /debuginfo threadpool)
+		ThreadPool::ThreadLoad avgLoad;
+
+		for (int i = 0, n = ThreadPool::GetNumThreads(); i < n; i++) {
+			const ThreadPool::ThreadLoad load = ThreadPool::GetThreadLoad(i);
+
+			avgLoad.busy  += load.busy  * 100.0f / n;
+			avgLoad.steal += load.steal * 100.0f / n;
+			avgLoad.spin  += load.spin  * 100.0f / n;
+			avgLoad.sleep += load.sleep * 100.0f / n;
+		}
+
+		font->glFormat(
+			drawArea[0], drawArea[3], 0.7f, FONT_TOP | DBG_FONT_FLAGS | FONT_BUFFERED,
+			"ThreadPool (%.1f seconds :: %u threads :: busy %.0f%% steal %.0f%% spin %.0f%% sleep %.0f%% :: %u queued)",
+			MAX_THREAD_HIST_TIME, numThreads, avgLoad.busy, avgLoad.steal, avgLoad.spin, avgLoad.sleep, static_cast<uint32_t>(ThreadPool::GetQueueDepth())
+		);
 	}
 	{
 		// Need to lock; CleanupOldThreadProfiles pop_front()'s old entries
@@ -467,10 +483,10 @@ static void DrawInfoText(TypedRenderBuffer<VA_TYPE_C   >& rb)
 	// background
 
 	rb.AddVertex({{             0.01f - 10.0f * globalRendering->pixelX, 0.02f - 10.0f * globalRendering->pixelY, 0.0f}, bgColor}); // tl
-	rb.AddVertex({{             0.01f - 10.0f * globalRendering->pixelX, 0.17f + 20.0f * globalRendering->pixelY, 0.0f}, bgColor}); // bl
-	rb.AddVertex({{MIN_X_COOR - 0.05f + 10.0f * globalRendering->pixelX, 0.17f + 20.0f * globalRendering->pixelY, 0.0f}, bgColor}); // br
+	rb.AddVertex({{             0.01f - 10.0f * globalRendering->pixelX, 0.19f + 20.0f * globalRendering->pixelY, 0.0f}, bgColor}); // bl
+	rb.AddVertex({{MIN_X_COOR - 0.05f + 10.0f * globalRendering->pixelX, 0.19f + 20.0f * globalRendering->pixelY, 0.0f}, bgColor}); // br
 
-	rb.AddVertex({{MIN_X_COOR - 0.05f + 10.0f * globalRendering->pixelX, 0.17f + 20.0f * globalRendering->pixelY, 0.0f}, bgColor}); // br
+	rb.AddVertex({{MIN_X_COOR - 0.05f + 10.0f * globalRendering->pixelX, 0.19f + 20.0f * globalRendering->pixelY, 0.0f}, bgColor}); // br
 	rb.AddVertex({{MIN_X_COOR - 0.05f + 10.0f * globalRendering->pixelX, 0.02f - 10.0f * globalRendering->pixelY, 0.0f}, bgColor}); // tr
 	rb.AddVertex({{             0.01f - 10.0f * globalRendering->pixelX, 0.02f - 10.0f * globalRendering->pixelY, 0.0f}, bgColor}); // tl
 
@@ -487,6 +503,7 @@ static void DrawInfoText(TypedRenderBuffer<VA_TYPE_C   >& rb)
 	constexpr const char* luaFmtStr = "[7] Lua-allocated memory: %.1fMB (%.1fK allocs : %.5u usecs : %.1u states)";
 	constexpr const char* gpuFmtStr = "[8] GPU-allocated memory: %.1fMB / %.1fMB";
 	constexpr const char* sopFmtStr = "[9] SOP-allocated memory: {U,F,P,W}={%.1f/%.1f, %.1f/%.1f, %.1f/%.1f, %.1f/%.1f}KB";
+	constexpr const char* mpsFmtStr = "[10] Pool memory: {Live,Peak,Reserved}={%.1f, %.1f, %.1f}MB (most fragmented: %s=%.1f%%)";
 
 	const CProjectileHandler* ph = &projectileHandler;
 	const IPathManager* pm = pathManager;
@@ -553,6 +570,32 @@ static void DrawInfoText(TypedRenderBuffer<VA_TYPE_C   >& rb)
 		weaponMemPool.alloc_size() / 1024.0f,
 		weaponMemPool.freed_size() / 1024.0f
 	);
+
+	{
+		size_t liveBytes = 0;
+		size_t peakBytes = 0;
+		size_t reservedBytes = 0;
+
+		const MemPoolStats* fragPool = nullptr;
+
+		// sampled by the profiler job, not every draw frame
+		for (const MemPoolStats& stats: MemPoolRegistry::GetStats()) {
+			liveBytes += stats.liveBytes;
+			peakBytes += stats.peakBytes;
+			reservedBytes += stats.reservedBytes;
+
+			if (fragPool == nullptr || stats.fragmentation > fragPool->fragmentation)
+				fragPool = &stats;
+		}
+
+		font->glFormat(0.01f, 0.20f, 0.5f, DBG_FONT_FLAGS | FONT_BUFFERED, mpsFmtStr,
+			liveBytes / 1024.0f / 1024.0f,
+			peakBytes / 1024.0f / 1024.0f,
+			reservedBytes / 1024.0f / 1024.0f,
+			(fragPool != nullptr)? fragPool->name: "none",
+			(fragPool != nullptr)? fragPool->fragmentation * 100.0f: 0.0f
+		);
+	}
 }
 
 
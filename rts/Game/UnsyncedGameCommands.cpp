@@ -48,6 +48,7 @@
 #include "Game/UI/Groups/GroupHandler.h"
 #include "Game/UI/PlayerRoster.h"
 
+#include "Lua/LuaMemPool.h"
 #include "Lua/LuaOpenGL.h"
 #include "Lua/LuaUI.h"
 #include "Lua/LuaMenu.h"
@@ -100,7 +101,10 @@
 #include "System/EventHandler.h"
 #include "System/GlobalConfig.h"
 #include "System/SafeUtil.h"
+#include "System/ScriptSampler.h"
 #include "System/TimeProfiler.h"
+#include "System/MemPoolStats.h"
+#include "System/Threading/ThreadPool.h"
 #include "System/Log/ILog.h"
 #include "System/Config/ConfigHandler.h"
 #include "System/FileSystem/SimpleParser.h"
@@ -3820,11 +3824,56 @@ public:
 };
 
 
+class ScriptSamplerActionExecutor : public IUnsyncedActionExecutor {
+public:
+	ScriptSamplerActionExecutor() : IUnsyncedActionExecutor(
+		"ScriptSampler",
+		"Control the Lua/COB sampling profiler: start [intervalUs], stop, reset, or dump [fileName] (folded stacks for flamegraphs)"
+	) {
+	}
+
+	bool Execute(const UnsyncedAction& action) const final {
+		const std::vector<std::string> args = CSimpleParser::Tokenize(action.GetArgs());
+
+		if (args.empty())
+			return false;
+
+		switch (hashString(args[0].c_str())) {
+			case hashString("start"): {
+				const int intervalUs = (args.size() > 1)? StringToInt(args[1]): CScriptSampler::DEFAULT_INTERVAL_US;
+
+				scriptSampler.Start(intervalUs);
+				LOG("[ScriptSamplerAction::%s] sampling every %dus", __func__, intervalUs);
+			} break;
+			case hashString("stop"): {
+				scriptSampler.Stop();
+				LOG("[ScriptSamplerAction::%s] stopped after %lu samples", __func__, static_cast<unsigned long>(scriptSampler.GetNumSamples()));
+			} break;
+			case hashString("reset"): {
+				scriptSampler.Reset();
+			} break;
+			case hashString("dump"): {
+				const std::string fileName = (args.size() > 1)? args[1]: "ScriptSamples.folded";
+
+				if (scriptSampler.DumpToFile(fileName))
+					LOG("[ScriptSamplerAction::%s] %lu samples written to \"%s\"", __func__, static_cast<unsigned long>(scriptSampler.GetNumSamples()), fileName.c_str());
+			} break;
+			default: {
+				return false;
+			} break;
+		}
+
+		return true;
+	}
+};
+
+
+
 class DebugInfoActionExecutor : public IUnsyncedActionExecutor {
 public:
 	DebugInfoActionExecutor() : IUnsyncedActionExecutor(
 		"DebugInfo",
-		"Print debug info to the chat/log-file about either sound, profiling, or command-descriptions"
+		"Print debug info to the chat/log-file about either sound, profiling, command-descriptions, Lua memory pools, Lua GL state changes, engine memory pools, thread-pool load, or dump the frame telemetry"
 	) {
 	}
 
@@ -3841,8 +3890,26 @@ public:
 			case hashString("cmddescrs"): {
 				commandDescriptionCache.Dump(true);
 			} break;
+			case hashString("luamempool"): {
+				LuaMemPool::LogPoolStats();
+			} break;
+			case hashString("luaglstate"): {
+				LuaOpenGL::LogStateChangeStats();
+			} break;
+			case hashString("mempools"): {
+				MemPoolRegistry::LogStats();
+			} break;
+			case hashString("threadpool"): {
+				ThreadPool::LogLoadStats();
+			} break;
+			case hashString("telemetry"): {
+				const std::string path = game->GetTelemetry().Dump("manual");
+
+				if (!path.empty())
+					LOG("[DbgInfoAction::%s] frame telemetry written to \"%s\"", __func__, path.c_str());
+			} break;
 			default: {
-				LOG_L(L_WARNING, "[DbgInfoAction::%s] unknown argument \"%s\" (use \"sound\", \"profiling\", or \"cmddescrs\")", __func__, args.c_str());
+				LOG_L(L_WARNING, "[DbgInfoAction::%s] unknown argument \"%s\" (use \"sound\", \"profiling\", \"cmddescrs\", \"luamempool\", \"luaglstate\", \"mempools\", \"threadpool\", or \"telemetry\")", __func__, args.c_str());
 			} break;
 		}
 
@@ -4182,6 +4249,7 @@ void UnsyncedGameCommands::AddDefaultActionExecutors()
 	AddActionExecutor(AllocActionExecutor<ReloadTexturesActionExecutor>());
 	AddActionExecutor(AllocActionExecutor<DumpAtlasActionExecutor>());
 	AddActionExecutor(AllocActionExecutor<DebugInfoActionExecutor>());
+	AddActionExecutor(AllocActionExecutor<ScriptSamplerActionExecutor>());
 
 	// XXX are these redirects really required?
 	AddActionExecutor(AllocActionExecutor<RedirectToSyncedActionExecutor>("ATM"));
@@ -15,6 +15,7 @@ struct SLuaAllocState {
 	std::atomic<uint64_t> numLuaAllocs;
 	std::atomic<uint64_t> luaAllocTime;
 	std::atomic<uint64_t> numLuaStates;
+	std::atomic<uint64_t> grossAllocedBytes; // never decremented, for call-in profiling
 };
 
 #endif
@@ -0,0 +1,120 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#include <algorithm>
+#include <cstdio>
+
+#include "LuaCallInProfiler.h"
+#include "LuaHandle.h"
+#include "System/FileSystem/DataDirsAccess.h"
+#include "System/FileSystem/FileQueryFlags.h"
+#include "System/Log/ILog.h"
+
+#include "System/Misc/TracyDefs.h"
+
+CLuaCallInProfiler luaCallInProfiler;
+
+
+int CLuaCallInProfiler::GetScopeID(const std::string& scopeName)
+{
+	std::lock_guard<spring::mutex> lock(mutex);
+
+	const auto iter = scopeIDs.find(scopeName);
+
+	if (iter != scopeIDs.end())
+		return iter->second;
+
+	scopeIDs[scopeName] = scopeNames.size();
+	scopeNames.push_back(scopeName);
+	return (scopeNames.size() - 1);
+}
+
+void CLuaCallInProfiler::AddCall(const CLuaHandle* handle, const char* callInName, int scopeID, spring_time dt, uint64_t allocBytes)
+{
+	RECOIL_DETAILED_TRACY_ZONE;
+	std::lock_guard<spring::mutex> lock(mutex);
+
+	const RecordKey key = {handle, callInName, scopeID};
+	const auto iter = records.find(key);
+
+	Record* rec = nullptr;
+
+	if (iter == records.end()) {
+		rec = &records[key];
+		rec->handleName = handle->GetName();
+		rec->callInName = callInName;
+	} else {
+		rec = &iter->second;
+	}
+
+	rec->numCalls += 1;
+	rec->allocBytes += allocBytes;
+	rec->totalTime += dt;
+	rec->maxTime = std::max(rec->maxTime, dt);
+}
+
+void CLuaCallInProfiler::HandleFreed(const CLuaHandle* handle)
+{
+	std::lock_guard<spring::mutex> lock(mutex);
+
+	for (auto iter = records.begin(); iter != records.end(); ) {
+		if (iter->first.handle == handle) {
+			iter = records.erase(iter);
+		} else {
+			++iter;
+		}
+	}
+}
+
+void CLuaCallInProfiler::Reset()
+{
+	std::lock_guard<spring::mutex> lock(mutex);
+	records.clear();
+}
+
+
+std::vector<CLuaCallInProfiler::Record> CLuaCallInProfiler::GetRecords() const
+{
+	std::vector<Record> recs;
+
+	{
+		std::lock_guard<spring::mutex> lock(mutex);
+		recs.reserve(records.size());
+
+		for (const auto& [key, rec]: records) {
+			recs.push_back(rec);
+			recs.back().scopeName = scopeNames[key.scopeID];
+		}
+	}
+
+	// most expensive first
+	std::sort(recs.begin(), recs.end(), [](const Record& a, const Record& b) { return (a.totalTime > b.totalTime); });
+	return recs;
+}
+
+bool CLuaCallInProfiler::DumpToFile(const std::string& fileName) const
+{
+	const std::string filePath = dataDirsAccess.LocateFile(fileName, FileQueryFlags::WRITE);
+	FILE* file = fopen(filePath.c_str(), "w");
+
+	if (file == nullptr) {
+		LOG_L(L_WARNING, "[LuaCallInProfiler::%s] could not open \"%s\" for writing", __func__, filePath.c_str());
+		return false;
+	}
+
+	fprintf(file, "%-24s %-32s %-32s %10s %12s %10s %14s\n", "handle", "callin", "scope", "calls", "total(ms)", "max(ms)", "alloc(KB)");
+
+	for (const Record& rec: GetRecords()) {
+		fprintf(file, "%-24s %-32s %-32s %10lu %12.3f %10.3f %14.1f\n",
+			rec.handleName.c_str(),
+			rec.callInName,
+			rec.scopeName.c_str(),
+			static_cast<unsigned long>(rec.numCalls),
+			rec.totalTime.toMilliSecsf(),
+			rec.maxTime.toMilliSecsf(),
+			rec.allocBytes / 1024.0f
+		);
+	}
+
+	fclose(file);
+	return true;
+}
@@ -0,0 +1,83 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#ifndef LUA_CALLIN_PROFILER_H
+#define LUA_CALLIN_PROFILER_H
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "System/Misc/SpringTime.h"
+#include "System/SpringHash.h"
+#include "System/Threading/SpringThreading.h"
+#include "System/UnorderedMap.hpp"
+
+class CLuaHandle;
+
+/**
+ * Accumulates time, call count and allocated bytes per (handle, call-in, scope).
+ * Scope 0 covers whole call-ins; named scopes are delimited from Lua through
+ * Script.ProfilerBeginScope/EndScope so frameworks like the gadget handler can
+ * attribute costs to individual gadgets or widgets.
+ */
+class CLuaCallInProfiler {
+public:
+	struct Record {
+		std::string handleName;
+		std::string scopeName;
+		const char* callInName = "";
+
+		uint64_t numCalls = 0;
+		uint64_t allocBytes = 0;
+
+		spring_time totalTime;
+		spring_time maxTime;
+	};
+
+	bool IsEnabled() const { return enabled.load(std::memory_order_relaxed); }
+	void SetEnabled(bool b) { enabled.store(b, std::memory_order_relaxed); }
+
+	int GetScopeID(const std::string& scopeName);
+
+	void AddCall(const CLuaHandle* handle, const char* callInName, int scopeID, spring_time dt, uint64_t allocBytes);
+	void HandleFreed(const CLuaHandle* handle);
+	void Reset();
+
+	std::vector<Record> GetRecords() const;
+	bool DumpToFile(const std::string& fileName) const;
+
+private:
+	struct RecordKey {
+		const CLuaHandle* handle;
+		const char* callInName;
+		int scopeID;
+
+		bool operator == (const RecordKey& k) const {
+			return (handle == k.handle && callInName == k.callInName && scopeID == k.scopeID);
+		}
+	};
+	struct RecordKeyHash {
+		uint32_t operator () (const RecordKey& k) const {
+			// hash the pointer values, not what they point to
+			uint32_t h = spring::LiteHash(&k.handle, sizeof(k.handle), 0);
+			h = spring::LiteHash(&k.callInName, sizeof(k.callInName), h);
+			h = spring::LiteHash(&k.scopeID, sizeof(k.scopeID), h);
+			return h;
+		}
+	};
+
+	std::atomic<bool> enabled = {false};
+
+	mutable spring::mutex mutex;
+
+	spring::unordered_map<RecordKey, Record, RecordKeyHash> records;
+	spring::unordered_map<std::string, int> scopeIDs;
+
+	// index 0 is the call-in itself
+	std::vector<std::string> scopeNames = {""};
+};
+
+extern CLuaCallInProfiler luaCallInProfiler;
+
+#endif
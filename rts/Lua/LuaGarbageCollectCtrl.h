@@ -3,6 +3,7 @@
 #ifndef SPRING_LUA_GARBAGE_COLLECT_CTRL_H
 #define SPRING_LUA_GARBAGE_COLLECT_CTRL_H
 
+#include <cstdint>
 #include <limits>
 
 struct SLuaGarbageCollectCtrl {
@@ -20,6 +21,14 @@ struct SLuaGarbageCollectCtrl {
 
 	float baseRunTimeMult = 0.0f;
 	float baseMemLoadMult = 0.0f;
+
+	// KB of collector steps owed per KB allocated since the previous call;
+	// CollectGarbage stops once the debt is paid (0 means run for the whole
+	// time budget like before), unpaid debt carries over to the next call
+	float allocDebtMult = 0.0f;
+	float allocDebtKB = 0.0f;
+
+	uint64_t lastGrossAllocedBytes = 0;
 };
 
 #endif
@@ -1,6 +1,7 @@
 /* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
 
 #include "LuaHandle.h"
+
 #include "lua_privileges.h"
 
 #include "LuaGaia.h"
@@ -8,6 +9,7 @@
 #include "LuaUI.h"
 
 #include "LuaCallInCheck.h"
+#include "LuaCallInProfiler.h"
 #include "LuaConfig.h"
 #include "LuaHashString.h"
 #include "LuaOpenGL.h"
@@ -34,14 +36,18 @@
 #include "Sim/Features/FeatureDef.h"
 #include "Sim/Units/Unit.h"
 #include "Sim/Units/UnitDef.h"
+#include "Sim/Units/UnitDefHandler.h"
 #include "Sim/Weapons/Weapon.h"
 #include "Sim/Weapons/WeaponDef.h"
+#include "Sim/Weapons/WeaponDefHandler.h"
 #include "System/creg/SerializeLuaState.h"
 #include "System/Config/ConfigHandler.h"
 #include "System/EventHandler.h"
 #include "System/Exceptions.h"
 #include "System/GlobalConfig.h"
+#include "System/MemPoolStats.h"
 #include "System/Rectangle.h"
+#include "System/ScriptSampler.h"
 #include "System/ScopedFPUSettings.h"
 #include "System/StringUtil.h"
 #include "System/Log/ILog.h"
@@ -56,6 +62,7 @@
 #include <SDL_mouse.h>
 
 #include "System/Misc/TracyDefs.h"
+#include "lib/lua/include/LuaUser.h" // spring_lua_alloc_get_stats
 #include <tracy/TracyLua.hpp>
 
 #include <algorithm>
@@ -64,7 +71,16 @@
 
 CONFIG(float, LuaGarbageCollectionMemLoadMult).defaultValue(1.33f).minimumValue(1.0f).maximumValue(100.0f).description("How much the amount of Lua memory in use increases the rate of garbage collection.");
 CONFIG(float, LuaGarbageCollectionRunTimeMult).defaultValue(5.0f).minimumValue(1.0f).description("How many milliseconds the garbage collected can run for in each GC cycle");
+CONFIG(float, LuaGarbageCollectionAllocDebtMult).defaultValue(1.0f).minimumValue(0.0f).description("How many KB of garbage collection steps are run per KB allocated by a Lua state since its previous GC cycle; collection ends early once this is done. 0 always uses the full time budget.");
+
+
+// all Lua states share one allocator, which only tracks live bytes
+static MemPoolRegistrar luaMemPoolRegistrar("Lua", [](MemPoolStats& stats) {
+	SLuaAllocState state = {};
+	spring_lua_alloc_get_stats(&state);
 
+	stats.liveBytes = state.allocedBytes.load();
+});
 
 static spring::unsynced_set<const luaContextData*>    SYNCED_LUAHANDLE_CONTEXTS;
 static spring::unsynced_set<const luaContextData*>  UNSYNCED_LUAHANDLE_CONTEXTS;
@@ -147,6 +163,7 @@ CLuaHandle::CLuaHandle(const string& _name, int _order, bool _userMode, bool _sy
 
 	D.gcCtrl.baseMemLoadMult = configHandler->GetFloat("LuaGarbageCollectionMemLoadMult");
 	D.gcCtrl.baseRunTimeMult = configHandler->GetFloat("LuaGarbageCollectionRunTimeMult");
+	D.gcCtrl.allocDebtMult = configHandler->GetFloat("LuaGarbageCollectionAllocDebtMult");
 
 	L = LUA_OPEN(&D);
 	L_GC = lua_newthread(L);
@@ -177,6 +194,8 @@ CLuaHandle::~CLuaHandle()
 	// KillLua() must be called before us!
 	assert(!IsValid());
 	assert(!eventHandler.HasClient(this));
+
+	luaCallInProfiler.HandleFreed(this);
 }
 
 
@@ -212,6 +231,62 @@ void CLuaHandle::KillLua(bool inFreeHandler)
 /******************************************************************************/
 /******************************************************************************/
 
+void CLuaHandle::UpdateSamplerHook(lua_State* L)
+{
+	const bool sampling = scriptSampler.IsEnabled();
+	const bool hooked = (lua_gethook(L) == SamplerHook);
+
+	if (sampling == hooked)
+		return;
+
+	// coroutines created while the hook is set inherit it
+	if (sampling) {
+		lua_sethook(L, SamplerHook, LUA_MASKCOUNT, CScriptSampler::LUA_HOOK_COUNT);
+	} else {
+		lua_sethook(L, nullptr, 0, 0);
+	}
+}
+
+void CLuaHandle::SamplerHook(lua_State* L, lua_Debug* ar)
+{
+	if (!scriptSampler.SampleDue(CScriptSampler::SOURCE_LUA))
+		return;
+
+	constexpr int MAX_DEPTH = 64;
+
+	const CLuaHandle* handle = GetHandle(L);
+
+	std::string frames[MAX_DEPTH];
+	std::string stack = "Lua;";
+
+	int depth = 0;
+
+	for (lua_Debug info; depth < MAX_DEPTH && lua_getstack(L, depth, &info) != 0; depth++) {
+		lua_getinfo(L, "Sn", &info);
+
+		frames[depth] = (info.name != nullptr)? info.name: "?";
+		frames[depth] += "@";
+		frames[depth] += info.short_src;
+		frames[depth] += ":";
+		frames[depth] += std::to_string(info.linedefined);
+	}
+
+	stack += (handle != nullptr)? handle->GetName(): "<null>";
+	stack += ";";
+	stack += (handle != nullptr && handle->profiledCallIn != nullptr)? handle->profiledCallIn: "?";
+
+	// root-first, as the folded format expects
+	while (depth > 0) {
+		stack += ";";
+		stack += frames[--depth];
+	}
+
+	scriptSampler.AddSample(stack);
+}
+
+
+/******************************************************************************/
+
 /***
  * @function Script.Kill
  * @param killMessage string? Kill message.
@@ -378,6 +453,17 @@ int CLuaHandle::RunCallInTraceback(
 				LuaOpenGL::InitMatrixState(state, luaFunc);
 			}
 
+			const bool profile = luaCallInProfiler.IsEnabled();
+			const char* prevCallIn = handle->profiledCallIn;
+			const size_t numScopes = handle->profilerScopes.size();
+			const SLuaAllocState& allocState = GetLuaContextData(state)->allocState;
+			const uint64_t allocStart = profile? allocState.grossAllocedBytes.load(): 0;
+			const spring_time timeStart = profile? spring_gettime(): spring_notime;
+
+			handle->profiledCallIn = func;
+
+			UpdateSamplerHook(state);
+
 			top = lua_gettop(state);
 			// note1: disable GC outside of this scope to prevent sync errors and similar
 			// note2: we collect garbage now in its own callin "CollectGarbage"
@@ -386,6 +472,13 @@ int CLuaHandle::RunCallInTraceback(
 			// only run GC inside of "SetHandleRunning(L, true) ... SetHandleRunning(L, false)"!
 			lua_gc(state, LUA_GCSTOP, 0);
 
+			if (profile)
+				luaCallInProfiler.AddCall(handle, func, 0, spring_gettime() - timeStart, allocState.grossAllocedBytes.load() - allocStart);
+
+			// drop scopes left open by an erroring or unbalanced call
+			handle->profilerScopes.resize(std::min(handle->profilerScopes.size(), numScopes));
+			handle->profiledCallIn = prevCallIn;
+
 			if (canDraw) {
 				LuaOpenGL::CheckMatrixState(state, luaFunc, error);
 				matTracker.PopMatrixState(prevMatState);
@@ -675,7 +768,7 @@ bool CLuaHandle::HasCallIn(lua_State* L, const string& name) const
 bool CLuaHandle::UpdateCallIn(lua_State* L, const string& name)
 {
 	RECOIL_DETAILED_TRACY_ZONE;
-	if (HasCallIn(L, name)) {
+	if (HasCallIn(L, name) || IsBatchingCallIn(name)) {
 		eventHandler.InsertEvent(this, name);
 	} else {
 		eventHandler.RemoveEvent(this, name);
@@ -853,6 +946,7 @@ void CLuaHandle::GameFramePost(int frameNum)
 {
 	RECOIL_DETAILED_TRACY_ZONE;
 	LUA_CALL_IN_CHECK(L);
+	FlushBatchedCallIns();
 	luaL_checkstack(L, 4, __func__);
 
 	const LuaUtils::ScopedDebugTraceBack traceBack(L);
@@ -1367,6 +1461,32 @@ void CLuaHandle::UnitDamaged(
 	int projectileID,
 	bool paralyzer)
 {
+	if (!damagedUnitDefFilter.empty() && !damagedUnitDefFilter[unit->unitDef->id])
+		return;
+	if (!damagedTeamFilter.empty() && !damagedTeamFilter[unit->team])
+		return;
+	if (!damagedWeaponDefFilter.empty() && (weaponDefID < 0 || !damagedWeaponDefFilter[weaponDefID]))
+		return;
+
+	if (batchedCallIns[BATCHED_UNIT_DAMAGED]) {
+		const bool attackerVisible = (attacker != nullptr && LuaUtils::IsUnitVisible(L, attacker));
+		const bool attackerTyped = (attackerVisible && LuaUtils::IsUnitTyped(L, attacker));
+
+		batchedUnitDamaged.push_back({
+			unit->id,
+			unit->unitDef->id,
+			unit->team,
+			damage,
+			paralyzer,
+			weaponDefID,
+			projectileID,
+			attackerVisible? attacker->id: -1,
+			attackerTyped? LuaUtils::EffectiveUnitDef(L, attacker)->id: -1,
+			attackerVisible? attacker->team: -1,
+		});
+		return;
+	}
+
 	LUA_CALL_IN_CHECK(L);
 	luaL_checkstack(L, 11, __func__);
 
@@ -1523,9 +1643,14 @@ void CLuaHandle::UnitSeismicPing(const CUnit* unit, int allyTeam,
 /******************************************************************************/
 
 void CLuaHandle::LosCallIn(const LuaHashString& hs,
-                           const CUnit* unit, int allyTeam)
+                           const CUnit* unit, int allyTeam, int batchIdx)
 {
 	RECOIL_DETAILED_TRACY_ZONE;
+	if (batchedCallIns[batchIdx]) {
+		batchedUnitLos[batchIdx].push_back({unit->id, unit->team, allyTeam, unit->unitDef->id});
+		return;
+	}
+
 	LUA_CALL_IN_CHECK(L);
 	luaL_checkstack(L, 6, __func__);
 	if (!hs.GetGlobalFunc(L))
@@ -1558,7 +1683,7 @@ void CLuaHandle::UnitEnteredRadar(const CUnit* unit, int allyTeam)
 {
 	RECOIL_DETAILED_TRACY_ZONE;
 	static const LuaHashString hs(__func__);
-	LosCallIn(hs, unit, allyTeam);
+	LosCallIn(hs, unit, allyTeam, BATCHED_UNIT_ENTERED_RADAR);
 }
 
 
@@ -1576,7 +1701,7 @@ void CLuaHandle::UnitEnteredRadar(const CUnit* unit, int allyTeam)
 void CLuaHandle::UnitEnteredLos(const CUnit* unit, int allyTeam)
 {
 	static const LuaHashString hs(__func__);
-	LosCallIn(hs, unit, allyTeam);
+	LosCallIn(hs, unit, allyTeam, BATCHED_UNIT_ENTERED_LOS);
 }
 
 
@@ -1597,7 +1722,7 @@ void CLuaHandle::UnitLeftRadar(const CUnit* unit, int allyTeam)
 {
 	RECOIL_DETAILED_TRACY_ZONE;
 	static const LuaHashString hs(__func__);
-	LosCallIn(hs, unit, allyTeam);
+	LosCallIn(hs, unit, allyTeam, BATCHED_UNIT_LEFT_RADAR);
 }
 
 
@@ -1615,7 +1740,7 @@ void CLuaHandle::UnitLeftRadar(const CUnit* unit, int allyTeam)
 void CLuaHandle::UnitLeftLos(const CUnit* unit, int allyTeam)
 {
 	static const LuaHashString hs(__func__);
-	LosCallIn(hs, unit, allyTeam);
+	LosCallIn(hs, unit, allyTeam, BATCHED_UNIT_LEFT_LOS);
 }
 
 
@@ -4010,12 +4135,26 @@ void CLuaHandle::CollectGarbage(bool forced)
 	const float gcBaseRunTime = smoothstep(10.0f, 100.0f, gcMemFootPrint / 1024);
 	const float gcLoopRunTime = std::clamp((gcBaseRunTime * gcRunTimeMult) / gcSpeedFactor, D.gcCtrl.minLoopRunTime, D.gcCtrl.maxLoopRunTime);
 
+	// a LUA_GCSTEP call with argument N does the work of N KB worth of allocations,
+	// so collecting only what was allocated since the last call keeps up with the
+	// garbage produced without spending the whole time budget on quiet frames
+	const uint64_t grossAllocedBytes = D.allocState.grossAllocedBytes.load();
+	const bool payAllocDebt = (!forced && D.gcCtrl.allocDebtMult > 0.0f);
+
+	float& gcAllocDebt = D.gcCtrl.allocDebtKB;
+
+	gcAllocDebt += ((grossAllocedBytes - D.gcCtrl.lastGrossAllocedBytes) / 1024.0f) * D.gcCtrl.allocDebtMult;
+	gcAllocDebt  = std::min(gcAllocDebt, gcMemFootPrint * 1.0f);
+
+	D.gcCtrl.lastGrossAllocedBytes = grossAllocedBytes;
+
 	const spring_time startTime = spring_gettime();
 	const spring_time   endTime = startTime + spring_msecs(gcLoopRunTime);
 
-	// perform GC cycles until time runs out or iteration-limit is reached
-	while (forced || (gcItersInBatch < D.gcCtrl.itersPerBatch && spring_gettime() < endTime)) {
+	// perform GC cycles until time runs out, iteration-limit is reached or debt is paid
+	while (forced || (gcItersInBatch < D.gcCtrl.itersPerBatch && spring_gettime() < endTime && (!payAllocDebt || gcAllocDebt > 0.0f))) {
 		gcItersInBatch++;
+		gcAllocDebt -= gcStepsPerIter;
 
 		if (!lua_gc(L_GC, LUA_GCSTEP, gcStepsPerIter))
 			continue;
@@ -4027,10 +4166,14 @@ void CLuaHandle::CollectGarbage(bool forced)
 		gcMemFootPrint = gcMemFootPrintNow;
 
 		// early-exit if cycle didn't free any memory
-		if (gcMemFootPrintDif == 0)
+		if (gcMemFootPrintDif == 0) {
+			gcAllocDebt = 0.0f;
 			break;
+		}
 	}
 
+	gcAllocDebt = std::max(gcAllocDebt, 0.0f);
+
 	// don't collect garbage outside of CollectGarbage
 	lua_gc(L_GC, LUA_GCSTOP, 0);
 	SetHandleRunning(L_GC, false);
@@ -4058,7 +4201,7 @@ bool CLuaHandle::AddBasicCalls(lua_State* L)
 {
 	RECOIL_DETAILED_TRACY_ZONE;
 	HSTR_PUSH(L, "Script");
-	lua_createtable(L, 0, 17); {
+	lua_createtable(L, 0, 21); {
 		HSTR_PUSH_CFUNC(L, "Kill",            KillActiveHandle);
 		HSTR_PUSH_CFUNC(L, "UpdateCallIn",    CallOutUpdateCallIn);
 		HSTR_PUSH_CFUNC(L, "GetName",         CallOutGetName);
@@ -4074,6 +4217,10 @@ bool CLuaHandle::AddBasicCalls(lua_State* L)
 		HSTR_PUSH_CFUNC(L, "GetCallInList",   CallOutGetCallInList);
 		HSTR_PUSH_CFUNC(L, "DelayByFrames",   CallOutDelayByFrames);
 		HSTR_PUSH_CFUNC(L, "IsEngineMinVersion", CallOutIsEngineMinVersion);
+		HSTR_PUSH_CFUNC(L, "SetUnitDamagedFilter", CallOutSetUnitDamagedFilter);
+		HSTR_PUSH_CFUNC(L, "SetBatchedCallIn", CallOutSetBatchedCallIn);
+		HSTR_PUSH_CFUNC(L, "ProfilerBeginScope", CallOutProfilerBeginScope);
+		HSTR_PUSH_CFUNC(L, "ProfilerEndScope", CallOutProfilerEndScope);
 		// special team constants
 
 		/*** @field Script.NO_ACCESS_TEAM -1 */
@@ -4250,6 +4397,258 @@ int CLuaHandle::CallOutDelayByFrames(lua_State* L)
 	return 0;
 }
 
+
+static void ParseCallInFilter(lua_State* L, int index, size_t size, std::vector<bool>& filter)
+{
+	filter.clear();
+
+	if (lua_isnoneornil(L, index))
+		return;
+
+	luaL_checktype(L, index, LUA_TTABLE);
+	filter.resize(size, false);
+
+	for (int i = 1, n = lua_objlen(L, index); i <= n; i++) {
+		lua_rawgeti(L, index, i);
+
+		const uint32_t id = luaL_checkint(L, -1);
+
+		if (id < size)
+			filter[id] = true;
+
+		lua_pop(L, 1);
+	}
+}
+
+static constexpr std::array<const char*, 5> BATCHED_CALLIN_NAMES = {
+	"UnitDamaged",
+	"UnitEnteredRadar",
+	"UnitEnteredLos",
+	"UnitLeftRadar",
+	"UnitLeftLos",
+};
+static constexpr std::array<const char*, 5> BATCHED_CALLIN_FUNC_NAMES = {
+	"UnitDamagedBatch",
+	"UnitEnteredRadarBatch",
+	"UnitEnteredLosBatch",
+	"UnitLeftRadarBatch",
+	"UnitLeftLosBatch",
+};
+
+bool CLuaHandle::IsBatchingCallIn(const std::string& name) const
+{
+	static_assert(BATCHED_CALLIN_NAMES.size() == BATCHED_CALLIN_COUNT);
+
+	// the flush happens in GameFramePost, which must stay subscribed
+	if (name == "GameFramePost")
+		return IsBatchingAnyCallIn();
+
+	for (size_t i = 0; i < BATCHED_CALLIN_NAMES.size(); i++) {
+		if (name == BATCHED_CALLIN_NAMES[i])
+			return batchedCallIns[i];
+	}
+
+	return false;
+}
+
+bool CLuaHandle::IsBatchingAnyCallIn() const
+{
+	return (std::find(batchedCallIns.begin(), batchedCallIns.end(), true) != batchedCallIns.end());
+}
+
+void CLuaHandle::FlushBatchedCallIns()
+{
+	RECOIL_DETAILED_TRACY_ZONE;
+	const auto PushColumn = [this](size_t numEvents, auto&& GetValue) {
+		lua_createtable(L, numEvents, 0);
+
+		for (size_t i = 0; i < numEvents; i++) {
+			GetValue(i);
+			lua_rawseti(L, -2, i + 1);
+		}
+	};
+	// -1 marks a hidden value, which leaves a hole
+	const auto PushIntColumn = [this](size_t numEvents, auto&& GetValue) {
+		lua_createtable(L, numEvents, 0);
+
+		for (size_t i = 0; i < numEvents; i++) {
+			const int value = GetValue(i);
+
+			if (value == -1)
+				continue;
+
+			lua_pushnumber(L, value);
+			lua_rawseti(L, -2, i + 1);
+		}
+	};
+
+	if (!batchedUnitDamaged.empty()) {
+		const LuaHashString cmdStr(BATCHED_CALLIN_FUNC_NAMES[BATCHED_UNIT_DAMAGED]);
+
+		const auto& events = batchedUnitDamaged;
+		const size_t n = events.size();
+
+		const LuaUtils::ScopedDebugTraceBack traceBack(L);
+		luaL_checkstack(L, 14, __func__);
+
+		if (cmdStr.GetGlobalFunc(L)) {
+			lua_pushnumber(L, n);
+			PushIntColumn(n, [&](size_t i) { return events[i].unitID; });
+			PushIntColumn(n, [&](size_t i) { return events[i].unitDefID; });
+			PushIntColumn(n, [&](size_t i) { return events[i].unitTeam; });
+			PushColumn(n, [&](size_t i) { lua_pushnumber(L, events[i].damage); });
+			PushColumn(n, [&](size_t i) { lua_pushboolean(L, events[i].paralyzer); });
+			// weaponDefID and projectileID can legitimately be -1
+			PushColumn(n, [&](size_t i) { lua_pushnumber(L, events[i].weaponDefID); });
+			PushColumn(n, [&](size_t i) { lua_pushnumber(L, events[i].projectileID); });
+			PushIntColumn(n, [&](size_t i) { return events[i].attackerID; });
+			PushIntColumn(n, [&](size_t i) { return events[i].attackerDefID; });
+			PushIntColumn(n, [&](size_t i) { return events[i].attackerTeam; });
+
+			RunCallInTraceback(L, cmdStr, 11, 0, traceBack.GetErrFuncIdx(), false);
+		}
+
+		batchedUnitDamaged.clear();
+	}
+
+	for (int b = BATCHED_UNIT_ENTERED_RADAR; b < BATCHED_CALLIN_COUNT; b++) {
+		auto& events = batchedUnitLos[b];
+
+		if (events.empty())
+			continue;
+
+		const LuaHashString cmdStr(BATCHED_CALLIN_FUNC_NAMES[b]);
+		const size_t n = events.size();
+		const bool fullRead = GetHandleFullRead(L);
+
+		const LuaUtils::ScopedDebugTraceBack traceBack(L);
+		luaL_checkstack(L, 8, __func__);
+
+		if (cmdStr.GetGlobalFunc(L)) {
+			lua_pushnumber(L, n);
+			PushIntColumn(n, [&](size_t i) { return events[i].unitID; });
+			PushIntColumn(n, [&](size_t i) { return events[i].unitTeam; });
+
+			if (fullRead) {
+				PushIntColumn(n, [&](size_t i) { return events[i].allyTeam; });
+				PushIntColumn(n, [&](size_t i) { return events[i].unitDefID; });
+			}
+
+			RunCallInTraceback(L, cmdStr, fullRead? 5: 3, 0, traceBack.GetErrFuncIdx(), false);
+		}
+
+		events.clear();
+	}
+}
+
+/*** Switches a call-in between per-event and batched delivery
+ *
+ * While batched, the events of a frame are queued in the engine and handed
+ * over in a single call to `<name>Batch` just before GameFramePost. Its
+ * arguments are the event count followed by one array per regular argument
+ * of the call-in, indexed by event; hidden values (e.g. the attacker of a
+ * UnitDamaged) are holes. Supported call-ins are UnitDamaged,
+ * UnitEnteredRadar, UnitEnteredLos, UnitLeftRadar and UnitLeftLos.
+ *
+ * @function Script.SetBatchedCallIn
+ * @param name string
+ * @param batched boolean
+ * @return boolean supported
+ */
+int CLuaHandle::CallOutSetBatchedCallIn(lua_State* L)
+{
+	const std::string name = luaL_checkstring(L, 1);
+	const bool batched = luaL_checkboolean(L, 2);
+
+	const auto iter = std::find_if(BATCHED_CALLIN_NAMES.begin(), BATCHED_CALLIN_NAMES.end(), [&](const char* n) { return (name == n); });
+
+	if (iter == BATCHED_CALLIN_NAMES.end()) {
+		lua_pushboolean(L, false);
+		return 1;
+	}
+
+	CLuaHandle* lh = GetHandle(L);
+
+	// deliver what was queued so far, GameFramePost might be unsubscribed below
+	if (!batched)
+		lh->FlushBatchedCallIns();
+
+	lh->batchedCallIns[iter - BATCHED_CALLIN_NAMES.begin()] = batched;
+	lh->UpdateCallIn(L, name);
+	lh->UpdateCallIn(L, "GameFramePost");
+
+	lua_pushboolean(L, true);
+	return 1;
+}
+
+/*** Starts attributing the running call-in's cost to a named scope
+ *
+ * Meant for frameworks dispatching one call-in to many gadgets or widgets;
+ * the time and memory allocated until the matching Script.ProfilerEndScope
+ * are recorded under (handle, call-in, name). Does nothing while call-in
+ * profiling is disabled, see Spring.SetCallInProfiling.
+ *
+ * @function Script.ProfilerBeginScope
+ * @param name string
+ */
+int CLuaHandle::CallOutProfilerBeginScope(lua_State* L)
+{
+	if (!luaCallInProfiler.IsEnabled())
+		return 0;
+
+	CLuaHandle* lh = GetHandle(L);
+
+	if (lh->profiledCallIn == nullptr)
+		return 0;
+
+	const int scopeID = luaCallInProfiler.GetScopeID(luaL_checkstring(L, 1));
+	const uint64_t allocBytes = GetLuaContextData(L)->allocState.grossAllocedBytes.load();
+
+	lh->profilerScopes.push_back({scopeID, allocBytes, spring_gettime()});
+	return 0;
+}
+
+/***
+ * @function Script.ProfilerEndScope
+ */
+int CLuaHandle::CallOutProfilerEndScope(lua_State* L)
+{
+	CLuaHandle* lh = GetHandle(L);
+
+	if (lh->profilerScopes.empty())
+		return 0;
+
+	const ProfilerScope scope = lh->profilerScopes.back();
+	const uint64_t allocBytes = GetLuaContextData(L)->allocState.grossAllocedBytes.load();
+
+	lh->profilerScopes.pop_back();
+	luaCallInProfiler.AddCall(lh, lh->profiledCallIn, scope.scopeID, spring_gettime() - scope.startTime, allocBytes - scope.startAllocBytes);
+	return 0;
+}
+
+/*** Limits which UnitDamaged events reach this handle
+ *
+ * Events are matched in the engine before the call-in is run, so unwanted
+ * ones cost no Lua call. Each argument is an array of IDs, or nil to not
+ * filter on that property; calling without arguments removes all filters.
+ * Damage not caused by a weapon (negative weaponDefID) is only delivered
+ * when no weapon filter is set.
+ *
+ * @function Script.SetUnitDamagedFilter
+ * @param unitDefIDs integer[]? damaged unit's unitDefID
+ * @param weaponDefIDs integer[]?
+ * @param teamIDs integer[]? damaged unit's team
+ */
+int CLuaHandle::CallOutSetUnitDamagedFilter(lua_State* L)
+{
+	CLuaHandle* lh = GetHandle(L);
+
+	ParseCallInFilter(L, 1, unitDefHandler->NumUnitDefs() + 1, lh->damagedUnitDefFilter);
+	ParseCallInFilter(L, 2, weaponDefHandler->NumWeaponDefs(), lh->damagedWeaponDefFilter);
+	ParseCallInFilter(L, 3, teamHandler.ActiveTeams(), lh->damagedTeamFilter);
+	return 0;
+}
+
 int CLuaHandle::CallOutGetCallInList(lua_State* L)
 {
 	std::vector<std::string> eventList;
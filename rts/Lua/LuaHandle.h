@@ -9,8 +9,10 @@
 #include "LuaContextData.h"
 #include "LuaHashString.h"
 #include "lib/lua/include/LuaInclude.h" //FIXME needed for GetLuaContextData
+#include "System/Misc/SpringTime.h"
 
 
+#include <array>
 #include <map>
 #include <string>
 #include <tuple>
@@ -35,6 +37,7 @@ struct Command;
 struct SRectangle;
 struct LuaHashString;
 struct lua_State;
+struct lua_Debug;
 class LuaRBOs;
 class LuaFBOs;
 class LuaVBOs;
@@ -68,6 +71,11 @@ class CLuaHandle : public CEventClient
 
 	#undef PERMISSIONS_FUNCS
 
+		bool CanReadAllyTeam(int allyTeam) const override {
+			const luaContextData* lcd = GetLuaContextData(L);
+			return (lcd->fullRead || (lcd->readAllyTeam == allyTeam));
+		}
+
 		static bool GetHandleSynced(const lua_State* L) { return GetLuaContextData(L)->synced; }
 
 		bool GetUserMode() const { return userMode; }
@@ -103,7 +111,7 @@ class CLuaHandle : public CEventClient
 		CLuaDisplayLists& GetDisplayLists(const lua_State* L = NULL) { return GetLuaContextData(L)->displayLists; }
 #endif
 	public: // call-ins
-		bool WantsEvent(const std::string& name) override { return HasCallIn(L, name); }
+		bool WantsEvent(const std::string& name) override { return (HasCallIn(L, name) || IsBatchingCallIn(name)); }
 		virtual bool HasCallIn(lua_State* L, const std::string& name) const;
 		virtual bool UpdateCallIn(lua_State* L, const std::string& name);
 
@@ -321,7 +329,7 @@ class CLuaHandle : public CEventClient
 		/// returns false and prints message to log on error
 		bool RunCallIn(lua_State* L, const LuaHashString& hs, int inArgs, int outArgs);
 
-		void LosCallIn(const LuaHashString& hs, const CUnit* unit, int allyTeam);
+		void LosCallIn(const LuaHashString& hs, const CUnit* unit, int allyTeam, int batchIdx);
 		void UnitCallIn(const LuaHashString& hs, const CUnit* unit);
 
 		void RunDrawCallIn(const LuaHashString& hs);
@@ -353,6 +361,64 @@ class CLuaHandle : public CEventClient
 		std::vector<bool> watchExplosionDefs;   // callin masks for Explosion
 		std::vector<bool> watchAllowTargetDefs; // callin masks for AllowWeapon*Target*
 
+		// UnitDamaged filters set through Script.SetUnitDamagedFilter, empty means unfiltered
+		std::vector<bool> damagedUnitDefFilter;
+		std::vector<bool> damagedWeaponDefFilter;
+		std::vector<bool> damagedTeamFilter;
+
+		enum BatchedCallIn {
+			BATCHED_UNIT_DAMAGED       = 0,
+			BATCHED_UNIT_ENTERED_RADAR = 1,
+			BATCHED_UNIT_ENTERED_LOS   = 2,
+			BATCHED_UNIT_LEFT_RADAR    = 3,
+			BATCHED_UNIT_LEFT_LOS      = 4,
+			BATCHED_CALLIN_COUNT       = 5,
+		};
+
+		// attacker fields are -1 when the attacker was hidden from this handle
+		struct UnitDamagedArgs {
+			int unitID;
+			int unitDefID;
+			int unitTeam;
+			float damage;
+			bool paralyzer;
+			int weaponDefID;
+			int projectileID;
+			int attackerID;
+			int attackerDefID;
+			int attackerTeam;
+		};
+		struct UnitLosArgs {
+			int unitID;
+			int unitTeam;
+			int allyTeam;
+			int unitDefID;
+		};
+
+		bool IsBatchingCallIn(const std::string& name) const;
+		bool IsBatchingAnyCallIn() const;
+		void FlushBatchedCallIns();
+
+		// call-ins switched to batched delivery by Script.SetBatchedCallIn; their
+		// events are queued here and handed to <name>Batch before GameFramePost
+		std::array<bool, BATCHED_CALLIN_COUNT> batchedCallIns = {};
+		std::vector<UnitDamagedArgs> batchedUnitDamaged;
+		std::array<std::vector<UnitLosArgs>, BATCHED_CALLIN_COUNT> batchedUnitLos;
+
+		struct ProfilerScope {
+			int scopeID;
+			uint64_t startAllocBytes;
+			spring_time startTime;
+		};
+
+		// call-in currently running in this handle and the open Script.ProfilerBeginScope's
+		const char* profiledCallIn = nullptr;
+		std::vector<ProfilerScope> profilerScopes;
+
+		// installed on a state while the script sampler is running
+		static void SamplerHook(lua_State* L, lua_Debug* ar);
+		static void UpdateSamplerHook(lua_State* L);
+
 	private: // call-outs
 		static int KillActiveHandle(lua_State* L);
 		static int CallOutGetName(lua_State* L);
@@ -369,6 +435,10 @@ class CLuaHandle : public CEventClient
 		static int CallOutUpdateCallIn(lua_State* L);
 		static int CallOutIsEngineMinVersion(lua_State* L);
 		static int CallOutDelayByFrames(lua_State* L);
+		static int CallOutSetUnitDamagedFilter(lua_State* L);
+		static int CallOutSetBatchedCallIn(lua_State* L);
+		static int CallOutProfilerBeginScope(lua_State* L);
+		static int CallOutProfilerEndScope(lua_State* L);
 
 	protected:
 		static int LoadStringData(lua_State* L);
@@ -17,6 +17,7 @@
 #include "System/Log/ILog.h"
 #include "System/StringUtil.h"
 
+#include <algorithm>
 #include <cctype>
 
 #include "System/Misc/TracyDefs.h"
@@ -941,30 +942,17 @@ LuaMatRef LuaMatHandler::GetRef(const LuaMaterial& mat)
 
 	LuaMatBin* fakeBin = (LuaMatBin*) &mat;
 
+	// bins are kept sorted, so a lookup costs log(#bins) comparisons
 	LuaMatBinSet& binSet = binTypes[mat.type];
-	LuaMatBinSet::iterator it = std::find_if(binSet.begin(), binSet.end(), [&](LuaMatBin* bin) {
-		return (!matBinCmp(bin, fakeBin) && !matBinCmp(fakeBin, bin));
-	});
+	LuaMatBinSet::iterator it = std::lower_bound(binSet.begin(), binSet.end(), fakeBin, matBinCmp);
 
-	if (it != binSet.end()) {
+	if (it != binSet.end() && !matBinCmp(fakeBin, *it)) {
 		assert(*fakeBin == *(*it));
 		return (LuaMatRef(*it));
 	}
 
-	binSet.push_back(new LuaMatBin(mat));
-
-	LuaMatBin* bin = binSet.back();
-	LuaMatRef ref(bin);
-
-	// swap new bin into place, faster than resorting
-	for (size_t n = binSet.size() - 1; n > 0; n--) {
-		if (matBinCmp(binSet[n - 1], binSet[n]))
-			break;
-
-		std::swap(binSet[n - 1], binSet[n]);
-	}
-
-	return ref;
+	// insert new bin in place, no resorting needed
+	return (LuaMatRef(*binSet.insert(it, new LuaMatBin(mat))));
 }
 
 
@@ -997,22 +985,15 @@ void LuaMatHandler::FreeBin(LuaMatBin* argBin)
 {
 	RECOIL_DETAILED_TRACY_ZONE;
 	LuaMatBinSet& binSet = binTypes[argBin->type];
-	LuaMatBinSet::iterator it = std::find_if(binSet.begin(), binSet.end(), [&](LuaMatBin* bin) {
-		return (!matBinCmp(bin, argBin) && !matBinCmp(argBin, bin));
-	});
+	LuaMatBinSet::iterator it = std::lower_bound(binSet.begin(), binSet.end(), argBin, matBinCmp);
 
-	if (it == binSet.end())
+	if (it == binSet.end() || matBinCmp(argBin, *it))
 		return;
 
 	assert((*it) == argBin);
 
-	// swap to-be-deleted bin to the back, faster than resorting
-	for (size_t n = (it - binSet.begin()); n < (binSet.size() - 1); n++) {
-		std::swap(binSet[n], binSet[n + 1]);
-	}
-
-	assert(binSet.back() == argBin);
-	binSet.pop_back();
+	// erasing keeps the remaining bins sorted
+	binSet.erase(it);
 
 	delete argBin;
 }
@@ -100,6 +100,43 @@ LuaMemPool::LuaMemPool(size_t lmpIndex): globalIndex(lmpIndex)
 	luaMemPoolImpl = std::make_unique<LuaMemPool::LuaMemPoolImpl>();
 }
 
+int LuaMemPool::GetSlabClass(size_t size)
+{
+	if (size <= NUM_BUCKETS * BUCKET_STEP || size > SLAB_CLASS_SIZES.back())
+		return -1;
+
+	return (std::lower_bound(SLAB_CLASS_SIZES.begin(), SLAB_CLASS_SIZES.end(), size) - SLAB_CLASS_SIZES.begin());
+}
+
+void* LuaMemPool::AllocSlab(int slabClass)
+{
+	if (SlabBlock* block = slabFreeLists[slabClass]; block != nullptr) {
+		slabFreeLists[slabClass] = block->next;
+		return block;
+	}
+
+	const size_t blockSize = SLAB_CLASS_SIZES[slabClass];
+
+	// the remainder of a chunk too small for this class is wasted
+	if ((slabChunkOffset + blockSize) > SLAB_CHUNK_SIZE) {
+		slabChunks.emplace_back(new uint8_t[SLAB_CHUNK_SIZE]);
+		slabChunkOffset = 0;
+	}
+
+	void* ptr = slabChunks.back().get() + slabChunkOffset;
+	slabChunkOffset += blockSize;
+	return ptr;
+}
+
+void LuaMemPool::FreeSlab(void* ptr, int slabClass)
+{
+	SlabBlock* block = static_cast<SlabBlock*>(ptr);
+
+	block->next = slabFreeLists[slabClass];
+	slabFreeLists[slabClass] = block;
+}
+
+
 void LuaMemPool::Clear()
 {
 	RECOIL_DETAILED_TRACY_ZONE;
@@ -119,8 +156,17 @@ void* LuaMemPool::Alloc(size_t size)
 	}
 
 	auto t0 = spring_now();
+
+	if (const int slabClass = GetSlabClass(size); slabClass >= 0) {
+		void* ptr = AllocSlab(slabClass);
+		allocStats[STAT_NAS] += 1;
+		allocStats[STAT_NBS] += size;
+		allocStats[STAT_NTS] += (spring_now() - t0).toMicroSecsi();
+		return ptr;
+	}
+
 	auto* ptr = luaMemPoolImpl->allocMem(size);
-	
+
 	if (size > NUM_BUCKETS * BUCKET_STEP) {
 		allocStats[STAT_NAE] += 1 * (size > 0);
 		allocStats[STAT_NBE] += size;
@@ -162,6 +208,24 @@ void* LuaMemPool::Realloc(void* ptr, size_t nsize, size_t osize)
 		return newPtr;
 	}
 
+	const int oldSlabClass = GetSlabClass(osize);
+	const int newSlabClass = GetSlabClass(nsize);
+
+	if (oldSlabClass >= 0 || newSlabClass >= 0) {
+		// still fits the block it already occupies
+		if (oldSlabClass == newSlabClass)
+			return ptr;
+
+		void* newPtr = Alloc(nsize);
+
+		if (newPtr == nullptr)
+			return nullptr;
+
+		std::memcpy(newPtr, ptr, std::min(nsize, osize));
+		Free(ptr, osize);
+		return newPtr;
+	}
+
 	auto t0 = spring_now();
 	auto* ret = luaMemPoolImpl->reAllocMem(ptr, nsize);
 	if (nsize > NUM_BUCKETS * BUCKET_STEP) {
@@ -190,6 +254,11 @@ void LuaMemPool::Free(void* ptr, size_t size)
 		return;
 	}
 
+	if (const int slabClass = GetSlabClass(size); slabClass >= 0) {
+		FreeSlab(ptr, slabClass);
+		return;
+	}
+
 	luaMemPoolImpl->freeMem(ptr);
 }
 
@@ -201,8 +270,9 @@ void LuaMemPool::LogStats(const char* handle, const char* lctype)
 	const float avgAllocTimeI = static_cast<float>(allocStats[STAT_NTI]) / static_cast<float>(std::max(allocStats[STAT_NAI], one));
 	const float avgAllocTimeF = static_cast<float>(allocStats[STAT_NTF]) / static_cast<float>(std::max(allocStats[STAT_NAF], one));
 	const float avgAllocTimeE = static_cast<float>(allocStats[STAT_NTE]) / static_cast<float>(std::max(allocStats[STAT_NAE], one));
+	const float avgAllocTimeS = static_cast<float>(allocStats[STAT_NTS]) / static_cast<float>(std::max(allocStats[STAT_NAS], one));
 	std::string msg = fmt::sprintf(
-		"[LuaMemPool::%s][handle=%s (%s)] index=%u numAllocs{int+, int-, ext, int_p}={%u, %u, %u, %.1f} allocedSize{int+, int-, ext}={%u, %u, %u}, avgAllocTime{int+, int-, ext}={%.4f, %.4f, %.4f}, cumAllocTime={int+, int-, ext}={%u, %u, %u}",
+		"[LuaMemPool::%s][handle=%s (%s)] index=%u numAllocs{int+, int-, ext, slab, int_p}={%u, %u, %u, %u, %.1f} allocedSize{int+, int-, ext, slab}={%u, %u, %u, %u}, avgAllocTime{int+, int-, ext, slab}={%.4f, %.4f, %.4f, %.4f}, cumAllocTime={int+, int-, ext, slab}={%u, %u, %u, %u}",
 		__func__,
 		handle,
 		lctype,
@@ -210,17 +280,44 @@ void LuaMemPool::LogStats(const char* handle, const char* lctype)
 		allocStats[STAT_NAI],
 		allocStats[STAT_NAF],
 		allocStats[STAT_NAE],
+		allocStats[STAT_NAS],
 		intPerc,
 		allocStats[STAT_NBI],
 		allocStats[STAT_NBF],
 		allocStats[STAT_NBE],
+		allocStats[STAT_NBS],
 		avgAllocTimeI,
 		avgAllocTimeF,
 		avgAllocTimeE,
+		avgAllocTimeS,
 		allocStats[STAT_NTI],
 		allocStats[STAT_NTF],
-		allocStats[STAT_NTE]
+		allocStats[STAT_NTE],
+		allocStats[STAT_NTS]
 	);
 	LOG("%s", msg.c_str());
 	allocStats = {};
 }
+
+void LuaMemPool::LogPoolStats()
+{
+	// only counters are read here, pools of worker states may be in use concurrently
+	const auto LogPool = [](const LuaMemPool* p) {
+		LOG("\tindex=%d sharedCount=%u slabChunks=%u (%uKB) numSlabAllocs=%u",
+			int(p->globalIndex), unsigned(p->sharedCount), unsigned(p->slabChunks.size()),
+			unsigned(p->slabChunks.size() * SLAB_CHUNK_SIZE / 1024), unsigned(p->allocStats[STAT_NAS]));
+	};
+
+	LOG("[LuaMemPool::%s] enabled=%d numStateOwnedPools=%u", __func__, LuaMemPool::enabled, unsigned(gCount.load()));
+
+	if (!LuaMemPool::enabled)
+		return;
+
+	LogPool(gSharedPool);
+
+	std::lock_guard<spring::mutex> lock(gMutex);
+
+	for (const LuaMemPool* p: gPools) {
+		LogPool(p);
+	}
+}
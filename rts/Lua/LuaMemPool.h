@@ -2,7 +2,9 @@
 
 #pragma once
 
+#include <array>
 #include <cstddef>
+#include <cstdint>
 #include <vector>
 #include <memory>
 
@@ -43,6 +45,8 @@ public:
 	static void InitStatic(bool enable);
 	static void KillStatic();
 
+	static void LogPoolStats();
+
 public:
 	void Clear();
 	void* Alloc(size_t size);
@@ -63,6 +67,24 @@ private:
 	using LuaMemPoolImpl = PassThroughPool<NUM_BUCKETS, 4 * (1024 * 1024)>;
 	std::unique_ptr<LuaMemPoolImpl> luaMemPoolImpl;
 
+	// size-classes for allocations too large for the smmalloc buckets (large
+	// tables and strings), carved from chunks owned by this pool; blocks are
+	// found by the size Lua passes back on free, so they need no header
+	static constexpr size_t SLAB_CHUNK_SIZE = 256 * 1024;
+	static constexpr std::array<uint32_t, 9> SLAB_CLASS_SIZES = {768, 1024, 1536, 2048, 3072, 4096, 6144, 8192, 12288};
+
+	static int GetSlabClass(size_t size);
+
+	void* AllocSlab(int slabClass);
+	void FreeSlab(void* ptr, int slabClass);
+
+	struct SlabBlock { SlabBlock* next; };
+
+	std::array<SlabBlock*, SLAB_CLASS_SIZES.size()> slabFreeLists = {};
+	std::vector<std::unique_ptr<uint8_t[]>> slabChunks;
+
+	size_t slabChunkOffset = SLAB_CHUNK_SIZE;
+
 	enum {
 		STAT_NAI = 0, // number of internal allocs
 		STAT_NAF = 1, // number of int fail allocs
@@ -73,9 +95,12 @@ private:
 		STAT_NTI = 6, // cumulative time spent on internal allocs
 		STAT_NTF = 7, // cumulative time spent on int fail allocs
 		STAT_NTE = 8, // cumulative time spent on external allocs
+		STAT_NAS = 9, // number of slab allocs
+		STAT_NBS = 10, // number of bytes alloced (slab)
+		STAT_NTS = 11, // cumulative time spent on slab allocs
 	};
 
-	std::array<uint64_t, 9> allocStats = { 0, 0, 0, 0, 0 };
+	std::array<uint64_t, 12> allocStats = {};
 
 	size_t globalIndex = 0;
 	size_t sharedCount = 0;
@@ -7,6 +7,8 @@
 #include "LuaUtils.h"
 #include "Map/MetalMap.h"
 #include "Map/ReadMap.h"
+#include "Sim/Misc/ResourceHandler.h"
+#include "Sim/Misc/ResourceMapAnalyzer.h"
 
 #include "System/Misc/TracyDefs.h"
 
@@ -31,6 +33,15 @@ bool LuaMetalMap::PushCtrlEntries(lua_State* L)
 	return true;
 }
 
+bool LuaMetalMap::PushUnsyncedReadEntries(lua_State* L)
+{
+	RECOIL_DETAILED_TRACY_ZONE;
+	// the analysis runs on first request (which may come from an AI),
+	// so its result does not track SetMetalAmount and is not synced
+	REGISTER_LUA_CFUNC(GetMetalSpots);
+	return true;
+}
+
 /***
  * @function Spring.GetMetalMapSize
  * @return integer x X coordinate in worldspace / `Game.metalMapSquareSize`.
@@ -96,6 +107,45 @@ int LuaMetalMap::GetMetalExtraction(lua_State* L)
 	return 1;
 }
 
+/***
+ * @class MetalSpot
+ * @field x number
+ * @field z number
+ * @field worth number Relative amount of metal an extractor placed here makes, only comparable between spots.
+ */
+
+/***
+ * Returns the extractor spots found by the engine's metal map analysis,
+ * the same ones skirmish AIs receive. The analysis is cached per map and
+ * metal layout.
+ * @function Spring.GetMetalSpots
+ * @return MetalSpot[] spots
+ * @return number averageIncome Average metal per metal map square.
+ */
+int LuaMetalMap::GetMetalSpots(lua_State* L)
+{
+	RECOIL_DETAILED_TRACY_ZONE;
+	const CResourceMapAnalyzer* rma = resourceHandler->GetResourceMapAnalyzer(resourceHandler->GetMetalId());
+
+	if (rma == nullptr)
+		return 0;
+
+	const std::vector<float3>& spots = rma->GetSpots();
+
+	lua_createtable(L, spots.size(), 0);
+
+	for (size_t i = 0; i < spots.size(); i++) {
+		lua_createtable(L, 0, 3);
+		LuaPushNamedNumber(L, "x", spots[i].x);
+		LuaPushNamedNumber(L, "z", spots[i].z);
+		LuaPushNamedNumber(L, "worth", spots[i].y);
+		lua_rawseti(L, -2, i + 1);
+	}
+
+	lua_pushnumber(L, rma->GetAverageIncome());
+	return 2;
+}
+
 
 
 
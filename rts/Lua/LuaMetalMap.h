@@ -10,11 +10,13 @@ class LuaMetalMap {
 	public:
 		static bool PushReadEntries(lua_State* L);
 		static bool PushCtrlEntries(lua_State* L);
+		static bool PushUnsyncedReadEntries(lua_State* L);
 
 		static int GetMetalMapSize(lua_State* L);
 		static int GetMetalAmount(lua_State* L);
 		static int SetMetalAmount(lua_State* L);
 		static int GetMetalExtraction(lua_State* L);
+		static int GetMetalSpots(lua_State* L);
 };
 
 
@@ -15,6 +15,7 @@
 #include <optional>
 #include <variant>
 #include <span>
+#include <cctype>
 
 #include "lib/fmt/format.h"
 
@@ -77,6 +78,8 @@
 #include "Sim/Units/UnitHandler.h"
 #include "Sim/Weapons/WeaponDefHandler.h"
 #include "System/Config/ConfigHandler.h"
+#include "System/Exceptions.h"
+#include "System/FileSystem/FileHandler.h"
 #include "System/Log/ILog.h"
 #include "System/Matrix44f.h"
 
@@ -572,6 +575,7 @@ void LuaOpenGL::ResetGLState()
 	if (IS_GL_FUNCTION_AVAILABLE(glUseProgram)) {
 		glUseProgram(0);
 	}
+	LuaShaders::ClearActiveProgram();
 }
 
 
@@ -592,10 +596,42 @@ const GLbitfield AttribBits =
 	GL_VIEWPORT_BIT;
 
 
+void LuaOpenGL::CountStateChange(StateChangeType type, uint64_t key)
+{
+	// repeated changes are not elided since engine drawing performed between
+	// two gl.* calls (e.g. gl.Unit) modifies the same state behind our back
+	stateChangesRepeated[type] += (lastStateChangeKeys[type] == key);
+	stateChangesIssued[type] += 1;
+	lastStateChangeKeys[type] = key;
+}
+
+void LuaOpenGL::LogStateChangeStats()
+{
+	static constexpr const char* typeNames[STATE_CHANGE_COUNT] = {"texture", "shader", "blend", "depth"};
+
+	const int numFrames = std::max(static_cast<int>(globalRendering->drawFrame - stateChangesFrame), 1);
+
+	LOG("[LuaOpenGL::%s] gl.* state changes per frame over the last %d frames", __func__, numFrames);
+
+	for (int i = 0; i < STATE_CHANGE_COUNT; i++) {
+		LOG("\t%-8s issued=%.1f repeated=%.1f", typeNames[i], stateChangesIssued[i] * 1.0f / numFrames, stateChangesRepeated[i] * 1.0f / numFrames);
+	}
+
+	LOG("\t%-8s issued=%.1f elided=%.1f", "uniform", uniformCallsIssued * 1.0f / numFrames, uniformCallsElided * 1.0f / numFrames);
+
+	stateChangesIssued.fill(0);
+	stateChangesRepeated.fill(0);
+	uniformCallsIssued = 0;
+	uniformCallsElided = 0;
+	stateChangesFrame = globalRendering->drawFrame;
+}
+
+
 void LuaOpenGL::EnableCommon(DrawMode mode)
 {
 	assert(drawMode == DRAW_NONE);
 	drawMode = mode;
+	lastStateChangeKeys.fill(~0ull);
 	if (safeMode) {
 		glPushAttrib(AttribBits);
 		ResetGLState();
@@ -618,6 +654,7 @@ void LuaOpenGL::DisableCommon(DrawMode mode)
 	if (IS_GL_FUNCTION_AVAILABLE(glUseProgram)) {
 		glUseProgram(0);
 	}
+	LuaShaders::ClearActiveProgram();
 }
 
 
@@ -3294,10 +3331,12 @@ int LuaOpenGL::DepthTest(lua_State* L)
 		} else {
 			glDisable(GL_DEPTH_TEST);
 		}
+		CountStateChange(STATE_CHANGE_DEPTH, lua_toboolean(L, 1));
 	}
 	else if (lua_isnumber(L, 1)) {
 		glEnable(GL_DEPTH_TEST);
 		glDepthFunc((GLenum)lua_tonumber(L, 1));
+		CountStateChange(STATE_CHANGE_DEPTH, (uint64_t(lua_tonumber(L, 1)) << 1) | 1);
 	}
 	else {
 		luaL_error(L, "Incorrect arguments to gl.DepthTest()");
@@ -3493,10 +3532,18 @@ int LuaOpenGL::Blending(lua_State* L)
 		const GLenum dst = (GLenum)luaL_checkint(L, 2);
 		glBlendFunc(src, dst);
 		glEnable(GL_BLEND);
+		CountStateChange(STATE_CHANGE_BLEND, (uint64_t(src) << 32) | dst);
+		return 0;
 	}
 	else {
 		luaL_error(L, "Incorrect arguments to gl.Blending()");
 	}
+
+	if (lua_isboolean(L, 1)) {
+		CountStateChange(STATE_CHANGE_BLEND, lua_toboolean(L, 1));
+	} else {
+		CountStateChange(STATE_CHANGE_BLEND, hashString(lua_tostring(L, 1)));
+	}
 	return 0;
 }
 
@@ -4072,6 +4119,8 @@ int LuaOpenGL::Texture(lua_State* L)
 
 		tex.Enable(true);
 		tex.Bind();
+
+		CountStateChange(STATE_CHANGE_TEXTURE, (uint64_t(tex.type) << 48) ^ reinterpret_cast<uintptr_t>(tex.data) ^ texUnit);
 	} else {
 		lua_pushboolean(L, false);
 	}
@@ -4909,9 +4958,16 @@ int LuaOpenGL::DeleteTextureAtlas(lua_State* L)
 }
 
 /***
+ * Adds a texture to an atlas before it is finalized.
+ *
+ * Plain image file names are decoded straight into the atlas, such that icon
+ * sets do not need an individual texture each; files added more than once
+ * (under different names) share one atlas region.
+ *
  * @function gl.AddAtlasTexture
  * @param texName string
- * @param subAtlasTexName string
+ * @param luaTexture string Lua texture or image file name
+ * @param subAtlasTexName string? (Default: `luaTexture`)
  */
 int LuaOpenGL::AddAtlasTexture(lua_State* L)
 {
@@ -4926,6 +4982,23 @@ int LuaOpenGL::AddAtlasTexture(lua_State* L)
 
 	LuaMatTexture luaTex;
 	const std::string luaTexStr = luaL_checksstring(L, 2);
+
+	// no (named) GL texture needed, skips the upload and glGetTexImage readback
+	if (std::isalnum(static_cast<unsigned char>(luaTexStr[0])) && CFileHandler::FileExists(luaTexStr, SPRING_VFS_RAW_FIRST)) {
+		std::string errMsg;
+
+		try {
+			atlas->AddTexFromFile(luaL_optstring(L, 3, luaTexStr.c_str()), luaTexStr);
+		} catch (const content_error& e) {
+			errMsg = e.what();
+		}
+
+		if (!errMsg.empty())
+			luaL_error(L, "gl.%s() %s", __func__, errMsg.c_str());
+
+		return 0;
+	}
+
 	if (!LuaOpenGLUtils::ParseTextureImage(L, luaTex, luaTexStr))
 		luaL_error(L, "gl.%s() Failed to find a Lua texture %s", __func__, luaTexStr.c_str());
 
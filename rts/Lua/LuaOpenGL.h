@@ -3,6 +3,8 @@
 #ifndef LUA_GL_H
 #define LUA_GL_H
 
+#include <array>
+#include <cstdint>
 #include <vector>
 #include <string>
 #include <unordered_set>
@@ -42,6 +44,21 @@ class LuaOpenGL {
 		static bool GetSafeMode() { return safeMode; }
 		static void SetSafeMode(bool value) { safeMode = value; }
 
+		enum StateChangeType {
+			STATE_CHANGE_TEXTURE = 0,
+			STATE_CHANGE_SHADER  = 1,
+			STATE_CHANGE_BLEND   = 2,
+			STATE_CHANGE_DEPTH   = 3,
+			STATE_CHANGE_COUNT   = 4,
+		};
+
+		// <key> identifies the new state; a change is counted as repeated if
+		// the previous gl.* call of the same type within this callin set it too
+		static void CountStateChange(StateChangeType type, uint64_t key);
+		// gl.Uniform* calls and how many of them were skipped as redundant
+		static void CountUniformCall(bool elided) { uniformCallsIssued += 1; uniformCallsElided += elided; }
+		static void LogStateChangeStats();
+
 		#define NOOP_STATE_FUNCS(Name)    \
 		static void Enable  ## Name () {} \
 		static void Disable ## Name () {} \
@@ -144,6 +161,13 @@ class LuaOpenGL {
 
 		static DrawMode drawMode;
 		static DrawMode prevDrawMode; // for minimap (when drawn in Screen mode)
+
+		inline static std::array<uint64_t, STATE_CHANGE_COUNT> lastStateChangeKeys;
+		inline static std::array<uint64_t, STATE_CHANGE_COUNT> stateChangesIssued;
+		inline static std::array<uint64_t, STATE_CHANGE_COUNT> stateChangesRepeated;
+		inline static unsigned int stateChangesFrame = 0;
+		inline static uint64_t uniformCallsIssued = 0;
+		inline static uint64_t uniformCallsElided = 0;
 		static bool safeMode;
 		static bool canUseShaders;
 		static int deprecatedGLWarnLevel;
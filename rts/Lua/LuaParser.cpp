@@ -5,6 +5,8 @@
 
 #include <algorithm>
 #include <climits>
+#include <cmath>
+#include <cstring>
 
 #include "lib/streflop/streflop_cond.h"
 
@@ -299,6 +301,202 @@ bool LuaParser::Execute()
 }
 
 
+/******************************************************************************/
+
+// tables nested deeper than this are most likely cyclic
+static constexpr int MAX_SERIAL_DEPTH = 64;
+
+template<typename T>
+static void AppendSerialItem(std::vector<std::uint8_t>& data, const T& item)
+{
+	const std::uint8_t* bytes = reinterpret_cast<const std::uint8_t*>(&item);
+	data.insert(data.end(), bytes, bytes + sizeof(T));
+}
+
+static bool IsSerialKeyType(int type) { return (type == LUA_TNUMBER || type == LUA_TSTRING || type == LUA_TBOOLEAN); }
+static bool IsSerialValueType(int type) { return (IsSerialKeyType(type) || type == LUA_TTABLE); }
+
+static bool SerializeValue(lua_State* L, int index, std::vector<std::uint8_t>& data, int depth)
+{
+	switch (lua_type(L, index)) {
+		case LUA_TNUMBER: {
+			data.push_back(LuaTable::NUMBER);
+			AppendSerialItem(data, lua_tonumber(L, index));
+		} break;
+		case LUA_TSTRING: {
+			size_t len = 0;
+			const char* str = lua_tolstring(L, index, &len);
+
+			data.push_back(LuaTable::STRING);
+			AppendSerialItem(data, std::uint32_t(len));
+			data.insert(data.end(), str, str + len);
+		} break;
+		case LUA_TBOOLEAN: {
+			data.push_back(LuaTable::BOOLEAN);
+			data.push_back(lua_toboolean(L, index));
+		} break;
+		case LUA_TTABLE: {
+			if (depth >= MAX_SERIAL_DEPTH || !lua_checkstack(L, 3))
+				return false;
+
+			// the array size lets the loader preallocate, and keeps '#' unchanged
+			const std::uint32_t arraySize = lua_objlen(L, index);
+			const size_t countPos = data.size() + 1 + sizeof(arraySize);
+
+			std::uint32_t count = 0;
+
+			data.push_back(LuaTable::TABLE);
+			AppendSerialItem(data, arraySize);
+			AppendSerialItem(data, count);
+
+			for (lua_pushnil(L); lua_next(L, index) != 0; lua_pop(L, 1)) {
+				if (!IsSerialKeyType(lua_type(L, -2)) || !IsSerialValueType(lua_type(L, -1)))
+					continue;
+
+				// keys first, SerializeValue never converts them in place
+				if (!SerializeValue(L, lua_gettop(L) - 1, data, depth + 1) || !SerializeValue(L, lua_gettop(L), data, depth + 1)) {
+					lua_pop(L, 2);
+					return false;
+				}
+
+				count += 1;
+			}
+
+			std::memcpy(&data[countPos], &count, sizeof(count));
+		} break;
+		default: {
+			return false;
+		} break;
+	}
+
+	return true;
+}
+
+
+struct SerialReader {
+public:
+	template<typename T> bool Read(T& item) { return (ReadBytes(&item, sizeof(T))); }
+
+	bool ReadBytes(void* bytes, size_t size) {
+		if (size > (data.size() - pos))
+			return false;
+
+		std::memcpy(bytes, &data[pos], size);
+		pos += size;
+		return true;
+	}
+
+	bool AtEnd() const { return (pos == data.size()); }
+
+public:
+	const std::vector<std::uint8_t>& data;
+	size_t pos;
+};
+
+static bool DeserializeValue(lua_State* L, SerialReader& reader, int depth)
+{
+	std::uint8_t type = 0;
+
+	if (!reader.Read(type))
+		return false;
+
+	switch (type) {
+		case LuaTable::NUMBER: {
+			lua_Number num = 0;
+
+			if (!reader.Read(num))
+				return false;
+
+			lua_pushnumber(L, num);
+		} break;
+		case LuaTable::STRING: {
+			std::uint32_t len = 0;
+
+			if (!reader.Read(len) || len > (reader.data.size() - reader.pos))
+				return false;
+
+			lua_pushlstring(L, reinterpret_cast<const char*>(&reader.data[reader.pos]), len);
+			reader.pos += len;
+		} break;
+		case LuaTable::BOOLEAN: {
+			std::uint8_t val = 0;
+
+			if (!reader.Read(val))
+				return false;
+
+			lua_pushboolean(L, val != 0);
+		} break;
+		case LuaTable::TABLE: {
+			std::uint32_t arraySize = 0;
+			std::uint32_t count = 0;
+
+			if (depth >= MAX_SERIAL_DEPTH || !lua_checkstack(L, 3))
+				return false;
+			if (!reader.Read(arraySize) || !reader.Read(count) || arraySize > count)
+				return false;
+
+			lua_createtable(L, arraySize, count - arraySize);
+
+			for (std::uint32_t i = 0; i < count; i++) {
+				if (!DeserializeValue(L, reader, depth + 1) || !DeserializeValue(L, reader, depth + 1))
+					return false;
+
+				// lua_rawset raises errors for these, outside of any pcall
+				if (lua_isnil(L, -2) || lua_istable(L, -2) || (lua_type(L, -2) == LUA_TNUMBER && std::isnan(lua_tonumber(L, -2))))
+					return false;
+
+				lua_rawset(L, -3);
+			}
+		} break;
+		default: {
+			return false;
+		} break;
+	}
+
+	return true;
+}
+
+
+bool LuaParser::SerializeRoot(std::vector<std::uint8_t>& data) const
+{
+	if (!IsValid() || !valid)
+		return false;
+
+	data.clear();
+
+	lua_rawgeti(L, LUA_REGISTRYINDEX, rootRef);
+	const bool ret = SerializeValue(L, lua_gettop(L), data, 0);
+	lua_pop(L, 1);
+
+	return ret;
+}
+
+bool LuaParser::LoadSerializedRoot(const std::vector<std::uint8_t>& data)
+{
+	if (!IsValid())
+		return false;
+
+	assert(rootRef == LUA_NOREF);
+	assert(initDepth == 0);
+
+	SerialReader reader = {data, 0};
+
+	// leaves the parser untouched on failure, Execute can still be called
+	if (!DeserializeValue(L, reader, 0) || !reader.AtEnd() || !lua_istable(L, -1)) {
+		lua_settop(L, 0);
+		return false;
+	}
+
+	initDepth = -1;
+	rootRef = luaL_ref(L, LUA_REGISTRYINDEX);
+	lua_settop(L, 0);
+
+	return (valid = true);
+}
+
+
+/******************************************************************************/
+
 void LuaParser::AddTable(LuaTable* tbl) { spring::VectorInsertUnique(tables, tbl); }
 void LuaParser::RemoveTable(LuaTable* tbl) { spring::VectorErase(tables, tbl); }
 
@@ -536,6 +734,7 @@ int LuaParser::Random(lua_State* L)
 
 	switch (lua_gettop(L)) {
 		case 0: {
+			GetLuaParser(L)->usedRandom = true;
 			lua_pushnumber(L, gsRNG.NextFloat());
 			return 1;
 		} break;
@@ -547,6 +746,7 @@ int LuaParser::Random(lua_State* L)
 				if (u < 1)
 					luaL_error(L, "error: too small upper limit (%d) given to math.random(), should be >= 1 {LuaParser}", u);
 
+				GetLuaParser(L)->usedRandom = true;
 				lua_pushnumber(L, 1 + gsRNG.NextInt(u));
 				return 1;
 			}
@@ -560,6 +760,8 @@ int LuaParser::Random(lua_State* L)
 				if (lower > upper)
 					luaL_error(L, "Empty interval in math.random() {LuaParser}");
 
+				GetLuaParser(L)->usedRandom = true;
+
 				const float diff = (upper - lower);
 				const float r = gsRNG.NextFloat(); // [0,1], not [0,1) ?
 
@@ -3,6 +3,7 @@
 #ifndef LUA_PARSER_H
 #define LUA_PARSER_H
 
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -133,6 +134,13 @@ public:
 
 	bool Execute();
 	bool IsValid() const { return (L != nullptr); } // true if nothing failed during Execute
+	bool UsedRandom() const { return usedRandom; } // true if Execute drew from the synced RNG
+
+	// flat binary copy of the root table, e.g. for caching Execute's result;
+	// values LuaTable can not return (functions, userdata) are left out
+	bool SerializeRoot(std::vector<std::uint8_t>& data) const;
+	// substitute for Execute, restores a root table written by SerializeRoot
+	bool LoadSerializedRoot(const std::vector<std::uint8_t>& data);
 	bool NoTable() const { return (errorLog.find("no return table") == 0); } // parser is still valid if true
 
 	LuaTable GetRoot();
@@ -189,6 +197,7 @@ private:
 	int currentRef = -1;
 
 	bool valid = false;
+	bool usedRandom = false;
 	bool lowerKeys = false; // convert all returned keys to lower case
 	bool lowerCppKeys = false; // convert strings in arguments keys to lower case
 
@@ -63,6 +63,7 @@ bool LuaPathFinder::PushEntries(lua_State* L)
 	CreatePathMetatable(L);
 
 	REGISTER_LUA_CFUNC(RequestPath);
+	REGISTER_LUA_CFUNC(RequestPathAsync);
 	REGISTER_LUA_CFUNC(InitPathNodeCostsArray);
 	REGISTER_LUA_CFUNC(FreePathNodeCostsArray);
 	REGISTER_LUA_CFUNC(SetPathNodeCosts);
@@ -134,6 +135,10 @@ static int path_next(lua_State* L)
 
 	const float minDist = luaL_optfloat(L, 5, 0.0f);
 
+	// no waypoints until the queued search ran
+	if (pathManager->PathPending(pathID))
+		return 0;
+
 	const bool synced = CLuaHandle::GetHandleSynced(L);
 	const float3 point = pathManager->NextWayPoint(nullptr, pathID, 0, callerPos, minDist, synced);
 
@@ -156,9 +161,21 @@ static int path_nodes(lua_State* L)
 	const int* idPtr = (int*)luaL_checkudata(L, 1, "Path");
 	const int pathID = *idPtr;
 
+	if (pathManager->PathPending(pathID))
+		return 0;
+
 	return (LuaPathFinder::PushPathNodes(L, pathID));
 }
 
+static int path_pending(lua_State* L)
+{
+	const int* idPtr = (int*)luaL_checkudata(L, 1, "Path");
+	const int pathID = *idPtr;
+
+	lua_pushboolean(L, pathID != 0 && pathManager->PathPending(pathID));
+	return 1;
+}
+
 static int path_index(lua_State* L)
 {
 	const int* idPtr = (int*)luaL_checkudata(L, 1, "Path");
@@ -176,6 +193,10 @@ static int path_index(lua_State* L)
 		lua_pushcfunction(L, path_nodes);
 		return 1;
 	}
+	if (key == "IsPending") {
+		lua_pushcfunction(L, path_pending);
+		return 1;
+	}
 	return 0;
 }
 
@@ -211,7 +232,7 @@ static void CreatePathMetatable(lua_State* L)
 /******************************************************************************/
 /******************************************************************************/
 
-int LuaPathFinder::RequestPath(lua_State* L)
+static int RequestPathImpl(lua_State* L, bool async)
 {
 	const MoveDef* moveDef = nullptr;
 
@@ -234,8 +255,9 @@ int LuaPathFinder::RequestPath(lua_State* L)
 
 	const float radius = luaL_optfloat(L, 8, 8.0f);
 
+	// queued searches run during the next sim update, which only synced state may depend on
 	const bool synced = CLuaHandle::GetHandleSynced(L);
-	const int pathID = pathManager->RequestPath(nullptr, moveDef, start, end, radius, synced, true);
+	const int pathID = pathManager->RequestPath(nullptr, moveDef, start, end, radius, synced, !(async && synced));
 
 	if (pathID == 0)
 		return 0;
@@ -248,6 +270,26 @@ int LuaPathFinder::RequestPath(lua_State* L)
 	return 1;
 }
 
+int LuaPathFinder::RequestPath(lua_State* L)
+{
+	return (RequestPathImpl(L, false));
+}
+
+/*** Queues a path request instead of searching right away
+ *
+ * Takes the same arguments as Spring.RequestPath. The search is queued with
+ * those of units and runs during the next sim frame, in the order requests
+ * were made; until then `path:IsPending()` returns true and the path has no
+ * waypoints. Unsynced callers get an immediate search as with RequestPath.
+ *
+ * @function Spring.RequestPathAsync
+ * @return Path? path
+ */
+int LuaPathFinder::RequestPathAsync(lua_State* L)
+{
+	return (RequestPathImpl(L, true));
+}
+
 
 
 int LuaPathFinder::InitPathNodeCostsArray(lua_State* L)
@@ -8,5 +8,6 @@ using namespace LuaRulesParams;
 CR_BIND(Param,)
 CR_REG_METADATA(Param, (
 	CR_MEMBER(los),
+	CR_MEMBER(changeFrame),
 	CR_MEMBER(value)
 ))
@@ -32,6 +32,7 @@ namespace LuaRulesParams
 		CR_DECLARE_STRUCT(Param)
 
 		int   los = RULESPARAMLOS_PRIVATE;
+		int   changeFrame = -1; //! last frame in which value or los was modified
 		std::variant <bool, float, std::string> value;
 	};
 
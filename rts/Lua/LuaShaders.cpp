@@ -21,7 +21,10 @@
 #include "Rendering/Models/ModelsMemStorageDefs.h"
 #include "Rendering/UniformConstants.h"
 
+#include <array>
+#include <cstring>
 #include <string>
+#include <type_traits>
 #include <vector>
 #include <algorithm>
 
@@ -106,10 +109,12 @@ inline void CheckDrawingEnabled(lua_State* L, const char* caller)
 
 GLuint LuaShaders::GetProgramName(uint32_t progIdx) const
 {
-	if (progIdx < programs.size())
-		return programs[progIdx].id;
+	if (progIdx >= programs.size())
+		return 0;
 
-	return 0;
+	// the caller (map or material shaders) sets uniforms behind our back
+	programs[progIdx].externalUniforms = true;
+	return programs[progIdx].id;
 }
 
 const LuaShaders::Program* LuaShaders::GetProgram(uint32_t progIdx) const
@@ -131,10 +136,12 @@ LuaShaders::Program* LuaShaders::GetProgram(uint32_t progIdx)
 
 GLuint LuaShaders::GetProgramName(lua_State* L, int index) const
 {
-	if (luaL_checkint(L, index) <= 0)
+	const int progIdx = luaL_checkint(L, index);
+
+	if (progIdx <= 0 || progIdx >= programs.size())
 		return 0;
 
-	return (GetProgramName(luaL_checkint(L, index)));
+	return programs[progIdx].id;
 }
 
 const LuaShaders::Program* LuaShaders::GetProgram(lua_State* L, int index) const
@@ -187,7 +194,9 @@ bool LuaShaders::DeleteProgram(Program& p)
 	glDeleteProgram(p.id);
 
 	p.objects.clear();
+	p.uniformValues.clear();
 	p.id = 0;
+	p.externalUniforms = false;
 	return true;
 }
 
@@ -549,6 +558,45 @@ GLint LuaShaders::GetUniformLocation(LuaShaders::Program* p, const char* name)
 	return iter->second.location;
 }
 
+template<typename T>
+bool LuaShaders::IsUniformUnchanged(GLint location, const std::array<T, 4>& values, int count)
+{
+	static_assert(sizeof(T) == sizeof(uint32_t));
+	// bogus locations are not worth a table entry
+	static constexpr GLint MAX_CACHED_LOCATION = 1024;
+
+	if (activeProgram == nullptr || activeProgram->externalUniforms)
+		return false;
+	if (location < 0 || location >= MAX_CACHED_LOCATION)
+		return false;
+
+	if (static_cast<size_t>(location) >= activeProgram->uniformValues.size())
+		activeProgram->uniformValues.resize(location + 1);
+
+	UniformValue& uv = activeProgram->uniformValues[location];
+
+	std::array<uint32_t, 4> bits = {};
+	std::memcpy(bits.data(), values.data(), count * sizeof(T));
+
+	const bool isInt = std::is_integral_v<T>;
+	const bool unchanged = (uv.count == count && uv.isInt == isInt && uv.bits == bits);
+
+	uv.bits = bits;
+	uv.count = count;
+	uv.isInt = isInt;
+
+	LuaOpenGL::CountUniformCall(unchanged);
+	return unchanged;
+}
+
+void LuaShaders::ForgetUniformValues()
+{
+	if (activeProgram == nullptr)
+		return;
+
+	activeProgram->uniformValues.clear();
+}
+
 /***
  * A table of uniform name to value.
  * 
@@ -817,6 +865,7 @@ int LuaShaders::UseShader(lua_State* L)
 	if (progIdx == 0) {
 		glUseProgram(0);
 		activeProgram = nullptr;
+		LuaOpenGL::CountStateChange(LuaOpenGL::STATE_CHANGE_SHADER, 0);
 		lua_pushboolean(L, true);
 		return 1;
 	}
@@ -830,6 +879,7 @@ int LuaShaders::UseShader(lua_State* L)
 	} else {
 		activeProgram = prog;
 		glUseProgram(prog->id);
+		LuaOpenGL::CountStateChange(LuaOpenGL::STATE_CHANGE_SHADER, prog->id);
 		lua_pushboolean(L, true);
 	}
 	return 1;
@@ -1058,25 +1108,28 @@ int LuaShaders::Uniform(lua_State* L)
 	if (activeShaderDepth <= 0)
 		CheckDrawingEnabled(L, __func__);
 
-	const GLuint location = (lua_type(L, 1) == LUA_TSTRING) ? GetUniformLocation(activeProgram, luaL_checkstring(L, 1)) : luaL_checkint(L, 1);
+	const GLint location = (lua_type(L, 1) == LUA_TSTRING) ? GetUniformLocation(activeProgram, luaL_checkstring(L, 1)) : luaL_checkint(L, 1);
 	const int numValues = lua_gettop(L) - 1;
 
+	if (numValues < 1 || numValues > 4)
+		luaL_error(L, "Incorrect arguments to gl.Uniform()");
+
+	std::array<float, 4> v = {};
+
+	for (int i = 0; i < numValues; i++) {
+		v[i] = luaL_checkfloat(L, i + 2);
+	}
+
+	// the program still holds these values, skip the upload
+	if (IsUniformUnchanged(location, v, numValues))
+		return 0;
+
 	switch (numValues) {
-		case 1: {
-			glUniform1f(location, luaL_checkfloat(L, 2));
-		} break;
-		case 2: {
-			glUniform2f(location, luaL_checkfloat(L, 2), luaL_checkfloat(L, 3));
-		} break;
-		case 3: {
-			glUniform3f(location, luaL_checkfloat(L, 2), luaL_checkfloat(L, 3), luaL_checkfloat(L, 4));
-		} break;
-		case 4: {
-			glUniform4f(location, luaL_checkfloat(L, 2), luaL_checkfloat(L, 3), luaL_checkfloat(L, 4), luaL_checkfloat(L, 5));
-		} break;
-		default: {
-			luaL_error(L, "Incorrect arguments to gl.Uniform()");
-		} break;
+		case 1: { glUniform1f(location, v[0]                  ); } break;
+		case 2: { glUniform2f(location, v[0], v[1]            ); } break;
+		case 3: { glUniform3f(location, v[0], v[1], v[2]      ); } break;
+		case 4: { glUniform4f(location, v[0], v[1], v[2], v[3]); } break;
+		default: {} break;
 	}
 
 	return 0;
@@ -1099,25 +1152,27 @@ int LuaShaders::UniformInt(lua_State* L)
 	if (activeShaderDepth <= 0)
 		CheckDrawingEnabled(L, __func__);
 
-	const GLuint location = (lua_type(L, 1) == LUA_TSTRING) ? GetUniformLocation(activeProgram, luaL_checkstring(L, 1)) : luaL_checkint(L, 1);
+	const GLint location = (lua_type(L, 1) == LUA_TSTRING) ? GetUniformLocation(activeProgram, luaL_checkstring(L, 1)) : luaL_checkint(L, 1);
 	const int numValues = lua_gettop(L) - 1;
 
+	if (numValues < 1 || numValues > 4)
+		luaL_error(L, "Incorrect arguments to gl.UniformInt()");
+
+	std::array<int, 4> v = {};
+
+	for (int i = 0; i < numValues; i++) {
+		v[i] = luaL_checkint(L, i + 2);
+	}
+
+	if (IsUniformUnchanged(location, v, numValues))
+		return 0;
+
 	switch (numValues) {
-		case 1: {
-			glUniform1i(location, luaL_checkint(L, 2));
-		} break;
-		case 2: {
-			glUniform2i(location, luaL_checkint(L, 2), luaL_checkint(L, 3));
-		} break;
-		case 3: {
-			glUniform3i(location, luaL_checkint(L, 2), luaL_checkint(L, 3), luaL_checkint(L, 4));
-		} break;
-		case 4: {
-			glUniform4i(location, luaL_checkint(L, 2), luaL_checkint(L, 3), luaL_checkint(L, 4), luaL_checkint(L, 5));
-		} break;
-		default: {
-			luaL_error(L, "Incorrect arguments to gl.UniformInt()");
-		}
+		case 1: { glUniform1i(location, v[0]                  ); } break;
+		case 2: { glUniform2i(location, v[0], v[1]            ); } break;
+		case 3: { glUniform3i(location, v[0], v[1], v[2]      ); } break;
+		case 4: { glUniform4i(location, v[0], v[1], v[2], v[3]); } break;
+		default: {} break;
 	}
 
 	return 0;
@@ -1172,6 +1227,9 @@ int LuaShaders::UniformArray(lua_State* L)
 	if (!lua_istable(L, 3))
 		return 0;
 
+	// arrays span several locations
+	ForgetUniformValues();
+
 	switch (luaL_checkint(L, 2)) {
 		case UNIFORM_TYPE_INT: {
 			#if 0
@@ -1235,6 +1293,9 @@ int LuaShaders::UniformMatrix(lua_State* L)
 	const GLuint location = (lua_type(L, 1) == LUA_TSTRING) ? GetUniformLocation(activeProgram, luaL_checkstring(L, 1)) : luaL_checkint(L, 1);
 	const int numValues = lua_gettop(L) - 1;
 
+	// matrix columns take consecutive locations
+	ForgetUniformValues();
+
 	switch (numValues) {
 	case 1: {
 			if (!lua_isstring(L, 2))
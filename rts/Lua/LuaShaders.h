@@ -3,6 +3,7 @@
 #ifndef LUA_SHADERS_H
 #define LUA_SHADERS_H
 
+#include <array>
 #include <string>
 #include <vector>
 #include <unordered_map>
@@ -29,6 +30,9 @@ class LuaShaders {
 		std::string errorLog;
 
 		GLuint GetProgramName(uint32_t progIdx) const;
+
+		// the program bound by gl.UseShader is no longer current
+		static void ClearActiveProgram() { activeProgram = nullptr; }
 		const Program* GetProgram(uint32_t progIdx) const;
 		      Program* GetProgram(uint32_t progIdx);
 	private:
@@ -45,6 +49,11 @@ class LuaShaders {
 		struct ActiveUniformLocation {
 			GLint location = -1;
 		};
+		struct UniformValue {
+			std::array<uint32_t, 4> bits = {};
+			uint8_t count = 0; // 0 if not known
+			bool isInt = false;
+		};
 		struct Program {
 			Program(GLuint _id) : id(_id) {}
 
@@ -52,6 +61,11 @@ class LuaShaders {
 			std::vector<Object> objects;
 			std::unordered_map<std::string, ActiveUniform> activeUniforms;
 			std::unordered_map<std::string, ActiveUniformLocation> activeUniformLocations;
+
+			// last gl.Uniform{Int} values per location; not used once the
+			// program was handed to engine code which sets uniforms itself
+			std::vector<UniformValue> uniformValues;
+			mutable bool externalUniforms = false;
 		};
 	private:
 		std::vector<Program> programs;
@@ -66,6 +80,10 @@ class LuaShaders {
 		// helper
 		static bool DeleteProgram(Program& p);
 		static GLint GetUniformLocation(Program* p, const char* name);
+
+		template<typename T>
+		static bool IsUniformUnchanged(GLint location, const std::array<T, 4>& values, int count);
+		static void ForgetUniformValues();
 	private:
 
 		// the call-outs
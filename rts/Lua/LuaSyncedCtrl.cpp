@@ -1,7 +1,9 @@
 /* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
 
+#include <array>
 #include <vector>
 #include <cctype>
+#include <cstring>
 
 #include "LuaSyncedCtrl.h"
 
@@ -67,6 +69,7 @@
 #include "Sim/Units/CommandAI/Command.h"
 #include "Sim/Units/CommandAI/CommandAI.h"
 #include "Sim/Units/CommandAI/FactoryCAI.h"
+#include "Sim/Units/UnitTypes/Building.h"
 #include "Sim/Units/UnitTypes/ExtractorBuilding.h"
 #include "Sim/Weapons/PlasmaRepulser.h"
 #include "Sim/Weapons/Weapon.h"
@@ -218,6 +221,7 @@ bool LuaSyncedCtrl::PushEntries(lua_State* L)
 	REGISTER_LUA_CFUNC(SetUnitMass);
 	REGISTER_LUA_CFUNC(SetUnitPosition);
 	REGISTER_LUA_CFUNC(SetUnitVelocity);
+	REGISTER_LUA_CFUNC(SetUnitsBulk);
 	REGISTER_LUA_CFUNC(SetUnitRotation);
 	REGISTER_LUA_CFUNC(SetUnitDirection);
 	REGISTER_LUA_CFUNC(SetUnitHeadingAndUpDir);
@@ -1390,16 +1394,18 @@ void SetRulesParam(lua_State* L, const char* caller, int offset,
 	const int losIndex = offset + 3; // table
 
 	const std::string& key = luaL_checkstring(L, index);
+	const size_t numParams = params.size();
 
 	LuaRulesParams::Param& param = params[key];
+	decltype(param.value) value;
 
 	// set the value of the parameter
 	if (lua_israwnumber(L, valIndex)) {
-		param.value.emplace <float> (lua_tofloat(L, valIndex));
+		value.emplace <float> (lua_tofloat(L, valIndex));
 	} else if (lua_israwboolean(L, valIndex)) {
-		param.value.emplace <bool> (lua_toboolean(L, valIndex));
+		value.emplace <bool> (lua_toboolean(L, valIndex));
 	} else if (lua_isstring(L, valIndex)) {
-		param.value.emplace <std::string> (lua_tostring(L, valIndex));
+		value.emplace <std::string> (lua_tostring(L, valIndex));
 	} else if (lua_isnoneornil(L, valIndex)) {
 		params.erase(key);
 		return; //no need to set los if param was erased
@@ -1408,6 +1414,14 @@ void SetRulesParam(lua_State* L, const char* caller, int offset,
 		luaL_error(L, "Incorrect arguments to %s()", caller);
 	}
 
+	const int prevLos = param.los;
+
+	// re-setting an unchanged value does not count as a change
+	if (params.size() != numParams || value != param.value) {
+		param.value = std::move(value);
+		param.changeFrame = gs->frameNum;
+	}
+
 	// set the los checking of the parameter
 	if (lua_istable(L, losIndex)) {
 		int losMask = LuaRulesParams::RULESPARAMLOS_PRIVATE;
@@ -1436,6 +1450,9 @@ void SetRulesParam(lua_State* L, const char* caller, int offset,
 	} else {
 		param.los = luaL_optint(L, losIndex, param.los);
 	}
+
+	if (param.los != prevLos)
+		param.changeFrame = gs->frameNum;
 }
 
 
@@ -4019,6 +4036,151 @@ int LuaSyncedCtrl::SetUnitVelocity(lua_State* L)
 }
 
 
+enum BulkSetUnitField {
+	BULK_SET_UNIT_POSITION,
+	BULK_SET_UNIT_VELOCITY,
+	BULK_SET_UNIT_HEALTH,
+	BULK_SET_UNIT_FIELD_COUNT,
+};
+
+static constexpr std::array<const char*, BULK_SET_UNIT_FIELD_COUNT> BULK_SET_UNIT_FIELD_NAMES = {
+	"position", "velocity", "health",
+};
+static constexpr std::array<int, BULK_SET_UNIT_FIELD_COUNT> BULK_SET_UNIT_FIELD_SIZES = {
+	3, 3, 1,
+};
+
+/*** Sets several fields of many units in one call
+ *
+ * The counterpart of Spring.GetUnitsBulk: values are read unit after unit
+ * from one flat array, each unit taking `stride` entries in the order the
+ * fields are given. A field whose first entry is nil is left unchanged for
+ * that unit; units that cannot be controlled are skipped.
+ *
+ * Fields: "position" (x, y, z) as Spring.SetUnitPosition, "velocity"
+ * (x, y, z) as Spring.SetUnitVelocity and "health" as Spring.SetUnitHealth.
+ * Blocking-map and quadfield updates of moved units are done once all units
+ * were moved, UnitMoved events are sent in unit order after that.
+ *
+ * @function Spring.SetUnitsBulk
+ * @param unitIDs integer[]
+ * @param fields string[]
+ * @param values number[]
+ * @return integer numUnits number of units that were changed
+ */
+int LuaSyncedCtrl::SetUnitsBulk(lua_State* L)
+{
+	luaL_checktype(L, 1, LUA_TTABLE);
+	luaL_checktype(L, 2, LUA_TTABLE);
+	luaL_checktype(L, 3, LUA_TTABLE);
+
+	std::array<BulkSetUnitField, BULK_SET_UNIT_FIELD_COUNT> fields;
+
+	size_t numFields = 0;
+	int stride = 0;
+
+	for (int i = 1, n = std::min(int(lua_objlen(L, 2)), int(fields.size())); i <= n; i++) {
+		lua_rawgeti(L, 2, i);
+
+		const char* name = luaL_checkstring(L, -1);
+		const auto iter = std::find_if(BULK_SET_UNIT_FIELD_NAMES.begin(), BULK_SET_UNIT_FIELD_NAMES.end(), [&](const char* f) { return (strcmp(f, name) == 0); });
+
+		if (iter == BULK_SET_UNIT_FIELD_NAMES.end())
+			luaL_error(L, "[%s] unknown field \"%s\"", __func__, name);
+
+		fields[numFields] = static_cast<BulkSetUnitField>(iter - BULK_SET_UNIT_FIELD_NAMES.begin());
+		stride += BULK_SET_UNIT_FIELD_SIZES[fields[numFields++]];
+
+		lua_pop(L, 1);
+	}
+
+	const int numUnits = lua_objlen(L, 1);
+
+	if (lua_objlen(L, 3) < size_t(numUnits * stride))
+		luaL_error(L, "[%s] expected %d values, got %d", __func__, numUnits * stride, int(lua_objlen(L, 3)));
+
+	// units moved by this call, blocking and quadfield are updated in bulk below
+	static std::vector< std::pair<CUnit*, float3> > movedUnits;
+	movedUnits.clear();
+
+	int valuePos = 1;
+	int numChanged = 0;
+
+	const auto HasValue = [&]() { lua_rawgeti(L, 3, valuePos); const bool ret = !lua_isnil(L, -1); lua_pop(L, 1); return ret; };
+	const auto GetValue = [&]() { lua_rawgeti(L, 3, valuePos++); const float ret = luaL_checkfloat(L, -1); lua_pop(L, 1); return ret; };
+
+	for (int i = 1; i <= numUnits; i++) {
+		lua_rawgeti(L, 1, i);
+		CUnit* unit = ParseUnit(L, __func__, -1);
+		lua_pop(L, 1);
+
+		if (unit == nullptr) {
+			valuePos += stride;
+			continue;
+		}
+
+		for (size_t j = 0; j < numFields; j++) {
+			const int fieldSize = BULK_SET_UNIT_FIELD_SIZES[fields[j]];
+
+			if (!HasValue()) {
+				valuePos += fieldSize;
+				continue;
+			}
+
+			switch (fields[j]) {
+				case BULK_SET_UNIT_POSITION: {
+					float3 pos;
+					pos.x = GetValue();
+					pos.y = GetValue();
+					pos.z = GetValue();
+
+					// buildings snap to the build grid and flatten the ground, keep their own path
+					if (dynamic_cast<CBuilding*>(unit) != nullptr) {
+						unit->ForcedMove(pos);
+					} else {
+						movedUnits.emplace_back(unit, pos);
+					}
+				} break;
+				case BULK_SET_UNIT_VELOCITY: {
+					float3 speed;
+					speed.x = std::clamp(GetValue(), -MAX_UNIT_SPEED, MAX_UNIT_SPEED);
+					speed.y = std::clamp(GetValue(), -MAX_UNIT_SPEED, MAX_UNIT_SPEED);
+					speed.z = std::clamp(GetValue(), -MAX_UNIT_SPEED, MAX_UNIT_SPEED);
+
+					unit->SetVelocityAndSpeed(speed);
+				} break;
+				case BULK_SET_UNIT_HEALTH: {
+					unit->health = std::min(unit->maxHealth, GetValue());
+				} break;
+				default: {
+					assert(false);
+				} break;
+			}
+		}
+
+		numChanged += 1;
+	}
+
+	// same steps as CUnit::ForcedMove, each done for all units at once
+	for (const auto& [unit, pos]: movedUnits) {
+		unit->UnBlock();
+	}
+	for (const auto& [unit, pos]: movedUnits) {
+		unit->Move(pos - unit->pos, true);
+	}
+	for (const auto& [unit, pos]: movedUnits) {
+		unit->Block();
+	}
+	for (const auto& [unit, pos]: movedUnits) {
+		eventHandler.UnitMoved(unit);
+		quadField.MovedUnit(unit);
+	}
+
+	lua_pushnumber(L, numChanged);
+	return 1;
+}
+
+
 /***
  *
  * @function Spring.SetFactoryBuggerOff
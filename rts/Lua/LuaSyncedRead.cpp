@@ -77,7 +77,11 @@
 #include "System/FileSystem/FileSystem.h"
 #include "System/StringUtil.h"
 
+#include <algorithm>
+#include <array>
 #include <cctype>
+#include <cstring>
+#include <limits>
 #include <type_traits>
 
 
@@ -154,6 +158,7 @@ bool LuaSyncedRead::PushEntries(lua_State* L)
 	REGISTER_LUA_CFUNC(GetTeamInfo);
 	REGISTER_LUA_CFUNC(GetTeamAllyTeamID);
 	REGISTER_LUA_CFUNC(GetTeamResources);
+	REGISTER_LUA_CFUNC(GetTeamUnitDefResources);
 	REGISTER_LUA_CFUNC(GetTeamUnitStats);
 	REGISTER_LUA_CFUNC(GetTeamResourceStats);
 	REGISTER_LUA_CFUNC(GetTeamDamageStats);
@@ -187,6 +192,7 @@ bool LuaSyncedRead::PushEntries(lua_State* L)
 
 	REGISTER_LUA_CFUNC(GetUnitArrayCentroid);
 	REGISTER_LUA_CFUNC(GetUnitMapCentroid);
+	REGISTER_LUA_CFUNC(GetUnitsBulk);
 
 	REGISTER_LUA_CFUNC(GetFeaturesInRectangle);
 	REGISTER_LUA_CFUNC(GetFeaturesInSphere);
@@ -288,6 +294,7 @@ bool LuaSyncedRead::PushEntries(lua_State* L)
 
 	REGISTER_LUA_CFUNC(GetUnitRulesParam);
 	REGISTER_LUA_CFUNC(GetUnitRulesParams);
+	REGISTER_LUA_CFUNC(GetUnitRulesParamsChanged);
 
 	REGISTER_LUA_CFUNC(GetCEGID);
 
@@ -336,6 +343,7 @@ bool LuaSyncedRead::PushEntries(lua_State* L)
 	REGISTER_LUA_CFUNC(GetWaterPlaneLevel);
 	REGISTER_LUA_CFUNC(GetWaterLevel);
 	REGISTER_LUA_CFUNC(GetGroundHeight);
+	REGISTER_LUA_CFUNC(GetGroundHeights);
 	REGISTER_LUA_CFUNC(GetGroundOrigHeight);
 	REGISTER_LUA_CFUNC(GetGroundNormal);
 	REGISTER_LUA_CFUNC(GetGroundInfo);
@@ -695,7 +703,8 @@ static inline const CTeam* ParseTeam(lua_State* L, const char* caller, int index
 
 static int PushRulesParams(lua_State* L, const char* caller,
                           const LuaRulesParams::Params& params,
-                          const int losStatus)
+                          const int losStatus,
+                          const int sinceFrame = std::numeric_limits<int>::min())
 {
 	lua_createtable(L, 0, params.size());
 
@@ -704,6 +713,8 @@ static int PushRulesParams(lua_State* L, const char* caller,
 		const LuaRulesParams::Param& param = it.second;
 		if (!(param.los & losStatus))
 			continue;
+		if (param.changeFrame <= sinceFrame)
+			continue;
 
 		std::visit ([L, &name](auto&& value) {
 			using T = std::decay_t <decltype(value)>;
@@ -1095,6 +1106,58 @@ int LuaSyncedRead::GetUnitRulesParams(lua_State* L)
 }
 
 
+/***
+ * Returns the rules params of the given units that were set to a different
+ * value (or access policy) after `sinceFrame`, so widgets can react to changes
+ * instead of polling every param of every unit each frame.
+ *
+ * Units without such changes are omitted; removed params are not reported.
+ *
+ * @function Spring.GetUnitRulesParamsChanged
+ *
+ * @param unitIDs integer[]
+ * @param sinceFrame integer
+ *
+ * @return table<integer, RulesParams> changedParams map of unitID to changed params
+ */
+int LuaSyncedRead::GetUnitRulesParamsChanged(lua_State* L)
+{
+	luaL_checktype(L, 1, LUA_TTABLE);
+
+	const int sinceFrame = luaL_checkint(L, 2);
+	const int numUnits = lua_objlen(L, 1);
+
+	if (game == nullptr)
+		return 0;
+
+	lua_createtable(L, 0, 0);
+
+	for (int i = 1; i <= numUnits; i++) {
+		lua_rawgeti(L, 1, i);
+
+		const CUnit* unit = lua_isnumber(L, -1)? unitHandler.GetUnit(lua_toint(L, -1)): nullptr;
+
+		lua_pop(L, 1);
+
+		if (unit == nullptr || !LuaUtils::IsUnitVisible(L, unit))
+			continue;
+
+		const int losMask = GetUnitRulesParamLosMask(L, unit);
+		const auto& params = unit->modParams;
+
+		const auto pred = [&](const auto& p) { return ((p.second.los & losMask) != 0 && p.second.changeFrame > sinceFrame); };
+
+		if (std::find_if(params.begin(), params.end(), pred) == params.end())
+			continue;
+
+		PushRulesParams(L, __func__, params, losMask, sinceFrame);
+		lua_rawseti(L, -2, unit->id);
+	}
+
+	return 1;
+}
+
+
 /***
  *
  * @function Spring.GetFeatureRulesParams
@@ -1860,6 +1923,53 @@ int LuaSyncedRead::GetTeamResources(lua_State* L)
 }
 
 
+/***
+ * @class UnitDefResources
+ * @field count integer Number of units of this unitDef.
+ * @field metalMake number
+ * @field metalUse number
+ * @field energyMake number
+ * @field energyUse number
+ * @see Spring.GetTeamUnitDefResources
+ */
+
+/***
+ *
+ * @function Spring.GetTeamUnitDefResources
+ *
+ * Per-unitDef sums of `Spring.GetUnitResources` over all units of the team,
+ * as of the last team resource update (once per second).
+ *
+ * @param teamID integer
+ * @return table<integer,UnitDefResources>? resourcesByUnitDef A table where keys are unitDefIDs, only unitDefs the team has units of are present.
+ */
+int LuaSyncedRead::GetTeamUnitDefResources(lua_State* L)
+{
+	const CTeam* team = ParseTeam(L, __func__, 1);
+	if (team == nullptr)
+		return 0;
+
+	if (!LuaUtils::IsAlliedTeam(L, team->teamNum))
+		return 0;
+
+	const auto& unitDefEconomy = team->GetUnitDefEconomy();
+
+	lua_createtable(L, 0, unitDefEconomy.size());
+
+	for (const CTeam::UnitDefEconomy& defEconomy: unitDefEconomy) {
+		lua_createtable(L, 0, 5);
+		LuaPushNamedNumber(L, "count", defEconomy.numUnits);
+		LuaPushNamedNumber(L, "metalMake", defEconomy.make.metal);
+		LuaPushNamedNumber(L, "metalUse", defEconomy.use.metal);
+		LuaPushNamedNumber(L, "energyMake", defEconomy.make.energy);
+		LuaPushNamedNumber(L, "energyUse", defEconomy.use.energy);
+		lua_rawseti(L, -2, defEconomy.unitDefID);
+	}
+
+	return 1;
+}
+
+
 /***
  *
  * @function Spring.GetTeamUnitStats
@@ -2005,13 +2115,56 @@ int LuaSyncedRead::GetTeamDamageStats(lua_State* L)
  * @param teamID integer
  * @return integer? historyCount The number of history entries, or `nil` if unable to resolve team.
  */
+struct TeamStatsField {
+	float Get(const TeamStatistics& stats) const {
+		const char* ptr = reinterpret_cast<const char*>(&stats) + offset;
+
+		// TeamStatistics is packed, fields may be unaligned
+		if (isInt) {
+			int i; memcpy(&i, ptr, sizeof(i)); return i;
+		}
+
+		float f; memcpy(&f, ptr, sizeof(f)); return f;
+	}
+
+	const char* name;
+	size_t offset;
+	bool isInt;
+};
+
+#define TEAM_STATS_FIELD(name, isInt) TeamStatsField{#name, offsetof(TeamStatistics, name), isInt}
+static const std::array<TeamStatsField, 20> teamStatsFields = {
+	TEAM_STATS_FIELD(frame           , true ),
+	TEAM_STATS_FIELD(metalUsed       , false),
+	TEAM_STATS_FIELD(metalProduced   , false),
+	TEAM_STATS_FIELD(metalExcess     , false),
+	TEAM_STATS_FIELD(metalReceived   , false),
+	TEAM_STATS_FIELD(metalSent       , false),
+	TEAM_STATS_FIELD(energyUsed      , false),
+	TEAM_STATS_FIELD(energyProduced  , false),
+	TEAM_STATS_FIELD(energyExcess    , false),
+	TEAM_STATS_FIELD(energyReceived  , false),
+	TEAM_STATS_FIELD(energySent      , false),
+	TEAM_STATS_FIELD(damageDealt     , false),
+	TEAM_STATS_FIELD(damageReceived  , false),
+	TEAM_STATS_FIELD(unitsProduced   , true ),
+	TEAM_STATS_FIELD(unitsDied       , true ),
+	TEAM_STATS_FIELD(unitsReceived   , true ),
+	TEAM_STATS_FIELD(unitsSent       , true ),
+	TEAM_STATS_FIELD(unitsCaptured   , true ),
+	TEAM_STATS_FIELD(unitsOutCaptured, true ),
+	TEAM_STATS_FIELD(unitsKilled     , true ),
+};
+#undef TEAM_STATS_FIELD
+
 /***
  * Get team stats history.
  * @function Spring.GetTeamStatsHistory
  * @param teamID integer
  * @param startIndex integer
  * @param endIndex integer? (Default: startIndex)
- * @return TeamStats[] The team stats history, or `nil` if unable to resolve team.
+ * @param statName string? When given, only this field (e.g. "metalProduced") is returned per entry as a flat array of numbers.
+ * @return TeamStats[]|number[] The team stats history, or `nil` if unable to resolve team.
  */
 int LuaSyncedRead::GetTeamStatsHistory(lua_State* L)
 {
@@ -2050,6 +2203,32 @@ int LuaSyncedRead::GetTeamStatsHistory(lua_State* L)
 
 	std::advance(it, start);
 
+	if ((args >= 4) && lua_isstring(L, 4)) {
+		// single column, avoids building a 21-field table per entry
+		const char* statName = lua_tostring(L, 4);
+
+		const auto pred = [statName](const TeamStatsField& f) { return (strcmp(f.name, statName) == 0); };
+		const auto iter = std::find_if(teamStatsFields.begin(), teamStatsFields.end(), pred);
+
+		if (iter == teamStatsFields.end())
+			luaL_error(L, "[%s] unknown statName \"%s\"", __func__, statName);
+
+		lua_createtable(L, max(0, end - start + 1), 0);
+
+		for (int i = start, count = 1; statCount > 0 && i <= end; ++i, ++it) {
+			if (iter->offset == offsetof(TeamStatistics, frame) && (i + 1) == statCount) {
+				// see below, the most recent entry has not been stamped yet
+				lua_pushnumber(L, gs->GetLuaSimFrame());
+			} else {
+				lua_pushnumber(L, iter->Get(*it));
+			}
+
+			lua_rawseti(L, -2, count++);
+		}
+
+		return 1;
+	}
+
 	lua_createtable(L, max(0, end - start), 0);
 	if (statCount > 0) {
 		int count = 1;
@@ -3419,6 +3598,160 @@ int LuaSyncedRead::GetUnitMapCentroid(lua_State* L)
 }
 
 
+enum BulkUnitField {
+	BULK_UNIT_DEFID,
+	BULK_UNIT_TEAM,
+	BULK_UNIT_ALLYTEAM,
+	BULK_UNIT_POSITION,
+	BULK_UNIT_VELOCITY,
+	BULK_UNIT_HEALTH,
+	BULK_UNIT_BUILDPROGRESS,
+	BULK_UNIT_FIELD_COUNT,
+};
+
+static constexpr std::array<const char*, BULK_UNIT_FIELD_COUNT> BULK_UNIT_FIELD_NAMES = {
+	"defID", "team", "allyTeam", "position", "velocity", "health", "buildProgress",
+};
+static constexpr std::array<int, BULK_UNIT_FIELD_COUNT> BULK_UNIT_FIELD_SIZES = {
+	1, 1, 1, 3, 3, 2, 1,
+};
+
+/*** Reads several fields of many units in one call
+ *
+ * Results are written unit after unit into one flat array, each unit taking
+ * `stride` entries in the order the fields were requested. The per-unit
+ * getters' visibility rules apply, so a field the caller may not read for
+ * a unit is left nil (as are all fields of invalid unitIDs).
+ *
+ * Fields: "defID", "team", "allyTeam", "position" (x, y, z),
+ * "velocity" (x, y, z), "health" (health, maxHealth) and "buildProgress".
+ *
+ * @function Spring.GetUnitsBulk
+ * @param unitIDs integer[]
+ * @param fields string[]
+ * @param out table? array to write into instead of creating a new one; it is not shrunk
+ * @return table values
+ * @return integer stride
+ */
+int LuaSyncedRead::GetUnitsBulk(lua_State* L)
+{
+	luaL_checktype(L, 1, LUA_TTABLE);
+	luaL_checktype(L, 2, LUA_TTABLE);
+
+	std::array<BulkUnitField, BULK_UNIT_FIELD_COUNT * 2> fields;
+
+	size_t numFields = 0;
+	int stride = 0;
+
+	for (int i = 1, n = std::min(int(lua_objlen(L, 2)), int(fields.size())); i <= n; i++) {
+		lua_rawgeti(L, 2, i);
+
+		const char* name = luaL_checkstring(L, -1);
+		const auto iter = std::find_if(BULK_UNIT_FIELD_NAMES.begin(), BULK_UNIT_FIELD_NAMES.end(), [&](const char* f) { return (strcmp(f, name) == 0); });
+
+		if (iter == BULK_UNIT_FIELD_NAMES.end())
+			luaL_error(L, "[%s] unknown field \"%s\"", __func__, name);
+
+		fields[numFields] = static_cast<BulkUnitField>(iter - BULK_UNIT_FIELD_NAMES.begin());
+		stride += BULK_UNIT_FIELD_SIZES[fields[numFields++]];
+
+		lua_pop(L, 1);
+	}
+
+	const int numUnits = lua_objlen(L, 1);
+
+	if (lua_istable(L, 3)) {
+		lua_pushvalue(L, 3);
+	} else {
+		lua_createtable(L, numUnits * stride, 0);
+	}
+
+	const int outIndex = lua_gettop(L);
+	int outPos = 1;
+
+	const auto SetNumber = [&](float v) { lua_pushnumber(L, v); lua_rawseti(L, outIndex, outPos++); };
+	const auto SetNils = [&](int n) { for (int k = 0; k < n; k++) { lua_pushnil(L); lua_rawseti(L, outIndex, outPos++); } };
+
+	for (int i = 1; i <= numUnits; i++) {
+		lua_rawgeti(L, 1, i);
+		const CUnit* unit = ParseRawUnit(L, __func__, -1);
+		lua_pop(L, 1);
+
+		const bool isVisible = (unit != nullptr && LuaUtils::IsUnitVisible(L, unit));
+		const bool isInLos = (unit != nullptr && LuaUtils::IsUnitInLos(L, unit));
+
+		for (size_t j = 0; j < numFields; j++) {
+			switch (fields[j]) {
+				case BULK_UNIT_DEFID: {
+					if (isVisible && LuaUtils::IsAllyUnit(L, unit)) {
+						SetNumber(unit->unitDef->id);
+					} else if (isVisible && LuaUtils::IsUnitTyped(L, unit)) {
+						SetNumber(LuaUtils::EffectiveUnitDef(L, unit)->id);
+					} else {
+						SetNils(1);
+					}
+				} break;
+				case BULK_UNIT_TEAM: {
+					if (isVisible) { SetNumber(unit->team); } else { SetNils(1); }
+				} break;
+				case BULK_UNIT_ALLYTEAM: {
+					if (isVisible) { SetNumber(unit->allyteam); } else { SetNils(1); }
+				} break;
+				case BULK_UNIT_POSITION: {
+					if (!isVisible) {
+						SetNils(3);
+						break;
+					}
+
+					float3 errorVec;
+
+					if (!LuaUtils::IsAllyUnit(L, unit))
+						errorVec = unit->GetLuaErrorVector(CLuaHandle::GetHandleReadAllyTeam(L), CLuaHandle::GetHandleFullRead(L));
+
+					SetNumber(unit->pos.x + errorVec.x);
+					SetNumber(unit->pos.y + errorVec.y);
+					SetNumber(unit->pos.z + errorVec.z);
+				} break;
+				case BULK_UNIT_VELOCITY: {
+					if (!isInLos) {
+						SetNils(3);
+						break;
+					}
+
+					SetNumber(unit->speed.x);
+					SetNumber(unit->speed.y);
+					SetNumber(unit->speed.z);
+				} break;
+				case BULK_UNIT_HEALTH: {
+					const UnitDef* ud = isInLos? unit->unitDef: nullptr;
+					const bool enemyUnit = isInLos && LuaUtils::IsEnemyUnit(L, unit);
+
+					if (!isInLos || (ud->hideDamage && enemyUnit)) {
+						SetNils(2);
+					} else if (!enemyUnit || (ud->decoyDef == nullptr)) {
+						SetNumber(unit->health);
+						SetNumber(unit->maxHealth);
+					} else {
+						const float scale = (ud->decoyDef->health / ud->health);
+						SetNumber(scale * unit->health);
+						SetNumber(scale * unit->maxHealth);
+					}
+				} break;
+				case BULK_UNIT_BUILDPROGRESS: {
+					if (isInLos) { SetNumber(unit->buildProgress); } else { SetNils(1); }
+				} break;
+				default: {
+					assert(false);
+				} break;
+			}
+		}
+	}
+
+	lua_pushnumber(L, stride);
+	return 2;
+}
+
+
 /***
  *
  * @function Spring.GetUnitNearestAlly
@@ -7566,6 +7899,55 @@ int LuaSyncedRead::GetGroundHeight(lua_State* L)
 	return 1;
 }
 
+static std::vector<float> gghPosX;
+static std::vector<float> gghPosZ;
+static std::vector<float> gghHeights;
+
+/*** Get ground heights of many positions in one call
+ *
+ * Same as calling Spring.GetGroundHeight for each position, but without the
+ * per-call overhead.
+ *
+ * @function Spring.GetGroundHeights
+ * @param coords number[] flat array of positions, `{x1, z1, x2, z2, ...}`
+ * @param out table? array to write into instead of creating a new one; it is not shrunk
+ * @return number[] heights one per position
+ */
+int LuaSyncedRead::GetGroundHeights(lua_State* L)
+{
+	luaL_checktype(L, 1, LUA_TTABLE);
+
+	const int numCoords = lua_objlen(L, 1);
+	const int numPositions = numCoords / 2;
+
+	gghPosX.resize(numPositions);
+	gghPosZ.resize(numPositions);
+	gghHeights.resize(numPositions);
+
+	for (int i = 0; i < numPositions; i++) {
+		lua_rawgeti(L, 1, i * 2 + 1);
+		lua_rawgeti(L, 1, i * 2 + 2);
+		gghPosX[i] = luaL_checkfloat(L, -2);
+		gghPosZ[i] = luaL_checkfloat(L, -1);
+		lua_pop(L, 2);
+	}
+
+	CGround::GetHeightReal(gghPosX.data(), gghPosZ.data(), gghHeights.data(), numPositions, CLuaHandle::GetHandleSynced(L));
+
+	if (lua_istable(L, 2)) {
+		lua_pushvalue(L, 2);
+	} else {
+		lua_createtable(L, numPositions, 0);
+	}
+
+	for (int i = 0; i < numPositions; i++) {
+		lua_pushnumber(L, gghHeights[i]);
+		lua_rawseti(L, -2, i + 1);
+	}
+
+	return 1;
+}
+
 /*** Get water plane height
  *
  * Water may at some point become shaped (rivers etc) but for now it is always a flat plane.
@@ -67,6 +67,7 @@ class LuaSyncedRead {
 		static int GetPlayerRulesParams(lua_State* L);
 
 		static int GetTeamResources(lua_State* L);
+		static int GetTeamUnitDefResources(lua_State* L);
 		static int GetTeamUnitStats(lua_State* L);
 		static int GetTeamResourceStats(lua_State* L);
 		static int GetTeamDamageStats(lua_State* L);
@@ -91,6 +92,7 @@ class LuaSyncedRead {
 
 		static int GetUnitArrayCentroid(lua_State* L);
 		static int GetUnitMapCentroid(lua_State* L);
+		static int GetUnitsBulk(lua_State* L);
 
 		static int GetUnitNearestAlly(lua_State* L);
 		static int GetUnitNearestEnemy(lua_State* L);
@@ -189,6 +191,7 @@ class LuaSyncedRead {
 
 		static int GetUnitRulesParam(lua_State* L);
 		static int GetUnitRulesParams(lua_State* L);
+		static int GetUnitRulesParamsChanged(lua_State* L);
 
 		static int GetUnitLosState(lua_State* L);
 		static int GetUnitSeparation(lua_State* L);
@@ -243,6 +246,7 @@ class LuaSyncedRead {
 		static int GetWaterPlaneLevel(lua_State* L);
 		static int GetWaterLevel(lua_State* L);
 		static int GetGroundHeight(lua_State* L);
+		static int GetGroundHeights(lua_State* L);
 		static int GetGroundOrigHeight(lua_State* L);
 		static int GetGroundNormal(lua_State* L);
 		static int GetGroundInfo(lua_State* L);
@@ -25,6 +25,7 @@
 #include "LuaUtils.h"
 #include "LuaVFS.h"
 #include "LuaVFSDownload.h"
+#include "LuaWorker.h"
 #include "LuaIO.h"
 #include "LuaZip.h"
 #include "Game/Camera.h"
@@ -159,6 +160,7 @@ CLuaUI::CLuaUI()
 	    !AddEntriesToTable(L, "Spring",      LuaUnsyncedCtrl::PushEntries)   ||
 	    !AddEntriesToTable(L, "Spring",      LuaUnsyncedRead::PushEntries)   ||
 	    !AddEntriesToTable(L, "Spring",      LuaUICommand::PushEntries)      ||
+	    !AddEntriesToTable(L, "Spring",      LuaWorker::PushEntries)         ||
 	    !AddEntriesToTable(L, "gl",          LuaOpenGL::PushEntries)         ||
 	    !AddEntriesToTable(L, "GL",          LuaConstGL::PushEntries)        ||
 	    !AddEntriesToTable(L, "Engine",      LuaConstEngine::PushEntries)    ||
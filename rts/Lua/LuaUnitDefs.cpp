@@ -135,7 +135,7 @@ static int UnitDefIndex(lua_State* L)
 			return 1;
 		}
 		case FUNCTION_TYPE: {
-			return elem.func(L, p);
+			return LuaUtils::PushObjectDefFuncValue(L, name, elem, p);
 		}
 		case ERROR_TYPE: {
 			LOG_L(L_ERROR, "[%s] ERROR_TYPE for key \"%s\" in UnitDefs __index", __func__, name);
@@ -3,10 +3,12 @@
 #include "LuaUnsyncedCtrl.h"
 
 #include "Game/Camera/DollyController.h"
+#include "LuaCallInProfiler.h"
 #include "LuaConfig.h"
 #include "LuaInclude.h"
 #include "LuaHandle.h"
 #include "LuaHashString.h"
+#include "LuaIO.h"
 #include "LuaMenu.h"
 #include "LuaOpenGLUtils.h"
 #include "LuaParser.h"
@@ -305,6 +307,8 @@ bool LuaUnsyncedCtrl::PushEntries(lua_State* L)
 	REGISTER_LUA_CFUNC(SetLogSectionFilterLevel);
 
 	REGISTER_LUA_CFUNC(ClearWatchDogTimer);
+	REGISTER_LUA_CFUNC(SetCallInProfiling);
+	REGISTER_LUA_CFUNC(DumpCallInProfile);
 	REGISTER_LUA_CFUNC(GarbageCollectCtrl);
 
 	REGISTER_LUA_CFUNC(PreloadUnitDefModel);
@@ -4260,6 +4264,7 @@ int LuaUnsyncedCtrl::SetLogSectionFilterLevel(lua_State* L) {
  * @param maxLoopRunTime number?
  * @param baseRunTimeMult number?
  * @param baseMemLoadMult number?
+ * @param allocDebtMult number? KB of collector steps per KB allocated before a cycle may end early, 0 to always use the full time budget
  * @return nil
  */
 int LuaUnsyncedCtrl::GarbageCollectCtrl(lua_State* L) {
@@ -4277,6 +4282,7 @@ int LuaUnsyncedCtrl::GarbageCollectCtrl(lua_State* L) {
 
 	gcCtrl.baseRunTimeMult = std::max(0.0f, luaL_optfloat(L, 7, gcCtrl.baseRunTimeMult));
 	gcCtrl.baseMemLoadMult = std::max(0.0f, luaL_optfloat(L, 8, gcCtrl.baseMemLoadMult));
+	gcCtrl.allocDebtMult = std::max(0.0f, luaL_optfloat(L, 9, gcCtrl.allocDebtMult));
 
 	return 0;
 }
@@ -5291,6 +5297,42 @@ int LuaUnsyncedCtrl::ClearWatchDogTimer(lua_State* L) {
 }
 
 
+/*** Toggles gathering of per call-in time, call count and allocation stats
+ *
+ * @function Spring.SetCallInProfiling
+ * @param enabled boolean
+ * @param reset boolean? (Default: `false`) discard what was gathered so far
+ * @return nil
+ */
+int LuaUnsyncedCtrl::SetCallInProfiling(lua_State* L)
+{
+	luaCallInProfiler.SetEnabled(luaL_checkboolean(L, 1));
+
+	if (luaL_optboolean(L, 2, false))
+		luaCallInProfiler.Reset();
+
+	return 0;
+}
+
+
+/*** Writes the call-in profile as a text table, most expensive entries first
+ *
+ * @function Spring.DumpCallInProfile
+ * @param fileName string? (Default: `"callinprofile.txt"`) relative to the write directory
+ * @return boolean success
+ */
+int LuaUnsyncedCtrl::DumpCallInProfile(lua_State* L)
+{
+	const std::string fileName = luaL_optsstring(L, 1, "callinprofile.txt");
+
+	if (!LuaIO::IsSimplePath(fileName))
+		luaL_error(L, "[%s] invalid file name \"%s\"", __func__, fileName.c_str());
+
+	lua_pushboolean(L, luaCallInProfiler.DumpToFile(fileName));
+	return 1;
+}
+
+
 /*** @function Spring.SetClipboard
  * @param text string
  * @return nil
@@ -198,6 +198,8 @@ class LuaUnsyncedCtrl {
 		static int SetLogSectionFilterLevel(lua_State* L);
 
 		static int ClearWatchDogTimer(lua_State* L);
+		static int SetCallInProfiling(lua_State* L);
+		static int DumpCallInProfile(lua_State* L);
 		static int GarbageCollectCtrl(lua_State* L);
 
 		static int PreloadUnitDefModel(lua_State* L);
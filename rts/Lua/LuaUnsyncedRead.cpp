@@ -2,10 +2,12 @@
 
 #include "LuaUnsyncedRead.h"
 
+#include "LuaCallInProfiler.h"
 #include "LuaConfig.h"
 #include "LuaInclude.h"
 #include "LuaHandle.h"
 #include "LuaHashString.h"
+#include "LuaMetalMap.h"
 #include "LuaUtils.h"
 #include "LuaRules.h"
 #include "Game/Camera.h"
@@ -82,6 +84,7 @@
 
 #include <cctype>
 #include <algorithm>
+#include <array>
 
 #include <SDL_keyboard.h>
 #include <SDL_clipboard.h>
@@ -105,6 +108,7 @@ bool LuaUnsyncedRead::PushEntries(lua_State* L)
 
 	REGISTER_LUA_CFUNC(GetProfilerTimeRecord);
 	REGISTER_LUA_CFUNC(GetProfilerRecordNames);
+	REGISTER_LUA_CFUNC(GetCallInProfile);
 
 	REGISTER_LUA_CFUNC(GetLuaMemUsage);
 	REGISTER_LUA_CFUNC(GetVidMemUsage);
@@ -226,6 +230,7 @@ bool LuaUnsyncedRead::PushEntries(lua_State* L)
 	REGISTER_LUA_CFUNC(GetSoundEffectParams);
 
 	REGISTER_LUA_CFUNC(GetFPS);
+	REGISTER_LUA_CFUNC(GetGPUFrameTimes);
 	REGISTER_LUA_CFUNC(GetGameSpeed);
 	REGISTER_LUA_CFUNC(GetGameState);
 
@@ -305,6 +310,9 @@ bool LuaUnsyncedRead::PushEntries(lua_State* L)
 	REGISTER_LUA_CFUNC(GetSyncedGCInfo);
 	REGISTER_LUA_CFUNC(SolveNURBSCurve);
 
+	if (!LuaMetalMap::PushUnsyncedReadEntries(L))
+		return false;
+
 	return true;
 }
 
@@ -587,6 +595,48 @@ int LuaUnsyncedRead::GetProfilerRecordNames(lua_State* L)
 }
 
 
+/***
+ * @class CallInProfileRecord
+ * @field handle string
+ * @field callIn string
+ * @field scope string empty for the call-in as a whole
+ * @field calls integer
+ * @field time number total in ms
+ * @field maxTime number in ms
+ * @field allocBytes number
+ */
+
+/*** Returns the call-in profile, most expensive entries first
+ *
+ * Empty unless enabled by Spring.SetCallInProfiling.
+ *
+ * @function Spring.GetCallInProfile
+ * @return CallInProfileRecord[] records
+ */
+int LuaUnsyncedRead::GetCallInProfile(lua_State* L)
+{
+	const std::vector<CLuaCallInProfiler::Record> records = luaCallInProfiler.GetRecords();
+
+	lua_createtable(L, records.size(), 0);
+
+	for (size_t i = 0; i < records.size(); i++) {
+		const CLuaCallInProfiler::Record& rec = records[i];
+
+		lua_createtable(L, 0, 7);
+		HSTR_PUSH_STRING(L, "handle", rec.handleName);
+		HSTR_PUSH_STRING(L, "callIn", std::string(rec.callInName));
+		HSTR_PUSH_STRING(L, "scope", rec.scopeName);
+		HSTR_PUSH_NUMBER(L, "calls", rec.numCalls);
+		HSTR_PUSH_NUMBER(L, "time", rec.totalTime.toMilliSecsf());
+		HSTR_PUSH_NUMBER(L, "maxTime", rec.maxTime.toMilliSecsf());
+		HSTR_PUSH_NUMBER(L, "allocBytes", rec.allocBytes);
+		lua_rawseti(L, -2, i + 1);
+	}
+
+	return 1;
+}
+
+
 /***
  *
  * @function Spring.GetLuaMemUsage
@@ -1775,6 +1825,80 @@ public:
 };
 
 
+/**
+ * Remembers the IDs returned by GetVisibleUnits and GetVisibleFeatures for
+ * each argument combination, as long as neither the camera nor the draw- or
+ * sim-frame changed; many widgets ask the same question every draw-frame.
+ */
+class CVisibleObjectsCache {
+public:
+	typedef std::array<float, 6> Key;
+
+	/// clears all entries if the view changed since they were added
+	void Validate() {
+		const CMatrix44f& curViewProjMat = camera->GetViewProjectionMatrix();
+
+		if (drawFrame == globalRendering->drawFrame && simFrame == gs->frameNum && viewCamera == camera && std::equal(std::begin(viewProjMat.m), std::end(viewProjMat.m), std::begin(curViewProjMat.m)))
+			return;
+
+		drawFrame = globalRendering->drawFrame;
+		simFrame = gs->frameNum;
+		viewCamera = camera;
+		viewProjMat = curViewProjMat;
+
+		numEntries = 0;
+	}
+
+	const std::vector<int>* Find(const Key& key) const {
+		for (size_t i = 0; i < numEntries; i++) {
+			if (entries[i].key == key)
+				return &entries[i].objectIDs;
+		}
+
+		return nullptr;
+	}
+
+	/// returns nullptr if all entries are taken, results are not cached then
+	std::vector<int>* Insert(const Key& key) {
+		if (numEntries == entries.size())
+			return nullptr;
+
+		Entry& entry = entries[numEntries++];
+		entry.key = key;
+		entry.objectIDs.clear();
+		return &entry.objectIDs;
+	}
+
+private:
+	struct Entry {
+		Key key;
+		std::vector<int> objectIDs;
+	};
+
+	std::array<Entry, 16> entries;
+	size_t numEntries = 0;
+
+	unsigned int drawFrame = -1u;
+	int simFrame = -1;
+
+	const CCamera* viewCamera = nullptr;
+	CMatrix44f viewProjMat;
+};
+
+static void PushCachedObjectIDs(lua_State* L, const std::vector<int>& objectIDs)
+{
+	lua_createtable(L, objectIDs.size(), 0);
+
+	for (size_t i = 0; i < objectIDs.size(); i++) {
+		lua_pushnumber(L, objectIDs[i]);
+		lua_rawseti(L, -2, i + 1);
+	}
+}
+
+static CVisibleObjectsCache visUnitsCache;
+static CVisibleObjectsCache visFeaturesCache;
+
+
 /***
  *
  * @function Spring.GetVisibleUnits
@@ -1823,6 +1947,17 @@ int LuaUnsyncedRead::GetVisibleUnits(lua_State* L)
 		testRadius = std::max(testRadius, -testRadius);
 	}
 
+	const CVisibleObjectsCache::Key cacheKey = {float(teamID), float(allyTeamID), float(noIcons), radiusMult, testRadius, 0.0f};
+
+	visUnitsCache.Validate();
+
+	if (const std::vector<int>* cachedIDs = visUnitsCache.Find(cacheKey); cachedIDs != nullptr) {
+		PushCachedObjectIDs(L, *cachedIDs);
+		return 1;
+	}
+
+	std::vector<int>* cacheIDs = visUnitsCache.Insert(cacheKey);
+
 	static CVisUnitQuadDrawer unitQuadIter;
 
 	unitQuadIter.ResetState();
@@ -1864,6 +1999,9 @@ int LuaUnsyncedRead::GetVisibleUnits(lua_State* L)
 			if (!camera->InView(u->drawMidPos, testRadius + (u->GetDrawRadius() * radiusMult)))
 				continue;
 
+			if (cacheIDs != nullptr)
+				cacheIDs->push_back(u->id);
+
 			lua_pushnumber(L, u->id);
 			lua_rawseti(L, -2, ++count);
 		}
@@ -1911,6 +2049,17 @@ int LuaUnsyncedRead::GetVisibleFeatures(lua_State* L)
 		testRadius = std::max(testRadius, -testRadius);
 	}
 
+	const CVisibleObjectsCache::Key cacheKey = {float(allyTeamID), float(gu->spectatingFullView), float(noIcons), float(noGeos), radiusMult, testRadius};
+
+	visFeaturesCache.Validate();
+
+	if (const std::vector<int>* cachedIDs = visFeaturesCache.Find(cacheKey); cachedIDs != nullptr) {
+		PushCachedObjectIDs(L, *cachedIDs);
+		return 1;
+	}
+
+	std::vector<int>* cacheIDs = visFeaturesCache.Insert(cacheKey);
+
 	static CVisFeatureQuadDrawer featureQuadIter;
 
 	featureQuadIter.ResetState();
@@ -1944,6 +2093,9 @@ int LuaUnsyncedRead::GetVisibleFeatures(lua_State* L)
 			if (!camera->InView(f->drawMidPos, testRadius + (f->GetDrawRadius() * radiusMult)))
 				continue;
 
+			if (cacheIDs != nullptr)
+				cacheIDs->push_back(f->id);
+
 			lua_pushnumber(L, f->id);
 			lua_rawseti(L, -2, ++count);
 		}
@@ -3314,6 +3466,27 @@ int LuaUnsyncedRead::GetFPS(lua_State* L)
 }
 
 
+/***
+ * Gets the GPU time spent on the previous draw-frame
+ *
+ * Measured with timer queries; meant for widgets that scale their own render
+ * passes (e.g. post-processing resolution) to hold a target frame time.
+ *
+ * @function Spring.GetGPUFrameTimes
+ * @return number? frameTime in milliseconds, nil if timer queries are unavailable
+ * @return number? worldTime in milliseconds, the part spent drawing the world
+ */
+int LuaUnsyncedRead::GetGPUFrameTimes(lua_State* L)
+{
+	if (!globalRendering->HaveGLDeltaTimes())
+		return 0;
+
+	lua_pushnumber(L, globalRendering->CalcGLDeltaTime(CGlobalRendering::FRAME_REF_TIME_QUERY_IDX, CGlobalRendering::FRAME_END_TIME_QUERY_IDX) * 1e-6f);
+	lua_pushnumber(L, globalRendering->CalcGLDeltaTime(CGlobalRendering::WORLD_BEG_TIME_QUERY_IDX, CGlobalRendering::WORLD_END_TIME_QUERY_IDX) * 1e-6f);
+	return 2;
+}
+
+
 /***
  *
  * @function Spring.GetGameSpeed
@@ -21,6 +21,7 @@ class LuaUnsyncedRead {
 
 		static int GetProfilerTimeRecord(lua_State* L);
 		static int GetProfilerRecordNames(lua_State* L);
+		static int GetCallInProfile(lua_State* L);
 
 		static int GetLuaMemUsage(lua_State* L);
 		static int GetVidMemUsage(lua_State* L);
@@ -140,6 +141,7 @@ class LuaUnsyncedRead {
 		static int GetSoundDevices(lua_State* L);
 
 		static int GetFPS(lua_State* L);
+		static int GetGPUFrameTimes(lua_State* L);
 		static int GetGameSpeed(lua_State* L);
 		static int GetGameState(lua_State* L);
 
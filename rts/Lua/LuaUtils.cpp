@@ -42,8 +42,15 @@ Json::Value LuaUtils::LuaStackDumper::root  = {};
 /******************************************************************************/
 
 
-static bool CopyPushData(lua_State* dst, lua_State* src, int index, int depth, spring::unsynced_map<const void*, int>& alreadyCopied);
-static bool CopyPushTable(lua_State* dst, lua_State* src, int index, int depth, spring::unsynced_map<const void*, int>& alreadyCopied);
+// objects already copied to dst are kept in a scratch table on dst's stack
+// (at index <cacheIdx>) under the slot numbers stored in <alreadyCopied>
+struct CopyCache {
+	spring::unsynced_map<const void*, int> alreadyCopied;
+	int cacheIdx;
+};
+
+static bool CopyPushData(lua_State* dst, lua_State* src, int index, int depth, CopyCache& cache);
+static bool CopyPushTable(lua_State* dst, lua_State* src, int index, int depth, CopyCache& cache);
 
 
 static inline int PosAbsLuaIndex(lua_State* src, int index)
@@ -55,7 +62,7 @@ static inline int PosAbsLuaIndex(lua_State* src, int index)
 }
 
 
-static bool CopyPushData(lua_State* dst, lua_State* src, int index, int depth, spring::unsynced_map<const void*, int>& alreadyCopied)
+static bool CopyPushData(lua_State* dst, lua_State* src, int index, int depth, CopyCache& cache)
 {
 	switch (lua_type(src, index)) {
 		case LUA_TBOOLEAN: {
@@ -72,9 +79,9 @@ static bool CopyPushData(lua_State* dst, lua_State* src, int index, int depth, s
 			const char* data = lua_tolstring(src, index, &len);
 
 			// check cache
-			auto it = alreadyCopied.find(data);
-			if (it != alreadyCopied.end()) {
-				lua_rawgeti(dst, LUA_REGISTRYINDEX, it->second);
+			auto it = cache.alreadyCopied.find(data);
+			if (it != cache.alreadyCopied.end()) {
+				lua_rawgeti(dst, cache.cacheIdx, it->second);
 				break;
 			}
 
@@ -82,13 +89,14 @@ static bool CopyPushData(lua_State* dst, lua_State* src, int index, int depth, s
 			lua_pushlstring(dst, data, len);
 
 			// cache it
+			const int slot = cache.alreadyCopied.size() + 1;
 			lua_pushvalue(dst, -1);
-			const int dstRef = luaL_ref(dst, LUA_REGISTRYINDEX);
-			alreadyCopied[data] = dstRef;
+			lua_rawseti(dst, cache.cacheIdx, slot);
+			cache.alreadyCopied[data] = slot;
 		} break;
 
 		case LUA_TTABLE: {
-			CopyPushTable(dst, src, index, depth, alreadyCopied);
+			CopyPushTable(dst, src, index, depth, cache);
 		} break;
 
 		default: {
@@ -101,15 +109,15 @@ static bool CopyPushData(lua_State* dst, lua_State* src, int index, int depth, s
 }
 
 
-static bool CopyPushTable(lua_State* dst, lua_State* src, int index, int depth, spring::unsynced_map<const void*, int>& alreadyCopied)
+static bool CopyPushTable(lua_State* dst, lua_State* src, int index, int depth, CopyCache& cache)
 {
 	const int table = PosAbsLuaIndex(src, index);
 
 	// check cache
 	const void* p = lua_topointer(src, table);
-	auto it = alreadyCopied.find(p);
-	if (it != alreadyCopied.end()) {
-		lua_rawgeti(dst, LUA_REGISTRYINDEX, it->second);
+	auto it = cache.alreadyCopied.find(p);
+	if (it != cache.alreadyCopied.end()) {
+		lua_rawgeti(dst, cache.cacheIdx, it->second);
 		return true;
 	}
 
@@ -125,14 +133,15 @@ static bool CopyPushTable(lua_State* dst, lua_State* src, int index, int depth,
 	lua_createtable(dst, array_len, 5);
 
 	// cache it
+	const int slot = cache.alreadyCopied.size() + 1;
 	lua_pushvalue(dst, -1);
-	const int dstRef = luaL_ref(dst, LUA_REGISTRYINDEX);
-	alreadyCopied[p] = dstRef;
+	lua_rawseti(dst, cache.cacheIdx, slot);
+	cache.alreadyCopied[p] = slot;
 
 	// copy table entries
 	for (lua_pushnil(src); lua_next(src, table) != 0; lua_pop(src, 1)) {
-		CopyPushData(dst, src, -2, depth, alreadyCopied); // copy the key
-		CopyPushData(dst, src, -1, depth, alreadyCopied); // copy the value
+		CopyPushData(dst, src, -2, depth, cache); // copy the key
+		CopyPushData(dst, src, -1, depth, cache); // copy the value
 		lua_rawset(dst, -3);
 	}
 
@@ -150,28 +159,28 @@ int LuaUtils::CopyData(lua_State* dst, lua_State* src, int count)
 		LOG_L(L_ERROR, "LuaUtils::CopyData: tried to copy more data than there is");
 		return 0;
 	}
-	lua_checkstack(dst, count + 3); // +3 needed for table copying
+	lua_checkstack(dst, count + 4); // +3 needed for table copying, +1 for the cache
 	lua_lock(src); // we need to be sure tables aren't changed while we iterate them
 
-	// hold a map of all already copied tables in the lua's registry table
-	// needed for recursive tables, i.e. "local t = {}; t[t] = t"
+	// hold a map of all already copied tables, needed for recursive tables
+	// i.e. "local t = {}; t[t] = t"; the copies live in a scratch table on
+	// dst's stack rather than in the registry, saving a ref+unref per object
 	// the order of traversal doesn't matter so we can use an unsynced map
-	spring::unsynced_map<const void*, int> alreadyCopied;
+	CopyCache cache;
+
+	lua_newtable(dst);
+	cache.cacheIdx = lua_gettop(dst);
 
 	const int startIndex = (srcTop - count + 1);
 	const int endIndex   = srcTop;
 	for (int i = startIndex; i <= endIndex; i++) {
-		CopyPushData(dst, src, i, 0, alreadyCopied);
-	}
-
-	// clear map
-	for (auto& pair: alreadyCopied) {
-		luaL_unref(dst, LUA_REGISTRYINDEX, pair.second);
+		CopyPushData(dst, src, i, 0, cache);
 	}
 
 	const int curSrcTop = lua_gettop(src);
 	assert(srcTop == curSrcTop);
-	lua_settop(dst, dstTop + count);
+	lua_settop(dst, dstTop + 1 + count);
+	lua_remove(dst, cache.cacheIdx);
 	lua_unlock(src);
 	return count;
 }
@@ -1276,6 +1285,40 @@ int LuaUtils::ParseFacing(lua_State* L, const char* caller, int index)
 /******************************************************************************/
 
 
+int LuaUtils::PushObjectDefFuncValue(lua_State* L, const char* key, const DataElement& elem, const void* data)
+{
+	// defs do not change after loading, so tables built from them (customParams,
+	// weapons, buildOptions, ...) are created once per state and kept in the def's
+	// metatable, which Lua code can not reach; otherwise every access would build
+	// a new copy and per-frame loops over defs would generate lots of garbage
+	if (!lua_getmetatable(L, 1))
+		return elem.func(L, data);
+
+	const int mtIndex = lua_gettop(L);
+
+	lua_pushstring(L, key);
+	lua_rawget(L, mtIndex);
+
+	if (lua_istable(L, -1)) {
+		lua_remove(L, mtIndex);
+		return 1;
+	}
+
+	lua_settop(L, mtIndex);
+
+	const int numRets = elem.func(L, data);
+
+	if (numRets == 1 && lua_istable(L, -1)) {
+		lua_pushstring(L, key);
+		lua_pushvalue(L, -2);
+		lua_rawset(L, mtIndex);
+	}
+
+	lua_remove(L, mtIndex);
+	return numRets;
+}
+
+
 int LuaUtils::Next(const ParamMap& paramMap, lua_State* L)
 {
 	luaL_checktype(L, 1, LUA_TTABLE);
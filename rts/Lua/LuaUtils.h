@@ -145,6 +145,8 @@ class LuaUtils {
 		// from LuaFeatureDefs.cpp / LuaUnitDefs.cpp / LuaWeaponDefs.cpp
 		// (helper for the Next() iteration routine)
 		static int Next(const ParamMap& paramMap, lua_State* L);
+		// (helper for the __index metamethods, caches table-valued FUNCTION_TYPE keys)
+		static int PushObjectDefFuncValue(lua_State* L, const char* key, const DataElement& elem, const void* data);
 
 		// from LuaParser.cpp / LuaUnsyncedCtrl.cpp
 		// (implementation copied from lua/src/lib/lbaselib.c)
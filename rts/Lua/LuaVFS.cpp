@@ -2,6 +2,7 @@
 
 
 #include <cmath>
+#include <future>
 #include <string_view>
 
 #include "LuaVFS.h"
@@ -16,8 +17,10 @@
 #include "System/FileSystem/VFSHandler.h"
 #include "System/FileSystem/FileSystem.h"
 #include "System/Log/ILog.h"
+#include "System/SafeUtil.h"
 #include "System/StringUtil.h"
 #include "System/TimeProfiler.h"
+#include "System/Threading/ThreadPool.h"
 #include "../tools/pr-downloader/src/pr-downloader.h"
 #include "fmt/format.h"
 
@@ -224,6 +227,7 @@ bool LuaVFS::PushUnsynced(lua_State* L)
 
 	HSTR_PUSH_CFUNC(L, "Include",             UnsyncInclude);
 	HSTR_PUSH_CFUNC(L, "LoadFile",            UnsyncLoadFile);
+	HSTR_PUSH_CFUNC(L, "LoadFileAsync",       LoadFileAsync);
 	HSTR_PUSH_CFUNC(L, "FileExists",          UnsyncFileExists);
 	HSTR_PUSH_CFUNC(L, "DirList",             UnsyncDirList);
 	HSTR_PUSH_CFUNC(L, "SubDirs",             UnsyncSubDirs);
@@ -238,6 +242,14 @@ bool LuaVFS::PushUnsynced(lua_State* L)
 	// HSTR_PUSH_CFUNC(L, "MapArchive",     MapArchive);
 	// HSTR_PUSH_CFUNC(L, "UnmapArchive",   UnmapArchive);
 
+	luaL_newmetatable(L, "LuaVFSLoadFileAsync");
+	lua_pushvalue(L, -1);
+	lua_setfield(L, -2, "__index");
+	HSTR_PUSH_CFUNC(L, "__gc",   meta_LoadFileAsync_gc);
+	HSTR_PUSH_CFUNC(L, "isDone", meta_LoadFileAsync_isDone);
+	HSTR_PUSH_CFUNC(L, "poll",   meta_LoadFileAsync_poll);
+	lua_pop(L, 1);
+
 	return true;
 }
 
@@ -440,6 +452,120 @@ int LuaVFS::UnsyncLoadFile(lua_State* L)
 }
 
 
+/******************************************************************************/
+
+struct LuaVFSAsyncLoad {
+	~LuaVFSAsyncLoad() { Wait(); }
+
+	bool IsDone() const {
+		return (!job.valid() || job.wait_for(std::chrono::seconds(0)) == std::future_status::ready);
+	}
+
+	void Wait() {
+		if (job.valid())
+			job.wait();
+	}
+
+	std::shared_future<void> job;
+	std::string data;
+
+	int loadCode = 0;
+};
+
+static LuaVFSAsyncLoad*& ToAsyncLoad(lua_State* L)
+{
+	return *static_cast<LuaVFSAsyncLoad**>(luaL_checkudata(L, 1, "LuaVFSLoadFileAsync"));
+}
+
+/***
+ * @class VFSAsyncLoad
+ *
+ * Handle for a file being read by `VFS.LoadFileAsync`.
+ */
+
+/***
+ * Load raw text data from the VFS on a worker thread.
+ *
+ * @function VFS.LoadFileAsync
+ *
+ * Same as `VFS.LoadFile`, except that reading (and uncompressing) the file
+ * happens on a thread-pool thread. The returned handle is polled on later
+ * frames until the contents are available.
+ *
+ * @param filename string
+ *
+ * Path to file, lowercase only. Use linux style path separators, e.g.
+ * `"foo/bar.txt"`.
+ *
+ * @param mode string?
+ *
+ * VFS modes are single char strings and can be concatenated;
+ * doing specifies an order of preference for the mode (i.e. location) from
+ * which to include files.
+ *
+ * @return VFSAsyncLoad handle
+ */
+int LuaVFS::LoadFileAsync(lua_State* L)
+{
+	RECOIL_DETAILED_TRACY_ZONE;
+
+	LuaVFSAsyncLoad* load = new LuaVFSAsyncLoad();
+
+	*static_cast<LuaVFSAsyncLoad**>(lua_newuserdata(L, sizeof(LuaVFSAsyncLoad*))) = load;
+	luaL_getmetatable(L, "LuaVFSLoadFileAsync");
+	lua_setmetatable(L, -2);
+
+	// the handle waits for the job before it is collected
+	load->job = ThreadPool::Enqueue([load, fileName = std::string(luaL_checkstring(L, 1)), vfsModes = GetModes(L, 2, false)]() {
+		load->loadCode = LoadFileWithModes(fileName, load->data, vfsModes);
+	});
+
+	return 1;
+}
+
+int LuaVFS::meta_LoadFileAsync_gc(lua_State* L)
+{
+	spring::SafeDelete(ToAsyncLoad(L));
+	return 0;
+}
+
+/***
+ * @function VFSAsyncLoad:isDone
+ * @return boolean done Whether the file was read, such that `poll` returns its result.
+ */
+int LuaVFS::meta_LoadFileAsync_isDone(lua_State* L)
+{
+	lua_pushboolean(L, ToAsyncLoad(L)->IsDone());
+	return 1;
+}
+
+/***
+ * @function VFSAsyncLoad:poll
+ * @return boolean? done `nil` while the file is being read, otherwise whether it could be loaded.
+ * @return string? data The contents of the file.
+ */
+int LuaVFS::meta_LoadFileAsync_poll(lua_State* L)
+{
+	LuaVFSAsyncLoad* load = ToAsyncLoad(L);
+
+	if (!load->IsDone())
+		return 0;
+
+	// wait() establishes ordering with the job's writes
+	load->Wait();
+
+	if (load->loadCode != 1) {
+		lua_pushboolean(L, false);
+		return 1;
+	}
+
+	LuaUtils::TracyRemoveAlsoExtras(load->data.data());
+	lua_pushboolean(L, true);
+	lua_pushsstring(L, load->data);
+	return 2;
+}
+
+
 /******************************************************************************/
 
 /***
@@ -38,6 +38,11 @@ class LuaVFS {
 		static int UnsyncDirList(lua_State* L);
 		static int UnsyncSubDirs(lua_State* L);
 
+		static int LoadFileAsync(lua_State* L);
+		static int meta_LoadFileAsync_gc(lua_State* L);
+		static int meta_LoadFileAsync_isDone(lua_State* L);
+		static int meta_LoadFileAsync_poll(lua_State* L);
+
 		static int UseArchive(lua_State* L); ///< temporary
 
 		static int CompressFolder(lua_State* L);
@@ -0,0 +1,272 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+
+/**
+ * @class LuaWorker
+ *
+ * @brief A Lua userdatum owning a separate Lua state that runs jobs off the main thread
+ *
+ * The worker state is set up by running the source passed to Spring.CreateLuaWorker,
+ * which must define a global function `Run`. Such a userdatum supports the methods:
+ *  - run(...)  : copies the arguments into the worker and calls Run(...) on a thread-pool
+ *                thread; returns false if the previous job is still running
+ *  - isBusy()  : true while a job is running
+ *  - poll()    : nil while a job is running or if none was started, otherwise true and
+ *                the values returned by Run (or false and the error message)
+ *  - close()   : waits for a running job and destroys the worker state
+ *
+ * Arguments and results are copied like SendToUnsynced data, i.e. only nil, booleans,
+ * numbers, strings and tables thereof.
+ */
+
+#include <future>
+#include <string>
+
+#include "LuaWorker.h"
+#include "LuaContextData.h"
+#include "LuaHashString.h"
+#include "LuaInclude.h"
+#include "LuaMathExtra.h"
+#include "LuaUtils.h"
+#include "System/SafeUtil.h"
+#include "System/Threading/ThreadPool.h"
+
+#include "System/Misc/TracyDefs.h"
+
+
+struct LuaWorkerState {
+public:
+	LuaWorkerState(): D(false, false) {}
+	~LuaWorkerState() {
+		Wait();
+
+		if (L != nullptr)
+			LUA_CLOSE(&L);
+	}
+
+	bool IsBusy() const {
+		return (job.valid() && job.wait_for(std::chrono::seconds(0)) != std::future_status::ready);
+	}
+
+	void Wait() {
+		if (job.valid())
+			job.wait();
+	}
+
+	bool Setup(lua_State* src, const char* code, size_t codeLen, const char* chunkName) {
+		if ((L = LUA_OPEN(&D)) == nullptr)
+			return false;
+
+		LUA_OPEN_LIB(L, luaopen_base);
+		LUA_OPEN_LIB(L, luaopen_math);
+		LUA_OPEN_LIB(L, luaopen_table);
+		LUA_OPEN_LIB(L, luaopen_string);
+
+		lua_pushnil(L); lua_setglobal(L, "dofile");
+		lua_pushnil(L); lua_setglobal(L, "loadfile");
+		lua_pushnil(L); lua_setglobal(L, "loadlib");
+		lua_pushnil(L); lua_setglobal(L, "require");
+
+		lua_getglobal(L, "math");
+		LuaMathExtra::PushEntries(L);
+		lua_pop(L, 1);
+
+		if (luaL_loadbuffer(L, code, codeLen, chunkName) != 0 || lua_pcall(L, 0, 0, 0) != 0) {
+			lua_pushstring(src, lua_tostring(L, -1));
+			return false;
+		}
+
+		lua_getglobal(L, "Run");
+
+		if (!lua_isfunction(L, -1)) {
+			lua_pushstring(src, "worker source does not define a global Run function");
+			return false;
+		}
+
+		lua_settop(L, 0);
+		return true;
+	}
+
+	// called from a thread-pool thread; Run and its arguments are on the stack
+	void RunJob(int numArgs) {
+		if (lua_pcall(L, numArgs, LUA_MULTRET, 0) != 0) {
+			numResults = 1;
+			success = false;
+			return;
+		}
+
+		numResults = lua_gettop(L);
+		success = true;
+	}
+
+public:
+	luaContextData D;
+	lua_State* L = nullptr;
+
+	std::shared_future<void> job;
+
+	int numResults = 0;
+
+	bool success = false;
+	bool haveResults = false;
+};
+
+
+/******************************************************************************/
+/******************************************************************************/
+
+bool LuaWorker::PushEntries(lua_State* L)
+{
+	CreateMetatable(L);
+
+	REGISTER_LUA_CFUNC(CreateLuaWorker);
+	return true;
+}
+
+
+bool LuaWorker::CreateMetatable(lua_State* L)
+{
+	luaL_newmetatable(L, "LuaWorker");
+
+	// metatable.__index = metatable
+	lua_pushvalue(L, -1);
+	lua_setfield(L, -2, "__index");
+
+	HSTR_PUSH_CFUNC(L, "__gc",   meta_gc);
+	HSTR_PUSH_CFUNC(L, "close",  meta_gc);
+	HSTR_PUSH_CFUNC(L, "run",    meta_run);
+	HSTR_PUSH_CFUNC(L, "isBusy", meta_isBusy);
+	HSTR_PUSH_CFUNC(L, "poll",   meta_poll);
+
+	lua_pop(L, 1);
+	return true;
+}
+
+
+static LuaWorkerState*& ToWorker(lua_State* L)
+{
+	return *static_cast<LuaWorkerState**>(luaL_checkudata(L, 1, "LuaWorker"));
+}
+
+static LuaWorkerState* CheckWorker(lua_State* L)
+{
+	LuaWorkerState* w = ToWorker(L);
+
+	if (w == nullptr)
+		luaL_error(L, "LuaWorker is closed");
+
+	return w;
+}
+
+
+/***
+ * Creates a worker Lua state for running jobs on a separate thread
+ *
+ * The worker only has the base, math, table and string libraries and can not
+ * access engine state; a running job must not loop forever since closing the
+ * worker (or reloading the owning handle) waits for it.
+ *
+ * @function Spring.CreateLuaWorker
+ * @param source string code defining a global function `Run`
+ * @param chunkName string? (Default: `"LuaWorker"`)
+ * @return LuaWorker? worker
+ * @return string? error
+ */
+int LuaWorker::CreateLuaWorker(lua_State* L)
+{
+	RECOIL_DETAILED_TRACY_ZONE;
+
+	size_t codeLen = 0;
+	const char* code = luaL_checklstring(L, 1, &codeLen);
+	const char* chunkName = luaL_optstring(L, 2, "LuaWorker");
+
+	LuaWorkerState* w = new LuaWorkerState();
+
+	if (!w->Setup(L, code, codeLen, chunkName)) {
+		spring::SafeDelete(w);
+
+		lua_pushnil(L);
+		lua_insert(L, -2);
+		return 2;
+	}
+
+	*static_cast<LuaWorkerState**>(lua_newuserdata(L, sizeof(LuaWorkerState*))) = w;
+	luaL_getmetatable(L, "LuaWorker");
+	lua_setmetatable(L, -2);
+	return 1;
+}
+
+
+int LuaWorker::meta_gc(lua_State* L)
+{
+	LuaWorkerState*& w = ToWorker(L);
+
+	spring::SafeDelete(w);
+	return 0;
+}
+
+
+int LuaWorker::meta_run(lua_State* L)
+{
+	RECOIL_DETAILED_TRACY_ZONE;
+	LuaWorkerState* w = CheckWorker(L);
+
+	if (w->IsBusy()) {
+		lua_pushboolean(L, false);
+		return 1;
+	}
+
+	// the worker is idle, so its state can be accessed from here
+	const int numArgs = lua_gettop(L) - 1;
+
+	lua_settop(w->L, 0);
+	lua_getglobal(w->L, "Run");
+	LuaUtils::CopyData(w->L, L, numArgs);
+
+	w->haveResults = false;
+	w->job = ThreadPool::Enqueue([w, numArgs]() {
+		w->RunJob(numArgs);
+		w->haveResults = true;
+	});
+
+	lua_pushboolean(L, true);
+	return 1;
+}
+
+
+int LuaWorker::meta_isBusy(lua_State* L)
+{
+	lua_pushboolean(L, CheckWorker(L)->IsBusy());
+	return 1;
+}
+
+
+int LuaWorker::meta_poll(lua_State* L)
+{
+	RECOIL_DETAILED_TRACY_ZONE;
+	LuaWorkerState* w = CheckWorker(L);
+
+	if (w->IsBusy())
+		return 0;
+
+	// wait() establishes ordering with the job's writes
+	w->Wait();
+
+	if (!w->haveResults)
+		return 0;
+
+	lua_settop(L, 1);
+	lua_pushboolean(L, w->success);
+
+	if (w->success) {
+		LuaUtils::CopyData(L, w->L, w->numResults);
+	} else {
+		lua_pushstring(L, lua_tostring(w->L, -1));
+	}
+
+	const int numRets = lua_gettop(L) - 1;
+
+	lua_settop(w->L, 0);
+	w->haveResults = false;
+	return numRets;
+}
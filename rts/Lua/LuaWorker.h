@@ -0,0 +1,29 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#ifndef LUA_WORKER_H
+#define LUA_WORKER_H
+
+struct lua_State;
+
+/**
+ * Bare Lua states (base, math, table and string libraries only) that run
+ * jobs on a thread-pool thread. The owning handle passes in everything the
+ * job needs as arguments and collects the return values once it finished;
+ * workers have no access to engine state.
+ */
+class LuaWorker {
+public:
+	static bool PushEntries(lua_State* L);
+
+private:
+	static bool CreateMetatable(lua_State* L);
+	static int CreateLuaWorker(lua_State* L);
+
+private: // metatable methods
+	static int meta_gc(lua_State* L);
+	static int meta_run(lua_State* L);
+	static int meta_isBusy(lua_State* L);
+	static int meta_poll(lua_State* L);
+};
+
+#endif /* LUA_WORKER_H */
@@ -7,6 +7,7 @@
 #include "Rendering/Env/GrassDrawer.h"
 #include "Sim/Misc/GroundBlockingObjectMap.h"
 #include "Sim/Misc/LosHandler.h"
+#include "Sim/Misc/ModInfo.h"
 #include "Sim/Misc/QuadField.h"
 #include "Sim/Misc/SmoothHeightMesh.h"
 #include "Sim/Units/Unit.h"
@@ -239,9 +240,13 @@ void CBasicMapDamage::RecalcArea(int x1, int x2, int y1, int y2)
 	if (updRect.GetArea() <= 0)
 		return;
 
+	// pending LOS raycasts read the heightmaps we are about to change
+	losHandler->WaitForUpdate();
+
 	readMap->UpdateHeightMapSynced(updRect);
 	featureHandler.TerrainChanged(x1, y1, x2, y2);
 	smoothGround.MapChanged(x1, y1, x2, y2);
+	quadField.MarkQuadsChanged(float3(x1 * SQUARE_SIZE, 0.0f, y1 * SQUARE_SIZE), float3(x2 * SQUARE_SIZE, 0.0f, y2 * SQUARE_SIZE));
 	{
 		SCOPED_TIMER("Sim::BasicMapDamage::Los");
 		losHandler->UpdateHeightMapSynced(updRect);
@@ -253,10 +258,38 @@ void CBasicMapDamage::RecalcArea(int x1, int x2, int y1, int y2)
 }
 
 
+// unions touching or overlapping rectangles until all remaining ones are apart
+static void MergeRecalcAreas(std::vector<SRectangle>& areas)
+{
+	for (size_t i = 0; i < areas.size(); ) {
+		bool merged = false;
+
+		for (size_t j = i + 1; j < areas.size(); ++j) {
+			const SRectangle& a = areas[i];
+			const SRectangle& b = areas[j];
+
+			if (a.x1 > b.x2 || b.x1 > a.x2 || a.z1 > b.z2 || b.z1 > a.z2)
+				continue;
+
+			areas[i] = {std::min(a.x1, b.x1), std::min(a.z1, b.z1), std::max(a.x2, b.x2), std::max(a.z2, b.z2)};
+			areas[j] = areas.back();
+			areas.pop_back();
+
+			merged = true;
+			break;
+		}
+
+		// a grown rectangle can now touch one that was already passed
+		i = merged? 0: (i + 1);
+	}
+}
+
 void CBasicMapDamage::Update()
 {
 	SCOPED_TIMER("Sim::BasicMapDamage");
 
+	const bool batchRecalc = modInfo.mapDamageBatchRecalc;
+
 	for (unsigned int i = explUpdateQueueIdx, n = explosionUpdateQueue.size(); i < n; i++) {
 		Explo& e = explosionUpdateQueue[i];
 
@@ -292,9 +325,24 @@ void CBasicMapDamage::Update()
 		if (e.ttl != 0)
 			continue;
 
+		if (batchRecalc) {
+			recalcAreas.emplace_back(e.x1 - 1, e.y1 - 1, e.x2 + 1, e.y2 + 1);
+			continue;
+		}
+
 		RecalcArea(e.x1 - 1, e.x2 + 1, e.y1 - 1, e.y2 + 1);
 	}
 
+	if (!recalcAreas.empty()) {
+		MergeRecalcAreas(recalcAreas);
+
+		for (const SRectangle& r: recalcAreas) {
+			RecalcArea(r.x1, r.x2, r.z1, r.z2);
+		}
+
+		recalcAreas.clear();
+	}
+
 
 	// pop explosions that are no longer being processed
 	while (explUpdateQueueIdx < explosionUpdateQueue.size()) {
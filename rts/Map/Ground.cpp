@@ -7,6 +7,9 @@
 #include "Sim/Misc/GlobalSynced.h"
 #include "System/SpringMath.h"
 
+#include "xsimd/xsimd.hpp"
+
+#include <array>
 #include <cassert>
 #include <limits>
 
@@ -149,6 +152,112 @@ static inline float LineGroundSquareCol(
 
 
 
+/**
+ * Decides which squares along a ray LineGroundSquareCol can be skipped for,
+ * using the max-height pyramid: if the line through from and to stays above
+ * the highest corner everywhere over a block of squares, none of them can be
+ * hit. The traversal itself is left alone, so the result is identical to
+ * testing every square; only the tests (and their cache misses) are saved.
+ */
+class CGroundRaySkipper
+{
+public:
+	CGroundRaySkipper(const float3& rayFrom, const float3& rayTo, bool isSynced)
+		: from(rayFrom)
+		, dir(rayTo - rayFrom)
+		, synced(isSynced)
+	{
+		invDir.x = (dir.x != 0.0f)? (1.0f / dir.x): 0.0f;
+		invDir.z = (dir.z != 0.0f)? (1.0f / dir.z): 0.0f;
+
+		failedCells.fill({-1, -1});
+	}
+
+	bool CanSkipSquare(int x, int z) {
+		if (x < 0 || z < 0 || x > mapDims.mapxm1 || z > mapDims.mapym1)
+			return false;
+
+		if (skipLevel > 0 && (x >> skipLevel) == skipCell.x && (z >> skipLevel) == skipCell.y)
+			return true;
+
+		skipLevel = 0;
+
+		// coarsest block first; blocks that could not be skipped before are not retested
+		for (int level = CReadMap::numHeightMipMaps - 1; level > 0; level--) {
+			const int2 cell = {x >> level, z >> level};
+
+			if (cell == failedCells[level])
+				continue;
+
+			if (!CanSkipCell(level, cell)) {
+				failedCells[level] = cell;
+				continue;
+			}
+
+			skipLevel = level;
+			skipCell = cell;
+			return true;
+		}
+
+		return false;
+	}
+
+private:
+	bool CanSkipCell(int level, const int2 cell) const {
+		// margins absorb the rounding of the intersection points LineGroundSquareCol computes
+		constexpr float POS_MARGIN = 1.0f;
+		constexpr float HGT_MARGIN = 1.0f;
+
+		const float* maxHeightMap = readMap->GetSharedMaxMIPHeightMap(level, synced);
+		const float maxHeight = maxHeightMap[cell.y * CReadMap::GetMaxMIPHeightMapSizeX(level) + cell.x];
+
+		const float cellSize = (1 << level) * SQUARE_SIZE;
+		const float2 mins = {cell.x * cellSize - POS_MARGIN, cell.y * cellSize - POS_MARGIN};
+		const float2 maxs = {mins.x + cellSize + POS_MARGIN * 2.0f, mins.y + cellSize + POS_MARGIN * 2.0f};
+
+		// not clamped to [0, 1], LineGroundSquareCol can report hits beyond the segment
+		float tmin = std::numeric_limits<float>::lowest();
+		float tmax = std::numeric_limits<float>::max();
+
+		if (dir.x != 0.0f) {
+			const float t0 = (mins.x - from.x) * invDir.x;
+			const float t1 = (maxs.x - from.x) * invDir.x;
+
+			tmin = std::max(tmin, std::min(t0, t1));
+			tmax = std::min(tmax, std::max(t0, t1));
+		}
+		if (dir.z != 0.0f) {
+			const float t0 = (mins.y - from.z) * invDir.z;
+			const float t1 = (maxs.y - from.z) * invDir.z;
+
+			tmin = std::max(tmin, std::min(t0, t1));
+			tmax = std::min(tmax, std::max(t0, t1));
+		}
+
+		// vertical ray or (rounding) miss, leave it to the exact test
+		if (dir.x == 0.0f && dir.z == 0.0f)
+			return false;
+		if (tmin > tmax)
+			return false;
+
+		const float minRayHeight = from.y + dir.y * ((dir.y > 0.0f)? tmin: tmax);
+
+		return (minRayHeight > (maxHeight + HGT_MARGIN));
+	}
+
+private:
+	float3 from;
+	float3 dir;
+	float3 invDir;
+
+	std::array<int2, CReadMap::numHeightMipMaps> failedCells;
+	int2 skipCell;
+
+	int skipLevel = 0;
+	bool synced = true;
+};
+
+
 /*
 void CGround::CheckColSquare(CProjectile* p, int x, int y)
 {
@@ -276,15 +385,19 @@ float CGround::LineGroundCol(float3 from, float3 to, bool synced)
 		return -1.0f;
 	}
 
+	CGroundRaySkipper raySkipper(from, to, synced);
+
 	if (fsx == tsx) {
 		// ray is parallel to z-axis
 		int zp = fsz;
 
 		for (unsigned int i = 0, n = Square(mapDims.mapyp1); (Square(i) <= n && zp != tsz); i++) {
-			const float ret = LineGroundSquareCol(hm, nm,  from, to,  fsx, zp);
+			if (!raySkipper.CanSkipSquare(fsx, zp)) {
+				const float ret = LineGroundSquareCol(hm, nm,  from, to,  fsx, zp);
 
-			if (ret >= 0.0f)
-				return (ret + skippedDist);
+				if (ret >= 0.0f)
+					return (ret + skippedDist);
+			}
 
 			zp += dirz;
 		}
@@ -297,10 +410,12 @@ float CGround::LineGroundCol(float3 from, float3 to, bool synced)
 		int xp = fsx;
 
 		for (unsigned int i = 0, n = Square(mapDims.mapxp1); (Square(i) <= n && xp != tsx); i++) {
-			const float ret = LineGroundSquareCol(hm, nm,  from, to,  xp, fsz);
+			if (!raySkipper.CanSkipSquare(xp, fsz)) {
+				const float ret = LineGroundSquareCol(hm, nm,  from, to,  xp, fsz);
 
-			if (ret >= 0.0f)
-				return (ret + skippedDist);
+				if (ret >= 0.0f)
+					return (ret + skippedDist);
+			}
 
 			xp += dirx;
 		}
@@ -334,11 +449,13 @@ float CGround::LineGroundCol(float3 from, float3 to, bool synced)
 		int curz = fsz;
 
 		for (unsigned int i = 0, n = Square(mapDims.mapxp1) + Square(mapDims.mapyp1); !stopTrace; i++) {
-			// test for collision with the ground-square triangles
-			const float ret = LineGroundSquareCol(hm, nm,  from, to,  curx, curz);
+			// test for collision with the ground-square triangles, unless the whole block is below the ray
+			if (!raySkipper.CanSkipSquare(curx, curz)) {
+				const float ret = LineGroundSquareCol(hm, nm,  from, to,  curx, curz);
 
-			if (ret >= 0.0f)
-				return (ret + skippedDist);
+				if (ret >= 0.0f)
+					return (ret + skippedDist);
+			}
 
 			// check if we reached the end already and need to stop the loop
 			const bool endReached = ((curx == tsx && curz == tsz) || (Square(i) > n));
@@ -470,6 +587,68 @@ float CGround::GetHeightReal(float x, float z, bool synced)
 	return InterpolateCornerHeight(x, z, readMap->GetSharedCornerHeightMap(synced));
 }
 
+void CGround::GetHeightReal(const float* xs, const float* zs, float* heights, size_t count, bool synced)
+{
+	RECOIL_DETAILED_TRACY_ZONE;
+	using FloatBatch = xsimd::simd_type<float>;
+
+	constexpr size_t N = FloatBatch::size;
+
+	const float* cornerHeightMap = readMap->GetSharedCornerHeightMap(synced);
+
+	alignas(FloatBatch) float fxs[N];
+	alignas(FloatBatch) float fzs[N];
+	alignas(FloatBatch) float dxs[N];
+	alignas(FloatBatch) float dzs[N];
+	alignas(FloatBatch) float h00s[N];
+	alignas(FloatBatch) float h10s[N];
+	alignas(FloatBatch) float h01s[N];
+	alignas(FloatBatch) float h11s[N];
+
+	size_t i = 0;
+
+	// performs the same operations in the same order as InterpolateCornerHeight,
+	// so results are identical to calling GetHeightReal once per position
+	for (; (i + N) <= count; i += N) {
+		const FloatBatch fx = xsimd::min(xsimd::max(xsimd::load_unaligned(xs + i), FloatBatch(0.0f)), FloatBatch(float3::maxxpos)) / FloatBatch(float(SQUARE_SIZE));
+		const FloatBatch fz = xsimd::min(xsimd::max(xsimd::load_unaligned(zs + i), FloatBatch(0.0f)), FloatBatch(float3::maxzpos)) / FloatBatch(float(SQUARE_SIZE));
+
+		xsimd::store_aligned(&fxs[0], fx);
+		xsimd::store_aligned(&fzs[0], fz);
+
+		// no gather in this xsimd version, fetch the corners per lane
+		for (size_t j = 0; j < N; j++) {
+			const int ix = fxs[j];
+			const int iz = fzs[j];
+			const int hs = ix + iz * mapDims.mapxp1;
+
+			dxs[j] = fxs[j] - ix;
+			dzs[j] = fzs[j] - iz;
+
+			h00s[j] = cornerHeightMap[hs + 0                 ];
+			h10s[j] = cornerHeightMap[hs + 1                 ];
+			h01s[j] = cornerHeightMap[hs + 0 + mapDims.mapxp1];
+			h11s[j] = cornerHeightMap[hs + 1 + mapDims.mapxp1];
+		}
+
+		const FloatBatch dx = xsimd::load_aligned(&dxs[0]);
+		const FloatBatch dz = xsimd::load_aligned(&dzs[0]);
+		const FloatBatch h00 = xsimd::load_aligned(&h00s[0]);
+		const FloatBatch h10 = xsimd::load_aligned(&h10s[0]);
+		const FloatBatch h01 = xsimd::load_aligned(&h01s[0]);
+		const FloatBatch h11 = xsimd::load_aligned(&h11s[0]);
+
+		const FloatBatch hTL = h00 + dx * (h10 - h00) + dz * (h01 - h00);
+		const FloatBatch hBR = h11 + (FloatBatch(1.0f) - dx) * (h01 - h11) + (FloatBatch(1.0f) - dz) * (h10 - h11);
+
+		xsimd::store_unaligned(heights + i, xsimd::select((dx + dz) < FloatBatch(1.0f), hTL, hBR));
+	}
+
+	for (; i < count; i++) {
+		heights[i] = InterpolateCornerHeight(xs[i], zs[i], cornerHeightMap);
+	}
+}
+
 float CGround::GetOrigHeight(float x, float z)
 {
 	RECOIL_DETAILED_TRACY_ZONE;
@@ -3,6 +3,8 @@
 #ifndef GROUND_H
 #define GROUND_H
 
+#include <cstddef>
+
 #include "System/float3.h"
 #include "System/type2.h"
 
@@ -19,6 +21,8 @@ public:
 	/// Returns the real height at the specified position, can be below 0
 	static float GetHeightReal(float x, float z, bool synced = true);
 	static float GetOrigHeight(float x, float z);
+	/// GetHeightReal for count positions at once, given as separate x and z arrays
+	static void GetHeightReal(const float* xs, const float* zs, float* heights, size_t count, bool synced = true);
 
 	static consteval float GetWaterPlaneLevel() {
 		/* Water plane height is hardcoded currently.
@@ -1,8 +1,12 @@
 /* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
 
 
+#include <array>
+#include <cstdint>
+#include <cstdio>
 #include <cstdlib>
 #include <cstring> // memcpy
+#include <stdexcept>
 
 #include "xsimd/xsimd.hpp"
 #include "ReadMap.h"
@@ -11,16 +15,21 @@
 #include "MetalMap.h"
 #include "Rendering/Env/MapRendering.h"
 #include "SMF/SMFReadMap.h"
+#include "Game/GameVersion.h"
 #include "Game/LoadScreen.h"
 #include "System/EventHandler.h"
+#include "System/Config/ConfigHandler.h"
 #include "System/Exceptions.h"
 #include "System/SpringMath.h"
 #include "System/Threading/ThreadPool.h"
 #include "System/FileSystem/ArchiveScanner.h"
+#include "System/FileSystem/DataDirsAccess.h"
 #include "System/FileSystem/FileHandler.h"
+#include "System/FileSystem/FileQueryFlags.h"
 #include "System/FileSystem/FileSystem.h"
 #include "System/Log/ILog.h"
 #include "System/SpringHash.h"
+#include "System/StringUtil.h"
 #include "System/SafeUtil.h"
 #include "System/TimeProfiler.h"
 #include "System/XSimdOps.hpp"
@@ -30,6 +39,9 @@
 #include "System/Misc/TracyDefs.h"
 
 static constexpr size_t MAX_UHM_RECTS_PER_FRAME = 128;
+static constexpr uint32_t DERIVED_MAPS_CACHE_VERSION = 1;
+
+CONFIG(bool, MapDerivedDataCache).defaultValue(false).description("Cache the heightmap-derived data (mip heightmaps, normals, slope map) of each map on disk and reuse it when the same map is loaded again.");
 
 //////////////////////////////////////////////////////////////////////
 // Construction/Destruction
@@ -59,6 +71,7 @@ CR_BIND_INTERFACE(CReadMap)
 CR_REG_METADATA(CReadMap, (
 	CR_IGNORED(hmUpdated),
 	CR_IGNORED(processingHeightBounds),
+	CR_IGNORED(unsyncedMapsShared),
 	CR_IGNORED(initHeightBounds),
 	CR_IGNORED(tempHeightBounds),
 	CR_IGNORED(currHeightBounds),
@@ -94,6 +107,7 @@ CR_REG_METADATA(CReadMap, (
 	CR_IGNORED(sharedSlopeMaps),
 
 	CR_IGNORED(unsyncedHeightMapUpdates),
+	CR_IGNORED(unsyncedHeightMapUpdateCount),
 
 	/*
 	CR_IGNORED(  syncedHeightMapDigests),
@@ -116,6 +130,7 @@ std::vector<float> CReadMap::originalHeightMap;
 std::vector<float> CReadMap::centerHeightMap;
 std::vector<float> CReadMap::maxHeightMap;
 std::array<std::vector<float>, CReadMap::numHeightMipMaps - 1> CReadMap::mipCenterHeightMaps;
+std::array<std::vector<float>, CReadMap::numHeightMipMaps - 1> CReadMap::maxMipHeightMaps[2];
 
 std::vector<float3> CReadMap::faceNormalsSynced;
 std::vector<float3> CReadMap::faceNormalsUnsynced;
@@ -286,8 +301,15 @@ void CReadMap::PostLoad()
 		mipCenterHeightMaps[i - 1].resize((mapDims.mapx >> i) * (mapDims.mapy >> i));
 
 		mipPointerHeightMaps[i] = &mipCenterHeightMaps[i - 1][0];
+
+		for (auto& maxMipHeightMapsSet: maxMipHeightMaps) {
+			maxMipHeightMapsSet[i - 1].clear();
+			maxMipHeightMapsSet[i - 1].resize(GetMaxMIPHeightMapSizeX(i) * GetMaxMIPHeightMapSizeY(i));
+		}
 	}
 
+	UpdateMaxMipHeightmaps({0, 0, mapDims.mapxm1, mapDims.mapym1}, false);
+
 	hmUpdated = true;
 
 	mapDamage->RecalcArea(0, mapDims.mapx, 0, mapDims.mapy);
@@ -329,9 +351,10 @@ void CReadMap::Initialize()
 			((  mapDims.hmapx     * mapDims.hmapy           * sizeof(float))         / 1024) +   // MetalMap::extractionMap
 			((  mapDims.hmapx     * mapDims.hmapy           * sizeof(unsigned char)) / 1024);    // MetalMap::metalMap
 
-		// mipCenterHeightMaps[i]
+		// mipCenterHeightMaps[i], maxMipHeightMaps[{0,1}][i]
 		for (int i = 1; i < numHeightMipMaps; i++) {
 			reqMemFootPrintKB += ((((mapDims.mapx >> i) * (mapDims.mapy >> i)) * sizeof(float)) / 1024);
+			reqMemFootPrintKB += ((GetMaxMIPHeightMapSizeX(i) * GetMaxMIPHeightMapSizeY(i) * 2 * sizeof(float)) / 1024);
 		}
 
 		sprintf(loadMsg, fmtString, reqMemFootPrintKB / 1024);
@@ -367,6 +390,11 @@ void CReadMap::Initialize()
 		mipCenterHeightMaps[i - 1].resize((mapDims.mapx >> i) * (mapDims.mapy >> i));
 
 		mipPointerHeightMaps[i] = &mipCenterHeightMaps[i - 1][0];
+
+		for (auto& maxMipHeightMapsSet: maxMipHeightMaps) {
+			maxMipHeightMapsSet[i - 1].clear();
+			maxMipHeightMapsSet[i - 1].resize(GetMaxMIPHeightMapSizeX(i) * GetMaxMIPHeightMapSizeY(i));
+		}
 	}
 
 	slopeMap.clear();
@@ -404,7 +432,13 @@ void CReadMap::Initialize()
 
 	// not callable here because losHandler is still uninitialized, deferred to Game::PostLoadSim
 	// InitHeightMapDigestVectors();
-	UpdateHeightMapSynced({0, 0, mapDims.mapx, mapDims.mapy});
+	if (!LoadDerivedMapsCache()) {
+		UpdateHeightMapSynced({0, 0, mapDims.mapx, mapDims.mapy});
+		SaveDerivedMapsCache();
+	}
+
+	// the unsynced heightmap starts out as a copy of the synced one, UpdateDraw keeps it current
+	UpdateMaxMipHeightmaps({0, 0, mapDims.mapxm1, mapDims.mapym1}, false);
 
 	unsyncedHeightInfo.resize(
 		(mapDims.mapx / PATCH_SIZE) * (mapDims.mapy / PATCH_SIZE),
@@ -460,6 +494,153 @@ void CReadMap::LoadOriginalHeightMapAndChecksum()
 
 
 
+template<typename T>
+static void WriteCacheItems(const T* items, size_t count, FILE* file) {
+	if (fwrite(items, sizeof(T), count, file) != count)
+		throw std::runtime_error("failed to write to file");
+}
+
+template<typename T>
+static void ReadCacheItems(T* items, size_t count, FILE* file) {
+	if (fread(items, sizeof(T), count, file) != count)
+		throw std::runtime_error("failed to read the required number of items");
+}
+
+std::string CReadMap::GetDerivedMapsCacheFileName() const
+{
+	const char sep = FileSystemAbstraction::GetNativePathSeparator();
+	const std::string dir = dataDirsAccess.LocateDir(FileSystem::GetCacheDir() + sep + "derivedMaps" + sep, FileQueryFlags::WRITE | FileQueryFlags::CREATE_DIRS);
+
+	return (dir + IntToString(mapChecksum, "%08x") + ".bin");
+}
+
+/**
+ * The cache header records everything the derived data depends on besides
+ * the heightmap itself (which mapChecksum covers), so a file written by a
+ * different engine build or for a different map is never picked up.
+ */
+void CReadMap::WriteDerivedMapsCacheHeader(FILE* file) const
+{
+	const std::string& engineVersion = SpringVersion::GetSync();
+	const uint32_t header[] = {DERIVED_MAPS_CACHE_VERSION, mapChecksum, uint32_t(mapDims.mapx), uint32_t(mapDims.mapy), uint32_t(numHeightMipMaps), uint32_t(engineVersion.size())};
+
+	WriteCacheItems(&header[0], std::size(header), file);
+	WriteCacheItems(engineVersion.data(), engineVersion.size(), file);
+}
+
+bool CReadMap::CheckDerivedMapsCacheHeader(FILE* file) const
+{
+	uint32_t header[6];
+	ReadCacheItems(&header[0], std::size(header), file);
+
+	const std::string& engineVersion = SpringVersion::GetSync();
+
+	if (header[0] != DERIVED_MAPS_CACHE_VERSION || header[1] != mapChecksum)
+		return false;
+	if (header[2] != uint32_t(mapDims.mapx) || header[3] != uint32_t(mapDims.mapy) || header[4] != uint32_t(numHeightMipMaps))
+		return false;
+	if (header[5] != engineVersion.size())
+		return false;
+
+	std::string fileVersion(header[5], '\0');
+	ReadCacheItems(fileVersion.data(), fileVersion.size(), file);
+
+	return (fileVersion == engineVersion);
+}
+
+bool CReadMap::LoadDerivedMapsCache()
+{
+	RECOIL_DETAILED_TRACY_ZONE;
+	if (!configHandler->GetBool("MapDerivedDataCache"))
+		return false;
+
+	const std::string cacheFileName = GetDerivedMapsCacheFileName();
+	FILE* cacheFile = fopen(cacheFileName.c_str(), "rb");
+
+	if (cacheFile == nullptr)
+		return false;
+
+	bool loaded = false;
+
+	try {
+		if (CheckDerivedMapsCacheHeader(cacheFile)) {
+			ReadCacheItems(centerHeightMap.data(), centerHeightMap.size(), cacheFile);
+			ReadCacheItems(maxHeightMap.data(), maxHeightMap.size(), cacheFile);
+
+			for (int i = 1; i < numHeightMipMaps; i++) {
+				ReadCacheItems(mipCenterHeightMaps[i - 1].data(), mipCenterHeightMaps[i - 1].size(), cacheFile);
+			}
+
+			ReadCacheItems(faceNormalsSynced.data(), faceNormalsSynced.size(), cacheFile);
+			ReadCacheItems(centerNormalsSynced.data(), centerNormalsSynced.size(), cacheFile);
+			ReadCacheItems(centerNormals2D.data(), centerNormals2D.size(), cacheFile);
+			ReadCacheItems(slopeMap.data(), slopeMap.size(), cacheFile);
+
+			// trailing data means the file does not belong to this layout
+			loaded = (fgetc(cacheFile) == EOF);
+		}
+	} catch (const std::runtime_error& err) {
+		LOG_L(L_WARNING, "[%s] failed to load the derived map data from %s: %s", __func__, cacheFileName.c_str(), err.what());
+	}
+
+	fclose(cacheFile);
+
+	if (!loaded)
+		return false;
+
+	// same as the initializing UpdateHeightMapSynced call
+	faceNormalsUnsynced = faceNormalsSynced;
+	centerNormalsUnsynced = centerNormalsSynced;
+
+	// not part of the cache, cheap enough to derive
+	UpdateMaxMipHeightmaps({0, 0, mapDims.mapxm1, mapDims.mapym1}, true);
+
+	unsyncedHeightMapUpdates.push_back({0, 0, mapDims.mapx, mapDims.mapy});
+	return true;
+}
+
+void CReadMap::SaveDerivedMapsCache() const
+{
+	RECOIL_DETAILED_TRACY_ZONE;
+	if (!configHandler->GetBool("MapDerivedDataCache"))
+		return;
+
+	const std::string cacheFileName = GetDerivedMapsCacheFileName();
+	FILE* cacheFile = fopen(cacheFileName.c_str(), "wb");
+
+	if (cacheFile == nullptr) {
+		LOG_L(L_WARNING, "[%s] failed to open %s for writing", __func__, cacheFileName.c_str());
+		return;
+	}
+
+	bool saved = true;
+
+	try {
+		WriteDerivedMapsCacheHeader(cacheFile);
+		WriteCacheItems(centerHeightMap.data(), centerHeightMap.size(), cacheFile);
+		WriteCacheItems(maxHeightMap.data(), maxHeightMap.size(), cacheFile);
+
+		for (int i = 1; i < numHeightMipMaps; i++) {
+			WriteCacheItems(mipCenterHeightMaps[i - 1].data(), mipCenterHeightMaps[i - 1].size(), cacheFile);
+		}
+
+		WriteCacheItems(faceNormalsSynced.data(), faceNormalsSynced.size(), cacheFile);
+		WriteCacheItems(centerNormalsSynced.data(), centerNormalsSynced.size(), cacheFile);
+		WriteCacheItems(centerNormals2D.data(), centerNormals2D.size(), cacheFile);
+		WriteCacheItems(slopeMap.data(), slopeMap.size(), cacheFile);
+	} catch (const std::runtime_error& err) {
+		LOG_L(L_WARNING, "[%s] failed to save the derived map data to %s: %s", __func__, cacheFileName.c_str(), err.what());
+		saved = false;
+	}
+
+	fclose(cacheFile);
+
+	// never leave a truncated file behind
+	if (!saved)
+		std::remove(cacheFileName.c_str());
+}
+
+
 uint32_t CReadMap::CalcHeightmapChecksum()
 {
 	RECOIL_DETAILED_TRACY_ZONE;
@@ -493,6 +674,10 @@ void CReadMap::UpdateDraw(bool firstCall)
 {
 	SCOPED_TIMER("Update::ReadMap::UHM");
 
+	// full-view spectators get every synced change pushed, their unsynced
+	// copies would only duplicate the synced data
+	ShareUnsyncedMaps(gu->spectatingFullView);
+
 	if (unsyncedHeightMapUpdates.empty())
 		return;
 
@@ -502,10 +687,16 @@ void CReadMap::UpdateDraw(bool firstCall)
 	const int N = static_cast<int>(std::min(MAX_UHM_RECTS_PER_FRAME, unsyncedHeightMapUpdates.size()));
 
 	for (int i = 0; i < N; i++) {
-		UpdateHeightMapUnsynced(*(unsyncedHeightMapUpdates.begin() + i));
+		const SRectangle& rect = *(unsyncedHeightMapUpdates.begin() + i);
+
+		UpdateHeightMapUnsynced(rect);
+		// corner-space rectangle, squares end one before the last corner
+		UpdateMaxMipHeightmaps({rect.x1, rect.z1, std::min(rect.x2, mapDims.mapxm1), std::min(rect.z2, mapDims.mapym1)}, false);
 	};
 	UpdateHeightMapUnsyncedPost();
 
+	unsyncedHeightMapUpdateCount += 1;
+
 	for (int i = 0; i < N; i++) {
 		eventHandler.UnsyncedHeightMapUpdate(*(unsyncedHeightMapUpdates.begin() + i));
 	}
@@ -666,12 +857,94 @@ void CReadMap::UpdateMipHeightmaps(const SRectangle& rect, bool initialize)
 			}
 		}
 	}
+
+	UpdateMaxMipHeightmaps(rect, true);
 }
 
 
+int CReadMap::GetMaxMIPHeightMapSizeX(uint32_t mip) { return (((mapDims.mapx - 1) >> mip) + 1); }
+int CReadMap::GetMaxMIPHeightMapSizeY(uint32_t mip) { return (((mapDims.mapy - 1) >> mip) + 1); }
+
+void CReadMap::UpdateMaxMipHeightmaps(const SRectangle& rect, bool synced)
+{
+	RECOIL_DETAILED_TRACY_ZONE;
+	const float* heightmap = sharedCornerHeightMaps[synced];
+
+	auto& maxMipMaps = maxMipHeightMaps[synced];
+
+	// first level straight from the corners, 3x3 of them per 2x2 squares
+	{
+		const int mipx = GetMaxMIPHeightMapSizeX(1);
+
+		for (int y = (rect.z1 >> 1); y <= (rect.z2 >> 1); y++) {
+			for (int x = (rect.x1 >> 1); x <= (rect.x2 >> 1); x++) {
+				float maxHeight = std::numeric_limits<float>::lowest();
+
+				for (int cy = y * 2, ey = std::min(y * 2 + 2, mapDims.mapy); cy <= ey; cy++) {
+					for (int cx = x * 2, ex = std::min(x * 2 + 2, mapDims.mapx); cx <= ex; cx++) {
+						maxHeight = std::max(maxHeight, heightmap[cy * mapDims.mapxp1 + cx]);
+					}
+				}
+
+				maxMipMaps[0][y * mipx + x] = maxHeight;
+			}
+		}
+	}
+
+	for (int i = 2; i < numHeightMipMaps; i++) {
+		const float* topMipMap = maxMipMaps[i - 2].data();
+		      float* subMipMap = maxMipMaps[i - 1].data();
+
+		const int topx = GetMaxMIPHeightMapSizeX(i - 1);
+		const int topy = GetMaxMIPHeightMapSizeY(i - 1);
+		const int subx = GetMaxMIPHeightMapSizeX(i);
+
+		for (int y = (rect.z1 >> i); y <= (rect.z2 >> i); y++) {
+			for (int x = (rect.x1 >> i); x <= (rect.x2 >> i); x++) {
+				const int tx = std::min(x * 2 + 1, topx - 1);
+				const int ty = std::min(y * 2 + 1, topy - 1);
+
+				subMipMap[y * subx + x] = std::max(
+					std::max(topMipMap[(y * 2) * topx + (x * 2)], topMipMap[(y * 2) * topx + tx]),
+					std::max(topMipMap[(ty   ) * topx + (x * 2)], topMipMap[(ty   ) * topx + tx])
+				);
+			}
+		}
+	}
+}
+
+
+/**
+ * @brief Batched float3::SafeNormalize
+ * The inverse square root mirrors fastmath::isqrt2_nosse op for op and no
+ * operations are fused, so the result matches the scalar normals bit for bit.
+ */
+template<typename FloatBatch>
+static void SafeNormalizeSIMD(FloatBatch& x, FloatBatch& y, FloatBatch& z)
+{
+	using IntBatch = xsimd::simd_type<std::int32_t>;
+	static_assert(IntBatch::size == FloatBatch::size);
+
+	const FloatBatch sql = x * x + y * y + z * z;
+	const FloatBatch xh = FloatBatch(0.5f) * sql;
+	const IntBatch i = IntBatch(0x5f375a86) - (xsimd::bitwise_cast<IntBatch>(sql) >> 1);
+
+	FloatBatch r = xsimd::bitwise_cast<FloatBatch>(i);
+	r = r * (FloatBatch(1.5f) - xh * (r * r));
+	r = r * (FloatBatch(1.5f) - xh * (r * r));
+
+	const auto valid = (sql > FloatBatch(float3::nrm_eps()));
+
+	x = xsimd::select(valid, x * r, x);
+	y = xsimd::select(valid, y * r, y);
+	z = xsimd::select(valid, z * r, z);
+}
+
 void CReadMap::UpdateFaceNormals(const SRectangle& rect, bool initialize)
 {
 	RECOIL_DETAILED_TRACY_ZONE;
+	using FloatBatch = xsimd::simd_type<float>;
+
 	const float* heightmapSynced = GetCornerHeightMapSynced();
 
 	const int z1 = std::max(             0, rect.z1 - 1);
@@ -683,7 +956,69 @@ void CReadMap::UpdateFaceNormals(const SRectangle& rect, bool initialize)
 		float3 fnTL;
 		float3 fnBR;
 
-		for (int x = x1; x <= x2; x++) {
+		int x = x1;
+
+		// vectorized part of the row, same math as the scalar loop below
+		for (; (x + int(FloatBatch::size)) <= (x2 + 1); x += FloatBatch::size) {
+			const int idxTL = (y    ) * mapDims.mapxp1 + x;
+			const int idxBL = (y + 1) * mapDims.mapxp1 + x;
+
+			const FloatBatch hTL = xsimd::load_unaligned(&heightmapSynced[idxTL    ]);
+			const FloatBatch hTR = xsimd::load_unaligned(&heightmapSynced[idxTL + 1]);
+			const FloatBatch hBL = xsimd::load_unaligned(&heightmapSynced[idxBL    ]);
+			const FloatBatch hBR = xsimd::load_unaligned(&heightmapSynced[idxBL + 1]);
+
+			FloatBatch tlX = -(hTR - hTL);
+			FloatBatch tlY = FloatBatch(SQUARE_SIZE);
+			FloatBatch tlZ = -(hBL - hTL);
+			FloatBatch brX = (hBL - hBR);
+			FloatBatch brY = FloatBatch(SQUARE_SIZE);
+			FloatBatch brZ = (hTR - hBR);
+
+			SafeNormalizeSIMD(tlX, tlY, tlZ);
+			SafeNormalizeSIMD(brX, brY, brZ);
+
+			FloatBatch cnX = tlX + brX;
+			FloatBatch cnY = tlY + brY;
+			FloatBatch cnZ = tlZ + brZ;
+			FloatBatch c2X = cnX;
+			FloatBatch c2Y = FloatBatch(0.0f);
+			FloatBatch c2Z = cnZ;
+
+			SafeNormalizeSIMD(cnX, cnY, cnZ);
+			SafeNormalizeSIMD(c2X, c2Y, c2Z);
+
+			alignas(64) std::array<float, FloatBatch::size * 12> lanes;
+
+			const std::array<const FloatBatch*, 12> comps = {
+				&tlX, &tlY, &tlZ,
+				&brX, &brY, &brZ,
+				&cnX, &cnY, &cnZ,
+				&c2X, &c2Y, &c2Z,
+			};
+
+			for (size_t c = 0; c < comps.size(); c++) {
+				comps[c]->store_aligned(&lanes[c * FloatBatch::size]);
+			}
+
+			for (size_t j = 0; j < FloatBatch::size; j++) {
+				const auto Lane = [&](size_t c) { return float3(lanes[(c + 0) * FloatBatch::size + j], lanes[(c + 1) * FloatBatch::size + j], lanes[(c + 2) * FloatBatch::size + j]); };
+				const int idx = y * mapDims.mapx + x + j;
+
+				faceNormalsSynced[idx * 2    ] = Lane(0);
+				faceNormalsSynced[idx * 2 + 1] = Lane(3);
+				centerNormalsSynced[idx] = Lane(6);
+				centerNormals2D[idx] = Lane(9);
+
+				if (initialize) {
+					faceNormalsUnsynced[idx * 2    ] = faceNormalsSynced[idx * 2    ];
+					faceNormalsUnsynced[idx * 2 + 1] = faceNormalsSynced[idx * 2 + 1];
+					centerNormalsUnsynced[idx] = centerNormalsSynced[idx];
+				}
+			}
+		}
+
+		for (; x <= x2; x++) {
 			const int idxTL = (y    ) * mapDims.mapxp1 + x; // TL
 			const int idxBL = (y + 1) * mapDims.mapxp1 + x; // BL
 
@@ -911,11 +1246,45 @@ namespace {
 void CReadMap::CopySyncedToUnsynced()
 {
 	RECOIL_DETAILED_TRACY_ZONE;
-	CopySyncedToUnsyncedImpl(*heightMapSyncedPtr, *heightMapUnsyncedPtr);
-	CopySyncedToUnsyncedImpl(faceNormalsSynced, faceNormalsUnsynced);
-	CopySyncedToUnsyncedImpl(centerNormalsSynced, centerNormalsUnsynced);
+	if (!unsyncedMapsShared) {
+		CopySyncedToUnsyncedImpl(*heightMapSyncedPtr, *heightMapUnsyncedPtr);
+		CopySyncedToUnsyncedImpl(faceNormalsSynced, faceNormalsUnsynced);
+		CopySyncedToUnsyncedImpl(centerNormalsSynced, centerNormalsUnsynced);
+	}
+
+	for (int i = 1; i < numHeightMipMaps; i++) {
+		CopySyncedToUnsyncedImpl(maxMipHeightMaps[true][i - 1], maxMipHeightMaps[false][i - 1]);
+	}
 	eventHandler.UnsyncedHeightMapUpdate(SRectangle{ 0, 0, mapDims.mapx, mapDims.mapy });
 }
 
+void CReadMap::ShareUnsyncedMaps(bool share)
+{
+	RECOIL_DETAILED_TRACY_ZONE;
+	if (share == unsyncedMapsShared)
+		return;
+
+	if ((unsyncedMapsShared = share)) {
+		// pending unsynced updates read from the synced arrays, nothing is lost
+		std::vector<float>().swap(*heightMapUnsyncedPtr);
+		std::vector<float3>().swap(faceNormalsUnsynced);
+		std::vector<float3>().swap(centerNormalsUnsynced);
+
+		sharedCornerHeightMaps[0] = sharedCornerHeightMaps[1];
+		sharedFaceNormals[0] = sharedFaceNormals[1];
+		sharedCenterNormals[0] = sharedCenterNormals[1];
+		return;
+	}
+
+	// the views diverge from here on, start from what was shown so far
+	*heightMapUnsyncedPtr = *heightMapSyncedPtr;
+	faceNormalsUnsynced = faceNormalsSynced;
+	centerNormalsUnsynced = centerNormalsSynced;
+
+	sharedCornerHeightMaps[0] = &(*heightMapUnsyncedPtr)[0];
+	sharedFaceNormals[0] = &faceNormalsUnsynced[0];
+	sharedCenterNormals[0] = &centerNormalsUnsynced[0];
+}
+
 bool CReadMap::HasVisibleWater()  const { return (!mapRendering->voidWater && !IsAboveWater()); }
 bool CReadMap::HasOnlyVoidWater() const { return ( mapRendering->voidWater &&  IsUnderWater()); }
@@ -4,6 +4,8 @@
 #define READ_MAP_H
 
 #include <array>
+#include <cstdio>
+#include <string>
 #include <vector>
 
 #include "MapTexture.h"
@@ -191,10 +193,18 @@ public:
 	const float3* GetSharedFaceNormals(bool synced) const { return sharedFaceNormals[synced]; }
 	const float3* GetSharedCenterNormals(bool synced) const { return sharedCenterNormals[synced]; }
 	const float* GetSharedSlopeMap(bool synced) const { return sharedSlopeMaps[synced]; }
+	/// highest corner height within each (2^mip)x(2^mip) block of squares, 0 < mip < numHeightMipMaps
+	const float* GetSharedMaxMIPHeightMap(uint32_t mip, bool synced) const { return maxMipHeightMaps[synced][mip - 1].data(); }
+
+	static int GetMaxMIPHeightMapSizeX(uint32_t mip);
+	static int GetMaxMIPHeightMapSizeY(uint32_t mip);
 
 	// Misc
 	void CopySyncedToUnsynced();
 
+	/// true while the unsynced corner heightmap and normals alias the synced ones
+	bool UnsyncedMapsShared() const { return unsyncedMapsShared; }
+
 	/// if you modify the heightmap through these, call UpdateHeightMapSynced
 	float SetHeight(const int idx, const float h, const int add = 0);
 	float AddHeight(const int idx, const float a);
@@ -224,17 +234,27 @@ public:
 	void UpdateHeightBounds();
 
 	bool GetHeightMapUpdated() const { return hmUpdated; }
+	// incremented whenever UpdateDraw applied unsynced heightmap changes
+	uint32_t GetUnsyncedHeightMapUpdateCount() const { return unsyncedHeightMapUpdateCount; }
 
 	virtual int2 GetPatch(int hmx, int hmz) const = 0;
 	virtual const float3& GetUnsyncedHeightInfo(int patchX, int patchZ) const = 0;
 private:
 	void InitHeightBounds();
 	void LoadOriginalHeightMapAndChecksum();
+	void ShareUnsyncedMaps(bool share);
+
+	std::string GetDerivedMapsCacheFileName() const;
+	void WriteDerivedMapsCacheHeader(FILE* file) const;
+	bool CheckDerivedMapsCacheHeader(FILE* file) const;
+	bool LoadDerivedMapsCache();
+	void SaveDerivedMapsCache() const;
 	void UpdateHeightBounds(int syncFrame);
 	void UpdateTempHeightBoundsSIMD(size_t begin, size_t end);
 
 	void UpdateCenterHeightmap(const SRectangle& rect, bool initialize) const;
 	void UpdateMipHeightmaps(const SRectangle& rect, bool initialize);
+	void UpdateMaxMipHeightmaps(const SRectangle& rect, bool synced);
 	void UpdateFaceNormals(const SRectangle& rect, bool initialize);
 	void UpdateSlopemap(const SRectangle& rect, bool initialize);
 
@@ -270,6 +290,13 @@ protected:
 	 */
 	std::array<float*, numHeightMipMaps> mipPointerHeightMaps;
 
+	/**
+	 * max-height pyramid over the corner heightmaps, [0] = unsynced, [1] = synced
+	 * maxMipHeightMaps[s][n] holds the highest corner of each (2^(n+1))x(2^(n+1))
+	 * block of squares, sizes are rounded up so every square is covered
+	 */
+	static std::array<std::vector<float>, numHeightMipMaps - 1> maxMipHeightMaps[2];
+
 	static std::vector<float3> faceNormalsSynced;     //< size: 2*mapx      *  mapy     , contains 2 normals per quad -> triangle strip [SYNCED]
 	static std::vector<float3> faceNormalsUnsynced;   //< size: 2*mapx      *  mapy     , contains 2 normals per quad -> triangle strip [UNSYNCED]
 	static std::vector<float3> centerNormalsSynced;   //< size:   mapx      *  mapy     , contains 1 interpolated normal per quad, same as (facenormal0+facenormal1).Normalize()) [SYNCED]
@@ -281,6 +308,7 @@ protected:
 
 
 	CRectangleOverlapHandler unsyncedHeightMapUpdates;
+	uint32_t unsyncedHeightMapUpdateCount = 0;
 
 	std::vector<float3> unsyncedHeightInfo; // per 128x128 HM patch
 private:
@@ -303,6 +331,7 @@ private:
 
 	bool processingHeightBounds = false;
 	bool hmUpdated = false;
+	bool unsyncedMapsShared = false;
 
 	float2 initHeightBounds; //< initial minimum- and maximum-height (before any deformations)
 	float2 tempHeightBounds; //< temporary minimum- and maximum-height
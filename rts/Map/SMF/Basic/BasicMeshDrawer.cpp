@@ -10,9 +10,14 @@
 #include "Rendering/GlobalRendering.h"
 #include "Rendering/GL/RenderBuffers.h"
 #include "System/EventHandler.h"
+#include "System/Config/ConfigHandler.h"
 
 #include "System/Misc/TracyDefs.h"
 
+CONFIG(bool, BasicMeshPerPatchLOD)
+	.defaultValue(true)
+	.description("Select the LOD of each Basic mesh-drawer patch by its distance to the camera rather than one LOD for the whole map. Custom vertex shaders need to handle the texSquareEdgeSpacing uniform to avoid cracks between patches.");
+
 
 CBasicMeshDrawer::CBasicMeshDrawer(CSMFGroundDrawer* gd)
 	: CEventClient("[CBasicMeshDrawer]", 717171, false)
@@ -22,7 +27,7 @@ CBasicMeshDrawer::CBasicMeshDrawer(CSMFGroundDrawer* gd)
 
 	numPatchesX = mapDims.mapx / PATCH_SIZE;
 	numPatchesY = mapDims.mapy / PATCH_SIZE;
-	drawPassLOD = 0;
+	perPatchLOD = configHandler->GetBool("BasicMeshPerPatchLOD");
 
 	assert(numPatchesX >= 1);
 	assert(numPatchesY >= 1);
@@ -62,6 +67,8 @@ CBasicMeshDrawer::CBasicMeshDrawer(CSMFGroundDrawer* gd)
 	for (auto& meshVisPatch : meshVisPatches) {
 		meshVisPatch.visUpdateFrames.fill(0);
 	}
+
+	patchLODs.resize(numPatchesX * numPatchesY, 0);
 }
 
 CBasicMeshDrawer::~CBasicMeshDrawer()
@@ -101,7 +108,39 @@ void CBasicMeshDrawer::Update(const DrawPass::e& drawPass)
 		}
 	}
 
-	drawPassLOD = CalcDrawPassLOD(activeCam, drawPass);
+	if (perPatchLOD) {
+		UpdatePatchLODs(activeCam, drawPass);
+	} else {
+		std::fill(patchLODs.begin(), patchLODs.end(), CalcDrawPassLOD(activeCam, drawPass));
+	}
+}
+
+void CBasicMeshDrawer::UpdatePatchLODs(const CCamera* cam, const DrawPass::e& drawPass)
+{
+	RECOIL_DETAILED_TRACY_ZONE;
+	static constexpr float wsEdge = PATCH_SIZE * SQUARE_SIZE;
+
+	// force SP and NP to equal LOD; avoids projection issues
+	if (drawPass == DrawPass::Shadow || drawPass == DrawPass::WaterReflection)
+		cam = CCameraHandler::GetCamera(CCamera::CAMTYPE_PLAYER);
+
+	const float3& camPos = cam->GetPos();
+
+	// invisible patches are included since their LOD decides the edges of visible neighbours
+	for (uint32_t pz = 0; pz < numPatchesY; pz++) {
+		for (uint32_t px = 0; px < numPatchesX; px++) {
+			const auto& uhmi = readMap->GetUnsyncedHeightInfo(px, pz);
+
+			// distance to the closest point of the patch bounds
+			const float3 patchPos = {
+				std::clamp(camPos.x, (px + 0) * wsEdge, (px + 1) * wsEdge),
+				std::clamp(camPos.y, uhmi.x           , uhmi.y           ),
+				std::clamp(camPos.z, (pz + 0) * wsEdge, (pz + 1) * wsEdge),
+			};
+
+			patchLODs[pz * numPatchesX + px] = CalcLODIndex(camPos.distance(patchPos), drawPass);
+		}
+	}
 }
 
 void CBasicMeshDrawer::UploadPatchSquareGeometry(std::unique_ptr<MeshRenderBuffer>& meshRenderBuffer, uint32_t lodStep)
@@ -171,31 +210,34 @@ void CBasicMeshDrawer::UploadPatchBorderGeometry(std::unique_ptr<BordRenderBuffe
 uint32_t CBasicMeshDrawer::CalcDrawPassLOD(const CCamera* cam, const DrawPass::e& drawPass) const
 {
 	RECOIL_DETAILED_TRACY_ZONE;
-	// higher detail biases LOD-step toward a smaller value
-	// NOTE: should perhaps prevent an insane initial bias?
-	int32_t lodBias = smfGroundDrawer->GetGroundDetail(drawPass) % LOD_LEVELS;
-	int32_t lodIndx = LOD_LEVELS - 1;
-
 	// force SP and NP to equal LOD; avoids projection issues
 	if (drawPass == DrawPass::Shadow || drawPass == DrawPass::WaterReflection)
 		cam = CCameraHandler::GetCamera(CCamera::CAMTYPE_PLAYER);
 
-	{
-		const CUnit* hitUnit = nullptr;
-		const CFeature* hitFeature = nullptr;
+	const CUnit* hitUnit = nullptr;
+	const CFeature* hitFeature = nullptr;
+
+	float mapRayDist = 0.0f;
+
+	if ((mapRayDist = TraceRay::GuiTraceRay(cam->GetPos(), cam->GetDir(), cam->GetFarPlaneDist(), nullptr, hitUnit, hitFeature, false, true, true)) < 0.0f)
+		mapRayDist = CGround::LinePlaneCol(cam->GetPos(), cam->GetDir(), cam->GetFarPlaneDist(), readMap->GetCurrMinHeight());
+	if (mapRayDist < 0.0f)
+		return (LOD_LEVELS - 1);
 
-		float mapRayDist = 0.0f;
+	return (CalcLODIndex(mapRayDist, drawPass));
+}
 
-		if ((mapRayDist = TraceRay::GuiTraceRay(cam->GetPos(), cam->GetDir(), cam->GetFarPlaneDist(), nullptr, hitUnit, hitFeature, false, true, true)) < 0.0f)
-			mapRayDist = CGround::LinePlaneCol(cam->GetPos(), cam->GetDir(), cam->GetFarPlaneDist(), readMap->GetCurrMinHeight());
-		if (mapRayDist < 0.0f)
-			return lodIndx;
+uint32_t CBasicMeshDrawer::CalcLODIndex(float dist, const DrawPass::e& drawPass) const
+{
+	// higher detail biases LOD-step toward a smaller value
+	// NOTE: should perhaps prevent an insane initial bias?
+	int32_t lodBias = smfGroundDrawer->GetGroundDetail(drawPass) % LOD_LEVELS;
+	int32_t lodIndx = LOD_LEVELS - 1;
 
-		for (uint32_t n = 0; n < LOD_LEVELS; n += 1) {
-			if (mapRayDist < lodDistTable[n]) {
-				lodIndx = n;
-				break;
-			}
+	for (uint32_t n = 0; n < LOD_LEVELS; n += 1) {
+		if (dist < lodDistTable[n]) {
+			lodIndx = n;
+			break;
 		}
 	}
 
@@ -212,10 +254,29 @@ uint32_t CBasicMeshDrawer::CalcDrawPassLOD(const CCamera* cam, const DrawPass::e
 
 
 
-void CBasicMeshDrawer::DrawSquareMeshPatch() const
+float4 CBasicMeshDrawer::GetPatchEdgeSpacing(uint32_t px, uint32_t py) const
+{
+	const uint32_t patchIdx = py * numPatchesX + px;
+	const uint32_t patchLOD = patchLODs[patchIdx];
+
+	// vertex spacing along each edge is that of the coarser of both patches
+	// sharing it; the vertex shader collapses the finer patch's edge onto it
+	const auto EdgeSpacing = [&](bool haveNeighbor, uint32_t neighborIdx) {
+		return (static_cast<float>((1 << std::max(patchLOD, haveNeighbor? uint32_t(patchLODs[neighborIdx]): patchLOD)) * SQUARE_SIZE));
+	};
+
+	return {
+		EdgeSpacing(px > 0              , patchIdx - 1          ), // L
+		EdgeSpacing(px < numPatchesX - 1, patchIdx + 1          ), // R
+		EdgeSpacing(py > 0              , patchIdx - numPatchesX), // T
+		EdgeSpacing(py < numPatchesY - 1, patchIdx + numPatchesX), // B
+	};
+}
+
+void CBasicMeshDrawer::DrawSquareMeshPatch(uint32_t lod) const
 {
 	RECOIL_DETAILED_TRACY_ZONE;
-	meshRenderBuffers[drawPassLOD]->DrawElements(GL_TRIANGLES, false);
+	meshRenderBuffers[lod]->DrawElements(GL_TRIANGLES, false);
 }
 
 void CBasicMeshDrawer::DrawMesh(const DrawPass::e& drawPass)
@@ -232,19 +293,19 @@ void CBasicMeshDrawer::DrawMesh(const DrawPass::e& drawPass)
 			if (meshVisPatch.visUpdateFrames[activeCam->GetCamType()] < globalRendering->drawFrame)
 				continue;
 
-			smfGroundDrawer->SetupBigSquare(drawPass, px, py);
+			smfGroundDrawer->SetupBigSquare(drawPass, px, py, GetPatchEdgeSpacing(px, py));
 
-			DrawSquareMeshPatch();
+			DrawSquareMeshPatch(patchLODs[py * numPatchesX + px]);
 		}
 	}
 }
 
 
 
-void CBasicMeshDrawer::DrawBorderMeshPatch(const CCamera* activeCam, uint32_t borderSide) const
+void CBasicMeshDrawer::DrawBorderMeshPatch(uint32_t lod, uint32_t borderSide) const
 {
 	RECOIL_DETAILED_TRACY_ZONE;
-	const auto idx = drawPassLOD * static_cast<uint32_t>(MAP_BORDER_C) + static_cast<uint32_t>(borderSide);
+	const auto idx = lod * static_cast<uint32_t>(MAP_BORDER_C) + static_cast<uint32_t>(borderSide);
 	borderRenderBuffers[idx]->DrawElements(GL_TRIANGLES, false);
 }
 
@@ -262,15 +323,15 @@ void CBasicMeshDrawer::DrawBorderMesh(const DrawPass::e& drawPass)
 		if (meshVisPatches[0 * numPatchesX + px].visUpdateFrames[actCamType] < globalRendering->drawFrame)
 			continue;
 
-		smfGroundDrawer->SetupBigSquare(drawPass, px, 0);
-		DrawBorderMeshPatch(activeCam, MAP_BORDER_T);
+		smfGroundDrawer->SetupBigSquare(drawPass, px, 0, GetPatchEdgeSpacing(px, 0));
+		DrawBorderMeshPatch(patchLODs[0 * numPatchesX + px], MAP_BORDER_T);
 	}
 	for (uint32_t py = 0; py < numPatchesY; py++) {
 		if (meshVisPatches[py * numPatchesX + npxm1].visUpdateFrames[actCamType] < globalRendering->drawFrame)
 			continue;
 
-		smfGroundDrawer->SetupBigSquare(drawPass, npxm1, py);
-		DrawBorderMeshPatch(activeCam, MAP_BORDER_R);
+		smfGroundDrawer->SetupBigSquare(drawPass, npxm1, py, GetPatchEdgeSpacing(npxm1, py));
+		DrawBorderMeshPatch(patchLODs[py * numPatchesX + npxm1], MAP_BORDER_R);
 	}
 
 	//glFrontFace(GL_CCW);
@@ -278,14 +339,14 @@ void CBasicMeshDrawer::DrawBorderMesh(const DrawPass::e& drawPass)
 		if (meshVisPatches[npym1 * numPatchesX + px].visUpdateFrames[actCamType] < globalRendering->drawFrame)
 			continue;
 
-		smfGroundDrawer->SetupBigSquare(drawPass, px, npym1);
-		DrawBorderMeshPatch(activeCam, MAP_BORDER_B);
+		smfGroundDrawer->SetupBigSquare(drawPass, px, npym1, GetPatchEdgeSpacing(px, npym1));
+		DrawBorderMeshPatch(patchLODs[npym1 * numPatchesX + px], MAP_BORDER_B);
 	}
 	for (uint32_t py = 0; py < numPatchesY; py++) {
 		if (meshVisPatches[py * numPatchesX + 0].visUpdateFrames[actCamType] < globalRendering->drawFrame)
 			continue;
 
-		smfGroundDrawer->SetupBigSquare(drawPass, 0, py);
-		DrawBorderMeshPatch(activeCam, MAP_BORDER_L);
+		smfGroundDrawer->SetupBigSquare(drawPass, 0, py, GetPatchEdgeSpacing(0, py));
+		DrawBorderMeshPatch(patchLODs[py * numPatchesX + 0], MAP_BORDER_L);
 	}
 }
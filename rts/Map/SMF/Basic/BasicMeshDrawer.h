@@ -12,6 +12,7 @@
 #include "Rendering/GL/RenderBuffersFwd.h"
 #include "Rendering/GL/VertexArrayTypes.h"
 #include "System/EventClient.h"
+#include "System/float4.h"
 
 class CSMFGroundDrawer;
 class CCamera;
@@ -52,16 +53,25 @@ private:
 	void UploadPatchSquareGeometry(std::unique_ptr<MeshRenderBuffer>& meshRenderBuffer, uint32_t lodStep);
 	void UploadPatchBorderGeometry(std::unique_ptr<BordRenderBuffer>& borderRenderBuffer, MAP_BORDERS b, uint32_t lodStep);
 
-	void DrawSquareMeshPatch() const;
-	void DrawBorderMeshPatch(const CCamera* activeCam, uint32_t borderSide) const;
+	void DrawSquareMeshPatch(uint32_t lod) const;
+	void DrawBorderMeshPatch(uint32_t lod, uint32_t borderSide) const;
+
+	void UpdatePatchLODs(const CCamera* cam, const DrawPass::e& drawPass);
 
 	uint32_t CalcDrawPassLOD(const CCamera* cam, const DrawPass::e& drawPass) const;
+	uint32_t CalcLODIndex(float dist, const DrawPass::e& drawPass) const;
+
+	float4 GetPatchEdgeSpacing(uint32_t px, uint32_t py) const;
 private:
 	uint32_t numPatchesX;
 	uint32_t numPatchesY;
-	uint32_t drawPassLOD;
+
+	// if false, every patch is drawn at the LOD of the map-point the camera looks at
+	bool perPatchLOD;
 
 	std::vector<MeshVisPatch> meshVisPatches;
+	// LOD of each patch for the current draw-pass
+	std::vector<uint8_t> patchLODs;
 	std::array<std::unique_ptr<MeshRenderBuffer>, LOD_LEVELS> meshRenderBuffers;
 	std::array<std::unique_ptr<BordRenderBuffer>, MAP_BORDERS::MAP_BORDER_C * LOD_LEVELS> borderRenderBuffers;
 
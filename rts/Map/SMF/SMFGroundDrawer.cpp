@@ -427,12 +427,12 @@ void CSMFGroundDrawer::SetLuaShader(const LuaMapShaderData* luaMapShaderData)
 	smfRenderStates[RENDER_STATE_LUA]->Update(this, luaMapShaderData);
 }
 
-void CSMFGroundDrawer::SetupBigSquare(const DrawPass::e& drawPass, const int bigSquareX, const int bigSquareY)
+void CSMFGroundDrawer::SetupBigSquare(const DrawPass::e& drawPass, const int bigSquareX, const int bigSquareY, const float4& edgeSpacing)
 {
 	RECOIL_DETAILED_TRACY_ZONE;
 	if (drawPass != DrawPass::Shadow) {
 		groundTextures->BindSquareTexture(bigSquareX, bigSquareY);
-		smfRenderStates[RENDER_STATE_SEL]->SetSquareTexGen(bigSquareX, bigSquareY);
+		smfRenderStates[RENDER_STATE_SEL]->SetSquareTexGen(bigSquareX, bigSquareY, edgeSpacing);
 
 		if (borderShader && borderShader->IsBound()) {
 			borderShader->SetUniform("texSquare", bigSquareX, bigSquareY);
@@ -441,6 +441,7 @@ void CSMFGroundDrawer::SetupBigSquare(const DrawPass::e& drawPass, const int big
 	else {
 		if (shadowShader && shadowShader->IsBound()) {
 			shadowShader->SetUniform("texSquare", bigSquareX, bigSquareY);
+			shadowShader->SetUniform("texSquareEdgeSpacing", edgeSpacing.x, edgeSpacing.y, edgeSpacing.z, edgeSpacing.w);
 		}
 	}
 }
@@ -56,7 +56,9 @@ public:
 		}
 	}
 
-	void SetupBigSquare(const DrawPass::e& drawPass, int bigSquareX, int bigSquareY);
+	// <edgeSpacing> is the vertex spacing along the L,R,T,B patch edges that
+	// edge vertices are snapped to; zero leaves the mesh unchanged
+	void SetupBigSquare(const DrawPass::e& drawPass, int bigSquareX, int bigSquareY, const float4& edgeSpacing = {});
 
 
 	void IncreaseDetail() { SetDetail(groundDetail + 1); }
@@ -1,6 +1,7 @@
 /* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
 
 
+#include <algorithm>
 #include <cmath>
 #include <cstdlib>
 #include <cstdio>
@@ -47,6 +48,8 @@ LOG_REGISTER_SECTION_GLOBAL(LOG_SECTION_SMF_GROUND_TEXTURES)
 #define LOG_SECTION_CURRENT LOG_SECTION_SMF_GROUND_TEXTURES
 
 CONFIG(bool , SMFTextureStreaming).defaultValue(false).safemodeValue(true).description("Dynamically load and unload SMF Diffuse textures. Saves VRAM, worse performance and image quality.");
+CONFIG(int  , SMFTextureStreamingUploadBudget).defaultValue(2048).minimumValue(0).description("In case SMFTextureStreaming = true, the number of KB of diffuse texture data uploaded per frame; squares beyond it are refined over the following frames. 0 is unlimited.");
+CONFIG(int  , SMFTextureStreamingMemBudget).defaultValue(0).minimumValue(0).description("In case SMFTextureStreaming = true, the number of MB the diffuse textures may occupy before the least recently drawn squares are unloaded. 0 is unlimited.");
 CONFIG(float, SMFTextureLodBias).defaultValue(0.0f).safemodeValue(0.0f).description("In case SMFTextureStreaming = false, this parameter controls the sampling lod bias applied to diffuse texture");
 
 std::vector<CSMFGroundTextures::GroundSquare> CSMFGroundTextures::squares;
@@ -76,6 +79,8 @@ CSMFGroundTextures::CSMFGroundTextures(CSMFReadMap* rm): smfMap(rm)
 	RECOIL_DETAILED_TRACY_ZONE;
 	smfTextureStreaming = configHandler->GetBool("SMFTextureStreaming");
 	smfTextureLodBias = configHandler->GetFloat("SMFTextureLodBias");
+	streamingUploadBudget = configHandler->GetInt("SMFTextureStreamingUploadBudget") * size_t(1024);
+	streamingMemBudget = configHandler->GetInt("SMFTextureStreamingMemBudget") * size_t(1024 * 1024);
 
 	LoadTiles(smfMap->GetMapFile());
 	if (smfTextureStreaming) {
@@ -350,6 +355,11 @@ void CSMFGroundTextures::DrawUpdate()
 	const float vsySq = globalRendering->viewSizeY * globalRendering->viewSizeY;
 	const float vdiag = fastmath::apxsqrt(vsxSq + vsySq);
 
+	size_t residentBytes = 0;
+
+	loadRequests.clear();
+	evictCandidates.clear();
+
 	for (int y = 0; y < smfMap->numBigTexY; ++y) {
 		float dz = cam->GetPos().z - (y * smfMap->bigSquareSize * SQUARE_SIZE);
 		dz -= (SQUARE_SIZE << 6);
@@ -358,16 +368,22 @@ void CSMFGroundTextures::DrawUpdate()
 		for (int x = 0; x < smfMap->numBigTexX; ++x) {
 			GroundSquare* square = &squares[y * smfMap->numBigTexX + x];
 
+			residentBytes += GetSquareTexBytes(square->GetMipLevel());
+
 			if (square->HasLuaTexture()) {
 				// no deletion or mip-level selection
 				continue;
 			}
 
 			if (!TexSquareInView(x, y)) {
-				if ((square->GetMipLevel() < 3) && ((globalRendering->drawFrame - square->GetDrawFrame()) > 120)) {
+				if (square->GetMipLevel() < 3) {
 					// `unload` texture (load lowest mip-map) if
 					// the square wasn't visible for 120 vframes
-					LoadSquareTexture(x, y, 3);
+					if ((globalRendering->drawFrame - square->GetDrawFrame()) > 120) {
+						loadRequests.push_back({x, y, 3, 0.0f, 0});
+					} else {
+						evictCandidates.push_back({x, y, 3, float(square->GetDrawFrame()), 0});
+					}
 				}
 				continue;
 			}
@@ -423,10 +439,95 @@ void CSMFGroundTextures::DrawUpdate()
 				wantedLevel--;
 
 			if (square->GetMipLevel() != wantedLevel) {
-				LoadSquareTexture(x, y, wantedLevel);
+				loadRequests.push_back({x, y, wantedLevel, dist, 0});
 			}
 		}
 	}
+
+	StreamSquareTextures(residentBytes);
+}
+
+void CSMFGroundTextures::StreamSquareTextures(size_t residentBytes)
+{
+	RECOIL_DETAILED_TRACY_ZONE;
+	static constexpr GLbitfield access = GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT;
+
+	if (loadRequests.empty())
+		return;
+
+	const auto GetLevel = [&](const SquareLoadRequest& r) { return int(squares[r.y * smfMap->numBigTexX + r.x].GetMipLevel()); };
+
+	// downgrades first since they are cheap and free memory, then the closest squares
+	std::sort(loadRequests.begin(), loadRequests.end(), [&](const SquareLoadRequest& a, const SquareLoadRequest& b) {
+		const bool da = (a.level > GetLevel(a));
+		const bool db = (b.level > GetLevel(b));
+
+		if (da != db)
+			return da;
+
+		return (a.sortKey < b.sortKey);
+	});
+	// least recently drawn first
+	std::sort(evictCandidates.begin(), evictCandidates.end(), [](const SquareLoadRequest& a, const SquareLoadRequest& b) {
+		return (a.sortKey < b.sortKey);
+	});
+
+	size_t batchBytes = 0;
+	size_t numEvicted = 0;
+
+	loadBatch.clear();
+
+	const auto AddToBatch = [&](SquareLoadRequest r) {
+		residentBytes -= GetSquareTexBytes(GetLevel(r));
+		residentBytes += GetSquareTexBytes(r.level);
+
+		r.pboOffset = batchBytes;
+		batchBytes += GetSquareTexBytes(r.level);
+		loadBatch.push_back(r);
+	};
+
+	for (const SquareLoadRequest& r: loadRequests) {
+		// spread the uploads over several frames, but always make progress
+		if (streamingUploadBudget > 0 && !loadBatch.empty() && (batchBytes + GetSquareTexBytes(r.level)) > streamingUploadBudget)
+			break;
+
+		if (streamingMemBudget > 0 && r.level < GetLevel(r)) {
+			const size_t extraBytes = GetSquareTexBytes(r.level) - GetSquareTexBytes(GetLevel(r));
+
+			while ((residentBytes + extraBytes) > streamingMemBudget && numEvicted < evictCandidates.size()) {
+				AddToBatch(evictCandidates[numEvicted++]);
+			}
+
+			// keep the square at its current level until memory frees up
+			if ((residentBytes + extraBytes) > streamingMemBudget)
+				continue;
+		}
+
+		AddToBatch(r);
+	}
+
+	if (loadBatch.empty())
+		return;
+
+	pbo.Bind();
+	pbo.New(batchBytes);
+
+	// tile extraction is a plain copy out of the static tile-data, so can run on all threads
+	if (GLubyte* pboMem = pbo.MapBuffer(0, pbo.GetSize(), access | pbo.mapUnsyncedBit); pboMem != nullptr) {
+		for_mt(0, loadBatch.size(), [&](const int i) {
+			const SquareLoadRequest& r = loadBatch[i];
+			ExtractSquareTiles(r.x, r.y, r.level, reinterpret_cast<GLint*>(pboMem + r.pboOffset));
+		});
+	}
+
+	pbo.UnmapBuffer();
+
+	for (const SquareLoadRequest& r: loadBatch) {
+		UploadSquareTexture(r.x, r.y, r.level, pbo.GetPtr(r.pboOffset));
+	}
+
+	pbo.Invalidate();
+	pbo.Unbind();
 }
 
 
@@ -541,12 +642,33 @@ void CSMFGroundTextures::ExtractSquareTiles(
 	}
 }
 
+size_t CSMFGroundTextures::GetSquareTexBytes(int level) const
+{
+	const size_t mipSqSize = smfMap->bigTexSize >> level;
+	return ((mipSqSize * mipSqSize) / 2);
+}
+
 void CSMFGroundTextures::LoadSquareTexture(int x, int y, int level)
 {
 	RECOIL_DETAILED_TRACY_ZONE;
-	static constexpr GLenum ttarget = GL_TEXTURE_2D;
 	static constexpr GLbitfield access = GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT;
 
+	pbo.Bind();
+	pbo.New(GetSquareTexBytes(level));
+	ExtractSquareTiles(x, y, level, reinterpret_cast<GLint*>(pbo.MapBuffer(0, pbo.GetSize(), access | pbo.mapUnsyncedBit)));
+	pbo.UnmapBuffer();
+
+	UploadSquareTexture(x, y, level, pbo.GetPtr());
+
+	pbo.Invalidate();
+	pbo.Unbind();
+}
+
+void CSMFGroundTextures::UploadSquareTexture(int x, int y, int level, const void* data)
+{
+	RECOIL_DETAILED_TRACY_ZONE;
+	static constexpr GLenum ttarget = GL_TEXTURE_2D;
+
 	const int mipSqSize = smfMap->bigTexSize >> level;
 	const int numSqBytes = (mipSqSize * mipSqSize) / 2;
 
@@ -554,11 +676,6 @@ void CSMFGroundTextures::LoadSquareTexture(int x, int y, int level)
 	square->SetMipLevel(level);
 	assert(!square->HasLuaTexture());
 
-	pbo.Bind();
-	pbo.New(numSqBytes);
-	ExtractSquareTiles(x, y, level, reinterpret_cast<GLint*>(pbo.MapBuffer(0, pbo.GetSize(), access | pbo.mapUnsyncedBit)));
-	pbo.UnmapBuffer();
-
 	glDeleteTextures(1, square->GetTextureIDPtr());
 	glGenTextures(1, square->GetTextureIDPtr());
 	glBindTexture(ttarget, square->GetTextureID());
@@ -577,11 +694,7 @@ void CSMFGroundTextures::LoadSquareTexture(int x, int y, int level)
 		glTexParameterf(ttarget, GL_TEXTURE_PRIORITY, 0.5f);
 	}
 
-	glCompressedTexImage2D(ttarget, 0, tileTexFormat, mipSqSize, mipSqSize, 0, numSqBytes, pbo.GetPtr());
-
-	pbo.Invalidate();
-	pbo.Unbind();
-
+	glCompressedTexImage2D(ttarget, 0, tileTexFormat, mipSqSize, mipSqSize, 0, numSqBytes, data);
 	glBindTexture(ttarget, 0);
 }
 
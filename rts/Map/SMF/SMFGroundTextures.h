@@ -30,6 +30,10 @@ protected:
 	void ExtractSquareTiles(const int texSquareX, const int texSquareY, const int mipLevel, GLint* tileBuf) const;
 	void LoadSquareTexture(int x, int y, int level);
 	void LoadSquareTexturePersistent(int x, int y);
+	void UploadSquareTexture(int x, int y, int level, const void* data);
+	void StreamSquareTextures(size_t residentBytes);
+
+	size_t GetSquareTexBytes(int level) const;
 
 	inline bool TexSquareInView(int, int) const;
 
@@ -74,6 +78,21 @@ private:
 	static std::vector<float> heightMinima;
 	static std::vector<float> stretchFactors;
 
+	struct SquareLoadRequest {
+		int x;
+		int y;
+		int level;
+		float sortKey; // camera distance, or draw-frame for eviction candidates
+		size_t pboOffset;
+	};
+
+	// squares whose wanted mip-level differs from the loaded one
+	std::vector<SquareLoadRequest> loadRequests;
+	// invisible squares above the lowest mip-level, unloaded when over the memory budget
+	std::vector<SquareLoadRequest> evictCandidates;
+	// what is (re)loaded this frame, within the upload budget
+	std::vector<SquareLoadRequest> loadBatch;
+
 	// use Pixel Buffer Objects for async. uploading (DMA)
 	PBO pbo;
 
@@ -81,6 +100,9 @@ private:
 	// unsigned int pboUnsyncedBit = 0;
 	bool smfTextureStreaming = false;
 	float smfTextureLodBias = 0.0f;
+
+	size_t streamingUploadBudget = 0;
+	size_t streamingMemBudget = 0;
 };
 
 #endif // _BF_GROUND_TEXTURES_H_
@@ -471,8 +471,8 @@ void CSMFReadMap::UpdateHeightMapUnsyncedPost()
 				const size_t idx1 = idx0 + bigSquareSize + 1;
 
 				unsyncedHeightInfo[pz * numBigTexX + px].arr = xsimd::reduce(
-					cornerHeightMapUnsynced.data() + idx0,
-					cornerHeightMapUnsynced.data() + idx1,
+					GetCornerHeightMapUnsynced() + idx0,
+					GetCornerHeightMapUnsynced() + idx1,
 					unsyncedHeightInfo[pz * numBigTexX + px].arr,
 					MinOp{}, MaxOp{}, PlusOp{}
 				);
@@ -485,6 +485,9 @@ void CSMFReadMap::UpdateHeightMapUnsyncedPost()
 void CSMFReadMap::UpdateCornerHeightMapUnsynced(const SRectangle& update)
 {
 	RECOIL_DETAILED_TRACY_ZONE;
+	if (UnsyncedMapsShared())
+		return;
+
 	//corner space, inclusive
 	for (int z = update.z1; z <= update.z2; z++) {
 		{
@@ -566,6 +569,9 @@ void CSMFReadMap::UpdateHeightBoundsUnsynced(const SRectangle& update)
 void CSMFReadMap::UpdateFaceNormalsUnsynced(const SRectangle& update)
 {
 	RECOIL_DETAILED_TRACY_ZONE;
+	// the synced normals are already up to date
+	if (UnsyncedMapsShared())
+		return;
 
 	const auto& sfn = faceNormalsSynced;
 	      auto& ufn = faceNormalsUnsynced;
@@ -318,11 +318,12 @@ void SMFRenderStateGLSL::Disable(const CSMFGroundDrawer* smfGroundDrawer, const
 	glActiveTexture(GL_TEXTURE0);
 }
 
-void SMFRenderStateGLSL::SetSquareTexGen(const int sqx, const int sqy) const {
+void SMFRenderStateGLSL::SetSquareTexGen(const int sqx, const int sqy, const float4& edgeSpacing) const {
 	RECOIL_DETAILED_TRACY_ZONE;
 	// needs to be set even for Lua shaders, is unknowable otherwise
 	// (works because SMFGroundDrawer::SetupBigSquare always calls us)
 	currShader->SetUniform("texSquare", sqx, sqy);
+	currShader->SetUniform("texSquareEdgeSpacing", edgeSpacing.x, edgeSpacing.y, edgeSpacing.z, edgeSpacing.w);
 }
 
 void SMFRenderStateGLSL::SetCurrentShader(const CSMFGroundDrawer* smfGroundDrawer, const DrawPass::e& drawPass) {
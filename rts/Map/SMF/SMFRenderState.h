@@ -4,6 +4,7 @@
 
 #include <array>
 #include "Map/MapDrawPassTypes.h"
+#include "System/float4.h"
 
 class CSMFGroundDrawer;
 struct ISkyLight;
@@ -42,7 +43,7 @@ public:
 	virtual void Enable(const CSMFGroundDrawer* smfGroundDrawer, const DrawPass::e& drawPass) = 0;
 	virtual void Disable(const CSMFGroundDrawer* smfGroundDrawer, const DrawPass::e& drawPass) = 0;
 
-	virtual void SetSquareTexGen(const int sqx, const int sqy) const = 0;
+	virtual void SetSquareTexGen(const int sqx, const int sqy, const float4& edgeSpacing) const = 0;
 	virtual void SetCurrentShader(const CSMFGroundDrawer* smfGroundDrawer, const DrawPass::e& drawPass) = 0;
 	virtual void UpdateShaderSkyUniforms() = 0;
 };
@@ -65,7 +66,7 @@ public:
 	void Enable(const CSMFGroundDrawer* smfGroundDrawer, const DrawPass::e& drawPass) override {}
 	void Disable(const CSMFGroundDrawer* smfGroundDrawer, const DrawPass::e& drawPass) override {}
 
-	void SetSquareTexGen(const int sqx, const int sqy) const override {}
+	void SetSquareTexGen(const int sqx, const int sqy, const float4& edgeSpacing) const override {}
 	void SetCurrentShader(const CSMFGroundDrawer* smfGroundDrawer, const DrawPass::e& drawPass) override {}
 	void UpdateShaderSkyUniforms() override {}
 };
@@ -94,7 +95,7 @@ public:
 	void Enable(const CSMFGroundDrawer* smfGroundDrawer, const DrawPass::e& drawPass) override;
 	void Disable(const CSMFGroundDrawer* smfGroundDrawer, const DrawPass::e& drawPass) override;
 
-	void SetSquareTexGen(const int sqx, const int sqy) const override;
+	void SetSquareTexGen(const int sqx, const int sqy, const float4& edgeSpacing) const override;
 	void SetCurrentShader(const CSMFGroundDrawer* smfGroundDrawer, const DrawPass::e& drawPass) override;
 	void UpdateShaderSkyUniforms() override;
 
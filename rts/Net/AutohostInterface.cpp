@@ -77,6 +77,41 @@ enum EVENT
 	 */
 	SERVER_WARNING = 5,
 
+	/**
+	 * Recent server frame-telemetry records
+	 *
+	 *   (uint16 numrecords, uint16 recordsize, uint8[numrecords * recordsize] records)
+	 *
+	 * Records are sent oldest first, their layout is CFrameTelemetry::Record
+	 * as defined in rts/System/FrameTelemetry.h. Each covers one server tick
+	 * that created frames; frameTimeMs is the time since the previous record
+	 * and the counters are (ingame players, max. frames behind, frames
+	 * created, speed percentage).
+	 */
+	SERVER_TELEMETRY = 6,
+
+	/**
+	 * Periodic game progress (AutohostStatusInterval)
+	 *
+	 *   (int32 frame, float internalspeed, float userspeed, uint8 paused)
+	 *
+	 * Sent while paused too; internalspeed is the speed the game runs at
+	 * after lag protection, userspeed the one requested by the players.
+	 */
+	SERVER_FRAME = 7,
+
+	/**
+	 * Lag protection decision (AutohostStatusInterval)
+	 *
+	 *   (uint8 speedcontrol, float refcpuusage, float mediancpu, int32 medianping, float oldspeed, float newspeed)
+	 *
+	 * Sent every time the server re-evaluates the game speed (every two
+	 * seconds while the game runs). refcpuusage is the load the speed is
+	 * based on: the highest (speedcontrol 2) or median (speedcontrol 1)
+	 * player CPU usage. oldspeed equals newspeed if nothing changed.
+	 */
+	SERVER_SPEEDCONTROL = 8,
+
 	/**
 	 * Player has joined the game
 	 *
@@ -137,6 +172,17 @@ enum EVENT
 	 */
 	PLAYER_DEFEATED = 14,
 
+	/**
+	 * CPU usage and ping of the ingame players (AutohostStatusInterval)
+	 *
+	 *   (uint8 numplayers, uint8 recordsize, uint8[numplayers * recordsize] records)
+	 *
+	 * Records are AutohostInterface::PlayerStatus as defined in
+	 * rts/Net/AutohostInterface.h: (uint8 playernumber, uint8 spectator,
+	 * float cpuusage, int32 ping in milliseconds).
+	 */
+	PLAYER_STATUS = 15,
+
 	/**
 	 * Message sent by Lua script
 	 *
@@ -154,6 +200,9 @@ enum EVENT
 	 *   (uint8 teamnumber, TeamStatistics stats)
 	 *
 	 * TeamStatistics is object as defined in rts/Sim/Misc/TeamStatistics.h
+	 *
+	 * Sent for every team at the end of the game and, with a non-zero
+	 * AutohostStatusInterval, periodically (as reported by one client).
 	 */
 	GAME_TEAMSTAT = NETMSG_TEAMSTAT, // should be 60
 };
@@ -363,6 +412,62 @@ void AutohostInterface::Warning(const std::string& message)
 	}
 }
 
+void AutohostInterface::SendTelemetry(const std::uint8_t* records, std::uint16_t numRecords, std::uint16_t recordSize)
+{
+	if (autohost.is_open()) {
+		std::vector<std::uint8_t> buffer(1 + 2 * sizeof(std::uint16_t) + numRecords * recordSize);
+		buffer[0] = SERVER_TELEMETRY;
+
+		memcpy(&buffer[1], &numRecords, sizeof(numRecords));
+		memcpy(&buffer[3], &recordSize, sizeof(recordSize));
+		std::copy(records, records + numRecords * recordSize, buffer.begin() + 5);
+
+		Send(asio::buffer(buffer));
+	}
+}
+
+void AutohostInterface::SendGameFrame(std::int32_t frameNum, float internalSpeed, float userSpeed, bool paused)
+{
+	std::uint8_t msg[1 + sizeof(frameNum) + sizeof(internalSpeed) + sizeof(userSpeed) + 1];
+	msg[0] = SERVER_FRAME;
+
+	memcpy(&msg[1], &frameNum, sizeof(frameNum));
+	memcpy(&msg[5], &internalSpeed, sizeof(internalSpeed));
+	memcpy(&msg[9], &userSpeed, sizeof(userSpeed));
+	msg[13] = paused;
+
+	Send(asio::buffer(&msg, sizeof(msg)));
+}
+
+void AutohostInterface::SendSpeedControl(uchar speedCtrl, float refCpuUsage, float medianCpu, std::int32_t medianPing, float oldSpeed, float newSpeed)
+{
+	std::uint8_t msg[1 + 1 + sizeof(float) * 4 + sizeof(std::int32_t)];
+	msg[0] = SERVER_SPEEDCONTROL;
+	msg[1] = speedCtrl;
+
+	memcpy(&msg[ 2], &refCpuUsage, sizeof(refCpuUsage));
+	memcpy(&msg[ 6], &medianCpu, sizeof(medianCpu));
+	memcpy(&msg[10], &medianPing, sizeof(medianPing));
+	memcpy(&msg[14], &oldSpeed, sizeof(oldSpeed));
+	memcpy(&msg[18], &newSpeed, sizeof(newSpeed));
+
+	Send(asio::buffer(&msg, sizeof(msg)));
+}
+
+void AutohostInterface::SendPlayerStatus(const std::vector<PlayerStatus>& status)
+{
+	if (autohost.is_open()) {
+		std::vector<std::uint8_t> buffer(1 + 2 * sizeof(uchar) + status.size() * sizeof(PlayerStatus));
+		buffer[0] = PLAYER_STATUS;
+		buffer[1] = status.size();
+		buffer[2] = sizeof(PlayerStatus);
+
+		memcpy(&buffer[3], status.data(), status.size() * sizeof(PlayerStatus));
+
+		Send(asio::buffer(buffer));
+	}
+}
+
 void AutohostInterface::SendLuaMsg(const std::uint8_t* msg, size_t msgSize)
 {
 	if (autohost.is_open()) {
@@ -4,6 +4,7 @@
 #define AUTOHOST_INTERFACE_H
 
 #include <string>
+#include <vector>
 #include <cinttypes>
 #include <asio/ip/udp.hpp>
 
@@ -46,6 +47,22 @@ public:
 	void Message(const std::string& message);
 	void Warning(const std::string& message);
 
+	void SendTelemetry(const std::uint8_t* records, std::uint16_t numRecords, std::uint16_t recordSize);
+
+#pragma pack(push, 1)
+	/// per-player record of the PLAYER_STATUS event
+	struct PlayerStatus {
+		std::uint8_t playerNum;
+		std::uint8_t spectator;
+		float cpuUsage;
+		std::int32_t ping; ///< in milliseconds
+	};
+#pragma pack(pop)
+
+	void SendGameFrame(std::int32_t frameNum, float internalSpeed, float userSpeed, bool paused);
+	void SendSpeedControl(uchar speedCtrl, float refCpuUsage, float medianCpu, std::int32_t medianPing, float oldSpeed, float newSpeed);
+	void SendPlayerStatus(const std::vector<PlayerStatus>& status);
+
 	void SendLuaMsg(const std::uint8_t* msg, size_t msgSize);
 	void Send(const std::uint8_t* msg, size_t msgSize);
 
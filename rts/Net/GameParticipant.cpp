@@ -22,7 +22,7 @@ GameParticipant::~GameParticipant()
 
 void GameParticipant::SendData(std::shared_ptr<const netcode::RawPacket> packet)
 {
-	if (clientLink != nullptr && myState != GameParticipant::State::DISCONNECTING)
+	if (clientLink != nullptr && myState != GameParticipant::State::DISCONNECTING && !awaitingSnapshot)
 		clientLink->SendData(packet);
 }
 
@@ -34,6 +34,7 @@ void GameParticipant::Connected(std::shared_ptr<netcode::CConnection> _link, boo
 	aiClientLinks[MAX_AIS].link.reset(new netcode::CLoopbackConnection());
 
 	isLocal = local;
+	awaitingSnapshot = false;
 	myState = CONNECTED;
 	lastFrameResponse = 0;
 }
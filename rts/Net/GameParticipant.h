@@ -47,6 +47,8 @@ public:
 	bool isLocal = false;
 	bool isReconn = false;
 	bool isMidgameJoin = false;
+	/// joined a running game and waits for a game-state snapshot, receives nothing meanwhile
+	bool awaitingSnapshot = false;
 
 	PlayerStatistics lastStats;
 
@@ -4,6 +4,7 @@
 #include "System/Net/UDPConnection.h"
 
 #include <functional>
+#include <limits>
 
 #if defined DEDICATED || defined DEBUG
 	#include <iostream>
@@ -72,10 +73,13 @@ CONFIG(int, SpeedControl).defaultValue(1).minimumValue(1).maximumValue(2)
 	.description("Sets how server adjusts speed according to player's load (CPU), 1: use average, 2: use highest");
 CONFIG(bool, AllowSpectatorJoin).defaultValue(true).dedicatedValue(false).description("allow any unauthenticated clients to join as spectator with any name, name will be prefixed with ~");
 CONFIG(bool, WhiteListAdditionalPlayers).defaultValue(true);
+CONFIG(bool, RejoinFromSnapshot).defaultValue(false).description("Players joining a running game load a game-state snapshot taken by another client instead of replaying the game from the start. Relies on the savegame code.");
 CONFIG(bool, ServerRecordDemos).defaultValue(false).dedicatedValue(true);
 CONFIG(bool, ServerLogInfoMessages).defaultValue(false);
 CONFIG(bool, ServerLogDebugMessages).defaultValue(false);
 CONFIG(std::string, AutohostIP).defaultValue("127.0.0.1");
+CONFIG(int, AutohostTelemetryInterval).defaultValue(0).minimumValue(0).description("Send the server's frame-telemetry records to the autohost every N server frames. 0 = off.");
+CONFIG(int, AutohostStatusInterval).defaultValue(0).minimumValue(0).description("Send game progress, player CPU/ping, team statistics and lag-protection decisions to the autohost every N milliseconds. 0 = off.");
 
 
 // use the specific section for all LOG*() calls in this source file
@@ -110,6 +114,13 @@ static constexpr unsigned gameProgressFrameInterval = GAME_SPEED * 5;
 
 static constexpr unsigned syncResponseEchoInterval = GAME_SPEED * 2;
 
+/// rejoining a game younger than this replays it, older ones use a game-state snapshot
+static constexpr int snapshotMinFrames = GAME_SPEED * 60 * 2;
+/// a snapshot is reused for further rejoins while the replay tail stays this short
+static constexpr int snapshotMaxAge = GAME_SPEED * 60;
+/// waiting players fall back to the full replay if no snapshot arrived by then
+static const spring_time snapshotTimeout = spring_secs(60);
+
 
 //FIXME remodularize server commands, so they get registered in word completion etc.
 decltype(CGameServer::commandBlacklist) CGameServer::commandBlacklist{
@@ -160,9 +171,17 @@ void CGameServer::Initialize()
 	// configs
 	curSpeedCtrl = configHandler->GetInt("SpeedControl");
 	allowSpecJoin = configHandler->GetBool("AllowSpectatorJoin") || myGameSetup->onlyLocal; ///!!! mantis #4418
+	rejoinFromSnapshot = configHandler->GetBool("RejoinFromSnapshot");
 	whiteListAdditionalPlayers = configHandler->GetBool("WhiteListAdditionalPlayers");
 	logInfoMessages = configHandler->GetBool("ServerLogInfoMessages");
 	logDebugMessages = configHandler->GetBool("ServerLogDebugMessages");
+	autohostTelemetryInterval = configHandler->GetInt("AutohostTelemetryInterval");
+	autohostStatusInterval = configHandler->GetInt("AutohostStatusInterval");
+
+	telemetry.SetCounterName(0, "players");
+	telemetry.SetCounterName(1, "framesBehind");
+	telemetry.SetCounterName(2, "newFrames");
+	telemetry.SetCounterName(3, "speedPct");
 
 	rng.Seed((myGameData->GetSetupText()).length());
 
@@ -737,6 +756,9 @@ void CGameServer::CheckSync()
 						Broadcast(CBaseNetProtocol::Get().SendGameStateDump(syncErrorFrame));
 					}
 					desyncHasOccurred = true;
+
+					if (const std::string path = telemetry.Dump("desync"); !path.empty())
+						LOG("Server frame telemetry written to \"%s\"", path.c_str());
 				}
 
 				#ifndef DEDICATED
@@ -844,6 +866,16 @@ void CGameServer::Update()
 	else if (!PreSimFrame() || demoReader != nullptr)
 		CreateNewFrame(true, false);
 
+	if (gameStateSnapshot.donor >= 0) {
+		if (players[gameStateSnapshot.donor].myState != GameParticipant::INGAME)
+			AbortGameStateSnapshot("snapshot provider left");
+		else if ((spring_gettime() - gameStateSnapshot.requestTime) > snapshotTimeout)
+			AbortGameStateSnapshot("timed out");
+	}
+
+	if (hostif != nullptr && autohostStatusInterval > 0 && (spring_gettime() - lastAutohostStatus) >= spring_msecs(autohostStatusInterval))
+		SendAutohostStatus();
+
 	if (hostif != nullptr) {
 		const std::string msg = hostif->GetChatMessage();
 
@@ -925,6 +957,8 @@ void CGameServer::LagProtection()
 		refCpuUsage = medianCpu;
 	}
 
+	const float oldSpeed = internalSpeed;
+
 	// adjust game speed
 	if (refCpuUsage > 0.0f && !isPaused) {
 		//userSpeedFactor holds the wanted speed adjusted manually by user ( normally 1)
@@ -964,6 +998,49 @@ void CGameServer::LagProtection()
 		if (newSpeed != internalSpeed)
 			InternalSpeedChange(newSpeed);
 	}
+
+	if (hostif != nullptr && autohostStatusInterval > 0)
+		hostif->SendSpeedControl(curSpeedCtrl, refCpuUsage, medianCpu, medianPing, oldSpeed, internalSpeed);
+}
+
+
+void CGameServer::SendAutohostStatus()
+{
+	lastAutohostStatus = spring_gettime();
+
+	hostif->SendGameFrame(serverFrameNum, internalSpeed, userSpeedFactor, isPaused);
+
+	if (!gameHasStarted)
+		return;
+
+	std::vector<AutohostInterface::PlayerStatus> status;
+	status.reserve(players.size());
+
+	for (const GameParticipant& p: players) {
+		if (p.myState != GameParticipant::INGAME)
+			continue;
+
+		AutohostInterface::PlayerStatus& ps = status.emplace_back();
+		ps.playerNum = p.id;
+		ps.spectator = p.spectator;
+		ps.cpuUsage = p.cpuUsage;
+		ps.ping = ((serverFrameNum - p.lastFrameResponse) * 1000) / (GAME_SPEED * internalSpeed);
+	}
+
+	// one byte holds the count, MAX_PLAYERS is larger
+	status.resize(std::min(status.size(), size_t(std::numeric_limits<uint8_t>::max())));
+	hostif->SendPlayerStatus(status);
+
+	// the server does not simulate, one client reports for all teams; its
+	// NETMSG_TEAMSTAT answers are forwarded as GAME_TEAMSTAT events
+	const int reporter = GetReferenceClient();
+
+	if (reporter < 0)
+		return;
+
+	for (size_t teamNum = 0; teamNum < teams.size(); teamNum++) {
+		players[reporter].SendData(CBaseNetProtocol::Get().SendRequestTeamStat(teamNum, 0));
+	}
 }
 
 
@@ -1848,6 +1925,9 @@ void CGameServer::ProcessPacket(const unsigned playerNum, std::shared_ptr<const
 			LOG("Server broadcast game state collection request.");
 			Broadcast(packet);
 			break;
+		case NETMSG_GAMESTATE_SNAPSHOT:
+			RecvGameStateSnapshot(a, packet);
+			break;
 		// CGameServer should never get these messages
 		//case NETMSG_GAMEID:
 		//case NETMSG_INTERNAL_SPEED:
@@ -2685,7 +2765,67 @@ void CGameServer::CreateNewFrame(bool fromServerThread, bool fixedFrameTime)
 			outstandingSyncFrames.insert(serverFrameNum);
 		#endif
 		}
+
+		if (numNewFrames > 0)
+			UpdateTelemetry(numNewFrames);
+	}
+}
+
+
+void CGameServer::UpdateTelemetry(unsigned int numNewFrames)
+{
+	const spring_time curTime = spring_gettime();
+
+	CFrameTelemetry::Record record;
+
+	unsigned int netBytesIn = 0;
+	unsigned int netBytesOut = 0;
+
+	record.frameNum = serverFrameNum;
+	record.frameTimeMs = spring_istime(lastTelemetryTime)? (curTime - lastTelemetryTime).toMilliSecsf(): 0.0f;
+
+	for (const GameParticipant& p: players) {
+		if (p.myState != GameParticipant::INGAME)
+			continue;
+
+		record.counters[0] += 1;
+		record.counters[1] = std::max(record.counters[1], static_cast<uint32_t>(std::max(serverFrameNum - p.lastFrameResponse, 0)));
+
+		if (p.clientLink == nullptr)
+			continue;
+
+		netBytesIn += p.clientLink->GetDataReceived();
+		netBytesOut += p.clientLink->GetDataSent();
 	}
+
+	record.counters[2] = numNewFrames;
+	record.counters[3] = internalSpeed * 100.0f;
+
+	// links come and go, totals can shrink
+	record.netBytesIn = (netBytesIn >= telemetryNetBytesIn)? (netBytesIn - telemetryNetBytesIn): 0;
+	record.netBytesOut = (netBytesOut >= telemetryNetBytesOut)? (netBytesOut - telemetryNetBytesOut): 0;
+
+	telemetryNetBytesIn = netBytesIn;
+	telemetryNetBytesOut = netBytesOut;
+	lastTelemetryTime = curTime;
+
+	telemetry.Push(record);
+
+	numUnsentTelemetry += 1;
+
+	if (hostif == nullptr || autohostTelemetryInterval <= 0)
+		return;
+	if ((serverFrameNum - lastAutohostTelemetryFrame) < autohostTelemetryInterval)
+		return;
+
+	// keep each event well below the maximum UDP datagram size
+	std::array<CFrameTelemetry::Record, 128> records;
+
+	const size_t numRecords = telemetry.GetRecent(records.data(), std::min(records.size(), numUnsentTelemetry));
+
+	hostif->SendTelemetry(reinterpret_cast<const uint8_t*>(records.data()), numRecords, sizeof(CFrameTelemetry::Record));
+	lastAutohostTelemetryFrame = serverFrameNum;
+	numUnsentTelemetry = 0;
 }
 
 
@@ -2717,8 +2857,17 @@ void CGameServer::UpdateLoop()
 		Threading::SetThreadName("netcode");
 		Threading::SetAffinity(~0);
 
+		spring_time loopStartTime = spring_gettime();
+
 		while (!quitServer) {
-			spring_msecs(loopSleepTime).sleep(true);
+			// only sleep for what is left of the tick, such that time spent on
+			// a burst of traffic does not also delay the next CreateNewFrame
+			const spring_time loopWorkTime = spring_gettime() - loopStartTime;
+
+			if (loopWorkTime < spring_msecs(loopSleepTime))
+				(spring_msecs(loopSleepTime) - loopWorkTime).sleep(true);
+
+			loopStartTime = spring_gettime();
 
 			if (udpListener != nullptr)
 				udpListener->Update();
@@ -3023,7 +3172,10 @@ unsigned CGameServer::BindConnection(
 
 	newPlayer.Connected(clientLink, isLocal);
 	newPlayer.SendData(std::shared_ptr<const RawPacket>(myGameData->Pack()));
-	newPlayer.SendData(CBaseNetProtocol::Get().SendSetPlayerNum((unsigned char)newPlayerNumber));
+
+	// the player number follows the snapshot, see SendGameStateSnapshot
+	if (!(newPlayer.awaitingSnapshot = UseGameStateSnapshot()))
+		newPlayer.SendData(CBaseNetProtocol::Get().SendSetPlayerNum((unsigned char)newPlayerNumber));
 
 	// after gamedata and playerNum, the player can start loading
 	if (demoReader == nullptr || myGameSetup->demoName.empty()) {
@@ -3042,8 +3194,12 @@ unsigned CGameServer::BindConnection(
 	}
 
 	// finally send player all packets he missed until now
-	for (const std::shared_ptr<const netcode::RawPacket>& p: packetCache)
-		newPlayer.SendData(p);
+	if (!newPlayer.awaitingSnapshot) {
+		for (const std::shared_ptr<const netcode::RawPacket>& p: packetCache)
+			newPlayer.SendData(p);
+	} else if (gameStateSnapshot.complete) {
+		SendGameStateSnapshot(newPlayer);
+	}
 
 	// new connection established
 	Message(spring::format(" -> Connection established (given id %i)", newPlayerNumber));
@@ -3053,6 +3209,191 @@ unsigned CGameServer::BindConnection(
 }
 
 
+bool CGameServer::UseGameStateSnapshot()
+{
+	if (!rejoinFromSnapshot || !gameHasStarted || demoReader != nullptr)
+		return false;
+	// packetCache is not kept
+	if (!canReconnect && !allowSpecJoin)
+		return false;
+	// replaying a short game is fast enough
+	if (serverFrameNum < snapshotMinFrames)
+		return false;
+
+	if (gameStateSnapshot.donor >= 0)
+		return true;
+	if (gameStateSnapshot.complete && (serverFrameNum - gameStateSnapshot.frameNum) < snapshotMaxAge)
+		return true;
+
+	return (RequestGameStateSnapshot());
+}
+
+int CGameServer::GetReferenceClient() const
+{
+	int client = -1;
+
+	for (const GameParticipant& p: players) {
+		if (p.isFromDemo || p.myState != GameParticipant::INGAME)
+			continue;
+
+		// extra work stalls the client, prefer spectators; then whoever is most up to date
+		if (client >= 0) {
+			const GameParticipant& c = players[client];
+
+			if (c.spectator && !p.spectator)
+				continue;
+			if (c.spectator == p.spectator && c.lastFrameResponse >= p.lastFrameResponse)
+				continue;
+		}
+
+		client = p.id;
+	}
+
+	return client;
+}
+
+bool CGameServer::RequestGameStateSnapshot()
+{
+	const int donor = GetReferenceClient();
+
+	if (donor < 0)
+		return false;
+
+	const int requestID = gameStateSnapshot.requestID + 1;
+
+	gameStateSnapshot = {};
+	gameStateSnapshot.requestID = requestID;
+	gameStateSnapshot.donor = donor;
+	// the request reaches the donor after every packet cached so far
+	gameStateSnapshot.cacheIndex = packetCache.size();
+	gameStateSnapshot.requestTime = spring_gettime();
+
+	players[donor].SendData(CBaseNetProtocol::Get().SendGameStateSnapshotRequest(requestID));
+
+	Message(spring::format(" -> requesting game-state snapshot from %s %s", players[donor].GetType(), players[donor].name.c_str()), false);
+	return true;
+}
+
+void CGameServer::RecvGameStateSnapshot(const unsigned playerNum, std::shared_ptr<const netcode::RawPacket> packet)
+{
+	constexpr uint32_t headerSize = sizeof(uint8_t) + sizeof(uint16_t) + sizeof(uint8_t) + sizeof(int32_t) * 2 + sizeof(uint32_t) * 3;
+
+	try {
+		netcode::UnpackPacket pckt(packet, sizeof(uint8_t) + sizeof(uint16_t));
+
+		uint8_t senderNum;
+		int32_t requestID;
+		int32_t frameNum;
+		uint32_t checksum;
+		uint32_t totalSize;
+		uint32_t offset;
+
+		pckt >> senderNum;
+		pckt >> requestID;
+		pckt >> frameNum;
+		pckt >> checksum;
+		pckt >> totalSize;
+		pckt >> offset;
+
+		if (senderNum != playerNum) {
+			Message(spring::format(WrongPlayer, NETMSG_GAMESTATE_SNAPSHOT, playerNum, (unsigned)senderNum));
+			return;
+		}
+
+		GameStateSnapshot& gss = gameStateSnapshot;
+
+		// answer to an earlier request, or to one that was aborted
+		if (int(playerNum) != gss.donor || requestID != gss.requestID)
+			return;
+
+		if (totalSize == 0) {
+			AbortGameStateSnapshot("snapshot provider could not create one");
+			return;
+		}
+
+		const uint32_t chunkSize = packet->length - headerSize;
+
+		if (offset != gss.numBytes || (gss.numBytes + chunkSize) > totalSize) {
+			AbortGameStateSnapshot("invalid snapshot chunk");
+			return;
+		}
+
+		gss.checksum.Update(packet->data + headerSize, chunkSize);
+		gss.chunks.push_back(packet);
+		gss.numBytes += chunkSize;
+		gss.frameNum = frameNum;
+
+		if (gss.numBytes < totalSize)
+			return;
+
+		if (gss.checksum.GetDigest() != checksum) {
+			AbortGameStateSnapshot("snapshot checksum mismatch");
+			return;
+		}
+
+		gss.complete = true;
+		gss.donor = -1;
+
+		Message(spring::format(" -> received game-state snapshot for frame %d (%u bytes, %dms)", frameNum, totalSize, int((spring_gettime() - gss.requestTime).toMilliSecsi())), false);
+
+		for (GameParticipant& p: players) {
+			if (p.awaitingSnapshot)
+				SendGameStateSnapshot(p);
+		}
+	} catch (const netcode::UnpackPacketException& ex) {
+		Message(spring::format("[GameServer::%s][NETMSG_GAMESTATE_SNAPSHOT] exception \"%s\" from player \"%s\"", __func__, ex.what(), players[playerNum].name.c_str()));
+	}
+}
+
+void CGameServer::SendGameStateSnapshot(GameParticipant& p)
+{
+	assert(gameStateSnapshot.complete);
+	p.awaitingSnapshot = false;
+
+	for (const std::shared_ptr<const netcode::RawPacket>& chunk: gameStateSnapshot.chunks)
+		p.SendData(chunk);
+
+	p.SendData(CBaseNetProtocol::Get().SendSetPlayerNum((unsigned char)p.id));
+
+	// state changed by packets before the snapshot is part of it, except for these
+	for (size_t i = 0; i < gameStateSnapshot.cacheIndex; i++) {
+		switch (packetCache[i]->data[0]) {
+			case NETMSG_GAMEID:
+			case NETMSG_STARTPLAYING: {
+				p.SendData(packetCache[i]);
+			} break;
+			default: {
+			} break;
+		}
+	}
+
+	for (size_t i = gameStateSnapshot.cacheIndex; i < packetCache.size(); i++)
+		p.SendData(packetCache[i]);
+
+	Message(spring::format(" -> sent game-state snapshot to %s (skipped %u cached packets)", p.name.c_str(), unsigned(gameStateSnapshot.cacheIndex)), false);
+}
+
+void CGameServer::AbortGameStateSnapshot(const char* reason)
+{
+	Message(spring::format(" -> game-state snapshot failed (%s), using full replay", reason), false);
+
+	gameStateSnapshot.chunks.clear();
+	gameStateSnapshot.donor = -1;
+	gameStateSnapshot.complete = false;
+
+	for (GameParticipant& p: players) {
+		if (!p.awaitingSnapshot)
+			continue;
+
+		p.awaitingSnapshot = false;
+		p.SendData(CBaseNetProtocol::Get().SendSetPlayerNum((unsigned char)p.id));
+
+		for (const std::shared_ptr<const netcode::RawPacket>& pkt: packetCache)
+			p.SendData(pkt);
+	}
+}
+
+
 void CGameServer::GotChatMessage(const ChatMessage& msg)
 {
 	// silently drop empty chat messages
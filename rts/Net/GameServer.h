@@ -17,7 +17,9 @@
 #include "Game/GameData.h"
 #include "Sim/Misc/GlobalConstants.h"
 #include "Sim/Misc/TeamBase.h"
+#include "System/CRC.h"
 #include "System/float3.h"
+#include "System/FrameTelemetry.h"
 #include "System/GlobalRNG.h"
 #include "System/Misc/SpringTime.h"
 #include "System/Threading/SpringThreading.h"
@@ -165,6 +167,12 @@ private:
 	void ServerReadNet();
 
 	void LagProtection();
+	void UpdateTelemetry(unsigned int numNewFrames);
+	/// periodic SERVER_FRAME, PLAYER_STATUS and GAME_TEAMSTAT autohost events
+	void SendAutohostStatus();
+
+	/// the ingame client best suited to do extra work for the server, -1 if none
+	int GetReferenceClient() const;
 
 	/** @brief Generate a unique game identifier and send it to all clients. */
 	void GenerateAndSendGameID();
@@ -175,6 +183,22 @@ private:
 
 	void Broadcast(std::shared_ptr<const netcode::RawPacket> packet);
 
+	/**
+	 * @brief rejoin fast-path
+	 *
+	 * Instead of the whole packetCache, players joining a running game get a
+	 * game-state snapshot taken by another client plus the packets that were
+	 * cached after it was requested. Returns false if the full replay has to
+	 * be used, otherwise the player waits in BindConnection until a snapshot
+	 * is available (a recent one is reused).
+	 */
+	bool UseGameStateSnapshot();
+	bool RequestGameStateSnapshot();
+	void RecvGameStateSnapshot(const unsigned playerNum, std::shared_ptr<const netcode::RawPacket> packet);
+	void SendGameStateSnapshot(GameParticipant& p);
+	/// drops the pending snapshot, waiting players fall back to the full replay
+	void AbortGameStateSnapshot(const char* reason);
+
 	/**
 	 * @brief skip frames
 	 *
@@ -223,6 +247,28 @@ private:
 
 	std::deque< std::shared_ptr<const netcode::RawPacket> > packetCache;
 
+	struct GameStateSnapshot {
+		/// NETMSG_GAMESTATE_SNAPSHOT chunks as received from the donor
+		std::vector< std::shared_ptr<const netcode::RawPacket> > chunks;
+
+		/// packetCache size when requested, the snapshot includes everything before
+		size_t cacheIndex = 0;
+
+		spring_time requestTime = spring_notime;
+
+		int requestID = 0;
+		int frameNum = -1;
+		/// player taking the snapshot, -1 if no request is pending
+		int donor = -1;
+
+		uint32_t numBytes = 0;
+		CRC checksum;
+
+		bool complete = false;
+	};
+
+	GameStateSnapshot gameStateSnapshot;
+
 	/////////////////// sync stuff ///////////////////
 #ifdef SYNCCHECK
 	std::set<int> outstandingSyncFrames;
@@ -276,11 +322,31 @@ private:
 	bool canReconnect = false;
 	bool allowSpecDraw = true;
 	bool allowSpecJoin = false;
+	bool rejoinFromSnapshot = false;
 	bool whiteListAdditionalPlayers = false;
 
 	bool logInfoMessages = false;
 	bool logDebugMessages = false;
 
+	/// one record per tick that created frames, dumped on desync and crash
+	CFrameTelemetry telemetry = {"server"};
+
+	spring_time lastTelemetryTime = spring_notime;
+
+	unsigned int telemetryNetBytesIn = 0;
+	unsigned int telemetryNetBytesOut = 0;
+
+	/// server frames between two SERVER_TELEMETRY autohost events, 0 if disabled
+	int autohostTelemetryInterval = 0;
+	int lastAutohostTelemetryFrame = 0;
+
+	size_t numUnsentTelemetry = 0;
+
+	/// milliseconds between two autohost status updates, 0 if disabled
+	int autohostStatusInterval = 0;
+
+	spring_time lastAutohostStatus = spring_notime;
+
 
 	/// If the server receives a command, it will forward it to clients if it is not in this set
 	static std::array<std::string, 26> commandBlacklist;
@@ -29,10 +29,12 @@
 #include "Sim/Units/UnitHandler.h"
 #include "System/Config/ConfigHandler.h"
 #include "System/EventHandler.h"
+#include "System/CRC.h"
 #include "System/GlobalConfig.h"
 #include "System/Log/ILog.h"
 #include "System/SpringMath.h"
 #include "System/TimeProfiler.h"
+#include "System/LoadSave/CregLoadSaveHandler.h"
 #include "System/LoadSave/DemoRecorder.h"
 #include "System/Net/UnpackPacket.h"
 #include "System/Sound/ISound.h"
@@ -223,7 +225,7 @@ void CGame::UpdateNetMessageProcessingTimeLeft()
 		const spring_time deltaReadNetTime = currentReadNetTime - lastReadNetTime;
 
 		if (skipping) {
-			msgProcTimeLeft = 10.0f;
+			msgProcTimeLeft = (skipEndFrame - gs->frameNum + 1) * 1000.0f;
 		} else {
 			// at <N> Hz we should consume one simframe message every (1000/N) ms
 			//
@@ -235,6 +237,9 @@ void CGame::UpdateNetMessageProcessingTimeLeft()
 		}
 
 		lastReadNetTime = currentReadNetTime;
+	} else if (skipping) {
+		// nothing is drawn while fast-forwarding, consume every remaining frame
+		msgProcTimeLeft = (skipEndFrame - gs->frameNum + 1) * 1000.0f;
 	} else {
 		// ensure ClientReadNet returns at least every 15 simframes
 		// so CGame can process keyboard input, and render etc.
@@ -253,6 +258,10 @@ float CGame::GetNetMessageProcessingTimeLimit() const
 	const float minDrawFPS   =         globalConfig.minSimDrawBalance  * 1000.0f / std::max(0.01f, gu->avgDrawFrameTime);
 	const float simDrawRatio = maxSimFPS / minDrawFPS;
 
+	// fast-forwarding only returns for input and the 2Hz progress reports
+	if (skipping)
+		return 500.0f;
+
 	return std::clamp(simDrawRatio * gu->avgSimFrameTime, 5.0f, 1000.0f / globalConfig.minDrawFPS);
 }
 
@@ -1094,7 +1103,7 @@ void CGame::ClientReadNet()
 						unit->ChangeTeam(dstTeamID, CUnit::ChangeGiven);
 					}
 
-					netSelUnits.clear();
+					selectedUnitsHandler.ClearNetSelect(playerNum);
 				}
 
 				AddTraffic(playerNum, packetCode, dataLength);
@@ -1255,7 +1264,19 @@ void CGame::ClientReadNet()
 			} break;
 
 			case NETMSG_TEAMSTAT: { /* LadderBot (dedicated client) only */ } break;
-			case NETMSG_REQUEST_TEAMSTAT: { /* LadderBot (dedicated client) only */ } break;
+			case NETMSG_REQUEST_TEAMSTAT: {
+				ZoneScopedN("Net::RequestTeamStat");
+				// sent by the server for its autohost, statFrameNum is not used; the
+				// answer is the team's current (cumulative) statistics entry
+				const uint8_t teamNum = inbuf[1];
+
+				if (!teamHandler.IsValidTeam(teamNum)) {
+					LOG_L(L_ERROR, "[Game::%s][NETMSG_REQUEST_TEAMSTAT] invalid team-number %i", __func__, teamNum);
+					break;
+				}
+
+				clientNet->Send(CBaseNetProtocol::Get().SendTeamStat(teamNum, teamHandler.Team(teamNum)->GetCurrentStats()));
+			} break;
 
 
 			case NETMSG_AI_CREATED: {
@@ -1578,9 +1599,39 @@ void CGame::ClientReadNet()
 				LOG("Collecting current game state information.");
 				const uint32_t desyncFrameNum = *reinterpret_cast<const uint32_t*>(inbuf + 1);
 				DumpState(gs->frameNum, gs->frameNum, 1, true, desyncFrameNum, true);
+
+				if (const std::string path = telemetry.Dump("desync"); !path.empty())
+					LOG("Frame telemetry written to \"%s\"", path.c_str());
 				break;
 			}
 
+			case NETMSG_GAMESTATE_SNAPSHOT_REQUEST: {
+				ZoneScopedN("Net::GamestateSnapshotRequest");
+				// the server wants our state for a player joining mid-game; all packets
+				// before the request have been processed, the state is what it expects
+				const int32_t requestID = *reinterpret_cast<const int32_t*>(inbuf + 1);
+				const spring_time startTime = spring_gettime();
+
+				CCregLoadSaveHandler handler;
+
+				const std::vector<uint8_t> snapshot = handler.SaveSnapshot();
+				const uint32_t checksum = CRC::CalcDigest(snapshot.data(), snapshot.size());
+
+				// leaves room for the header, an empty snapshot tells the server we failed
+				constexpr uint32_t maxChunkSize = 60000;
+				uint32_t offset = 0;
+
+				do {
+					const uint32_t chunkSize = std::min(maxChunkSize, uint32_t(snapshot.size()) - offset);
+
+					clientNet->Send(CBaseNetProtocol::Get().SendGameStateSnapshot(gu->myPlayerNum, requestID, gs->frameNum, checksum, snapshot.size(), offset, snapshot.data() + offset, chunkSize));
+					offset += chunkSize;
+				} while (offset < snapshot.size());
+
+				LOG("[Game::%s] sent game-state snapshot for frame %d (%u bytes, %dms)", __func__, gs->frameNum, uint32_t(snapshot.size()), int((spring_gettime() - startTime).toMilliSecsi()));
+				AddTraffic(-1, packetCode, dataLength);
+			} break;
+
 			default: {
 #ifdef SYNCDEBUG
 				if (!CSyncDebugger::GetInstance()->ClientReceived(inbuf))
@@ -308,6 +308,13 @@ PacketType CBaseNetProtocol::SendTeamStat(uint8_t teamNum, const TeamStatistics&
 	return PacketType(packet);
 }
 
+PacketType CBaseNetProtocol::SendRequestTeamStat(uint8_t teamNum, uint16_t statFrameNum)
+{
+	PackPacket* packet = new PackPacket(sizeof(uint8_t) + sizeof(teamNum) + sizeof(statFrameNum), NETMSG_REQUEST_TEAMSTAT);
+	*packet << teamNum << statFrameNum;
+	return PacketType(packet);
+}
+
 
 
 PacketType CBaseNetProtocol::SendGameOver(uint8_t playerNum, const std::vector<uint8_t>& winningAllyTeams)
@@ -612,6 +619,28 @@ PacketType CBaseNetProtocol::SendGameStateDump(uint32_t frameNum)
 	return PacketType(packet);
 }
 
+PacketType CBaseNetProtocol::SendGameStateSnapshotRequest(int32_t requestID)
+{
+	PackPacket* packet = new PackPacket(sizeof(uint8_t) + sizeof(requestID), NETMSG_GAMESTATE_SNAPSHOT_REQUEST);
+	*packet << requestID;
+	return PacketType(packet);
+}
+
+PacketType CBaseNetProtocol::SendGameStateSnapshot(uint8_t playerNum, int32_t requestID, int32_t frameNum, uint32_t checksum, uint32_t totalSize, uint32_t offset, const uint8_t* data, uint32_t size)
+{
+	const uint32_t payloadSize = sizeof(playerNum) + sizeof(requestID) + sizeof(frameNum) + sizeof(checksum) + sizeof(totalSize) + sizeof(offset) + size;
+	const uint32_t headerSize = sizeof(uint8_t) + sizeof(uint16_t);
+	const uint32_t packetSize = headerSize + payloadSize;
+
+	if (packetSize >= (1 << (sizeof(uint16_t) * 8)))
+		throw netcode::PackPacketException("[BaseNetProto::SendGameStateSnapshot] maximum packet-size exceeded");
+
+	PackPacket* packet = new PackPacket(packetSize, NETMSG_GAMESTATE_SNAPSHOT);
+	*packet << static_cast<uint16_t>(packetSize) << playerNum << requestID << frameNum << checksum << totalSize << offset;
+	*packet << std::vector<uint8_t>(data, data + size);
+	return PacketType(packet);
+}
+
 CBaseNetProtocol::CBaseNetProtocol()
 {
 	netcode::ProtocolDef* proto = netcode::ProtocolDef::GetInstance();
@@ -672,6 +701,8 @@ CBaseNetProtocol::CBaseNetProtocol()
 	proto->AddType(NETMSG_AI_STATE_CHANGED, 4);
 	proto->AddType(NETMSG_GAME_FRAME_PROGRESS, 5);
 	proto->AddType(NETMSG_PING, 1 + (1 + 1 + 4));
+	proto->AddType(NETMSG_GAMESTATE_SNAPSHOT_REQUEST, 1 + sizeof(int32_t));
+	proto->AddType(NETMSG_GAMESTATE_SNAPSHOT, -2);
 
 #ifdef SYNCDEBUG
 	proto->AddType(NETMSG_SD_CHKREQUEST, 5);
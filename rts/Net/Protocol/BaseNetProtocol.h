@@ -85,6 +85,7 @@ public:
 
 	PacketType SendPlayerStat(uint8_t playerNum, const PlayerStatistics& currentStats);
 	PacketType SendTeamStat(uint8_t teamNum, const TeamStatistics& currentStats);
+	PacketType SendRequestTeamStat(uint8_t teamNum, uint16_t statFrameNum);
 
 	PacketType SendGiveAwayEverything(uint8_t playerNum, uint8_t giveToTeam);
 	/**
@@ -120,6 +121,14 @@ public:
 
 	PacketType SendGameStateDump(uint32_t frameNum);
 
+	PacketType SendGameStateSnapshotRequest(int32_t requestID);
+	/**
+	 * One chunk of a compressed game-state snapshot; totalSize and checksum
+	 * (CRC32) refer to the complete snapshot, a totalSize of 0 means the
+	 * sender could not create one.
+	 */
+	PacketType SendGameStateSnapshot(uint8_t playerNum, int32_t requestID, int32_t frameNum, uint32_t checksum, uint32_t totalSize, uint32_t offset, const uint8_t* data, uint32_t size);
+
 private:
 	CBaseNetProtocol();
 
@@ -96,6 +96,9 @@ enum NETMSG {
 
 	NETMSG_PING = 78, // uint8_t playerNum, uint8_t pingTag, float localTime
 
+	NETMSG_GAMESTATE_SNAPSHOT_REQUEST = 79, // int32_t requestID # server asks one client for a snapshot to hand to rejoining clients #
+	NETMSG_GAMESTATE_SNAPSHOT         = 80, // uint16_t messageSize, uint8_t playerNum, int32_t requestID, int32_t frameNum, uint32_t checksum, uint32_t totalSize, uint32_t offset, std::vector<uint8_t> data
+
 	NETMSG_LAST //max types of netmessages, internal only
 };
 
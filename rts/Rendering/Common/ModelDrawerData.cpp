@@ -1,3 +1,4 @@
 #include "ModelDrawerData.h"
 
-CONFIG(int, UnitLodDist).defaultValue(1000).headlessValue(0).deprecated(true);
\ No newline at end of file
+CONFIG(int, UnitLodDist).defaultValue(1000).headlessValue(0).deprecated(true);
+CONFIG(bool, TerrainOcclusionCulling).defaultValue(false).headlessValue(false).description("Skip drawing features and buildings if the terrain fully hides them from the player camera.");
@@ -34,9 +34,35 @@ public:
 public:
 	bool GetFullRead() const override { return true; }
 	int  GetReadAllyTeam() const override { return AllAccessTeam; }
+	bool CanReadAllyTeam(int allyTeam) const override { return true; }
+protected:
+	// selects the cameras UpdateObjectDrawFlags tests objects against; the
+	// water and shadow state can not change during an Update, so this is done
+	// once up front rather than per object
+	void UpdateDrawFlagCamTypes() {
+		numDrawFlagCamTypes = 0;
+
+		for (uint32_t camType = CCamera::CAMTYPE_PLAYER; camType < CCamera::CAMTYPE_ENVMAP; ++camType) {
+			if (camType == CCamera::CAMTYPE_UWREFL && !IWater::GetWater()->CanDrawReflectionPass())
+				continue;
+
+			if (camType == CCamera::CAMTYPE_SHADOW && ((shadowHandler.shadowGenBits & CShadowHandler::SHADOWGEN_BIT_MODEL) == 0))
+				continue;
+
+			drawFlagCamTypes[numDrawFlagCamTypes++] = camType;
+		}
+
+		terrainOcclusion = configHandler->GetBool("TerrainOcclusionCulling");
+	}
 protected:
 	static constexpr int MT_CHUNK_OR_MIN_CHUNK_SIZE_SMMA = 128;
 	static constexpr int MT_CHUNK_OR_MIN_CHUNK_SIZE_UPDT = 256;
+
+	// in CAMTYPE order, the player camera (if any) always comes first
+	std::array<uint32_t, CCamera::CAMTYPE_ENVMAP> drawFlagCamTypes = {};
+	uint32_t numDrawFlagCamTypes = 0;
+
+	bool terrainOcclusion = false;
 };
 
 
@@ -168,12 +194,15 @@ inline void CModelDrawerDataBase<T>::UpdateObjectTrasform(const T* o)
 
 	ScopedTransformMemAlloc& stma = GetObjectTransformMemAlloc(o);
 
+	// one lock for all of the object's transforms rather than one per element
+	auto lock = CModelsLock::GetScopedLock();
+
 	const auto& tmPrev = o->preFrameTra;
 	const auto  tmCurr = Transform::FromMatrix(o->GetTransformMatrix(true)); //synced transform
 
 	// conditionally update new and prev synced positions
-	stma.UpdateIfChanged(0, tmPrev);
-	stma.UpdateIfChanged(1, tmCurr);
+	stma.UpdateIfChangedUnlocked(0, tmPrev);
+	stma.UpdateIfChangedUnlocked(1, tmCurr);
 
 	for (int i = 0; i < o->localModel.pieces.size(); ++i) {
 		const LocalModelPiece& lmp = o->localModel.pieces[i];
@@ -184,14 +213,14 @@ inline void CModelDrawerDataBase<T>::UpdateObjectTrasform(const T* o)
 			continue;
 
 		if unlikely(!lmp.GetScriptVisible()) {
-			stma.UpdateForced(2 * (1 + i) + 0, Transform::Zero());
-			stma.UpdateForced(2 * (1 + i) + 1, Transform::Zero());
+			stma.UpdateForcedUnlocked(2 * (1 + i) + 0, Transform::Zero());
+			stma.UpdateForcedUnlocked(2 * (1 + i) + 1, Transform::Zero());
 			lmp.ResetWasUpdated();
 			continue;
 		}
 
-		stma.UpdateForced(2 * (1 + i) + 0, lmp.GetPrevModelSpaceTransform());
-		stma.UpdateForced(2 * (1 + i) + 1, lmpTransform);
+		stma.UpdateForcedUnlocked(2 * (1 + i) + 0, lmp.GetPrevModelSpaceTransform());
+		stma.UpdateForcedUnlocked(2 * (1 + i) + 1, lmpTransform);
 
 		lmp.ResetWasUpdated();
 	}
@@ -2,6 +2,7 @@
 #include "ModelDrawer.h"
 #include "System/float3.h"
 #include "Map/Ground.h"
+#include "Map/ReadMap.h"
 #include "Game/Camera.h"
 #include "Sim/Misc/TeamHandler.h"
 #include "Sim/Misc/Team.h"
@@ -37,6 +38,38 @@ bool CModelDrawerHelper::ObjectVisibleReflection(const float3& objPos, const flo
 #endif
 }
 
+bool CModelDrawerHelper::ObjectOccludedByTerrain(const float3& objPos, const float3& camPos, float maxRadius)
+{
+	RECOIL_DETAILED_TRACY_ZONE;
+	// coarse test of the line from the top of the bounding sphere to the camera
+	// against the (unsynced) heightmap; the margin keeps objects from popping
+	// in and out behind gentle ridges the sampling steps over
+	constexpr float stepSize = SQUARE_SIZE * 4.0f;
+	constexpr float hgtMargin = SQUARE_SIZE * 2.0f;
+
+	const float3 topPos = objPos + UpVector * maxRadius;
+	const float3 rayDir = camPos - topPos;
+	const float rayLen = rayDir.Length2D();
+
+	if (rayLen <= stepSize)
+		return false;
+
+	const float maxHeight = readMap->GetCurrMaxHeight();
+
+	for (float t = std::max(maxRadius, stepSize); t < rayLen; t += stepSize) {
+		const float3 rayPos = topPos + rayDir * (t / rayLen);
+
+		// nothing left that could block the camera
+		if (rayPos.y > maxHeight && camPos.y >= rayPos.y)
+			return false;
+
+		if (CGround::GetHeightReal(rayPos.x, rayPos.z, false) > (rayPos.y + hgtMargin))
+			return true;
+	}
+
+	return false;
+}
+
 void CModelDrawerHelper::EnableTexturesCommon()
 {
 	RECOIL_DETAILED_TRACY_ZONE;
@@ -33,6 +33,7 @@ public:
 public:
 	// Auxilary
 	static bool ObjectVisibleReflection(const float3& objPos, const float3& camPos, float maxRadius);
+	static bool ObjectOccludedByTerrain(const float3& objPos, const float3& camPos, float maxRadius);
 
 	static void EnableTexturesCommon();
 	static void DisableTexturesCommon();
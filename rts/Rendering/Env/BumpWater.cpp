@@ -43,6 +43,7 @@ using std::max;
 
 CONFIG(int, BumpWaterTexSizeReflection).defaultValue(512).headlessValue(32).minimumValue(32).description("Sets the size of the framebuffer texture used to store the reflection in Bumpmapped water.");
 CONFIG(int, BumpWaterReflection).defaultValue(1).headlessValue(0).minimumValue(0).maximumValue(2).description("Determines the amount of objects reflected in Bumpmapped water.\n0:=off, 1:=fast (skip terrain), 2:=full");
+CONFIG(int, BumpWaterReflectionRate).defaultValue(1).minimumValue(1).maximumValue(8).description("Renders the Bumpmapped water reflection only every Nth frame and reprojects the previous one in between.\n1:=every frame");
 CONFIG(int, BumpWaterRefraction).defaultValue(1).headlessValue(0).minimumValue(0).maximumValue(1).description("Determines the method of refraction with Bumpmapped water.\n0:=off, 1:=screencopy, 2:=own rendering cycle (disabled)");
 CONFIG(float, BumpWaterAnisotropy).defaultValue(0.0f).minimumValue(0.0f);
 CONFIG(bool, BumpWaterUseDepthTexture).defaultValue(true).headlessValue(false);
@@ -206,6 +207,9 @@ void CBumpWater::InitResources(bool loadShader)
 	// LOAD USER CONFIGS
 	reflTexSize  = std::bit_ceil <uint32_t> (configHandler->GetInt("BumpWaterTexSizeReflection"));
 	reflection   = configHandler->GetInt("BumpWaterReflection");
+	reflRate     = configHandler->GetInt("BumpWaterReflectionRate");
+	// (re)created FBO's have no reflection to reuse yet
+	nextReflDrawFrame = 0;
 	refraction   = configHandler->GetInt("BumpWaterRefraction");
 	anisotropy   = configHandler->GetFloat("BumpWaterAnisotropy");
 	depthCopy    = configHandler->GetBool("BumpWaterUseDepthTexture");
@@ -419,6 +423,7 @@ void CBumpWater::InitResources(bool loadShader)
 	if (shoreWaves)   definitions += "#define opt_shorewaves\n";
 	if (depthCopy)    definitions += "#define opt_depth\n";
 	if (blurRefl)     definitions += "#define opt_blurreflection\n";
+	if (reflection > 0 && reflRate > 1) definitions += "#define opt_reflection_reproject\n";
 	if (endlessOcean) definitions += "#define opt_endlessocean\n";
 
 	GLSLDefineConstf3(definitions, "MapMid",                    float3(mapDims.mapx * SQUARE_SIZE * 0.5f, 0.0f, mapDims.mapy * SQUARE_SIZE * 0.5f));
@@ -930,6 +935,9 @@ void CBumpWater::Draw()
 	waterShader->SetUniform("eyePos", camera->GetPos().x, camera->GetPos().y, camera->GetPos().z);
 	waterShader->SetUniform("frame", (gs->frameNum + globalRendering->timeOffset) / 15000.0f);
 
+	if (reflection > 0 && reflRate > 1)
+		waterShader->SetUniformMatrix4x4("reflectionViewProj", false, &reflViewProj.m[0]);
+
 	if (shadowHandler.ShadowsLoaded()) {
 		waterShader->SetUniformMatrix4x4("shadowMatrix", false, shadowHandler.GetShadowMatrixRaw());
 
@@ -1010,6 +1018,12 @@ void CBumpWater::DrawRefraction(const CGame* game)
 void CBumpWater::DrawReflection(const CGame* game)
 {
 	ZoneScopedN("BumpWater::DrawReflection");
+	// keep the previous reflection, Draw reprojects it with reflViewProj
+	if (globalRendering->drawFrame < nextReflDrawFrame)
+		return;
+
+	nextReflDrawFrame = globalRendering->drawFrame + reflRate;
+
 	reflectFBO.Bind();
 
 	const auto& sky = ISky::GetSky();
@@ -1024,6 +1038,10 @@ void CBumpWater::DrawReflection(const CGame* game)
 	CCamera* prvCam = CCameraHandler::GetSetActiveCamera(CCamera::CAMTYPE_UWREFL);
 	CCamera* curCam = CCameraHandler::GetActiveCamera();
 
+	// the reflected world-space position of any point on the water plane is the
+	// point itself, so the player camera also maps it into the reflection texture
+	reflViewProj = prvCam->GetViewProjectionMatrix();
+
 	{
 		curCam->CopyStateReflect(prvCam);
 		curCam->UpdateLoadViewport(0, 0, reflTexSize, reflTexSize);
@@ -9,6 +9,7 @@
 #include "IWater.h"
 
 #include "System/EventClient.h"
+#include "System/Matrix44f.h"
 #include "System/Misc/RectangleOverlapHandler.h"
 
 
@@ -71,6 +72,7 @@ private:
 	char  reflection;   ///< 0:=off, 1:=don't render the terrain, 2:=render everything+terrain
 	char  refraction;   ///< 0:=off, 1:=screencopy, 2:=own rendering cycle
 	int   reflTexSize;
+	int   reflRate;     ///< reflection is re-rendered every reflRate'th draw-frame and reprojected in between
 	bool  depthCopy;    ///< uses a screen depth copy, which allows a nicer interpolation between deep sea and shallow water
 	float anisotropy;
 	char  depthBits;    ///< depthBits for reflection/refraction RBO
@@ -107,6 +109,10 @@ private:
 
 	Shader::IProgramObject* waterShader;
 	Shader::IProgramObject* blurShader;
+
+	//! player camera's view-projection at the time the reflection texture was last rendered
+	CMatrix44f reflViewProj;
+	unsigned int nextReflDrawFrame = 0;
 };
 
 #endif // BUMP_WATER_H
@@ -772,15 +772,16 @@ void CGroundDecalHandler::Draw()
 	if (instVBO.GetSize() < decals.size() * sizeof(GroundDecal)) {
 		vao.Bind();
 
+		// grow with a GPU-side copy, the decals already uploaded stay valid
+		// and only those appended since the last frame need to be sent
 		instVBO.Bind();
-		instVBO.New(decals.capacity() * sizeof(GroundDecal), GL_STREAM_DRAW);
+		instVBO.Resize(decals.capacity() * sizeof(GroundDecal), GL_STREAM_DRAW);
 		BindVertexAtrribs();
 
 		vao.Unbind();
 
 		UnbindVertexAtrribs();
 		instVBO.Unbind();
-		decalsUpdateList.SetNeedUpdateAll();
 	}
 
 	if (decalsUpdateList.NeedUpdate()) {
@@ -1384,9 +1385,10 @@ void CGroundDecalHandler::CompactDecalsVector(int frameNum)
 	if (numToDelete == 0)
 		return;
 
-	// resort if number of expired items > 25.0%
+	// resort if number of expired items > 25.0%, expired decals
+	// are culled by the shader until then and cost no uploads
 	static constexpr float RESORT_THRESHOLD = 1.0f / 4.0f;
-	if (static_cast<float>(decals.size()) / static_cast<float>(numToDelete) <= RESORT_THRESHOLD)
+	if (static_cast<float>(numToDelete) / static_cast<float>(decals.size()) <= RESORT_THRESHOLD)
 		return;
 
 #if 0
@@ -1420,6 +1422,12 @@ void CGroundDecalHandler::CompactDecalsVector(int frameNum)
 	// clean to restore it later
 	decalOwners.clear();
 
+	// decals in front of the first expired one keep their positions,
+	// so neither they nor their pending updates have to be touched
+	const size_t firstMovedPos = std::distance(decals.begin(), std::find_if(decals.begin(), decals.end(), [](const GroundDecal& decal) {
+		return !decal.IsValid();
+	}));
+
 	// group all expired items towards the end of the vector
 	// Lua items are not considered expired
 	const auto expIt = std::stable_partition(decals.begin(), decals.end(), [](const GroundDecal& decal) {
@@ -1437,7 +1445,8 @@ void CGroundDecalHandler::CompactDecalsVector(int frameNum)
 
 	// remove expired decals
 	decals.resize(decals.size() - numToDelete);
-	decalsUpdateList.Resize(decals.size());
+	decalsUpdateList.Trim(decals.size());
+	decalsUpdateList.SetUpdate(firstMovedPos, decals.size() - firstMovedPos);
 
 	idToPos.clear();
 	for (size_t i = 0; i < decals.size(); ++i) {
@@ -75,6 +75,7 @@ public:
 
 	bool GetFullRead() const override { return true; }
 	int GetReadAllyTeam() const override { return AllAccessTeam; }
+	bool CanReadAllyTeam(int allyTeam) const override { return true; }
 
 	void RenderUnitCreated(const CUnit*, int cloaked) override;
 	void RenderUnitDestroyed(const CUnit*) override;
@@ -395,26 +395,35 @@ static float3 GetTurfParams(GrassRNG& rng, const int x, const int y)
 void CGrassDrawer::DrawNear(const std::vector<InviewNearGrass>& inviewGrass)
 {
 	RECOIL_DETAILED_TRACY_ZONE;
-	for (const InviewNearGrass& g: inviewGrass) {
-		grng.Seed(g.y * mapDims.mapx / grassSquareSize + g.x);
+	nearTurfs.resize(inviewGrass.size() * numTurfs);
 
-//		const float distSq = GetGrassBlockCamDist(g.x, g.y, true);
-		const float rdist  = 1.0f + grng.NextFloat() * 0.5f;
+	// turf placement only reads the heightmap, compute it on all threads
+	// and keep the GL calls below serial
+	for_mt(0, inviewGrass.size(), [&](const int i) {
+		const InviewNearGrass& g = inviewGrass[i];
+
+		GrassRNG trng; // need our own, this runs threaded
+		trng.Seed(g.y * mapDims.mapx / grassSquareSize + g.x);
+
+		const float rdist  = 1.0f + trng.NextFloat() * 0.5f;
 		const float alpha  = linearstep(maxDetailedDist, maxDetailedDist + 128.0f * rdist, g.dist);
 
 		for (int a = 0; a < numTurfs; a++) {
-			const float3& p = GetTurfParams(grng, g.x, g.y);
-			float3 pos(p.x, CGround::GetHeightReal(p.x, p.y, false), p.y);
-
-			pos.y -= CGround::GetSlope(p.x, p.y, false) * 30.0f;
-			pos.y -= 2.0f * mapInfo->grass.bladeHeight * alpha;
+			const float3& p = GetTurfParams(trng, g.x, g.y);
+			float4& turf = nearTurfs[i * numTurfs + a];
 
-			glPushMatrix();
-			glTranslatef3(pos);
-			glRotatef(p.z, 0.0f, 1.0f, 0.0f);
-			glCallList(grassDL);
-			glPopMatrix();
+			turf = {p.x, CGround::GetHeightReal(p.x, p.y, false), p.y, p.z};
+			turf.y -= CGround::GetSlope(p.x, p.y, false) * 30.0f;
+			turf.y -= 2.0f * mapInfo->grass.bladeHeight * alpha;
 		}
+	});
+
+	for (const float4& turf: nearTurfs) {
+		glPushMatrix();
+		glTranslatef3(turf);
+		glRotatef(turf.w, 0.0f, 1.0f, 0.0f);
+		glCallList(grassDL);
+		glPopMatrix();
 	}
 }
 
@@ -1056,9 +1065,18 @@ unsigned char CGrassDrawer::GetGrass(const float3& pos)
 void CGrassDrawer::UnsyncedHeightMapUpdate(const SRectangle& rect)
 {
 	RECOIL_DETAILED_TRACY_ZONE;
-	for (int z = rect.z1; z <= rect.z2; ++z) {
-		for (int x = rect.x1; x <= rect.x2; ++x) {
-			ResetPos(float3(x, 0.f, z));
+	if (grassOff)
+		return;
+
+	// rect is in heightmap squares, reset each grass block it touches once
+	const int bx1 = std::clamp(rect.x1 / blockMapSize, 0, blocksX - 1);
+	const int bz1 = std::clamp(rect.z1 / blockMapSize, 0, blocksY - 1);
+	const int bx2 = std::clamp(rect.x2 / blockMapSize, 0, blocksX - 1);
+	const int bz2 = std::clamp(rect.z2 / blockMapSize, 0, blocksY - 1);
+
+	for (int z = bz1; z <= bz2; ++z) {
+		for (int x = bx1; x <= bx2; ++x) {
+			ResetPos(x, z);
 		}
 	}
 }
@@ -7,6 +7,7 @@
 
 #include "Rendering/GL/VertexArray.h"
 #include "System/float3.h"
+#include "System/float4.h"
 #include "System/EventClient.h"
 
 namespace Shader {
@@ -103,6 +104,9 @@ protected:
 
 	CVertexArray farnearVA;
 
+	// positions (xyz) and rotations (w) of the mesh-turfs drawn by DrawNear
+	std::vector<float4> nearTurfs;
+
 	std::vector<GrassStruct> grass;
 	std::vector<unsigned char> grassMap;
 
@@ -184,8 +184,6 @@ CMatrix44f FlyingPiece::GetMatrixOf(const SplitterData& cp, const float3 dragFac
 void FlyingPiece::CheckDrawStateChange(const FlyingPiece* prev) const
 {
 	RECOIL_DETAILED_TRACY_ZONE;
-	ScopedModelDrawerImpl<CUnitDrawer> legacy(true, false);
-
 	const auto thisModelType = piece->GetParentModel()->type;
 
 	if (prev == nullptr) {
@@ -197,7 +195,7 @@ void FlyingPiece::CheckDrawStateChange(const FlyingPiece* prev) const
 		return;
 	}
 
-	const auto prevModelType = piece->GetParentModel()->type;
+	const auto prevModelType = prev->piece->GetParentModel()->type;
 
 	if (team != prev->team)
 		CUnitDrawer::SetTeamColor(team);
@@ -3,7 +3,8 @@
 
 #include "ProjectileDrawer.h"
 
-#include <tuple>
+#include <array>
+#include <utility>
 #include <bit>
 
 #include "Game/Camera.h"
@@ -44,15 +45,46 @@
 #include "System/Misc/TracyDefs.h"
 
 CONFIG(int, SoftParticles).defaultValue(1).safemodeValue(0).description("Soften up CEG particles on clipping edges");
+CONFIG(bool, ApproximateParticleSorting).defaultValue(false).description("Sort transparent particles on a coarser depth key (about 1% of the camera distance), which needs half the sorting passes");
 
-static uint32_t sortCamType = 0;
-static bool CProjectileDrawOrderSortingPredicate(const CProjectile* p1, const CProjectile* p2) noexcept {
-	return std::forward_as_tuple(p2->drawOrder, p1->GetSortDist(sortCamType), p1) > std::forward_as_tuple(p1->drawOrder, p2->GetSortDist(sortCamType), p2);
+// maps floats to unsigned ints with the same ordering; far-to-near is ascending
+static inline uint32_t FarToNearKey(float dist) {
+	const uint32_t bits = std::bit_cast<uint32_t>(dist);
+	return ~(bits ^ ((bits >> 31) != 0u ? 0xFFFFFFFFu : 0x80000000u));
 }
 
-static bool CProjectileSortingPredicate(const CProjectile* p1, const CProjectile* p2) noexcept {
-	return std::forward_as_tuple(p1->GetSortDist(sortCamType), p1) > std::forward_as_tuple(p2->GetSortDist(sortCamType), p2);
-};
+// stable LSD radix sort over bytes [firstByte, 3] of key(item); passes in which
+// all items share the same byte are skipped
+template<typename T, typename KeyFunc>
+static void RadixSort(std::vector<T>& items, std::vector<T>& scratch, uint32_t firstByte, KeyFunc&& key)
+{
+	std::array<uint32_t, 256> counts;
+
+	scratch.resize(items.size());
+
+	for (uint32_t byte = firstByte; byte < 4; byte++) {
+		const uint32_t shift = byte * 8;
+
+		counts.fill(0);
+
+		for (const T& item: items) {
+			counts[(key(item) >> shift) & 0xFF]++;
+		}
+
+		if (counts[(key(items[0]) >> shift) & 0xFF] == items.size())
+			continue;
+
+		for (uint32_t i = 0, sum = 0; i < counts.size(); i++) {
+			sum += std::exchange(counts[i], sum);
+		}
+
+		for (const T& item: items) {
+			scratch[counts[(key(item) >> shift) & 0xFF]++] = item;
+		}
+
+		std::swap(items, scratch);
+	}
+}
 
 CProjectileDrawer* projectileDrawer = nullptr;
 
@@ -114,6 +146,8 @@ void CProjectileDrawer::Init() {
 	int smokeTexCount = -1;
 
 	{
+		std::vector<std::pair<std::string, std::string>> smokeFiles;
+
 		// get the smoke textures, hold the count in 'smokeTexCount'
 		if (resSmokeTexturesTable.IsValid()) {
 			for (smokeTexCount = 0; true; smokeTexCount++) {
@@ -124,7 +158,7 @@ void CProjectileDrawer::Init() {
 				const std::string texName = "bitmaps/" + tex;
 				const std::string smokeName = "ismoke" + IntToString(smokeTexCount, "%02i");
 
-				textureAtlas->AddTexFromFile(smokeName, texName);
+				smokeFiles.emplace_back(smokeName, texName);
 				blockedTexNames.insert(StringToLower(smokeName));
 			}
 		} else {
@@ -134,11 +168,13 @@ void CProjectileDrawer::Init() {
 				const std::string smokeName = "ismoke" + smokeNum;
 				const std::string texName = "bitmaps/smoke/smoke" + smokeNum + ".tga";
 
-				textureAtlas->AddTexFromFile(smokeName, texName);
+				smokeFiles.emplace_back(smokeName, texName);
 				blockedTexNames.insert(StringToLower(smokeName));
 			}
 		}
 
+		textureAtlas->AddTexFromFiles(smokeFiles);
+
 		if (smokeTexCount <= 0) {
 			// this needs to be an exception, other code
 			// assumes at least one smoke-texture exists
@@ -341,6 +377,8 @@ void CProjectileDrawer::Init() {
 	sdbc = std::make_unique<ScopedDepthBufferCopy>(false);
 
 	EnableSoften(configHandler->GetInt("SoftParticles"));
+
+	approxSorting = configHandler->GetBool("ApproximateParticleSorting");
 }
 
 void CProjectileDrawer::Kill() {
@@ -360,6 +398,9 @@ void CProjectileDrawer::Kill() {
 	for (auto& dp : drawParticles)
 		dp.clear();
 
+	sortedParticles.clear();
+	sortedParticlesTmp.clear();
+
 	perlinFB.Kill();
 
 	perlinTexObjects = 0;
@@ -457,6 +498,7 @@ void CProjectileDrawer::ParseAtlasTextures(
 ) {
 	RECOIL_DETAILED_TRACY_ZONE;
 	std::vector<std::string> subTables;
+	std::vector<std::pair<std::string, std::string>> namedFiles;
 	spring::unordered_map<std::string, std::string> texturesMap;
 
 	textureTable.GetMap(texturesMap);
@@ -472,7 +514,7 @@ void CProjectileDrawer::ParseAtlasTextures(
 			blockedTextures.insert(textureName);
 
 		if (blockTextures || (blockedTextures.find(textureName) == blockedTextures.end()))
-			texAtlas->AddTexFromFile(texturesMapIt->first, "bitmaps/" + texturesMapIt->second);
+			namedFiles.emplace_back(texturesMapIt->first, "bitmaps/" + texturesMapIt->second);
 	}
 
 	texturesMap.clear();
@@ -492,11 +534,13 @@ void CProjectileDrawer::ParseAtlasTextures(
 				blockedTextures.insert(textureName);
 
 			if (blockTextures || (blockedTextures.find(textureName) == blockedTextures.end()))
-				texAtlas->AddTexFromFile(texturesMapIt->first, "bitmaps/" + texturesMapIt->second);
+				namedFiles.emplace_back(texturesMapIt->first, "bitmaps/" + texturesMapIt->second);
 		}
 
 		texturesMap.clear();
 	}
+
+	texAtlas->AddTexFromFiles(namedFiles);
 }
 
 void CProjectileDrawer::LoadWeaponTextures() {
@@ -679,6 +723,9 @@ void CProjectileDrawer::DrawFlyingPieces(int modelType) const
 	if (container.empty())
 		return;
 
+	// select the legacy drawer once for all pieces rather than once per piece
+	ScopedModelDrawerImpl<CUnitDrawer> legacy(true, false);
+
 	FlyingPiece::BeginDraw();
 
 	const FlyingPiece* last = nullptr;
@@ -779,21 +826,36 @@ void CProjectileDrawer::DrawAlpha(bool drawAboveWater, bool drawBelowWater, bool
 		}
 	}
 
-	// set static variable to facilite sorting
-	sortCamType = camera->GetCamType();
-
 	{
 		ZoneScopedN("ProjectileDrawer::DrawAlpha(SO)");
-		if (wantDrawOrder)
-			std::sort(drawParticles[true].begin(), drawParticles[true].end(), CProjectileDrawOrderSortingPredicate);
-		else
-			std::sort(drawParticles[true].begin(), drawParticles[true].end(), CProjectileSortingPredicate);
+		const uint32_t sortCamType = camera->GetCamType();
+
+		const auto& dps = drawParticles[true];
+
+		sortedParticles.resize(dps.size());
+
+		// gathering the keys chases a pointer per particle, sorting does not
+		for_mt(0, dps.size(), [&](const int i) {
+			const CProjectile* p = dps[i];
+			sortedParticles[i] = {FarToNearKey(p->GetSortDist(sortCamType)), static_cast<uint32_t>(p->drawOrder) ^ 0x80000000u, dps[i]};
+		});
+
+		// back-to-front; equidistant particles keep their render order. The
+		// coarse key only keeps the upper 16 bits (sign, exponent and seven
+		// mantissa bits) of the distance
+		if (!sortedParticles.empty()) {
+			RadixSort(sortedParticles, sortedParticlesTmp, approxSorting? 2: 0, [](const SortedParticle& sp) { return sp.distKey; });
+
+			// drawOrder takes precedence, sorted last
+			if (wantDrawOrder)
+				RadixSort(sortedParticles, sortedParticlesTmp, 0, [](const SortedParticle& sp) { return sp.orderKey; });
+		}
 	}
 
 	{
 		ZoneScopedN("ProjectileDrawer::DrawAlpha(DS)");
-		for (auto p : drawParticles[ true]) {
-			p->Draw();
+		for (const auto& sp : sortedParticles) {
+			sp.p->Draw();
 		}
 	}
 	{
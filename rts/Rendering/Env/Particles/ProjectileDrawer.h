@@ -167,7 +167,17 @@ private:
 	/// used to render particle effects in back-to-front order. {unsorted, sorted}
 	std::array<std::vector<CProjectile*>, 2> drawParticles;
 
+	struct SortedParticle {
+		uint32_t distKey;
+		uint32_t orderKey;
+		CProjectile* p;
+	};
+	/// sort keys of drawParticles[true] are copied here so sorting does not chase pointers
+	std::vector<SortedParticle> sortedParticles;
+	std::vector<SortedParticle> sortedParticlesTmp;
+
 	bool drawSorted = true;
+	bool approxSorting = false;
 
 	std::array<Shader::IProgramObject*, 2> fxShaders = { nullptr };
 	Shader::IProgramObject* fsShadowShader = nullptr;
@@ -90,6 +90,8 @@ void CFeatureDrawerData::ConfigNotify(const std::string& key, const std::string&
 void CFeatureDrawerData::Update()
 {
 	RECOIL_DETAILED_TRACY_ZONE;
+	UpdateDrawFlagCamTypes();
+
 	if (mtModelDrawer) {
 		for_mt_chunk(0, unsortedObjects.size(), [this](const int k) {
 			CFeature* f = unsortedObjects[k];
@@ -118,30 +120,22 @@ void CFeatureDrawerData::UpdateObjectDrawFlags(CSolidObject* o) const
 	CFeature* f = static_cast<CFeature*>(o);
 	f->ResetDrawFlag();
 
-	for (uint32_t camType = CCamera::CAMTYPE_PLAYER; camType < CCamera::CAMTYPE_ENVMAP; ++camType) {
-		if (camType == CCamera::CAMTYPE_UWREFL && !IWater::GetWater()->CanDrawReflectionPass())
-			continue;
-
-		if (camType == CCamera::CAMTYPE_SHADOW && ((shadowHandler.shadowGenBits & CShadowHandler::SHADOWGEN_BIT_MODEL) == 0))
-			continue;
+	// camera-independent rejections; skip the camera tests but not the transform update below
+	const bool canDraw = !f->noDraw && !f->IsInVoid() && (f->IsInLosForAllyTeam(gu->myAllyTeam) || gu->spectatingFullView);
 
+	for (uint32_t i = 0, n = canDraw * numDrawFlagCamTypes; i < n; ++i) {
+		const uint32_t camType = drawFlagCamTypes[i];
 		const CCamera* cam = CCameraHandler::GetCamera(camType);
 
-		if (f->noDraw)
-			continue;
-
-		if (f->IsInVoid())
-			continue;
-
-		if (!f->IsInLosForAllyTeam(gu->myAllyTeam) && !gu->spectatingFullView)
-			continue;
-
 		if (!cam->InView(f->drawMidPos, f->GetDrawRadius()))
 			continue;
 
 		switch (camType)
 			{
 			case CCamera::CAMTYPE_PLAYER: {
+				if (terrainOcclusion && CModelDrawerHelper::ObjectOccludedByTerrain(f->drawMidPos, cam->GetPos(), f->GetDrawRadius()))
+					continue;
+
 				const float camDist = (f->drawPos - cam->GetPos()).Length();
 
 				// special case for non-fading features
@@ -191,6 +185,9 @@ void CFeatureDrawerData::UpdateObjectDrawFlags(CSolidObject* o) const
 			} break;
 
 			case CCamera::CAMTYPE_SHADOW: {
+				if (f->GetDrawRadius() < shadowHandler.GetMinCasterRadius())
+					continue;
+
 				if (f->drawAlpha <= 0.0f)
 					continue;
 
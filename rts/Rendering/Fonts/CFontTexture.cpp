@@ -867,6 +867,7 @@ bool CFontTexture::ClearGlyphs() {
 
 		// clear all glyps
 		glyphs.clear();
+		glyphsGeneration++;
 
 		// clear atlases
 		ClearAtlases(32, 32);
@@ -1124,8 +1125,10 @@ void CFontTexture::LoadWantedGlyphs(const std::vector<char32_t>& wanted)
 
 			assert(glyphIdx < atlasGlyphs.size());
 
-			if (texpos[2] != 0)
+			if (texpos[2] != 0) {
 				atlasUpdate.CopySubImage(atlasGlyphs[glyphIdx], texpos.x, texpos.y);
+				AddDirtyAtlasRect({int(texpos.x), int(texpos.y), int(texpos.x) + atlasGlyphs[glyphIdx].xsize, int(texpos.y) + atlasGlyphs[glyphIdx].ysize});
+			}
 			if (texpos2[2] != 0) {
 				const int x = texpos2.x;
 				const int y = texpos2.y;
@@ -1135,6 +1138,7 @@ void CFontTexture::LoadWantedGlyphs(const std::vector<char32_t>& wanted)
 					std::min<int>(wantedTexWidth,  x + 2*outlineSize + atlasGlyphs[glyphIdx].xsize),
 					std::min<int>(wantedTexHeight, y + 2*outlineSize + atlasGlyphs[glyphIdx].ysize)
 				);
+				AddDirtyAtlasRect(blurRectangles.back());
 				atlasUpdateShadow.CopySubImage(atlasGlyphs[glyphIdx], x + outlineSize, y + outlineSize);
 			}
 		}
@@ -1267,6 +1271,28 @@ void CFontTexture::CreateTexture(const int width, const int height)
 
 	atlasUpdateShadow = {};
 	atlasUpdateShadow.Alloc(width, height, 1);
+
+	// the first upload replaces the placeholder texture
+	dirtyAtlasRect = {};
+	uploadedTexSize = {};
+#endif
+}
+
+void CFontTexture::AddDirtyAtlasRect(const SRectangle& rect)
+{
+#ifndef HEADLESS
+	if (rect.GetArea() <= 0)
+		return;
+
+	if (dirtyAtlasRect.GetArea() <= 0) {
+		dirtyAtlasRect = rect;
+		return;
+	}
+
+	dirtyAtlasRect.x1 = std::min(dirtyAtlasRect.x1, rect.x1);
+	dirtyAtlasRect.y1 = std::min(dirtyAtlasRect.y1, rect.y1);
+	dirtyAtlasRect.x2 = std::max(dirtyAtlasRect.x2, rect.x2);
+	dirtyAtlasRect.y2 = std::max(dirtyAtlasRect.y2, rect.y2);
 #endif
 }
 
@@ -1351,6 +1377,10 @@ void CFontTexture::ClearAtlases(const int width, const int height)
 
 	atlasGlyphs.clear();
 	blurRectangles.clear();
+
+	// everything previously uploaded is stale
+	dirtyAtlasRect = {};
+	uploadedTexSize = {};
 #endif
 }
 
@@ -1388,25 +1418,26 @@ void CFontTexture::UpdateGlyphAtlasTexture()
 
 	// merge shadow and regular atlas bitmaps, dispose shadow
 	if (atlasUpdateShadow.xsize == atlasUpdate.xsize && atlasUpdateShadow.ysize == atlasUpdate.ysize) {
+		assert(atlasUpdateShadow.GetMemSize() == atlasUpdate.GetMemSize());
+
+		// the shadow atlas is blank outside of the (disjoint) rectangles of
+		// newly added glyphs, only those parts have to be merged
 		for_mt(0, blurRectangles.size(), [&](int i) {
 			SRectangle& rect = blurRectangles[i];
 			atlasUpdateShadow.Blur(outlineSize, outlineWeight, rect.x1, rect.y1, rect.x2-rect.x1, rect.y2-rect.y1);
-		});
-		blurRectangles.clear();
 
-		assert((atlasUpdate.xsize * atlasUpdate.ysize) % sizeof(int) == 0);
+			const uint8_t* src = atlasUpdateShadow.GetRawMem();
+			      uint8_t* dst = atlasUpdate.GetRawMem();
 
-		const int* src = reinterpret_cast<const int*>(atlasUpdateShadow.GetRawMem());
-		      int* dst = reinterpret_cast<      int*>(atlasUpdate.GetRawMem());
+			for (int y = rect.y1; y < rect.y2; ++y) {
+				const int rowOffset = y * atlasUpdate.xsize;
 
-		const int size = (atlasUpdate.xsize * atlasUpdate.ysize) / sizeof(int);
-
-		assert(atlasUpdateShadow.GetMemSize() / sizeof(int) == size);
-		assert(atlasUpdate.GetMemSize() / sizeof(int) == size);
-
-		for (int i = 0; i < size; ++i) {
-			dst[i] |= src[i];
-		}
+				for (int x = rect.x1; x < rect.x2; ++x) {
+					dst[rowOffset + x] |= src[rowOffset + x];
+				}
+			}
+		});
+		blurRectangles.clear();
 
 		atlasUpdateShadow = {}; // MT-safe
 		needsTextureUpload = true;
@@ -1428,15 +1459,39 @@ void CFontTexture::UploadGlyphAtlasTextureImpl()
 	if (!GlyphAtlasTextureNeedsUpload())
 		return;
 
-	// update texture atlas
-	glBindTexture(GL_TEXTURE_2D, glyphAtlasTextureID);
 	#ifdef SUPPORT_AMD_HACKS_HERE
-		glTexImage2D(GL_TEXTURE_2D, 0, GL_ALPHA, texWidth, texHeight, 0, GL_ALPHA, GL_UNSIGNED_BYTE, atlasUpdate.GetRawMem());
+	constexpr GLenum texFormat = GL_ALPHA;
+	constexpr GLint  intFormat = GL_ALPHA;
 	#else
-		glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, texWidth, texHeight, 0, GL_RED, GL_UNSIGNED_BYTE, atlasUpdate.GetRawMem());
+	constexpr GLenum texFormat = GL_RED;
+	constexpr GLint  intFormat = GL_R8;
 	#endif
+
+	// update texture atlas; glyphs never move once placed, so unless the
+	// atlas was resized only the area of the new glyphs has to be sent
+	glBindTexture(GL_TEXTURE_2D, glyphAtlasTextureID);
+
+	if (uploadedTexSize != int2(texWidth, texHeight)) {
+		glTexImage2D(GL_TEXTURE_2D, 0, intFormat, texWidth, texHeight, 0, texFormat, GL_UNSIGNED_BYTE, atlasUpdate.GetRawMem());
+	} else {
+		SRectangle rect = dirtyAtlasRect;
+		rect.ClampIn({0, 0, texWidth, texHeight});
+
+		if (rect.GetArea() > 0) {
+			glPixelStorei(GL_UNPACK_ROW_LENGTH, texWidth);
+			glPixelStorei(GL_UNPACK_SKIP_PIXELS, rect.x1);
+			glPixelStorei(GL_UNPACK_SKIP_ROWS, rect.y1);
+			glTexSubImage2D(GL_TEXTURE_2D, 0, rect.x1, rect.y1, rect.GetWidth(), rect.GetHeight(), texFormat, GL_UNSIGNED_BYTE, atlasUpdate.GetRawMem());
+			glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+			glPixelStorei(GL_UNPACK_SKIP_PIXELS, 0);
+			glPixelStorei(GL_UNPACK_SKIP_ROWS, 0);
+		}
+	}
+
 	glBindTexture(GL_TEXTURE_2D, 0);
 
+	dirtyAtlasRect = {};
+	uploadedTexSize = int2(texWidth, texHeight);
 	needsTextureUpload = false;
 #endif
 }
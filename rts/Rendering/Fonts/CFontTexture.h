@@ -150,11 +150,15 @@ protected:
 private:
 	void ClearAtlases(const int width, const int height);
 	void CreateTexture(const int width, const int height);
+	void AddDirtyAtlasRect(const SRectangle& rect);
 	void LoadGlyph(std::shared_ptr<FontFace>& f, char32_t ch, unsigned index);
 	bool ClearGlyphs();
 	void PreloadGlyphs();
 protected:
 	float GetKerning(const GlyphInfo& lgl, const GlyphInfo& rgl);
+
+	// changes whenever previously loaded glyphs were discarded
+	int GetGlyphsGeneration() const { return glyphsGeneration; }
 protected:
 	static inline std::vector<std::weak_ptr<CFontTexture>> allFonts = {};
 
@@ -172,6 +176,8 @@ protected:
 	std::string fontFamily;
 	std::string fontStyle;
 
+	int glyphsGeneration = 0;
+
 	int texWidth;
 	int texHeight;
 	int wantedTexWidth;
@@ -187,6 +193,10 @@ private:
 	int curTextureUpdate = 0;
 	int lastTextureUpdate = 0;
 	bool needsTextureUpload = true;
+	// atlas area changed since the last upload; the whole atlas is
+	// uploaded instead when its size differs from the uploaded one
+	SRectangle dirtyAtlasRect;
+	int2 uploadedTexSize;
 	inline static int maxFontTries = 0;
 	inline static int maxPinnedFonts = 0;
 #endif
@@ -163,6 +163,9 @@ void CglFont::ReallocSystemFontAtlases(bool pre)
 	assert(fontsCounter <= 2);
 #endif
 
+	// cached layouts are rebuilt with the reallocated glyph data
+	layoutGeneration++;
+
 	if (font != nullptr)		
 		font->ReallocAtlases(pre);
 	if (smallFont != nullptr && smallFont != font)
@@ -182,6 +185,11 @@ CglFont::CglFont(const std::string& fontFile, int size, int _outlineWidth, float
 		[f = this](const std::string& str) { HeightCache hc; hc.height = f->GetTextHeight_(toustring(str), &hc.descender, &hc.numLines); return hc; },
 		[](const std::string& str, const auto& cache) {}, //don't save anything
 	}
+	, stringLayout {
+		1 << 11,
+		[f = this](const std::string& str) { return f->BuildTextLayout(str); },
+		[](const std::string& str, const auto& cache) {}, //don't save anything
+	}
 {
 	textColor    = white;
 	outlineColor = darkOutline;
@@ -210,10 +218,11 @@ void CglFont::SetOutlineColor(const float4* color) {}
 void CglFont::SetColors(const float4* textColor, const float4* outlineColor) {}
 
 float CglFont::GetCharacterWidth(const char32_t c) { return 1.0f; }
-bool CglFont::SkipColorCodesAndNewLines(const spring::u8string& text, int& curIndex, int& numLines)
+bool CglFont::SkipColorCodesAndNewLines(const spring::u8string& text, int& curIndex, int& numLines, TextLayout* layout)
 {
 	return true;
 }
+std::shared_ptr<const CglFont::TextLayout> CglFont::BuildTextLayout(const std::string& str) { return nullptr; }
 void CglFont::ScanForWantedGlyphs(const spring::u8string& str) {}
 float CglFont::GetTextWidth_(const spring::u8string& text) { return (text.size() * 1.0f); }
 float CglFont::GetTextHeight_(const spring::u8string& text, float* descender, int* numLines) { return 1.0f; }
@@ -249,36 +258,65 @@ static inline int SkipColorCodes(const spring::u8string& text, int idx)
 }
 
 
-bool CglFont::SkipColorCodesAndNewLines(const spring::u8string& text, int& curIndex, int& numLines)
+void CglFont::ApplyColorOp(const ColorOp& op)
+{
+	switch (op.type) {
+		case ColorOp::COLOR_CODE: {
+			if (autoOutlineColor)
+				SetColors(&op.textColor, nullptr);
+			else
+				SetTextColor(&op.textColor);
+		} break;
+		case ColorOp::COLOR_CODE_EX: {
+			// ignore autoOutline here
+			SetColors(&op.textColor, &op.outlineColor);
+		} break;
+		case ColorOp::COLOR_RESET: {
+			SetColors(&baseTextColor, &baseOutlineColor);
+		} break;
+		default: {
+			assert(false);
+		} break;
+	}
+}
+
+bool CglFont::SkipColorCodesAndNewLines(const spring::u8string& text, int& curIndex, int& numLines, TextLayout* layout)
 {
 	RECOIL_DETAILED_TRACY_ZONE;
 	int idx = curIndex;
 	int nls = 0;
 
+	// applies the color change now, or records it if building a layout
+	const auto ColorChange = [&](const ColorOp& op) {
+		if (layout == nullptr) {
+			ApplyColorOp(op);
+			return;
+		}
+
+		layout->colorOps.push_back(op);
+		layout->colorOps.back().glyphIdx = layout->quads.size();
+	};
+
 	char32_t nextChar = 0;
 	for (int end = static_cast<int>(text.length()); idx < end; ) {
 		switch (nextChar = utf8::GetNextChar(text, idx, false/*do not advance*/)) {
 			case CglFont::ColorCodeIndicator: {
 				if ((idx += 3 + 1) < end) {
 					const float4 newTextColor = { text[idx - 3] / 255.0f, text[idx - 2] / 255.0f, text[idx - 1] / 255.0f, 1.0f };
-					if (autoOutlineColor)
-						SetColors(&newTextColor, nullptr);
-					else
-						SetTextColor(&newTextColor);
+					ColorChange({0, ColorOp::COLOR_CODE, newTextColor, {}});
 				}
 			} break;
 			case CglFont::ColorCodeIndicatorEx: {
 				if ((idx += 4 * 2 + 1) < end) {
 					const float4 newTextColor = { text[idx - 8] / 255.0f, text[idx - 7] / 255.0f, text[idx - 6] / 255.0f, text[idx - 5] / 255.0f };
 					const float4 newOutlColor = { text[idx - 4] / 255.0f, text[idx - 3] / 255.0f, text[idx - 2] / 255.0f, text[idx - 1] / 255.0f };
-					// ignore autoOutline here
-					SetColors(&newTextColor, &newOutlColor);
+					ColorChange({0, ColorOp::COLOR_CODE_EX, newTextColor, newOutlColor});
 				}
 			} break;
 
 			case CglFont::ColorResetIndicator: {
 				idx += 1;
-				SetColors(&baseTextColor, &baseOutlineColor);
+				ColorChange({0, ColorOp::COLOR_RESET, {}, {}});
 			} break;
 
 			case 0x0D: {
@@ -682,16 +720,19 @@ void CglFont::DrawWorldBuffered(bool userDefinedBlending)
 	glPopMatrix();
 }
 
-template<int shiftXC, int shiftYC, bool outline>
-void CglFont::RenderStringImpl(float x, float y, float scaleX, float scaleY, const std::string& str)
+std::shared_ptr<const CglFont::TextLayout> CglFont::BuildTextLayout(const std::string& str)
 {
 	RECOIL_DETAILED_TRACY_ZONE;
 	const spring::u8string& ustr = toustring(str);
 
 	ScanForWantedGlyphs(ustr);
 
-	const float startx = x;
-	const float lineHeight_ = scaleY * GetLineHeight();
+	auto layout = std::make_shared<TextLayout>();
+	layout->glyphsGeneration = GetGlyphsGeneration();
+	layout->layoutGeneration = layoutGeneration;
+
+	float penX = 0.0f;
+	float penY = 0.0f;
 
 	char32_t curGlyphIdx = 0;
 	char32_t prvGlyphIdx = 0;
@@ -699,36 +740,91 @@ void CglFont::RenderStringImpl(float x, float y, float scaleX, float scaleY, con
 	int currentPos = 0;
 	int skippedLines = 0;
 
-	constexpr float texScaleX = 1.0f;
-	constexpr float texScaleY = 1.0f;
-
-	// check for end-of-string
-	while (!SkipColorCodesAndNewLines(ustr, currentPos, skippedLines)) {
+	// color changes are recorded instead of applied, replayed by RenderStringImpl
+	while (!SkipColorCodesAndNewLines(ustr, currentPos, skippedLines, layout.get())) {
 		curGlyphIdx = utf8::GetNextChar(ustr, currentPos);
 
 		const GlyphInfo* curGlyphPtr = &GetGlyph(curGlyphIdx);
 		assert(curGlyphPtr != &CFontTexture::dummyGlyph);
-		const GlyphInfo* prvGlyphPtr = nullptr;
 
 		if (skippedLines > 0) {
-			x = startx;
-			y -= (skippedLines * lineHeight_);
+			penX = 0.0f;
+			penY -= (skippedLines * GetLineHeight());
 		}
 		else if (prvGlyphIdx != 0) {
-			prvGlyphPtr = &GetGlyph(prvGlyphIdx);
+			const GlyphInfo* prvGlyphPtr = &GetGlyph(prvGlyphIdx);
 			assert(prvGlyphPtr != &CFontTexture::dummyGlyph);
-			x += (scaleX * GetKerning(*prvGlyphPtr, *curGlyphPtr));
+			penX += GetKerning(*prvGlyphPtr, *curGlyphPtr);
 		}
 
-		prvGlyphPtr = curGlyphPtr;
 		prvGlyphIdx = curGlyphIdx;
 
+		const auto& gs = curGlyphPtr->size;
+
+		layout->quads.push_back({
+			{penX + gs.x0(), penY + gs.y0(), penX + gs.x1(), penY + gs.y1()},
+			curGlyphPtr->texCord,
+			curGlyphPtr->shadowTexCord
+		});
+	}
+
+	return layout;
+}
+
+std::shared_ptr<const CglFont::TextLayout> CglFont::GetTextLayout(const std::string& str)
+{
+	RECOIL_DETAILED_TRACY_ZONE;
+	std::shared_ptr<const TextLayout> layout = stringLayout.Get(str);
+
+	// glyph texcoords and metrics are only valid until the glyphs or atlases are discarded
+	if (layout->glyphsGeneration != GetGlyphsGeneration() || layout->layoutGeneration != layoutGeneration) {
+		layout = BuildTextLayout(str);
+		stringLayout.Set(str, layout);
+	}
+
+	return layout;
+}
+
+template<int shiftXC, int shiftYC, bool outline>
+void CglFont::RenderStringImpl(float x, float y, float scaleX, float scaleY, const std::string& str)
+{
+	RECOIL_DETAILED_TRACY_ZONE;
+	const std::shared_ptr<const TextLayout> layout = GetTextLayout(str);
+
+	const auto& quads = layout->quads;
+	const auto& colorOps = layout->colorOps;
+
+	constexpr float texScaleX = 1.0f;
+	constexpr float texScaleY = 1.0f;
+
+	float shiftX = 0.0f;
+	float shiftY = 0.0f;
+	if constexpr (shiftXC > 0 || shiftYC > 0) {
+		shiftX = scaleX * static_cast<float>(shiftXC) / 100.0f;
+		shiftY = scaleY * static_cast<float>(shiftYC) / 100.0f;
+	}
+
+	float ssX = 0.0f;
+	float ssY = 0.0f;
+	if constexpr (outline) {
+		ssX = (scaleX / fontSize) * GetOutlineWidth();
+		ssY = (scaleY / fontSize) * GetOutlineWidth();
+	}
+
+	size_t opIdx = 0;
+
+	for (size_t i = 0, n = quads.size(); i < n; i++) {
+		while (opIdx < colorOps.size() && colorOps[opIdx].glyphIdx <= i) {
+			ApplyColorOp(colorOps[opIdx++]);
+		}
+
+		const GlyphQuad& q = quads[i];
 
-		const auto& tc = prvGlyphPtr->texCord;
-		const float dx0 = (scaleX * prvGlyphPtr->size.x0()) + x;
-		const float dy0 = (scaleY * prvGlyphPtr->size.y0()) + y;
-		const float dx1 = (scaleX * prvGlyphPtr->size.x1()) + x;
-		const float dy1 = (scaleY * prvGlyphPtr->size.y1()) + y;
+		const auto& tc = q.texCord;
+		const float dx0 = (scaleX * q.pos.x) + x;
+		const float dy0 = (scaleY * q.pos.y) + y;
+		const float dx1 = (scaleX * q.pos.z) + x;
+		const float dy1 = (scaleY * q.pos.w) + y;
 		const float tx0 = tc.x0() * texScaleX;
 		const float ty0 = tc.y0() * texScaleY;
 		const float tx1 = tc.x1() * texScaleX;
@@ -736,26 +832,12 @@ void CglFont::RenderStringImpl(float x, float y, float scaleX, float scaleY, con
 
 
 		if constexpr (shiftXC > 0 || shiftYC > 0 || outline) {
-			const auto& stc = prvGlyphPtr->shadowTexCord;
+			const auto& stc = q.shadowTexCord;
 			const float stx0 = stc.x0() * texScaleX;
 			const float sty0 = stc.y0() * texScaleY;
 			const float stx1 = stc.x1() * texScaleX;
 			const float sty1 = stc.y1() * texScaleY;
 
-			float shiftX = 0.0f;
-			float shiftY = 0.0f;
-			if constexpr (shiftXC > 0 || shiftYC > 0) {
-				shiftX = scaleX * static_cast<float>(shiftXC) / 100.0f;
-				shiftY = scaleY * static_cast<float>(shiftYC) / 100.0f;
-			}
-
-			float ssX = 0.0f;
-			float ssY = 0.0f;
-			if constexpr (outline) {
-				ssX = (scaleX / fontSize) * GetOutlineWidth();
-				ssY = (scaleY / fontSize) * GetOutlineWidth();
-			}
-
 			fontRenderer->AddQuadTrianglesOB(
 				{ {dx0 + shiftX - ssX, dy0 - shiftY + ssY, textDepth.y},  stx0, sty0,  (&outlineColor.x) },
 				{ {dx1 + shiftX + ssX, dy0 - shiftY + ssY, textDepth.y},  stx1, sty0,  (&outlineColor.x) },
@@ -771,6 +853,11 @@ void CglFont::RenderStringImpl(float x, float y, float scaleX, float scaleY, con
 			{ {dx0, dy1, textDepth.x},  tx0, ty1,  (&textColor.x) }
 		);
 	}
+
+	// trailing color codes still change the current color, as before
+	while (opIdx < colorOps.size()) {
+		ApplyColorOp(colorOps[opIdx++]);
+	}
 }
 
 void CglFont::glWorldPrint(const float3& p, const float size, const std::string& str, int options)
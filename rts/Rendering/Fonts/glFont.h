@@ -5,6 +5,7 @@
 #include <string>
 #include <deque>
 #include <memory>
+#include <vector>
 
 #include "TextWrap.h"
 #include "ustring.h"
@@ -111,8 +112,40 @@ public:
 	static constexpr char8_t ColorCodeIndicatorEx = 0xFE;
 	static constexpr char8_t ColorResetIndicator  = 0x08; // =: '\\b'
 private:
+	// in-text color change, applied in front of the glyph at <glyphIdx>
+	struct ColorOp {
+		enum {
+			COLOR_CODE    = 0,
+			COLOR_CODE_EX = 1,
+			COLOR_RESET   = 2,
+		};
+
+		uint32_t glyphIdx;
+		uint32_t type;
+
+		float4 textColor;
+		float4 outlineColor;
+	};
+	struct GlyphQuad {
+		float4 pos; // x0,y0,x1,y1 at unit scale relative to the print position
+		IGlyphRect texCord;
+		IGlyphRect shadowTexCord;
+	};
+	// positioned glyphs of a string, reused by glPrint while the string does not change
+	struct TextLayout {
+		std::vector<GlyphQuad> quads;
+		std::vector<ColorOp> colorOps;
+
+		int glyphsGeneration = 0;
+		int layoutGeneration = 0;
+	};
+
 	static const float4* ChooseOutlineColor(const float4& textColor);
 
+	std::shared_ptr<const TextLayout> GetTextLayout(const std::string& str);
+	std::shared_ptr<const TextLayout> BuildTextLayout(const std::string& str);
+	void ApplyColorOp(const ColorOp& op);
+
 	template<int shiftXC, int shiftYC, bool outline>
 	void RenderStringImpl(float x, float y, float scaleX, float scaleY, const std::string& str);
 
@@ -128,7 +161,8 @@ private:
 	bool SkipColorCodesAndNewLines(
 		const spring::u8string& text,
 		int& curIndex,
-		int& numLines
+		int& numLines,
+		TextLayout* layout = nullptr
 	);
 private:
 	float GetTextWidth_(const spring::u8string& text);
@@ -161,6 +195,10 @@ private:
 
 	spring::LRUClockCache<std::string, float> stringWidth;
 	spring::LRUClockCache<std::string, HeightCache> stringHeight;
+	spring::LRUClockCache<std::string, std::shared_ptr<const TextLayout>> stringLayout;
+
+	// bumped by ReallocSystemFontAtlases
+	static inline int layoutGeneration = 0;
 
 	CMatrix44f viewMatrix;
 	CMatrix44f projMatrix;
@@ -88,6 +88,7 @@ unsigned int GL::LightHandler::SetLight(unsigned int lgtIndex, const GL::Light&
 	lights[lgtIndex].SetRelativeTime(0);
 	lights[lgtIndex].SetAbsoluteTime(gs->frameNum);
 
+	clearedLights = false;
 	return (lights[lgtIndex].GetUID());
 }
 
@@ -95,8 +96,11 @@ GL::Light* GL::LightHandler::GetLight(unsigned int lgtHandle) {
 	RECOIL_DETAILED_TRACY_ZONE;
 	const auto it = std::find_if(lights.begin(), lights.end(), [&](const GL::Light& lgt) { return (lgt.GetUID() == lgtHandle); });
 
-	if (it != lights.end())
+	// caller may revive or change the light
+	if (it != lights.end()) {
+		clearedLights = false;
 		return &(*it);
+	}
 
 	return nullptr;
 }
@@ -115,6 +119,13 @@ void GL::LightHandler::Update(Shader::IProgramObject* shader) {
 	if (numLights == 0)
 		return;
 
+	// this runs for every model render-state switch; nothing to (re)upload
+	// once all lights have expired and their contributions were cleared
+	if (clearedLights)
+		return;
+
+	const bool anyLiveLight = std::any_of(lights.begin(), lights.end(), [](const GL::Light& lgt) { return (lgt.GetTTL() != 0); });
+
 	// float3 sumWeight;
 	float3 maxWeight = OnesVector * 0.01f;
 
@@ -223,5 +234,7 @@ void GL::LightHandler::Update(Shader::IProgramObject* shader) {
 		#endif
 		glDisable(lightID);
 	}
+
+	clearedLights = !anyLiveLight;
 }
 
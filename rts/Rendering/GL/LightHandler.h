@@ -14,7 +14,7 @@ namespace Shader {
 namespace GL {
 	struct LightHandler {
 	public:
-		LightHandler(): baseLight(0), maxLights(0), numLights(0), lightHandle(0) {}
+		LightHandler(): baseLight(0), maxLights(0), numLights(0), lightHandle(0), clearedLights(false) {}
 		~LightHandler() { Kill(); }
 
 		void Init(unsigned int, unsigned int);
@@ -36,6 +36,9 @@ namespace GL {
 		unsigned int maxLights;
 		unsigned int numLights;
 		unsigned int lightHandle;
+
+		// true if every GL light was zeroed by the last Update and none was added since
+		bool clearedLights;
 	};
 }
 
@@ -1,28 +1,38 @@
 #include "RenderBuffers.h"
 
+#include "System/Config/ConfigHandler.h"
 #include "System/Log/ILog.h"
 
 #include "System/Misc/TracyDefs.h"
 
+CONFIG(bool, RenderBuffersPersistentMap).defaultValue(true).safemodeValue(false).description("Whether the engine's standard render buffers use triple-buffered persistently mapped storage (when supported) instead of glBufferSubData uploads. Needs three times the buffer memory.");
+
 std::array<std::unique_ptr<RenderBuffer>, 13> RenderBuffer::typedRenderBuffers;
 
 void RenderBuffer::InitStatic()
 {
 	RECOIL_DETAILED_TRACY_ZONE;
+	using SBType = IStreamBufferConcept::Types;
+	const SBType sbType = (globalRendering->supportPersistentMapping && configHandler->GetBool("RenderBuffersPersistentMap"))
+		? SBType::SB_PERSISTENTMAP
+		: SBType::SB_BUFFERSUBDATA;
+
+	LOG("[RenderBuffer::%s] using %s storage", __func__, (sbType == SBType::SB_PERSISTENTMAP)? "persistently mapped": "BufferSubData");
+
 	RenderBuffer::typedRenderBuffers = {
-		std::make_unique<TypedRenderBuffer<VA_TYPE_0   >>(1 << 16, 1 << 17),
-		std::make_unique<TypedRenderBuffer<VA_TYPE_C   >>(1 << 20, 1 << 21),
-		std::make_unique<TypedRenderBuffer<VA_TYPE_N   >>(1 << 10, 1 << 11),
-		std::make_unique<TypedRenderBuffer<VA_TYPE_T   >>(1 << 20, 1 << 21),
-		std::make_unique<TypedRenderBuffer<VA_TYPE_T4  >>(1 << 16, 1 << 18),
-		std::make_unique<TypedRenderBuffer<VA_TYPE_TN  >>(1 << 16, 1 << 17),
-		std::make_unique<TypedRenderBuffer<VA_TYPE_TC  >>(1 << 20, 1 << 21),
-		std::make_unique<TypedRenderBuffer<VA_TYPE_PROJ>>(1 << 20, 1 << 21),
-		std::make_unique<TypedRenderBuffer<VA_TYPE_TNT >>(0      , 0      ),
-		std::make_unique<TypedRenderBuffer<VA_TYPE_2D0 >>(1 << 16, 1 << 17),
-		std::make_unique<TypedRenderBuffer<VA_TYPE_2DC >>(1 << 16, 1 << 17),
-		std::make_unique<TypedRenderBuffer<VA_TYPE_2DT >>(1 << 20, 1 << 21),
-		std::make_unique<TypedRenderBuffer<VA_TYPE_2DTC>>(1 << 20, 1 << 21)
+		std::make_unique<TypedRenderBuffer<VA_TYPE_0   >>(1 << 16, 1 << 17, sbType),
+		std::make_unique<TypedRenderBuffer<VA_TYPE_C   >>(1 << 20, 1 << 21, sbType),
+		std::make_unique<TypedRenderBuffer<VA_TYPE_N   >>(1 << 10, 1 << 11, sbType),
+		std::make_unique<TypedRenderBuffer<VA_TYPE_T   >>(1 << 20, 1 << 21, sbType),
+		std::make_unique<TypedRenderBuffer<VA_TYPE_T4  >>(1 << 16, 1 << 18, sbType),
+		std::make_unique<TypedRenderBuffer<VA_TYPE_TN  >>(1 << 16, 1 << 17, sbType),
+		std::make_unique<TypedRenderBuffer<VA_TYPE_TC  >>(1 << 20, 1 << 21, sbType),
+		std::make_unique<TypedRenderBuffer<VA_TYPE_PROJ>>(1 << 20, 1 << 21, sbType),
+		std::make_unique<TypedRenderBuffer<VA_TYPE_TNT >>(0      , 0      , sbType),
+		std::make_unique<TypedRenderBuffer<VA_TYPE_2D0 >>(1 << 16, 1 << 17, sbType),
+		std::make_unique<TypedRenderBuffer<VA_TYPE_2DC >>(1 << 16, 1 << 17, sbType),
+		std::make_unique<TypedRenderBuffer<VA_TYPE_2DT >>(1 << 20, 1 << 21, sbType),
+		std::make_unique<TypedRenderBuffer<VA_TYPE_2DTC>>(1 << 20, 1 << 21, sbType)
 	};
 }
 
@@ -791,6 +791,14 @@ inline void TypedRenderBuffer<T>::UploadVBO()
 		LOG_L(L_DEBUG, "[TypedRenderBuffer<%s>::%s] Increase the number of elements here!", vboTypeName, __func__);
 		vbo->Resize(static_cast<uint32_t>(verts.capacity()));
 		vertCount0 = verts.capacity();
+
+		// persistently mapped storage is immutable and gets recreated on resize, so
+		// the VAO has to pick up the new buffer and all of this frame's data be resent
+		if (vbo->GetBufferImplementation() == IStreamBufferConcept::Types::SB_PERSISTENTMAP) {
+			InitVAO();
+			vboUploadIndex = 0;
+			elemsCount = verts.size();
+		}
 	}
 
 	//update on the GPU
@@ -817,6 +825,14 @@ inline void TypedRenderBuffer<T>::UploadEBO()
 		LOG_L(L_DEBUG, "[TypedRenderBuffer<%s>::%s] Increase the number of elements here!", vboTypeName, __func__);
 		ebo->Resize(static_cast<uint32_t>(indcs.capacity()));
 		elemCount0 = indcs.capacity();
+
+		// persistently mapped storage is immutable and gets recreated on resize, so
+		// the VAO has to pick up the new buffer and all of this frame's data be resent
+		if (ebo->GetBufferImplementation() == IStreamBufferConcept::Types::SB_PERSISTENTMAP) {
+			InitVAO();
+			eboUploadIndex = 0;
+			elemsCount = indcs.size();
+		}
 	}
 
 	//update on the GPU
@@ -885,7 +901,8 @@ inline void TypedRenderBuffer<T>::DrawElements(uint32_t mode, bool rewind)
 	assert(vao.GetIdRaw() > 0);
 #endif
 	vao.Bind();
-	glDrawElements(mode, static_cast<GLsizei>(indcsCount), GL_UNSIGNED_INT, BUFFER_OFFSET(uint32_t, ebo->BufferElemOffset() + eboStartIndex));
+	// indices are relative to the start of verts, the base vertex moves them into the current VBO section
+	glDrawElementsBaseVertex(mode, static_cast<GLsizei>(indcsCount), GL_UNSIGNED_INT, BUFFER_OFFSET(uint32_t, ebo->BufferElemOffset() + eboStartIndex), static_cast<GLint>(vbo->BufferElemOffset()));
 	vao.Unbind();
 	#undef BUFFER_OFFSET
 
@@ -212,7 +212,8 @@ CR_REG_METADATA(CGlobalRendering, (
 	CR_IGNORED(glContext),
 
 	CR_IGNORED(glExtensions),
-	CR_IGNORED(glTimerQueries)
+	CR_IGNORED(glTimerQueries),
+	CR_IGNORED(glTimerQueriesFrame)
 ))
 
 
@@ -340,6 +341,7 @@ CGlobalRendering::CGlobalRendering()
 	, glContext{nullptr}
 	, glExtensions{}
 	, glTimerQueries{0}
+	, glTimerQueriesFrame(0)
 {
 	verticalSync->WrapNotifyOnChange();
 	configHandler->NotifyOnChange(this, {
@@ -685,12 +687,21 @@ void CGlobalRendering::SwapBuffers(bool allowSwapBuffers, bool clearErrors)
 	globalRendering->lastSwapBuffersEnd = spring_now();
 }
 
-void CGlobalRendering::SetGLTimeStamp(uint32_t queryIdx) const
+void CGlobalRendering::SetGLTimeStamp(uint32_t queryIdx)
 {
 	if (!GLAD_GL_ARB_timer_query)
 		return;
 
 	glQueryCounter(glTimerQueries[(NUM_OPENGL_TIMER_QUERIES * (drawFrame & 1)) + queryIdx], GL_TIMESTAMP);
+
+	if (queryIdx == FRAME_END_TIME_QUERY_IDX)
+		glTimerQueriesFrame = drawFrame;
+}
+
+bool CGlobalRendering::HaveGLDeltaTimes() const
+{
+	// queries of frames that were skipped (e.g. loadscreen, minimized) never got issued
+	return (GLAD_GL_ARB_timer_query && (glTimerQueriesFrame + 1) == drawFrame);
 }
 
 uint64_t CGlobalRendering::CalcGLDeltaTime(uint32_t queryIdx0, uint32_t queryIdx1) const
@@ -53,8 +53,10 @@ public:
 
 	void SwapBuffers(bool allowSwapBuffers, bool clearErrors);
 
-	void SetGLTimeStamp(uint32_t queryIdx) const;
+	void SetGLTimeStamp(uint32_t queryIdx);
 	uint64_t CalcGLDeltaTime(uint32_t queryIdx0, uint32_t queryIdx1) const;
+	// true if the previous draw-frame issued a complete set of timer queries
+	bool HaveGLDeltaTimes() const;
 
 	void MakeCurrentContext(bool clear) const;
 
@@ -397,6 +399,8 @@ public:
 
 	static constexpr uint32_t NUM_OPENGL_TIMER_QUERIES = 8;
 	static constexpr uint32_t FRAME_REF_TIME_QUERY_IDX = 0;
+	static constexpr uint32_t WORLD_BEG_TIME_QUERY_IDX = 1;
+	static constexpr uint32_t WORLD_END_TIME_QUERY_IDX = 2;
 	static constexpr uint32_t FRAME_END_TIME_QUERY_IDX = NUM_OPENGL_TIMER_QUERIES - 1;
 private:
 	void SetMinSampleShadingRate();
@@ -405,6 +409,8 @@ private:
 	spring::unordered_set<std::string> glExtensions;
 	// double-buffered; results from frame N become available on frame N+1
 	std::array<uint32_t, NUM_OPENGL_TIMER_QUERIES * 2> glTimerQueries;
+	// draw-frame in which FRAME_END_TIME_QUERY_IDX was last issued
+	uint32_t glTimerQueriesFrame;
 private:
 	static constexpr inline const char* xsKeys[2] = { "XResolutionWindowed", "XResolution" };
 	static constexpr inline const char* ysKeys[2] = { "YResolutionWindowed", "YResolution" };
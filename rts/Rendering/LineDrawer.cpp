@@ -4,6 +4,7 @@
 
 #include "LineDrawer.h"
 
+#include <algorithm>
 #include <cmath>
 
 #include "Rendering/GlobalRendering.h"
@@ -21,9 +22,8 @@ CLineDrawer::CLineDrawer()
 	, lastPos(ZeroVector)
 	, lastColor(NULL)
 	, stippleTimer(0.0f)
+	, curBatch(&batches[BATCH_STRIPS])
 {
-	lines.reserve(32);
-	stippled.reserve(32);
 }
 
 
@@ -51,9 +51,11 @@ void CLineDrawer::SetupLineStipple()
 
 void CLineDrawer::DrawAll()
 {
-	if (lines.empty() && stippled.empty())
+	const auto IsEmpty = [](const LineBatch& b) { return b.verts.empty(); };
+
+	if (std::all_of(batches.begin(), batches.end(), IsEmpty))
 		return;
-	
+
 	glEnableClientState(GL_VERTEX_ARRAY);
 	glEnableClientState(GL_COLOR_ARRAY);
 
@@ -62,32 +64,30 @@ void CLineDrawer::DrawAll()
 	glDisable(GL_DEPTH_TEST);
 	glDisable(GL_LINE_STIPPLE);
 
-	for (int i = 0; i<lines.size(); ++i) {
-		int size = lines[i].colors.size();
-		if(size > 0) {
-			glColorPointer(4, GL_FLOAT, 0, &lines[i].colors[0]);
-			glVertexPointer(3, GL_FLOAT, 0, &lines[i].verts[0]);
-			glDrawArrays(lines[i].type, 0, size/4);
-		}
-	}
+	for (int i = 0; i < BATCH_COUNT; ++i) {
+		LineBatch& b = batches[i];
+
+		if (b.verts.empty())
+			continue;
+
+		if ((i & BATCH_STIPPLED_STRIPS) != 0)
+			glEnable(GL_LINE_STIPPLE);
 
-	if (!stippled.empty()) {
-		glEnable(GL_LINE_STIPPLE);
-		for (int i = 0; i<stippled.size(); ++i) {
-			int size = stippled[i].colors.size();
-			if(size > 0) {
-				glColorPointer(4, GL_FLOAT, 0, &stippled[i].colors[0]);
-				glVertexPointer(3, GL_FLOAT, 0, &stippled[i].verts[0]);
-				glDrawArrays(stippled[i].type, 0, size/4);
-			}
+		glColorPointer(4, GL_FLOAT, 0, b.colors.data());
+		glVertexPointer(3, GL_FLOAT, 0, b.verts.data());
+
+		if ((i & BATCH_LINES) != 0) {
+			glDrawArrays(GL_LINES, 0, b.verts.size() / 3);
+		} else {
+			glMultiDrawArrays(GL_LINE_STRIP, b.firsts.data(), b.counts.data(), b.firsts.size());
 		}
-		glDisable(GL_LINE_STIPPLE);
+
+		b.Clear();
 	}
 
+	glDisable(GL_LINE_STIPPLE);
+
 	glDisableClientState(GL_COLOR_ARRAY);
 	glDisableClientState(GL_VERTEX_ARRAY);
 	glPopAttrib();
-
-	lines.clear();
-	stippled.clear();
 }
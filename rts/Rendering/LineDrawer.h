@@ -45,15 +45,39 @@ class CLineDrawer {
 		
 		float stippleTimer;
 
-		// queue all lines and draw them in one go later
-		struct LinePair {
-			GLenum type;
+		// queue all lines and draw them in one go later; paths share one
+		// vertex array per batch instead of allocating their own, strips
+		// are submitted with a single glMultiDrawArrays
+		struct LineBatch {
+			void Clear() {
+				verts.clear();
+				colors.clear();
+				firsts.clear();
+				counts.clear();
+			}
+			void AddVertex(const float3& pos, const float* color) {
+				verts.insert(verts.end(), {pos.x, pos.y, pos.z});
+				colors.insert(colors.end(), color, color + 4);
+			}
+
 			std::vector<GLfloat> verts;
 			std::vector<GLfloat> colors;
+
+			// first vertex and vertex count of each GL_LINE_STRIP path
+			std::vector<GLint> firsts;
+			std::vector<GLsizei> counts;
+		};
+
+		enum {
+			BATCH_STRIPS          = 0,
+			BATCH_LINES           = 1,
+			BATCH_STIPPLED_STRIPS = 2,
+			BATCH_STIPPLED_LINES  = 3,
+			BATCH_COUNT           = 4,
 		};
 
-		std::vector<LinePair> lines;
-		std::vector<LinePair> stippled;
+		std::array<LineBatch, BATCH_COUNT> batches;
+		LineBatch* curBatch;
 };
 
 
@@ -90,28 +114,14 @@ inline void CLineDrawer::Break(const float3& endPos, const float* color)
 
 inline void CLineDrawer::Restart()
 {
-	LinePair *ptr;
-	if (lineStipple) {
-		stippled.push_back(LinePair());
-		ptr = &stippled.back();
-	} else {
-		lines.push_back(LinePair());
-		ptr = &lines.back();
-	}
-	LinePair& p = *ptr;
-
-	if (!useColorRestarts)	 {
-		p.type = GL_LINE_STRIP;
-		p.colors.push_back(lastColor[0]);
-		p.colors.push_back(lastColor[1]);
-		p.colors.push_back(lastColor[2]);
-		p.colors.push_back(lastColor[3]);
-		p.verts.push_back(lastPos[0]);
-		p.verts.push_back(lastPos[1]);
-		p.verts.push_back(lastPos[2]);
-	} else {
-		p.type = GL_LINES;
-	}
+	curBatch = &batches[lineStipple * BATCH_STIPPLED_STRIPS + useColorRestarts * BATCH_LINES];
+
+	if (useColorRestarts)
+		return;
+
+	curBatch->firsts.push_back(static_cast<GLint>(curBatch->verts.size() / 3));
+	curBatch->counts.push_back(1);
+	curBatch->AddVertex(lastPos, lastColor);
 }
 
 
@@ -140,45 +150,20 @@ inline void CLineDrawer::StartPath(const float3& pos, const float* color)
 
 inline void CLineDrawer::DrawLine(const float3& endPos, const float* color)
 {
-	LinePair *ptr;
-	if (lineStipple) {
-		ptr = &stippled.back();
-	} else {
-		ptr = &lines.back();
-	}
-	LinePair& p = *ptr;
+	LineBatch& b = *curBatch;
 
 	if (!useColorRestarts) {
-		p.colors.push_back(color[0]);
-		p.colors.push_back(color[1]);
-		p.colors.push_back(color[2]);
-		p.colors.push_back(color[3]);
-		p.verts.push_back(endPos.x);
-		p.verts.push_back(endPos.y);
-		p.verts.push_back(endPos.z);
+		b.AddVertex(endPos, color);
+		b.counts.back() += 1;
 	} else {
 		if (useRestartColor) {
-			p.colors.push_back(restartColor[0]);
-			p.colors.push_back(restartColor[1]);
-			p.colors.push_back(restartColor[2]);
-			p.colors.push_back(restartColor[3]);
+			b.AddVertex(lastPos, restartColor);
 		} else {
-			p.colors.push_back(color[0]);
-			p.colors.push_back(color[1]);
-			p.colors.push_back(color[2]);
-			p.colors.push_back(color[3] * restartAlpha);
+			const float fadedColor[4] = {color[0], color[1], color[2], color[3] * restartAlpha};
+			b.AddVertex(lastPos, fadedColor);
 		}
-		p.verts.push_back(lastPos.x);
-		p.verts.push_back(lastPos.y);
-		p.verts.push_back(lastPos.z);
-
-		p.colors.push_back(color[0]);
-		p.colors.push_back(color[1]);
-		p.colors.push_back(color[2]);
-		p.colors.push_back(color[3]);
-		p.verts.push_back(endPos.x);
-		p.verts.push_back(endPos.y);
-		p.verts.push_back(endPos.z);
+
+		b.AddVertex(endPos, color);
 	}
 
 	lastPos = endPos;
@@ -356,6 +356,12 @@ void LuaObjectDrawer::DrawMaterialBins(LuaObjType objType, LuaMatType matType, b
 
 	for (const auto& bin: bins) {
 		assert(matType == bin->type);
+
+		// a bin without visible objects only costs state changes, unless
+		// its material has a DrawMaterial callin
+		if (bin->GetObjects(objType).empty() && !bin->HasDrawCall())
+			continue;
+
 		DrawMaterialBin(bin, prevMat, objType, matType, deferredPass, inAlphaBin);
 		prevMat = bin;
 	}
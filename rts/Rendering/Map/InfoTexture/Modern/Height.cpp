@@ -28,6 +28,7 @@ CHeightTexture::CHeightTexture()
 	eventHandler.AddClient(this);
 
 	texSize = int2(mapDims.mapxp1, mapDims.mapyp1);
+	dirtyRect = SRectangle(0, 0, texSize.x - 1, texSize.y - 1);
 
 	{
 		GL::TextureCreationParams tcp{
@@ -107,8 +108,9 @@ void CHeightTexture::UpdateCPU()
 	const SColor* extraTexPal = CHeightLinePalette::GetData();
 	const float* heightMap = readMap->GetCornerHeightMapUnsynced();
 
-	for (int y = 0; y < texSize.y; ++y) {
-		for (int x = 0; x < texSize.x; ++x) {
+	// infoTexMem keeps the colors of the last update, only the dirty part is recomputed
+	for (int y = dirtyRect.z1; y <= dirtyRect.z2; ++y) {
+		for (int x = dirtyRect.x1; x <= dirtyRect.x2; ++x) {
 			const int idx = y * texSize.x + x;
 			const float height = heightMap[idx];
 			const auto value = static_cast<unsigned int>(height * 8.0f) % 255;
@@ -116,8 +118,9 @@ void CHeightTexture::UpdateCPU()
 		}
 	}
 
+	// upload whole rows, sub-row uploads would need an unpack row length
 	auto binding = texture.ScopedBind();
-	texture.UploadImage(infoTexMem.data());
+	texture.UploadSubImage(infoTexMem.data() + dirtyRect.z1 * texSize.x, 0, dirtyRect.z1, texSize.x, dirtyRect.GetHeight() + 1);
 }
 
 
@@ -135,12 +138,18 @@ void CHeightTexture::Update()
 
 	const auto hmTexID = readMap->GetHeightMapTexture();
 
-	if (!fbo.IsValid() || !shader->IsValid() || (hmTexID == 0))
-		return UpdateCPU();
+	if (!fbo.IsValid() || !shader->IsValid() || (hmTexID == 0)) {
+		UpdateCPU();
+		dirtyRect = SRectangle(texSize.x, texSize.y, -1, -1);
+		return;
+	}
 
+	// the pass still covers the whole viewport, the scissor box restricts it to the changed texels
 	using namespace GL::State;
 	auto state = GL::SubState(
-		Blending(GL_FALSE)
+		Blending(GL_FALSE),
+		ScissorTest(GL_TRUE),
+		Scissor(dirtyRect.x1, dirtyRect.z1, dirtyRect.GetWidth() + 1, dirtyRect.GetHeight() + 1)
 	);
 	auto binding = paletteTex.ScopedBind(1);
 
@@ -148,6 +157,8 @@ void CHeightTexture::Update()
 	glBindTexture(GL_TEXTURE_2D, hmTexID);
 
 	RunFullScreenPass();
+
+	dirtyRect = SRectangle(texSize.x, texSize.y, -1, -1);
 }
 
 
@@ -155,6 +166,12 @@ void CHeightTexture::UnsyncedHeightMapUpdate(const SRectangle& rect)
 {
 	RECOIL_DETAILED_TRACY_ZONE;
 	needUpdate = true;
+
+	// rect indexes the corner heightmap with inclusive bounds, clamp to be safe
+	dirtyRect.x1 = std::max(std::min(dirtyRect.x1, rect.x1), 0);
+	dirtyRect.z1 = std::max(std::min(dirtyRect.z1, rect.z1), 0);
+	dirtyRect.x2 = std::min(std::max(dirtyRect.x2, rect.x2), texSize.x - 1);
+	dirtyRect.z2 = std::min(std::max(dirtyRect.z2, rect.z2), texSize.y - 1);
 }
 
 
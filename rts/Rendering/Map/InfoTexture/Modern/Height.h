@@ -6,6 +6,7 @@
 #include "ModernInfoTexture.h"
 #include "Rendering/GL/FBO.h"
 #include "System/EventHandler.h"
+#include "System/Rectangle.h"
 
 
 namespace Shader {
@@ -40,6 +41,10 @@ private:
 
 private:
 	bool needUpdate;
+
+	// union of the heightmap rectangles changed since the last Update, in texels (inclusive)
+	SRectangle dirtyRect;
+
 	GL::Texture2D paletteTex;
 };
 
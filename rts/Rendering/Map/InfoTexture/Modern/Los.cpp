@@ -92,10 +92,21 @@ void CLosTexture::UpdateCPU()
 	infoTexMem.resize(texSize.x * texSize.y);
 
 	if (!losHandler->GetGlobalLOS(gu->myAllyTeam)) {
-		const auto& myLos = losHandler->los.losMaps[gu->myAllyTeam].GetLosMap();
-		for (int y = 0; y < texSize.y; ++y) {
-			for (int x = 0; x < texSize.x; ++x) {
-				infoTexMem[y * texSize.x + x] = (myLos[y * texSize.x + x] != 0) ? 0xFF : 0x00;
+		const auto& myLosBits = losHandler->los.losMaps[gu->myAllyTeam].GetLosBits();
+
+		// 64 squares per word, skip the ones entirely out of LOS
+		for (size_t w = 0, n = infoTexMem.size(); w < myLosBits.size(); ++w) {
+			const uint64_t bits = myLosBits[w];
+			const size_t i0 = w * 64;
+			const size_t i1 = std::min(i0 + 64, n);
+
+			if (bits == 0) {
+				std::fill(infoTexMem.begin() + i0, infoTexMem.begin() + i1, 0x00);
+				continue;
+			}
+
+			for (size_t i = i0; i < i1; ++i) {
+				infoTexMem[i] = ((bits >> (i - i0)) & 1) * 0xFF;
 			}
 		}
 	} else {
@@ -136,13 +136,26 @@ void S3DModelPiece::CreateShatterPieces()
 
 	shatterIndices.reserve(S3DModelPiecePart::SHATTER_VARIATIONS * indices.size());
 
+	// polygon directions are the same for every variation, only the part directions differ
+	std::vector<float3> polygonDirs;
+	polygonDirs.reserve(indices.size() / 3);
+
+	for (size_t i = 0; i < indices.size(); i += 3) {
+		float3 midPos;
+		midPos += GetVertexPos(indices[i + 0]);
+		midPos += GetVertexPos(indices[i + 1]);
+		midPos += GetVertexPos(indices[i + 2]);
+		midPos /= 3.0f;
+		polygonDirs.push_back(midPos.ANormalize());
+	}
+
 	for (int i = 0; i < S3DModelPiecePart::SHATTER_VARIATIONS; ++i) {
-		CreateShatterPiecesVariation(i);
+		CreateShatterPiecesVariation(i, polygonDirs);
 	}
 }
 
 
-void S3DModelPiece::CreateShatterPiecesVariation(int num)
+void S3DModelPiece::CreateShatterPiecesVariation(int num, const std::vector<float3>& polygonDirs)
 {
 	RECOIL_DETAILED_TRACY_ZONE;
 	using ShatterPartDataPair = std::pair<S3DModelPiecePart::RenderData, std::vector<uint32_t>>;
@@ -154,34 +167,22 @@ void S3DModelPiece::CreateShatterPiecesVariation(int num)
 		rd.dir = (guRNG.NextVector()).ANormalize();
 	}
 
-	// helper
-	const auto GetPolygonDir = [&](size_t idx)
-	{
-		float3 midPos;
-		midPos += GetVertexPos(indices[idx + 0]);
-		midPos += GetVertexPos(indices[idx + 1]);
-		midPos += GetVertexPos(indices[idx + 2]);
-		midPos /= 3.0f;
-		return midPos.ANormalize();
-	};
-
 	// add vertices to splitter parts
 	for (size_t i = 0; i < indices.size(); i += 3) {
-		const float3& dir = GetPolygonDir(i);
+		const float3& dir = polygonDirs[i / 3];
 
 		// find the closest shatter part (the one that points into same dir)
 		float md = -2.0f;
 
 		ShatterPartDataPair* mcp = nullptr;
-		const S3DModelPiecePart::RenderData* rd = nullptr;
 
 		for (ShatterPartDataPair& cp: shatterPartsBuf) {
-			rd = &cp.first;
+			const float d = cp.first.dir.dot(dir);
 
-			if (rd->dir.dot(dir) < md)
+			if (d < md)
 				continue;
 
-			md = rd->dir.dot(dir);
+			md = d;
 			mcp = &cp;
 		}
 
@@ -235,6 +236,66 @@ void S3DModelPiece::CreateShatterPiecesVariation(int num)
 }
 
 
+void S3DModelPiece::CreateLODIndices()
+{
+	RECOIL_DETAILED_TRACY_ZONE;
+	// pieces this small are not worth simplifying
+	static constexpr size_t LOD_MIN_INDICES = 3 * 128;
+	static constexpr int LOD_GRID_CELLS = 16;
+
+	if (!HasGeometryData() || indices.size() < LOD_MIN_INDICES)
+		return;
+
+	// cluster the vertices on a regular grid spanning the piece, every cell
+	// is represented by the first vertex that falls into it; all vertices of
+	// a piece share its bone so the result needs no new vertex data
+	float3 vMins = GetVertexPos(0);
+	float3 vMaxs = GetVertexPos(0);
+
+	for (const SVertexData& v: vertices) {
+		vMins = float3::min(vMins, v.pos);
+		vMaxs = float3::max(vMaxs, v.pos);
+	}
+
+	const float3 cellScale = float3(LOD_GRID_CELLS) / float3::max(vMaxs - vMins, float3(0.001f));
+
+	spring::unordered_map<uint32_t, uint32_t> cellVerts;
+	std::vector<uint32_t> vertRemap(vertices.size());
+
+	for (size_t i = 0; i < vertices.size(); i++) {
+		const float3 cellPos = (vertices[i].pos - vMins) * cellScale;
+		const uint32_t cx = std::clamp(static_cast<int>(cellPos.x), 0, LOD_GRID_CELLS - 1);
+		const uint32_t cy = std::clamp(static_cast<int>(cellPos.y), 0, LOD_GRID_CELLS - 1);
+		const uint32_t cz = std::clamp(static_cast<int>(cellPos.z), 0, LOD_GRID_CELLS - 1);
+
+		vertRemap[i] = cellVerts.emplace((cz * LOD_GRID_CELLS + cy) * LOD_GRID_CELLS + cx, static_cast<uint32_t>(i)).first->second;
+	}
+
+	lodIndices.clear();
+	lodIndices.reserve(indices.size());
+
+	for (size_t i = 0; i < indices.size(); i += 3) {
+		const uint32_t a = vertRemap[indices[i + 0]];
+		const uint32_t b = vertRemap[indices[i + 1]];
+		const uint32_t c = vertRemap[indices[i + 2]];
+
+		// triangles collapsed into a line or point
+		if (a == b || b == c || c == a)
+			continue;
+
+		lodIndices.push_back(a);
+		lodIndices.push_back(b);
+		lodIndices.push_back(c);
+	}
+
+	// keep drawing the full mesh if clustering did not remove enough
+	if (lodIndices.size() * 4 > indices.size() * 3)
+		lodIndices.clear();
+
+	lodIndices.shrink_to_fit();
+}
+
+
 void S3DModelPiece::Shatter(float pieceChance, int modelType, int texType, int team, const float3 pos, const float3 speed, const CMatrix44f& m) const
 {
 	RECOIL_DETAILED_TRACY_ZONE;
@@ -310,6 +371,13 @@ void S3DModelPiece::ReleaseShatterIndices()
 	shatterIndices.clear();
 }
 
+void S3DModelPiece::ReleaseLODIndices()
+{
+	RECOIL_DETAILED_TRACY_ZONE;
+	lodIndices.clear();
+	lodIndices.shrink_to_fit();
+}
+
 /** ****************************************************************************************************
  * LocalModel
  */
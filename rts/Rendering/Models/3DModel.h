@@ -173,6 +173,7 @@ struct S3DModelPiece {
 		vertices.clear();
 		indices.clear();
 		shatterIndices.clear();
+		lodIndices.clear();
 
 		parent = nullptr;
 		colvol = {};
@@ -213,6 +214,7 @@ public:
 	void DrawStaticLegacyRec() const;
 
 	void CreateShatterPieces();
+	void CreateLODIndices();
 	void Shatter(float, int, int, int, const float3, const float3, const CMatrix44f&) const;
 
 	void SetPieceTransform(const Transform& parentTra);
@@ -232,16 +234,18 @@ public:
 	const S3DModel* GetParentModel() const { return model; }
 
 	void ReleaseShatterIndices();
+	void ReleaseLODIndices();
 
 	const std::vector<SVertexData>& GetVerticesVec() const { return vertices; }
 	const std::vector<uint32_t>& GetIndicesVec() const { return indices; }
 	const std::vector<uint32_t>& GetShatterIndicesVec() const { return shatterIndices; }
+	const std::vector<uint32_t>& GetLODIndicesVec() const { return lodIndices; }
 
 	std::vector<SVertexData>& GetVerticesVec() { return vertices; }
 	std::vector<uint32_t>& GetIndicesVec() { return indices; }
 	std::vector<uint32_t>& GetShatterIndicesVec() { return shatterIndices; }
 private:
-	void CreateShatterPiecesVariation(int num);
+	void CreateShatterPiecesVariation(int num, const std::vector<float3>& polygonDirs);
 public:
 	std::string name;
 	std::vector<S3DModelPiece*> children;
@@ -267,6 +271,8 @@ protected:
 	std::vector<SVertexData> vertices;
 	std::vector<uint32_t> indices;
 	std::vector<uint32_t> shatterIndices;
+	// simplified triangle list over the same vertices, empty if not worth it
+	std::vector<uint32_t> lodIndices;
 
 	S3DModel* model;
 
@@ -290,6 +296,8 @@ struct S3DModel
 
 		, indxStart(~0u)
 		, indxCount(0u)
+		, lodIndxStart(~0u)
+		, lodIndxCount(0u)
 
 		, type(MODELTYPE_CNT)
 
@@ -330,6 +338,8 @@ struct S3DModel
 
 		indxStart = m.indxStart;
 		indxCount = m.indxCount;
+		lodIndxStart = m.lodIndxStart;
+		lodIndxCount = m.lodIndxCount;
 
 		pieceObjects.swap(m.pieceObjects);
 
@@ -393,6 +403,10 @@ public:
 
 	uint32_t indxStart; //global VBO offset, size data
 	uint32_t indxCount;
+	uint32_t lodIndxStart; //simplified geometry, same as indx* if there is none
+	uint32_t lodIndxCount;
+
+	bool HasLODGeometry() const { return (lodIndxStart != indxStart); }
 
 	ModelType type;
 
@@ -5,15 +5,21 @@
 #include <algorithm>
 #include <iterator>
 
+#include "Game/Camera.h"
+#include "Game/CameraHandler.h"
+#include "Rendering/GlobalRendering.h"
 #include "Rendering/Models/3DModel.h"
 #include "Rendering/Models/IModelParser.h"
 #include "Rendering/ModelsDataUploader.h"
 #include "Sim/Units/Unit.h"
 #include "Sim/Units/UnitDef.h"
 #include "Sim/Features/Feature.h"
+#include "System/Config/ConfigHandler.h"
 
 #include "System/Misc/TracyDefs.h"
 
+CONFIG(float, ModelLODScreenRadius).defaultValue(0.0f).minimumValue(0.0f).description("Units and features whose projected radius is smaller than this many pixels are drawn with an automatically simplified mesh. 0 disables generating and using simplified meshes.");
+
 
 void S3DModelVAO::EnableAttribs(bool inst) const
 {
@@ -65,6 +71,8 @@ S3DModelVAO::S3DModelVAO()
 	instVBO.Bind();
 	instVBO.New(S3DModelVAO::INSTANCE_BUFFER_NUM_ELEMS * sizeof(SInstanceData), GL_STREAM_DRAW);
 	instVBO.Unbind();
+
+	lodScreenRadius = configHandler->GetFloat("ModelLODScreenRadius");
 }
 
 void S3DModelVAO::ProcessVertices(const S3DModel* model)
@@ -133,6 +141,33 @@ void S3DModelVAO::ProcessIndicies(S3DModel* model)
 
 		std::for_each(begIdx, endIdx, [offset = modelPiece->vertIndex](uint32_t& indx) { indx += offset; }); // add per piece vertex offset to indices
 	}
+
+	model->lodIndxStart = model->indxStart;
+	model->lodIndxCount = model->indxCount;
+
+	const auto HasLODIndices = [](const S3DModelPiece* p) { return !p->GetLODIndicesVec().empty(); };
+
+	if (std::none_of(model->pieceObjects.begin(), model->pieceObjects.end(), HasLODIndices))
+		return;
+
+	//add simplified indices to the end of indxData, pieces without any fall back to their full geometry
+	model->lodIndxStart = static_cast<uint32_t>(indxData.size());
+
+	for (const auto* modelPiece : model->pieceObjects) {
+		if (!modelPiece->HasGeometryData())
+			continue;
+
+		const auto& mdlPcsLODIndcs = HasLODIndices(modelPiece)? modelPiece->GetLODIndicesVec(): modelPiece->GetIndicesVec();
+
+		indxData.insert(indxData.end(), mdlPcsLODIndcs.begin(), mdlPcsLODIndcs.end()); //append
+
+		const auto endIdx = indxData.end();
+		const auto begIdx = endIdx - mdlPcsLODIndcs.size();
+
+		std::for_each(begIdx, endIdx, [offset = modelPiece->vertIndex](uint32_t& indx) { indx += offset; }); // add per piece vertex offset to indices
+	}
+
+	model->lodIndxCount = static_cast<uint32_t>(indxData.size() - model->lodIndxStart);
 }
 
 void S3DModelVAO::CreateVAO()
@@ -283,6 +318,26 @@ void S3DModelVAO::DrawElements(GLenum prim, uint32_t vboIndxStart, uint32_t vboI
 	glDrawElements(prim, vboIndxCount, GL_UNSIGNED_INT, indxVBO.GetPtr(vboIndxStart * sizeof(uint32_t)));
 }
 
+template<typename TObj>
+bool S3DModelVAO::UseLODGeometry(const TObj* obj) const
+{
+	if (lodScreenRadius <= 0.0f)
+		return false;
+
+	const S3DModel* model = obj->model;
+
+	if (!model->HasLODGeometry())
+		return false;
+
+	// judged from the player camera in every pass so shadows match the visible mesh
+	const CCamera* playerCam = CCameraHandler::GetCamera(CCamera::CAMTYPE_PLAYER);
+
+	// projected radius in pixels ~= radius * (viewSizeY / 2) / (distance * tan(fov / 2))
+	const float pixelRadius = model->GetDrawRadius() * globalRendering->viewSizeY * 0.5f / playerCam->GetTanHalfFov();
+
+	return ((pixelRadius * pixelRadius) < (lodScreenRadius * lodScreenRadius) * playerCam->GetPos().SqDistance(obj->drawMidPos));
+}
+
 template<typename TObj>
 bool S3DModelVAO::AddToSubmissionImpl(const TObj* obj, uint32_t indexStart, uint32_t indexCount, uint8_t teamID, uint8_t drawFlags)
 {
@@ -336,6 +391,9 @@ bool S3DModelVAO::AddToSubmission(const CUnit* unit)
 	const S3DModel* model = unit->model;
 	assert(model);
 
+	if (UseLODGeometry(unit))
+		return AddToSubmissionImpl(unit, model->lodIndxStart, model->lodIndxCount, unit->team, unit->drawFlag);
+
 	return AddToSubmissionImpl(unit, model->indxStart, model->indxCount, unit->team, unit->drawFlag);
 }
 
@@ -347,6 +405,9 @@ bool S3DModelVAO::AddToSubmission(const CFeature* feature)
 	const S3DModel* model = feature->model;
 	assert(model);
 
+	if (UseLODGeometry(feature))
+		return AddToSubmissionImpl(feature, model->lodIndxStart, model->lodIndxCount, feature->team, feature->drawFlag);
+
 	return AddToSubmissionImpl(feature, model->indxStart, model->indxCount, feature->team, feature->drawFlag);
 }
 
@@ -375,6 +436,8 @@ void S3DModelVAO::Submit(GLenum mode, bool bindUnbind)
 	allRenderModelData.clear();
 
 	for (const auto& [indxCount, renderModelData] : modelDataToInstance) {
+		if (renderModelData.empty())
+			continue;
 		if (allRenderModelData.size() + renderModelData.size() >= INSTANCE_BUFFER_NUM_BATCHED)
 			continue;
 
@@ -392,8 +455,10 @@ void S3DModelVAO::Submit(GLenum mode, bool bindUnbind)
 		batchedBaseInstance += renderModelData.size();
 	}
 
-	if (submitCmds.empty())
+	if (submitCmds.empty()) {
+		ClearSubmission();
 		return;
+	}
 
 	instVBO.Bind();
 	instVBO.SetBufferSubData(allRenderModelData);
@@ -407,7 +472,17 @@ void S3DModelVAO::Submit(GLenum mode, bool bindUnbind)
 	if (bindUnbind)
 		Unbind();
 
-	modelDataToInstance.clear();
+	ClearSubmission();
+}
+
+void S3DModelVAO::ClearSubmission()
+{
+	// keep the per-model entries and their capacity; the set of drawn models
+	// hardly changes between frames, so clearing the map would only make every
+	// Submit reallocate all instance vectors
+	for (auto& [indxCount, renderModelData] : modelDataToInstance) {
+		renderModelData.clear();
+	}
 }
 
 template<typename TObj>
@@ -104,13 +104,20 @@ private:
 		uint8_t teamID,
 		uint8_t drawFlags
 	);
+	template<typename TObj>
+	bool UseLODGeometry(const TObj* obj) const;
+
 	void EnableAttribs(bool inst) const;
 	void DisableAttribs() const;
+	void ClearSubmission();
 private:
 	inline static std::unique_ptr<S3DModelVAO> instance = nullptr;
 private:
 	bool safeToDeleteVectors = false;
 
+	// objects smaller than this many pixels on screen use simplified geometry, 0 disables
+	float lodScreenRadius = 0.0f;
+
 	uint32_t batchedBaseInstance   = 0;
 	uint32_t immediateBaseInstance = 0; //note relative index
 
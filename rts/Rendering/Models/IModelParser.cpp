@@ -15,6 +15,7 @@
 #include "Rendering/Textures/S3OTextureHandler.h"
 #include "Net/Protocol/NetProtocol.h" // NETLOG
 #include "Sim/Misc/CollisionVolume.h"
+#include "System/Config/ConfigHandler.h"
 #include "System/FileSystem/FileHandler.h"
 #include "System/FileSystem/FileSystem.h"
 #include "System/Log/ILog.h"
@@ -148,6 +149,8 @@ void CModelLoader::Init()
 	RegisterModelFormats(parsers);
 	InitParsers();
 
+	createLODs = (configHandler->GetFloat("ModelLODScreenRadius") > 0.0f);
+
 	models.clear();
 	models.resize(MAX_MODEL_OBJECTS);
 
@@ -379,13 +382,11 @@ void CModelLoader::DrainPreloadFutures(uint32_t numAllowed)
 	// collect completed futures
 	std::erase_if(preloadFutures, erasePredicate);
 
-	if (preloadFutures.size() <= numAllowed)
-		return;
-
+	// block on the oldest outstanding future rather than polling with a fixed
+	// sleep, which could idle for most of its period after the last one ended
 	while (preloadFutures.size() > numAllowed) {
-		//drain queue until there are <= numAllowed items there
+		preloadFutures.front().wait();
 		std::erase_if(preloadFutures, erasePredicate);
-		spring_sleep(spring_msecs(100));
 	}
 }
 
@@ -444,6 +445,9 @@ void CModelLoader::PostProcessGeometry(S3DModel* model)
 		auto* p = model->pieceObjects[i];
 		p->PostProcessGeometry(static_cast<uint32_t>(i));
 		p->CreateShatterPieces();
+
+		if (createLODs)
+			p->CreateLODIndices();
 	}
 	{
 		auto lock = CModelsLock::GetScopedLock(); // working with S3DModelVAO needs locking
@@ -475,6 +479,7 @@ void CModelLoader::Upload(S3DModel* model) const {
 
 	for (auto* p : model->pieceObjects) {
 		p->ReleaseShatterIndices();
+		p->ReleaseLODIndices();
 	}
 
 	// warn about models with bad normals (they break lighting)
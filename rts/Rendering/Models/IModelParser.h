@@ -59,6 +59,9 @@ private:
 
 	std::condition_variable_any cv;
 
+	// generate simplified geometry for distant objects (ModelLODScreenRadius)
+	bool createLODs = false;
+
 	//can't be weak_ptr here, because in that case there are no owners left for futures. preloadFutures needs to own futures
 	std::vector<std::shared_future<void>> preloadFutures;
 
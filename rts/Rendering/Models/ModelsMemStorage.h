@@ -33,7 +33,19 @@ public:
 	template<typename MyTypeLike = MyType> // to force universal references
 	bool UpdateIfChanged(std::size_t idx, MyTypeLike&& newValue, EqualCmpFunctor eqCmp) {
 		auto lock = CModelsLock::GetScopedLock();
+		return UpdateIfChangedUnlocked(idx, std::forward<MyTypeLike>(newValue), eqCmp);
+	}
 
+	template<typename MyTypeLike = MyType> // to force universal references
+	void UpdateForced(std::size_t idx, MyTypeLike&& newValue) {
+		auto lock = CModelsLock::GetScopedLock();
+		UpdateForcedUnlocked(idx, std::forward<MyTypeLike>(newValue));
+	}
+
+	// the *Unlocked versions expect the caller to hold CModelsLock, so that
+	// updating all transforms of one object only needs to take it once
+	template<typename MyTypeLike = MyType> // to force universal references
+	bool UpdateIfChangedUnlocked(std::size_t idx, MyTypeLike&& newValue, EqualCmpFunctor eqCmp) {
 		using DT = StablePosAllocator<MyType>;
 		const auto& curValue = const_cast<const DT&>(storage)[idx];
 		if (eqCmp(curValue, newValue))
@@ -49,9 +61,7 @@ public:
 	}
 
 	template<typename MyTypeLike = MyType> // to force universal references
-	void UpdateForced(std::size_t idx, MyTypeLike&& newValue) {
-		auto lock = CModelsLock::GetScopedLock();
-
+	void UpdateForcedUnlocked(std::size_t idx, MyTypeLike&& newValue) {
 		updateList.SetUpdate(idx);
 		auto& mutValue = storage[idx];
 		mutValue = newValue;
@@ -122,10 +132,6 @@ public:
 
 	template<typename MyTypeLike = TransformsMemStorage::MyType> // to force universal references
 	bool UpdateIfChanged(std::size_t offset, MyTypeLike&& newValue) {
-		static const auto EqCmp = [](const TransformsMemStorage::MyType& lhs, const TransformsMemStorage::MyType& rhs) {
-			return lhs.equals(rhs);
-		};
-
 		assert(firstElem != TransformsMemStorage::INVALID_INDEX);
 		assert(offset >= 0 && offset < numElems);
 
@@ -139,12 +145,32 @@ public:
 
 		transformsMemStorage.UpdateForced(firstElem + offset, std::forward<MyTypeLike>(newValue));
 	}
+
+	template<typename MyTypeLike = TransformsMemStorage::MyType> // to force universal references
+	bool UpdateIfChangedUnlocked(std::size_t offset, MyTypeLike&& newValue) {
+		assert(firstElem != TransformsMemStorage::INVALID_INDEX);
+		assert(offset >= 0 && offset < numElems);
+
+		return transformsMemStorage.UpdateIfChangedUnlocked(firstElem + offset, std::forward<MyTypeLike>(newValue), EqCmp);
+	}
+
+	template<typename MyTypeLike = TransformsMemStorage::MyType> // to force universal references
+	void UpdateForcedUnlocked(std::size_t offset, MyTypeLike&& newValue) {
+		assert(firstElem != TransformsMemStorage::INVALID_INDEX);
+		assert(offset >= 0 && offset < numElems);
+
+		transformsMemStorage.UpdateForcedUnlocked(firstElem + offset, std::forward<MyTypeLike>(newValue));
+	}
 public:
 	static const ScopedTransformMemAlloc& Dummy() {
 		static ScopedTransformMemAlloc dummy;
 
 		return dummy;
 	};
+private:
+	static bool EqCmp(const TransformsMemStorage::MyType& lhs, const TransformsMemStorage::MyType& rhs) {
+		return lhs.equals(rhs);
+	}
 private:
 	std::size_t firstElem = TransformsMemStorage::INVALID_INDEX;
 	std::size_t numElems  = 0u;
@@ -2,6 +2,8 @@
 
 #include "Screenshot.h"
 
+#include <cstring>
+#include <memory>
 #include <vector>
 
 #include "Rendering/GL/myGL.h"
@@ -28,8 +30,72 @@ struct FunctionArgs
 	int y;
 };
 
+// readbacks go through a PBO and are only mapped once their fence passed,
+// so taking a screenshot does not wait on the GPU finishing the frame
+struct PendingScreenshot
+{
+	FunctionArgs args;
+	GLuint pbo = 0;
+	GLsync fence = nullptr;
+};
+
+static constexpr size_t MAX_PENDING_SCREENSHOTS = 4;
+
+static std::vector<PendingScreenshot> pending;
 static std::shared_future<void> fut = {};
 
+
+static void SaveScreenshot(PendingScreenshot& ps)
+{
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, ps.pbo);
+
+	if (const void* pixels = glMapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY); pixels != nullptr) {
+		ps.args.pixelbuf.resize(ps.args.x * ps.args.y * 4);
+		std::memcpy(ps.args.pixelbuf.data(), pixels, ps.args.pixelbuf.size());
+		glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+	}
+
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+	glDeleteBuffers(1, &ps.pbo);
+	glDeleteSync(ps.fence);
+
+	if (ps.args.pixelbuf.empty()) {
+		LOG_L(L_WARNING, "[%s] could not read back pixels for \"%s\"", __func__, ps.args.filename.c_str());
+		return;
+	}
+
+	if (fut.valid()) {
+		fut.get();
+		fut = {};
+	}
+
+	// shared rather than captured by value, Enqueue copies its functor
+	fut = ThreadPool::Enqueue([args = std::make_shared<FunctionArgs>(std::move(ps.args))]() {
+		CBitmap bmp(&args->pixelbuf[0], args->x, args->y);
+		bmp.ReverseYAxis();
+		bmp.Save(args->filename, true, true, args->quality);
+	});
+}
+
+void UpdateScreenshots()
+{
+	if (pending.empty())
+		return;
+
+	// fences signal in submission order
+	size_t numDone = 0;
+
+	for (PendingScreenshot& ps: pending) {
+		if (glClientWaitSync(ps.fence, 0, 0) == GL_TIMEOUT_EXPIRED)
+			break;
+
+		SaveScreenshot(ps);
+		numDone++;
+	}
+
+	pending.erase(pending.begin(), pending.begin() + numDone);
+}
+
 void TakeScreenshot(std::string type, unsigned quality)
 {
 	if (type.empty())
@@ -38,12 +104,14 @@ void TakeScreenshot(std::string type, unsigned quality)
 	if (!FileSystem::CreateDirectory("screenshots"))
 		return;
 
-	if (fut.valid()) {
-		fut.get();
-		fut = {};
+	if (pending.size() >= MAX_PENDING_SCREENSHOTS) {
+		glClientWaitSync(pending.front().fence, GL_SYNC_FLUSH_COMMANDS_BIT, GL_TIMEOUT_IGNORED);
+		SaveScreenshot(pending.front());
+		pending.erase(pending.begin());
 	}
 
-	FunctionArgs args;
+	PendingScreenshot& ps = pending.emplace_back();
+	FunctionArgs& args = ps.args;
 	args.x  = globalRendering->winSizeX;
 	args.y  = globalRendering->winSizeY;
 	args.x += ((4 - (args.x % 4)) * int((args.x % 4) != 0));
@@ -53,13 +121,13 @@ void TakeScreenshot(std::string type, unsigned quality)
 	const std::string curTime = CTimeUtil::GetCurrentTimeStr(true);
 	args.filename.assign("screenshots/screen_" + curTime + "." + type);
 	args.quality = quality;
-	args.pixelbuf.resize(args.x * args.y * 4);
 
-	glReadPixels(0, 0, args.x, args.y, GL_RGBA, GL_UNSIGNED_BYTE, &args.pixelbuf[0]);
+	glGenBuffers(1, &ps.pbo);
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, ps.pbo);
+	glBufferData(GL_PIXEL_PACK_BUFFER, args.x * args.y * 4, nullptr, GL_STREAM_READ);
+	glReadPixels(0, 0, args.x, args.y, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
 
-	fut = ThreadPool::Enqueue([](const FunctionArgs& args) {
-		CBitmap bmp(&args.pixelbuf[0], args.x, args.y);
-		bmp.ReverseYAxis();
-		bmp.Save(args.filename, true, true, args.quality);
-	}, args);
+	ps.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	glFlush();
 }
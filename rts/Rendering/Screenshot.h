@@ -6,5 +6,7 @@
 #include <string>
 
 void TakeScreenshot(std::string type, unsigned quality);
+// hands finished readbacks of earlier TakeScreenshot calls to the encoder, once per frame
+void UpdateScreenshots();
 
 #endif
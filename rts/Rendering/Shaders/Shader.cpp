@@ -4,6 +4,7 @@
 #include "Rendering/Shaders/ShaderHandler.h"
 #include "Rendering/Shaders/LuaShaderContainer.h"
 #include "Rendering/Shaders/GLSLCopyState.h"
+#include "Rendering/Shaders/ShaderBinaryCache.h"
 #include "Rendering/GL/myGL.h"
 #include "Rendering/GlobalRendering.h"
 
@@ -119,6 +120,14 @@ namespace Shader {
 		return hash;
 	}
 
+	uint64_t IShaderObject::GetBinaryCacheHash(uint64_t seed) const {
+		uint64_t hash = XXH3_64bits_withSeed(&type, sizeof(type), seed);
+		hash = XXH3_64bits_withSeed(   srcText.data(),    srcText.size(), hash);
+		hash = XXH3_64bits_withSeed(rawDefStrs.data(), rawDefStrs.size(), hash);
+		hash = XXH3_64bits_withSeed(modDefStrs.data(), modDefStrs.size(), hash);
+		return hash;
+	}
+
 	std::string IShaderObject::GetShaderSource(const std::string& fileName)
 	{
 		if (fileName.find("void main()") != std::string::npos)
@@ -643,7 +652,13 @@ namespace Shader {
 			}
 		}
 
-		// recompile if not found in cache (id 0)
+		// in-memory cache miss, try the on-disk binary cache
+		const uint64_t binaryCacheKey = (objID == 0)? GetBinaryCacheKey(): 0;
+
+		if (binaryCacheKey != 0)
+			objID = ShaderBinaryCache::LoadProgram(binaryCacheKey);
+
+		// recompile if not found in either cache (id 0)
 		if (objID == 0) {
 			objID = glCreateProgram();
 
@@ -672,6 +687,9 @@ namespace Shader {
 				glBindFragDataLocation(objID, index, name.c_str());
 			}
 
+			if (binaryCacheKey != 0)
+				glProgramParameteri(objID, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+
 			glLinkProgram(objID);
 
 			valid = glslIsValid(objID);
@@ -681,6 +699,9 @@ namespace Shader {
 				LOG_L(L_WARNING, "[GLSL-PO::%s] program-object name: %s, link-log:\n%s\n", __func__, name.c_str(), log.c_str());
 			}
 
+			if (IsValid() && binaryCacheKey != 0)
+				ShaderBinaryCache::SaveProgram(binaryCacheKey, objID);
+
 			#ifdef _DEBUG
 			if (IsValid()) {
 				for (const auto& [name, index] : attribLocations) {
@@ -739,6 +760,32 @@ namespace Shader {
 			glDeleteProgram(oldProgID);
 	}
 
+	uint64_t GLSLProgramObject::GetBinaryCacheKey() const {
+		if (!ShaderBinaryCache::IsEnabled())
+			return 0;
+
+		uint64_t key = ShaderBinaryCache::GetKeySeed();
+
+		for (const IShaderObject* so: shaderObjs) {
+			key = so->GetBinaryCacheHash(key);
+		}
+
+		// locations are baked into the binary; combine order-independently
+		// since the maps do not guarantee any iteration order
+		uint64_t locsHash = 0;
+
+		for (const auto& [name, index] : attribLocations) {
+			locsHash += XXH3_64bits_withSeed(name.data(), name.size(), index);
+		}
+		for (const auto& [name, index] : outputLocations) {
+			locsHash += XXH3_64bits_withSeed(name.data(), name.size(), ~uint64_t(index));
+		}
+
+		key ^= locsHash;
+		// 0 means "not cached"
+		return key + (key == 0);
+	}
+
 	int GLSLProgramObject::GetUniformType(const int idx) {
 		GLint size = 0;
 		GLenum type = 0;
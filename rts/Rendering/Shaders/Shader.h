@@ -52,6 +52,8 @@ namespace Shader {
 		unsigned int GetObjID() const { return objID; }
 		unsigned int GetType() const { return type; }
 		unsigned int GetHash() const;
+		// wider hash of type, source and definitions for the on-disk binary cache
+		uint64_t GetBinaryCacheHash(uint64_t seed) const;
 
 		const std::string& GetLog() const { return log; }
 
@@ -492,6 +494,9 @@ namespace Shader {
 		void SetUniformMatrix3x3(UniformState* uState, bool transp, const float*  v) override;
 		void SetUniformMatrix4x4(UniformState* uState, bool transp, const float*  v) override;
 
+	private:
+		uint64_t GetBinaryCacheKey() const;
+
 	private:
 		std::vector<size_t> uniformLocs;
 		unsigned int curSrcHash;
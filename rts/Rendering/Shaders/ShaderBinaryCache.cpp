@@ -0,0 +1,159 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "ShaderBinaryCache.h"
+#include "Rendering/GL/myGL.h"
+#include "Rendering/GlobalRenderingInfo.h"
+#include "System/Config/ConfigHandler.h"
+#include "System/FileSystem/DataDirsAccess.h"
+#include "System/FileSystem/FileQueryFlags.h"
+#include "System/FileSystem/FileSystem.h"
+#include "System/Log/ILog.h"
+#include "System/SpringHash.h"
+
+#include "System/Misc/TracyDefs.h"
+
+
+#define LOG_SECTION_SHADER "Shader"
+LOG_REGISTER_SECTION_GLOBAL(LOG_SECTION_SHADER)
+
+// use the specific section for all LOG*() calls in this source file
+#ifdef LOG_SECTION_CURRENT
+	#undef LOG_SECTION_CURRENT
+#endif
+#define LOG_SECTION_CURRENT LOG_SECTION_SHADER
+
+
+CONFIG(bool, UseShaderBinaryCache).defaultValue(true).description("Store linked shader programs on disk and reuse them on the next start if neither their sources nor the driver changed, instead of compiling them again.");
+
+
+static constexpr uint32_t SHADER_BINARY_CACHE_VERSION = 1;
+
+namespace Shader::ShaderBinaryCache {
+	static std::string GetCacheFileName(uint64_t key)
+	{
+		const char sep = FileSystemAbstraction::GetNativePathSeparator();
+		const std::string dir = dataDirsAccess.LocateDir(FileSystem::GetCacheDir() + sep + "shaders" + sep, FileQueryFlags::WRITE | FileQueryFlags::CREATE_DIRS);
+
+		char keyStr[32];
+		snprintf(keyStr, sizeof(keyStr), "%016llx", static_cast<unsigned long long>(key));
+
+		return (dir + keyStr + ".bin");
+	}
+
+	bool IsEnabled()
+	{
+	#ifndef HEADLESS
+		// some drivers expose the extension without supporting any binary format
+		static const bool supported = [] {
+			if (!GLAD_GL_ARB_get_program_binary)
+				return false;
+
+			GLint numFormats = 0;
+			glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &numFormats);
+			return (numFormats > 0);
+		}();
+
+		return (supported && configHandler->GetBool("UseShaderBinaryCache"));
+	#else
+		return false;
+	#endif
+	}
+
+	uint64_t GetKeySeed()
+	{
+		static const uint64_t seed = [] {
+			const std::string driverStr = std::string(globalRenderingInfo.glVendor) + "\n" + globalRenderingInfo.glRenderer + "\n" + globalRenderingInfo.glVersion + "\n" + globalRenderingInfo.glslVersion;
+			return XXH3_64bits_withSeed(driverStr.data(), driverStr.size(), SHADER_BINARY_CACHE_VERSION);
+		}();
+
+		return seed;
+	}
+
+	GLuint LoadProgram(uint64_t key)
+	{
+		RECOIL_DETAILED_TRACY_ZONE;
+		FILE* file = fopen(GetCacheFileName(key).c_str(), "rb");
+
+		if (file == nullptr)
+			return 0;
+
+		uint64_t fileKey = 0;
+		uint32_t header[3] = {0, 0, 0}; // version, format, size
+		std::vector<uint8_t> binary;
+
+		bool success = true;
+		success = success && (fread(&fileKey, sizeof(fileKey), 1, file) == 1);
+		success = success && (fread(&header[0], sizeof(header), 1, file) == 1);
+		success = success && (fileKey == key && header[0] == SHADER_BINARY_CACHE_VERSION && header[2] > 0);
+
+		if (success) {
+			binary.resize(header[2]);
+			success = (fread(binary.data(), binary.size(), 1, file) == 1);
+		}
+
+		fclose(file);
+
+		if (!success)
+			return 0;
+
+		const GLuint progID = glCreateProgram();
+
+		glProgramBinary(progID, header[1], binary.data(), binary.size());
+
+		GLint linked = GL_FALSE;
+		glGetProgramiv(progID, GL_LINK_STATUS, &linked);
+
+		// the driver can reject binaries at any time, e.g. after a hardware change
+		if (linked != GL_TRUE) {
+			LOG_L(L_INFO, "[ShaderBinaryCache::%s] driver rejected cached program %016llx, recompiling", __func__, static_cast<unsigned long long>(key));
+			glDeleteProgram(progID);
+			return 0;
+		}
+
+		return progID;
+	}
+
+	void SaveProgram(uint64_t key, GLuint progID)
+	{
+		RECOIL_DETAILED_TRACY_ZONE;
+		GLint binarySize = 0;
+		glGetProgramiv(progID, GL_PROGRAM_BINARY_LENGTH, &binarySize);
+
+		if (binarySize <= 0)
+			return;
+
+		std::vector<uint8_t> binary(binarySize);
+		GLenum binaryFormat = 0;
+		GLsizei binaryLength = 0;
+
+		glGetProgramBinary(progID, binarySize, &binaryLength, &binaryFormat, binary.data());
+
+		if (binaryLength <= 0)
+			return;
+
+		const std::string fileName = GetCacheFileName(key);
+		FILE* file = fopen(fileName.c_str(), "wb");
+
+		if (file == nullptr) {
+			LOG_L(L_WARNING, "[ShaderBinaryCache::%s] could not open \"%s\" for writing", __func__, fileName.c_str());
+			return;
+		}
+
+		const uint32_t header[3] = {SHADER_BINARY_CACHE_VERSION, static_cast<uint32_t>(binaryFormat), static_cast<uint32_t>(binaryLength)};
+
+		bool success = true;
+		success = success && (fwrite(&key, sizeof(key), 1, file) == 1);
+		success = success && (fwrite(&header[0], sizeof(header), 1, file) == 1);
+		success = success && (fwrite(binary.data(), binaryLength, 1, file) == 1);
+
+		fclose(file);
+
+		// do not leave truncated entries behind
+		if (!success)
+			std::remove(fileName.c_str());
+	}
+}
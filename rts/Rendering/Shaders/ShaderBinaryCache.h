@@ -0,0 +1,32 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#ifndef _SHADER_BINARY_CACHE_H
+#define _SHADER_BINARY_CACHE_H
+
+#include <cstdint>
+
+typedef unsigned int GLuint;
+
+namespace Shader {
+	/**
+	 * @brief
+	 * On-disk cache of linked program binaries (glGetProgramBinary), such that
+	 * unchanged programs do not have to be compiled again on the next start.
+	 *
+	 * Keys are expected to cover everything the program depends on (sources,
+	 * definitions, attribute and output locations); GetKeySeed mixes in the
+	 * driver identification so a driver update never picks up stale binaries.
+	 */
+	namespace ShaderBinaryCache {
+		// false if disabled by config or not supported by the driver
+		bool IsEnabled();
+
+		uint64_t GetKeySeed();
+
+		// returns a new linked program, or 0 if there was no usable binary
+		GLuint LoadProgram(uint64_t key);
+		void SaveProgram(uint64_t key, GLuint progID);
+	}
+}
+
+#endif //_SHADER_BINARY_CACHE_H
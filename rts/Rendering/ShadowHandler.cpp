@@ -32,6 +32,8 @@
 CONFIG(int, Shadows).defaultValue(2).headlessValue(-1).minimumValue(-1).safemodeValue(-1).description("Sets whether shadows are rendered.\n-1:=forceoff, 0:=off, 1:=full, 2:=fast (skip terrain)"); //FIXME document bitmask
 CONFIG(int, ShadowMapSize).defaultValue(CShadowHandler::DEF_SHADOWMAP_SIZE).minimumValue(32).description("Sets the resolution of shadows. Higher numbers increase quality at the cost of performance.");
 CONFIG(int, ShadowProjectionMode).defaultValue(CShadowHandler::SHADOWPROMODE_CAM_CENTER);
+CONFIG(bool, ShadowTerrainCache).defaultValue(true).description("Whether to reuse the terrain depth of earlier shadow passes while neither the shadow projection nor the heightmap changed.");
+CONFIG(float, ShadowMinCasterTexels).defaultValue(0.0f).minimumValue(0.0f).description("Units and features whose diameter covers fewer shadowmap texels than this are not rendered into the shadowmap. 0 disables the check.");
 CONFIG(bool, ShadowColorMode).defaultValue(true).description("Whether the colorbuffer of shadowmap FBO is RGB vs greyscale(to conserve some VRAM)");
 
 CShadowHandler shadowHandler;
@@ -72,6 +74,12 @@ void CShadowHandler::Init()
 	shadowColorMode = configHandler->GetInt("ShadowColorMode");
 	shadowGenBits = SHADOWGEN_BIT_NONE;
 
+	minCasterTexels = configHandler->GetFloat("ShadowMinCasterTexels");
+	minCasterRadius = 0.0f;
+
+	terrainCacheEnabled = configHandler->GetBool("ShadowTerrainCache") && GLAD_GL_ARB_copy_image;
+	terrainCacheValid = false;
+
 	shadowsLoaded = false;
 	inShadowPass = false;
 
@@ -132,6 +140,10 @@ void CShadowHandler::Update()
 
 	SetShadowMatrix(playCam, shadCam);
 	SetShadowCamera(shadCam);
+
+	// the map spans 2 * shadowProjScales.x elmos across shadowMapSize texels,
+	// so a caster of radius r covers (r * shadowMapSize / shadowProjScales.x)
+	minCasterRadius = minCasterTexels * shadowProjScales.x / std::max(shadowMapSize, 1);
 }
 
 void CShadowHandler::SaveShadowMapTextures() const
@@ -186,6 +198,9 @@ void CShadowHandler::FreeFBOAndTextures() {
 
 	glDeleteTextures(1, &shadowDepthTexture); shadowDepthTexture = 0;
 	glDeleteTextures(1, &shadowColorTexture); shadowColorTexture = 0;
+	glDeleteTextures(1, &terrainDepthCacheTexture); terrainDepthCacheTexture = 0;
+
+	terrainCacheValid = false;
 }
 
 
@@ -430,6 +445,21 @@ bool CShadowHandler::InitFBOAndTextures()
 	// revert to FBO = 0 default
 	glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
 
+	if (status && terrainCacheEnabled && shadowConfig > 0) {
+		// must have the same internal format as shadowDepthTexture for glCopyImageSubData
+		const int depthBits = std::min(globalRendering->supportDepthBufferBitDepth, 24);
+		const GLint depthFormat = CGlobalRendering::DepthBitsToFormat(depthBits);
+
+		glGenTextures(1, &terrainDepthCacheTexture);
+		glBindTexture(GL_TEXTURE_2D, terrainDepthCacheTexture);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
+		glTexImage2D(GL_TEXTURE_2D, 0, depthFormat, realShTexSize, realShTexSize, 0, GL_DEPTH_COMPONENT, GL_FLOAT, nullptr);
+		glBindTexture(GL_TEXTURE_2D, 0);
+	}
+
 	return status;
 }
 
@@ -441,6 +471,14 @@ void CShadowHandler::DrawShadowPasses()
 	glEnable(GL_CULL_FACE);
 	glCullFace(GL_BACK);
 
+	// terrain goes first so its depth can be cached (or restored from the
+	// cache) before anything else is rasterized; the order of opaque depth
+	// writes does not matter for the end result
+	if ((shadowGenBits & SHADOWGEN_BIT_MAP) != 0){
+		ZoneScopedN("Draw::World::CreateShadows::Terrain");
+		DrawTerrainShadowPass();
+	}
+
 	eventHandler.DrawWorldShadow();
 
 	EnableColorOutput(true);
@@ -460,6 +498,23 @@ void CShadowHandler::DrawShadowPasses()
 		featureDrawer->DrawShadowPass();
 	}
 
+	// Restore GL_BACK culling, because Lua shadow materials might
+	// have changed culling at their own discretion
+	glCullFace(GL_BACK);
+
+	//transparent pass, comes last
+	if ((shadowGenBits & SHADOWGEN_BIT_PROJ) != 0) {
+		projectileDrawer->DrawShadowTransparent();
+		eventHandler.DrawShadowPassTransparent();
+	}
+
+	glPopAttrib();
+
+	inShadowPass = false;
+}
+
+void CShadowHandler::DrawTerrainShadowPass()
+{
 	// cull front-faces during the terrain shadow pass: sun direction
 	// can be set so oblique that geometry back-faces are visible (eg.
 	// from hills near map edges) from its POV
@@ -471,23 +526,45 @@ void CShadowHandler::DrawShadowPasses()
 	// also want to prevent overdraw in low-angle passes)
 	// glCullFace(GL_FRONT);
 
-	// Restore GL_BACK culling, because Lua shadow materials might
-	// have changed culling at their own discretion
-	glCullFace(GL_BACK);
-	if ((shadowGenBits & SHADOWGEN_BIT_MAP) != 0){
-		ZoneScopedN("Draw::World::CreateShadows::Terrain");
+	if (terrainDepthCacheTexture == 0 || !globalRendering->drawGround) {
+		terrainCacheValid = false;
 		readMap->GetGroundDrawer()->DrawShadowPass();
+		return;
 	}
 
-	//transparent pass, comes last
-	if ((shadowGenBits & SHADOWGEN_BIT_PROJ) != 0) {
-		projectileDrawer->DrawShadowTransparent();
-		eventHandler.DrawShadowPassTransparent();
+	// the projection follows the player camera (and the sun), so the cache
+	// only survives while both are at rest; ROAM's shadow LOD depends on
+	// the culling matrix which is compared too
+	terrainCacheValid &= (terrainCacheHeightMapUpdateCount == readMap->GetUnsyncedHeightMapUpdateCount());
+	terrainCacheValid &= (terrainCacheViewMatrix[SHADOWMAT_TYPE_CULLING] == viewMatrix[SHADOWMAT_TYPE_CULLING]);
+	terrainCacheValid &= (terrainCacheViewMatrix[SHADOWMAT_TYPE_DRAWING] == viewMatrix[SHADOWMAT_TYPE_DRAWING]);
+	terrainCacheValid &= (terrainCacheProjMatrix == projMatrix[SHADOWMAT_TYPE_DRAWING]);
+	terrainCacheValid &= (terrainCacheProjScales == shadowProjScales);
+
+	if (terrainCacheValid) {
+		// depth is cleared at this point, so a plain copy restores the terrain
+		glCopyImageSubData(
+			terrainDepthCacheTexture, GL_TEXTURE_2D, 0, 0, 0, 0,
+			shadowDepthTexture      , GL_TEXTURE_2D, 0, 0, 0, 0,
+			shadowMapSize, shadowMapSize, 1
+		);
+		return;
 	}
 
-	glPopAttrib();
+	readMap->GetGroundDrawer()->DrawShadowPass();
 
-	inShadowPass = false;
+	glCopyImageSubData(
+		shadowDepthTexture      , GL_TEXTURE_2D, 0, 0, 0, 0,
+		terrainDepthCacheTexture, GL_TEXTURE_2D, 0, 0, 0, 0,
+		shadowMapSize, shadowMapSize, 1
+	);
+
+	terrainCacheHeightMapUpdateCount = readMap->GetUnsyncedHeightMapUpdateCount();
+	terrainCacheViewMatrix[SHADOWMAT_TYPE_CULLING] = viewMatrix[SHADOWMAT_TYPE_CULLING];
+	terrainCacheViewMatrix[SHADOWMAT_TYPE_DRAWING] = viewMatrix[SHADOWMAT_TYPE_DRAWING];
+	terrainCacheProjMatrix = projMatrix[SHADOWMAT_TYPE_DRAWING];
+	terrainCacheProjScales = shadowProjScales;
+	terrainCacheValid = true;
 }
 
 static CMatrix44f ComposeLightMatrix(const CCamera* playerCam, const ISkyLight* light)
@@ -80,6 +80,9 @@ public:
 
 	const float4& GetShadowParams() const { return shadowTexProjCenter; }
 
+	// casters with a smaller draw-radius cover less than ShadowMinCasterTexels texels and are skipped
+	float GetMinCasterRadius() const { return minCasterRadius; }
+
 	uint32_t GetShadowTextureID() const { return shadowDepthTexture; }
 	uint32_t GetColorTextureID() const { return shadowColorTexture; }
 
@@ -98,6 +101,7 @@ private:
 	bool InitFBOAndTextures();
 
 	void DrawShadowPasses();
+	void DrawTerrainShadowPass();
 	void LoadProjectionMatrix(const CCamera* shadowCam);
 	void LoadShadowGenShaders();
 
@@ -134,6 +138,9 @@ private:
 
 	float4 shadowProjScales;
 
+	float minCasterTexels = 0.0f;
+	float minCasterRadius = 0.0f;
+
 	// culling and drawing versions of both matrices
 	CMatrix44f projMatrix[2];
 	CMatrix44f viewMatrix[2];
@@ -141,6 +148,18 @@ private:
 	uint32_t shadowDepthTexture;
 	uint32_t shadowColorTexture;
 
+	// copy of the depth written by the terrain pass, reused as long as
+	// the shadow projection and the heightmap have not changed since
+	uint32_t terrainDepthCacheTexture = 0;
+	uint32_t terrainCacheHeightMapUpdateCount = 0;
+
+	bool terrainCacheEnabled = false;
+	bool terrainCacheValid = false;
+
+	CMatrix44f terrainCacheViewMatrix[2];
+	CMatrix44f terrainCacheProjMatrix;
+	float4 terrainCacheProjScales;
+
 	FBO smOpaqFBO;
 
 	/// xmid, ymid, p17, p18
@@ -23,6 +23,7 @@
 #include "System/SpringMem.h"
 #include "System/SpringMath.h"
 #include "System/StringUtil.h"
+#include "System/MemPoolStats.h"
 #include "System/Threading/ThreadPool.h"
 #include "System/FileSystem/DataDirsAccess.h"
 #include "System/FileSystem/FileQueryFlags.h"
@@ -52,6 +53,8 @@ public:
 	virtual ~ITexMemPool() {}
 
 	virtual size_t Size() const = 0;
+	size_t AllocSize() const { return allocSize; }
+
 	virtual size_t AllocIdx(size_t size) = 0;
 	virtual size_t AllocIdxRaw(size_t size) = 0;
 
@@ -371,6 +374,19 @@ void ITexMemPool::Kill()
 	texMemPool = {};
 }
 
+static MemPoolRegistrar texMemPoolRegistrar("Bitmaps", [](MemPoolStats& stats) {
+	ITexMemPool* pool = ITexMemPool::texMemPool.get();
+
+	if (pool == nullptr)
+		return;
+
+	std::scoped_lock lck(pool->GetMutex());
+
+	// TexNoMemPool has no backing array and reserves exactly what it hands out
+	stats.liveBytes = pool->AllocSize();
+	stats.reservedBytes = pool->Size();
+});
+
 
 // static bool IsValidImageType(int type) {
 // 	// this is a minimal list of file formats that (should) be available at all platforms
@@ -96,10 +96,32 @@ void CS3OTextureHandler::Reload()
 void CS3OTextureHandler::PreloadTexture(S3DModel* model, bool invertAxis, bool invertAlpha)
 {
 	RECOIL_DETAILED_TRACY_ZONE;
+	// never invert alpha for tex2
+	const bool invertAlphas[2] = {invertAlpha, false};
+
+	CBitmap bitmaps[2];
+	bool decoded[2] = {false, false};
+
+	// decode without holding the models lock, such that parser threads do not
+	// wait on each other and the main thread is not stalled in LoadTexture for
+	// as long as some other model's textures are being read from disk
+	for (unsigned int texNum = 0; texNum < 2; texNum++) {
+		{
+			auto lock = CModelsLock::GetScopedLock();
+
+			if (IsTextureCached(model->texs[texNum]))
+				continue;
+		}
+
+		DecodeTexture(bitmaps[texNum], model, texNum, invertAxis, invertAlphas[texNum]);
+		decoded[texNum] = true;
+	}
+
 	auto lock = CModelsLock::GetScopedLock();
 
-	LoadAndCacheTexture(model, 0, invertAxis, invertAlpha, true);
-	LoadAndCacheTexture(model, 1, invertAxis,       false, true); // never invert alpha for tex2
+	// if another thread cached the same texture in the meantime, ours is dropped
+	LoadAndCacheTexture(model, 0, invertAxis, invertAlphas[0], true, decoded[0]? &bitmaps[0]: nullptr);
+	LoadAndCacheTexture(model, 1, invertAxis, invertAlphas[1], true, decoded[1]? &bitmaps[1]: nullptr);
 }
 
 
@@ -122,12 +144,47 @@ void CS3OTextureHandler::LoadTexture(S3DModel* model)
 	}
 }
 
+bool CS3OTextureHandler::IsTextureCached(const std::string& textureName) const
+{
+	const auto textureIt = textureCache.find(textureName);
+
+	if (textureIt != textureCache.end() && textureIt->second.texID > 0)
+		return true;
+
+	return (bitmapCache.find(textureName) != bitmapCache.end());
+}
+
+void CS3OTextureHandler::DecodeTexture(
+	CBitmap& bitmap,
+	const S3DModel* model,
+	unsigned int texNum,
+	bool invertAxis,
+	bool invertAlpha
+) {
+	RECOIL_DETAILED_TRACY_ZONE;
+	const auto& textureName = model->texs[texNum];
+
+	if (!bitmap.Load(textureName) && !bitmap.Load("unittextures/" + textureName)) {
+		if (texNum == 0)
+			LOG_L(L_WARNING, "[%s] could not load primary texture \"%s\" from model \"%s\"", __func__, textureName.c_str(), model->name.c_str());
+
+		// file not found (or headless build), set a single pixel so model is visible
+		bitmap.AllocDummy(SColor(255 * (texNum == 0), 0, 0, 255 * (1 - invertAlpha)));
+	}
+
+	if (invertAxis)
+		bitmap.ReverseYAxis();
+	if (invertAlpha)
+		bitmap.InvertAlpha();
+}
+
 unsigned int CS3OTextureHandler::LoadAndCacheTexture(
 	const S3DModel* model,
 	unsigned int texNum,
 	bool invertAxis,
 	bool invertAlpha,
-	bool preloadCall
+	bool preloadCall,
+	CBitmap* decodedBitmap
 ) {
 	RECOIL_DETAILED_TRACY_ZONE;
 	CBitmap* bitmap = nullptr;
@@ -158,18 +215,11 @@ unsigned int CS3OTextureHandler::LoadAndCacheTexture(
 
 		bitmap = &(iter->second);
 
-		if (!bitmap->Load(textureName) && !bitmap->Load("unittextures/" + textureName)) {
-			if (texNum == 0)
-				LOG_L(L_WARNING, "[%s] could not load primary texture \"%s\" from model \"%s\"", __func__, textureName.c_str(), model->name.c_str());
-
-			// file not found (or headless build), set a single pixel so model is visible
-			bitmap->AllocDummy(SColor(255 * (texNum == 0), 0, 0, 255 * (1 - invertAlpha)));
+		if (decodedBitmap != nullptr) {
+			*bitmap = std::move(*decodedBitmap);
+		} else {
+			DecodeTexture(*bitmap, model, texNum, invertAxis, invertAlpha);
 		}
-
-		if (invertAxis)
-			bitmap->ReverseYAxis();
-		if (invertAlpha)
-			bitmap->InvertAlpha();
 	}
 
 	const unsigned int texID = preloadCall ? 0 : bitmap->CreateMipMapTexture();
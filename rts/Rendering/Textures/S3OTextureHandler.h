@@ -53,12 +53,22 @@ public:
 	}
 
 private:
+	bool IsTextureCached(const std::string& textureName) const;
+
+	void DecodeTexture(
+		CBitmap& bitmap,
+		const S3DModel* model,
+		unsigned int texNum,
+		bool invertAxis,
+		bool invertAlpha
+	);
 	unsigned int LoadAndCacheTexture(
 		const S3DModel* model,
 		unsigned int texNum,
 		bool invertAxis,
 		bool invertAlpha,
-		bool preloadCall
+		bool preloadCall,
+		CBitmap* decodedBitmap = nullptr
 	);
 	unsigned int InsertTextureMat(const S3DModel* model);
 
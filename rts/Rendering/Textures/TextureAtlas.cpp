@@ -15,6 +15,7 @@
 #include "System/StringUtil.h"
 #include "System/Exceptions.h"
 #include "System/SafeUtil.h"
+#include "System/Threading/ThreadPool.h"
 #include "System/UnorderedSet.hpp"
 
 #include <cstring>
@@ -24,6 +25,19 @@
 CONFIG(int, MaxTextureAtlasSizeX).defaultValue(4096).minimumValue(512).maximumValue(32768).description("The max X size of the projectile and Lua texture atlasses");
 CONFIG(int, MaxTextureAtlasSizeY).defaultValue(4096).minimumValue(512).maximumValue(32768).description("The max Y size of the projectile and Lua texture atlasses");
 
+// decodes the files on the worker threads, the atlas itself is not touched
+static void LoadBitmaps(const std::vector<std::string>& fileNames, std::vector<CBitmap>& bitmaps, std::vector<uint8_t>& loaded)
+{
+	bitmaps.clear();
+	bitmaps.resize(fileNames.size());
+	loaded.clear();
+	loaded.resize(fileNames.size(), false);
+
+	for_mt(0, fileNames.size(), [&](const int i) {
+		loaded[i] = bitmaps[i].Load(fileNames[i]);
+	});
+}
+
 CR_BIND(AtlasedTexture, )
 CR_REG_METADATA(AtlasedTexture, (CR_IGNORED(x), CR_IGNORED(y), CR_IGNORED(z), CR_IGNORED(w)))
 
@@ -131,6 +145,53 @@ size_t CTextureAtlas::AddTexFromFile(std::string texName, const std::string& fil
 	return (files[lcFile] = AddTexFromMem(std::move(texName), bitmap.xsize, bitmap.ysize, RGBA32, bitmap.GetRawMem()));
 }
 
+void CTextureAtlas::AddTexFromFiles(const std::vector<std::pair<std::string, std::string>>& namedFiles)
+{
+	RECOIL_DETAILED_TRACY_ZONE;
+	std::vector<std::string> newFiles;
+	spring::unordered_map<std::string, size_t> newFileIndices;
+
+	for (const auto& [texName, file]: namedFiles) {
+		const std::string& lcFile = StringToLower(file);
+
+		if (files.contains(lcFile) || newFileIndices.contains(lcFile))
+			continue;
+
+		newFileIndices.emplace(lcFile, newFiles.size());
+		newFiles.push_back(file);
+	}
+
+	std::vector<CBitmap> bitmaps;
+	std::vector<uint8_t> loaded;
+
+	LoadBitmaps(newFiles, bitmaps, loaded);
+
+	// entries are added in the given order, same as a sequence of AddTexFromFile
+	// calls, so the packing does not depend on which worker finished first
+	for (const auto& [texName, file]: namedFiles) {
+		const std::string& lcTexName = StringToLower(texName);
+		const std::string& lcFile = StringToLower(file);
+
+		if (const auto it = files.find(lcFile); it != files.end()) {
+			memTextures[it->second].names.emplace_back(lcTexName);
+			continue;
+		}
+
+		const size_t bitmapIdx = newFileIndices[lcFile];
+		CBitmap& bitmap = bitmaps[bitmapIdx];
+
+		if (!loaded[bitmapIdx]) {
+			bitmap.Alloc(2, 2, 4);
+			LOG_L(L_WARNING, "[TexAtlas::%s] could not load texture from file \"%s\"", __func__, file.c_str());
+		}
+
+		if (bitmap.channels != 4 || bitmap.compressed)
+			throw content_error("Unsupported bitmap format in file " + file);
+
+		files[lcFile] = AddTexFromMem(lcTexName, bitmap.xsize, bitmap.ysize, RGBA32, bitmap.GetRawMem());
+	}
+}
+
 
 bool CTextureAtlas::Finalize()
 {
@@ -188,12 +249,14 @@ bool CTextureAtlas::CreateTexture()
 		// make spacing between textures black transparent to avoid ugly lines with linear filtering
 		std::memset(data, 0, atlasSize.x * atlasSize.y * 4);
 
+		std::vector<int2> texPositions;
+		texPositions.reserve(memTextures.size());
+
 		for (const MemTex& memTex: memTextures) {
 			const float4 texCoords = atlasAllocator->GetTexCoords(memTex.names[0]);
 			const float4 absCoords = atlasAllocator->GetEntry(memTex.names[0]);
 
-			const int xpos = absCoords.x;
-			const int ypos = absCoords.y;
+			texPositions.emplace_back(absCoords.x, absCoords.y);
 
 			AtlasedTexture tex(texCoords);
 
@@ -201,13 +264,22 @@ bool CTextureAtlas::CreateTexture()
 				textures[name] = std::move(tex); //make sure textures[name] gets only its guts replaced, so all pointers remain valid
 			}
 
+		}
+
+		// sub-images never overlap, each one is copied by a single worker
+		for_mt(0, memTextures.size(), [&](const int i) {
+			const MemTex& memTex = memTextures[i];
+
+			const int xpos = texPositions[i].x;
+			const int ypos = texPositions[i].y;
+
 			for (int y = 0; y < memTex.ysize; ++y) {
 				int* dst = ((int*)           data  ) + xpos + (ypos + y) * atlasSize.x;
 				int* src = ((int*)memTex.mem.data()) +        (       y) * memTex.xsize;
 
 				memcpy(dst, src, memTex.xsize * 4);
 			}
-		}
+		});
 
 		if (debug) {
 			CBitmap tex(data, atlasSize.x, atlasSize.y);
@@ -273,14 +345,28 @@ void CTextureAtlas::ReloadTextures()
 		nonFileEntries.emplace(i);
 	}
 
+	std::vector<std::string> fileNames;
+	std::vector<size_t> fileIndices;
+
 	for (const auto& [filename, idx] : files) {
 		assert(idx < memTextures.size());
 		nonFileEntries.erase(idx);
-		auto& memTex = memTextures[idx];
 
-		CBitmap bitmap;
-		if (!bitmap.Load(filename)) {
-			LOG_L(L_WARNING, "[TexAtlas::%s] could not reload texture from file \"%s\"", __func__, filename.c_str());
+		fileNames.push_back(filename);
+		fileIndices.push_back(idx);
+	}
+
+	std::vector<CBitmap> bitmaps;
+	std::vector<uint8_t> loaded;
+
+	LoadBitmaps(fileNames, bitmaps, loaded);
+
+	for (size_t i = 0; i < fileNames.size(); ++i) {
+		auto& memTex = memTextures[fileIndices[i]];
+		auto& bitmap = bitmaps[i];
+
+		if (!loaded[i]) {
+			LOG_L(L_WARNING, "[TexAtlas::%s] could not reload texture from file \"%s\"", __func__, fileNames[i].c_str());
 			bitmap.Alloc(2, 2, 4);
 			bitmap.Fill(SColor(1.0f, 0.0f, 0.0f, 1.0f));
 		}
@@ -4,6 +4,7 @@
 #define TEXTURE_ATLAS_H
 
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "System/creg/creg_cond.h"
@@ -109,6 +110,8 @@ public:
 	size_t AddTexFromMem(std::string name, int xsize, int ysize, TextureType texType, const void* data);
 	// add a texture from a file
 	size_t AddTexFromFile(std::string name, const std::string& file);
+	// add textures from a list of <name, file> pairs, decoding the files in parallel
+	void AddTexFromFiles(const std::vector<std::pair<std::string, std::string>>& namedFiles);
 	// add a blank texture
 	size_t AddTex(std::string name, int xsize, int ysize, TextureType texType = RGBA32);
 
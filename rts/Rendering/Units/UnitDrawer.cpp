@@ -361,7 +361,31 @@ void CUnitDrawerGLSL::DrawUnitMiniMapIcons() const
 	const auto isFullView = gu->spectatingFullView;
 	const float ghostIconDimming = modelDrawerData->ghostIconDimming;
 
-	if (!minimap->UseUnitIcons())
+	const bool useUnitIcons = minimap->UseUnitIcons();
+	const bool useSimpleColors = minimap->UseSimpleColors();
+
+	// icon colors only depend on the team, resolve them once instead of per unit
+	static std::array<SColor, MAX_TEAMS> teamIconColors;
+
+	for (int teamID = 0; teamID < teamHandler.ActiveTeams(); ++teamID) {
+		if (!useSimpleColors) {
+			teamIconColors[teamID] = teamHandler.Team(teamID)->color;
+			continue;
+		}
+
+		if (teamID == gu->myTeam) {
+			teamIconColors[teamID] = minimap->GetMyTeamIconColor();
+		}
+		else if (teamHandler.Ally(myAllyTeam, teamHandler.AllyTeam(teamID))) {
+			teamIconColors[teamID] = minimap->GetAllyTeamIconColor();
+		}
+		else {
+			teamIconColors[teamID] = minimap->GetEnemyTeamIconColor();
+		}
+	}
+
+	// without per-type icons every group shares one texture and can go into a single batch
+	if (!useUnitIcons)
 		icon::iconHandler.GetDefaultIconData()->BindTexture();
 
 	for (const auto& [icon, objects] : modelDrawerData->GetUnitsByIcon()) {
@@ -373,7 +397,7 @@ void CUnitDrawerGLSL::DrawUnitMiniMapIcons() const
 		if (units.empty() && ghosts.empty())
 			continue;
 
-		if (minimap->UseUnitIcons())
+		if (useUnitIcons)
 			icon->BindTexture();
 
 		for (const CUnit* unit : units) {
@@ -391,20 +415,7 @@ void CUnitDrawerGLSL::DrawUnitMiniMapIcons() const
 				currentColor = color4::white; // selected color
 			}
 			else {
-				if (minimap->UseSimpleColors()) {
-					if (unit->team == gu->myTeam) {
-						currentColor = minimap->GetMyTeamIconColor();
-					}
-					else if (teamHandler.Ally(myAllyTeam, unit->allyteam)) {
-						currentColor = minimap->GetAllyTeamIconColor();
-					}
-					else {
-						currentColor = minimap->GetEnemyTeamIconColor();
-					}
-				}
-				else {
-					currentColor = teamHandler.Team(unit->team)->color;
-				}
+				currentColor = teamIconColors[unit->team];
 
 				if (!isFullView && !(unit->losStatus[myAllyTeam] & LOS_INRADAR)) {
 					if (ghostIconDimming == 0.0f)
@@ -426,7 +437,7 @@ void CUnitDrawerGLSL::DrawUnitMiniMapIcons() const
 
 		if (!isFullView && ghostIconDimming > 0.0f) {
 			for (const auto& ghost : ghosts) {
-				if (minimap->UseSimpleColors())
+				if (useSimpleColors)
 					currentColor = minimap->GetEnemyTeamIconColor();
 				else
 					currentColor = teamHandler.Team(ghost->team)->color;
@@ -442,15 +453,19 @@ void CUnitDrawerGLSL::DrawUnitMiniMapIcons() const
 			}
 		}
 
-		rb.Submit(GL_TRIANGLES);
+		if (useUnitIcons)
+			rb.Submit(GL_TRIANGLES);
 	}
 
+	if (!useUnitIcons)
+		rb.Submit(GL_TRIANGLES);
+
 	sh.SetUniform("alphaCtrl", 0.0f, 0.0f, 0.0f, 1.0f);
 	sh.Disable();
 	glBindTexture(GL_TEXTURE_2D, 0);
 }
 
-float CUnitDrawerGLSL::DrawUnitIcon(TypedRenderBuffer<VA_TYPE_TC>& rb, const icon::CIconData* icon, const float iconRadius, float3 pos, const uint8_t* color, const float unitRadius) const
+float CUnitDrawerGLSL::CalcUnitIconPosAndScale(const icon::CIconData* icon, float3& pos, const float unitRadius) const
 {
 	// make sure icon is above ground (needed before we calculate scale below)
 	const float h = CGround::GetHeightReal(pos.x, pos.z, false);
@@ -471,6 +486,11 @@ float CUnitDrawerGLSL::DrawUnitIcon(TypedRenderBuffer<VA_TYPE_TC>& rb, const ico
 	// make sure icon is not partly under ground
 	pos.y = std::max(pos.y, h + scale);
 
+	return scale;
+}
+
+void CUnitDrawerGLSL::DrawUnitIcon(TypedRenderBuffer<VA_TYPE_TC>& rb, const float3& pos, const float scale, const uint8_t* color) const
+{
 	const float3 dy = camera->GetUp() * scale;
 	const float3 dx = camera->GetRight() * scale;
 	const float3 vn = pos - dx;
@@ -486,7 +506,6 @@ float CUnitDrawerGLSL::DrawUnitIcon(TypedRenderBuffer<VA_TYPE_TC>& rb, const ico
 		{ br, 1.0f, 1.0f, color },
 		{ bl, 0.0f, 1.0f, color }
 	);
-	return scale;
 }
 
 void CUnitDrawerGLSL::DrawUnitIcons() const
@@ -525,25 +544,39 @@ void CUnitDrawerGLSL::DrawUnitIcons() const
 
 		icon->BindTexture();
 
-		for (const CUnit* cu : units)
-		{
-			CUnit* unit = const_cast<CUnit*>(cu);
+		// the per-unit position, ground-height and scale work is independent
+		// between units and dominates when the whole map is iconified
+		unitIconQuads.resize(units.size());
+
+		for_mt(0, units.size(), [&](const int i) {
+			CUnit* unit = const_cast<CUnit*>(units[i]);
+			UnitIconQuad& q = unitIconQuads[i];
+
+			q.color = nullptr;
 
 			if (!unit->GetIsIcon())
-				continue;
+				return;
 			if (!unit->drawIcon)
-				continue;
+				return;
 
 			// drawMidPos is auto-calculated now; can wobble on its own as pieces move
-			float3 pos = (!gu->spectatingFullView) ?
+			q.pos = (!gu->spectatingFullView) ?
 				unit->GetObjDrawErrorPos(gu->myAllyTeam) :
 				unit->GetObjDrawMidPos();
 
 			// use white for selected units
 			const uint8_t* colors[] = { teamHandler.Team(unit->team)->color, color4::white };
-			const uint8_t* color = colors[unit->isSelected];
+			q.color = colors[unit->isSelected];
+
+			q.scale = CalcUnitIconPosAndScale(icon, q.pos, unit->radius);
+			unit->iconRadius = q.scale;
+		});
+
+		for (const UnitIconQuad& q : unitIconQuads) {
+			if (q.color == nullptr)
+				continue;
 
-			unit->iconRadius = DrawUnitIcon(rb, icon, unit->iconRadius, pos, color, unit->radius);
+			DrawUnitIcon(rb, q.pos, q.scale, q.color);
 		}
 
 		rb.Submit(GL_TRIANGLES);
@@ -189,8 +189,18 @@ protected:
 	void PopIndividualAlphaState(const S3DModel* model, int teamID, bool deferredPass) const;
 
 	void DrawUnitMiniMapIcon(TypedRenderBuffer<VA_TYPE_2DTC>& rb, const float iconScale, const float3& pos, const SColor& color) const;
-	float DrawUnitIcon(TypedRenderBuffer<VA_TYPE_TC>& rb, const icon::CIconData* icon, const float iconRadius, float3 pos, const uint8_t* color, const float unitRadius) const;
+	float CalcUnitIconPosAndScale(const icon::CIconData* icon, float3& pos, const float unitRadius) const;
+	void DrawUnitIcon(TypedRenderBuffer<VA_TYPE_TC>& rb, const float3& pos, const float scale, const uint8_t* color) const;
 	void DrawUnitIconScreen(TypedRenderBuffer<VA_TYPE_2DTC>& rb, const icon::CIconData* icon, const float3 pos, SColor& color, const float unitRadius, bool isIcon) const;
+private:
+	struct UnitIconQuad {
+		float3 pos;
+		float scale;
+		const uint8_t* color; // nullptr if the unit is not drawn as an icon
+	};
+
+	// filled in parallel by DrawUnitIcons, then turned into quads serially
+	mutable std::vector<UnitIconQuad> unitIconQuads;
 };
 
 //TODO remove CUnitDrawerLegacy inheritance
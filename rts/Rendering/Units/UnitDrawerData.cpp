@@ -191,6 +191,8 @@ void CUnitDrawerData::Update()
 
 	iconZoomDist = dist;
 
+	UpdateDrawFlagCamTypes();
+
 	const auto updateBody = [this](CUnit* u) {
 		UpdateDrawPos(u);
 
@@ -228,32 +230,117 @@ void CUnitDrawerData::Update()
 void CUnitDrawerData::UpdateGhostedBuildings()
 {
 	RECOIL_DETAILED_TRACY_ZONE;
-	for (int allyTeam = 0; allyTeam < savedData.deadGhostBuildings.size(); ++allyTeam) {
-		for (int modelType = MODELTYPE_3DO; modelType < MODELTYPE_CNT; modelType++) {
-			auto& dgb = savedData.deadGhostBuildings[allyTeam][modelType];
+	if (!deadGhostBlocksValid)
+		RebuildDeadGhostBlocks();
+
+	// ghosts can only come into view where some instance added sight, so
+	// test those near the areas gained in this frame's LOS update
+	const auto testBlock = [this](int allyTeam, std::vector<GhostSolidObject*>& ghosts) {
+		for (size_t i = 0; i < ghosts.size(); /*no-op*/) {
+			if (!RemoveDeadGhostInLos(allyTeam, ghosts[i])) {
+				++i;
+				continue;
+			}
 
-			for (int i = 0; i < dgb.size(); /*no-op*/) {
-				GhostSolidObject* gso = dgb[i];
+			ghosts[i] = ghosts.back();
+			ghosts.pop_back();
+		}
+	};
 
-				if (!losHandler->InLos(gso->pos, allyTeam)) {
-					++i;
-					continue;
-				}
+	for (int allyTeam = 0; allyTeam < deadGhostBlocks.size(); ++allyTeam) {
+		auto& blocks = deadGhostBlocks[allyTeam];
+		auto& newGhosts = newDeadGhosts[allyTeam];
+
+		for (GhostSolidObject* gso: newGhosts) {
+			if (!losHandler->InLos(gso->pos, allyTeam))
+				continue;
+
+			spring::VectorErase(blocks[GetDeadGhostBlock(gso->pos)], gso);
+			RemoveDeadGhostInLos(allyTeam, gso);
+		}
+
+		newGhosts.clear();
+
+		if (blocks.empty())
+			continue;
+
+		if (losHandler->GetGlobalLOS(allyTeam)) {
+			for (auto& [block, ghosts]: blocks) {
+				testBlock(allyTeam, ghosts);
+			}
 
-				// obtained LOS on the ghost of a dead building
-				if (!gso->DecRef()) {
-					spring::VectorErase(unitsByIcon[gso->myIcon].second, const_cast<const GhostSolidObject*>(gso));
-					groundDecals->GhostDestroyed(gso);
-					ghostMemPool.free(gso);
+			continue;
+		}
+
+		for (const SRectangle& area: losHandler->los.GetGainedAreas(allyTeam)) {
+			const int bx1 = std::max(area.x1, 0) / DEAD_GHOST_BLOCK_SIZE;
+			const int bz1 = std::max(area.z1, 0) / DEAD_GHOST_BLOCK_SIZE;
+			const int bx2 = std::max(area.x2, 0) / DEAD_GHOST_BLOCK_SIZE;
+			const int bz2 = std::max(area.z2, 0) / DEAD_GHOST_BLOCK_SIZE;
+
+			for (int bz = bz1; bz <= bz2; bz++) {
+				for (int bx = bx1; bx <= bx2; bx++) {
+					const auto it = blocks.find((bz << 16) | bx);
+
+					if (it != blocks.end())
+						testBlock(allyTeam, it->second);
 				}
+			}
+		}
+	}
+}
+
+int CUnitDrawerData::GetDeadGhostBlock(const float3& pos)
+{
+	const int2 sq = losHandler->los.PosToSquare(pos);
+	return (((sq.y / DEAD_GHOST_BLOCK_SIZE) << 16) | (sq.x / DEAD_GHOST_BLOCK_SIZE));
+}
+
+void CUnitDrawerData::RebuildDeadGhostBlocks()
+{
+	RECOIL_DETAILED_TRACY_ZONE;
+	deadGhostBlocks.clear();
+	deadGhostBlocks.resize(savedData.deadGhostBuildings.size());
+	newDeadGhosts.clear();
+	newDeadGhosts.resize(savedData.deadGhostBuildings.size());
+
+	deadGhostBlocksValid = true;
 
-				dgb[i] = dgb.back();
-				dgb.pop_back();
+	for (int allyTeam = 0; allyTeam < savedData.deadGhostBuildings.size(); ++allyTeam) {
+		for (const auto& dgb: savedData.deadGhostBuildings[allyTeam]) {
+			for (GhostSolidObject* gso: dgb) {
+				AddDeadGhost(allyTeam, gso);
 			}
 		}
 	}
 }
 
+void CUnitDrawerData::AddDeadGhost(int allyTeam, GhostSolidObject* gso)
+{
+	if (!deadGhostBlocksValid)
+		return;
+
+	deadGhostBlocks[allyTeam][GetDeadGhostBlock(gso->pos)].push_back(gso);
+	newDeadGhosts[allyTeam].push_back(gso);
+}
+
+bool CUnitDrawerData::RemoveDeadGhostInLos(int allyTeam, GhostSolidObject* gso)
+{
+	if (!losHandler->InLos(gso->pos, allyTeam))
+		return false;
+
+	// obtained LOS on the ghost of a dead building
+	spring::VectorErase(savedData.deadGhostBuildings[allyTeam][gso->GetModel()->type], gso);
+
+	if (!gso->DecRef()) {
+		spring::VectorErase(unitsByIcon[gso->myIcon].second, const_cast<const GhostSolidObject*>(gso));
+		groundDecals->GhostDestroyed(gso);
+		ghostMemPool.free(gso);
+	}
+
+	return true;
+}
+
 const icon::CIconData* CUnitDrawerData::GetUnitIcon(const CUnit* unit)
 {
 	RECOIL_DETAILED_TRACY_ZONE;
@@ -383,11 +470,20 @@ void CUnitDrawerData::UpdateDrawPos(CUnit* u)
 {
 	RECOIL_DETAILED_TRACY_ZONE;
 
+	// read positions from the contiguous end-of-frame copies when available
+	const CSolidObjectTransformCache& tc = unitHandler.GetTransformCache();
+
 	if (const CUnit* t = u->GetTransporter(); t != nullptr) {
-		u->drawPos = u->GetDrawPosOther(t->preFrameTra.t, t->pos, globalRendering->timeOffset);
+		if (tc.IsValid(t->id))
+			u->drawPos = u->GetDrawPosOther(tc.GetPrevPos(t->id), tc.GetPos(t->id), globalRendering->timeOffset);
+		else
+			u->drawPos = u->GetDrawPosOther(t->preFrameTra.t, t->pos, globalRendering->timeOffset);
 	}
 	else {
-		u->drawPos = u->GetDrawPos(globalRendering->timeOffset);
+		if (tc.IsValid(u->id))
+			u->drawPos = tc.GetDrawPos(u->id, globalRendering->timeOffset);
+		else
+			u->drawPos = u->GetDrawPos(globalRendering->timeOffset);
 	}
 
 	u->drawMidPos = u->GetMdlDrawMidPos();
@@ -405,27 +501,23 @@ void CUnitDrawerData::UpdateObjectDrawFlags(CSolidObject* o) const
 		u->SetIsIcon(isIcon);
 	}
 
-	for (uint32_t camType = CCamera::CAMTYPE_PLAYER; camType < CCamera::CAMTYPE_ENVMAP; ++camType) {
-		if (camType == CCamera::CAMTYPE_UWREFL && !IWater::GetWater()->CanDrawReflectionPass())
-			continue;
-
-		if (camType == CCamera::CAMTYPE_SHADOW && ((shadowHandler.shadowGenBits & CShadowHandler::SHADOWGEN_BIT_MODEL) == 0))
-			continue;
-
-		const CCamera* cam = CCameraHandler::GetCamera(camType);
+	// camera-independent rejections
+	if (u->noDraw)
+		return;
 
-		if (u->noDraw)
-			continue;
+	// unit will be drawn as icon instead
+	if (u->GetIsIcon())
+		return;
 
-		// unit will be drawn as icon instead
-		if (u->GetIsIcon())
-			continue;
+	if (u->IsInVoid())
+		return;
 
-		if (u->IsInVoid())
-			continue;
+	if (!(u->losStatus[gu->myAllyTeam] & LOS_INLOS) && !gu->spectatingFullView)
+		return;
 
-		if (!(u->losStatus[gu->myAllyTeam] & LOS_INLOS) && !gu->spectatingFullView)
-			continue;
+	for (uint32_t i = 0; i < numDrawFlagCamTypes; ++i) {
+		const uint32_t camType = drawFlagCamTypes[i];
+		const CCamera* cam = CCameraHandler::GetCamera(camType);
 
 		if (!cam->InView(u->drawMidPos, u->GetDrawRadius()))
 			continue;
@@ -433,7 +525,9 @@ void CUnitDrawerData::UpdateObjectDrawFlags(CSolidObject* o) const
 		switch (camType)
 		{
 			case CCamera::CAMTYPE_PLAYER: {
-				const float sqrCamDist = (u->drawPos - cam->GetPos()).SqLength();
+				// mobile units are left alone, they would visibly pop while moving over ridges
+				if (terrainOcclusion && u->unitDef->IsImmobileUnit() && CModelDrawerHelper::ObjectOccludedByTerrain(u->drawMidPos, cam->GetPos(), u->GetDrawRadius()))
+					continue;
 
 				if (!IsAlpha(u)) {
 					u->SetDrawFlag(DrawFlags::SO_OPAQUE_FLAG);
@@ -452,6 +546,9 @@ void CUnitDrawerData::UpdateObjectDrawFlags(CSolidObject* o) const
 			} break;
 
 			case CCamera::CAMTYPE_SHADOW: {
+				if (u->GetDrawRadius() < shadowHandler.GetMinCasterRadius())
+					continue;
+
 				if unlikely(IsAlpha(u))
 					u->AddDrawFlag(DrawFlags::SO_SHTRAN_FLAG);
 				else
@@ -603,7 +700,12 @@ void CUnitDrawerData::RenderUnitDestroyed(const CUnit* unit)
 	const UnitDef* unitDef = unit->unitDef;
 	const UnitDef* decoyDef = unitDef->decoyDef;
 
+	#ifndef HEADLESS
 	const bool addNewGhost = unitDef->IsBuildingUnit() && gameSetup->ghostedBuildings;
+	#else
+	// nobody draws them, and UpdateGhostedBuildings is not part of the sim frame
+	constexpr bool addNewGhost = false;
+	#endif
 
 	// TODO - make ghosted buildings per allyTeam - so they are correctly dealt with
 	// when spectating
@@ -639,6 +741,7 @@ void CUnitDrawerData::RenderUnitDestroyed(const CUnit* unit)
 			// (the ref-counter saves us come deletion time)
 			savedData.deadGhostBuildings[allyTeam][gsoModel->type].push_back(gso);
 			gso->IncRef();
+			AddDeadGhost(allyTeam, gso);
 
 			if (allyTeam == gu->myAllyTeam) {
 				unitsByIcon[u->myIcon].second.push_back(gso);
@@ -141,7 +141,7 @@ public:
 		return savedData.liveGhostBuildings[allyTeam][modelType];
 	}
 
-	auto*       GetSavedData()       { return &savedData; }
+	auto*       GetSavedData()       { deadGhostBlocksValid = false; return &savedData; }
 	const auto* GetSavedData() const { return &savedData; }
 
 	const spring::unsynced_map<icon::CIconData*, std::pair<std::vector<const CUnit*>, std::vector<const GhostSolidObject*> > >& GetUnitsByIcon() const { return unitsByIcon; }
@@ -157,6 +157,12 @@ private:
 	void UpdateUnitIconStateScreen(CUnit* unit);
 	static void UpdateDrawPos(CUnit* unit);
 
+	static int GetDeadGhostBlock(const float3& pos);
+
+	void RebuildDeadGhostBlocks();
+	void AddDeadGhost(int allyTeam, GhostSolidObject* gso);
+	bool RemoveDeadGhostInLos(int allyTeam, GhostSolidObject* gso);
+
 	/// Returns true if the given unit should be drawn as icon in the current frame.
 	bool DrawAsIconByDistance(const CUnit* unit, const float sqUnitCamDist) const;
 	//bool DrawAsIconScreen(CUnit* unit) const;
@@ -181,6 +187,17 @@ public:
 private:
 	SavedData savedData;
 
+	/// dead ghosts per allyTeam, bucketed by blocks of LOS squares s.t. only
+	/// those near newly gained sight have to be tested each frame
+	std::vector< spring::unsynced_map<int, std::vector<GhostSolidObject*>> > deadGhostBlocks;
+	/// dead ghosts created since the last update, their area might be in LOS already
+	std::vector< std::vector<GhostSolidObject*> > newDeadGhosts;
+
+	/// cleared when savedData is exposed (e.g. for loading)
+	bool deadGhostBlocksValid = false;
+
+	static constexpr int DEAD_GHOST_BLOCK_SIZE = 16;
+
 	spring::unsynced_map<icon::CIconData*, std::pair<std::vector<const CUnit*>, std::vector<const GhostSolidObject*> > > unitsByIcon;
 
 	std::vector<UnitDefImage> unitDefImages;
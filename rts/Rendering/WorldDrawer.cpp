@@ -3,8 +3,11 @@
 #include "Rendering/GL/myGL.h"
 
 #include "WorldDrawer.h"
+#include "Sim/Misc/SideParser.h"
+#include "Sim/Units/UnitDef.h"
 #include "Sim/Units/UnitDefHandler.h"
 #include "Sim/Features/FeatureDefHandler.h"
+#include "Sim/Weapons/WeaponDef.h"
 #include "Sim/Weapons/WeaponDefHandler.h"
 #include "Rendering/Env/CubeMapHandler.h"
 #include "Rendering/Env/GrassDrawer.h"
@@ -53,6 +56,7 @@
 #include "System/LoadLock.h"
 
 CONFIG(bool, PreloadModels).defaultValue(true).description("The engine will preload all models");
+CONFIG(bool, PreloadReachableModelsOnly).defaultValue(false).description("Restricts PreloadModels to the units the sides' start units can build (also indirectly) and their weapons; other unit and weapon models load on first use.");
 
 void CWorldDrawer::InitPre() const
 {
@@ -86,7 +90,41 @@ void CWorldDrawer::InitPost() const
 	{
 		loadscreen->SetLoadMessage("Loading Models");
 
-		if (preloadMode) {
+		if (preloadMode && configHandler->GetBool("PreloadReachableModelsOnly")) {
+			// games with many defs often only use a fraction of them in a match
+			std::vector<std::string> startUnits;
+			std::vector<bool> weaponDefsSeen(weaponDefHandler->NumWeaponDefs(), false);
+
+			for (unsigned int i = 0; i < sideParser.GetCount(); i++) {
+				startUnits.push_back(sideParser.GetStartUnit(i));
+			}
+
+			const auto PreloadWeaponDef = [&](const WeaponDef* wd) {
+				if (wd == nullptr || weaponDefsSeen[wd->id])
+					return;
+
+				weaponDefsSeen[wd->id] = true;
+				wd->PreloadModel();
+			};
+
+			for (const int id : unitDefHandler->GetReachableUnitDefIDs(startUnits)) {
+				const UnitDef* ud = unitDefHandler->GetUnitDefByID(id);
+
+				ud->PreloadModel();
+
+				for (const auto& udw : ud->weapons) {
+					PreloadWeaponDef(udw.def);
+				}
+
+				PreloadWeaponDef(ud->deathExpWeaponDef);
+				PreloadWeaponDef(ud->selfdExpWeaponDef);
+			}
+
+			// map features are spawned right away, wrecks are cheap to keep
+			for (const auto& def : featureDefHandler->GetFeatureDefsVec()) {
+				def.PreloadModel();
+			}
+		} else if (preloadMode) {
 			for (const auto& def : unitDefHandler->GetUnitDefsVec()) {
 				def.PreloadModel();
 			}
@@ -155,10 +193,14 @@ void CWorldDrawer::InitPost() const
 	lock = {}; //unlock
 	{
 		loadscreen->SetLoadMessage("Finalizing Models");
-		modelLoader.DrainPreloadFutures(0);
+		{
+			ScopedOnceTimer timer("WorldDrawer::InitPost::WaitPreloadedModels");
+			modelLoader.DrainPreloadFutures(0);
+		}
 		auto& mv = S3DModelVAO::GetInstance();
 		if (preloadMode) {
 			{
+				ScopedOnceTimer timer("WorldDrawer::InitPost::UploadModelVBOs");
 				auto lock = CLoadLock::GetUniqueLock();
 				mv.UploadVBOs();
 			}
@@ -920,11 +920,9 @@ void RenderInterface_GL3_Recoil::RenderGeometry(Rml::CompiledGeometryHandle hand
 	geometry->vao->Bind();
 	glDrawElements(GL_TRIANGLES, geometry->num_indices, GL_UNSIGNED_INT, nullptr);
 	geometry->vao->Unbind();
-	
-	if (texture != TexturePostprocess) {
-		UseProgram(ProgramId::None);
-		glBindTexture(GL_TEXTURE_2D, 0);
-	}
+
+	// the program stays active for the next draw, consecutive geometry nearly always
+	// uses the same one; UseProgram skips redundant switches and EndFrame resets it
 
 	Gfx::CheckGLError("RenderCompiledGeometry");
 }
@@ -37,6 +37,8 @@ CR_BIND_DERIVED_POOL(CFeature, CSolidObject, , featureMemPool.allocMem, featureM
 CR_REG_METADATA(CFeature, (
 	CR_MEMBER(isRepairingBeforeResurrect),
 	CR_MEMBER(inUpdateQue),
+	CR_MEMBER(inPrevFrameQue),
+	CR_MEMBER(positionSettled),
 	CR_MEMBER(deleteMe),
 	CR_MEMBER(alphaFade),
 
@@ -154,7 +156,7 @@ void CFeature::Initialize(const FeatureLoadParams& params)
 	RECOIL_DETAILED_TRACY_ZONE;
 	const CSolidObject* po = params.parentObj;
 
-	prevFrameNeedsUpdate = true;
+	SetPrevFrameNeedsUpdate();
 
 	def = params.featureDef;
 	udef = params.unitDef;
@@ -473,7 +475,10 @@ void CFeature::ForcedMove(const float3& newPos)
 	// remove from managers
 	quadField.RemoveFeature(this);
 
-	prevFrameNeedsUpdate = true;
+	// might have been moved off the ground, let gravity act again if queued
+	positionSettled = false;
+
+	SetPrevFrameNeedsUpdate();
 
 	UnBlock();
 	Move(newPos - pos, true);
@@ -497,7 +502,7 @@ void CFeature::ForcedSpin(const float3& newDir)
 	CSolidObject::ForcedSpin(newDir);
 	UpdateTransform(pos, true);
 
-	prevFrameNeedsUpdate = true;
+	SetPrevFrameNeedsUpdate();
 }
 
 void CFeature::ForcedSpin(const float3& newFrontDir, const float3& newRightDir)
@@ -507,7 +512,7 @@ void CFeature::ForcedSpin(const float3& newFrontDir, const float3& newRightDir)
 	CSolidObject::ForcedSpin(newFrontDir, newRightDir);
 	UpdateTransform(pos, true);
 
-	prevFrameNeedsUpdate = true;
+	SetPrevFrameNeedsUpdate();
 }
 
 
@@ -517,7 +522,7 @@ void CFeature::UpdateTransformAndPhysState()
 	UpdateDirVectors(!def->upright && IsOnGround(), true, 0.0f);
 	UpdateTransform(pos, true);
 
-	prevFrameNeedsUpdate = true;
+	SetPrevFrameNeedsUpdate();
 
 	UpdatePhysicalStateBit(CSolidObject::PSTATE_BIT_MOVING, (SetSpeed(speed) != 0.0f));
 	UpdatePhysicalState(0.1f);
@@ -577,7 +582,7 @@ bool CFeature::UpdateVelocity(
 bool CFeature::UpdatePosition()
 {
 	RECOIL_DETAILED_TRACY_ZONE;
-	prevFrameNeedsUpdate = true;
+	SetPrevFrameNeedsUpdate();
 	// const float4 oldSpd = speed;
 
 	if (moveCtrl.enabled) {
@@ -624,6 +629,12 @@ bool CFeature::UpdatePosition()
 	return (moveCtrl.enabled);
 }
 
+void CFeature::SetPrevFrameNeedsUpdate()
+{
+	prevFrameNeedsUpdate = true;
+	featureHandler.SetFeaturePrevFrameUpdateable(this);
+}
+
 void CFeature::UpdatePrevFrameTransform()
 {
 	if (!prevFrameNeedsUpdate)
@@ -636,7 +647,14 @@ void CFeature::UpdatePrevFrameTransform()
 bool CFeature::Update()
 {
 	RECOIL_DETAILED_TRACY_ZONE;
-	bool continueUpdating = UpdatePosition();
+	// a feature that came to rest stays there until SetFeatureUpdateable, a
+	// ForcedMove or Lua changing its speed wakes it, so only smoke and fire
+	// need to be processed; UpdatePosition zeroes the speed when settling
+	const bool skipPosition = (positionSettled && speed.w == 0.0f && !moveCtrl.enabled);
+
+	bool continueUpdating = (!skipPosition && UpdatePosition());
+
+	positionSettled = !continueUpdating;
 
 	continueUpdating |= (smokeTime != 0);
 	continueUpdating |= (fireTime != 0);
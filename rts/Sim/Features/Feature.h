@@ -104,6 +104,7 @@ public:
 
 private:
 	void PostLoad();
+	void SetPrevFrameNeedsUpdate();
 
 	static int ChunkNumber(float f);
 
@@ -117,6 +118,10 @@ public:
 	 */
 	bool isRepairingBeforeResurrect = false;
 	bool inUpdateQue = false;
+	bool inPrevFrameQue = false;
+	// set while resting in the update-queue (e.g. smoking or a geo-vent),
+	// Update then skips the physics until something moves us again
+	bool positionSettled = false;
 	bool deleteMe = false;
 	bool alphaFade = true; // unsynced
 
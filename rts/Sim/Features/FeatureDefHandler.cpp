@@ -33,28 +33,31 @@ void CFeatureDefHandler::Init(LuaParser* defsParser)
 	featureDefsVector.reserve(keys.size());
 	featureDefsVector.emplace_back();
 
-	for (unsigned int i = 0; i < keys.size(); i++) {
-		const std::string& nameMixedCase = keys[i];
-		const std::string& nameLowerCase = StringToLower(nameMixedCase);
-		const LuaTable& fdTable = rootTable.SubTable(nameMixedCase);
+	// (featureDefID, featureDead) pairs, resolved once all defs exist
+	std::vector<std::pair<int, std::string>> deadNames;
+	deadNames.reserve(keys.size());
 
-		AddFeatureDef(nameLowerCase, CreateFeatureDef(fdTable, nameLowerCase), false);
-	}
 	for (unsigned int i = 0; i < keys.size(); i++) {
 		const std::string& nameMixedCase = keys[i];
 		const std::string& nameLowerCase = StringToLower(nameMixedCase);
 		const LuaTable& fdTable = rootTable.SubTable(nameMixedCase);
 
-		const FeatureDef* fd = GetFeatureDef(nameLowerCase);
-		const FeatureDef* dfd = GetFeatureDef(fdTable.GetString("featureDead", ""));
+		FeatureDef* fd = CreateFeatureDef(fdTable, nameLowerCase);
+
+		AddFeatureDef(nameLowerCase, fd, false);
 
 		if (fd == nullptr)
 			continue;
 
+		deadNames.emplace_back(fd->id, fdTable.GetString("featureDead", ""));
+	}
+	for (const auto& [featureDefID, deadName]: deadNames) {
+		const FeatureDef* dfd = GetFeatureDef(deadName);
+
 		if (dfd == nullptr)
 			continue;
 
-		const_cast<FeatureDef*>(fd)->deathFeatureDefID = dfd->id;
+		featureDefsVector[featureDefID].deathFeatureDefID = dfd->id;
 	}
 }
 
@@ -12,6 +12,7 @@
 #include "Sim/Units/CommandAI/BuilderCaches.h"
 #include "System/creg/STL_Set.h"
 #include "System/EventHandler.h"
+#include "System/MemPoolStats.h"
 #include "System/TimeProfiler.h"
 
 #include "System/Misc/TracyDefs.h"
@@ -25,12 +26,14 @@ CR_REG_METADATA(CFeatureHandler, (
 	CR_MEMBER(activeFeatureIDs),
 	CR_MEMBER(features),
 	CR_MEMBER(updateFeatures),
+	CR_MEMBER(prevFrameFeatures),
 	CR_MEMBER(featuresJustAdded)
 ))
 
 /******************************************************************************/
 
 FeatureMemPool featureMemPool;
+static MemPoolRegistrar featureMemPoolRegistrar("Features", featureMemPool);
 
 CFeatureHandler featureHandler;
 
@@ -59,6 +62,7 @@ void CFeatureHandler::Kill() {
 	deletedFeatureIDs.clear();
 	features.clear();
 	updateFeatures.clear();
+	prevFrameFeatures.clear();
 }
 
 
@@ -191,12 +195,13 @@ void CFeatureHandler::UpdatePreFrame()
 {
 	SCOPED_TIMER("Sim::Features::UpdatePreFrame");
 
-	for (auto* feature : features) {
-		if (!feature) // sucks, but w/e
-			continue;
-
+	// only features that moved, spun or got created since the last frame
+	for (CFeature* feature: prevFrameFeatures) {
 		feature->UpdatePrevFrameTransform();
+		feature->inPrevFrameQue = false;
 	}
+
+	prevFrameFeatures.clear();
 }
 
 void CFeatureHandler::UpdatePostFrame()
@@ -255,6 +260,9 @@ bool CFeatureHandler::UpdateFeature(CFeature* feature)
 
 		spring::VectorErase(featuresJustAdded, feature);
 
+		if (feature->inPrevFrameQue)
+			spring::VectorErase(prevFrameFeatures, feature);
+
 		eventHandler.RenderFeatureDestroyed(feature);
 		eventHandler.FeatureDestroyed(feature);
 
@@ -284,6 +292,9 @@ bool CFeatureHandler::UpdateFeature(CFeature* feature)
 void CFeatureHandler::SetFeatureUpdateable(CFeature* feature)
 {
 	RECOIL_DETAILED_TRACY_ZONE;
+	// whatever queued us (terrain change, new velocity, ...) might move us
+	feature->positionSettled = false;
+
 	if (feature->inUpdateQue) {
 		assert(std::find(updateFeatures.begin(), updateFeatures.end(), feature) != updateFeatures.end());
 		return;
@@ -293,6 +304,15 @@ void CFeatureHandler::SetFeatureUpdateable(CFeature* feature)
 	feature->inUpdateQue = spring::VectorInsertUnique(updateFeatures, feature);
 }
 
+void CFeatureHandler::SetFeaturePrevFrameUpdateable(CFeature* feature)
+{
+	if (feature->inPrevFrameQue)
+		return;
+
+	feature->inPrevFrameQue = true;
+	prevFrameFeatures.push_back(feature);
+}
+
 
 void CFeatureHandler::TerrainChanged(int x1, int y1, int x2, int y2)
 {
@@ -65,6 +65,7 @@ public:
 	void LoadFeaturesFromMap();
 
 	void SetFeatureUpdateable(CFeature* feature);
+	void SetFeaturePrevFrameUpdateable(CFeature* feature);
 	void TerrainChanged(int x1, int y1, int x2, int y2);
 
 	const spring::unordered_set<int>& GetActiveFeatureIDs() const { return activeFeatureIDs; }
@@ -90,6 +91,8 @@ private:
 	std::vector<int> deletedFeatureIDs;
 	std::vector<CFeature*> features;
 	std::vector<CFeature*> updateFeatures;
+	// features whose interpolation transform is stale, the rest are static
+	std::vector<CFeature*> prevFrameFeatures;
 	std::vector<CFeature*> featuresJustAdded;
 };
 
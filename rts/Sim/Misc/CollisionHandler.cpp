@@ -10,6 +10,8 @@
 #include "System/Matrix44f.h"
 #include "System/Log/ILog.h"
 
+#include "xsimd/xsimd.hpp"
+
 #include "System/Misc/TracyDefs.h"
 
 unsigned int CCollisionHandler::numDiscTests = 0;
@@ -76,6 +78,98 @@ bool CCollisionHandler::DetectHit(
 
 
 
+float4 CCollisionHandler::GetHitTestSphere(const CSolidObject* o)
+{
+	const CollisionVolume* v = &o->collisionVolume;
+
+	if (o->IsInVoid())
+		return {ZeroVector, -1.0f};
+
+	// piece volumes are not bounded by the object's own volume
+	if (v->DefaultToPieceTree())
+		return {o->midPos, 1.0e15f};
+
+	if (v->IgnoreHits())
+		return {ZeroVector, -1.0f};
+
+	// pad by an elmo to absorb the rounding of the matrix-space tests
+	return {v->GetWorldSpacePos(o), v->GetBoundingRadius() + 1.0f};
+}
+
+size_t CCollisionHandler::SegmentSpheresOverlap(
+	const float3& p0,
+	const float3& p1,
+	const CollisionSphereBatch& spheres,
+	std::vector<uint32_t>& indices
+) {
+	RECOIL_DETAILED_TRACY_ZONE;
+	using FloatBatch = xsimd::batch<float, 4>;
+
+	constexpr size_t BATCH_SIZE = FloatBatch::size;
+
+	// closest point to each center on the segment is p0 + d * clamp(dot(c - p0, d) / dot(d, d), 0, 1)
+	const float3 d = p1 - p0;
+	const float dd = d.dot(d);
+	const float invdd = (dd > 0.0f)? (1.0f / dd): 0.0f;
+
+	const size_t numSpheres = spheres.Size();
+	const size_t numBatched = numSpheres - (numSpheres % BATCH_SIZE);
+
+	indices.clear();
+	indices.reserve(numSpheres);
+
+	{
+		const FloatBatch p0x(p0.x), p0y(p0.y), p0z(p0.z);
+		const FloatBatch  dx( d.x),  dy( d.y),  dz( d.z);
+		const FloatBatch vinvdd(invdd);
+		const FloatBatch zeros(0.0f);
+		const FloatBatch  ones(1.0f);
+
+		const auto LoadBatch = [](const float* src) {
+			FloatBatch b;
+			b.load_unaligned(src);
+			return b;
+		};
+
+		alignas(16) float laneHits[BATCH_SIZE];
+
+		for (size_t i = 0; i < numBatched; i += BATCH_SIZE) {
+			const FloatBatch cx = LoadBatch(&spheres.xs[i]) - p0x;
+			const FloatBatch cy = LoadBatch(&spheres.ys[i]) - p0y;
+			const FloatBatch cz = LoadBatch(&spheres.zs[i]) - p0z;
+
+			const FloatBatch t = xsimd::min(xsimd::max((cx * dx + cy * dy + cz * dz) * vinvdd, zeros), ones);
+
+			const FloatBatch ex = cx - dx * t;
+			const FloatBatch ey = cy - dy * t;
+			const FloatBatch ez = cz - dz * t;
+
+			const auto hit = ((ex * ex + ey * ey + ez * ez) <= LoadBatch(&spheres.rSqs[i]));
+
+			if (!xsimd::any(hit))
+				continue;
+
+			xsimd::select(hit, ones, zeros).store_aligned(laneHits);
+
+			for (size_t j = 0; j < BATCH_SIZE; ++j) {
+				if (laneHits[j] != 0.0f)
+					indices.push_back(i + j);
+			}
+		}
+	}
+
+	for (size_t i = numBatched; i < numSpheres; ++i) {
+		const float3 c = float3(spheres.xs[i], spheres.ys[i], spheres.zs[i]) - p0;
+		const float t = std::clamp(c.dot(d) * invdd, 0.0f, 1.0f);
+
+		if ((c - d * t).SqLength() <= spheres.rSqs[i])
+			indices.push_back(i);
+	}
+
+	return indices.size();
+}
+
+
 bool CCollisionHandler::Collision(
 	const CSolidObject* o,
 	const CollisionVolume* v,
@@ -5,9 +5,12 @@
 
 #include "System/creg/creg_cond.h"
 #include "System/float3.h"
+#include "System/float4.h"
 #include "System/Matrix44f.h"
 
 #include <algorithm>
+#include <cstdint>
+#include <vector>
 
 class CSolidObject;
 struct LocalModelPiece;
@@ -86,6 +89,33 @@ private:
 	const LocalModelPiece* lmp = nullptr;
 };
 
+// bounding spheres of many objects stored per component, such that
+// CCollisionHandler can test a segment against several of them at once
+struct CollisionSphereBatch {
+public:
+	void Clear() {
+		xs.clear();
+		ys.clear();
+		zs.clear();
+		rSqs.clear();
+	}
+	// negative <s.w> marks a sphere that can never be touched
+	void Add(const float4& s) {
+		xs.push_back(s.x);
+		ys.push_back(s.y);
+		zs.push_back(s.z);
+		rSqs.push_back((s.w < 0.0f)? -1.0f: (s.w * s.w));
+	}
+
+	size_t Size() const { return rSqs.size(); }
+
+public:
+	std::vector<float> xs;
+	std::vector<float> ys;
+	std::vector<float> zs;
+	std::vector<float> rSqs;
+};
+
 /**
  * Responsible for detecting hits between projectiles
  * and solid objects (units, features), each SO has a
@@ -112,6 +142,24 @@ class CCollisionHandler {
 			CollisionQuery* cq = nullptr,
 			bool forceTrace = false
 		);
+		/**
+		 * Sphere (xyz = center, w = radius) that DetectHit(o, o->GetTransformMatrix(true), ...)
+		 * can not report a hit outside of; w is negative if DetectHit never hits <o> at all.
+		 */
+		static float4 GetHitTestSphere(const CSolidObject* o);
+		/**
+		 * Conservative broadphase for one segment against many objects: writes the
+		 * indices of the spheres in <spheres> that segment [p0, p1] touches to
+		 * <indices> (in increasing order), testing four spheres per SIMD pass.
+		 * @return number of indices written
+		 */
+		static size_t SegmentSpheresOverlap(
+			const float3& p0,
+			const float3& p1,
+			const CollisionSphereBatch& spheres,
+			std::vector<uint32_t>& indices
+		);
+
 		static bool MouseHit(
 			const CSolidObject* o,
 			const CMatrix44f& m,
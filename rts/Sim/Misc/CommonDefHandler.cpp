@@ -55,29 +55,57 @@ size_t CommonDefHandler::SoundSetDataCount()
 }
 
 
-int CommonDefHandler::LoadSoundFile(const std::string& fileName)
+std::string CommonDefHandler::ResolveSoundFile(const std::string& fileName)
 {
 	RECOIL_DETAILED_TRACY_ZONE;
-	if (!fileName.empty()) {
-		const std::string soundExt = FileSystem::GetExtension(fileName);
+	if (fileName.empty())
+		return "";
 
-		// unlike constructing a CFileHandler this does not read the data
-		// into memory; faster for large files and many small individually
-		// compressed sounds (e.g. in pool archives)
-		const bool foundExt = (std::find(soundExts.cbegin(), soundExts.cend(), soundExt) != soundExts.cend());
-		const bool haveFile = (foundExt && CFileHandler::FileExists(fileName, SPRING_VFS_RAW_FIRST));
-		const bool haveItem = (haveFile || sound->HasSoundItem(fileName));
+	const std::string soundExt = FileSystem::GetExtension(fileName);
 
-		if (haveItem)
-			return (sound->GetSoundId(fileName));
+	// unlike constructing a CFileHandler this does not read the data
+	// into memory; faster for large files and many small individually
+	// compressed sounds (e.g. in pool archives)
+	const bool foundExt = (std::find(soundExts.cbegin(), soundExts.cend(), soundExt) != soundExts.cend());
+	const bool haveFile = (foundExt && CFileHandler::FileExists(fileName, SPRING_VFS_RAW_FIRST));
+	const bool haveItem = (haveFile || sound->HasSoundItem(fileName));
 
-		const std::string soundFile = "sounds/" + fileName + ((soundExt.empty())? ".wav": "");
+	if (haveItem)
+		return fileName;
 
-		if (CFileHandler::FileExists(soundFile, SPRING_VFS_RAW_FIRST))
-			return (sound->GetSoundId(soundFile));
+	const std::string soundFile = "sounds/" + fileName + ((soundExt.empty())? ".wav": "");
 
-		LOG_L(L_WARNING, "[%s] could not load sound \"%s\" from {Unit,Weapon}Def", __func__, fileName.c_str());
-	}
+	if (CFileHandler::FileExists(soundFile, SPRING_VFS_RAW_FIRST))
+		return soundFile;
+
+	return "";
+}
+
+int CommonDefHandler::LoadSoundFile(const std::string& fileName)
+{
+	RECOIL_DETAILED_TRACY_ZONE;
+	if (fileName.empty())
+		return 0;
+
+	const std::string soundFile = ResolveSoundFile(fileName);
 
+	if (!soundFile.empty())
+		return (sound->GetSoundId(soundFile));
+
+	LOG_L(L_WARNING, "[%s] could not load sound \"%s\" from {Unit,Weapon}Def", __func__, fileName.c_str());
 	return 0;
 }
+
+void CommonDefHandler::PreDecodeSounds()
+{
+	RECOIL_DETAILED_TRACY_ZONE;
+	// [0] is the dummy entry
+	for (size_t i = 1; i < soundSetData.size(); i++) {
+		const std::string soundFile = ResolveSoundFile(soundSetData[i].name);
+
+		if (soundFile.empty())
+			continue;
+
+		sound->PreDecodeSound(soundFile);
+	}
+}
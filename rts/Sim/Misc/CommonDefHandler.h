@@ -21,6 +21,13 @@ public:
 
 	// loads a soundfile, adds "sounds/" prefix and ".wav" extension if necessary
 	static int LoadSoundFile(const std::string& fileName);
+
+	// starts decoding all {Unit,Weapon}Def sounds in the background
+	static void PreDecodeSounds();
+
+private:
+	// the name LoadSoundFile passes to the sound system, empty if none
+	static std::string ResolveSoundFile(const std::string& fileName);
 };
 
 #endif
@@ -28,7 +28,8 @@ CR_BIND(CGroundBlockingObjectMap, )
 CR_REG_METADATA(CGroundBlockingObjectMap, (
 	CR_MEMBER(arrCells),
 	CR_MEMBER(vecCells),
-	CR_MEMBER(vecIndcs)
+	CR_MEMBER(vecIndcs),
+	CR_MEMBER(cellMasks)
 ))
 
 
@@ -288,6 +289,9 @@ bool CGroundBlockingObjectMap::CellInsertUnique(unsigned int sqr, CSolidObject*
 
 	if (ac.Contains(o))
 		return false;
+
+	cellMasks[sqr] |= GetObjectCellMask(o);
+
 	if (ac.Insert(o))
 		return true;
 
@@ -312,8 +316,10 @@ bool CGroundBlockingObjectMap::CellErase(unsigned int sqr, CSolidObject* o) {
 	VecCell* vc = nullptr;
 
 	if (ac.Erase(o)) {
-		if (ac.GetVecIndx() == 0)
+		if (ac.GetVecIndx() == 0) {
+			UpdateCellMask(sqr);
 			return true;
+		}
 
 		// never allow a hole between array and vector parts
 		assert(!vecCells[ac.GetVecIndx()].empty());
@@ -342,6 +348,18 @@ CommonExit:
 		ac.SetVecIndx(0);
 	}
 
+	UpdateCellMask(sqr);
 	return true;
 }
 
+void CGroundBlockingObjectMap::UpdateCellMask(unsigned int sqr) {
+	const BlockingMapCell& cell = GetCellUnsafeConst(sqr);
+	uint8_t mask = 0;
+
+	for (size_t i = 0, n = cell.size(); i < n; i++) {
+		mask |= GetObjectCellMask(cell[i]);
+	}
+
+	cellMasks[sqr] = mask;
+}
+
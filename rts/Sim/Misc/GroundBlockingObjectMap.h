@@ -73,6 +73,14 @@ private:
 	typedef std::vector<CSolidObject*> VecCell;
 
 public:
+	// packed per-square summary of which kinds of objects block it,
+	// lets range scans skip empty squares without touching the cells
+	enum CellMaskBits {
+		CELL_MASK_STRUCTURE = 1 << 0, // objects without a MoveDef
+		CELL_MASK_MOBILE    = 1 << 1, // objects with a MoveDef
+		CELL_MASK_YARDMAP   = 1 << 2, // objects blocking through a yardmap
+	};
+
 	struct BlockingMapCell {
 	public:
 		BlockingMapCell() = delete;
@@ -99,6 +107,7 @@ public:
 
 	void Init(unsigned int numSquares) {
 		arrCells.resize(numSquares);
+		cellMasks.resize(numSquares, 0);
 		vecCells.reserve(32);
 		vecIndcs.reserve(32);
 
@@ -112,6 +121,8 @@ public:
 		for (auto& v: arrCells) {
 			v.Clear();
 		}
+
+		std::fill(cellMasks.begin(), cellMasks.end(), 0);
 		for (auto& v: vecCells) {
 			v.clear();
 		}
@@ -164,6 +175,12 @@ public:
 	}
 
 
+	// CELL_MASK_* bits of the objects in a cell; zero iff the cell is empty
+	uint8_t GetCellMaskUnsafe(unsigned int mapSquare) const {
+		assert(mapSquare < cellMasks.size());
+		return cellMasks[mapSquare];
+	}
+
 	BlockingMapCell GetCellUnsafeConst(const float3& pos) const;
 	BlockingMapCell GetCellUnsafeConst(unsigned int mapSquare) const {
 		assert(mapSquare < arrCells.size());
@@ -182,10 +199,18 @@ private:
 	bool CellInsertUnique(unsigned int sqr, CSolidObject* o);
 	bool CellErase(unsigned int sqr, CSolidObject* o);
 
+	static uint8_t GetObjectCellMask(const CSolidObject* o) {
+		uint8_t mask = (o->moveDef != nullptr)? CELL_MASK_MOBILE: CELL_MASK_STRUCTURE;
+		mask |= (CELL_MASK_YARDMAP * (o->GetBlockMap() != nullptr));
+		return mask;
+	}
+	void UpdateCellMask(unsigned int sqr);
+
 private:
 	std::vector<ArrCell> arrCells;
 	std::vector<VecCell> vecCells;
 	std::vector<uint32_t> vecIndcs;
+	std::vector<uint8_t> cellMasks;
 };
 
 extern CGroundBlockingObjectMap groundBlockingObjectMap;
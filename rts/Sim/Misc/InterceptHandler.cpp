@@ -7,6 +7,7 @@
 
 #include "Map/Ground.h"
 #include "Sim/Misc/GlobalSynced.h"
+#include "Sim/Misc/ModInfo.h"
 #include "Sim/Misc/TeamHandler.h"
 #include "Sim/Weapons/Weapon.h"
 #include "Sim/Projectiles/WeaponProjectiles/WeaponProjectile.h"
@@ -36,85 +37,113 @@ void CInterceptHandler::Update(bool forced) {
 		return;
 
 	for (CWeapon* w: interceptors) {
-		const WeaponDef* wDef = w->weaponDef;
-		const CUnit* wOwner = w->owner;
-
-		assert(wDef->interceptor || wDef->isShield);
+		assert(w->weaponDef->interceptor || w->weaponDef->isShield);
 
 		for (CWeaponProjectile* p: interceptables) {
-			if (!p->CanBeInterceptedBy(wDef))
-				continue;
-			if (w->HasIncomingProjectile(p->id))
-				continue;
-
-			const int pAllyTeam = p->GetAllyteamID();
-
-			if (teamHandler.IsValidAllyTeam(pAllyTeam) && teamHandler.Ally(wOwner->allyteam, pAllyTeam))
-				continue;
-
-			// note: will be called every Update so long as gadget does not return true
-			if (!eventHandler.AllowWeaponInterceptTarget(wOwner, w, p))
-				continue;
-
-			// there are four cases when an interceptor <w> should fire at a projectile <p>:
-			//     1. p's target position inside w's interception circle (w's owner can move!)
-			//     2. p's current position inside w's interception circle
-			//     3. p's projected impact position inside w's interception circle
-			//     4. p's trajectory intersects w's interception circle
-			//
-			// these checks all need to be evaluated periodically, not just
-			// when a projectile is created and handed to AddInterceptTarget
-			const float weaponDist = w->aimFromPos.distance(p->pos);
-			const float impactDist = CGround::LineGroundCol(p->pos, p->pos + p->dir * weaponDist);
-
-			const float3& pImpactPos = p->pos + p->dir * impactDist;
-			const float3& pTargetPos = p->GetTargetPos();
-			const float3  pWeaponVec = p->pos - w->aimFromPos;
-
-			if (w->aimFromPos.SqDistance2D(pTargetPos) < Square(wDef->coverageRange)) {
-				w->AddDeathDependence(p, DEPENDENCE_INTERCEPT);
-				w->AddIncomingProjectile(p->id);
-				continue; // 1
-			}
-
-			if (false /*wDef->noFlyThroughIntercept*/) {
-				// <w> is just a static interceptor and fires only at projectiles
-				// TARGETED within its current interception area; any projectiles
-				// CROSSING its interception area aren't targeted
-				//XXX implement in lua?
-				continue;
-			}
-
-			if (pWeaponVec.SqLength2D() < Square(wDef->coverageRange)) {
-				w->AddDeathDependence(p, DEPENDENCE_INTERCEPT);
-				w->AddIncomingProjectile(p->id);
-				continue; // 2
-			}
-
-			if (w->aimFromPos.SqDistance2D(pImpactPos) < Square(wDef->coverageRange)) {
-				const float3 pTargetDir = (pTargetPos - p->pos).SafeNormalize();
-				const float3 pImpactDir = (pImpactPos - p->pos).SafeNormalize();
-
-				// the projected impact position can briefly shift into the covered
-				// area during transition from vertical to horizontal flight, so we
-				// perform an extra test (NOTE: assumes non-parabolic trajectory)
-				if (pTargetDir.dot(pImpactDir) >= 0.999f) {
-					w->AddDeathDependence(p, DEPENDENCE_INTERCEPT);
-					w->AddIncomingProjectile(p->id);
-					continue; // 3
-				}
-			}
-
-			const float3 pMinSepPos = p->pos + p->dir * std::clamp(-(pWeaponVec.dot(p->dir)), 0.0f, impactDist);
-			const float3 pMinSepVec = w->aimFromPos - pMinSepPos;
-
-			if (pMinSepVec.SqLength() < Square(wDef->coverageRange)) {
-				w->AddDeathDependence(p, DEPENDENCE_INTERCEPT);
-				w->AddIncomingProjectile(p->id);
-				continue; // 4
-			}
+			UpdateInterceptTarget(w, p);
+		}
+	}
+}
+
+// conservative test whether any of the four positions checked by UpdateInterceptTarget
+// can be inside <w>'s coverage: all but p's target position lie on p's line of flight
+// from one elmo behind p onwards (impactDist is -1 when LineGroundCol misses)
+bool CInterceptHandler::CanReachCoverage(const CWeapon* w, const CWeaponProjectile* p)
+{
+	const float coverageRange = w->weaponDef->coverageRange + 1.0f;
+
+	if (w->aimFromPos.SqDistance2D(p->GetTargetPos()) < Square(coverageRange))
+		return true;
+
+	const float3 flightDir = p->dir * XZVector;
+	const float3 startVec = (p->pos - p->dir) - w->aimFromPos;
+
+	const float dirSqLen = flightDir.SqLength2D();
+	const float startDist = (dirSqLen > 0.0f)? std::max(0.0f, -startVec.dot2D(flightDir) / dirSqLen): 0.0f;
+
+	return ((startVec + flightDir * startDist).SqLength2D() < Square(coverageRange));
+}
+
+void CInterceptHandler::UpdateInterceptTarget(CWeapon* w, CWeaponProjectile* p)
+{
+	RECOIL_DETAILED_TRACY_ZONE;
+	const WeaponDef* wDef = w->weaponDef;
+	const CUnit* wOwner = w->owner;
+
+	if (!p->CanBeInterceptedBy(wDef))
+		return;
+	if (w->HasIncomingProjectile(p->id))
+		return;
+
+	const int pAllyTeam = p->GetAllyteamID();
+
+	if (teamHandler.IsValidAllyTeam(pAllyTeam) && teamHandler.Ally(wOwner->allyteam, pAllyTeam))
+		return;
+
+	if (modInfo.incrementalInterception && !CanReachCoverage(w, p))
+		return;
+
+	// note: will be called every Update so long as gadget does not return true
+	if (!eventHandler.AllowWeaponInterceptTarget(wOwner, w, p))
+		return;
+
+	// there are four cases when an interceptor <w> should fire at a projectile <p>:
+	//     1. p's target position inside w's interception circle (w's owner can move!)
+	//     2. p's current position inside w's interception circle
+	//     3. p's projected impact position inside w's interception circle
+	//     4. p's trajectory intersects w's interception circle
+	//
+	// these checks all need to be evaluated periodically, not just
+	// when a projectile is created and handed to AddInterceptTarget
+	const float weaponDist = w->aimFromPos.distance(p->pos);
+	const float impactDist = CGround::LineGroundCol(p->pos, p->pos + p->dir * weaponDist);
+
+	const float3& pImpactPos = p->pos + p->dir * impactDist;
+	const float3& pTargetPos = p->GetTargetPos();
+	const float3  pWeaponVec = p->pos - w->aimFromPos;
+
+	if (w->aimFromPos.SqDistance2D(pTargetPos) < Square(wDef->coverageRange)) {
+		w->AddDeathDependence(p, DEPENDENCE_INTERCEPT);
+		w->AddIncomingProjectile(p->id);
+		return; // 1
+	}
+
+	if (false /*wDef->noFlyThroughIntercept*/) {
+		// <w> is just a static interceptor and fires only at projectiles
+		// TARGETED within its current interception area; any projectiles
+		// CROSSING its interception area aren't targeted
+		//XXX implement in lua?
+		return;
+	}
+
+	if (pWeaponVec.SqLength2D() < Square(wDef->coverageRange)) {
+		w->AddDeathDependence(p, DEPENDENCE_INTERCEPT);
+		w->AddIncomingProjectile(p->id);
+		return; // 2
+	}
+
+	if (w->aimFromPos.SqDistance2D(pImpactPos) < Square(wDef->coverageRange)) {
+		const float3 pTargetDir = (pTargetPos - p->pos).SafeNormalize();
+		const float3 pImpactDir = (pImpactPos - p->pos).SafeNormalize();
+
+		// the projected impact position can briefly shift into the covered
+		// area during transition from vertical to horizontal flight, so we
+		// perform an extra test (NOTE: assumes non-parabolic trajectory)
+		if (pTargetDir.dot(pImpactDir) >= 0.999f) {
+			w->AddDeathDependence(p, DEPENDENCE_INTERCEPT);
+			w->AddIncomingProjectile(p->id);
+			return; // 3
 		}
 	}
+
+	const float3 pMinSepPos = p->pos + p->dir * std::clamp(-(pWeaponVec.dot(p->dir)), 0.0f, impactDist);
+	const float3 pMinSepVec = w->aimFromPos - pMinSepPos;
+
+	if (pMinSepVec.SqLength() < Square(wDef->coverageRange)) {
+		w->AddDeathDependence(p, DEPENDENCE_INTERCEPT);
+		w->AddIncomingProjectile(p->id);
+		return; // 4
+	}
 }
 
 
@@ -147,7 +176,15 @@ void CInterceptHandler::AddInterceptTarget(CWeaponProjectile* target, const floa
 	// die before the interceptable itself does)
 	AddDeathDependence(target, DEPENDENCE_INTERCEPTABLE);
 
-	Update(true);
+	if (!modInfo.incrementalInterception) {
+		Update(true);
+		return;
+	}
+
+	// pairs with older targets are re-evaluated by the regular Update
+	for (CWeapon* w: interceptors) {
+		UpdateInterceptTarget(w, target);
+	}
 }
 
 
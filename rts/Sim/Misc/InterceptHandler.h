@@ -26,6 +26,11 @@ public:
 
 	void DependentDied(CObject* o);
 
+private:
+	void UpdateInterceptTarget(CWeapon* w, CWeaponProjectile* p);
+
+	static bool CanReachCoverage(const CWeapon* w, const CWeaponProjectile* p);
+
 private:
 	std::deque<CWeapon*> interceptors;
 	std::deque<CWeaponProjectile*> interceptables;
@@ -43,7 +43,12 @@ CR_REG_METADATA(CLosHandler,(
 	CR_MEMBER(baseRadarErrorSize),
 	CR_MEMBER(baseRadarErrorMult),
 	CR_MEMBER(radarErrorSizes),
-	CR_IGNORED(losTypes)
+	CR_IGNORED(losTypes),
+	CR_IGNORED(asyncRaycasts),
+	CR_IGNORED(asyncRaycastTasks),
+	CR_IGNORED(asyncRaycastIndex),
+	CR_IGNORED(asyncUpdatePending),
+	CR_IGNORED(asyncUpdateMutex)
 ))
 
 
@@ -74,6 +79,7 @@ inline void SLosInstance::Init(int radius, int allyteam, int2 basePos, float bas
 size_t ILosType::cacheFails = 1;
 size_t ILosType::cacheHits  = 1;
 size_t ILosType::cacheRefs  = 1;
+size_t ILosType::footprintShares = 0;
 
 constexpr float CLosHandler::defBaseRadarErrorSize;
 constexpr float CLosHandler::defBaseRadarErrorMult;
@@ -93,6 +99,7 @@ void ILosType::Init(const int mipLevel_, LosType type_)
 
 	freeIDs.reserve(4096);
 	losMaps.resize(teamHandler.ActiveAllyTeams());
+	gainedAreas.resize(teamHandler.ActiveAllyTeams());
 
 	const float* ctrHeightMap = readMap->GetCenterHeightMapSynced();
 	const float* mipHeightMap = readMap->GetMIPHeightMapSynced(mipLevel_);
@@ -126,6 +133,9 @@ void ILosType::Kill()
 	losAdd.clear();
 	losDeleted.clear();
 	losRecalc.clear();
+	gainedAreas.clear();
+	losShared.clear();
+	spring::clear_unordered_map(recalcFootprints);
 
 	// mark as invalid
 	size = {0, 0};
@@ -499,6 +509,29 @@ inline int ILosType::GetHashNum(const int allyteam, const int2 baseLos, const fl
 void ILosType::Update()
 {
 	RECOIL_DETAILED_TRACY_ZONE;
+	if (!UpdateBegin())
+		return;
+
+	// raycast terrain
+	if (algoType == LOS_ALGO_RAYCAST) {
+		for_mt(0, losRecalc.size(), [&](const int idx) {
+			UpdateRaycast(idx);
+		});
+	}
+
+	UpdateEnd();
+}
+
+bool ILosType::UpdateBegin()
+{
+	RECOIL_DETAILED_TRACY_ZONE;
+	// nothing is recalculated unless we get past the early exit
+	losRecalc.clear();
+
+	for (auto& areas: gainedAreas) {
+		areas.clear();
+	}
+
 	// delayed delete
 	while (!delayedDeleteQue.empty() && delayedDeleteQue.front().timeoutTime < gs->frameNum) {
 		UnrefInstance(delayedDeleteQue.front().instance);
@@ -517,7 +550,7 @@ void ILosType::Update()
 
 	// no updates? -> early exit
 	if (losUpdate.empty())
-		return;
+		return (updatePending = false);
 
 
 	losRemove.clear();
@@ -527,10 +560,8 @@ void ILosType::Update()
 	losDeleted.clear();
 	losDeleted.reserve(losUpdate.size());
 
-	if (algoType == LOS_ALGO_RAYCAST) {
-		losRecalc.clear();
+	if (algoType == LOS_ALGO_RAYCAST)
 		losRecalc.reserve(losUpdate.size());
-	}
 
 	// filter the updates into their subparts
 	for (SLosInstance* li: losUpdate) {
@@ -574,20 +605,106 @@ void ILosType::Update()
 		LosRemove(li);
 	}
 
-	// raycast terrain
-	if (algoType == LOS_ALGO_RAYCAST)  {
-		for_mt(0, losRecalc.size(), [&](const int idx) {
-			auto li = losRecalc[idx];
-			assert(li->refCount > 0);
-			li->squares.clear();
-			losMaps[li->allyteam].PrepareRaycast(li);
-		});
+	if (algoType == LOS_ALGO_RAYCAST)
+		ShareFootprints();
+
+	return (updatePending = true);
+}
+
+void ILosType::ShareFootprints()
+{
+	RECOIL_DETAILED_TRACY_ZONE;
+	// Footprints only depend on position, radius and height (not on the allyteam),
+	// so another allyteam's instance can provide one as long as it is up to date:
+	// computed (non-empty) and not waiting for a recalc after a terrain change.
+	// Clear ours first so instances still to be raycast never act as a source.
+	for (SLosInstance* li: losRecalc) {
+		li->squares.clear();
+	}
+
+	const auto HaveSameFootprint = [](const SLosInstance* a, const SLosInstance* b) {
+		return (a->basePos == b->basePos && a->radius == b->radius && a->baseHeight == b->baseHeight);
+	};
+	const auto FindFootprintSource = [&](const SLosInstance* li) -> const SLosInstance* {
+		for (int allyTeam = 0, numAllyTeams = teamHandler.ActiveAllyTeams(); allyTeam < numAllyTeams; allyTeam++) {
+			const auto iter = instanceHashes.find(GetHashNum(allyTeam, li->basePos, li->radius));
+
+			if (iter == instanceHashes.end())
+				continue;
+
+			for (const SLosInstance* src: iter->second) {
+				if (src == li || src->squares.empty() || (src->status & SLosInstance::TLosStatus::RECALC) != 0)
+					continue;
+				if (!HaveSameFootprint(src, li))
+					continue;
+
+				return src;
+			}
+		}
+
+		return nullptr;
+	};
+
+	losShared.clear();
+	recalcFootprints.clear();
+
+	size_t numRecalcs = 0;
+
+	for (SLosInstance* li: losRecalc) {
+		if (const SLosInstance* src = FindFootprintSource(li); src != nullptr) {
+			li->squares = src->squares;
+			footprintShares += 1;
+			continue;
+		}
+
+		// identical footprints in this batch are raycast once, by the first
+		auto& batchInstances = recalcFootprints[GetHashNum(0, li->basePos, li->radius)];
+		const auto pred = [&](const SLosInstance* ri) { return HaveSameFootprint(ri, li); };
+		const auto iter = std::find_if(batchInstances.begin(), batchInstances.end(), pred);
+
+		if (iter != batchInstances.end()) {
+			losShared.emplace_back(li, *iter);
+			footprintShares += 1;
+			continue;
+		}
+
+		batchInstances.push_back(li);
+		losRecalc[numRecalcs++] = li;
+	}
+
+	losRecalc.resize(numRecalcs);
+}
+
+void ILosType::UpdateRaycast(size_t idx)
+{
+	SLosInstance* li = losRecalc[idx];
+
+	assert(li->refCount > 0);
+	li->squares.clear();
+	losMaps[li->allyteam].PrepareRaycast(li);
+}
+
+void ILosType::UpdateEnd()
+{
+	RECOIL_DETAILED_TRACY_ZONE;
+	if (!updatePending)
+		return;
+
+	updatePending = false;
+
+	for (const auto& [li, src]: losShared) {
+		li->squares = src->squares;
 	}
 
 	// add sight
 	for (SLosInstance* li: losAdd) {
 		assert(li->refCount > 0);
 		LosAdd(li);
+
+		const int2 p = li->basePos;
+		const int r = li->radius;
+
+		gainedAreas[li->allyteam].emplace_back(p.x - r, p.y - r, p.x + r, p.y + r);
 	}
 
 	// delete / move to cache unused instances
@@ -685,6 +802,7 @@ void CLosHandler::InitStatic()
 	ILosType::cacheFails = 1;
 	ILosType::cacheHits  = 1;
 	ILosType::cacheRefs  = 1;
+	ILosType::footprintShares = 0;
 
 	if (losHandler == nullptr)
 		losHandler = new (losHandlerMem) CLosHandler();
@@ -738,6 +856,8 @@ void CLosHandler::Init()
 void CLosHandler::Kill()
 {
 	RECOIL_DETAILED_TRACY_ZONE;
+	WaitForUpdate();
+
 	los.Kill();
 	airLos.Kill();
 	radar.Kill();
@@ -759,10 +879,11 @@ void CLosHandler::Kill()
 	}
 	LOG_L(L_WARNING, "LosHandler MemUsage: ~%.1fMB", memUsage / (1024.f * 1024.f));*/
 
-	LOG("[LosHandler::%s] raycast instance cache-{hits,misses}={%u,%u}; shared=%.0f%%; cached=%.0f%%",
+	LOG("[LosHandler::%s] raycast instance cache-{hits,misses}={%u,%u}; shared=%.0f%%; cached=%.0f%%; footprint-copies=%u",
 		__func__, unsigned(ILosType::cacheHits), unsigned(ILosType::cacheFails),
 		100.0f * float(ILosType::cacheHits - ILosType::cacheRefs) / (ILosType::cacheHits + ILosType::cacheFails),
-		100.0f * float(ILosType::cacheRefs) / (ILosType::cacheHits + ILosType::cacheFails)
+		100.0f * float(ILosType::cacheRefs) / (ILosType::cacheHits + ILosType::cacheFails),
+		unsigned(ILosType::footprintShares)
 	);
 
 	losTypes.fill(nullptr);
@@ -781,6 +902,8 @@ void CLosHandler::SetGlobalLOS(const int allyTeamId, const bool newState)
 void CLosHandler::UnitDestroyed(const CUnit* unit, const CUnit* attacker, int weaponDefID)
 {
 	RECOIL_DETAILED_TRACY_ZONE;
+	WaitForUpdate();
+
 	for (ILosType* lt: losTypes) {
 		lt->RemoveUnit(const_cast<CUnit*>(unit), true);
 	}
@@ -790,6 +913,8 @@ void CLosHandler::UnitDestroyed(const CUnit* unit, const CUnit* attacker, int we
 void CLosHandler::UnitTaken(const CUnit* unit, int oldTeam, int newTeam)
 {
 	RECOIL_DETAILED_TRACY_ZONE;
+	WaitForUpdate();
+
 	for (ILosType* lt: losTypes) {
 		lt->RemoveUnit(const_cast<CUnit*>(unit));
 	}
@@ -799,6 +924,8 @@ void CLosHandler::UnitTaken(const CUnit* unit, int oldTeam, int newTeam)
 void CLosHandler::UnitReverseBuilt(const CUnit* unit)
 {
 	RECOIL_DETAILED_TRACY_ZONE;
+	WaitForUpdate();
+
 	for (ILosType* lt: losTypes) {
 		lt->RemoveUnit(const_cast<CUnit*>(unit));
 	}
@@ -811,16 +938,17 @@ void CLosHandler::UnitLoaded(const CUnit* unit, const CUnit* transport)
 	if (!unit->IsStunned())
 		return;
 
+	WaitForUpdate();
+
 	for (ILosType* lt: losTypes) {
 		lt->RemoveUnit(const_cast<CUnit*>(unit));
 	}
 }
 
 
-void CLosHandler::Update()
+template<typename F>
+void CLosHandler::UpdateLosTypes(F&& updateLosType)
 {
-	SCOPED_TIMER("Sim::Los");
-
 	const std::vector<CUnit*>& activeUnits = unitHandler.GetActiveUnits();
 
 	#if (USE_STAGGERED_UPDATES == 1)
@@ -849,14 +977,104 @@ void CLosHandler::Update()
 		}
 		#endif
 
-		lt->Update();
+		updateLosType(lt);
 	});
 }
 
 
+void CLosHandler::Update()
+{
+	SCOPED_TIMER("Sim::Los");
+
+	// already started by UpdateAsync, only needs completing
+	if (modInfo.asyncLosUpdate) {
+		WaitForUpdate();
+		return;
+	}
+
+	UpdateLosTypes([](ILosType* lt) { lt->Update(); });
+}
+
+
+void CLosHandler::UpdateAsync()
+{
+	if (!modInfo.asyncLosUpdate)
+		return;
+
+	SCOPED_TIMER("Sim::Los::Async");
+	assert(!asyncUpdatePending.load());
+
+	// unit state is only read here, the raycasts themselves
+	// just depend on the instances and the (synced) heightmap
+	UpdateLosTypes([](ILosType* lt) { lt->UpdateBegin(); });
+
+	asyncRaycasts.clear();
+
+	for (ILosType* lt: losTypes) {
+		for (size_t n = 0, m = lt->GetNumRaycasts(); n < m; n++) {
+			asyncRaycasts.emplace_back(lt, n);
+		}
+	}
+
+	asyncRaycastIndex.store(0);
+	asyncUpdatePending.store(true, std::memory_order_release);
+
+	// one task per worker, each claims raycasts until none are left
+	for (size_t i = 1, n = std::min(size_t(ThreadPool::GetNumThreads()), asyncRaycasts.size() + 1); i < n; i++) {
+		asyncRaycastTasks.push_back(ThreadPool::Enqueue([this]() { RunAsyncRaycasts(); }));
+	}
+}
+
+
+void CLosHandler::RunAsyncRaycasts() const
+{
+	RECOIL_DETAILED_TRACY_ZONE;
+	for (size_t i = asyncRaycastIndex.fetch_add(1); i < asyncRaycasts.size(); i = asyncRaycastIndex.fetch_add(1)) {
+		asyncRaycasts[i].first->UpdateRaycast(asyncRaycasts[i].second);
+	}
+}
+
+
+void CLosHandler::FinishAsyncUpdate() const
+{
+	RECOIL_DETAILED_TRACY_ZONE;
+	// queries can come from more than one thread
+	std::lock_guard<spring::mutex> lock(asyncUpdateMutex);
+
+	if (!asyncUpdatePending.load(std::memory_order_relaxed))
+		return;
+
+	// the main thread helps out with whatever is left; pool workers share their
+	// thread-numbers and thereby their raycast buffers with the async workers
+	if (ThreadPool::GetThreadNum() == 0)
+		RunAsyncRaycasts();
+
+	for (const std::shared_future<void>& task: asyncRaycastTasks) {
+		task.wait();
+	}
+
+	asyncRaycastTasks.clear();
+
+	// for_mt would clobber the flag for an enclosing parallel section
+	if (ThreadPool::GetThreadNum() == 0 && !ThreadPool::inMultiThreadedSection) {
+		for_mt(0, losTypes.size(), [&](const int idx) {
+			losTypes[idx]->UpdateEnd();
+		});
+	} else {
+		for (ILosType* lt: losTypes) {
+			lt->UpdateEnd();
+		}
+	}
+
+	asyncUpdatePending.store(false, std::memory_order_release);
+}
+
+
 void CLosHandler::UpdateHeightMapSynced(SRectangle rect)
 {
 	RECOIL_DETAILED_TRACY_ZONE;
+	WaitForUpdate();
+
 	for (ILosType* lt: losTypes) {
 		ZoneScopedN("LosHandler::UpdateHeightMapSynced");
 		lt->UpdateHeightMapSynced(rect);
@@ -867,6 +1085,8 @@ void CLosHandler::UpdateHeightMapSynced(SRectangle rect)
 bool CLosHandler::InLos(const CUnit* unit, int allyTeam) const
 {
 	RECOIL_DETAILED_TRACY_ZONE;
+	WaitForUpdate();
+
 	// NOTE: units are treated differently than world objects in two ways:
 	//   1. they can be cloaked (has to be checked BEFORE all other cases)
 	//   2. when underwater, they are only considered to be in LOS if they
@@ -905,6 +1125,8 @@ bool CLosHandler::InLos(const CUnit* unit, int allyTeam) const
 bool CLosHandler::InAirLos(const CUnit* unit, int allyTeam) const
 {
 	RECOIL_DETAILED_TRACY_ZONE;
+	WaitForUpdate();
+
 	// NOTE: units are treated differently than world objects in two ways:
 	//   1. they can be cloaked (has to be checked BEFORE all other cases)
 	//   2. when underwater, they are only considered to be in LOS if they
@@ -939,6 +1161,8 @@ bool CLosHandler::InAirLos(const CUnit* unit, int allyTeam) const
 bool CLosHandler::InRadar(const float3 pos, int allyTeam) const
 {
 	RECOIL_DETAILED_TRACY_ZONE;
+	WaitForUpdate();
+
 	// position is underwater, only sonar can see it
 	// note: only check jammers when we have a common jammer map, else jammers only apply to objects!
 	if (pos.y < 0.0f)
@@ -951,6 +1175,8 @@ bool CLosHandler::InRadar(const float3 pos, int allyTeam) const
 bool CLosHandler::InRadar(const CUnit* unit, int allyTeam) const
 {
 	RECOIL_DETAILED_TRACY_ZONE;
+	WaitForUpdate();
+
 	// unit is discoverable by sonar
 	if (unit->IsInWater()) {
 		if ((!unit->sonarStealth || unit->beingBuilt) &&
@@ -974,6 +1200,8 @@ bool CLosHandler::InRadar(const CUnit* unit, int allyTeam) const
 bool CLosHandler::InJammer(const float3 pos, int allyTeam) const
 {
 	RECOIL_DETAILED_TRACY_ZONE;
+	WaitForUpdate();
+
 	const int jammerAlly = modInfo.separateJammers ? allyTeam : 0;
 
 	if (pos.y < 0.0f)
@@ -986,6 +1214,8 @@ bool CLosHandler::InJammer(const float3 pos, int allyTeam) const
 bool CLosHandler::InJammer(const CUnit* unit, int allyTeam) const
 {
 	RECOIL_DETAILED_TRACY_ZONE;
+	WaitForUpdate();
+
 	if (allyTeam == unit->allyteam)
 		return false;
 
@@ -3,6 +3,8 @@
 #ifndef LOS_HANDLER_H
 #define LOS_HANDLER_H
 
+#include <atomic>
+#include <future>
 #include <vector>
 #include <deque>
 
@@ -14,6 +16,7 @@
 #include "System/Rectangle.h"
 #include "System/EventClient.h"
 #include "System/UnorderedMap.hpp"
+#include "System/Threading/SpringThreading.h"
 
 
 /**
@@ -108,7 +111,7 @@ public:
 
 	inline bool InSight(const float3 pos, int allyTeam) const {
 		assert(allyTeam < losMaps.size());
-		return (losMaps[allyTeam].At(PosToSquare(pos)) != 0);
+		return (losMaps[allyTeam].InSight(PosToSquare(pos)));
 	}
 
 public:
@@ -133,6 +136,17 @@ public:
 	void RemoveUnit(CUnit* unit, bool delayed = false);
 	void UpdateUnit(CUnit* unit, bool ignore = false);
 
+	// Update() split into its parts, so the (independent) raycasts can be
+	// run elsewhere; UpdateEnd must follow once all of them have finished
+	bool UpdateBegin();
+	void UpdateRaycast(size_t idx);
+	void UpdateEnd();
+
+	size_t GetNumRaycasts() const { return losRecalc.size(); }
+
+	/// bounds (in LOS-map squares) of the instances an allyteam added in the last update
+	const std::vector<SRectangle>& GetGainedAreas(int allyTeam) const { return gainedAreas[allyTeam]; }
+
 private:
 	//void PostLoad();
 
@@ -144,6 +158,8 @@ private:
 	void DelayedUnrefInstance(SLosInstance* instance);
 	void AddInstanceToCache(SLosInstance* instance);
 
+	void ShareFootprints();
+
 	void UpdateInstanceStatus(SLosInstance* instance, SLosInstance::TLosStatus status);
 	static SLosInstance::TLosStatus OptimizeInstanceUpdate(SLosInstance* instance);
 
@@ -169,6 +185,7 @@ public:
 	static size_t cacheFails;
 	static size_t cacheHits;
 	static size_t cacheRefs;
+	static size_t footprintShares;
 
 	spring::unordered_map<int, std::vector<SLosInstance*> > instanceHashes;
 
@@ -191,6 +208,13 @@ private:
 	std::vector<SLosInstance*> losAdd;
 	std::vector<SLosInstance*> losDeleted;
 	std::vector<SLosInstance*> losRecalc;
+	std::vector< std::pair<SLosInstance*, const SLosInstance*> > losShared; // {instance, footprint source}
+
+	spring::unordered_map<int, std::vector<const SLosInstance*> > recalcFootprints;
+
+	std::vector< std::vector<SRectangle> > gainedAreas;
+
+	bool updatePending = false;
 
 	static constexpr int CACHE_SIZE = 4096;
 };
@@ -218,6 +242,8 @@ public:
 	// the Interface
 	bool InLos(const CUnit* unit, int allyTeam) const;
 	bool InLos(const CWorldObject* obj, int allyTeam) const {
+		WaitForUpdate();
+
 		if (obj->alwaysVisible || globalLOS[allyTeam])
 			return true;
 		if (obj->useAirLos)
@@ -229,6 +255,8 @@ public:
 		return (los.InSight(obj->pos, allyTeam) || los.InSight(obj->pos + obj->speed, allyTeam));
 	}
 	bool InLos(const float3 pos, int allyTeam) const {
+		WaitForUpdate();
+
 		if (globalLOS[allyTeam])
 			return true;
 		return los.InSight(pos, allyTeam);
@@ -237,12 +265,16 @@ public:
 
 	bool InAirLos(const CUnit* unit, int allyTeam) const;
 	bool InAirLos(const CWorldObject* obj, int allyTeam) const {
+		WaitForUpdate();
+
 		if (obj->alwaysVisible || globalLOS[allyTeam])
 			return true;
 
 		return airLos.InSight(obj->pos, allyTeam);
 	}
 	bool InAirLos(const float3 pos, int allyTeam) const {
+		WaitForUpdate();
+
 		if (globalLOS[allyTeam])
 			return true;
 		return airLos.InSight(pos, allyTeam);
@@ -260,6 +292,7 @@ public:
 
 
 	bool InSeismicDistance(const CUnit* unit, int allyTeam) const {
+		WaitForUpdate();
 		return seismic.InSight(unit->pos, allyTeam);
 	}
 
@@ -288,6 +321,7 @@ public:
 	}
 	bool GetFullRead() const override { return true; }
 	int  GetReadAllyTeam() const override { return AllAccessTeam; }
+	bool CanReadAllyTeam(int allyTeam) const override { return true; }
 
 	void UnitDestroyed(const CUnit* unit, const CUnit* attacker, int weaponDefID) override;
 	void UnitTaken(const CUnit* unit, int oldTeam, int newTeam) override;
@@ -298,6 +332,25 @@ public:
 	void Update() override;
 	void UpdateHeightMapSynced(SRectangle rect);
 
+	// with the asyncLosUpdate modrule, starts this frame's update early (the
+	// raycasts then run on the async workers) and Update() only completes it
+	void UpdateAsync();
+
+	// blocks until an update started by UpdateAsync has completed, must be
+	// called before anything reads or changes the LOS maps or instances
+	void WaitForUpdate() const {
+		if (!asyncUpdatePending.load(std::memory_order_acquire))
+			return;
+
+		FinishAsyncUpdate();
+	}
+
+private:
+	template<typename F> void UpdateLosTypes(F&& updateLosType);
+
+	void RunAsyncRaycasts() const;
+	void FinishAsyncUpdate() const;
+
 public:
 	ILosType los;
 	ILosType airLos;
@@ -324,6 +377,15 @@ private:
 
 	std::vector<float> radarErrorSizes;
 	std::array<ILosType*, 7> losTypes;
+
+	// raycasts of the update started by UpdateAsync, claimed by index
+	std::vector< std::pair<ILosType*, size_t> > asyncRaycasts;
+
+	mutable std::vector< std::shared_future<void> > asyncRaycastTasks;
+	mutable std::atomic<size_t> asyncRaycastIndex = {0};
+	mutable std::atomic<bool> asyncUpdatePending = {false};
+
+	mutable spring::mutex asyncUpdateMutex;
 };
 
 
@@ -2,6 +2,7 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 
 #include "LosMap.h"
 #include "LosHandler.h"
@@ -10,9 +11,12 @@
 #include "System/float3.h"
 #include "System/Log/ILog.h"
 #include "System/StringUtil.h"
+#include "System/Threading/SpringThreading.h"
 #include "System/Threading/ThreadPool.h"
 #include "Game/GlobalUnsynced.h" // for myAllyTeam
 
+#include "xsimd/xsimd.hpp"
+
 constexpr float LOS_BONUS_HEIGHT = 5.0f;
 
 static std::array<std::vector<float>, ThreadPool::MAX_THREADS> RADIUS_ISQRT_TABLES;
@@ -117,27 +121,35 @@ public:
 	typedef std::vector<int2> LosLine;
 	typedef std::vector<LosLine> LosTable;
 
-	// only generates table if not in cache
-	void GenerateForLosSize(size_t losSize);
+	struct RayStep {
+		int2 square;
+		float invR; // inverse distance of <square> to the ray origin
+	};
 
-	const int2 GetLosTableRaySquare(size_t losSize, size_t rayIndex, size_t squareIdx) {
-		return losTables[losSize][rayIndex][squareIdx];
-	}
+	// all rays of one radius flattened into a single array, ray <i>
+	// covering the steps in [rayStarts[i], rayStarts[i + 1])
+	struct RayTable {
+		size_t GetNumRays() const { return (rayStarts.empty()? 0: rayStarts.size() - 1); }
+		size_t GetRaySize(size_t rayIndex) const { return (rayStarts[rayIndex + 1] - rayStarts[rayIndex]); }
 
-	size_t GetLosTableRaySize(size_t losSize, size_t rayIndex) {
-		return losTables[losSize][rayIndex].size();
-	}
+		const RayStep* GetRaySteps(size_t rayIndex) const { return &steps[rayStarts[rayIndex]]; }
 
-	size_t GetLosTableSize(size_t losSize) {
-		return losTables[losSize].size();
-	}
+		std::vector<RayStep> steps;
+		std::vector<unsigned int> rayStarts;
+	};
+
+	// only generates table if not in cache; may be called by any thread
+	const RayTable& GenerateForLosSize(size_t losSize);
 
 private:
 	// [0] is the zero-radius table
 	// NOTE:
 	//   do we even need a table for *every* possible radius?
 	//   why not precalculate only the largest and subsample?
-	std::array<LosTable, MAX_UNIT_SENSOR_RADIUS + 1> losTables;
+	std::array<RayTable, MAX_UNIT_SENSOR_RADIUS + 1> rayTables;
+	std::array<std::atomic<bool>, MAX_UNIT_SENSOR_RADIUS + 1> rayTablesReady;
+
+	spring::mutex rayTablesMutex;
 
 private:
 	static LosLine GetRay(int x, int y);
@@ -147,25 +159,45 @@ private:
 	static void Debug(const LosTable& losRays, const std::vector<int2>& points, int radius);
 };
 
-static std::array<CLosTableHelper, ThreadPool::MAX_THREADS> losTableHelpers;
+// shared by all threads, tables only depend on the radius
+static CLosTableHelper losTableHelper;
 
 
 
-void CLosTableHelper::GenerateForLosSize(size_t losSize)
+const CLosTableHelper::RayTable& CLosTableHelper::GenerateForLosSize(size_t losSize)
 {
 	RECOIL_DETAILED_TRACY_ZONE;
 	// guard against insane sight distances
-	assert(losSize < losTables.size());
+	assert(losSize < rayTables.size());
 
-	if (losSize == 0)
-		return;
+	RayTable& table = rayTables[losSize];
 
-	LosTable& table = losTables[losSize];
+	if (losSize == 0 || rayTablesReady[losSize].load(std::memory_order_acquire))
+		return table;
 
-	if (!table.empty())
-		return;
+	std::lock_guard<spring::mutex> lock(rayTablesMutex);
+
+	// another thread may have generated it while we waited
+	if (rayTablesReady[losSize].load(std::memory_order_relaxed))
+		return table;
 
-	table = GetLosRays(losSize);
+	const LosTable losRays = GetLosRays(losSize);
+
+	table.rayStarts.reserve(losRays.size() + 1);
+	table.rayStarts.push_back(0);
+
+	for (const LosLine& line: losRays) {
+		for (const int2& p: line) {
+			table.steps.push_back({p, math::isqrt(std::max(unsigned(p.x * p.x + p.y * p.y), 1u))});
+		}
+
+		table.rayStarts.push_back(table.steps.size());
+	}
+
+	table.steps.shrink_to_fit();
+
+	rayTablesReady[losSize].store(true, std::memory_order_release);
+	return table;
 }
 
 
@@ -420,7 +452,7 @@ void CLosMap::AddCircle(SLosInstance* instance, int amount)
 			const unsigned ex = std::clamp(instance->basePos.x + width + 1, 0, size.x);
 
 			for (unsigned x_ = sx; x_ < ex; ++x_) {
-				losmap[(y_ * size.x) + x_] += amount;
+				AddCount((y_ * size.x) + x_, amount);
 			}
 		}
 	});
@@ -442,7 +474,7 @@ void CLosMap::AddRaycast(SLosInstance* instance, int amount)
 	if ((amount > 0) && updateUnsyncedHeightMap) {
 		for (const SLosInstance::RLE rle: losSquares) {
 			for (int idx = rle.start, len = rle.length; len > 0; --len, ++idx) {
-				losmap[idx] += amount;
+				AddCount(idx, amount);
 
 				// skip if this los-square did not *enter* LOS
 				if (losmap[idx] != amount)
@@ -462,7 +494,7 @@ void CLosMap::AddRaycast(SLosInstance* instance, int amount)
 
 	for (const SLosInstance::RLE rle: losSquares) {
 		for (int idx = rle.start, len = rle.length; len > 0; --len, ++idx) {
-			losmap[idx] += amount;
+			AddCount(idx, amount);
 		}
 	}
 }
@@ -554,6 +586,59 @@ inline void CastLos(
 }
 
 
+// Casts the four rays obtained by rotating one table ray in 90 degree steps at
+// once, one per lane. Rotated squares share their distance to the origin and
+// losRaySquares is only ever cleared, so this yields exactly what four CastLos
+// loops would, but compares all four rays without branching.
+static void CastLosRotated(
+	const CLosTableHelper::RayStep* steps,
+	size_t numSteps,
+	std::vector<char>& losRaySquares,
+	const std::vector<float>& raycastAngles,
+	int losRadius
+) {
+	using FloatBatch = xsimd::batch<float, 4>;
+
+	FloatBatch maxAngles(-1e7f);
+	FloatBatch prvAngles(-1e7f);
+
+	alignas(16) float sqrAngles[4];
+	alignas(16) float sqrVisible[4];
+
+	size_t sqrIndices[4];
+
+	for (size_t n = 0; n < numSteps; n++) {
+		const int2 square = steps[n].square;
+
+		sqrIndices[0] = ToAngleMapIdx(      square              , losRadius);
+		sqrIndices[1] = ToAngleMapIdx(     -square              , losRadius);
+		sqrIndices[2] = ToAngleMapIdx(int2( square.y, -square.x), losRadius);
+		sqrIndices[3] = ToAngleMapIdx(int2(-square.y,  square.x), losRadius);
+
+		for (int i = 0; i < 4; i++) {
+			sqrAngles[i] = raycastAngles[sqrIndices[i]];
+		}
+
+		const FloatBatch angles = xsimd::load_aligned(&sqrAngles[0]);
+		const FloatBatch dropAngles = prvAngles - FloatBatch(LOS_BONUS_HEIGHT * steps[n].invR);
+
+		// see CastLos; a lane that descends from its previous angle lowers its max-angle
+		const auto belowMax = (angles < maxAngles);
+		const auto belowPrv = (angles < prvAngles) & ~belowMax;
+		const auto hidden = belowMax | (belowPrv & (angles < dropAngles));
+
+		maxAngles = xsimd::select(belowPrv, dropAngles, maxAngles);
+		prvAngles = xsimd::select(hidden, prvAngles, angles);
+
+		xsimd::store_aligned(&sqrVisible[0], xsimd::select(hidden, FloatBatch(0.0f), FloatBatch(1.0f)));
+
+		for (int i = 0; i < 4; i++) {
+			losRaySquares[sqrIndices[i]] &= char(sqrVisible[i] != 0.0f);
+		}
+	}
+}
+
+
 void CLosMap::AddSquaresToInstance(SLosInstance* li, const std::vector<char>& losRaySquares) const
 {
 	RECOIL_DETAILED_TRACY_ZONE;
@@ -606,13 +691,11 @@ void CLosMap::UnsafeLosAdd(SLosInstance* li) const
 	const float losHeight = li->baseHeight;
 
 
-	CLosTableHelper& helper = losTableHelpers[threadNum];
+	const CLosTableHelper::RayTable& rayTable = losTableHelper.GenerateForLosSize(radius);
 
 	std::vector<char>& losRaySquares = LOSRAY_SQUARE_TABLES[threadNum];
 	std::vector<float>& raycastAngles = RAYCAST_ANGLE_TABLES[threadNum];
 
-	helper.GenerateForLosSize(radius);
-
 	losRaySquares.clear();
 	losRaySquares.resize(Square((2 * radius) + 1), false);
 	raycastAngles.clear();
@@ -659,22 +742,8 @@ void CLosMap::UnsafeLosAdd(SLosInstance* li) const
 	// cast the rays
 	losRaySquares[ToAngleMapIdx(int2(0, 0), radius)] = true;
 
-	const size_t numRays = helper.GetLosTableSize(radius);
-
-	for (size_t i = 0; i < numRays; ++i) {
-		float maxAngles[4] = {-1e7, -1e7, -1e7, -1e7};
-		float prvAngles[4] = {-1e7, -1e7, -1e7, -1e7};
-
-		const size_t numSquares = helper.GetLosTableRaySize(radius, i);
-
-		for (size_t n = 0; n < numSquares; n++) {
-			const int2 square = helper.GetLosTableRaySquare(radius, i, n);
-
-			CastLos(&prvAngles[0], &maxAngles[0],       square              , losRaySquares, raycastAngles, radius, threadNum);
-			CastLos(&prvAngles[1], &maxAngles[1],      -square              , losRaySquares, raycastAngles, radius, threadNum);
-			CastLos(&prvAngles[2], &maxAngles[2], int2( square.y, -square.x), losRaySquares, raycastAngles, radius, threadNum);
-			CastLos(&prvAngles[3], &maxAngles[3], int2(-square.y,  square.x), losRaySquares, raycastAngles, radius, threadNum);
-		}
+	for (size_t i = 0, numRays = rayTable.GetNumRays(); i < numRays; ++i) {
+		CastLosRotated(rayTable.GetRaySteps(i), rayTable.GetRaySize(i), losRaySquares, raycastAngles, radius);
 	}
 
 	// translate visible square indices to map square idx + RLE
@@ -693,13 +762,11 @@ void CLosMap::SafeLosAdd(SLosInstance* li) const
 	const float losHeight = li->baseHeight;
 
 
-	CLosTableHelper& helper = losTableHelpers[threadNum];
+	const CLosTableHelper::RayTable& rayTable = losTableHelper.GenerateForLosSize(radius);
 
 	std::vector< char>& losRaySquares = LOSRAY_SQUARE_TABLES[threadNum];
 	std::vector<float>& raycastAngles = RAYCAST_ANGLE_TABLES[threadNum];
 
-	helper.GenerateForLosSize(radius);
-
 	losRaySquares.clear();
 	losRaySquares.resize(Square((2 * radius) + 1), false);
 	raycastAngles.clear();
@@ -748,7 +815,7 @@ void CLosMap::SafeLosAdd(SLosInstance* li) const
 
 
 	// Cast the Rays
-	const size_t numRays = helper.GetLosTableSize(radius);
+	const size_t numRays = rayTable.GetNumRays();
 
 	if (safeRect.Inside(pos)) {
 		losRaySquares[ToAngleMapIdx(int2(0, 0), radius)] = true;
@@ -757,10 +824,11 @@ void CLosMap::SafeLosAdd(SLosInstance* li) const
 			float maxAngles[4] = {-1e7, -1e7, -1e7, -1e7};
 			float prvAngles[4] = {-1e7, -1e7, -1e7, -1e7};
 
-			const size_t numSquares = helper.GetLosTableRaySize(radius, i);
+			const CLosTableHelper::RayStep* raySteps = rayTable.GetRaySteps(i);
+			const size_t numSquares = rayTable.GetRaySize(i);
 
 			for (size_t n = 0; n < numSquares; n++) {
-				const int2 square = helper.GetLosTableRaySquare(radius, i, n);
+				const int2 square = raySteps[n].square;
 
 				if (!safeRect.Inside(pos + square))
 					break;
@@ -768,7 +836,7 @@ void CLosMap::SafeLosAdd(SLosInstance* li) const
 				CastLos(&prvAngles[0], &maxAngles[0],  square,                   losRaySquares, raycastAngles, radius, threadNum);
 			}
 			for (size_t n = 0; n < numSquares; n++) {
-				const int2 square = helper.GetLosTableRaySquare(radius, i, n);
+				const int2 square = raySteps[n].square;
 
 				if (!safeRect.Inside(pos - square))
 					break;
@@ -776,7 +844,7 @@ void CLosMap::SafeLosAdd(SLosInstance* li) const
 				CastLos(&prvAngles[1], &maxAngles[1], -square,                   losRaySquares, raycastAngles, radius, threadNum);
 			}
 			for (size_t n = 0; n < numSquares; n++) {
-				const int2 square = helper.GetLosTableRaySquare(radius, i, n);
+				const int2 square = raySteps[n].square;
 
 				if (!safeRect.Inside(pos + int2(square.y, -square.x)))
 					break;
@@ -784,7 +852,7 @@ void CLosMap::SafeLosAdd(SLosInstance* li) const
 				CastLos(&prvAngles[2], &maxAngles[2], int2(square.y, -square.x), losRaySquares, raycastAngles, radius, threadNum);
 			}
 			for (size_t n = 0; n < numSquares; n++) {
-				const int2 square = helper.GetLosTableRaySquare(radius, i, n);
+				const int2 square = raySteps[n].square;
 
 				if (!safeRect.Inside(pos + int2(-square.y, square.x)))
 					break;
@@ -798,10 +866,11 @@ void CLosMap::SafeLosAdd(SLosInstance* li) const
 			float maxAngles[4] = {-1e7, -1e7, -1e7, -1e7};
 			float prvAngles[4] = {-1e7, -1e7, -1e7, -1e7};
 
-			const size_t numSquares = helper.GetLosTableRaySize(radius, i);
+			const CLosTableHelper::RayStep* raySteps = rayTable.GetRaySteps(i);
+			const size_t numSquares = rayTable.GetRaySize(i);
 
 			for (size_t n = 0; n < numSquares; n++) {
-				const int2 square = helper.GetLosTableRaySquare(radius, i, n);
+				const int2 square = raySteps[n].square;
 
 				if (safeRect.Inside(pos + square))
 					CastLos(&prvAngles[0], &maxAngles[0],  square,                   losRaySquares, raycastAngles, radius, threadNum);
@@ -5,6 +5,7 @@
 #ifndef LOS_MAP_H
 #define LOS_MAP_H
 
+#include <cstdint>
 #include <vector>
 #include "System/type2.h"
 #include "System/SpringMath.h"
@@ -24,6 +25,8 @@ public:
 
 		losmap.clear();
 		losmap.resize(size.x * size.y, 0);
+		losBits.clear();
+		losBits.resize((size.x * size.y + 63) / 64, 0);
 
 		ctrHeightMap = ctrHeightMap_;
 		mipHeightMap = mipHeightMap_;
@@ -50,6 +53,18 @@ public:
 		return losmap[p.y * size.x + p.x];
 	}
 
+	/// same as (At(p) != 0), but only touches the (16x smaller) bitmask
+	bool InSight(int2 p) const {
+		p.x = std::clamp(p.x, 0, size.x - 1);
+		p.y = std::clamp(p.y, 0, size.y - 1);
+		return GetBit(p.y * size.x + p.x);
+	}
+
+	/// one bit per square, set iff its count is non-zero; bit (i & 63) of
+	/// word (i >> 6) belongs to square i, so a word covers 64 squares of a row
+	/// (or of two consecutive rows if the row length is not a multiple of 64)
+	const auto& GetLosBits() const { return losBits; }
+
 	// FIXME temp fix for CBaseGroundDrawer and AI interface, which need raw data
 	const unsigned short& front() const { return losmap.front(); }
 	const auto& GetLosMap() const { return losmap; }
@@ -60,11 +75,20 @@ private:
 
 	void AddSquaresToInstance(SLosInstance* li, const std::vector<char>& losRaySquares) const;
 
+	bool GetBit(int idx) const { return ((losBits[idx >> 6] >> (idx & 63)) & 1); }
+	void AddCount(int idx, int amount) {
+		const uint64_t bit = uint64_t(1) << (idx & 63);
+
+		losmap[idx] += amount;
+		losBits[idx >> 6] = (losBits[idx >> 6] & ~bit) | (bit * (losmap[idx] != 0));
+	}
+
 protected:
 	int2 size;
 	int2 LOS2HEIGHT;
 
 	std::vector<unsigned short> losmap;
+	std::vector<uint64_t> losBits; // derived from losmap, see GetLosBits
 
 	const float* ctrHeightMap = nullptr;
 	const float* mipHeightMap = nullptr;
@@ -104,6 +104,7 @@ void CModInfo::ResetState()
 		alwaysVisibleOverridesCloaked = false;
 		decloakRequiresLineOfSight = false;
 		separateJammers = true;
+		asyncLosUpdate = false;
 	}
 	{
 		featureVisibility = FEATURELOS_ALL;
@@ -115,14 +116,34 @@ void CModInfo::ResetState()
 		pfRepathDelayInFrames = 60;
 		pfRepathMaxRateInFrames = 150;
 		pfRawMoveSpeedThreshold = 0.f;
+		pfCacheMultiThreadedSearches = false;
 		qtMaxNodesSearched = 8192;
 		qtRefreshPathMinDist = 512.f;
+		qtGroupPathSharing = false;
+		qtHierarchicalSearch = false;
+		qtProvisionalPathNodesSearched = 0;
+		qtIncrementalPathRepair = false;
+		qtPrioritizeMapDamageNearPaths = false;
+		qtFlowFieldMinGroupSize = 0;
 		qtMaxNodesSearchedRelativeToMapOpenNodes = 0.25;
 
 		enableSmoothMesh = true;
 		smoothMeshResDivider = 2;
 		smoothMeshSmoothRadius = 40;
 		quadFieldQuadSizeInElmos = 128;
+		unitUpdateMT = false;
+		weaponTargetMT = false;
+		weaponLineOfFireCacheFrames = 0;
+		incrementalInterception = false;
+		unitSlowUpdateByCost = false;
+		mobileCAIGoalCheckMT = false;
+		projectileUpdateMT = false;
+		projectileCollisionMT = false;
+		mapDamageBatchRecalc = false;
+		explosionDamageBatching = false;
+		hitscanBatching = false;
+		shieldCoverageCache = false;
+		airCollisionScanMT = false;
 
 		SLuaAllocLimit::MAX_ALLOC_BYTES = SLuaAllocLimit::MAX_ALLOC_BYTES_DEFAULT;
 
@@ -173,8 +194,15 @@ void CModInfo::Init(const std::string& modFileName)
 		pfRepathDelayInFrames = system.GetInt("pfRepathDelayInFrames", pfRepathDelayInFrames);
 		pfRepathMaxRateInFrames = system.GetInt("pfRepathMaxRateInFrames", pfRepathMaxRateInFrames);
 		pfRawMoveSpeedThreshold = system.GetFloat("pfRawMoveSpeedThreshold", pfRawMoveSpeedThreshold);
+		pfCacheMultiThreadedSearches = system.GetBool("pfCacheMultiThreadedSearches", pfCacheMultiThreadedSearches);
 		qtMaxNodesSearched = system.GetInt("qtMaxNodesSearched", qtMaxNodesSearched);
 		qtRefreshPathMinDist = system.GetFloat("qtRefreshPathMinDist", qtRefreshPathMinDist);
+		qtGroupPathSharing = system.GetBool("qtGroupPathSharing", qtGroupPathSharing);
+		qtHierarchicalSearch = system.GetBool("qtHierarchicalSearch", qtHierarchicalSearch);
+		qtProvisionalPathNodesSearched = system.GetInt("qtProvisionalPathNodesSearched", qtProvisionalPathNodesSearched);
+		qtIncrementalPathRepair = system.GetBool("qtIncrementalPathRepair", qtIncrementalPathRepair);
+		qtPrioritizeMapDamageNearPaths = system.GetBool("qtPrioritizeMapDamageNearPaths", qtPrioritizeMapDamageNearPaths);
+		qtFlowFieldMinGroupSize = system.GetInt("qtFlowFieldMinGroupSize", qtFlowFieldMinGroupSize);
 		qtMaxNodesSearchedRelativeToMapOpenNodes = system.GetFloat("qtMaxNodesSearchedRelativeToMapOpenNodes", qtMaxNodesSearchedRelativeToMapOpenNodes);
 
 		enableSmoothMesh = system.GetBool("enableSmoothMesh", enableSmoothMesh);
@@ -182,6 +210,19 @@ void CModInfo::Init(const std::string& modFileName)
 		smoothMeshSmoothRadius = system.GetInt("smoothMeshSmoothRadius", smoothMeshSmoothRadius);
 
 		quadFieldQuadSizeInElmos = system.GetInt("quadFieldQuadSizeInElmos", quadFieldQuadSizeInElmos);
+		unitUpdateMT = system.GetBool("unitUpdateMT", unitUpdateMT);
+		weaponTargetMT = system.GetBool("weaponTargetMT", weaponTargetMT);
+		weaponLineOfFireCacheFrames = std::max(system.GetInt("weaponLineOfFireCacheFrames", weaponLineOfFireCacheFrames), 0);
+		incrementalInterception = system.GetBool("incrementalInterception", incrementalInterception);
+		unitSlowUpdateByCost = system.GetBool("unitSlowUpdateByCost", unitSlowUpdateByCost);
+		mobileCAIGoalCheckMT = system.GetBool("mobileCAIGoalCheckMT", mobileCAIGoalCheckMT);
+		projectileUpdateMT = system.GetBool("projectileUpdateMT", projectileUpdateMT);
+		projectileCollisionMT = system.GetBool("projectileCollisionMT", projectileCollisionMT);
+		mapDamageBatchRecalc = system.GetBool("mapDamageBatchRecalc", mapDamageBatchRecalc);
+		explosionDamageBatching = system.GetBool("explosionDamageBatching", explosionDamageBatching);
+		hitscanBatching = system.GetBool("hitscanBatching", hitscanBatching);
+		shieldCoverageCache = system.GetBool("shieldCoverageCache", shieldCoverageCache);
+		airCollisionScanMT = system.GetBool("airCollisionScanMT", airCollisionScanMT);
 
 		// Specify in megabytes: 1 << 20 = (1024 * 1024)
 		SLuaAllocLimit::MAX_ALLOC_BYTES = static_cast<decltype(SLuaAllocLimit::MAX_ALLOC_BYTES)>(system.GetInt("LuaAllocLimit", SLuaAllocLimit::MAX_ALLOC_BYTES >> 20u)) << 20u;
@@ -319,6 +360,7 @@ void CModInfo::Init(const std::string& modFileName)
 		alwaysVisibleOverridesCloaked = sensors.GetBool("alwaysVisibleOverridesCloaked", alwaysVisibleOverridesCloaked);
 		decloakRequiresLineOfSight = sensors.GetBool("decloakRequiresLineOfSight", decloakRequiresLineOfSight);
 		separateJammers = sensors.GetBool("separateJammers", separateJammers);
+		asyncLosUpdate = sensors.GetBool("asyncLosUpdate", asyncLosUpdate);
 
 		losMipLevel = los.GetInt("losMipLevel", losMipLevel);
 		airMipLevel = los.GetInt("airMipLevel", airMipLevel);
@@ -171,6 +171,9 @@ public:
 	bool decloakRequiresLineOfSight;
 	/// should _all_ allyteams share the same jammermap
 	bool separateJammers;
+	/// recalculate sensor coverage right after units have moved so it overlaps
+	/// with the rest of the frame, rather than after unit scripts have run
+	bool asyncLosUpdate;
 
 
 	enum {
@@ -197,6 +200,12 @@ public:
 	/// Point at which a region is considered bad for raw path tracing.
 	float pfRawMoveSpeedThreshold;
 
+	/// If true, the paths HAPFS resolves in parallel during a frame's path requests are
+	/// added to the low- and med-res path caches afterwards, in request order, so later
+	/// requests between the same blocks can reuse them. Changes resulting paths so must
+	/// be synced, default false.
+	bool pfCacheMultiThreadedSearches;
+
 	/// Limits how many nodes the QTPFS pathing system is permitted to search. A smaller number
 	/// improves CPU performance, but a larger number will resolve longer paths better, without
 	/// needing to refresh the path.
@@ -214,6 +223,44 @@ public:
 	/// would bring the unit nearer to the goal.
 	float qtRefreshPathMinDist;
 
+	/// Let searches towards the same goal quad (at QTPFS_PARTIAL_SHARE_PATH_MAX_SIZE
+	/// resolution) partially share their path with the first such search queued,
+	/// even when their sources are far apart, i.e. a group move order only needs
+	/// one full search. Changes resulting paths so must be synced, default false.
+	bool qtGroupPathSharing;
+
+	/// If true, QTPFS searches spanning more than a few regions (64x64 squares)
+	/// are guided by a coarse region graph of each node-layer, so they follow the
+	/// corridor that leads around obstacles instead of flooding dead ends. Changes
+	/// resulting paths so must be synced, default false.
+	bool qtHierarchicalSearch;
+
+	/// If greater than zero, a unit's first search for a new path stops after this many
+	/// nodes (split between forward and reverse search) and hands the unit a provisional
+	/// partial path towards the best node found; the full path is searched for on the
+	/// following frame and replaces it. Changes resulting paths so must be synced,
+	/// default 0 (disabled).
+	int qtProvisionalPathNodesSearched;
+
+	/// If true, a path crossing an area that QTPFS re-tesselated (e.g. after a building
+	/// was placed) is only dirtied by nodes whose size or move-cost actually changed,
+	/// rather than by every node overlapping the area; untouched nodes are kept and
+	/// relinked. Changes resulting paths so must be synced, default false.
+	bool qtIncrementalPathRepair;
+
+	/// If true, map damage queued for QTPFS re-tesselation is processed starting with the
+	/// areas that the remaining part of a synced path crosses, instead of in the order it
+	/// happened, so units get repaired paths through their corridor first. Changes
+	/// resulting paths so must be synced, default false.
+	bool qtPrioritizeMapDamageNearPaths;
+
+	/// If greater than zero, every group of at least this many units heading to the same goal
+	/// (see qtGroupPathSharing, which must be enabled) gets a QTPFS flow field over the area
+	/// around them. Units steer along the field's per-node directions instead of straight at
+	/// their next waypoint, so large groups spread over the available corridor instead of
+	/// queuing along one node list. Changes unit movement so must be synced, default 0.
+	int qtFlowFieldMinGroupSize;
+
 	float pfRawDistMult;
 	float pfUpdateRateScale;
 
@@ -230,6 +277,82 @@ public:
 
 	int quadFieldQuadSizeInElmos;
 
+	/// Run the unit-local part of CUnit::Update on the thread-pool; quad-field
+	/// moves and the (serial) builder/factory updates are applied afterwards in
+	/// activeUnits order. Changes update order so must be synced, default false.
+	bool unitUpdateMT;
+
+	/// Gather and score auto-target candidates for weapons due a SlowUpdate on
+	/// the thread-pool against the sim state at the start of SlowUpdateUnits;
+	/// script/Lua weighting, TryTarget and target selection stay serial.
+	/// Targets may differ from the serial path so must be synced, default false.
+	bool weaponTargetMT;
+
+	/// Number of frames a weapon may reuse its last line-of-fire result for the
+	/// same aim and target positions, as long as no unit or feature entered or
+	/// left the quads around the ray and the terrain there did not change.
+	/// Objects moving within those quads are not noticed. Default 0 (off).
+	int weaponLineOfFireCacheFrames;
+
+	/// When an interceptable projectile is created, test only it against all
+	/// interceptors instead of re-testing every interceptor/target pair, and
+	/// skip AllowWeaponInterceptTarget for pairs whose coverage circle can not
+	/// contain the target's position or line of flight. Default false.
+	bool incrementalInterception;
+
+	/// Size the per-frame SlowUpdate slices by a (synced) per-unit cost estimate
+	/// instead of by unit count; every unit still gets exactly one SlowUpdate per
+	/// UNIT_SLOWUPDATE_RATE frames. Default false.
+	bool unitSlowUpdateByCost;
+
+	/// Evaluate the move-goal checks of mobile units due a SlowUpdate on the
+	/// thread-pool (MobileCAIGoalSystem); results are only used while the
+	/// unit's order and move state are unchanged when its SlowUpdate runs.
+	/// Default false.
+	bool mobileCAIGoalCheckMT;
+
+	/// Advance explosive (ballistic) projectiles by gravity and speed on the
+	/// thread-pool before the serial projectile update instead of inside it,
+	/// so projectiles updated earlier in a frame see later ones already moved.
+	/// Default false.
+	bool projectileUpdateMT;
+
+	/// Gather the units, features and shields near each synced projectile on
+	/// the thread-pool before the (serial) collision pass instead of once per
+	/// projectile inside it; objects moved or added by collisions earlier in
+	/// the same pass are then not seen by later projectiles. Default false.
+	bool projectileCollisionMT;
+
+	/// Defer the heightmap, LOS, path and smooth-mesh recalculation of map
+	/// damage whose explosions finish in the same frame until all of them
+	/// have been applied, and run it once per merged (touching) rectangle.
+	/// Default false.
+	bool mapDamageBatchRecalc;
+
+	/// Queue the area damage of explosions caused by projectile collisions
+	/// and apply it (in the same order) after the synced collision pass, with
+	/// one quadfield query per quad in which several explosions went off; the
+	/// order in which one explosion damages objects can change. Default false.
+	bool explosionDamageBatching;
+
+	/// Let BeamLaser and LightningCannon weapons only aim when firing, and
+	/// trace their beams after all units updated their weapons: candidate
+	/// objects are gathered for every beam in parallel, then the shots hit
+	/// (and damage) serially in firing order. Default false.
+	bool hitscanBatching;
+
+	/// Look up the shields a projectile can collide with in sets shared by
+	/// all projectiles spanning the same quads, rebuilt only when shields
+	/// enter or leave quads; shields that one projectile reaches in the same
+	/// frame can be tested in a different order. Default false.
+	bool shieldCoverageCache;
+
+	/// Run the periodic collision-warning scans of aircraft in parallel
+	/// before the movetype update instead of inside it, so aircraft see the
+	/// units around them as they were at the start of the update rather than
+	/// partly moved already. Default false.
+	bool airCollisionScanMT;
+
 	bool allowTake;
 	bool allowEnginePlayerlist;
 
@@ -1,6 +1,7 @@
 /* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
 
 #include <algorithm>
+#include <cassert>
 
 #include "QuadField.h"
 #include "Map/ReadMap.h"
@@ -20,6 +21,13 @@
 
 #include "System/Misc/TracyDefs.h"
 
+#ifndef UNIT_TEST
+// the quad lists are only guarded by the sim's serial phases; see CQuadField::ReleaseVector
+static inline void AssertSerialAccess() {
+	assert(!ThreadPool::inMultiThreadedSection);
+}
+#endif
+
 CR_BIND(CQuadField, )
 CR_REG_METADATA(CQuadField, (
 	CR_MEMBER(baseQuads),
@@ -29,11 +37,20 @@ CR_REG_METADATA(CQuadField, (
 	CR_MEMBER(quadSizeZ),
 	CR_MEMBER(invQuadSize),
 
+	CR_IGNORED(quadBlocks),
+	CR_IGNORED(numBlocksX),
+	CR_IGNORED(numBlocksZ),
+
 	CR_IGNORED(tempUnits),
 	CR_IGNORED(tempFeatures),
 	CR_IGNORED(tempProjectiles),
 	CR_IGNORED(tempSolids),
-	CR_IGNORED(tempQuads)
+	CR_IGNORED(tempQuads),
+
+	CR_IGNORED(numQuadChanges),
+	CR_IGNORED(numRepulserChanges),
+
+	CR_POSTLOAD(PostLoad)
 ))
 
 CR_BIND(CQuadField::Quad, )
@@ -43,6 +60,7 @@ CR_REG_METADATA_SUB(CQuadField, Quad, (
 	CR_MEMBER(features),
 	CR_MEMBER(projectiles),
 	CR_MEMBER(repulsers),
+	CR_MEMBER(lastChangeFrame),
 
 	CR_POSTLOAD(PostLoad)
 ))
@@ -63,6 +81,29 @@ void CQuadField::Quad::PostLoad()
 #endif
 }
 
+void CQuadField::PostLoad()
+{
+	numBlocksX = (numQuadsX + QUAD_BLOCK_SIZE - 1) / QUAD_BLOCK_SIZE;
+	numBlocksZ = (numQuadsZ + QUAD_BLOCK_SIZE - 1) / QUAD_BLOCK_SIZE;
+
+	RecountQuadBlocks();
+}
+
+void CQuadField::RecountQuadBlocks()
+{
+	RECOIL_DETAILED_TRACY_ZONE;
+	quadBlocks.clear();
+	quadBlocks.resize(numBlocksX * numBlocksZ);
+
+	for (int qi = 0, n = baseQuads.size(); qi < n; ++qi) {
+		QuadBlock& block = GetQuadBlock(qi);
+
+		block.numUnits += baseQuads[qi].units.size();
+		block.numFeatures += baseQuads[qi].features.size();
+		block.numProjectiles += baseQuads[qi].projectiles.size();
+	}
+}
+
 void CQuadField::Init(int2 mapDims, int quadSize)
 {
 	RECOIL_DETAILED_TRACY_ZONE;
@@ -78,7 +119,12 @@ void CQuadField::Init(int2 mapDims, int quadSize)
 
 	invQuadSize = {1.0f / quadSizeX, 1.0f / quadSizeZ};
 
+	numBlocksX = (numQuadsX + QUAD_BLOCK_SIZE - 1) / QUAD_BLOCK_SIZE;
+	numBlocksZ = (numQuadsZ + QUAD_BLOCK_SIZE - 1) / QUAD_BLOCK_SIZE;
+
 	baseQuads.resize(numQuadsX * numQuadsZ);
+	quadBlocks.clear();
+	quadBlocks.resize(numBlocksX * numBlocksZ);
 
 	size_t threadCount = ThreadPool::GetNumThreads();
 
@@ -104,18 +150,21 @@ void CQuadField::Kill()
 		quad.Clear();
 	}
 
-	for (auto cache : tempUnits)
+	std::fill(quadBlocks.begin(), quadBlocks.end(), QuadBlock{});
+
+	for (auto& cache : tempUnits)
 		cache.ReleaseAll();
 
-	for (auto cache : tempFeatures)
+	for (auto& cache : tempFeatures)
 		cache.ReleaseAll();
 
-	tempProjectiles.ReleaseAll();
+	for (auto& cache : tempProjectiles)
+		cache.ReleaseAll();
 
-	for (auto cache : tempSolids)
+	for (auto& cache : tempSolids)
 		cache.ReleaseAll();
 
-	for (auto cache : tempQuads)
+	for (auto& cache : tempQuads)
 		cache.ReleaseAll();
 }
 
@@ -137,7 +186,7 @@ int CQuadField::WorldPosToQuadFieldIdx(const float3 p) const
 
 
 #ifndef UNIT_TEST // ClampInBounds() is not linked
-void CQuadField::GetQuads(QuadFieldQuery& qfq, float3 pos, float radius)
+void CQuadField::GetQuads(QuadFieldQuery& qfq, float3 pos, float radius, unsigned int listBits)
 {
 	RECOIL_DETAILED_TRACY_ZONE;
 	pos.AssertNaNs();
@@ -157,6 +206,13 @@ void CQuadField::GetQuads(QuadFieldQuery& qfq, float3 pos, float radius)
 		for (int x = min.x; x <= max.x; ++x) {
 			assert(x < numQuadsX);
 			assert(z < numQuadsZ);
+
+			// skip to the last column of an empty block; keeps the row-major order
+			if (!QuadBlockHasAny(x, z, listBits)) {
+				x |= (QUAD_BLOCK_SIZE - 1);
+				continue;
+			}
+
 			const float3 quadPos = float3(x * quadSizeX + quadSizeX * 0.5f, 0, z * quadSizeZ + quadSizeZ * 0.5f);
 			if (pos.SqDistance2D(quadPos) < maxSqLength) {
 				qfq.quads->push_back(z * numQuadsX + x);
@@ -168,7 +224,7 @@ void CQuadField::GetQuads(QuadFieldQuery& qfq, float3 pos, float radius)
 }
 
 
-void CQuadField::GetQuadsRectangle(QuadFieldQuery& qfq, const float3& mins, const float3& maxs)
+void CQuadField::GetQuadsRectangle(QuadFieldQuery& qfq, const float3& mins, const float3& maxs, unsigned int listBits)
 {
 	RECOIL_DETAILED_TRACY_ZONE;
 	mins.AssertNaNs();
@@ -185,6 +241,12 @@ void CQuadField::GetQuadsRectangle(QuadFieldQuery& qfq, const float3& mins, cons
 		for (int x = min.x; x <= max.x; ++x) {
 			assert(x < numQuadsX);
 			assert(z < numQuadsZ);
+
+			if (!QuadBlockHasAny(x, z, listBits)) {
+				x |= (QUAD_BLOCK_SIZE - 1);
+				continue;
+			}
+
 			qfq.quads->push_back(z * numQuadsX + x);
 		}
 	}
@@ -378,6 +440,7 @@ void CQuadField::GetQuadsOnWideRay(QuadFieldQuery& qfq, const float3& start, con
 bool CQuadField::InsertUnitIf(CUnit* unit, const float3& wpos)
 {
 	RECOIL_DETAILED_TRACY_ZONE;
+	AssertSerialAccess();
 	assert(unit != nullptr);
 
 	const int wposQuadIdx = WorldPosToQuadFieldIdx(wpos);
@@ -391,14 +454,16 @@ bool CQuadField::InsertUnitIf(CUnit* unit, const float3& wpos)
 	if (!spring::VectorInsertUnique(unit->quads, wposQuadIdx, true))
 		return false;
 
-	spring::VectorInsertUnique(baseQuads[wposQuadIdx].units, unit, false);
+	GetQuadBlock(wposQuadIdx).numUnits += spring::VectorInsertUnique(baseQuads[wposQuadIdx].units, unit, false);
 	spring::VectorInsertUnique(baseQuads[wposQuadIdx].teamUnits[unit->allyteam], unit, false);
+	MarkQuadChanged(wposQuadIdx);
 	return true;
 }
 
 bool CQuadField::RemoveUnitIf(CUnit* unit, const float3& wpos)
 {
 	RECOIL_DETAILED_TRACY_ZONE;
+	AssertSerialAccess();
 	if (unit == nullptr)
 		return false;
 
@@ -422,8 +487,9 @@ bool CQuadField::RemoveUnitIf(CUnit* unit, const float3& wpos)
 	if (!spring::VectorErase(unit->quads, wposQuadIdx))
 		return false;
 
-	spring::VectorErase(baseQuads[wposQuadIdx].units, unit);
+	GetQuadBlock(wposQuadIdx).numUnits -= spring::VectorErase(baseQuads[wposQuadIdx].units, unit);
 	spring::VectorErase(baseQuads[wposQuadIdx].teamUnits[unit->allyteam], unit);
+	MarkQuadChanged(wposQuadIdx);
 	return true;
 }
 #endif
@@ -434,6 +500,7 @@ bool CQuadField::RemoveUnitIf(CUnit* unit, const float3& wpos)
 void CQuadField::MovedUnit(CUnit* unit)
 {
 	RECOIL_DETAILED_TRACY_ZONE;
+	AssertSerialAccess();
 	QuadFieldQuery qfQuery;
 	GetQuads(qfQuery, unit->pos, unit->radius);
 
@@ -444,13 +511,15 @@ void CQuadField::MovedUnit(CUnit* unit)
 	}
 
 	for (const int qi: unit->quads) {
-		spring::VectorErase(baseQuads[qi].units, unit);
+		GetQuadBlock(qi).numUnits -= spring::VectorErase(baseQuads[qi].units, unit);
 		spring::VectorErase(baseQuads[qi].teamUnits[unit->allyteam], unit);
+		MarkQuadChanged(qi);
 	}
 
 	for (const int qi: *qfQuery.quads) {
-		spring::VectorInsertUnique(baseQuads[qi].units, unit, false);
+		GetQuadBlock(qi).numUnits += spring::VectorInsertUnique(baseQuads[qi].units, unit, false);
 		spring::VectorInsertUnique(baseQuads[qi].teamUnits[unit->allyteam], unit, false);
+		MarkQuadChanged(qi);
 	}
 
 	unit->quads = std::move(*qfQuery.quads);
@@ -459,9 +528,11 @@ void CQuadField::MovedUnit(CUnit* unit)
 void CQuadField::RemoveUnit(CUnit* unit)
 {
 	RECOIL_DETAILED_TRACY_ZONE;
+	AssertSerialAccess();
 	for (const int qi: unit->quads) {
-		spring::VectorErase(baseQuads[qi].units, unit);
+		GetQuadBlock(qi).numUnits -= spring::VectorErase(baseQuads[qi].units, unit);
 		spring::VectorErase(baseQuads[qi].teamUnits[unit->allyteam], unit);
+		MarkQuadChanged(qi);
 	}
 
 	unit->quads.clear();
@@ -481,6 +552,7 @@ void CQuadField::RemoveUnit(CUnit* unit)
 void CQuadField::MovedRepulser(CPlasmaRepulser* repulser)
 {
 	RECOIL_DETAILED_TRACY_ZONE;
+	AssertSerialAccess();
 	QuadFieldQuery qfQuery;
 	GetQuads(qfQuery, repulser->weaponMuzzlePos, repulser->GetRadius());
 
@@ -501,16 +573,19 @@ void CQuadField::MovedRepulser(CPlasmaRepulser* repulser)
 	}
 
 	repulser->SetQuads(std::move(*qfQuery.quads));
+	numRepulserChanges += 1;
 }
 
 void CQuadField::RemoveRepulser(CPlasmaRepulser* repulser)
 {
 	RECOIL_DETAILED_TRACY_ZONE;
+	AssertSerialAccess();
 	for (const int qi: repulser->GetQuads()) {
 		spring::VectorErase(baseQuads[qi].repulsers, repulser);
 	}
 
 	repulser->ClearQuads();
+	numRepulserChanges += 1;
 
 	#ifdef DEBUG_QUADFIELD
 	for (const Quad& q: baseQuads) {
@@ -521,26 +596,62 @@ void CQuadField::RemoveRepulser(CPlasmaRepulser* repulser)
 	#endif
 }
 
+#ifndef UNIT_TEST // ClampInBounds() is not linked
+uint64_t CQuadField::GetQuadRectKey(float3 pos, float radius) const
+{
+	pos.ClampInBounds();
+
+	const int2 min = WorldPosToQuadField(pos - radius);
+	const int2 max = WorldPosToQuadField(pos + radius);
+
+	return ((uint64_t(min.x) << 48) | (uint64_t(min.y) << 32) | (uint64_t(max.x) << 16) | uint64_t(max.y));
+}
+#endif
+
+void CQuadField::GetQuadRectRepulsers(uint64_t key, std::vector<CPlasmaRepulser*>& repulsers) const
+{
+	RECOIL_DETAILED_TRACY_ZONE;
+	const int2 min = {int((key >> 48) & 0xFFFF), int((key >> 32) & 0xFFFF)};
+	const int2 max = {int((key >> 16) & 0xFFFF), int((key >>  0) & 0xFFFF)};
+
+	repulsers.clear();
+
+	for (int z = min.y; z <= max.y; ++z) {
+		for (int x = min.x; x <= max.x; ++x) {
+			for (CPlasmaRepulser* r: baseQuads[z * numQuadsX + x].repulsers) {
+				if (std::find(repulsers.begin(), repulsers.end(), r) != repulsers.end())
+					continue;
+
+				repulsers.push_back(r);
+			}
+		}
+	}
+}
+
 
 void CQuadField::AddFeature(CFeature* feature)
 {
 	RECOIL_DETAILED_TRACY_ZONE;
+	AssertSerialAccess();
 	QuadFieldQuery qfQuery;
 	GetQuads(qfQuery, feature->pos, feature->radius);
 
 	for (const int qi: *qfQuery.quads) {
-		spring::VectorInsertUnique(baseQuads[qi].features, feature, false);
+		GetQuadBlock(qi).numFeatures += spring::VectorInsertUnique(baseQuads[qi].features, feature, false);
+		MarkQuadChanged(qi);
 	}
 }
 
 void CQuadField::RemoveFeature(CFeature* feature)
 {
 	RECOIL_DETAILED_TRACY_ZONE;
+	AssertSerialAccess();
 	QuadFieldQuery qfQuery;
 	GetQuads(qfQuery, feature->pos, feature->radius);
 
 	for (const int qi: *qfQuery.quads) {
-		spring::VectorErase(baseQuads[qi].features, feature);
+		GetQuadBlock(qi).numFeatures -= spring::VectorErase(baseQuads[qi].features, feature);
+		MarkQuadChanged(qi);
 	}
 
 	#ifdef DEBUG_QUADFIELD
@@ -554,9 +665,43 @@ void CQuadField::RemoveFeature(CFeature* feature)
 
 
 
+void CQuadField::MarkQuadsChanged(const float3& mins, const float3& maxs)
+{
+	RECOIL_DETAILED_TRACY_ZONE;
+	QuadFieldQuery qfQuery;
+	GetQuadsRectangle(qfQuery, mins, maxs);
+
+	for (const int qi: *qfQuery.quads) {
+		MarkQuadChanged(qi);
+	}
+}
+
+bool CQuadField::QuadsChangedSince(const float3& mins, const float3& maxs, int frameNum)
+{
+	RECOIL_DETAILED_TRACY_ZONE;
+	QuadFieldQuery qfQuery;
+	GetQuadsRectangle(qfQuery, mins, maxs);
+
+	for (const int qi: *qfQuery.quads) {
+		if (baseQuads[qi].lastChangeFrame >= frameNum)
+			return true;
+	}
+
+	return false;
+}
+
+void CQuadField::MarkQuadChanged(int qi)
+{
+	baseQuads[qi].lastChangeFrame = gs->frameNum;
+	numQuadChanges += 1;
+}
+
+
+
 void CQuadField::MovedProjectile(CProjectile* p)
 {
 	RECOIL_DETAILED_TRACY_ZONE;
+	AssertSerialAccess();
 	if (!p->synced)
 		return;
 	// hit-scan projectiles do NOT move!
@@ -573,6 +718,7 @@ void CQuadField::MovedProjectile(CProjectile* p)
 void CQuadField::AddProjectile(CProjectile* p)
 {
 	RECOIL_DETAILED_TRACY_ZONE;
+	AssertSerialAccess();
 	assert(p->synced);
 
 	if (p->hitscan) {
@@ -580,13 +726,13 @@ void CQuadField::AddProjectile(CProjectile* p)
 		GetQuadsOnRay(qfQuery, p->pos, p->dir, p->speed.w);
 
 		for (const int qi: *qfQuery.quads) {
-			spring::VectorInsertUnique(baseQuads[qi].projectiles, p, false);
+			GetQuadBlock(qi).numProjectiles += spring::VectorInsertUnique(baseQuads[qi].projectiles, p, false);
 		}
 
 		p->quads = std::move(*qfQuery.quads);
 	} else {
 		int newQuad = WorldPosToQuadFieldIdx(p->pos);
-		spring::VectorInsertUnique(baseQuads[newQuad].projectiles, p, false);
+		GetQuadBlock(newQuad).numProjectiles += spring::VectorInsertUnique(baseQuads[newQuad].projectiles, p, false);
 		p->quads.clear();
 		p->quads.push_back(newQuad);
 	}
@@ -595,10 +741,11 @@ void CQuadField::AddProjectile(CProjectile* p)
 void CQuadField::RemoveProjectile(CProjectile* p)
 {
 	RECOIL_DETAILED_TRACY_ZONE;
+	AssertSerialAccess();
 	assert(p->synced);
 
 	for (const int qi: p->quads) {
-		spring::VectorErase(baseQuads[qi].projectiles, p);
+		GetQuadBlock(qi).numProjectiles -= spring::VectorErase(baseQuads[qi].projectiles, p);
 	}
 
 	p->quads.clear();
@@ -614,7 +761,7 @@ void CQuadField::GetUnits(QuadFieldQuery& qfq, const float3& pos, float radius)
 	auto curThread = qfq.threadOwner;
 	QuadFieldQuery qfQuery;
 	qfQuery.threadOwner = curThread;
-	GetQuads(qfQuery, pos, radius);
+	GetQuads(qfQuery, pos, radius, QUAD_LIST_UNITS);
 	const int tempNum = gs->GetMtTempNum(curThread);
 	qfq.units = tempUnits[curThread].ReserveVector();
 
@@ -637,7 +784,7 @@ void CQuadField::GetUnitsExact(QuadFieldQuery& qfq, const float3& pos, float rad
 	auto curThread = qfq.threadOwner;
 	QuadFieldQuery qfQuery;
 	qfQuery.threadOwner = curThread;
-	GetQuads(qfQuery, pos, radius);
+	GetQuads(qfQuery, pos, radius, QUAD_LIST_UNITS);
 	const int tempNum = gs->GetMtTempNum(curThread);
 	qfq.units = tempUnits[curThread].ReserveVector();
 
@@ -670,7 +817,7 @@ void CQuadField::GetUnitsExact(QuadFieldQuery& qfq, const float3& mins, const fl
 	auto curThread = qfq.threadOwner;
 	QuadFieldQuery qfQuery;
 	qfQuery.threadOwner = curThread;
-	GetQuadsRectangle(qfQuery, mins, maxs);
+	GetQuadsRectangle(qfQuery, mins, maxs, QUAD_LIST_UNITS);
 	const int tempNum = gs->GetMtTempNum(curThread);
 	qfq.units = tempUnits[curThread].ReserveVector();
 
@@ -702,7 +849,7 @@ void CQuadField::GetFeaturesExact(QuadFieldQuery& qfq, const float3& pos, float
 	auto curThread = qfq.threadOwner;
 	QuadFieldQuery qfQuery;
 	qfQuery.threadOwner = curThread;
-	GetQuads(qfQuery, pos, radius);
+	GetQuads(qfQuery, pos, radius, QUAD_LIST_FEATURES);
 	const int tempNum = gs->GetMtTempNum(curThread);
 	qfq.features = tempFeatures[curThread].ReserveVector();
 
@@ -735,7 +882,7 @@ void CQuadField::GetFeaturesExact(QuadFieldQuery& qfq, const float3& mins, const
 	auto curThread = qfq.threadOwner;
 	QuadFieldQuery qfQuery;
 	qfQuery.threadOwner = curThread;
-	GetQuadsRectangle(qfQuery, mins, maxs);
+	GetQuadsRectangle(qfQuery, mins, maxs, QUAD_LIST_FEATURES);
 	const int tempNum = gs->GetMtTempNum(curThread);
 	qfq.features = tempFeatures[curThread].ReserveVector();
 
@@ -764,17 +911,19 @@ void CQuadField::GetFeaturesExact(QuadFieldQuery& qfq, const float3& mins, const
 void CQuadField::GetProjectilesExact(QuadFieldQuery& qfq, const float3& pos, float radius)
 {
 	RECOIL_DETAILED_TRACY_ZONE;
+	auto curThread = qfq.threadOwner;
 	QuadFieldQuery qfQuery;
-	GetQuads(qfQuery, pos, radius);
-	const int tempNum = gs->GetTempNum();
-	qfq.projectiles = tempProjectiles.ReserveVector();
+	qfQuery.threadOwner = curThread;
+	GetQuads(qfQuery, pos, radius, QUAD_LIST_PROJECTILES);
+	const int tempNum = gs->GetMtTempNum(curThread);
+	qfq.projectiles = tempProjectiles[curThread].ReserveVector();
 
 	for (const int qi: *qfQuery.quads) {
 		for (CProjectile* p: baseQuads[qi].projectiles) {
-			if (p->tempNum == tempNum)
+			if (p->mtTempNum[curThread] == tempNum)
 				continue;
 
-			p->tempNum = tempNum;
+			p->mtTempNum[curThread] = tempNum;
 
 			if (pos.SqDistance(p->pos) >= Square(radius + p->radius))
 				continue;
@@ -789,17 +938,19 @@ void CQuadField::GetProjectilesExact(QuadFieldQuery& qfq, const float3& pos, flo
 void CQuadField::GetProjectilesExact(QuadFieldQuery& qfq, const float3& mins, const float3& maxs)
 {
 	RECOIL_DETAILED_TRACY_ZONE;
+	auto curThread = qfq.threadOwner;
 	QuadFieldQuery qfQuery;
-	GetQuadsRectangle(qfQuery, mins, maxs);
-	const int tempNum = gs->GetTempNum();
-	qfq.projectiles = tempProjectiles.ReserveVector();
+	qfQuery.threadOwner = curThread;
+	GetQuadsRectangle(qfQuery, mins, maxs, QUAD_LIST_PROJECTILES);
+	const int tempNum = gs->GetMtTempNum(curThread);
+	qfq.projectiles = tempProjectiles[curThread].ReserveVector();
 
 	for (const int qi: *qfQuery.quads) {
 		for (CProjectile* p: baseQuads[qi].projectiles) {
-			if (p->tempNum == tempNum)
+			if (p->mtTempNum[curThread] == tempNum)
 				continue;
 
-			p->tempNum = tempNum;
+			p->mtTempNum[curThread] = tempNum;
 
 			const float3& pos = p->pos;
 			if (pos.x < mins.x || pos.x > maxs.x)
@@ -827,7 +978,7 @@ void CQuadField::GetSolidsExact(
 	auto curThread = qfq.threadOwner;
 	QuadFieldQuery qfQuery;
 	qfQuery.threadOwner = curThread;
-	GetQuads(qfQuery, pos, radius);
+	GetQuads(qfQuery, pos, radius, QUAD_LIST_UNITS | QUAD_LIST_FEATURES);
 	const int tempNum = gs->GetMtTempNum(curThread);
 	qfq.solids = tempSolids[curThread].ReserveVector();
 	
@@ -877,16 +1028,19 @@ bool CQuadField::NoSolidsExact(
 	const unsigned int collisionStateBits
 ) {
 	RECOIL_DETAILED_TRACY_ZONE;
+	const int curThread = ThreadPool::GetThreadNum();
+
 	QuadFieldQuery qfQuery;
-	GetQuads(qfQuery, pos, radius);
-	const int tempNum = gs->GetTempNum();
+	qfQuery.threadOwner = curThread;
+	GetQuads(qfQuery, pos, radius, QUAD_LIST_UNITS | QUAD_LIST_FEATURES);
+	const int tempNum = gs->GetMtTempNum(curThread);
 
 	for (const int qi: *qfQuery.quads) {
 		for (CUnit* u: baseQuads[qi].units) {
-			if (u->tempNum == tempNum)
+			if (u->mtTempNum[curThread] == tempNum)
 				continue;
 
-			u->tempNum = tempNum;
+			u->mtTempNum[curThread] = tempNum;
 
 			if (!u->HasPhysicalStateBit(physicalStateBits))
 				continue;
@@ -899,10 +1053,10 @@ bool CQuadField::NoSolidsExact(
 		}
 
 		for (CFeature* f: baseQuads[qi].features) {
-			if (f->tempNum == tempNum)
+			if (f->mtTempNum[curThread] == tempNum)
 				continue;
 
-			f->tempNum = tempNum;
+			f->mtTempNum[curThread] = tempNum;
 
 			if (!f->HasPhysicalStateBit(physicalStateBits))
 				continue;
@@ -925,12 +1079,27 @@ void CQuadField::GetUnitsAndFeaturesColVol(
 	const float radius,
 	std::vector<CUnit*>& units,
 	std::vector<CFeature*>& features,
-	std::vector<CPlasmaRepulser*>* repulsers
+	std::vector<CPlasmaRepulser*>* repulsers,
+	int onThread
 ) {
 	RECOIL_DETAILED_TRACY_ZONE;
-	const int tempNum = gs->GetTempNum();
+	// per-thread markers when run from the thread-pool, the synced one otherwise
+	const bool mtQuery = (onThread >= 0);
+	const int tempNum = mtQuery? gs->GetMtTempNum(onThread): gs->GetTempNum();
+
+	const auto MarkObject = [&](CWorldObject* o) {
+		int& objTempNum = mtQuery? o->mtTempNum[onThread]: o->tempNum;
+
+		// prevent double adding
+		if (objTempNum == tempNum)
+			return false;
+
+		objTempNum = tempNum;
+		return true;
+	};
 
 	QuadFieldQuery qfQuery;
+	qfQuery.threadOwner = std::max(onThread, 0);
 	GetQuads(qfQuery, pos, radius);
 	// start counting from the previous object-cache sizes
 
@@ -938,12 +1107,9 @@ void CQuadField::GetUnitsAndFeaturesColVol(
 		const Quad& quad = baseQuads[qi];
 
 		for (CUnit* u: quad.units) {
-			// prevent double adding
-			if (u->tempNum == tempNum)
+			if (!MarkObject(u))
 				continue;
 
-			u->tempNum = tempNum;
-
 			const auto* colvol = &u->collisionVolume;
 			const float totRad = radius + colvol->GetBoundingRadius();
 
@@ -954,12 +1120,9 @@ void CQuadField::GetUnitsAndFeaturesColVol(
 		}
 
 		for (CFeature* f: quad.features) {
-			// prevent double adding
-			if (f->tempNum == tempNum)
+			if (!MarkObject(f))
 				continue;
 
-			f->tempNum = tempNum;
-
 			const auto* colvol = &f->collisionVolume;
 			const float totRad = radius + colvol->GetBoundingRadius();
 
@@ -970,11 +1133,17 @@ void CQuadField::GetUnitsAndFeaturesColVol(
 		}
 		if (repulsers != nullptr) {
 			for (CPlasmaRepulser* r: quad.repulsers) {
-				// prevent double adding
-				if (r->tempNum == tempNum)
-					continue;
-
-				r->tempNum = tempNum;
+				// prevent double adding; repulsers have no per-thread
+				// markers, but there are only ever a handful per query
+				if (mtQuery) {
+					if (std::find(repulsers->begin(), repulsers->end(), r) != repulsers->end())
+						continue;
+				} else {
+					if (r->tempNum == tempNum)
+						continue;
+
+					r->tempNum = tempNum;
+				}
 
 				const auto* colvol = &r->collisionVolume;
 				const float totRad = radius + colvol->GetBoundingRadius();
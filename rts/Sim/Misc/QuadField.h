@@ -85,17 +85,29 @@ public:
 	void Init(int2 mapDims, int quadSize);
 	void Kill();
 
-	void GetQuads(QuadFieldQuery& qfq, float3 pos, float radius);
-	void GetQuadsRectangle(QuadFieldQuery& qfq, const float3& mins, const float3& maxs);
+	/**
+	 * Quads are grouped into blocks of QUAD_BLOCK_SIZE x QUAD_BLOCK_SIZE that count
+	 * the entries of their quads' lists. Passing a QUAD_LIST_* mask in @c listBits
+	 * leaves out quads whose block holds none of those kinds, so large-radius queries
+	 * cost in proportion to the occupied area; 0 returns every quad in range.
+	 */
+	void GetQuads(QuadFieldQuery& qfq, float3 pos, float radius, unsigned int listBits = 0);
+	void GetQuadsRectangle(QuadFieldQuery& qfq, const float3& mins, const float3& maxs, unsigned int listBits = 0);
 	void GetQuadsOnRay(QuadFieldQuery& qfq, const float3& start, const float3& dir, float length);
 	void GetQuadsOnWideRay(QuadFieldQuery& qfq, const float3& start, const float3& dir, float length, float width);
 
+	/**
+	 * Appends the units, features and (optionally) shield repulsers whose
+	 * collision volumes are within @c radius of @c pos. Pass the pool thread
+	 * in @c onThread to run concurrently with other such queries.
+	 */
 	void GetUnitsAndFeaturesColVol(
 		const float3& pos,
 		const float radius,
 		std::vector<CUnit*>& units,
 		std::vector<CFeature*>& features,
-		std::vector<CPlasmaRepulser*>* repulsers = nullptr
+		std::vector<CPlasmaRepulser*>* repulsers = nullptr,
+		int onThread = -1
 	);
 
 	/**
@@ -161,11 +173,32 @@ public:
 	void MovedRepulser(CPlasmaRepulser* repulser);
 	void RemoveRepulser(CPlasmaRepulser* repulser);
 
+	/// packed rectangle of the quads GetQuads(pos, radius) draws from
+	uint64_t GetQuadRectKey(float3 pos, float radius) const;
+	/// repulsers registered in any quad of rectangle <key> (once each, in row-major quad order)
+	void GetQuadRectRepulsers(uint64_t key, std::vector<CPlasmaRepulser*>& repulsers) const;
+	/// bumped whenever a repulser enters or leaves a quad
+	unsigned int GetNumRepulserChanges() const { return numRepulserChanges; }
+
+	/**
+	 * Units or features entering or leaving a quad mark it as changed in the
+	 * current frame; others (e.g. heightmap updates) can do so explicitly.
+	 * QuadsChangedSince is true if any quad overlapping the XZ rectangle
+	 * [mins, maxs] was marked in or after frame @c frameNum.
+	 */
+	void MarkQuadsChanged(const float3& mins, const float3& maxs);
+	bool QuadsChangedSince(const float3& mins, const float3& maxs, int frameNum);
+	/// bumped by every change mark, for detecting changes within a frame
+	unsigned int GetNumQuadChanges() const { return numQuadChanges; }
+
 	// Note: ensure ReleaseVector is called in the same thread as original quad field query generated.
+	// Queries of every kind may be issued concurrently from pool threads as long as each passes
+	// its own thread number (QuadFieldQuery::threadOwner); adding, moving or removing objects is
+	// not synchronized and must only happen on the main or load thread outside for_mt sections.
 
 	void ReleaseVector(std::vector<CUnit*>* v       , int onThread = 0) { tempUnits[onThread].ReleaseVector(v); }
 	void ReleaseVector(std::vector<CFeature*>* v    , int onThread = 0) { tempFeatures[onThread].ReleaseVector(v); }
-	void ReleaseVector(std::vector<CProjectile*>* v ) { tempProjectiles.ReleaseVector(v); }
+	void ReleaseVector(std::vector<CProjectile*>* v , int onThread = 0) { tempProjectiles[onThread].ReleaseVector(v); }
 	void ReleaseVector(std::vector<CSolidObject*>* v, int onThread = 0) { tempSolids[onThread].ReleaseVector(v); }
 	void ReleaseVector(std::vector<int>* v          , int onThread = 0) { tempQuads[onThread].ReleaseVector(v); }
 
@@ -184,6 +217,7 @@ public:
 			features = std::move(q.features);
 			projectiles = std::move(q.projectiles);
 			repulsers = std::move(q.repulsers);
+			lastChangeFrame = q.lastChangeFrame;
 			return *this;
 		}
 
@@ -199,6 +233,7 @@ public:
 			features.clear();
 			projectiles.clear();
 			repulsers.clear();
+			lastChangeFrame = -1;
 		}
 
 	public:
@@ -207,6 +242,8 @@ public:
 		std::vector<CFeature*> features;
 		std::vector<CProjectile*> projectiles;
 		std::vector<CPlasmaRepulser*> repulsers;
+
+		int lastChangeFrame = -1;
 	};
 
 	const Quad& GetQuad(unsigned i) const {
@@ -226,18 +263,51 @@ public:
 	int GetQuadSizeZ() const { return quadSizeZ; }
 
 	constexpr static unsigned int BASE_QUAD_SIZE = 128;
+	constexpr static int QUAD_BLOCK_SIZE = 4;
+
+	enum QuadListBits {
+		QUAD_LIST_UNITS       = 1 << 0,
+		QUAD_LIST_FEATURES    = 1 << 1,
+		QUAD_LIST_PROJECTILES = 1 << 2,
+	};
 
 private:
+	struct QuadBlock {
+		bool HasAny(unsigned int listBits) const {
+			return
+				((listBits & QUAD_LIST_UNITS      ) != 0 && numUnits       > 0) ||
+				((listBits & QUAD_LIST_FEATURES   ) != 0 && numFeatures    > 0) ||
+				((listBits & QUAD_LIST_PROJECTILES) != 0 && numProjectiles > 0);
+		}
+
+		int numUnits = 0;
+		int numFeatures = 0;
+		int numProjectiles = 0;
+	};
+
+	void PostLoad();
+	void MarkQuadChanged(int qi);
+	void RecountQuadBlocks();
+
+	QuadBlock& GetQuadBlock(int qi) {
+		return quadBlocks[((qi / numQuadsX) / QUAD_BLOCK_SIZE) * numBlocksX + (qi % numQuadsX) / QUAD_BLOCK_SIZE];
+	}
+	bool QuadBlockHasAny(int x, int z, unsigned int listBits) const {
+		return (listBits == 0 || quadBlocks[(z / QUAD_BLOCK_SIZE) * numBlocksX + (x / QUAD_BLOCK_SIZE)].HasAny(listBits));
+	}
+
 	int2 WorldPosToQuadField(const float3 p) const;
 	int WorldPosToQuadFieldIdx(const float3 p) const;
 
 private:
 	std::vector<Quad> baseQuads;
+	// coarse level over baseQuads, rebuilt on load
+	std::vector<QuadBlock> quadBlocks;
 
 	// preallocated vectors for Get*Exact functions
 	std::array< QueryVectorCache<CUnit*>, ThreadPool::MAX_THREADS >  tempUnits;
 	std::array< QueryVectorCache<CFeature*>, ThreadPool::MAX_THREADS >  tempFeatures;
-	QueryVectorCache<CProjectile*> tempProjectiles;
+	std::array< QueryVectorCache<CProjectile*>, ThreadPool::MAX_THREADS > tempProjectiles;
 	std::array< QueryVectorCache<CSolidObject*>, ThreadPool::MAX_THREADS > tempSolids;
 	std::array< QueryVectorCache<int>, ThreadPool::MAX_THREADS > tempQuads;
 
@@ -246,8 +316,14 @@ private:
 	int numQuadsX;
 	int numQuadsZ;
 
+	int numBlocksX;
+	int numBlocksZ;
+
 	int quadSizeX;
 	int quadSizeZ;
+
+	unsigned int numQuadChanges = 0;
+	unsigned int numRepulserChanges = 0;
 };
 
 extern CQuadField quadField;
@@ -257,7 +333,7 @@ struct QuadFieldQuery {
 	~QuadFieldQuery() {
 		quadField.ReleaseVector(units, threadOwner);
 		quadField.ReleaseVector(features, threadOwner);
-		quadField.ReleaseVector(projectiles);
+		quadField.ReleaseVector(projectiles, threadOwner);
 		quadField.ReleaseVector(solids, threadOwner);
 		quadField.ReleaseVector(quads, threadOwner);
 	}
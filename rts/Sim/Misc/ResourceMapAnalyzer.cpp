@@ -15,14 +15,18 @@ using std::fclose;
 #include "Sim/Units/Unit.h"
 #include "Sim/Units/UnitHandler.h"
 #include "Game/GameHelper.h"
-#include "Game/GameSetup.h"
 #include "Map/MapInfo.h"
 #include "Map/MetalMap.h"
+#include "Map/ReadMap.h"
 #include "System/FileSystem/DataDirsAccess.h"
 #include "System/FileSystem/FileQueryFlags.h"
 #include "System/FileSystem/FileSystem.h"
 #include "System/Log/ILog.h"
+#include "System/SpringHash.h"
+#include "System/StringUtil.h"
+#include "System/Threading/ThreadPool.h"
 
+#include <algorithm>
 #include <stdexcept>
 
 #include "System/Misc/TracyDefs.h"
@@ -54,8 +58,9 @@ CResourceMapAnalyzer::CResourceMapAnalyzer(int resourceId)
 	, xtractorRadius(0)
 	, doubleRadius(0)
 {
+	// shared with the derived heightmap data (CReadMap::GetDerivedMapsCacheFileName)
 	if (CACHE_BASE.empty())
-		CACHE_BASE = dataDirsAccess.LocateDir(FileSystem::GetCacheDir() + FileSystemAbstraction::GetNativePathSeparator() + "analyzedResourceMaps" + FileSystemAbstraction::GetNativePathSeparator(), FileQueryFlags::WRITE | FileQueryFlags::CREATE_DIRS);
+		CACHE_BASE = dataDirsAccess.LocateDir(FileSystem::GetCacheDir() + FileSystemAbstraction::GetNativePathSeparator() + "derivedMaps" + FileSystemAbstraction::GetNativePathSeparator(), FileQueryFlags::WRITE | FileQueryFlags::CREATE_DIRS);
 }
 
 
@@ -177,79 +182,48 @@ void CResourceMapAnalyzer::GetResourcePoints() {
 		return;
 
 	// Now work out how much resources each spot can make
-	// by adding up the resources from nearby spots
-	for (int y = 0; y < mapHeight; y++) {
-		for (int x = 0; x < mapWidth; x++) {
-			totalResources = 0;
-
-			// first spot needs full calculation
-			if (x == 0 && y == 0)
-				for (int sy = y - xtractorRadius, a = 0;  sy <= y + xtractorRadius;  sy++, a++) {
-					if (sy >= 0 && sy < mapHeight){
-						for (int sx = x - xend[a]; sx <= x + xend[a]; sx++) {
-							if (sx >= 0 && sx < mapWidth) {
-								// get the resources from all pixels around the extractor radius
-								totalResources += rexArrayA[sy * mapWidth + sx];
-							}
-						}
-					}
-				}
-
-			// quick calc test
-			if (x > 0) {
-				totalResources = tempAverage[y * mapWidth + x - 1];
-				for (int sy = y - xtractorRadius, a = 0;  sy <= y + xtractorRadius;  sy++, a++) {
-					if (sy >= 0 && sy < mapHeight) {
-						const int addX = x + xend[a];
-						const int remX = x - xend[a] - 1;
-
-						if (addX < mapWidth) {
-							totalResources += rexArrayA[sy * mapWidth + addX];
-						}
-						if (remX >= 0) {
-							totalResources -= rexArrayA[sy * mapWidth + remX];
-						}
-					}
-				}
-			} else if (y > 0) {
-				// x == 0 here
-				totalResources = tempAverage[(y - 1) * mapWidth];
-				// remove the top half
-				int a = xtractorRadius;
-
-				for (int sx = 0; sx <= xtractorRadius;  sx++, a++) {
+	// by adding up the resources from nearby spots; rows are
+	// independent, each starts with a full sum at x == 0 and
+	// slides the extractor disc along x from there
+	for_mt(0, mapHeight, [&](const int y) {
+		int rowResources = 0;
+
+		for (int sy = y - xtractorRadius, a = 0;  sy <= y + xtractorRadius;  sy++, a++) {
+			if (sy >= 0 && sy < mapHeight) {
+				for (int sx = 0; sx <= xend[a]; sx++) {
 					if (sx < mapWidth) {
-						const int remY = y - xend[a] - 1;
-
-						if (remY >= 0) {
-							totalResources -= rexArrayA[remY * mapWidth + sx];
-						}
+						// get the resources from all pixels around the extractor radius
+						rowResources += rexArrayA[sy * mapWidth + sx];
 					}
 				}
+			}
+		}
 
-				// add the bottom half
-				a = xtractorRadius;
+		tempAverage[y * mapWidth] = rowResources;
 
-				for (int sx = 0; sx <= xtractorRadius;  sx++, a++) {
-					if (sx < mapWidth) {
-						const int addY = y + xend[a];
+		for (int x = 1; x < mapWidth; x++) {
+			for (int sy = y - xtractorRadius, a = 0;  sy <= y + xtractorRadius;  sy++, a++) {
+				if (sy >= 0 && sy < mapHeight) {
+					const int addX = x + xend[a];
+					const int remX = x - xend[a] - 1;
 
-						if (addY < mapHeight) {
-							totalResources += rexArrayA[addY * mapWidth + sx];
-						}
+					if (addX < mapWidth) {
+						rowResources += rexArrayA[sy * mapWidth + addX];
+					}
+					if (remX >= 0) {
+						rowResources -= rexArrayA[sy * mapWidth + remX];
 					}
 				}
 			}
 
 			// set that spot's resource making ability
-			// (divide by cells to values are small)
-			tempAverage[y * mapWidth + x] = totalResources;
-
-			if (maxResource < totalResources) {
-				// find the spot with the highest resource value to set as the map's max
-				maxResource = totalResources;
-			}
+			tempAverage[y * mapWidth + x] = rowResources;
 		}
+	});
+
+	// find the spot with the highest resource value to set as the map's max
+	for (int i = 0; i < totalCells; i++) {
+		maxResource = std::max(maxResource, tempAverage[i]);
 	}
 
 	// make a list for the distribution of values
@@ -577,7 +551,12 @@ std::string CResourceMapAnalyzer::GetCacheFileName() const {
 	RECOIL_DETAILED_TRACY_ZONE;
 
 	const CResourceDescription* resource = resourceHandler->GetResource(resourceId);
-	std::string absFile = CACHE_BASE + gameSetup->mapName + resource->name;
+	const unsigned char* resourceMapArray = resourceHandler->GetResourceMap(resourceId);
+
+	// the spots only depend on the resource map and the extractor radius,
+	// Lua may have changed the former since the map was loaded
+	uint32_t inputHash = spring::LiteHash(extractorRadius, readMap->GetMapChecksum());
+	inputHash = spring::LiteHash(resourceMapArray, totalCells, inputHash);
 
-	return absFile;
+	return (CACHE_BASE + IntToString(readMap->GetMapChecksum(), "%08x") + "_" + resource->name + "_" + IntToString(inputHash, "%08x") + ".spots");
 }
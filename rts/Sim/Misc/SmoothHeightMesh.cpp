@@ -199,6 +199,48 @@ inline static void FindMaximumColumnHeights(
 }
 
 
+// windows wider than this are cheaper to slide with a monotone deque than to rescan
+static constexpr int RADIAL_MAXIMUM_DEQUE_WINDOW = 32;
+
+inline static void FindRadialMaximumDeque(
+	const int2 map,
+	int y,
+	int minx,
+	int maxx,
+	int winSize,
+	const std::vector<float>& colsMaxima,
+	      std::vector<float>& mesh,
+	      std::vector<int>& window
+) {
+	RECOIL_DETAILED_TRACY_ZONE;
+	// indices in [head, size) hold strictly decreasing column maxima, front is the window maximum
+	size_t head = 0;
+	int nextx = std::max(minx - winSize, 0);
+
+	window.clear();
+
+	for (int x = minx; x <= maxx; ++x) {
+		const int startx = std::max(x - winSize, 0);
+		const int endx = std::min(x + winSize, map.x - 1);
+
+		for (; nextx <= endx; ++nextx) {
+			while (window.size() > head && colsMaxima[window.back()] <= colsMaxima[nextx])
+				window.pop_back();
+
+			window.push_back(nextx);
+		}
+
+		while (window[head] < startx)
+			++head;
+
+		mesh[x + y * map.x] = colsMaxima[window[head]];
+
+#ifdef SMOOTH_MESH_DEBUG_MAXIMA
+		LOG("%s: y:%d x:%d local max: %f", __func__, y, x, mesh[x + y * map.x]);
+#endif
+	}
+}
+
 inline static void FindRadialMaximum(
 	const int2 map,
 	int y,
@@ -207,9 +249,15 @@ inline static void FindRadialMaximum(
 	int winSize,
 	float resolution,
 	const std::vector<float>& colsMaxima,
-	      std::vector<float>& mesh
+	      std::vector<float>& mesh,
+	      std::vector<int>& window
 ) {
 	RECOIL_DETAILED_TRACY_ZONE;
+	if ((winSize * 2 + 1) > RADIAL_MAXIMUM_DEQUE_WINDOW) {
+		FindRadialMaximumDeque(map, y, minx, maxx, winSize, colsMaxima, mesh, window);
+		return;
+	}
+
 	for (int x = minx; x <= maxx; ++x) {
 		float maxRowHeight = -std::numeric_limits<float>::max();
 
@@ -547,7 +595,7 @@ LOG("%s: quad area in world space (%f,%f) (%f,%f)", __func__
 	FindMaximumColumnHeights(map, damageMin.y, min.x, max.x, winSize, resolution, colsMaxima, maximaRows);
 
 	for (int y = damageMin.y; y <= damageMax.y; ++y) {
-		FindRadialMaximum(map, y, damageMin.x, damageMax.x, winSize, resolution, colsMaxima, maximaMesh);
+		FindRadialMaximum(map, y, damageMin.x, damageMax.x, winSize, resolution, colsMaxima, maximaMesh, maximaWindow);
 		AdvanceMaximas(map, y+1, min.x, max.x, winSize, resolution, colsMaxima, maximaRows);
 	}
 }
@@ -631,19 +679,37 @@ void SmoothHeightMesh::MakeSmoothMesh() {
 	int2 max{maxx-1, maxy-1};
 	int2 map{maxx, maxy};
 
- 	FindMaximumColumnHeights(map, 0, 0, max.x, winSize, resolution, colsMaxima, maximaRows);
+	// the sliding column maxima only depend on the heightmap, so every stripe
+	// of rows can be swept independently from its own starting window; rows
+	// of the blur passes are independent as well (columns for the vertical)
+	const int numStripes = std::clamp(ThreadPool::GetNumThreads(), 1, map.y);
+
+	for_mt(0, numStripes, [&](const int stripe) {
+		const int stripeMinY = (map.y * (stripe    )) / numStripes;
+		const int stripeMaxY = (map.y * (stripe + 1)) / numStripes - 1;
+
+		std::vector<float> stripeColsMaxima(map.x, -std::numeric_limits<float>::max());
+		std::vector<int> stripeMaximaRows(map.x, -1);
+		std::vector<int> stripeWindow;
 
-	for (int y = 0; y <= max.y; ++y) {
-		FindRadialMaximum(map, y, 0, max.x, winSize, resolution, colsMaxima, maximaMesh);
-		AdvanceMaximas(map, y+1, 0, max.x, winSize, resolution, colsMaxima, maximaRows);
+		FindMaximumColumnHeights(map, stripeMinY, 0, max.x, winSize, resolution, stripeColsMaxima, stripeMaximaRows);
+
+		for (int y = stripeMinY; y <= stripeMaxY; ++y) {
+			FindRadialMaximum(map, y, 0, max.x, winSize, resolution, stripeColsMaxima, maximaMesh, stripeWindow);
+			AdvanceMaximas(map, y+1, 0, max.x, winSize, resolution, stripeColsMaxima, stripeMaximaRows);
 
 #ifdef _DEBUG
-		CheckInvariants(y, max.x, max.y, winSize, resolution, colsMaxima, maximaRows);
+			CheckInvariants(y, max.x, max.y, winSize, resolution, stripeColsMaxima, stripeMaximaRows);
 #endif
-	}
-
-	BlurHorizontal(map, min, max, blurSize, resolution, maximaMesh, tempMesh);
-	BlurVertical(map, min, max, blurSize, resolution, tempMesh, mesh);
+		}
+	});
+
+	for_mt_chunk(min.y, max.y + 1, [&](const int y) {
+		BlurHorizontal(map, {min.x, y}, {max.x, y}, blurSize, resolution, maximaMesh, tempMesh);
+	});
+	for_mt_chunk(min.x, max.x + 1, [&](const int x) {
+		BlurVertical(map, {x, min.y}, {x, max.y}, blurSize, resolution, tempMesh, mesh);
+	});
 
 	// <mesh> now contains the final smoothed heightmap, save it in origMesh
 	std::copy(mesh.begin(), mesh.end(), origMesh.begin());
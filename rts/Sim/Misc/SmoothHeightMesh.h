@@ -83,6 +83,7 @@ private:
 
 	std::vector<float> colsMaxima;
 	std::vector<int> maximaRows;
+	std::vector<int> maximaWindow;
 
 	MapChangeTrack mapChangeTrack;
 };
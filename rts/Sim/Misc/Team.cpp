@@ -13,6 +13,7 @@
 #include "Net/Protocol/NetProtocol.h"
 #include "Sim/Units/Unit.h"
 #include "Sim/Units/UnitDef.h"
+#include "Sim/Units/UnitDefHandler.h"
 #include "Sim/Units/UnitHandler.h"
 #include "System/ContainerUtil.h"
 #include "System/EventHandler.h"
@@ -52,7 +53,8 @@ CR_REG_METADATA(CTeam, (
 	CR_MEMBER(nextHistoryEntry),
 	CR_MEMBER(statHistory),
 	CR_MEMBER(modParams),
-	CR_IGNORED(highlight)
+	CR_IGNORED(highlight),
+	CR_IGNORED(unitDefEconomy) // rebuilt by SlowUpdate
 ))
 
 
@@ -406,6 +408,32 @@ void CTeam::SlowUpdate()
 		nextHistoryEntry = gs->frameNum + (TeamStatistics::statsPeriod * GAME_SPEED);
 		GetCurrentStats().frame = nextHistoryEntry;
 	}
+
+	UpdateUnitDefEconomy();
+}
+
+void CTeam::UpdateUnitDefEconomy()
+{
+	RECOIL_DETAILED_TRACY_ZONE;
+	unitDefEconomy.clear();
+
+	// per-def unit lists are kept in synced order, so every client
+	// sums in the same order and gets bit-identical results
+	for (int unitDefID = 1, numUnitDefs = unitDefHandler->NumUnitDefs(); unitDefID <= numUnitDefs; unitDefID++) {
+		const std::vector<CUnit*>& defUnits = unitHandler.GetUnitsByTeamAndDef(teamNum, unitDefID);
+
+		if (defUnits.empty())
+			continue;
+
+		UnitDefEconomy& defEconomy = unitDefEconomy.emplace_back();
+		defEconomy.unitDefID = unitDefID;
+		defEconomy.numUnits = defUnits.size();
+
+		for (const CUnit* unit: defUnits) {
+			defEconomy.make += unit->resourcesMake;
+			defEconomy.use += unit->resourcesUse;
+		}
+	}
 }
 
 
@@ -53,6 +53,17 @@ public:
 	const TeamStatistics& GetCurrentStats() const { return statHistory.back(); }
 	      TeamStatistics& GetCurrentStats()       { return statHistory.back(); }
 
+	struct UnitDefEconomy {
+		int unitDefID = 0;
+		int numUnits = 0;
+
+		// sums of the units' resourcesMake and resourcesUse
+		SResourcePack make;
+		SResourcePack use;
+	};
+
+	const std::vector<UnitDefEconomy>& GetUnitDefEconomy() const { return unitDefEconomy; }
+
 	CTeam& operator = (const TeamBase& base) {
 		TeamBase::operator = (base);
 		return *this;
@@ -73,6 +84,9 @@ public:
 	void AddUnit(CUnit* unit, AddType type);
 	void RemoveUnit(CUnit* unit, RemoveType type);
 
+private:
+	void UpdateUnitDefEconomy();
+
 public:
 	int teamNum;
 	unsigned int numUnits; // number of units this team controls
@@ -101,6 +115,10 @@ public:
 
 	/// unsynced
 	float highlight;
+
+private:
+	/// per-unitdef breakdown as of the last SlowUpdate, only defs with units
+	std::vector<UnitDefEconomy> unitDefEconomy;
 };
 
 #endif /* TEAM_H */
@@ -8,6 +8,7 @@
 #include "Map/MapInfo.h"
 #include "Rendering/Env/Particles/Classes/SmokeProjectile.h"
 #include "Sim/Ecs/Registry.h"
+#include "Sim/Misc/GlobalSynced.h"
 #include "Sim/Misc/QuadField.h"
 #include "Sim/Misc/SmoothHeightMesh.h"
 #include "Sim/Projectiles/ExplosionGenerator.h"
@@ -47,6 +48,9 @@ CR_REG_METADATA(AAirMoveType, (
 
 	CR_MEMBER(lastCollidee),
 
+	CR_IGNORED(collisionScan),
+	CR_IGNORED(collisionScanFrame),
+
 	CR_MEMBER(crashExpGenID)
 ))
 
@@ -113,7 +117,19 @@ AAirMoveType::AAirMoveType(CUnit* unit): AMoveType(unit)
 		crashExpGenID = ud->GetCrashExpGenID(crashExpGenID);
 	}
 
+	Connect();
+}
+
+void AAirMoveType::Connect() {
+	RECOIL_DETAILED_TRACY_ZONE;
 	Sim::registry.emplace_or_replace<GeneralMoveType>(owner->entityReference, owner->id);
+	Sim::registry.emplace_or_replace<AirMoveType>(owner->entityReference, owner->id);
+}
+
+void AAirMoveType::Disconnect() {
+	RECOIL_DETAILED_TRACY_ZONE;
+	Sim::registry.remove<GeneralMoveType>(owner->entityReference);
+	Sim::registry.remove<AirMoveType>(owner->entityReference);
 }
 
 
@@ -236,26 +252,26 @@ void AAirMoveType::UpdateLanding()
 }
 
 
-void AAirMoveType::CheckForCollision()
+void AAirMoveType::PrefetchCollisionScan(int threadOwner)
 {
 	RECOIL_DETAILED_TRACY_ZONE;
-	if (!collide)
-		return;
+	collisionScan = ScanForCollision(threadOwner);
+	collisionScanFrame = gs->frameNum;
+}
 
+AAirMoveType::CollisionScan AAirMoveType::ScanForCollision(int threadOwner) const
+{
+	RECOIL_DETAILED_TRACY_ZONE;
 	const SyncedFloat3& pos = owner->midPos;
 	const SyncedFloat3& forward = owner->frontdir;
 
 	float dist = 200.0f;
 
 	QuadFieldQuery qfQuery;
+	qfQuery.threadOwner = threadOwner;
 	quadField.GetUnitsExact(qfQuery, pos + forward * 121.0f, dist);
 
-	if (lastCollidee != nullptr) {
-		DeleteDeathDependence(lastCollidee, DEPENDENCE_LASTCOLWARN);
-
-		lastCollidee = nullptr;
-		collisionState = COLLISION_NOUNIT;
-	}
+	CollisionScan scan;
 
 	// find closest potential collidee
 	for (CUnit* unit: *qfQuery.units) {
@@ -276,14 +292,13 @@ void AAirMoveType::CheckForCollision()
 
 		if (ortoDif.SqLength() < (minOrtoDif * minOrtoDif)) {
 			dist = frontLength;
-			lastCollidee = const_cast<CUnit*>(unit);
+			scan.collidee = unit;
 		}
 	}
 
-	if (lastCollidee != nullptr) {
-		collisionState = COLLISION_DIRECT;
-		AddDeathDependence(lastCollidee, DEPENDENCE_LASTCOLWARN);
-		return;
+	if (scan.collidee != nullptr) {
+		scan.state = COLLISION_DIRECT;
+		return scan;
 	}
 
 	for (CUnit* u: *qfQuery.units) {
@@ -293,12 +308,38 @@ void AAirMoveType::CheckForCollision()
 		if ((u->midPos - pos).SqLength() > Square((owner->radius + u->radius) * 2.0f))
 			continue;
 
-		lastCollidee = u;
+		scan.collidee = u;
 	}
 
-	if (lastCollidee != nullptr) {
-		collisionState = COLLISION_NEARBY;
-		AddDeathDependence(lastCollidee, DEPENDENCE_LASTCOLWARN);
+	if (scan.collidee != nullptr)
+		scan.state = COLLISION_NEARBY;
+
+	return scan;
+}
+
+void AAirMoveType::CheckForCollision()
+{
+	RECOIL_DETAILED_TRACY_ZONE;
+	if (!collide)
 		return;
+
+	// a prefetched scan saw the units where they were before this frame's
+	// serial update; without one, scan the current positions
+	const CollisionScan scan = (collisionScanFrame == gs->frameNum)? collisionScan: ScanForCollision(0);
+
+	collisionScanFrame = -1;
+
+	if (lastCollidee != nullptr) {
+		DeleteDeathDependence(lastCollidee, DEPENDENCE_LASTCOLWARN);
+
+		lastCollidee = nullptr;
+		collisionState = COLLISION_NOUNIT;
 	}
+
+	if (scan.collidee == nullptr)
+		return;
+
+	lastCollidee = scan.collidee;
+	collisionState = scan.state;
+	AddDeathDependence(lastCollidee, DEPENDENCE_LASTCOLWARN);
 }
@@ -58,9 +58,21 @@ public:
 	bool CanApplyImpulse(const float3&) { return true; }
 	bool UseSmoothMesh() const;
 
+	void Connect() override;
+	void Disconnect() override;
+
 	void DependentDied(CObject* o);
 
+	/// run by AirMoveSystem ahead of the serial update, see CheckForCollision
+	void PrefetchCollisionScan(int threadOwner);
+
 protected:
+	struct CollisionScan {
+		CUnit* collidee = nullptr;
+		CollisionState state = COLLISION_NOUNIT;
+	};
+
+	CollisionScan ScanForCollision(int threadOwner) const;
 	void CheckForCollision();
 
 public:
@@ -93,6 +105,10 @@ protected:
 	/// unit found to be dangerously close to our path
 	CUnit* lastCollidee = nullptr;
 
+	/// result of PrefetchCollisionScan, only valid during collisionScanFrame
+	CollisionScan collisionScan;
+	int collisionScanFrame = -1;
+
 	unsigned int crashExpGenID = -1u;
 };
 
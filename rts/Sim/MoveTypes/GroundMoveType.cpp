@@ -1193,6 +1193,15 @@ bool CGroundMoveType::FollowPath(int thread)
 		// do not compare y-components since these usually differ and only x&z matter
 		SetWaypointDir(cwp, opos);
 
+		// large groups steer along their flow field, as long as it agrees with the path
+		// well enough not to lead away from the current waypoint
+		if (modInfo.qtFlowFieldMinGroupSize > 0 && !atEndOfPath) {
+			float3 flowDir;
+
+			if (pathManager->GetFlowFieldDirection(pathID, opos, flowDir) && flowDir.dot(waypointDir) > 0.0f)
+				waypointDir = flowDir;
+		}
+
 		//ASSERT_SYNCED(waypointVec);
 		//ASSERT_SYNCED(waypointDir);
 
@@ -1865,9 +1874,9 @@ float3 CGroundMoveType::GetObstacleAvoidanceDir(const float3& desiredDir) {
 
 	for (const CSolidObject* avoidee: *qfQuery.solids) {
 		const MoveDef* avoideeMD = avoidee->moveDef;
-		const UnitDef* avoideeUD = dynamic_cast<const UnitDef*>(avoidee->GetDef());
 
 		// cases in which there is no need to avoid this obstacle
+		// (cheapest tests first; none of them have side-effects)
 		if (avoidee == owner)
 			continue;
 		// do not avoid statics (it interferes too much with PFS)
@@ -1876,13 +1885,8 @@ float3 CGroundMoveType::GetObstacleAvoidanceDir(const float3& desiredDir) {
 		// ignore aircraft (or flying ground units)
 		if (avoidee->IsInAir() || avoidee->IsFlying())
 			continue;
-		if (CMoveMath::IsNonBlocking(avoidee, &avoiderInfo))
-			continue;
-		if (!CMoveMath::CrushResistant(*avoiderMD, avoidee))
-			continue;
 
 		const bool avoideeMobile  = (avoideeMD != nullptr);
-		const bool avoideeMovable = (avoideeUD != nullptr && !static_cast<const CUnit*>(avoidee)->moveType->IsPushResistant());
 
 		const float3 avoideeVector = (avoider->pos + avoider->speed) - (avoidee->pos + avoidee->speed);
 
@@ -1892,17 +1896,14 @@ float3 CGroundMoveType::GetObstacleAvoidanceDir(const float3& desiredDir) {
 			avoideeMD->CalcFootPrintMinExteriorRadius():
 			avoidee->CalcFootPrintMinExteriorRadius();
 		const float avoidanceRadiusSum = avoiderRadius + avoideeRadius;
-		const float avoidanceMassSum = avoider->mass + avoidee->mass;
-		const float avoideeMassScale = avoideeMobile? (avoidee->mass / avoidanceMassSum): 1.0f;
 		const float avoideeDistSq = avoideeVector.SqLength();
-		const float avoideeDist   = math::sqrt(avoideeDistSq) + 0.01f;
 
-		// do not bother steering around idling MOBILE objects
-		// (since collision handling will just push them aside)
-		if (avoideeMobile && avoideeMovable) {
-			if (!avoiderMD->avoidMobilesOnPath || (!avoidee->IsMoving() && avoidee->allyteam == avoider->allyteam))
-				continue;
-		}
+		if (avoideeDistSq >= Square(std::max(currentSpeed, 1.0f) * GAME_SPEED + avoidanceRadiusSum))
+			continue;
+		if (avoideeDistSq >= avoider->pos.SqDistance2D(goalPos))
+			continue;
+
+		const float avoideeDist   = math::sqrt(avoideeDistSq) + 0.01f;
 
 		// ignore objects that are more than this many degrees off-center from us
 		// NOTE:
@@ -1913,11 +1914,24 @@ float3 CGroundMoveType::GetObstacleAvoidanceDir(const float3& desiredDir) {
 		if (avoider->frontdir.dot(-(avoideeVector / avoideeDist)) < MAX_AVOIDEE_COSINE)
 			continue;
 
-		if (avoideeDistSq >= Square(std::max(currentSpeed, 1.0f) * GAME_SPEED + avoidanceRadiusSum))
+		if (CMoveMath::IsNonBlocking(avoidee, &avoiderInfo))
 			continue;
-		if (avoideeDistSq >= avoider->pos.SqDistance2D(goalPos))
+		if (!CMoveMath::CrushResistant(*avoiderMD, avoidee))
 			continue;
 
+		const UnitDef* avoideeUD = dynamic_cast<const UnitDef*>(avoidee->GetDef());
+		const bool avoideeMovable = (avoideeUD != nullptr && !static_cast<const CUnit*>(avoidee)->moveType->IsPushResistant());
+
+		const float avoidanceMassSum = avoider->mass + avoidee->mass;
+		const float avoideeMassScale = avoideeMobile? (avoidee->mass / avoidanceMassSum): 1.0f;
+
+		// do not bother steering around idling MOBILE objects
+		// (since collision handling will just push them aside)
+		if (avoideeMobile && avoideeMovable) {
+			if (!avoiderMD->avoidMobilesOnPath || (!avoidee->IsMoving() && avoidee->allyteam == avoider->allyteam))
+				continue;
+		}
+
 		// if object and unit in relative motion are closing in on one another
 		// (or not yet fully apart), then the object is on the path of the unit
 		// and they are not collided
@@ -2636,6 +2650,7 @@ bool CGroundMoveType::HandleStaticObjectCollision(
 		}
 
 		MoveTypes::CheckCollisionQuery colliderInfo(owner);
+		const CMoveMath::PosSpeedModFunc getPosSpeedMod = CMoveMath::GetPosSpeedModFunc(*colliderMD);
 
 		// check for blocked squares inside collider's MoveDef footprint zone
 		// interpret each square as a "collidee" and sum up separation vectors
@@ -2656,7 +2671,7 @@ bool CGroundMoveType::HandleStaticObjectCollision(
 				const int xabs = xmid + x;
 				const int zabs = zmid + z;
 
-				if ( checkTerrain &&  (CMoveMath::GetPosSpeedMod(*colliderMD, xabs, zabs) > 0.f))
+				if ( checkTerrain &&  (getPosSpeedMod(*colliderMD, xabs, zabs) > 0.f))
 					continue;
 				if ( checkYardMap && ((CMoveMath::SquareIsBlocked(*colliderMD, xabs, zabs, &colliderInfo) & CMoveMath::BLOCK_STRUCTURE) == 0))
 					continue;
@@ -2806,6 +2821,18 @@ void CGroundMoveType::HandleUnitCollisions(
 		if (unloadingCollider)
 			collider->requestRemoveUnloadTransportId = true;
 
+		const float collDist = (collideeMobile) ? collideeMD->CalcFootPrintMaxInteriorRadius() : collidee->CalcFootPrintMaxInteriorRadius();
+
+		// both the collision and the separation test below fail beyond this (2D)
+		// distance, so reject such neighbours before the costlier blocking tests
+		{
+			const float maxSeparationDist = std::max(colliderSeparationDist, collideeUD->separationDistance);
+			const float maxInteractionDist = colliderParams.y + collDist + std::max(maxSeparationDist, 0.0f);
+
+			if ((collider->pos.SqDistance2D(collidee->pos) - Square(maxInteractionDist)) > 0.01f)
+				continue;
+		}
+
 		// don't push/crush either party if the collidee does not block the collider (or vv.)
 		if (colliderMobile && CMoveMath::IsNonBlocking(collidee, &colliderInfo))
 			continue;
@@ -2821,7 +2848,6 @@ void CGroundMoveType::HandleUnitCollisions(
 		if (collider->loadingTransportId == collidee->id) continue;
 		if (collidee->loadingTransportId == collider->id) continue;
 
-		const float collDist = (collideeMobile) ? collideeMD->CalcFootPrintMaxInteriorRadius() : collidee->CalcFootPrintMaxInteriorRadius();
 		const float2 collideeParams = {collidee->speed.w, collDist};
 		const float4 separationVect = {collider->pos - collidee->pos, Square(colliderParams.y + collideeParams.y)};
 
@@ -498,13 +498,19 @@ bool MoveDef::DoRawSearch(
 	float minSpeedMod = std::numeric_limits<float>::max();
 	int   maxBlockBit = CMoveMath::BLOCK_NONE;
 
-	std::function<float(int x, int z)> getPosSpeedMod;
-	if (md->allowDirectionalPathing) {
-		float3 testMoveDir = startPos - endPos;
-		getPosSpeedMod = [this, testMoveDir](int x, int z){ return CMoveMath::GetPosSpeedMod(*this, x, z, testMoveDir); };
-	} else {
-		getPosSpeedMod = [&](int x, int z){ return CMoveMath::GetPosSpeedMod(*this, x, z); };
-	}
+	// speed-mod class dispatch happens once, not per square
+	const CMoveMath::PosSpeedModFunc posSpeedModFunc = CMoveMath::GetPosSpeedModFunc(*this);
+	const CMoveMath::DirPosSpeedModFunc dirPosSpeedModFunc = CMoveMath::GetDirPosSpeedModFunc(*this);
+
+	const bool directional = md->allowDirectionalPathing;
+	const float3 testMoveDir = startPos - endPos;
+
+	const auto getPosSpeedMod = [&](int x, int z) {
+		if (directional)
+			return (dirPosSpeedModFunc(*this, x, z, testMoveDir));
+
+		return (posSpeedModFunc(*this, x, z));
+	};
 
 	auto terrainTest = [this, &minSpeedMod, speedModThreshold, &getPosSpeedMod](int x, int z) -> bool {
 		if (x >= mapDims.mapx || x < 0 || z >= mapDims.mapy || z < 0) { return true; }
@@ -637,12 +643,17 @@ bool MoveDef::TestMoveSquareRange(
 	bool retTestMove = true;
 
 	if (testTerrain) {
-		std::function<float(int x, int z)> getPosSpeedMod;
-		if (collider.moveDef->allowDirectionalPathing) {
-			getPosSpeedMod = [&](int x, int z){ return CMoveMath::GetPosSpeedMod(*this, x, z, testMoveDir); };
-		} else {
-			getPosSpeedMod = [&](int x, int z){ return CMoveMath::GetPosSpeedMod(*this, x, z); };
-		}
+		const CMoveMath::PosSpeedModFunc posSpeedModFunc = CMoveMath::GetPosSpeedModFunc(*this);
+		const CMoveMath::DirPosSpeedModFunc dirPosSpeedModFunc = CMoveMath::GetDirPosSpeedModFunc(*this);
+
+		const bool directional = collider.moveDef->allowDirectionalPathing;
+
+		const auto getPosSpeedMod = [&](int x, int z) {
+			if (directional)
+				return (dirPosSpeedModFunc(*this, x, z, testMoveDir));
+
+			return (posSpeedModFunc(*this, x, z));
+		};
 
 		for (int z = zmin; retTestMove && z <= zmax; ++z) {
 			for (int x = xmin; retTestMove && x <= xmax; ++x) {
@@ -6,6 +6,28 @@
 
 #include "System/Misc/TracyDefs.h"
 
+#include "xsimd/xsimd.hpp"
+
+using FloatBatch = xsimd::simd_type<float>;
+
+// mirrors MoveDef::GetDepthMod, including its evaluation order
+static FloatBatch GetDepthMods(const MoveDef& moveDef, const FloatBatch& height)
+{
+	const float* params = &moveDef.depthModParams[0];
+
+	const FloatBatch a = FloatBatch(params[MoveDef::DEPTHMOD_QUA_COEFF]);
+	const FloatBatch b = FloatBatch(params[MoveDef::DEPTHMOD_LIN_COEFF]);
+	const FloatBatch c = FloatBatch(params[MoveDef::DEPTHMOD_CON_COEFF]);
+
+	const FloatBatch depth = -height;
+	const FloatBatch scale = xsimd::min(xsimd::max(a * depth * depth + b * depth + c, FloatBatch(0.01f)), FloatBatch(params[MoveDef::DEPTHMOD_MAX_SCALE]));
+
+	FloatBatch depthMod = FloatBatch(1.0f) / scale;
+	depthMod = xsimd::select(height < FloatBatch(-params[MoveDef::DEPTHMOD_MAX_HEIGHT]), FloatBatch(0.0f), depthMod);
+	depthMod = xsimd::select(height > FloatBatch(-params[MoveDef::DEPTHMOD_MIN_HEIGHT]), FloatBatch(1.0f), depthMod);
+	return depthMod;
+}
+
 /*
 Calculate speed-multiplier for given height and slope data.
 */
@@ -28,6 +50,25 @@ float CMoveMath::GroundSpeedMod(const MoveDef& moveDef, float height, float slop
 	return speedMod;
 }
 
+void CMoveMath::GroundSpeedMods(const MoveDef& moveDef, const float* heights, const float* slopes, float* speedMods, size_t count)
+{
+	RECOIL_DETAILED_TRACY_ZONE;
+	assert((count % FloatBatch::size) == 0);
+
+	for (size_t i = 0; i < count; i += FloatBatch::size) {
+		const FloatBatch height = xsimd::load_aligned(&heights[i]);
+		const FloatBatch slope = xsimd::load_aligned(&slopes[i]);
+
+		const auto blocked = (slope > FloatBatch(moveDef.maxSlope)) | (-height > FloatBatch(moveDef.depth));
+
+		FloatBatch speedMod = FloatBatch(1.0f) / (FloatBatch(1.0f) + slope * FloatBatch(moveDef.slopeMod));
+		speedMod *= xsimd::select(height < FloatBatch(0.0f), FloatBatch(waterDamageCost), FloatBatch(1.0f));
+		speedMod *= GetDepthMods(moveDef, height);
+
+		xsimd::store_aligned(&speedMods[i], xsimd::select(blocked, FloatBatch(0.0f), speedMod));
+	}
+}
+
 float CMoveMath::GroundSpeedMod(const MoveDef& moveDef, float height, float slope, float dirSlopeMod)
 {
 	RECOIL_DETAILED_TRACY_ZONE;
@@ -6,6 +6,8 @@
 
 #include "System/Misc/TracyDefs.h"
 
+#include "xsimd/xsimd.hpp"
+
 /*
 Calculate speed-multiplier for given height and slope data.
 */
@@ -22,6 +24,26 @@ float CMoveMath::HoverSpeedMod(const MoveDef& moveDef, float height, float slope
 	return (1.0f / (1.0f + slope * moveDef.slopeMod));
 }
 
+void CMoveMath::HoverSpeedMods(const MoveDef& moveDef, const float* heights, const float* slopes, float* speedMods, size_t count)
+{
+	RECOIL_DETAILED_TRACY_ZONE;
+	using FloatBatch = xsimd::simd_type<float>;
+	assert((count % FloatBatch::size) == 0);
+
+	const FloatBatch waterSpeedMod = FloatBatch(1.0f * !noHoverWaterMove);
+
+	for (size_t i = 0; i < count; i += FloatBatch::size) {
+		const FloatBatch height = xsimd::load_aligned(&heights[i]);
+		const FloatBatch slope = xsimd::load_aligned(&slopes[i]);
+
+		FloatBatch speedMod = FloatBatch(1.0f) / (FloatBatch(1.0f) + slope * FloatBatch(moveDef.slopeMod));
+		speedMod = xsimd::select(slope > FloatBatch(moveDef.maxSlope), FloatBatch(0.0f), speedMod);
+		speedMod = xsimd::select(height < FloatBatch(0.0f), waterSpeedMod, speedMod);
+
+		xsimd::store_aligned(&speedMods[i], speedMod);
+	}
+}
+
 float CMoveMath::HoverSpeedMod(const MoveDef& moveDef, float height, float slope, float dirSlopeMod)
 {
 	RECOIL_DETAILED_TRACY_ZONE;
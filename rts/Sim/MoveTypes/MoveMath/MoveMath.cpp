@@ -12,9 +12,12 @@
 #include "Sim/Objects/SolidObject.h"
 #include "Sim/Units/Unit.h"
 #include "System/Platform/Threading.h"
+#include "System/SpringMath.h"
 
 #include "System/Misc/TracyDefs.h"
 
+#include "xsimd/xsimd.hpp"
+
 bool CMoveMath::noHoverWaterMove = false;
 float CMoveMath::waterDamageCost = 0.0f;
 
@@ -78,7 +81,8 @@ float CMoveMath::yLevel(const MoveDef& moveDef, const float3& pos)
 
 
 /* calculate the local speed-modifier for this MoveDef */
-float CMoveMath::GetPosSpeedMod(const MoveDef& moveDef, unsigned xSquare, unsigned zSquare)
+template<int speedModClass>
+float CMoveMath::GetPosSpeedModT(const MoveDef& moveDef, unsigned xSquare, unsigned zSquare)
 {
 	RECOIL_DETAILED_TRACY_ZONE;
 	if (xSquare >= mapDims.mapx || zSquare >= mapDims.mapy)
@@ -93,18 +97,120 @@ float CMoveMath::GetPosSpeedMod(const MoveDef& moveDef, unsigned xSquare, unsign
 
 	const CMapInfo::TerrainType& tt = mapInfo->terrainTypes[squareTerrType];
 
+	if constexpr (speedModClass == MoveDef::Tank)
+		return (GroundSpeedMod(moveDef, height, slope) * tt.tankSpeed );
+	if constexpr (speedModClass == MoveDef::KBot)
+		return (GroundSpeedMod(moveDef, height, slope) * tt.kbotSpeed );
+	if constexpr (speedModClass == MoveDef::Hover)
+		return ( HoverSpeedMod(moveDef, height, slope) * tt.hoverSpeed);
+	if constexpr (speedModClass == MoveDef::Ship)
+		return (  ShipSpeedMod(moveDef, height, slope) * tt.shipSpeed );
+
+	return 0.0f;
+}
+
+float CMoveMath::GetPosSpeedMod(const MoveDef& moveDef, unsigned xSquare, unsigned zSquare)
+{
 	switch (moveDef.speedModClass) {
-		case MoveDef::Tank:  { return (GroundSpeedMod(moveDef, height, slope) * tt.tankSpeed ); } break;
-		case MoveDef::KBot:  { return (GroundSpeedMod(moveDef, height, slope) * tt.kbotSpeed ); } break;
-		case MoveDef::Hover: { return ( HoverSpeedMod(moveDef, height, slope) * tt.hoverSpeed); } break;
-		case MoveDef::Ship:  { return (  ShipSpeedMod(moveDef, height, slope) * tt.shipSpeed ); } break;
+		case MoveDef::Tank:  { return (GetPosSpeedModT<MoveDef::Tank >(moveDef, xSquare, zSquare)); } break;
+		case MoveDef::KBot:  { return (GetPosSpeedModT<MoveDef::KBot >(moveDef, xSquare, zSquare)); } break;
+		case MoveDef::Hover: { return (GetPosSpeedModT<MoveDef::Hover>(moveDef, xSquare, zSquare)); } break;
+		case MoveDef::Ship:  { return (GetPosSpeedModT<MoveDef::Ship >(moveDef, xSquare, zSquare)); } break;
 		default: {} break;
 	}
 
 	return 0.0f;
 }
 
-float CMoveMath::GetPosSpeedMod(const MoveDef& moveDef, unsigned xSquare, unsigned zSquare, float3 moveDir)
+CMoveMath::PosSpeedModFunc CMoveMath::GetPosSpeedModFunc(const MoveDef& moveDef)
+{
+	switch (moveDef.speedModClass) {
+		case MoveDef::Tank:  { return (&GetPosSpeedModT<MoveDef::Tank >); } break;
+		case MoveDef::KBot:  { return (&GetPosSpeedModT<MoveDef::KBot >); } break;
+		case MoveDef::Hover: { return (&GetPosSpeedModT<MoveDef::Hover>); } break;
+		case MoveDef::Ship:  { return (&GetPosSpeedModT<MoveDef::Ship >); } break;
+		default: {} break;
+	}
+
+	return (&GetPosSpeedModT<-1>);
+}
+
+void CMoveMath::GetPosSpeedMods(const MoveDef& moveDef, const SRectangle& areaToSample, std::vector<float>& results)
+{
+	RECOIL_DETAILED_TRACY_ZONE;
+	using FloatBatch = xsimd::simd_type<float>;
+
+	static constexpr size_t CHUNK_SIZE = 64;
+	static_assert((CHUNK_SIZE % FloatBatch::size) == 0);
+
+	assert(areaToSample.x1 >= 0 && areaToSample.x2 <= mapDims.mapx);
+	assert(areaToSample.z1 >= 0 && areaToSample.z2 <= mapDims.mapy);
+
+	results.clear();
+	results.resize(areaToSample.GetArea(), 0.0f);
+
+	float CMapInfo::TerrainType::* terrainSpeed = nullptr;
+	void (*speedModsFunc)(const MoveDef&, const float*, const float*, float*, size_t) = nullptr;
+
+	switch (moveDef.speedModClass) {
+		case MoveDef::Tank:  { terrainSpeed = &CMapInfo::TerrainType::tankSpeed;  speedModsFunc = &GroundSpeedMods; } break;
+		case MoveDef::KBot:  { terrainSpeed = &CMapInfo::TerrainType::kbotSpeed;  speedModsFunc = &GroundSpeedMods; } break;
+		case MoveDef::Hover: { terrainSpeed = &CMapInfo::TerrainType::hoverSpeed; speedModsFunc = &HoverSpeedMods;  } break;
+		case MoveDef::Ship:  { terrainSpeed = &CMapInfo::TerrainType::shipSpeed;  speedModsFunc = &ShipSpeedMods;   } break;
+		default: { return; } break;
+	}
+
+	const float* heightMap = readMap->GetMaxHeightMapSynced();
+	const float* slopeMap = readMap->GetSlopeMapSynced();
+	const uint8_t* typeMap = readMap->GetTypeMapSynced();
+
+	alignas(64) std::array<float, CHUNK_SIZE> heights;
+	alignas(64) std::array<float, CHUNK_SIZE> slopes;
+	alignas(64) std::array<float, CHUNK_SIZE> ttSpeeds;
+	alignas(64) std::array<float, CHUNK_SIZE> speedMods;
+
+	const size_t width = areaToSample.GetWidth();
+
+	for (int z = areaToSample.z1; z < areaToSample.z2; ++z) {
+		const int zOffset = z * mapDims.mapx;
+		const int hzOffset = (z >> 1) * mapDims.hmapx;
+
+		float* rowResults = &results[(z - areaToSample.z1) * width];
+
+		for (size_t chunkBeg = 0; chunkBeg < width; chunkBeg += CHUNK_SIZE) {
+			const size_t chunkLen = std::min(width - chunkBeg, CHUNK_SIZE);
+			const size_t batchLen = AlignUp(chunkLen, FloatBatch::size);
+
+			for (size_t j = 0; j < chunkLen; j++) {
+				const int x = areaToSample.x1 + chunkBeg + j;
+				const int square = (x >> 1) + hzOffset;
+
+				heights[j] = heightMap[zOffset + x];
+				slopes[j] = slopeMap[square];
+				ttSpeeds[j] = mapInfo->terrainTypes[typeMap[square]].*terrainSpeed;
+			}
+			for (size_t j = chunkLen; j < batchLen; j++) {
+				heights[j] = 0.0f;
+				slopes[j] = 0.0f;
+				ttSpeeds[j] = 0.0f;
+			}
+
+			speedModsFunc(moveDef, heights.data(), slopes.data(), speedMods.data(), batchLen);
+
+			for (size_t j = 0; j < batchLen; j += FloatBatch::size) {
+				const FloatBatch speedMod = xsimd::load_aligned(&speedMods[j]);
+				const FloatBatch ttSpeed = xsimd::load_aligned(&ttSpeeds[j]);
+
+				xsimd::store_aligned(&speedMods[j], speedMod * ttSpeed);
+			}
+
+			std::copy(speedMods.begin(), speedMods.begin() + chunkLen, rowResults + chunkBeg);
+		}
+	}
+}
+
+template<int speedModClass>
+float CMoveMath::GetPosSpeedModT(const MoveDef& moveDef, unsigned xSquare, unsigned zSquare, float3 moveDir)
 {
 	RECOIL_DETAILED_TRACY_ZONE;
 	if (xSquare >= mapDims.mapx || zSquare >= mapDims.mapy)
@@ -130,17 +236,44 @@ float CMoveMath::GetPosSpeedMod(const MoveDef& moveDef, unsigned xSquare, unsign
 	// scale is negative for "downhill" slopes, positive for "uphill" ones
 	const float dirSlopeMod = -moveDir.dot(sqrNormal);
 
+	if constexpr (speedModClass == MoveDef::Tank)
+		return (GroundSpeedMod(moveDef, height, slope, dirSlopeMod) * tt.tankSpeed );
+	if constexpr (speedModClass == MoveDef::KBot)
+		return (GroundSpeedMod(moveDef, height, slope, dirSlopeMod) * tt.kbotSpeed );
+	if constexpr (speedModClass == MoveDef::Hover)
+		return ( HoverSpeedMod(moveDef, height, slope, dirSlopeMod) * tt.hoverSpeed);
+	if constexpr (speedModClass == MoveDef::Ship)
+		return (  ShipSpeedMod(moveDef, height, slope, dirSlopeMod) * tt.shipSpeed );
+
+	return 0.0f;
+}
+
+float CMoveMath::GetPosSpeedMod(const MoveDef& moveDef, unsigned xSquare, unsigned zSquare, float3 moveDir)
+{
 	switch (moveDef.speedModClass) {
-		case MoveDef::Tank:  { return (GroundSpeedMod(moveDef, height, slope, dirSlopeMod) * tt.tankSpeed ); } break;
-		case MoveDef::KBot:  { return (GroundSpeedMod(moveDef, height, slope, dirSlopeMod) * tt.kbotSpeed ); } break;
-		case MoveDef::Hover: { return ( HoverSpeedMod(moveDef, height, slope, dirSlopeMod) * tt.hoverSpeed); } break;
-		case MoveDef::Ship:  { return (  ShipSpeedMod(moveDef, height, slope, dirSlopeMod) * tt.shipSpeed ); } break;
+		case MoveDef::Tank:  { return (GetPosSpeedModT<MoveDef::Tank >(moveDef, xSquare, zSquare, moveDir)); } break;
+		case MoveDef::KBot:  { return (GetPosSpeedModT<MoveDef::KBot >(moveDef, xSquare, zSquare, moveDir)); } break;
+		case MoveDef::Hover: { return (GetPosSpeedModT<MoveDef::Hover>(moveDef, xSquare, zSquare, moveDir)); } break;
+		case MoveDef::Ship:  { return (GetPosSpeedModT<MoveDef::Ship >(moveDef, xSquare, zSquare, moveDir)); } break;
 		default: {} break;
 	}
 
 	return 0.0f;
 }
 
+CMoveMath::DirPosSpeedModFunc CMoveMath::GetDirPosSpeedModFunc(const MoveDef& moveDef)
+{
+	switch (moveDef.speedModClass) {
+		case MoveDef::Tank:  { return (&GetPosSpeedModT<MoveDef::Tank >); } break;
+		case MoveDef::KBot:  { return (&GetPosSpeedModT<MoveDef::KBot >); } break;
+		case MoveDef::Hover: { return (&GetPosSpeedModT<MoveDef::Hover>); } break;
+		case MoveDef::Ship:  { return (&GetPosSpeedModT<MoveDef::Ship >); } break;
+		default: {} break;
+	}
+
+	return (&GetPosSpeedModT<-1>);
+}
+
 /* Check if a given square-position is accessible by the MoveDef footprint. */
 CMoveMath::BlockType CMoveMath::IsBlockedNoSpeedModCheck(const MoveDef& moveDef, int xSquare, int zSquare, const CSolidObject* collider, int thread)
 {
@@ -185,6 +318,10 @@ CMoveMath::BlockType CMoveMath::IsBlockedNoSpeedModCheckDiff(const MoveDef& move
 			 		&& 	x <= prev_xmax && x >= prev_xmin)
 				continue;
 
+			// check the packed mask first, most squares are empty
+			if (groundBlockingObjectMap.GetCellMaskUnsafe(zOffset + x) == 0)
+				continue;
+
 			const CGroundBlockingObjectMap::BlockingMapCell& cell = groundBlockingObjectMap.GetCellUnsafeConst(zOffset + x);
 
 			for (size_t i = 0, n = cell.size(); i < n; i++) {
@@ -387,6 +524,9 @@ CMoveMath::BlockType CMoveMath::RangeIsBlockedSt(int xmin, int xmax, int zmin, i
 		const int zOffset = z * mapDims.mapx;
 
 		for (int x = xmin; x <= xmax; x += FOOTPRINT_XSTEP) {
+			if (groundBlockingObjectMap.GetCellMaskUnsafe(zOffset + x) == 0)
+				continue;
+
 			const CGroundBlockingObjectMap::BlockingMapCell& cell = groundBlockingObjectMap.GetCellUnsafeConst(zOffset + x);
 
 			for (size_t i = 0, n = cell.size(); i < n; i++) {
@@ -419,6 +559,9 @@ CMoveMath::BlockType CMoveMath::RangeIsBlockedMt(int xmin, int xmax, int zmin, i
 		const int zOffset = z * mapDims.mapx;
 
 		for (int x = xmin; x <= xmax; x += FOOTPRINT_XSTEP) {
+			if (groundBlockingObjectMap.GetCellMaskUnsafe(zOffset + x) == 0)
+				continue;
+
 			const CGroundBlockingObjectMap::BlockingMapCell& cell = groundBlockingObjectMap.GetCellUnsafeConst(zOffset + x);
 
 			for (size_t i = 0, n = cell.size(); i < n; i++) {
@@ -458,6 +601,9 @@ CMoveMath::BlockType CMoveMath::RangeIsBlockedHashedSt(int xmin, int xmax, int z
 		const int zOffset = z * mapDims.mapx;
 
 		for (int x = xmin; x <= xmax; x += FOOTPRINT_XSTEP) {
+			if (groundBlockingObjectMap.GetCellMaskUnsafe(zOffset + x) == 0)
+				continue;
+
 			const CGroundBlockingObjectMap::BlockingMapCell& cell = groundBlockingObjectMap.GetCellUnsafeConst(zOffset + x);
 
 			for (size_t i = 0, n = cell.size(); i < n; i++) {
@@ -512,6 +658,9 @@ CMoveMath::BlockType CMoveMath::RangeIsBlockedHashedMt(int xmin, int xmax, int z
 		const int zOffset = z * mapDims.mapx;
 
 		for (int x = xmin; x <= xmax; x += FOOTPRINT_XSTEP) {
+			if (groundBlockingObjectMap.GetCellMaskUnsafe(zOffset + x) == 0)
+				continue;
+
 			const CGroundBlockingObjectMap::BlockingMapCell& cell = groundBlockingObjectMap.GetCellUnsafeConst(zOffset + x);
 
 			for (size_t i = 0, n = cell.size(); i < n; i++) {
@@ -552,6 +701,11 @@ void CMoveMath::FloodFillRangeIsBlocked(const MoveDef& moveDef, const CSolidObje
 		const int zOffset = z * mapDims.mapx;
 
 		for (int x = areaToSample.x1; x < areaToSample.x2; ++x) {
+			if (groundBlockingObjectMap.GetCellMaskUnsafe(zOffset + x) == 0) {
+				results.emplace_back(BLOCK_NONE);
+				continue;
+			}
+
 			const CGroundBlockingObjectMap::BlockingMapCell& cell = groundBlockingObjectMap.GetCellUnsafeConst(zOffset + x);
 			BlockType ret = BLOCK_NONE;
 
@@ -53,6 +53,12 @@ protected:
 	static float ShipSpeedMod(const MoveDef& moveDef, float height, float slope);
 	static float ShipSpeedMod(const MoveDef& moveDef, float height, float slope, float dirSlopeMod);
 
+	// batch versions of the above, results are bitwise identical to the scalar ones;
+	// all arrays must be aligned to and <count> a multiple of the native SIMD batch
+	static void GroundSpeedMods(const MoveDef& moveDef, const float* heights, const float* slopes, float* speedMods, size_t count);
+	static void HoverSpeedMods(const MoveDef& moveDef, const float* heights, const float* slopes, float* speedMods, size_t count);
+	static void ShipSpeedMods(const MoveDef& moveDef, const float* heights, const float* slopes, float* speedMods, size_t count);
+
 public:
 	// gives the y-coordinate the unit will "stand on"
 	static float yLevel(const MoveDef& moveDef, const float3& pos);
@@ -81,6 +87,17 @@ public:
 	}
 	static float GetPosSpeedMod(const MoveDef& moveDef, unsigned squareIndex);
 
+	typedef float (*PosSpeedModFunc)(const MoveDef& moveDef, unsigned xSquare, unsigned zSquare);
+	typedef float (*DirPosSpeedModFunc)(const MoveDef& moveDef, unsigned xSquare, unsigned zSquare, float3 moveDir);
+
+	// GetPosSpeedMod specialized for the speed-mod class of <moveDef>; loops over
+	// many squares fetch these once instead of switching on the class per square
+	static PosSpeedModFunc GetPosSpeedModFunc(const MoveDef& moveDef);
+	static DirPosSpeedModFunc GetDirPosSpeedModFunc(const MoveDef& moveDef);
+
+	// evaluates GetPosSpeedMod for every square of a rectangle inside the map, row-major
+	static void GetPosSpeedMods(const MoveDef& moveDef, const SRectangle& areaToSample, std::vector<float>& results);
+
 	// tells whether a position is blocked (inaccessible for a given object's MoveDef)
 	static inline BlockType IsBlocked(const MoveDef& moveDef, const float3& pos, const CSolidObject* collider, int thread);
 	static inline BlockType IsBlocked(const MoveDef& moveDef, int xSquare, int zSquare, const CSolidObject* collider, int thread);
@@ -116,6 +133,10 @@ public:
 
 	static bool RangeHasExitOnly(int xmin, int xmax, int zmin, int zmax, const ObjectCollisionMapHelper& object);
 
+private:
+	template<int speedModClass> static float GetPosSpeedModT(const MoveDef& moveDef, unsigned xSquare, unsigned zSquare);
+	template<int speedModClass> static float GetPosSpeedModT(const MoveDef& moveDef, unsigned xSquare, unsigned zSquare, float3 moveDir);
+
 public:
 	static bool noHoverWaterMove;
 	static float waterDamageCost;
@@ -5,6 +5,8 @@
 
 #include "System/Misc/TracyDefs.h"
 
+#include "xsimd/xsimd.hpp"
+
 /*
 Calculate speed-multiplier for given height and slope data.
 */
@@ -17,6 +19,20 @@ float CMoveMath::ShipSpeedMod(const MoveDef& moveDef, float height, float slope)
 	return 1.0f;
 }
 
+void CMoveMath::ShipSpeedMods(const MoveDef& moveDef, const float* heights, const float* slopes, float* speedMods, size_t count)
+{
+	RECOIL_DETAILED_TRACY_ZONE;
+	using FloatBatch = xsimd::simd_type<float>;
+	assert((count % FloatBatch::size) == 0);
+
+	for (size_t i = 0; i < count; i += FloatBatch::size) {
+		const FloatBatch height = xsimd::load_aligned(&heights[i]);
+		const auto blocked = (-height < FloatBatch(moveDef.depth));
+
+		xsimd::store_aligned(&speedMods[i], xsimd::select(blocked, FloatBatch(0.0f), FloatBatch(1.0f)));
+	}
+}
+
 float CMoveMath::ShipSpeedMod(const MoveDef& moveDef, float height, float slope, float dirSlopeMod)
 {
 	RECOIL_DETAILED_TRACY_ZONE;
@@ -87,13 +87,19 @@ void AMoveType::SlowUpdate()
 void AMoveType::UpdateCollisionMap(bool force)
 {
 	RECOIL_DETAILED_TRACY_ZONE;
-	if (!force && ((gs->frameNum + owner->id) % modInfo.unitQuadPositionUpdateRate))
+	if (!WantCollisionMapUpdate(force))
 		return;
 
-	if (owner->pos != oldCollisionUpdatePos){
-		oldCollisionUpdatePos = owner->pos;
-		quadField.MovedUnit(owner);
-	}
+	oldCollisionUpdatePos = owner->pos;
+	quadField.MovedUnit(owner);
+}
+
+bool AMoveType::WantCollisionMapUpdate(bool force) const
+{
+	if (!force && ((gs->frameNum + owner->id) % modInfo.unitQuadPositionUpdateRate))
+		return false;
+
+	return (owner->pos != oldCollisionUpdatePos);
 }
 
 void AMoveType::UpdateGroundBlockMap() {
@@ -54,6 +54,7 @@ public:
 	virtual bool Update() = 0;
 	virtual void SlowUpdate();
 	void UpdateCollisionMap(bool force = false);
+	bool WantCollisionMapUpdate(bool force = false) const;
 	void UpdateGroundBlockMap();
 
 	virtual bool IsSkidding() const { return false; }
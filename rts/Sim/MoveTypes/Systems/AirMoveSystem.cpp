@@ -0,0 +1,49 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#include "AirMoveSystem.h"
+
+#include "Sim/Misc/GlobalSynced.h"
+#include "Sim/Ecs/Registry.h"
+#include "Sim/Misc/ModInfo.h"
+#include "Sim/MoveTypes/AAirMoveType.h"
+#include "Sim/MoveTypes/Components/MoveTypesComponents.h"
+#include "Sim/Units/Unit.h"
+#include "Sim/Units/UnitHandler.h"
+
+#include "System/TimeProfiler.h"
+#include "System/Threading/ThreadPool.h"
+
+#include "System/Misc/TracyDefs.h"
+
+using namespace MoveTypes;
+
+void AirMoveSystem::Init() {}
+
+void AirMoveSystem::Update() {
+    RECOIL_DETAILED_TRACY_ZONE;
+    if (!modInfo.airCollisionScanMT)
+        return;
+
+    // Integration and collision handling stay in GeneralMoveSystem: they consume
+    // gsRNG and push other units around, so their order must not change. Only the
+    // read-only collision-warning scan, done by every aircraft once per four frames,
+    // is taken out of the serial update.
+    SCOPED_TIMER("Sim::Unit::MoveType::4::ScanAirCollisions");
+    auto view = Sim::registry.view<AirMoveType>();
+    for_mt(0, view.size(), [&view](const int i){
+        auto entity = view.storage<AirMoveType>()[i];
+        auto unitId = view.get<AirMoveType>(entity);
+
+        CUnit* unit = unitHandler.GetUnit(unitId.value);
+        AAirMoveType* moveType = static_cast<AAirMoveType*>(unit->moveType);
+        assert(moveType != nullptr);
+
+        // same schedule as the CheckForCollision calls in the update
+        if (((gs->frameNum + unit->id) & 3) != 0)
+            return;
+        if (!moveType->collide || moveType->aircraftState == AAirMoveType::AIRCRAFT_LANDED)
+            return;
+
+        moveType->PrefetchCollisionScan(ThreadPool::GetThreadNum());
+    });
+}
@@ -0,0 +1,12 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#ifndef AIR_MOVE_SYSTEM_H__
+#define AIR_MOVE_SYSTEM_H__
+
+class AirMoveSystem {
+public:
+    static void Init();
+    static void Update();
+};
+
+#endif
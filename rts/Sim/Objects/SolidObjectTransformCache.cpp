@@ -0,0 +1,51 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#include <cassert>
+
+#include "SolidObjectTransformCache.h"
+#include "SolidObject.h"
+
+#include "System/Misc/TracyDefs.h"
+
+
+void CSolidObjectTransformCache::Init(size_t numObjects)
+{
+	RECOIL_DETAILED_TRACY_ZONE;
+	prevPos.assign(numObjects, ZeroVector);
+	pos.assign(numObjects, ZeroVector);
+	speed.assign(numObjects, float4{});
+	frontdir.assign(numObjects, FwdVector);
+	updir.assign(numObjects, UpVector);
+	rightdir.assign(numObjects, RgtVector);
+
+	valid.assign(numObjects, 0);
+}
+
+void CSolidObjectTransformCache::Kill()
+{
+	RECOIL_DETAILED_TRACY_ZONE;
+	prevPos.clear();
+	pos.clear();
+	speed.clear();
+	frontdir.clear();
+	updir.clear();
+	rightdir.clear();
+
+	valid.clear();
+}
+
+void CSolidObjectTransformCache::Store(const CSolidObject* o)
+{
+	const int id = o->id;
+
+	assert(id >= 0 && static_cast<size_t>(id) < valid.size());
+
+	prevPos[id] = o->preFrameTra.t;
+	pos[id] = o->pos;
+	speed[id] = o->speed;
+	frontdir[id] = o->frontdir;
+	updir[id] = o->updir;
+	rightdir[id] = o->rightdir;
+
+	valid[id] = 1;
+}
@@ -0,0 +1,56 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#ifndef SOLID_OBJECT_TRANSFORM_CACHE_H
+#define SOLID_OBJECT_TRANSFORM_CACHE_H
+
+#include <cstdint>
+#include <vector>
+
+#include "System/float3.h"
+#include "System/float4.h"
+#include "System/SpringMath.h"
+
+class CSolidObject;
+
+/**
+ * Contiguous (structure-of-arrays) copies of the hot transform fields of
+ * one kind of solid object, indexed by object id. Refreshed once at the
+ * end of every sim frame, so the contents always equal the state visible
+ * to unsynced code until the next frame starts. Must not be read from
+ * synced code, which can observe objects mid-frame.
+ */
+class CSolidObjectTransformCache
+{
+public:
+	void Init(size_t numObjects);
+	void Kill();
+
+	// called from worker threads, each id is written by exactly one of them
+	void Store(const CSolidObject* o);
+	void Clear(int id) { valid[id] = 0; }
+
+	bool IsValid(int id) const { return (id >= 0 && static_cast<size_t>(id) < valid.size() && valid[id] != 0); }
+	size_t Size() const { return valid.size(); }
+
+	const float3& GetPrevPos(int id) const { return prevPos[id]; }
+	const float3& GetPos(int id) const { return pos[id]; }
+	const float4& GetSpeed(int id) const { return speed[id]; }
+	const float3& GetFrontDir(int id) const { return frontdir[id]; }
+	const float3& GetUpDir(int id) const { return updir[id]; }
+	const float3& GetRightDir(int id) const { return rightdir[id]; }
+
+	// interpolated base-position; same as CWorldObject::GetDrawPos
+	float3 GetDrawPos(int id, float t) const { return mix(prevPos[id], pos[id], t); }
+
+private:
+	std::vector<float3> prevPos;
+	std::vector<float3> pos;
+	std::vector<float4> speed;
+	std::vector<float3> frontdir;
+	std::vector<float3> updir;
+	std::vector<float3> rightdir;
+
+	std::vector<uint8_t> valid;
+};
+
+#endif
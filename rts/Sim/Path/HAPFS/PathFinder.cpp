@@ -15,6 +15,7 @@
 #include "Sim/Misc/ModInfo.h"
 #include "Sim/Misc/GeometricObjects.h"
 #include "System/MathConstants.h"
+#include "System/MemPoolStats.h"
 #include "System/TimeProfiler.h"
 
 #include "System/Misc/TracyDefs.h"
@@ -33,6 +34,7 @@ using namespace Bitwise;
 using MMBT = CMoveMath::BlockTypes;
 
 PFMemPool pfMemPool;
+static MemPoolRegistrar pfMemPoolRegistrar("PathFinders", pfMemPool);
 
 
 static constexpr uint32_t squareMobileBlockBits =
@@ -234,6 +236,9 @@ void CPathFinder::TestNeighborSquares(
 
 	const int2 squarePos = square->nodePos;
 
+	const CMoveMath::PosSpeedModFunc getPosSpeedMod = CMoveMath::GetPosSpeedModFunc(moveDef);
+	const CMoveMath::DirPosSpeedModFunc getDirPosSpeedMod = CMoveMath::GetDirPosSpeedModFunc(moveDef);
+
 	const bool startSquareExpanded = (openBlocks.empty() && testedBlocks < 8);
 	const bool startSquareBlocked = (startSquareExpanded && (CMoveMath::IsBlockedNoSpeedModCheck(moveDef, squarePos.x, squarePos.y, owner, thread) & MMBT::BLOCK_STRUCTURE) != 0);
 
@@ -262,7 +267,7 @@ void CPathFinder::TestNeighborSquares(
 		}
 
 		if (moveDef.allowDirectionalPathing) {
-			sqState.speedMod = CMoveMath::GetPosSpeedMod(moveDef, ngbSquareCoors.x, ngbSquareCoors.y, PF_DIRECTION_VECTORS_3D[optDir]);
+			sqState.speedMod = getDirPosSpeedMod(moveDef, ngbSquareCoors.x, ngbSquareCoors.y, PF_DIRECTION_VECTORS_3D[optDir]);
 		} else {
 			// PE search; use positional speed-mods since PE assumes path-costs
 			// are bidirectionally symmetric between parent and child vertices
@@ -271,7 +276,7 @@ void CPathFinder::TestNeighborSquares(
 			//
 			// only close node if search is directionally independent, since it
 			// might still be entered from another (better) direction otherwise
-			sqState.speedMod = CMoveMath::GetPosSpeedMod(moveDef, ngbSquareCoors.x, ngbSquareCoors.y);
+			sqState.speedMod = getPosSpeedMod(moveDef, ngbSquareCoors.x, ngbSquareCoors.y);
 			if (sqState.speedMod == 0.0f) {
 				blockStates.nodeMask[ngbSquareIdx] |= PATHOPT_CLOSED;
 				dirtyBlocks.push_back(ngbSquareIdx);
@@ -425,6 +425,13 @@ void CPathManager::DeletePath(unsigned int pathID, bool /* force ignored*/) {
 	}
 }
 
+bool CPathManager::PathPending(unsigned int pathID) const
+{
+	const MultiPath* multiPath = GetMultiPathConst(pathID);
+
+	return (multiPath != nullptr && multiPath->searchResult == IPath::SearchResult::Unitialized);
+}
+
 /*
 Request a new multipath, store the result and return a handle-id to it.
 */
@@ -447,9 +454,11 @@ unsigned int CPathManager::RequestPath(
 
 		PathSearch* existingSearch = nullptr;
 		auto searchView = registry.view<PathSearch>();
+
+		// requests without a caller (from Lua) are independent of each other
 		for ( entt::entity entity : searchView ) {
 			auto& search = searchView.get<PathSearch>(entity);
-			if (search.caller == caller) {
+			if (caller != nullptr && search.caller == caller) {
 				existingSearch = &search;
 				break;
 			}
@@ -848,6 +857,26 @@ void CPathManager::Update()
 			// 		, (int)newPath.maxResPath.path.size());
 		});
 
+		// The searches above cannot touch the path caches while running in parallel, so
+		// merge their results here; adding in view order keeps the first of several
+		// colliding entries identical on every client.
+		if (modInfo.pfCacheMultiThreadedSearches) {
+			for (entt::entity searchEntity : pathSearchView) {
+				if (registry.try_get<PathExtension>(searchEntity) != nullptr)
+					continue;
+
+				const PathSearch& pathSearch = pathSearchView.get<PathSearch>(searchEntity);
+				const MultiPath* multiPath = GetMultiPathConst(pathSearch.pathId);
+
+				if (multiPath == nullptr)
+					continue;
+				if (multiPath->searchResult != IPath::Ok && multiPath->searchResult != IPath::GoalOutOfRange)
+					continue;
+
+				SavePathCacheForPathId(pathSearch.pathId);
+			}
+		}
+
 		// Clear out the search entities.
 		pathSearchView.each([](entt::entity ent){ registry.destroy(ent); });
 	}
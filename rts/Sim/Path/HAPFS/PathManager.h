@@ -137,6 +137,7 @@ public:
 	// Isn't used here due to the way waypoints get consumed and then a noPoint
 	// is returned when out of points.
 	bool CurrentWaypointIsUnreachable(unsigned int pathID) override { return false; }
+	bool PathPending(unsigned int pathID) const override;
 
 	unsigned int RequestPath(
 		CSolidObject* caller,
@@ -26,6 +26,7 @@
 #include "System/FileSystem/DataDirsAccess.h"
 #include "System/FileSystem/FileSystem.h"
 #include "System/FileSystem/FileQueryFlags.h"
+#include "System/MemPoolStats.h"
 #include "System/Platform/Threading.h"
 #include "System/StringUtil.h"
 #include "System/Threading/ThreadPool.h" // for_mt
@@ -44,6 +45,7 @@ static std::vector<PathNodeStateBuffer> nodeStateBuffers;
 static size_t pathingStates = 0;
 
 PCMemPool pcMemPool;
+static MemPoolRegistrar pcMemPoolRegistrar("PathCaches", pcMemPool);
 // PEMemPool peMemPool;
 
 static const std::string GetPathCacheDir() {
@@ -148,10 +150,13 @@ void PathingState::Init(std::vector<IPathFinder*> pathFinderlist, PathingState*
 		// calculate map-wide maximum positional speedmod for each MoveDef
 		for_mt(0, moveDefHandler.GetNumMoveDefs(), [&](unsigned int i) {
 			const MoveDef* md = moveDefHandler.GetMoveDefByPathType(i);
+			std::vector<float> rowSpeedMods;
 
 			for (int y = 0; y < mapDims.mapy; y++) {
-				for (int x = 0; x < mapDims.mapx; x++) {
-					childPE->maxSpeedMods[i] = std::max(childPE->maxSpeedMods[i], CMoveMath::GetPosSpeedMod(*md, x, y));
+				CMoveMath::GetPosSpeedMods(*md, SRectangle(0, y, mapDims.mapx, y + 1), rowSpeedMods);
+
+				for (const float speedMod: rowSpeedMods) {
+					childPE->maxSpeedMods[i] = std::max(childPE->maxSpeedMods[i], speedMod);
 				}
 			}
 		});
@@ -335,6 +340,8 @@ int2 PathingState::FindBlockPosOffset(const MoveDef& moveDef, unsigned int block
 	int2 bestPos(lowerX + (BLOCK_SIZE >> 1), lowerZ + (BLOCK_SIZE >> 1));
 	float bestCost = std::numeric_limits<float>::max();
 
+	const CMoveMath::PosSpeedModFunc getPosSpeedMod = CMoveMath::GetPosSpeedModFunc(moveDef);
+
 	// same as above, but with squares sorted by their baseCost
 	// s.t. we can exit early when a square exceeds our current
 	// best (from testing, on avg. 40% of blocks can be skipped)
@@ -343,7 +350,7 @@ int2 PathingState::FindBlockPosOffset(const MoveDef& moveDef, unsigned int block
 			break;
 
 		const int2 blockPos(lowerX + ob.offset.x, lowerZ + ob.offset.y);
-		const float speedMod = CMoveMath::GetPosSpeedMod(moveDef, blockPos.x, blockPos.y);
+		const float speedMod = getPosSpeedMod(moveDef, blockPos.x, blockPos.y);
 
 		//assert((blockArea / (0.001f + speedMod) >= 0.0f);
 		const float cost = ob.cost + (blockArea / (0.001f + speedMod));
@@ -37,6 +37,12 @@ public:
 	virtual bool PathUpdated(unsigned int pathID) { return false; }
 	virtual void ClearPathUpdated(unsigned int pathID) {}
 
+	/**
+	 * returns if the search for a path requested without immediateResult
+	 * has not run yet; its waypoints are placeholders until then
+	 */
+	virtual bool PathPending(unsigned int pathID) const { return false; }
+
 	virtual void RemoveCacheFiles() {}
 	virtual void Update() {}
 	virtual void UpdatePath(const CSolidObject* owner, unsigned int pathID) {}
@@ -88,6 +94,21 @@ public:
 	virtual bool CurrentWaypointIsUnreachable(unsigned int pathID) { return false; }
 	virtual bool NextWayPointIsUnreachable(unsigned int pathID) { return false; }
 
+	/**
+	 * Samples the flow field (if any) that serves the group of the given path.
+	 * Read-only, so safe to call from multi-threaded unit updates.
+	 *
+	 * @param pathID
+	 *     The path-id returned by RequestPath.
+	 * @param pos
+	 *     The position to sample the field at.
+	 * @param dir
+	 *     Receives the normalized xz-direction towards the goal.
+	 * @return
+	 *     false if no field covers <pos>, in which case <dir> is untouched.
+	 */
+	virtual bool GetFlowFieldDirection(unsigned int pathID, const float3& pos, float3& dir) const { return false; }
+
 
 	/**
 	 * Returns all waypoints of a path. Different segments of a path might
@@ -32,6 +32,16 @@ struct PartialSharedPathChain {
     QTPFS::entity next{entt::null};
 };
 
+struct GroupSharedPathChain {
+	GroupSharedPathChain() {}
+
+	GroupSharedPathChain(QTPFS::entity initPrev, QTPFS::entity initNext)
+		: prev(initPrev), next(initNext) {}
+
+    QTPFS::entity prev{entt::null};
+    QTPFS::entity next{entt::null};
+};
+
 VOID_COMPONENT(PathIsTemp);
 VOID_COMPONENT(PathIsDirty);
 VOID_COMPONENT(PathIsToBeUpdated);
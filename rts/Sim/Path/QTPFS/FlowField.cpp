@@ -0,0 +1,138 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#include <algorithm>
+#include <cassert>
+#include <functional>
+
+#include "FlowField.h"
+#include "Node.h"
+#include "NodeLayer.h"
+
+#include "Map/ReadMap.h"
+#include "Sim/Misc/GlobalConstants.h"
+
+#include "System/Misc/TracyDefs.h"
+
+static bool IsNodeEnterable(const QTPFS::INode* n) {
+	return (!n->AllSquaresImpassable() && !n->IsExitOnly());
+}
+
+static const QTPFS::INode* GetNodeAtPos(const QTPFS::NodeLayer& nodeLayer, const float3& pos) {
+	const unsigned int x = std::clamp(int(pos.x / SQUARE_SIZE), 0, mapDims.mapxm1);
+	const unsigned int z = std::clamp(int(pos.z / SQUARE_SIZE), 0, mapDims.mapym1);
+
+	return nodeLayer.GetNode(x, z);
+}
+
+
+void QTPFS::FlowField::Build(const NodeLayer& nodeLayer, const float3& goal, const SRectangle& searchArea, FlowQueue& queue) {
+	RECOIL_DETAILED_TRACY_ZONE;
+	flowNodes.clear();
+	queue.clear();
+
+	area = searchArea;
+	goalPos = goal;
+	dirty = false;
+
+	const INode* goalNode = GetNodeAtPos(nodeLayer, goalPos);
+
+	goalNodeIndex = goalNode->GetIndex();
+	nodeBounds = SRectangle(goalNode->xmin(), goalNode->zmin(), goalNode->xmax(), goalNode->zmax());
+
+	FlowNode& goalFlowNode = flowNodes[goalNodeIndex];
+	goalFlowNode.exitPoint = {goalPos.x, goalPos.z};
+
+	queue.emplace_back(0.0f, goalNodeIndex);
+
+	// Dijkstra from the goal; a node's cost is that of moving from its exit point
+	// (the transition point into its next node) to the goal, with each segment
+	// weighted by the move-cost of the node it crosses, as search g-costs are
+	while (!queue.empty()) {
+		std::pop_heap(queue.begin(), queue.end(), std::greater<>{});
+		const auto [curCost, curNodeIndex] = queue.back();
+		queue.pop_back();
+
+		const FlowNode curFlowNode = flowNodes[curNodeIndex];
+
+		if (curCost > curFlowNode.cost)
+			continue;
+
+		const INode* curNode = nodeLayer.GetPoolNode(curNodeIndex);
+
+		// units may move out of, but never through, nodes they cannot enter
+		if (curNodeIndex != goalNodeIndex && !IsNodeEnterable(curNode))
+			continue;
+
+		const float curMoveCost = curNode->AllSquaresImpassable() ? QTPFS_CLOSED_NODE_COST : curNode->GetMoveCost();
+
+		for (const INode::NeighbourPoints& ngbPoints: curNode->GetNeighbours()) {
+			const INode* ngbNode = nodeLayer.GetPoolNode(ngbPoints.nodeId);
+
+			if (!ngbNode->RectIntersects(area))
+				continue;
+
+			const float2& netPoint = ngbPoints.netpoints[0];
+			const float ngbCost = curCost + curFlowNode.exitPoint.Distance(netPoint) * curMoveCost;
+
+			const auto iter = flowNodes.find(ngbPoints.nodeId);
+
+			if (iter != flowNodes.end() && ngbCost >= iter->second.cost)
+				continue;
+
+			FlowNode& ngbFlowNode = (iter != flowNodes.end())? iter->second: flowNodes[ngbPoints.nodeId];
+
+			ngbFlowNode.cost = ngbCost;
+			ngbFlowNode.nextNodeIndex = curNodeIndex;
+			ngbFlowNode.exitPoint = netPoint;
+
+			nodeBounds.x1 = std::min(nodeBounds.x1, ngbNode->xmin());
+			nodeBounds.z1 = std::min(nodeBounds.z1, ngbNode->zmin());
+			nodeBounds.x2 = std::max(nodeBounds.x2, ngbNode->xmax());
+			nodeBounds.z2 = std::max(nodeBounds.z2, ngbNode->zmax());
+
+			queue.emplace_back(ngbCost, ngbPoints.nodeId);
+			std::push_heap(queue.begin(), queue.end(), std::greater<>{});
+		}
+	}
+}
+
+void QTPFS::FlowField::Clear() {
+	flowNodes.clear();
+	goalNodeIndex = -1u;
+	dirty = true;
+}
+
+bool QTPFS::FlowField::GetDirection(const NodeLayer& nodeLayer, const float3& pos, float3& dir) const {
+	RECOIL_DETAILED_TRACY_ZONE;
+	if (dirty || !Covers(pos))
+		return false;
+
+	const INode* curNode = GetNodeAtPos(nodeLayer, pos);
+	const auto iter = flowNodes.find(curNode->GetIndex());
+
+	if (iter == flowNodes.end() || iter->second.nextNodeIndex == -1u)
+		return false;
+
+	const float2& exitPoint = iter->second.exitPoint;
+	float3 exitVec = float3(exitPoint.x - pos.x, 0.0f, exitPoint.y - pos.z);
+
+	if (exitVec.SqLength2D() < 1.0f)
+		return false;
+
+	dir = exitVec.SafeNormalize2D();
+	return true;
+}
+
+bool QTPFS::FlowField::Covers(const float3& pos) const {
+	const int x = int(pos.x / SQUARE_SIZE);
+	const int z = int(pos.z / SQUARE_SIZE);
+
+	return (x >= area.x1 && x < area.x2 && z >= area.z1 && z < area.z2);
+}
+
+bool QTPFS::FlowField::Intersects(const SRectangle& r) const {
+	if (flowNodes.empty())
+		return false;
+
+	return !(nodeBounds.x1 >= r.x2 || nodeBounds.x2 <= r.x1 || nodeBounds.z1 >= r.z2 || nodeBounds.z2 <= r.z1);
+}
@@ -0,0 +1,67 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#ifndef QTPFS_FLOWFIELD_H_
+#define QTPFS_FLOWFIELD_H_
+
+#include <utility>
+#include <vector>
+
+#include "System/float3.h"
+#include "System/Rectangle.h"
+#include "System/type2.h"
+#include "System/UnorderedMap.hpp"
+
+namespace QTPFS {
+	struct NodeLayer;
+
+	// Directions towards a single goal for the leaf-nodes of one node-layer that lie
+	// within a bounded area, built by a Dijkstra search outwards from the goal's node.
+	// Every reached node stores the neighbour to move into next and where to cross
+	// into it, so any number of units in the area can look up a heading without a
+	// search of their own. Only reached nodes are stored, so memory is proportional
+	// to the area covered rather than to the map.
+	struct FlowField {
+	public:
+		struct FlowNode {
+			float cost = 0.0f;
+			unsigned int nextNodeIndex = -1u;
+			float2 exitPoint;
+		};
+
+		typedef std::vector< std::pair<float, unsigned int> > FlowQueue;
+
+		void Build(const NodeLayer& nodeLayer, const float3& goal, const SRectangle& area, FlowQueue& queue);
+		void Clear();
+
+		// returns false if <pos> is outside the field, unreachable, or in the goal's node
+		bool GetDirection(const NodeLayer& nodeLayer, const float3& pos, float3& dir) const;
+
+		bool Covers(const float3& pos) const;
+		bool Contains(const SRectangle& r) const {
+			return (r.x1 >= area.x1 && r.z1 >= area.z1 && r.x2 <= area.x2 && r.z2 <= area.z2);
+		}
+		bool Intersects(const SRectangle& r) const;
+
+		void MarkDirty() { dirty = true; }
+		bool IsDirty() const { return dirty; }
+
+		std::size_t GetMemFootPrint() const {
+			return (flowNodes.size() * sizeof(decltype(flowNodes)::value_type));
+		}
+
+	private:
+		spring::unordered_map<unsigned int, FlowNode> flowNodes;
+
+		// <area> limits the search; <nodeBounds> is the union of the nodes it reached,
+		// which can stick out of <area> and is what re-tesselation must be tested against
+		SRectangle area;
+		SRectangle nodeBounds;
+
+		float3 goalPos;
+		unsigned int goalNodeIndex = -1u;
+
+		bool dirty = true;
+	};
+}
+
+#endif
@@ -711,6 +711,39 @@ void QTPFS::QTNode::Serialize(std::fstream& fStream, NodeLayer& nodeLayer, unsig
 }
 
 
+void QTPFS::QTNode::WriteCache(std::vector<std::uint8_t>& buffer) const {
+	const std::uint32_t numNeighbours = neighbours.size();
+
+	NodeLayer::WriteCacheData(buffer, &nodeNumber, 1);
+	NodeLayer::WriteCacheData(buffer, &index, 1);
+	NodeLayer::WriteCacheData(buffer, points.data(), points.size());
+	NodeLayer::WriteCacheData(buffer, &moveCostAvg, 1);
+	NodeLayer::WriteCacheData(buffer, &childBaseIndex, 1);
+	NodeLayer::WriteCacheData(buffer, &numNeighbours, 1);
+	NodeLayer::WriteCacheData(buffer, neighbours.data(), numNeighbours);
+}
+
+bool QTPFS::QTNode::ReadCache(const std::vector<std::uint8_t>& buffer, size_t& pos) {
+	std::uint32_t numNeighbours = 0;
+
+	if (!NodeLayer::ReadCacheData(buffer, pos, &nodeNumber, 1))
+		return false;
+	if (!NodeLayer::ReadCacheData(buffer, pos, &index, 1))
+		return false;
+	if (!NodeLayer::ReadCacheData(buffer, pos, points.data(), points.size()))
+		return false;
+	if (!NodeLayer::ReadCacheData(buffer, pos, &moveCostAvg, 1))
+		return false;
+	if (!NodeLayer::ReadCacheData(buffer, pos, &childBaseIndex, 1))
+		return false;
+	if (!NodeLayer::ReadCacheData(buffer, pos, &numNeighbours, 1))
+		return false;
+
+	neighbours.resize(numNeighbours);
+	return (NodeLayer::ReadCacheData(buffer, pos, neighbours.data(), numNeighbours));
+}
+
+
 // this is *either* called from ::GetNeighbors when the conservative
 // update-scheme is enabled, *or* from PM::ExecQueuedNodeLayerUpdates
 // (never both)
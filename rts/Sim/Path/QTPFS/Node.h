@@ -85,6 +85,10 @@ namespace QTPFS {
 		void Tesselate(NodeLayer& nl, const SRectangle& r, unsigned int depth, const UpdateThreadData* threadData);
 		void Serialize(std::fstream& fStream, NodeLayer& nodeLayer, unsigned int* streamSize, unsigned int depth, bool readMode);
 
+		// raw (host-endian) node state for the on-disk node-layer cache
+		void WriteCache(std::vector<std::uint8_t>& buffer) const;
+		bool ReadCache(const std::vector<std::uint8_t>& buffer, size_t& pos);
+
 		bool IsLeaf() const { return (childBaseIndex == -1u); }
 		bool CanSplit(unsigned int depth, bool forced) const;
 
@@ -3,7 +3,10 @@
 #ifndef QTPFS_NODEHEAP_HDR
 #define QTPFS_NODEHEAP_HDR
 
+#include <algorithm>
+#include <cassert>
 #include <limits>
+#include <utility>
 #include <vector>
 #include "PathDefines.h"
 
@@ -291,6 +294,110 @@ namespace QTPFS {
 		size_t cur_idx; // index of first free (unused) slot
 		size_t max_idx; // index of last free (unused) slot
 	};
+
+
+	// d-ary min-heap over small value-types with the std::priority_queue
+	// interface plus clear(). Entries are ordered by an integral sort-key
+	// (TKey()(entry), smallest on top) rather than by a comparator, so that
+	// picking the best child is a branch-free integer compare; the wider
+	// fan-out halves the depth of the binary case and keeps all children of
+	// a parent in one cache line. With unique keys the pop sequence matches
+	// that of any other heap, so swapping implementations cannot change
+	// search results.
+	template<class T, class TKey, size_t D = 4> class d_ary_heap {
+	public:
+		static_assert(D >= 2);
+
+		typedef T value_type;
+
+		void push(const T& v) {
+			entries.push_back(v);
+			inc_heap(entries.size() - 1);
+		}
+
+		template<typename... Args>
+		void emplace(Args&&... args) {
+			entries.emplace_back(std::forward<Args>(args)...);
+			inc_heap(entries.size() - 1);
+		}
+
+		void pop() {
+			assert(!empty());
+
+			entries.front() = entries.back();
+			entries.pop_back();
+
+			if (!entries.empty())
+				dec_heap(0);
+		}
+
+		const T& top() const {
+			assert(!empty());
+			return entries.front();
+		}
+
+		bool empty() const { return entries.empty(); }
+		size_t size() const { return entries.size(); }
+		size_t capacity() const { return entries.capacity(); }
+
+		// keeps the allocation around for the next search
+		void clear() { entries.clear(); }
+		void reserve(size_t n) { entries.reserve(n); }
+
+	private:
+		static size_t parent_idx(size_t c_idx) { return ((c_idx - 1) / D); }
+		static size_t child_idx(size_t p_idx) { return (p_idx * D + 1); }
+
+		void inc_heap(size_t c_idx) {
+			const T v = entries[c_idx];
+			const auto v_key = key(v);
+
+			while (c_idx > 0) {
+				const size_t p_idx = parent_idx(c_idx);
+
+				if (key(entries[p_idx]) <= v_key)
+					break;
+
+				entries[c_idx] = entries[p_idx];
+				c_idx = p_idx;
+			}
+
+			entries[c_idx] = v;
+		}
+
+		void dec_heap(size_t p_idx) {
+			const T v = entries[p_idx];
+			const auto v_key = key(v);
+			const size_t n = entries.size();
+
+			for (size_t c_idx = child_idx(p_idx); c_idx < n; c_idx = child_idx(p_idx)) {
+				// pick the child closest to the top; kept branch-free since
+				// the outcome of each comparison is essentially random
+				const size_t c_end = std::min(c_idx + D, n);
+				size_t b_idx = c_idx;
+				auto b_key = key(entries[c_idx]);
+
+				for (size_t i = c_idx + 1; i < c_end; i++) {
+					const auto i_key = key(entries[i]);
+					const bool better = (i_key < b_key);
+					b_key = better? i_key: b_key;
+					b_idx = better? i: b_idx;
+				}
+
+				if (v_key <= b_key)
+					break;
+
+				entries[p_idx] = entries[b_idx];
+				p_idx = b_idx;
+			}
+
+			entries[p_idx] = v;
+		}
+
+	private:
+		std::vector<T> entries;
+		TKey key;
+	};
 }
 
 #endif
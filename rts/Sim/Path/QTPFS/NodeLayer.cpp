@@ -60,6 +60,11 @@ void QTPFS::NodeLayer::Init(unsigned int layerNum) {
 	numLeafNodes = 1;
 	layerNumber = layerNum;
 
+	// may be re-initialized after a failed cache read
+	numOpenNodes = 0;
+	numClosedNodes = 0;
+	maxNodesAlloced = 0;
+
 	xsize = mapDims.mapx;
 	zsize = mapDims.mapy;
 
@@ -79,10 +84,92 @@ void QTPFS::NodeLayer::Init(unsigned int layerNum) {
 	useShortestPath = md->preferShortestPath;
 }
 
+void QTPFS::NodeLayer::WriteCache(std::vector<std::uint8_t>& buffer) const {
+	RECOIL_DETAILED_TRACY_ZONE;
+	const std::uint32_t numNodeIndcs = nodeIndcs.size();
+	const std::uint32_t numSpeedMods = curSpeedMods.size();
+	const std::uint32_t numSpeedBins = curSpeedBins.size();
+
+	WriteCacheData(buffer, &numLeafNodes, 1);
+	WriteCacheData(buffer, &numOpenNodes, 1);
+	WriteCacheData(buffer, &numClosedNodes, 1);
+	WriteCacheData(buffer, &maxNodesAlloced, 1);
+	WriteCacheData(buffer, &maxRelSpeedMod, 1);
+	WriteCacheData(buffer, &avgRelSpeedMod, 1);
+
+	WriteCacheData(buffer, &numNodeIndcs, 1);
+	WriteCacheData(buffer, nodeIndcs.data(), numNodeIndcs);
+	WriteCacheData(buffer, &numSpeedMods, 1);
+	WriteCacheData(buffer, curSpeedMods.data(), numSpeedMods);
+	WriteCacheData(buffer, &numSpeedBins, 1);
+	WriteCacheData(buffer, curSpeedBins.data(), numSpeedBins);
+
+	// free'd nodes are included, they keep their deactivated state
+	for (int32_t i = 0; i < maxNodesAlloced; i++) {
+		if (poolNodes[i / POOL_CHUNK_SIZE].empty()) {
+			QTNode().WriteCache(buffer);
+			continue;
+		}
+
+		GetPoolNode(i)->WriteCache(buffer);
+	}
+}
+
+bool QTPFS::NodeLayer::ReadCache(const std::vector<std::uint8_t>& buffer) {
+	RECOIL_DETAILED_TRACY_ZONE;
+	size_t pos = 0;
+
+	std::uint32_t numNodeIndcs = 0;
+	std::uint32_t numSpeedMods = 0;
+	std::uint32_t numSpeedBins = 0;
+
+	if (!ReadCacheData(buffer, pos, &numLeafNodes, 1))
+		return false;
+	if (!ReadCacheData(buffer, pos, &numOpenNodes, 1))
+		return false;
+	if (!ReadCacheData(buffer, pos, &numClosedNodes, 1))
+		return false;
+	if (!ReadCacheData(buffer, pos, &maxNodesAlloced, 1))
+		return false;
+	if (!ReadCacheData(buffer, pos, &maxRelSpeedMod, 1))
+		return false;
+	if (!ReadCacheData(buffer, pos, &avgRelSpeedMod, 1))
+		return false;
+
+	if (maxNodesAlloced < 0 || maxNodesAlloced > int32_t(POOL_TOTAL_SIZE))
+		return false;
+
+	if (!ReadCacheData(buffer, pos, &numNodeIndcs, 1) || numNodeIndcs > POOL_TOTAL_SIZE)
+		return false;
+	nodeIndcs.resize(numNodeIndcs);
+	if (!ReadCacheData(buffer, pos, nodeIndcs.data(), numNodeIndcs))
+		return false;
+
+	if (!ReadCacheData(buffer, pos, &numSpeedMods, 1) || numSpeedMods != curSpeedMods.size())
+		return false;
+	if (!ReadCacheData(buffer, pos, curSpeedMods.data(), numSpeedMods))
+		return false;
+	if (!ReadCacheData(buffer, pos, &numSpeedBins, 1) || numSpeedBins != curSpeedBins.size())
+		return false;
+	if (!ReadCacheData(buffer, pos, curSpeedBins.data(), numSpeedBins))
+		return false;
+
+	for (int32_t i = 0; i < maxNodesAlloced; i++) {
+		if (poolNodes[i / POOL_CHUNK_SIZE].empty())
+			poolNodes[i / POOL_CHUNK_SIZE].resize(POOL_CHUNK_SIZE);
+
+		if (!GetPoolNode(i)->ReadCache(buffer, pos))
+			return false;
+	}
+
+	return (pos == buffer.size());
+}
+
 void QTPFS::NodeLayer::Clear() {
 	RECOIL_DETAILED_TRACY_ZONE;
 	curSpeedMods.clear();
 	curSpeedBins.clear();
+	regionGraph.Clear();
 }
 
 
@@ -148,6 +235,8 @@ bool QTPFS::NodeLayer::Update(UpdateThreadData& threadData) {
 		return CMoveMath::RangeIsBlockedHashedMt(xmin, xmax, zmin, zmax, &virtualObject, tempNum, threadData.threadId);
 	};
 
+	CMoveMath::GetPosSpeedMods(*md, r, threadData.speedMods);
+
 	// divide speed-modifiers into bins
 	for (unsigned int hmz = r.z1; hmz < r.z2; hmz++) {
 		for (unsigned int hmx = r.x1; hmx < r.x2; hmx++) {
@@ -178,7 +267,7 @@ bool QTPFS::NodeLayer::Update(UpdateThreadData& threadData) {
 
 			#define NL QTPFS::NodeLayer
 			if ((maxBlockBit & CMoveMath::BLOCK_STRUCTURE) == 0) {
-				const float minSpeedMod = CMoveMath::GetPosSpeedMod(*md, hmx, hmz);
+				const float minSpeedMod = threadData.speedMods[recIdx];
 				newAbsSpeedMod = std::clamp(minSpeedMod, NL::MIN_SPEEDMOD_VALUE, NL::MAX_SPEEDMOD_VALUE);
 			}
 			const float newRelSpeedMod = std::clamp((newAbsSpeedMod - NL::MIN_SPEEDMOD_VALUE) / (NL::MAX_SPEEDMOD_VALUE - NL::MIN_SPEEDMOD_VALUE), 0.0f, 1.0f);
@@ -9,11 +9,14 @@
 #include <vector>
 #include <deque>
 #include <cinttypes>
+#include <cstring>
+#include <type_traits>
 
 #include "System/Rectangle.h"
 #include "Node.h"
 #include "PathDefines.h"
 #include "PathThreads.h"
+#include "RegionGraph.h"
 
 #include "System/Log/ILog.h"
 #include "System/Rectangle.h"
@@ -141,6 +144,7 @@ namespace QTPFS {
 			}
 
 			memFootPrint += (nodeIndcs.size() * sizeof(decltype(nodeIndcs)::value_type));
+			memFootPrint += regionGraph.GetMemFootPrint();
 			return memFootPrint;
 		}
 
@@ -165,6 +169,29 @@ namespace QTPFS {
 
 		bool UseShortestPath() { return useShortestPath; }
 
+		// the tesselated state right after initialization, see PathManager::InitNodeLayersThreaded
+		void InitRegionGraph() { regionGraph.Init(xsize, zsize); UpdateRegionGraph(SRectangle(0, 0, xsize, zsize)); }
+		void UpdateRegionGraph(const SRectangle& r) { regionGraph.UpdateRegions(*this, r, selectedNodes); }
+		const RegionGraph& GetRegionGraph() const { return regionGraph; }
+
+		void WriteCache(std::vector<std::uint8_t>& buffer) const;
+		bool ReadCache(const std::vector<std::uint8_t>& buffer);
+
+		template<typename T> static void WriteCacheData(std::vector<std::uint8_t>& buffer, const T* data, size_t count) {
+			static_assert(std::is_trivially_copyable_v<T>);
+			const std::uint8_t* bytes = reinterpret_cast<const std::uint8_t*>(data);
+			buffer.insert(buffer.end(), bytes, bytes + count * sizeof(T));
+		}
+		template<typename T> static bool ReadCacheData(const std::vector<std::uint8_t>& buffer, size_t& pos, T* data, size_t count) {
+			static_assert(std::is_trivially_copyable_v<T>);
+			if ((buffer.size() - pos) < (count * sizeof(T)))
+				return false;
+			if (count > 0)
+				std::memcpy(data, &buffer[pos], count * sizeof(T));
+			pos += (count * sizeof(T));
+			return true;
+		}
+
 	private:
 		std::vector<QTNode> poolNodes[16];
 		std::vector<unsigned int> nodeIndcs;
@@ -175,6 +202,8 @@ namespace QTPFS {
 		std::vector<SpeedModType> curSpeedMods;
 		std::vector<SpeedBinType> curSpeedBins;
 
+		RegionGraph regionGraph;
+
 public:
 		static constexpr unsigned int NUM_POOL_CHUNKS = sizeof(poolNodes) / sizeof(poolNodes[0]);
 		static constexpr unsigned int POOL_TOTAL_SIZE = (1024 * 1024) / 2;
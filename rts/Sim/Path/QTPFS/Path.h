@@ -30,6 +30,7 @@ namespace QTPFS {
 			int zmin = 0;
 			int xmax = 0;
 			int zmax = 0;
+			float moveCost = 0.f;
 			bool badNode = false;
 
 			bool IsNodeBad() const { return badNode; }
@@ -93,6 +94,7 @@ namespace QTPFS {
 
 			hash   = other.hash;
 			virtualHash = other.virtualHash;
+			goalHash = other.goalHash;
 			radius = other.radius;
 			synced = other.synced;
 			haveFullPath = other.haveFullPath;
@@ -125,6 +127,7 @@ namespace QTPFS {
 
 			hash   = other.hash;
 			virtualHash = other.virtualHash;
+			goalHash = other.goalHash;
 			radius = other.radius;
 			synced = other.synced;
 			haveFullPath = other.haveFullPath;
@@ -157,6 +160,7 @@ namespace QTPFS {
 
 		void SetHash(PathHashType hash) { this->hash = hash; }
 		void SetVirtualHash(PathHashType virtualHash) { this->virtualHash = virtualHash; }
+		void SetGoalHash(PathHashType goalHash) { this->goalHash = goalHash; }
 		void SetRadius(float radius) { this->radius = radius; }
 		void SetSynced(bool synced) { this->synced = synced; }
 		void SetHasFullPath(bool fullPath) { this->haveFullPath = fullPath; }
@@ -165,6 +169,7 @@ namespace QTPFS {
 		float GetRadius() const { return radius; }
 		PathHashType GetHash() const { return hash; }
 		PathHashType GetVirtualHash() const { return virtualHash; }
+		PathHashType GetGoalHash() const { return goalHash; }
 		bool IsSynced() const { return synced; }
 		bool IsFullPath() const { return haveFullPath; }
 		bool IsPartialPath() const { return havePartialPath; }
@@ -267,6 +272,8 @@ namespace QTPFS {
 			nodes[i].xmax = xmax;
 			nodes[i].zmax = zmax;
 		}
+
+		void SetNodeMoveCost(unsigned int i, float moveCost) { nodes[i].moveCost = moveCost; }
 		// There are always (points - 1) valid path nodes.
 		uint32_t GetGoodNodeCount() const { return points.size() - 1; };
 
@@ -352,6 +359,10 @@ namespace QTPFS {
 		// start and/or end in different, but close, quads. This is used to handle partially-
 		// shared path searches.
 		PathHashType virtualHash = BAD_HASH;
+
+		// Like virtualHash, but only identifies the layer and virtual target quad so that
+		// searches from anywhere towards the same goal (group move orders) can be combined.
+		PathHashType goalHash = BAD_HASH;
 		float radius = 0.f;
 
 		// Whether this AFFECTS synced state (like heatmaps and whatnot).
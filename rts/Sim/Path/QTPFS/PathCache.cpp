@@ -14,6 +14,7 @@
 #include "Sim/Misc/GlobalConstants.h"
 #include "Sim/Misc/CollisionHandler.h"
 #include "Sim/Misc/CollisionVolume.h"
+#include "Sim/Misc/ModInfo.h"
 #include "System/Log/ILog.h"
 #include "System/Rectangle.h"
 
@@ -77,9 +78,23 @@ bool QTPFS::PathCache::MarkDeadPaths(const SRectangle& r, const NodeLayer& nodeL
 	// deformation, for which some or all of its waypoints
 	// might now be invalid and need to be recomputed
 
+	// A path node that was re-tesselated into a leaf of the same size and cost is still as good
+	// as it was, so the path can keep it; only the pool index may need refreshing.
+	const bool incrementalRepair = modInfo.qtIncrementalPathRepair;
+	auto nodeSurvivedDamage = [&nodeLayer](QTPFS::IPath::PathNodeData& node) {
+		const QTPFS::INode* curNode = nodeLayer.GetNode(node.xmin, node.zmin);
+
+		if (curNode->xmin() != node.xmin || curNode->zmin() != node.zmin) { return false; }
+		if (curNode->xmax() != node.xmax || curNode->zmax() != node.zmax) { return false; }
+		if (curNode->GetMoveCost() != node.moveCost || curNode->IsExitOnly()) { return false; }
+
+		node.nodeId = curNode->GetIndex();
+		return true;
+	};
+
 	bool pathWasChecked = false;
-	auto testNodeDamage = [/*&testPathIntersect,*/ &nodeLayer, damagedNodeNumber, damageDepthMask, damageWidth, &pathWasChecked, &r]
-			( const QTPFS::IPath::PathNodeData& node
+	auto testNodeDamage = [/*&testPathIntersect,*/ &nodeLayer, &nodeSurvivedDamage, incrementalRepair, damagedNodeNumber, damageDepthMask, damageWidth, &pathWasChecked, &r]
+			( QTPFS::IPath::PathNodeData& node
 			, const IPath* path
 			, int i
 			) {
@@ -101,7 +116,7 @@ bool QTPFS::PathCache::MarkDeadPaths(const SRectangle& r, const NodeLayer& nodeL
 			bool nodesOverlap = ( damagedNodeNumber == (node.nodeNumber & damageDepthMask) );
 			// if (path->GetID() == 290455867)
 				// LOG("Damage mask=%x nodesOverlap=%d", damageDepthMask, int(nodesOverlap));
-			return nodesOverlap;
+			return nodesOverlap && !(incrementalRepair && !node.IsNodeBad() && nodeSurvivedDamage(node));
 		} else {
 			// the rect is sized to either 16x16 or the size of the quad it is in, so if the current node is bigger
 			// than the damage rect, then it can't possibly be overlapping - (damaged nodes are never revisited by a
@@ -191,7 +206,7 @@ bool QTPFS::PathCache::MarkDeadPaths(const SRectangle& r, const NodeLayer& nodeL
 		
 			// reverse search to determine where any path repair will be needed up to.
 			for (int i = pathNodeStart; i > pathGoodFromNodeId; --i) {
-				const QTPFS::IPath::PathNodeData& node = pathNodeList[i-1];
+				QTPFS::IPath::PathNodeData& node = pathNodeList[i-1];
 
 				// If the path is shared, then we need to check bad nodes so that path sharing can be stopped if required.
 				// Otherwise, bad nodes can be ignored.
@@ -242,7 +257,7 @@ bool QTPFS::PathCache::MarkDeadPaths(const SRectangle& r, const NodeLayer& nodeL
 				// 	LOG("%s: minIdx %d, maxIdx %d", __func__, minIdx, maxIdx);
 
 				for (unsigned int i = minIdx; i < maxIdx; i++) {
-					const QTPFS::IPath::PathNodeData& node = pathNodeList[i];
+					QTPFS::IPath::PathNodeData& node = pathNodeList[i];
 
 					// Bad nodes only occur at the end, if found, then stop. They do not affect the path the unit is
 					// following.
@@ -37,6 +37,14 @@ static constexpr uint32_t QTPFS_PARTIAL_SHARE_PATH_MAX_SIZE = 32;
 
 static constexpr uint32_t QTPFS_MAP_DAMAGE_SIZE = 16;
 
+// Side length (in heightmap squares) of the coarse regions used to guide long-distance
+// searches, and the minimum source-target distance (in regions) before they are used.
+static constexpr uint32_t QTPFS_REGION_SIZE = 64;
+static constexpr uint32_t QTPFS_REGION_SEARCH_MIN_DIST = 4;
+
+// Margin (in heightmap squares) a flow field extends beyond the units of its group.
+static constexpr int32_t QTPFS_FLOW_FIELD_AREA_MARGIN = 64;
+
 // Though there are four quads per level, having nothing is like a 5th state. So 3 bits, not 2, is needed per level.
 static constexpr uint32_t QTPFS_NODE_NUMBER_SHIFT_STEP = 3;
 
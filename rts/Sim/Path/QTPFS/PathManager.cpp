@@ -10,6 +10,9 @@
 #include <deque>
 #include <functional>
 
+#include "zlib.h"
+#include "minizip/zip.h"
+
 #include "System/Threading/ThreadPool.h"
 #include "System/Threading/SpringThreading.h"
 
@@ -21,15 +24,22 @@
 #include "Game/GameSetup.h"
 #include "Game/LoadScreen.h"
 #include "Map/MapInfo.h"
+#include "Map/ReadMap.h"
 
 #include "Sim/Misc/GlobalSynced.h"
+#include "Sim/Misc/GroundBlockingObjectMap.h"
 #include "Sim/Misc/ModInfo.h"
 #include "Sim/Misc/TeamHandler.h"
 #include "Sim/MoveTypes/MoveDefHandler.h"
 #include "Sim/MoveTypes/MoveMath/MoveMath.h"
 #include "Sim/Objects/SolidObject.h"
 #include "System/Config/ConfigHandler.h"
+#include "System/CRC.h"
+#include "System/FileSystem/Archives/IArchive.h"
+#include "System/FileSystem/ArchiveLoader.h"
 #include "System/FileSystem/ArchiveScanner.h"
+#include "System/FileSystem/DataDirsAccess.h"
+#include "System/FileSystem/FileQueryFlags.h"
 #include "System/FileSystem/FileSystem.h"
 #include "System/Log/ILog.h"
 #include "System/Platform/Threading.h"
@@ -57,6 +67,7 @@
 #define MAP_RECTANGLE SRectangle(0, 0,  mapDims.mapx, mapDims.mapy)
 
 CONFIG(int, PathingThreadCount).defaultValue(0).safemodeValue(1).minimumValue(0);
+CONFIG(bool, QTPFSNodeLayerCache).defaultValue(true).safemodeValue(false).description("Cache the initial QTPFS node-layer trees per map, game and movedefs in the cache directory.");
 
 namespace QTPFS {
 	struct PMLoadScreen {
@@ -196,13 +207,16 @@ QTPFS::PathManager::~PathManager() {
 	auto clearTrackers = [](auto& track){
 		track.damageMap.clear();
 		track.damageQueue.clear();
+		track.pathMap.clear();
 	};
 
 	pathTraces.clear();
+	flowFields.clear();
 	std::for_each(nodeLayersMapDamageTrack.mapChangeTrackers.begin(), nodeLayersMapDamageTrack.mapChangeTrackers.end(), clearTrackers);
 	nodeLayersMapDamageTrack.mapChangeTrackers.clear();
 	sharedPaths.clear();
 	partialSharedPaths.clear();
+	groupSharedPaths.clear();
 
 	// numCurrExecutedSearches.clear();
 	// numPrevExecutedSearches.clear();
@@ -250,6 +264,9 @@ void QTPFS::PathManager::InitStatic() {
 	{ auto view = registry.view<PartialSharedPathChain>();
 	  if (view.size() > 0) { LOG("%s: PartialSharedPathChain is unexpectedly greater than 0.", __func__); }
 	}
+	{ auto view = registry.view<GroupSharedPathChain>();
+	  if (view.size() > 0) { LOG("%s: GroupSharedPathChain is unexpectedly greater than 0.", __func__); }
+	}
 	{ auto view = registry.view<IPath>();
 	  if (view.size() > 0) { LOG("%s: IPath is unexpectedly greater than 0.", __func__); }
 	}
@@ -298,10 +315,14 @@ void QTPFS::PathManager::Load() {
 
 	nodeLayersMapDamageTrack.mapChangeTrackers.clear();
 	nodeLayersMapDamageTrack.mapChangeTrackers.reserve(numMoveDefs);
+
+	flowFields.clear();
+	flowFields.resize(numMoveDefs);
 	for (int i = 0; i < numMoveDefs; ++i) {
 		{
 			MapChangeTrack newChangeTrack;
 			newChangeTrack.damageMap.resize(nodeLayersMapDamageTrack.width*nodeLayersMapDamageTrack.height);
+			newChangeTrack.pathMap.resize(nodeLayersMapDamageTrack.width*nodeLayersMapDamageTrack.height);
 			nodeLayersMapDamageTrack.mapChangeTrackers.emplace_back(newChangeTrack);
 		}
 		nodeLayerUpdatePriorityOrder[i] = i;
@@ -405,6 +426,13 @@ std::uint64_t QTPFS::PathManager::GetMemFootPrint() const {
 	memFootPrint += pathTraces.size() * sizeof(decltype(pathTraces)::value_type);
 	memFootPrint += sharedPaths.size() * sizeof(decltype(sharedPaths)::value_type);
 	memFootPrint += partialSharedPaths.size() * sizeof(decltype(partialSharedPaths)::value_type);
+	memFootPrint += groupSharedPaths.size() * sizeof(decltype(groupSharedPaths)::value_type);
+
+	for (const auto& layerFlowFields : flowFields) {
+		for (const auto& flowFieldPair : layerFlowFields) {
+			memFootPrint += flowFieldPair.second.GetMemFootPrint();
+		}
+	}
 
 	memFootPrint += sizeof(nodeLayersMapDamageTrack);
 	memFootPrint += nodeLayersMapDamageTrack.mapChangeTrackers.size()
@@ -445,7 +473,18 @@ void QTPFS::PathManager::InitNodeLayersThreaded(const SRectangle& rect) {
 	// const char* pstFmtStr = "  initialized node-layer %u (%u MB, %u leafs, ratio %f)";
 	// #endif
 
-	for_mt(0, nodeLayers.size(), [this,&loadMsg, &rect](const int layerNum){
+	// layers found in the cache are restored instead of tesselated; those
+	// that were not are written back (as a whole file) afterwards
+	const bool useCache = configHandler->GetBool("QTPFSNodeLayerCache");
+	const std::uint32_t cacheHash = useCache? CalcNodeLayerCacheHash(): 0;
+
+	std::vector< std::vector<std::uint8_t> > layerCaches(nodeLayers.size());
+	std::vector<std::uint8_t> layersRestored(nodeLayers.size(), 0);
+
+	if (useCache && ReadNodeLayerCache(cacheHash, layerCaches))
+		pmLoadScreen.AddMessage("[PathManager] reading cached node-layers");
+
+	for_mt(0, nodeLayers.size(), [this,&loadMsg, &rect, &layerCaches, &layersRestored](const int layerNum){
 		int currentThread = ThreadPool::GetThreadNum();
 		// #ifndef NDEBUG
 		// snprintf(loadMsg, sizeof(loadMsg), preFmtStr, layerNum);
@@ -456,6 +495,21 @@ void QTPFS::PathManager::InitNodeLayersThreaded(const SRectangle& rect) {
 
 		InitNodeLayer(layerNum, rect);
 
+		if (!layerCaches[layerNum].empty()) {
+			if ((layersRestored[layerNum] = layer.ReadCache(layerCaches[layerNum])) != 0) {
+				pathCache.SetLayerPathCount(layerNum, INITIAL_PATH_RESERVE);
+
+				if (modInfo.qtHierarchicalSearch)
+					layer.InitRegionGraph();
+
+				return;
+			}
+
+			// corrupt entry, start over
+			layer.Clear();
+			InitNodeLayer(layerNum, rect);
+		}
+
 		INode* rootNode = layer.GetPoolNode(0);
 
 		std::vector<SRectangle> rootRects;
@@ -474,8 +528,21 @@ void QTPFS::PathManager::InitNodeLayersThreaded(const SRectangle& rect) {
 		std::for_each(rootRects.begin(), rootRects.end(), [this, layerNum, currentThread](auto &rect){
 			UpdateNodeLayer(layerNum, rect, currentThread);
 		});
+
+		// built once the whole layer is tesselated; kept current by UpdateNodeLayer from here on
+		if (modInfo.qtHierarchicalSearch)
+			layer.InitRegionGraph();
 	});
 
+	if (useCache && std::find(layersRestored.begin(), layersRestored.end(), 0) != layersRestored.end()) {
+		for_mt(0, nodeLayers.size(), [this, &layerCaches](const int layerNum){
+			layerCaches[layerNum].clear();
+			nodeLayers[layerNum].WriteCache(layerCaches[layerNum]);
+		});
+
+		WriteNodeLayerCache(cacheHash, layerCaches);
+	}
+
 	// Full map-wide allocations have been made, we shouldn't need that much memory in future.
 	for (int i = 0; i <ThreadPool::GetNumThreads(); ++i) {
 		updateThreadData[i].Reset();
@@ -484,6 +551,106 @@ void QTPFS::PathManager::InitNodeLayersThreaded(const SRectangle& rect) {
 	streflop::streflop_init<streflop::Simple>();
 }
 
+// bump when the layout written by NodeLayer::WriteCache changes
+static constexpr std::uint32_t NODE_LAYER_CACHE_VERSION = 1;
+
+static const std::string GetNodeLayerCacheFileName(std::uint32_t hash) {
+	const std::string pathCacheDir = FileSystem::GetCacheDir() + FileSystemAbstraction::GetNativePathSeparator() + "paths" + FileSystemAbstraction::GetNativePathSeparator();
+	return (pathCacheDir + mapInfo->map.name + ".qtpfs-" + IntToString(hash, "%x") + ".zip");
+}
+
+/**
+ * Returns a hash-code identifying everything the initial tesselation depends
+ * on: map and game archives, terrain, blocking objects placed before us, the
+ * movedefs and the QTPFS constants.
+ */
+std::uint32_t QTPFS::PathManager::CalcNodeLayerCacheHash() const {
+	RECOIL_DETAILED_TRACY_ZONE;
+	const sha512::raw_digest mapCheckSum = archiveScanner->GetArchiveCompleteChecksumBytes(gameSetup->mapName);
+	const sha512::raw_digest modCheckSum = archiveScanner->GetArchiveCompleteChecksumBytes(gameSetup->modName);
+
+	const std::uint32_t values[] = {
+		readMap->CalcHeightmapChecksum(),
+		readMap->CalcTypemapChecksum(),
+		moveDefHandler.GetCheckSum(),
+		groundBlockingObjectMap.CalcChecksum(),
+		static_cast<std::uint32_t>(moveDefHandler.GetNumMoveDefs()),
+		static_cast<std::uint32_t>(rootSize),
+		mapInfo->pfs.qtpfs_constants.minNodeSizeX,
+		mapInfo->pfs.qtpfs_constants.minNodeSizeZ,
+		mapInfo->pfs.qtpfs_constants.maxNodeDepth,
+		NodeLayer::NUM_SPEEDMOD_BINS,
+		static_cast<std::uint32_t>(NodeLayer::POOL_TOTAL_SIZE),
+		static_cast<std::uint32_t>(sizeof(QTNode::NeighbourPoints)),
+		NODE_LAYER_CACHE_VERSION,
+	};
+
+	CRC crc;
+	crc.Update(mapCheckSum.data(), mapCheckSum.size());
+	crc.Update(modCheckSum.data(), modCheckSum.size());
+	crc.Update(values, sizeof(values));
+	crc.Update(&NodeLayer::MIN_SPEEDMOD_VALUE, sizeof(NodeLayer::MIN_SPEEDMOD_VALUE));
+	crc.Update(&NodeLayer::MAX_SPEEDMOD_VALUE, sizeof(NodeLayer::MAX_SPEEDMOD_VALUE));
+
+	LOG("[QTPFS::%s] nodeLayerCacheHash=%x", __func__, crc.GetDigest());
+	return crc.GetDigest();
+}
+
+bool QTPFS::PathManager::ReadNodeLayerCache(std::uint32_t hash, std::vector< std::vector<std::uint8_t> >& layerCaches) const {
+	RECOIL_DETAILED_TRACY_ZONE;
+	const std::string cacheFileName = GetNodeLayerCacheFileName(hash);
+
+	LOG("[QTPFS::%s] file=\"%s\" (exists=%d)", __func__, cacheFileName.c_str(), FileSystem::FileExists(cacheFileName));
+
+	if (!FileSystem::FileExists(cacheFileName))
+		return false;
+
+	std::unique_ptr<IArchive> upfile(archiveLoader.OpenArchive(dataDirsAccess.LocateFile(cacheFileName), "sdz"));
+
+	if (upfile == nullptr || !upfile->IsOpen()) {
+		FileSystem::Remove(cacheFileName);
+		return false;
+	}
+
+	for (size_t layerNum = 0; layerNum < layerCaches.size(); layerNum++) {
+		const unsigned int fid = upfile->FindFile("layer" + IntToString(layerNum));
+
+		// missing or unreadable layers are simply rebuilt (and the file rewritten)
+		if (fid >= upfile->NumFiles() || !upfile->GetFile(fid, layerCaches[layerNum]))
+			layerCaches[layerNum].clear();
+	}
+
+	return true;
+}
+
+bool QTPFS::PathManager::WriteNodeLayerCache(std::uint32_t hash, const std::vector< std::vector<std::uint8_t> >& layerCaches) const {
+	RECOIL_DETAILED_TRACY_ZONE;
+	const std::string cacheFileName = GetNodeLayerCacheFileName(hash);
+
+	// we need this directory to exist
+	if (!FileSystem::CreateDirectory(FileSystem::GetDirectory(cacheFileName)))
+		return false;
+
+	LOG("[QTPFS::%s] file=\"%s\"", __func__, cacheFileName.c_str());
+
+	zipFile file = zipOpen(dataDirsAccess.LocateFile(cacheFileName, FileQueryFlags::WRITE).c_str(), APPEND_STATUS_CREATE);
+
+	if (file == nullptr)
+		return false;
+
+	for (size_t layerNum = 0; layerNum < layerCaches.size(); layerNum++) {
+		const std::string fileName = "layer" + IntToString(layerNum);
+
+		// mostly repetitive index data, compresses well even at the fastest level
+		zipOpenNewFileInZip(file, fileName.c_str(), nullptr, nullptr, 0, nullptr, 0, nullptr, Z_DEFLATED, Z_BEST_SPEED);
+		zipWriteInFileInZip(file, layerCaches[layerNum].data(), layerCaches[layerNum].size());
+		zipCloseFileInZip(file);
+	}
+
+	zipClose(file, nullptr);
+	return true;
+}
+
 void QTPFS::PathManager::InitRootSize(const SRectangle& r) {
 	RECOIL_DETAILED_TRACY_ZONE;
 	// setup the root node system
@@ -655,6 +822,15 @@ void QTPFS::PathManager::UpdateNodeLayer(unsigned int layerNum, const SRectangle
 		#ifndef QTPFS_CONSERVATIVE_NEIGHBOR_CACHE_UPDATES
 		nodeLayers[layerNum].ExecNodeNeighborCacheUpdates(ur, updateThreadData[currentThread]);
 		#endif
+
+		// no-op unless the region graph was built
+		nodeLayer.UpdateRegionGraph(re);
+
+		// node indices in the area may have been reused, fields are rebuilt by UpdateFlowFields
+		for (auto& flowFieldPair : flowFields[layerNum]) {
+			if (flowFieldPair.second.Intersects(re))
+				flowFieldPair.second.MarkDirty();
+		}
 	}
 }
 
@@ -698,6 +874,66 @@ void QTPFS::PathManager::MapChanged(int x1, int y1, int x2, int y2) {
 	}
 }
 
+// Moves the damaged sectors that lie on what is left of a synced path of the layer
+// to the front of its damage queue, so a burst of map damage first re-tesselates
+// the areas units are about to cross. The per-frame update budget is unchanged.
+void QTPFS::PathManager::PrioritizeMapDamageNearPaths() {
+	RECOIL_DETAILED_TRACY_ZONE;
+	auto& mapChangeTrackers = nodeLayersMapDamageTrack.mapChangeTrackers;
+
+	const int w = nodeLayersMapDamageTrack.width;
+	const int h = nodeLayersMapDamageTrack.height;
+	const float sectorSize = DAMAGE_MAP_BLOCK_SIZE * SQUARE_SIZE;
+
+	bool haveDamage = false;
+	for (auto& nlChangeTracker : mapChangeTrackers) {
+		if (nlChangeTracker.damageQueue.empty())
+			continue;
+
+		std::fill(nlChangeTracker.pathMap.begin(), nlChangeTracker.pathMap.end(), false);
+		haveDamage = true;
+	}
+
+	if (!haveDamage)
+		return;
+
+	auto markSector = [w, h, sectorSize](MapChangeTrack& nlChangeTracker, const float3& pos) {
+		const int x = std::clamp(int(pos.x / sectorSize), 0, w - 1);
+		const int z = std::clamp(int(pos.z / sectorSize), 0, h - 1);
+		nlChangeTracker.pathMap[x + z*w] = true;
+	};
+
+	auto pathView = registry.view<IPath>();
+	for (auto entity : pathView) {
+		const IPath& path = pathView.get<IPath>(entity);
+
+		// unsynced paths must not influence the (synced) update order
+		if (!path.IsSynced() || path.NumPoints() < 2)
+			continue;
+
+		auto& nlChangeTracker = mapChangeTrackers[path.GetPathType()];
+		if (nlChangeTracker.damageQueue.empty())
+			continue;
+
+		for (unsigned int i = std::max(path.GetNextPointIndex(), 1u); i < path.NumPoints(); ++i) {
+			const float3& p0 = path.GetPoint(i - 1);
+			const float3& p1 = path.GetPoint(i);
+			const int steps = int(p0.distance2D(p1) / sectorSize) + 1;
+
+			for (int s = 0; s <= steps; ++s) {
+				markSector(nlChangeTracker, mix(p0, p1, s / float(steps)));
+			}
+		}
+	}
+
+	for (auto& nlChangeTracker : mapChangeTrackers) {
+		auto& damageQueue = nlChangeTracker.damageQueue;
+		const auto& pathMap = nlChangeTracker.pathMap;
+
+		std::stable_partition(damageQueue.begin(), damageQueue.end(), [&pathMap](int sectorId) { return pathMap[sectorId]; });
+	}
+}
+
 void QTPFS::PathManager::Update() {
 	SCOPED_TIMER("Sim::Path");
 	{
@@ -712,6 +948,9 @@ void QTPFS::PathManager::Update() {
 
 		RequestMaxSpeedModRefreshForLayer(0);
 
+		if (modInfo.qtPrioritizeMapDamageNearPaths)
+			PrioritizeMapDamageNearPaths();
+
 		auto numBlocksToUpdate = [this](int layerNum) {
 			int blocksToUpdate = 0;
 			int updatedBlocks = nodeLayersMapDamageTrack.mapChangeTrackers[layerNum].damageQueue.size();
@@ -769,6 +1008,7 @@ void QTPFS::PathManager::Update() {
 				//if (dirtyPathDetail.clearSharing) {
 					RemovePathFromShared(pathEntity);
 					RemovePathFromPartialShared(pathEntity);
+					RemovePathFromGroupShared(pathEntity);
 				}
 
 					// The path may still be fine for owner, even if it can't be shared any more.
@@ -802,6 +1042,108 @@ void QTPFS::PathManager::Update() {
 		if (refreshDirtyPathRateFrame == QTPFS_LAST_FRAME && pathsMarkedDirty > 0)
 			refreshDirtyPathRateFrame = gs->frameNum + GAME_SPEED;
 	}
+	if (modInfo.qtFlowFieldMinGroupSize > 0) {
+		SCOPED_TIMER("Sim::Path::FlowFields");
+		UpdateFlowFields();
+	}
+}
+
+// Keeps a flow field for every group of paths sharing a goal (see GroupSharedPathChain) with
+// at least qtFlowFieldMinGroupSize owners, covering the owners and the goal. Fields are only
+// rebuilt when re-tesselation invalidated them or an owner has left the area they cover.
+void QTPFS::PathManager::UpdateFlowFields() {
+	RECOIL_DETAILED_TRACY_ZONE;
+	const int minGroupSize = modInfo.qtFlowFieldMinGroupSize;
+
+	// drop the fields of groups that no longer exist
+	for (auto& layerFlowFields : flowFields) {
+		for (auto iter = layerFlowFields.begin(); iter != layerFlowFields.end(); ) {
+			if (groupSharedPaths.find(iter->first) == groupSharedPaths.end()) {
+				iter = layerFlowFields.erase(iter);
+			} else {
+				++iter;
+			}
+		}
+	}
+
+	for (const auto& [goalHash, headEntity] : groupSharedPaths) {
+		const IPath* headPath = registry.try_get<IPath>(headEntity);
+		if (headPath == nullptr)
+			continue;
+
+		const int pathType = headPath->GetPathType();
+		const float3 goalPos = headPath->GetGoalPosition();
+
+		const int goalX = std::clamp(int(goalPos.x / SQUARE_SIZE), 0, mapDims.mapxm1);
+		const int goalZ = std::clamp(int(goalPos.z / SQUARE_SIZE), 0, mapDims.mapym1);
+
+		SRectangle groupArea(goalX, goalZ, goalX + 1, goalZ + 1);
+		int groupSize = 0;
+
+		QTPFS::entity curEntity = headEntity;
+		do {
+			const IPath& path = registry.get<IPath>(curEntity);
+			const CSolidObject* owner = path.GetOwner();
+
+			if (owner != nullptr) {
+				const int x = std::clamp(int(owner->pos.x / SQUARE_SIZE), 0, mapDims.mapxm1);
+				const int z = std::clamp(int(owner->pos.z / SQUARE_SIZE), 0, mapDims.mapym1);
+
+				groupArea.x1 = std::min(groupArea.x1, x);
+				groupArea.z1 = std::min(groupArea.z1, z);
+				groupArea.x2 = std::max(groupArea.x2, x + 1);
+				groupArea.z2 = std::max(groupArea.z2, z + 1);
+				groupSize++;
+			}
+
+			curEntity = registry.get<GroupSharedPathChain>(curEntity).next;
+		} while (curEntity != headEntity);
+
+		FlowFieldMap& layerFlowFields = flowFields[pathType];
+
+		if (groupSize < minGroupSize) {
+			layerFlowFields.erase(goalHash);
+			continue;
+		}
+
+		FlowField& flowField = layerFlowFields[goalHash];
+
+		if (!flowField.IsDirty() && flowField.Contains(groupArea))
+			continue;
+
+		// leave room for the group to spread out before the field has to grow
+		SRectangle fieldArea
+			( groupArea.x1 - QTPFS_FLOW_FIELD_AREA_MARGIN
+			, groupArea.z1 - QTPFS_FLOW_FIELD_AREA_MARGIN
+			, groupArea.x2 + QTPFS_FLOW_FIELD_AREA_MARGIN
+			, groupArea.z2 + QTPFS_FLOW_FIELD_AREA_MARGIN
+			);
+		fieldArea.ClampIn(SRectangle(0, 0, mapDims.mapx, mapDims.mapy));
+
+		flowField.Build(nodeLayers[pathType], goalPos, fieldArea, flowFieldQueue);
+	}
+}
+
+bool QTPFS::PathManager::GetFlowFieldDirection(unsigned int pathID, const float3& pos, float3& dir) const {
+	RECOIL_DETAILED_TRACY_ZONE;
+	if (!IsFinalized())
+		return false;
+
+	const QTPFS::entity pathEntity = QTPFS::entity(pathID);
+	if (!registry.valid(pathEntity))
+		return false;
+
+	const IPath* path = registry.try_get<IPath>(pathEntity);
+	if (path == nullptr || path->GetGoalHash() == QTPFS::BAD_HASH)
+		return false;
+
+	const FlowFieldMap& layerFlowFields = flowFields[path->GetPathType()];
+	const auto iter = layerFlowFields.find(path->GetGoalHash());
+
+	if (iter == layerFlowFields.end())
+		return false;
+
+	return (iter->second.GetDirection(nodeLayers[path->GetPathType()], pos, dir));
 }
 
 __FORCE_ALIGN_STACK__
@@ -835,6 +1177,7 @@ bool QTPFS::PathManager::InitializeSearch(QTPFS::entity searchEntity) {
 		search->Initialize(&nodeLayer, path->GetSourcePoint(), path->GetGoalPosition(), path->GetOwner());
 		path->SetHash(search->GetHash());
 		path->SetVirtualHash(search->GetPartialSearchHash());
+		path->SetGoalHash(search->GetGoalSearchHash());
 
 		// LOG("%s: search vhash %x%x", __func__, int(search->GetPartialSearchHash() >> 32), int(search->GetPartialSearchHash() & 32));
 		// LOG("%s: path vhash %x%x", __func__, int(path->GetVirtualHash() >> 32), int(path->GetVirtualHash() & 32));
@@ -862,6 +1205,16 @@ bool QTPFS::PathManager::InitializeSearch(QTPFS::entity searchEntity) {
 					linkedListHelper.InsertChain<PartialSharedPathChain>(partialSharedPaths[path->GetVirtualHash()], pathEntity);
 				}
 			}
+			if (search->GetGoalSearchHash() != QTPFS::BAD_HASH) {
+				assert(!registry.all_of<GroupSharedPathChain>(pathEntity));
+				GroupSharedPathMap::iterator groupSharedPathsIt = groupSharedPaths.find(path->GetGoalHash());
+				if (groupSharedPathsIt == groupSharedPaths.end()) {
+					registry.emplace<GroupSharedPathChain>(pathEntity, pathEntity, pathEntity);
+					groupSharedPaths[path->GetGoalHash()] = pathEntity;
+				} else {
+					linkedListHelper.InsertChain<GroupSharedPathChain>(groupSharedPaths[path->GetGoalHash()], pathEntity);
+				}
+			}
 		}
 
 		search->initialized = true;
@@ -931,6 +1284,7 @@ void QTPFS::PathManager::ExecuteQueuedSearches() {
 		if (!path->IsBoundingBoxOverriden() || path->GetNodeList().size() == 0) {
 			RemovePathFromShared(pathEntity);
 			RemovePathFromPartialShared(pathEntity);
+			RemovePathFromGroupShared(pathEntity);
 		}
 	};
 
@@ -947,15 +1301,28 @@ void QTPFS::PathManager::ExecuteQueuedSearches() {
 			if (path != nullptr) {
 				if (search->PathWasFound()) {
 					completePath(pathEntity, path);
+
+					// the unit can start on the provisional path; the full search is done next frame
+					if (search->provisionalPath) {
+						PathRequeueSearch* requeue = registry.try_get<PathRequeueSearch>(pathEntity);
+						if (requeue != nullptr)
+							requeue->value = true;
+					}
 					// LOG("%s: %x - path found", __func__, entt::to_integral(pathEntity));
 				} else {
 					if (search->rawPathCheck) {
+						const bool allowProvisionalPath = search->allowProvisionalPath;
+
 						registry.remove<PathSearchRef>(pathEntity);
 						registry.remove<PathIsDirty>(pathEntity);
 
 						// adding a new search doesn't break this loop because new paths do not
 						// have the tag ProcessPath and so don't impact this group view.
 						RequeueSearch(path, false, true, search->tryPathRepair);
+
+						// NOTE: search may have been invalidated by the new registry entry
+						if (allowProvisionalPath && registry.all_of<PathSearchRef>(pathEntity))
+							registry.get<PathSearch>(registry.get<PathSearchRef>(pathEntity).value).allowProvisionalPath = true;
 						// LOG("%s: %x - raw path check failed", __func__, entt::to_integral(pathEntity));
 					} else if (search->pathRequestWaiting) {
 						// nothing to do - it will be rerun next frame
@@ -1065,6 +1432,24 @@ bool QTPFS::PathManager::ExecuteSearch(
 
 				}
 			}
+
+			// No nearby search to share with, try one from elsewhere towards the same goal. Uses
+			// the partial search mechanism so a poor connection is rejected and searched in full.
+			if (!search->doPartialSearch) {
+				GroupSharedPathMap::const_iterator groupSharedPathsIt = groupSharedPaths.find(path->GetGoalHash());
+				if (groupSharedPathsIt != groupSharedPaths.end() && groupSharedPathsIt->second != pathEntity) {
+					assert(path->GetGoalHash() != QTPFS::BAD_HASH);
+					partialChainHeadEntity = groupSharedPathsIt->second;
+					bool pathIsCopyable = !registry.all_of<PathSearchRef>(partialChainHeadEntity);
+					if (!pathIsCopyable) {
+						search->pathRequestWaiting = true;
+						return false;
+					}
+
+					search->pathRequestWaiting = false;
+					search->doPartialSearch = true;
+				}
+			}
 		}
 		{
 			SharedPathMap::const_iterator sharedPathsIt = sharedPaths.find(path->GetHash());
@@ -1269,6 +1654,7 @@ unsigned int QTPFS::PathManager::QueueSearch(
 	newSearch->SetGoalDistance(newPath->GetRadius());
 	newSearch->rawPathCheck = allowRawSearch;
 	newSearch->allowPartialSearch = !allowRawSearch;
+	newSearch->allowProvisionalPath = (object != nullptr);
 	newSearch->initialized = false;
 	newSearch->synced = synced;
 
@@ -1319,6 +1705,7 @@ unsigned int QTPFS::PathManager::RequeueSearch(
 
 	RemovePathFromShared(pathEntity);
 	RemovePathFromPartialShared(pathEntity);
+	RemovePathFromGroupShared(pathEntity);
 
 	oldPath->SetHash(QTPFS::BAD_HASH);
 	// oldPath->SetNextPointIndex(0); - don't clear, will mess up active units.
@@ -1383,6 +1770,7 @@ void QTPFS::PathManager::DeletePathEntity(QTPFS::entity pathEntity) {
 
 	RemovePathFromShared(pathEntity);
 	RemovePathFromPartialShared(pathEntity);
+	RemovePathFromGroupShared(pathEntity);
 
 	// if (registry.valid(pathEntity)) - check is already done.
 	RemovePathSearch(pathEntity);
@@ -1416,6 +1804,26 @@ void QTPFS::PathManager::RemovePathFromShared(QTPFS::entity entity) {
 	linkedListHelper.RemoveChain<SharedPathChain>(entity);
 }
 
+void QTPFS::PathManager::RemovePathFromGroupShared(QTPFS::entity entity) {
+	RECOIL_DETAILED_TRACY_ZONE;
+	if (!registry.all_of<GroupSharedPathChain>(entity)) return;
+
+	IPath* path = &registry.get<IPath>(entity);
+	auto iter = groupSharedPaths.find(path->GetGoalHash());
+
+	// case: when entity is at the head of the chain.
+	if (iter != groupSharedPaths.end() && iter->second == entity) {
+		auto& chain = registry.get<GroupSharedPathChain>(entity);
+		if (chain.next == entity) {
+			groupSharedPaths.erase(path->GetGoalHash());
+		} else {
+			groupSharedPaths[path->GetGoalHash()] = chain.next;
+		}
+	}
+
+	linkedListHelper.RemoveChain<GroupSharedPathChain>(entity);
+}
+
 void QTPFS::PathManager::RemovePathFromPartialShared(QTPFS::entity entity) {
 	RECOIL_DETAILED_TRACY_ZONE;
 	// if (!registry.valid(entity)) return;
@@ -1540,6 +1948,16 @@ void QTPFS::PathManager::ClearPathUpdated(unsigned int pathID) {
 }
 
 
+bool QTPFS::PathManager::PathPending(unsigned int pathID) const {
+	RECOIL_DETAILED_TRACY_ZONE;
+	QTPFS::entity pathEntity = (QTPFS::entity)pathID;
+	if (!registry.valid(pathEntity)) { return false; }
+
+	// removed once the search completed, requeued searches keep it
+	return (registry.all_of<PathIsTemp>(pathEntity));
+}
+
+
 float3 QTPFS::PathManager::NextWayPoint(
 	const CSolidObject* owner,
 	unsigned int pathID,
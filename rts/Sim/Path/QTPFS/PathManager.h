@@ -7,6 +7,7 @@
 
 #include "Sim/Misc/ModInfo.h"
 #include "Sim/Path/IPathManager.h"
+#include "FlowField.h"
 #include "NodeLayer.h"
 #include "PathCache.h"
 #include "PathSearch.h"
@@ -27,6 +28,9 @@ namespace QTPFS {
 		struct MapChangeTrack {
 			std::vector<bool> damageMap;
 			std::deque<int> damageQueue;
+
+			// sectors crossed by the remaining part of a synced path of this layer
+			std::vector<bool> pathMap;
 		};
 		struct NodeLayersChangeTrack {
 			std::vector<MapChangeTrack> mapChangeTrackers;
@@ -47,6 +51,7 @@ namespace QTPFS {
 
 		bool PathUpdated(unsigned int pathID) override;
 		void ClearPathUpdated(unsigned int pathID) override;
+		bool PathPending(unsigned int pathID) const override;
 
 		bool AllowShortestPath() override { return true; }
 
@@ -86,6 +91,8 @@ namespace QTPFS {
 
 		int2 GetNumQueuedUpdates() const override;
 
+		bool GetFlowFieldDirection(unsigned int pathID, const float3& pos, float3& dir) const override;
+
 
 		const NodeLayer& GetNodeLayer(unsigned int pathType) const { return nodeLayers[pathType]; }
 		const NodeLayersChangeTrack& GetMapDamageTrack() const { return nodeLayersMapDamageTrack; };
@@ -113,18 +120,27 @@ namespace QTPFS {
 		typedef spring::unordered_map<PathHashType, QTPFS::entity>::iterator SharedPathMapIt;
 		typedef spring::unordered_map<PathHashType, QTPFS::entity> PartialSharedPathMap;
 		typedef spring::unordered_map<PathHashType, QTPFS::entity>::iterator PartialSharedPathMapIt;
+		typedef spring::unordered_map<PathHashType, QTPFS::entity> GroupSharedPathMap;
+		typedef spring::unordered_map<PathHashType, FlowField> FlowFieldMap;
 
 		typedef std::vector<PathSearch*> PathSearchVect;
 		typedef std::vector<PathSearch*>::iterator PathSearchVectIt;
 
 		void InitNodeLayersThreaded(const SRectangle& rect);
+
+		std::uint32_t CalcNodeLayerCacheHash() const;
+		bool ReadNodeLayerCache(std::uint32_t hash, std::vector< std::vector<std::uint8_t> >& layerCaches) const;
+		bool WriteNodeLayerCache(std::uint32_t hash, const std::vector< std::vector<std::uint8_t> >& layerCaches) const;
 		void InitNodeLayer(unsigned int layerNum, const SRectangle& r);
 		void InitRootSize(const SRectangle& r);
 		void UpdateNodeLayer(unsigned int layerNum, const SRectangle& r, int currentThread);
+		void PrioritizeMapDamageNearPaths();
+		void UpdateFlowFields();
 
 		bool InitializeSearch(QTPFS::entity searchEntity);
 		void RemovePathFromShared(QTPFS::entity entity);
 		void RemovePathFromPartialShared(QTPFS::entity entity);
+		void RemovePathFromGroupShared(QTPFS::entity entity);
 		void RemovePathSearch(QTPFS::entity pathEntity);
 
 		void ReadyQueuedSearches();
@@ -174,6 +190,11 @@ namespace QTPFS {
 		PathTraceMap pathTraces;
 		SharedPathMap sharedPaths;
 		PartialSharedPathMap partialSharedPaths;
+		GroupSharedPathMap groupSharedPaths;
+
+		// per layer, keyed by the goal hash of the group they serve
+		std::vector<FlowFieldMap> flowFields;
+		FlowField::FlowQueue flowFieldQueue;
 
 		// std::vector<unsigned int> numCurrExecutedSearches;
 		// std::vector<unsigned int> numPrevExecutedSearches;
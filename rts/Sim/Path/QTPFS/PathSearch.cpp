@@ -134,6 +134,7 @@ void QTPFS::PathSearch::Initialize(
 
 	pathSearchHash = GenerateHash(srcNode, tgtNode);
 	pathPartialSearchHash = GenerateVirtualHash(srcNode, tgtNode);
+	pathGoalSearchHash = GenerateGoalHash(tgtNode);
 
 	doPartialSearch = false;
 	pathRequestWaiting = false;
@@ -269,8 +270,7 @@ void QTPFS::PathSearch::InitializeThread(SearchThreadData* threadData) {
 		data.openNodes = &searchThreadData->openNodes[i];
 		data.minSearchNode = data.srcSearchNode;
 
-		while (!data.openNodes->empty())
-			data.openNodes->pop();
+		data.openNodes->clear();
 	}
 
 	// Set search boundaries for path repairs. If a repair cannot be made within the boundaries then the path is better
@@ -561,6 +561,12 @@ void QTPFS::PathSearch::InitStartingSearchNodes() {
 		int absoluteLimit = std::max(MAP_MAX_NODES_SEARCHED, modInfo.qtMaxNodesSearched);
 
 		fwdNodeSearchLimit = std::max(absoluteLimit, relativeLimit) >> 1;
+
+		// partial and repair searches are cheap already, only fresh searches are cut short
+		if (allowProvisionalPath && modInfo.qtProvisionalPathNodesSearched > 0 && !doPartialSearch && !doPathRepair)
+			provisionalNodeSearchLimit = std::max(modInfo.qtProvisionalPathNodesSearched >> 1, 1);
+
+		fwdNodeSearchLimit = std::min(fwdNodeSearchLimit, provisionalNodeSearchLimit);
 	} else {
 		fwdNodeSearchLimit = std::numeric_limits<int>::max();
 	}
@@ -617,6 +623,50 @@ void QTPFS::PathSearch::UpdateHcostMult() {
 	adjustedGoalDistance = (doPathRepair) ? -1.f : goalDistance * hCostMult;
 }
 
+void QTPFS::PathSearch::InitRegionHeuristic() {
+	RECOIL_DETAILED_TRACY_ZONE;
+	useRegionHeuristic = false;
+
+	if (!modInfo.qtHierarchicalSearch || hCostMult == 0.0f || doPathRepair)
+		return;
+
+	const RegionGraph& regionGraph = nodeLayer->GetRegionGraph();
+
+	if (!regionGraph.IsInitialized())
+		return;
+
+	const auto& fwd = directionalSearchData[SearchThreadData::SEARCH_FORWARD];
+	constexpr float minSearchDist = QTPFS_REGION_SIZE * QTPFS_REGION_SEARCH_MIN_DIST * SQUARE_SIZE;
+
+	// short searches don't run into enough obstacles to be worth it
+	if (fwd.srcPoint.SqDistance2D(fwd.tgtPoint) < Square(minSearchDist))
+		return;
+
+	// each direction is steered towards its own target, so the costs are
+	// measured outwards from the region that direction is searching for
+	for (int i = 0; i < SearchThreadData::SEARCH_DIRECTIONS; ++i) {
+		const auto& data = directionalSearchData[i];
+		const unsigned int srcRegion = regionGraph.GetRegionIndex(data.tgtPoint.x, data.tgtPoint.z);
+		const unsigned int tgtRegion = regionGraph.GetRegionIndex(data.srcPoint.x, data.srcPoint.z);
+
+		// disconnected regions, the search will find out for itself
+		if (!regionGraph.CalcRegionCosts(srcRegion, tgtRegion, searchThreadData->regionCosts[i], searchThreadData->regionQueue))
+			return;
+	}
+
+	// region costs are measured between region centers; the points being
+	// estimated and the target can lie anywhere within their regions
+	regionHeuristicSlack = QTPFS_REGION_SIZE * SQUARE_SIZE * 1.41421356f * hCostMult;
+	useRegionHeuristic = true;
+}
+
+float QTPFS::PathSearch::GetRegionHeuristic(unsigned int searchDir, const float2& point) const {
+	const RegionGraph& regionGraph = nodeLayer->GetRegionGraph();
+	const float regionCost = searchThreadData->regionCosts[searchDir][regionGraph.GetRegionIndex(point.x, point.y)];
+
+	return std::max(regionCost - regionHeuristicSlack, 0.0f);
+}
+
 void QTPFS::PathSearch::RemoveOutdatedOpenNodesFromQueue(int searchDir) {
 	RECOIL_DETAILED_TRACY_ZONE;
 	// Remove any out-of-date node entries in the queue.
@@ -682,6 +732,7 @@ void QTPFS::PathSearch::SetForwardSearchLimit() {
 
 	const float interp = std::clamp(dist / maxDist, 0.f, 1.f);
 	fwdNodeSearchLimit = std::max(minNodesSearched, int(limit * CircularEaseOut(interp)));
+	fwdNodeSearchLimit = std::min(fwdNodeSearchLimit, provisionalNodeSearchLimit);
 }
 
 // #pragma GCC push_options
@@ -695,6 +746,7 @@ bool QTPFS::PathSearch::ExecutePathSearch() {
 	#endif
 
 	UpdateHcostMult();
+	InitRegionHeuristic();
 	InitStartingSearchNodes();
 
 	auto& fwd = directionalSearchData[SearchThreadData::SEARCH_FORWARD];
@@ -1146,6 +1198,9 @@ bool QTPFS::PathSearch::ExecutePathSearch() {
 		}
 	}
 
+	// ran out of provisional budget rather than nodes to search; the path manager will requeue
+	provisionalPath = !haveFullPath && (std::max(fwdNodesSearched, bwdNodesSearched) >= size_t(provisionalNodeSearchLimit));
+
 	havePartPath = (fwd.minSearchNode != fwd.srcSearchNode)
 				// Normally now, we would count this as a part path to avoid units smashing against
 				// walls because elsewhere the pathing cannot fail, but as units can be trapped then
@@ -1474,7 +1529,11 @@ void QTPFS::PathSearch::IterateNodeNeighbors(const INode* curNode, unsigned int
 		float gCost =
 			curSearchNode->GetPathCost(NODE_PATH_COST_G) +
 			curNodeSanitizedCost * gDist;
-		const float hCost = hDist * hCostMult * float(!isTarget);
+		float hCost = hDist * hCostMult * float(!isTarget);
+
+		// long searches: never estimate less than the cost of following the region corridor
+		if (useRegionHeuristic && !isTarget)
+			hCost = std::max(hCost, GetRegionHeuristic(searchDir, netPoint));
 
 		if (isTarget) {
 			gCost += nxtNode->GetMoveCost() * hDist;
@@ -2032,6 +2091,7 @@ void QTPFS::PathSearch::TracePath(IPath* path) {
 
 		path->SetNode(nodeIndex, nodeId & ~ONLY_NODE_ID_MASK, curPoint.nodeNumber, float2(point.x, point.z), nodePointIndex, curPoint.isBad);
 		path->SetNodeBoundary(nodeIndex, curPoint.xmin, curPoint.zmin, curPoint.xmax, curPoint.zmax);
+		path->SetNodeMoveCost(nodeIndex, nodeLayer->GetPoolNode(nodeId & ~ONLY_NODE_ID_MASK)->GetMoveCost());
 
 		#ifndef NDEBUG
 		if (nodeIndex > 1) {
@@ -2638,6 +2698,25 @@ const QTPFS::PathHashType QTPFS::PathSearch::GenerateVirtualHash(const INode* sr
 	return GenerateHash2(vSrcNodeId, vTgtNodeId);
 }
 
+const QTPFS::PathHashType QTPFS::PathSearch::GenerateGoalHash(const INode* tgtNode) const {
+	RECOIL_DETAILED_TRACY_ZONE;
+	if (!modInfo.qtGroupPathSharing)
+		return BAD_HASH;
+
+	// same restrictions as partial sharing, group sharing reuses its mechanism
+	if (pathPartialSearchHash == BAD_HASH)
+		return BAD_HASH;
+
+	int tgtX = tgtNode->xmid();
+	int tgtZ = tgtNode->zmid();
+	INode* tgtRootNode = nodeLayer->GetRootNode(tgtX, tgtZ);
+
+	std::uint32_t vTgtNodeId = GenerateVirtualNodeNumber(*nodeLayer, tgtRootNode, QTPFS_PARTIAL_SHARE_PATH_MAX_SIZE, tgtX, tgtZ);
+
+	// any source, virtual node numbers never use all bits
+	return GenerateHash2(-1u, vTgtNodeId);
+}
+
 const QTPFS::PathHashType QTPFS::PathSearch::GenerateHash2(uint32_t src, uint32_t dest) const {
 	RECOIL_DETAILED_TRACY_ZONE;
 	std::uint64_t k = nodeLayer->GetNodelayer();
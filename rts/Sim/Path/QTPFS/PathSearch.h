@@ -3,6 +3,7 @@
 #ifndef QTPFS_PATHSEARCH_HDR
 #define QTPFS_PATHSEARCH_HDR
 
+#include <limits>
 #include <queue>
 #include <vector>
 
@@ -122,6 +123,7 @@ namespace QTPFS {
 
 		const PathHashType GetHash() const { return pathSearchHash; };
 		const PathHashType GetPartialSearchHash() const { return pathPartialSearchHash; };
+		const PathHashType GetGoalSearchHash() const { return pathGoalSearchHash; };
 
 		bool PathWasFound() const { return haveFullPath | havePartPath; }
 
@@ -177,6 +179,8 @@ namespace QTPFS {
 
 		void InitStartingSearchNodes();
 		void UpdateHcostMult();
+		void InitRegionHeuristic();
+		float GetRegionHeuristic(unsigned int searchDir, const float2& point) const;
 		void RemoveOutdatedOpenNodesFromQueue(int searchDir);
 		bool IsNodeActive(const SearchNode& curSearchNode) const;
 
@@ -191,6 +195,7 @@ namespace QTPFS {
 		const PathHashType GenerateHash2(uint32_t p1, uint32_t p2) const;
 
 		const PathHashType GenerateVirtualHash(const INode* srcNode, const INode* tgtNode) const;
+		const PathHashType GenerateGoalHash(const INode* tgtNode) const;
 
 		public:
 		static const std::uint32_t GenerateVirtualNodeNumber(const QTPFS::NodeLayer& nodeLayer, const INode* startNode, int nodeMaxSize, int x, int z, uint32_t* depth = nullptr);
@@ -209,6 +214,10 @@ namespace QTPFS {
 		// shared path searches.
 		PathHashType pathPartialSearchHash;
 
+		// Only the layer and virtual target quad of pathPartialSearchHash; used to partially
+		// share paths between searches with distant sources but a common goal.
+		PathHashType pathGoalSearchHash;
+
 		const CSolidObject* pathOwner;
 		NodeLayer* nodeLayer;
 		int pathType;
@@ -232,6 +241,7 @@ namespace QTPFS {
 		float hCosts[QTPFS_MAX_NETPOINTS_PER_NODE_EDGE];
 
 		float hCostMult;
+		float regionHeuristicSlack = 0.f;
 		float goalDistance = 0.f;
 		float adjustedGoalDistance;
 
@@ -239,6 +249,7 @@ namespace QTPFS {
 		int bwdStepIndex = 0;
 
 		int fwdNodeSearchLimit = 0;
+		int provisionalNodeSearchLimit = std::numeric_limits<int>::max();
 
 		size_t fwdNodesSearched = 0;
 		size_t bwdNodesSearched = 0;
@@ -246,6 +257,7 @@ namespace QTPFS {
 		bool haveFullPath;
 		bool havePartPath;
 		bool badGoal;
+		bool useRegionHeuristic = false;
 
 public:
 		bool rawPathCheck = false;
@@ -261,6 +273,11 @@ public:
 		bool partialReverseTrace = false;
 		bool doPathRepair = false;
 
+		// allowProvisionalPath: search may stop early on the provisional budget
+		// provisionalPath: it did, and the result should be refined next frame
+		bool allowProvisionalPath = false;
+		bool provisionalPath = false;
+
 		bool fwdPathConnected = false;
 		bool bwdPathConnected = false;
 		bool useFwdPathOnly = false;
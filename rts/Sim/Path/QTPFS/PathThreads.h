@@ -1,12 +1,16 @@
 #ifndef PATH_THREADS_H__
 #define PATH_THREADS_H__
 
+#include <bit>
+#include <cassert>
 #include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <queue>
 #include <vector>
 
 #include "Node.h"
+#include "NodeHeap.h"
 
 #include "Map/ReadMap.h"
 #include "Sim/MoveTypes/MoveDefHandler.h"
@@ -91,26 +95,31 @@ namespace QTPFS {
 
     struct SearchQueueNode {
         SearchQueueNode(int index, float newPriorty)
-            : heapPriority(newPriorty)
-            , nodeIndex(index)
+            : nodeIndex(index)
+            , heapPriority(newPriorty)
             {}
 
-        float heapPriority;
+        // Orders by (heapPriority, nodeIndex). Priorities are never negative, so the bits of the
+        // float sort like an unsigned int and with the index in the low half the whole entry is
+        // its own key (little-endian).
+        std::uint64_t GetSortKey() const {
+            assert(heapPriority >= 0.f);
+            return std::bit_cast<std::uint64_t>(*this);
+        }
+
         int nodeIndex;
+        float heapPriority;
     };
+    static_assert(sizeof(SearchQueueNode) == sizeof(std::uint64_t));
 
     /// Functor to define node priority.
     /// Needs to guarantee stable ordering, even if the sorting algorithm itself is not stable.
-    struct ShouldMoveTowardsBottomOfPriorityQueue {
-        inline bool operator() (const SearchQueueNode& lhs, const SearchQueueNode& rhs) const {
-            return std::tie(lhs.heapPriority, lhs.nodeIndex) > std::tie(rhs.heapPriority, rhs.nodeIndex);
-        }
+    struct SearchQueueNodeSortKey {
+        inline std::uint64_t operator() (const SearchQueueNode& node) const { return node.GetSortKey(); }
     };
 
-
-    // Reminder that std::priority does comparisons to push element back to the bottom. So using
-    // ShouldMoveTowardsBottomOfPriorityQueue here means the smallest value will be top()
-    typedef std::priority_queue<SearchQueueNode, std::vector<SearchQueueNode>, ShouldMoveTowardsBottomOfPriorityQueue> SearchPriorityQueue;
+    // smallest (heapPriority, nodeIndex) will be top()
+    typedef d_ary_heap<SearchQueueNode, SearchQueueNodeSortKey, 4> SearchPriorityQueue;
 
 	struct SearchThreadData {
 
@@ -121,6 +130,10 @@ namespace QTPFS {
 		SparseData<SearchNode> allSearchedNodes[SEARCH_DIRECTIONS];
         SearchPriorityQueue openNodes[SEARCH_DIRECTIONS];
         std::vector<INode*> tmpNodesStore;
+
+        // per-direction region-graph costs for long searches, see PathSearch::InitRegionHeuristic
+        std::vector<float> regionCosts[SEARCH_DIRECTIONS];
+        std::vector< std::pair<float, unsigned int> > regionQueue;
         int threadId = 0;
 
 		SearchThreadData(size_t nodeCount, int curThreadId)
@@ -130,7 +143,7 @@ namespace QTPFS {
 
         void ResetQueue() { ZoneScoped; for (int i=0; i<SEARCH_DIRECTIONS; ++i) ResetQueue(i); }
 
-        void ResetQueue(int i) { ZoneScoped; while (!openNodes[i].empty()) openNodes[i].pop(); }
+        void ResetQueue(int i) { ZoneScoped; openNodes[i].clear(); }
 
 		void Init(size_t sparseSize, size_t denseSize) {
             constexpr size_t tmpNodeStoreInitialReserve = 128;
@@ -148,9 +161,12 @@ namespace QTPFS {
 
             for (int i=0; i<SEARCH_DIRECTIONS; ++i) {
                 memFootPrint += allSearchedNodes[i].GetMemFootPrint();
-                memFootPrint += openNodes[i].size() * sizeof(std::remove_reference_t<decltype(openNodes[0])>::value_type);
+                memFootPrint += openNodes[i].capacity() * sizeof(std::remove_reference_t<decltype(openNodes[0])>::value_type);
             }
             memFootPrint += tmpNodesStore.size() * sizeof(decltype(tmpNodesStore)::value_type);
+            memFootPrint += regionQueue.capacity() * sizeof(decltype(regionQueue)::value_type);
+            for (int i=0; i<SEARCH_DIRECTIONS; ++i)
+                memFootPrint += regionCosts[i].capacity() * sizeof(float);
 
             return memFootPrint;
         }
@@ -158,6 +174,7 @@ namespace QTPFS {
 
     struct UpdateThreadData {
         std::vector<std::uint8_t> maxBlockBits;
+        std::vector<float> speedMods;
         std::vector<INode*> relinkNodeGrid;
         SRectangle areaRelinkedInner;
         SRectangle areaRelinked;
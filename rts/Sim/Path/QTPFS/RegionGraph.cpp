@@ -0,0 +1,216 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#include <algorithm>
+#include <cassert>
+#include <functional>
+
+#include "RegionGraph.h"
+#include "Node.h"
+#include "NodeLayer.h"
+
+#include "Sim/Misc/GlobalConstants.h"
+#include "System/Rectangle.h"
+#include "System/type2.h"
+
+#include "System/Misc/TracyDefs.h"
+
+static bool IsNodeEnterable(const QTPFS::INode* n) {
+	return (!n->AllSquaresImpassable() && !n->IsExitOnly());
+}
+
+
+void QTPFS::RegionGraph::Init(unsigned int mapxSize, unsigned int mapzSize) {
+	RECOIL_DETAILED_TRACY_ZONE;
+	xsize = mapxSize;
+	zsize = mapzSize;
+	xregions = (xsize + QTPFS_REGION_SIZE - 1) / QTPFS_REGION_SIZE;
+	zregions = (zsize + QTPFS_REGION_SIZE - 1) / QTPFS_REGION_SIZE;
+
+	regionMoveCosts.clear();
+	regionMoveCosts.resize(xregions * zregions, QTPFS_POSITIVE_INFINITY);
+	regionLinks.clear();
+	regionLinks.resize(xregions * zregions, 0);
+}
+
+void QTPFS::RegionGraph::Clear() {
+	regionMoveCosts.clear();
+	regionLinks.clear();
+}
+
+void QTPFS::RegionGraph::UpdateRegions(NodeLayer& nodeLayer, const SRectangle& area, std::vector<INode*>& tmpNodes) {
+	RECOIL_DETAILED_TRACY_ZONE;
+	if (!IsInitialized())
+		return;
+
+	// the links of the regions west and north of <area> point into it, so those are refreshed too
+	const unsigned int rx1 = std::max(area.x1 / int(QTPFS_REGION_SIZE) - 1, 0);
+	const unsigned int rz1 = std::max(area.z1 / int(QTPFS_REGION_SIZE) - 1, 0);
+	const unsigned int rx2 = std::min((area.x2 - 1) / QTPFS_REGION_SIZE, xregions - 1);
+	const unsigned int rz2 = std::min((area.z2 - 1) / QTPFS_REGION_SIZE, zregions - 1);
+
+	for (unsigned int rz = rz1; rz <= rz2; ++rz) {
+		for (unsigned int rx = rx1; rx <= rx2; ++rx) {
+			UpdateRegion(nodeLayer, rx, rz, tmpNodes);
+		}
+	}
+}
+
+void QTPFS::RegionGraph::UpdateRegion(NodeLayer& nodeLayer, unsigned int rx, unsigned int rz, std::vector<INode*>& tmpNodes) {
+	const unsigned int i = rz * xregions + rx;
+	const SRectangle r
+		( rx * QTPFS_REGION_SIZE
+		, rz * QTPFS_REGION_SIZE
+		, std::min((rx + 1) * QTPFS_REGION_SIZE, xsize)
+		, std::min((rz + 1) * QTPFS_REGION_SIZE, zsize)
+		);
+
+	nodeLayer.GetNodesInArea(r, tmpNodes);
+
+	// the cheapest cost keeps the region estimates from overshooting what
+	// the actual search finds when it squeezes through the region
+	float minMoveCost = QTPFS_POSITIVE_INFINITY;
+	for (const INode* n: tmpNodes) {
+		if (IsNodeEnterable(n))
+			minMoveCost = std::min(minMoveCost, n->GetMoveCost());
+	}
+
+	regionMoveCosts[i] = minMoveCost;
+	regionLinks[i] = 0;
+
+	if (!IsRegionOpen(i))
+		return;
+
+	if (rx + 1 < xregions && IsBorderPassable(nodeLayer, rx, rz, false))
+		regionLinks[i] |= REGION_LINK_EAST;
+	if (rz + 1 < zregions && IsBorderPassable(nodeLayer, rx, rz, true))
+		regionLinks[i] |= REGION_LINK_SOUTH;
+}
+
+bool QTPFS::RegionGraph::IsBorderPassable(const NodeLayer& nodeLayer, unsigned int rx, unsigned int rz, bool southBorder) const {
+	// walk along the border, stepping over the leaf-nodes on either side of it
+	if (southBorder) {
+		const unsigned int z = (rz + 1) * QTPFS_REGION_SIZE;
+		const unsigned int xend = std::min((rx + 1) * QTPFS_REGION_SIZE, xsize);
+
+		for (unsigned int x = rx * QTPFS_REGION_SIZE; x < xend; ) {
+			const INode* n0 = nodeLayer.GetNode(x, z - 1);
+			const INode* n1 = nodeLayer.GetNode(x, z    );
+
+			if (IsNodeEnterable(n0) && IsNodeEnterable(n1))
+				return true;
+
+			x = std::min(n0->xmax(), n1->xmax());
+		}
+	} else {
+		const unsigned int x = (rx + 1) * QTPFS_REGION_SIZE;
+		const unsigned int zend = std::min((rz + 1) * QTPFS_REGION_SIZE, zsize);
+
+		for (unsigned int z = rz * QTPFS_REGION_SIZE; z < zend; ) {
+			const INode* n0 = nodeLayer.GetNode(x - 1, z);
+			const INode* n1 = nodeLayer.GetNode(x    , z);
+
+			if (IsNodeEnterable(n0) && IsNodeEnterable(n1))
+				return true;
+
+			z = std::min(n0->zmax(), n1->zmax());
+		}
+	}
+
+	return false;
+}
+
+bool QTPFS::RegionGraph::HaveLink(unsigned int rx, unsigned int rz, int dx, int dz) const {
+	// callers guarantee (rx + dx, rz + dz) is on the map
+	if (dx > 0) return (regionLinks[rz * xregions + rx    ] & REGION_LINK_EAST);
+	if (dx < 0) return (regionLinks[rz * xregions + rx - 1] & REGION_LINK_EAST);
+	if (dz > 0) return (regionLinks[(rz    ) * xregions + rx] & REGION_LINK_SOUTH);
+	if (dz < 0) return (regionLinks[(rz - 1) * xregions + rx] & REGION_LINK_SOUTH);
+	return false;
+}
+
+bool QTPFS::RegionGraph::CalcRegionCosts(unsigned int srcRegion, unsigned int tgtRegion, std::vector<float>& regionCosts, RegionQueue& queue) const {
+	RECOIL_DETAILED_TRACY_ZONE;
+	constexpr float orthoDist = QTPFS_REGION_SIZE * SQUARE_SIZE;
+	constexpr float diagDist = orthoDist * 1.41421356f;
+
+	constexpr int2 dirs[] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}, {1, 1}, {-1, 1}, {1, -1}, {-1, -1}};
+	static_assert((sizeof(dirs) / sizeof(dirs[0])) == 8);
+
+	regionCosts.clear();
+	regionCosts.resize(GetNumRegions(), QTPFS_POSITIVE_INFINITY);
+	queue.clear();
+
+	if (srcRegion >= GetNumRegions() || !IsRegionOpen(srcRegion))
+		return false;
+
+	regionCosts[srcRegion] = 0.0f;
+	queue.emplace_back(0.0f, srcRegion);
+
+	float maxCost = 0.0f;
+
+	while (!queue.empty()) {
+		std::pop_heap(queue.begin(), queue.end(), std::greater<>{});
+		const auto [curCost, curRegion] = queue.back();
+		queue.pop_back();
+
+		if (curCost > regionCosts[curRegion])
+			continue;
+
+		maxCost = curCost;
+
+		const int rx = curRegion % xregions;
+		const int rz = curRegion / xregions;
+
+		for (const int2& dir: dirs) {
+			const int nx = rx + dir.x;
+			const int nz = rz + dir.y;
+
+			if (nx < 0 || nz < 0 || nx >= int(xregions) || nz >= int(zregions))
+				continue;
+
+			const bool isDiagonal = (dir.x != 0 && dir.y != 0);
+
+			// diagonal moves must be possible through at least one of the two orthogonal neighbours
+			if (isDiagonal) {
+				const bool viaX = HaveLink(rx, rz, dir.x, 0) && HaveLink(nx, rz, 0, dir.y);
+				const bool viaZ = HaveLink(rx, rz, 0, dir.y) && HaveLink(rx, nz, dir.x, 0);
+
+				if (!viaX && !viaZ)
+					continue;
+			} else if (!HaveLink(rx, rz, dir.x, dir.y)) {
+				continue;
+			}
+
+			const unsigned int nxtRegion = nz * xregions + nx;
+			const float edgeCost = (isDiagonal? diagDist: orthoDist) * 0.5f * (regionMoveCosts[curRegion] + regionMoveCosts[nxtRegion]);
+			const float nxtCost = curCost + edgeCost;
+
+			if (nxtCost >= regionCosts[nxtRegion])
+				continue;
+
+			regionCosts[nxtRegion] = nxtCost;
+			queue.emplace_back(nxtCost, nxtRegion);
+			std::push_heap(queue.begin(), queue.end(), std::greater<>{});
+		}
+	}
+
+	// unreachable regions must still compare worse than every reachable one
+	const float unreachableCost = maxCost * 2.0f + diagDist;
+	const bool tgtReachable = (tgtRegion < GetNumRegions() && regionCosts[tgtRegion] != QTPFS_POSITIVE_INFINITY);
+
+	for (float& cost: regionCosts) {
+		if (cost == QTPFS_POSITIVE_INFINITY)
+			cost = unreachableCost;
+	}
+
+	return tgtReachable;
+}
+
+unsigned int QTPFS::RegionGraph::GetRegionIndex(float x, float z) const {
+	constexpr float regionScale = 1.0f / (QTPFS_REGION_SIZE * SQUARE_SIZE);
+
+	const unsigned int rx = std::clamp(int(x * regionScale), 0, int(xregions) - 1);
+	const unsigned int rz = std::clamp(int(z * regionScale), 0, int(zregions) - 1);
+
+	return (rz * xregions + rx);
+}
@@ -0,0 +1,70 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#ifndef QTPFS_REGIONGRAPH_H_
+#define QTPFS_REGIONGRAPH_H_
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "PathDefines.h"
+
+struct SRectangle;
+
+namespace QTPFS {
+	struct INode;
+	struct NodeLayer;
+
+	// Coarse abstraction of a node-layer. The map is divided into regions of
+	// QTPFS_REGION_SIZE^2 squares; each region keeps the cheapest move-cost of
+	// its open leaf-nodes and whether an open leaf-node crosses (or links to
+	// one across) its east and south borders. Walking this graph gives a cheap
+	// estimate of the cost of going around obstacles, which long searches use
+	// to stay within the corridor of regions that actually lead to the goal.
+	struct RegionGraph {
+	public:
+		static constexpr std::uint8_t REGION_LINK_EAST  = 1;
+		static constexpr std::uint8_t REGION_LINK_SOUTH = 2;
+
+		typedef std::vector< std::pair<float, unsigned int> > RegionQueue;
+
+		void Init(unsigned int mapxSize, unsigned int mapzSize);
+		void Clear();
+
+		// expects the leaf-nodes covering <area> to be up to date
+		void UpdateRegions(NodeLayer& nodeLayer, const SRectangle& area, std::vector<INode*>& tmpNodes);
+
+		// Dijkstra over the regions starting from <srcRegion>; <regionCosts> receives the cost to reach
+		// each region (in the same units as search g-costs). Regions that cannot be reached are given a
+		// cost above that of any reachable region. Returns false if <tgtRegion> cannot be reached.
+		bool CalcRegionCosts(unsigned int srcRegion, unsigned int tgtRegion, std::vector<float>& regionCosts, RegionQueue& queue) const;
+
+		unsigned int GetRegionIndex(float x, float z) const;
+		unsigned int GetNumRegions() const { return (xregions * zregions); }
+
+		bool IsRegionOpen(unsigned int i) const { return (regionMoveCosts[i] != QTPFS_POSITIVE_INFINITY); }
+		bool IsInitialized() const { return (!regionMoveCosts.empty()); }
+
+		std::size_t GetMemFootPrint() const {
+			return (regionMoveCosts.size() * sizeof(decltype(regionMoveCosts)::value_type))
+				+ (regionLinks.size() * sizeof(decltype(regionLinks)::value_type));
+		}
+
+	private:
+		void UpdateRegion(NodeLayer& nodeLayer, unsigned int rx, unsigned int rz, std::vector<INode*>& tmpNodes);
+		bool IsBorderPassable(const NodeLayer& nodeLayer, unsigned int rx, unsigned int rz, bool southBorder) const;
+
+		bool HaveLink(unsigned int rx, unsigned int rz, int dx, int dz) const;
+
+	private:
+		std::vector<float> regionMoveCosts;
+		std::vector<std::uint8_t> regionLinks;
+
+		unsigned int xsize = 0;
+		unsigned int zsize = 0;
+		unsigned int xregions = 0;
+		unsigned int zregions = 0;
+	};
+}
+
+#endif
@@ -4,6 +4,7 @@
 #include <stdexcept>
 #include <cassert>
 #include <cinttypes>
+#include <cstring>
 
 #include "ExplosionGenerator.h"
 #include "ExpGenSpawner.h" //!!
@@ -370,6 +371,11 @@ bool CExplosionGeneratorHandler::GenExplosion(
 	if (expGen == nullptr)
 		return false;
 
+	#ifdef HEADLESS
+	// generators only spawn unsynced effects, which nothing would draw
+	return true;
+	#endif
+
 	return (expGen->Explosion(pos, dir, damage, radius, gfxMod, owner, hit, withMutex));
 }
 
@@ -730,6 +736,130 @@ void CCustomExplosionGenerator::ExecuteExplosionCode(const char* code, float dam
 
 
 
+// calls f(opcode, operands) for each instruction of <code> up to OP_END
+template<typename F>
+static void ForEachExplosionCodeOp(const std::string& code, F&& f)
+{
+	for (size_t i = 0; i < code.size(); ) {
+		const char op = code[i++];
+		const char* operands = &code[i];
+
+		switch (op) {
+			case CCustomExplosionGenerator::OP_END     : { return; } break;
+			case CCustomExplosionGenerator::OP_STOREI  : { i += 3; } break;
+			case CCustomExplosionGenerator::OP_STOREF  : { i += 3; } break;
+			case CCustomExplosionGenerator::OP_LOADP   : { i += sizeof(void*); } break;
+			case CCustomExplosionGenerator::OP_STOREP  : { i += 2; } break;
+			case CCustomExplosionGenerator::OP_DIR     : { i += 2; } break;
+			default                                    : { i += 4; } break;
+		}
+
+		f(op, operands);
+	}
+}
+
+// split the per-property code: properties without spawn-dependent operators
+// (random, damage, index, dir, or the shared buffer) are evaluated here once
+// and become plain byte copies, unless they overlap another property's store
+void CCustomExplosionGenerator::CompileExplosionCode(ProjectileSpawnInfo* psi, const std::vector<std::string>& propCodes)
+{
+	RECOIL_DETAILED_TRACY_ZONE;
+	struct StoreRange {
+		std::uint16_t offset;
+		std::uint8_t size;
+	};
+
+	std::vector< std::vector<StoreRange> > propStores(propCodes.size());
+	std::vector<bool> propConstant(propCodes.size(), true);
+
+	for (size_t n = 0; n < propCodes.size(); n++) {
+		ForEachExplosionCodeOp(propCodes[n], [&](char op, const char* operands) {
+			std::uint16_t ofs = 0;
+
+			switch (op) {
+				case OP_STOREI:
+				case OP_STOREF: {
+					std::memcpy(&ofs, operands + 1, sizeof(ofs));
+					propStores[n].push_back({ofs, *reinterpret_cast<const std::uint8_t*>(operands)});
+				} break;
+				case OP_STOREP: {
+					std::memcpy(&ofs, operands, sizeof(ofs));
+					propStores[n].push_back({ofs, sizeof(void*)});
+				} break;
+				case OP_DIR: {
+					std::memcpy(&ofs, operands, sizeof(ofs));
+					propStores[n].push_back({ofs, sizeof(float3)});
+					propConstant[n] = false;
+				} break;
+				case OP_RAND:
+				case OP_DAMAGE:
+				case OP_INDEX:
+				case OP_YANK:
+				case OP_MULTIPLY:
+				case OP_ADDBUFF:
+				case OP_POWBUFF: {
+					propConstant[n] = false;
+				} break;
+				default: {
+				} break;
+			}
+		});
+	}
+
+	const auto Overlaps = [](const StoreRange& a, const StoreRange& b) {
+		return (a.offset < (b.offset + b.size) && b.offset < (a.offset + a.size));
+	};
+
+	alignas(PMP_ALIGN) char scratch[PMP_S];
+
+	std::string code;
+
+	psi->paramStores.clear();
+
+	for (size_t n = 0; n < propCodes.size(); n++) {
+		bool constant = propConstant[n];
+
+		for (size_t m = 0; m < propCodes.size() && constant; m++) {
+			if (m == n)
+				continue;
+
+			for (const StoreRange& a: propStores[n]) {
+				for (const StoreRange& b: propStores[m]) {
+					constant &= !Overlaps(a, b);
+				}
+			}
+		}
+
+		for (const StoreRange& sr: propStores[n]) {
+			constant &= ((sr.offset + sr.size) <= sizeof(scratch) && sr.size <= sizeof(ProjectileSpawnInfo::ParamStore::data));
+		}
+
+		if (!constant) {
+			code += propCodes[n];
+			continue;
+		}
+
+		// none of the inputs are used, so any will do
+		const std::string propCode = propCodes[n] + (char) OP_END;
+
+		ExecuteExplosionCode(propCode.data(), 0.0f, &scratch[0], 0, ZeroVector);
+
+		for (const StoreRange& sr: propStores[n]) {
+			ProjectileSpawnInfo::ParamStore& ps = psi->paramStores.emplace_back();
+
+			ps.offset = sr.offset;
+			ps.size = sr.size;
+
+			std::memcpy(ps.data.data(), &scratch[sr.offset], sr.size);
+		}
+	}
+
+	code += (char) OP_END;
+
+	psi->code.assign(code.begin(), code.end());
+}
+
+
 void CCustomExplosionGenerator::ParseExplosionCode(
 	CCustomExplosionGenerator::ProjectileSpawnInfo* psi,
 	const string& script,
@@ -906,7 +1036,7 @@ bool CCustomExplosionGenerator::Load(CExplosionGeneratorHandler* handler, const
 		psi.flags = GetFlagsFromTable(spawnTable);
 		psi.count = std::max(0, spawnTable.GetInt("count", 1));
 
-		std::string code;
+		std::vector<std::string> propCodes;
 		spring::unordered_map<string, string> props;
 
 		spawnTable.SubTable("properties").GetMap(props);
@@ -939,16 +1069,14 @@ bool CCustomExplosionGenerator::Load(CExplosionGeneratorHandler* handler, const
 			SExpGenSpawnableMemberInfo memberInfo = { 0, 0, 0, STRING_HASH(std::move(StringToLower(key))), SExpGenSpawnableMemberInfo::TYPE_INT, nullptr };
 
 			if (CExpGenSpawnable::GetSpawnableMemberInfo(className, memberInfo)) {
-				ParseExplosionCode(&psi, val, memberInfo, code);
+				ParseExplosionCode(&psi, val, memberInfo, propCodes.emplace_back());
 			}
 			else {
 				LOG_L(L_WARNING, "[CCEG::%s] unknown field %s::%s in spawn-table \"%s\" for CEG \"%s\"", __func__, tag, key.c_str(), spawnName.c_str(), className.c_str());
 			}
 		}
 
-		code += (char)OP_END;
-		psi.code.resize(code.size());
-		copy(code.begin(), code.end(), psi.code.begin());
+		CompileExplosionCode(&psi, propCodes);
 
 		expGenParams.projectiles.push_back(psi);
 	}
@@ -1026,6 +1154,11 @@ bool CCustomExplosionGenerator::Explosion(
 
 		for (unsigned int c = 0; c < psi.count; c++) {
 			CExpGenSpawnable* projectile = CExpGenSpawnable::CreateSpawnable(psi.spawnableID);
+
+			for (const ProjectileSpawnInfo::ParamStore& ps: psi.paramStores) {
+				std::memcpy(reinterpret_cast<char*>(projectile) + ps.offset, ps.data.data(), ps.size);
+			}
+
 			ExecuteExplosionCode(&psi.code[0], damage, (char*) projectile, c, dir);
 			projectile->Init(owner, pos);
 		}
@@ -3,6 +3,8 @@
 #ifndef EXPLOSION_GENERATOR_H
 #define EXPLOSION_GENERATOR_H
 
+#include <array>
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -150,7 +152,17 @@ protected:
 		unsigned int count = 0;
 		unsigned int flags = 0;
 
-		/// parsed explosion script code
+		/// properties that evaluate to the same bytes for every spawn,
+		/// computed once at load and copied into each new instance
+		struct ParamStore {
+			std::uint16_t offset = 0;
+			std::uint8_t size = 0;
+			std::array<char, 8> data = {};
+		};
+
+		std::vector<ParamStore> paramStores;
+
+		/// parsed explosion script code for the remaining properties
 		std::vector<char> code;
 	};
 
@@ -219,6 +231,7 @@ public:
 private:
 	void ParseExplosionCode(ProjectileSpawnInfo* psi, const std::string& script, SExpGenSpawnableMemberInfo& memberInfo, std::string& code);
 	void ExecuteExplosionCode(const char* code, float damage, char* instance, int spawnIndex, const float3& dir);
+	void CompileExplosionCode(ProjectileSpawnInfo* psi, const std::vector<std::string>& propCodes);
 
 protected:
 	ExpGenParams expGenParams;
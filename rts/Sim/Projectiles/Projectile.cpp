@@ -1,5 +1,7 @@
 /* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
 
+#include <utility>
+
 #include "Projectile.h"
 #include "Map/MapInfo.h"
 #include "Rendering/Colors.h"
@@ -31,6 +33,7 @@ CR_REG_METADATA(CProjectile,
 
 	CR_IGNORED(createMe),
 	CR_MEMBER(deleteMe),
+	CR_IGNORED(kinematicsUpdated),
 
 	CR_MEMBER(drawSorted),
 
@@ -148,11 +151,25 @@ void CProjectile::Init(const CUnit* owner, const float3& offset)
 void CProjectile::Update()
 {
 	RECOIL_DETAILED_TRACY_ZONE;
+	// always consume the flag, Lua may have taken control since it was set
+	const bool integrated = std::exchange(kinematicsUpdated, false);
+
+	if (luaMoveCtrl || integrated)
+		return;
+
+	SetVelocityAndSpeed(speed + (UpVector * mygravity));
+	SetPosition(pos + speed);
+}
+
+void CProjectile::UpdateKinematics()
+{
 	if (luaMoveCtrl)
 		return;
 
 	SetVelocityAndSpeed(speed + (UpVector * mygravity));
 	SetPosition(pos + speed);
+
+	kinematicsUpdated = true;
 }
 
 
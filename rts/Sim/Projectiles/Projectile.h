@@ -47,6 +47,9 @@ public:
 	void Delete();
 	virtual void PreUpdate();
 	virtual void Update();
+	// the ballistic step of CProjectile::Update, run ahead of time by
+	// ProjectileHandler for a batch of projectiles; Update then skips it
+	void UpdateKinematics();
 	virtual void Init(const CUnit* owner, const float3& offset) override;
 
 	virtual void Draw() {}
@@ -111,6 +114,7 @@ public:
 
 	bool createMe =  true;
 	bool deleteMe = false;
+	bool kinematicsUpdated = false; // set by UpdateKinematics, consumed by Update
 
 	bool castShadow = false;
 	bool drawSorted = true;
@@ -5,6 +5,7 @@
 #include "Projectile.h"
 #include "ProjectileHandler.h"
 #include "ProjectileMemPool.h"
+#include "Game/GameHelper.h"
 #include "Game/GlobalUnsynced.h"
 #include "Game/TraceRay.h"
 #include "Map/Ground.h"
@@ -15,6 +16,7 @@
 #include "Sim/Misc/CollisionHandler.h"
 #include "Sim/Misc/CollisionVolume.h"
 #include "Sim/Misc/GlobalSynced.h"
+#include "Sim/Misc/ModInfo.h"
 #include "Sim/Misc/QuadField.h"
 #include "Sim/Misc/TeamHandler.h"
 #include "Rendering/Env/Particles/Classes/NanoProjectile.h"
@@ -27,6 +29,7 @@
 #include "System/Config/ConfigHandler.h"
 #include "System/EventHandler.h"
 #include "System/Log/ILog.h"
+#include "System/MemPoolStats.h"
 #include "System/Cpp11Compat.hpp"
 #include "System/SpringMath.h"
 #include "System/TimeProfiler.h"
@@ -55,13 +58,19 @@ CR_REG_METADATA(CProjectileHandler, (
 	CR_MEMBER(maxNanoParticles),
 	CR_MEMBER(currentNanoParticles),
 	CR_MEMBER_UN(frameCurrentParticles),
-	CR_MEMBER_UN(frameProjectileCounts)
+	CR_MEMBER_UN(frameProjectileCounts),
+	CR_IGNORED(collisionCandidates),
+	CR_IGNORED(shieldCoverageSets),
+	CR_IGNORED(shieldCoverageIndices),
+	CR_IGNORED(numShieldCoverageSets),
+	CR_IGNORED(shieldCoverageChanges)
 ))
 
 
 
 // note: stores all ExpGenSpawnable types, not just projectiles
 ProjMemPool projMemPool;
+static MemPoolRegistrar projMemPoolRegistrar("Projectiles", projMemPool);
 
 CProjectileHandler projectileHandler;
 
@@ -108,6 +117,11 @@ void CProjectileHandler::Kill()
 			projMemPool.free(p);
 
 		projectiles[true].clear();
+		collisionCandidates.clear();
+
+		shieldCoverageSets.clear();
+		shieldCoverageIndices.clear();
+		numShieldCoverageSets = 0;
 	}
 
 	{
@@ -192,13 +206,41 @@ void CProjectileHandler::UpdateProjectilesImpl()
 	// WARNING: same as above but for p->Update()
 	if constexpr (synced) {
 
+		// projectiles that exist now get their PreUpdate (interpolation state only)
+		// on the thread-pool; ones spawned by an Update below get it in the serial
+		// loop. With projectileUpdateMT the ballistic step of explosive projectiles
+		// is done here too, everything else (ttl, interception, collisions, events,
+		// quad-field moves) still runs serially and in container order
+		const size_t numPreUpdated = pc.size();
+
+		{
+			SCOPED_TIMER("Sim::Projectiles::UpdateSyncedMT");
+
+			if (modInfo.projectileUpdateMT) {
+				for_mt_chunk(0, numPreUpdated, [&pc](int i) {
+					CProjectile* p = pc[i];
+
+					p->PreUpdate();
+
+					if (p->GetProjectileType() == WEAPON_EXPLOSIVE_PROJECTILE)
+						p->UpdateKinematics();
+				});
+			} else {
+				for_mt_chunk(0, numPreUpdated, [&pc](int i) {
+					pc[i]->PreUpdate();
+				});
+			}
+		}
+
 		SCOPED_TIMER("Sim::Projectiles::UpdateSyncedST");
 		for (size_t i = 0; i < pc.size(); ++i) {
 			CProjectile* p = pc[i];
 			assert(p != nullptr);
 
 			MAPPOS_SANITY_CHECK(p->pos);
-			p->PreUpdate();
+			if (i >= numPreUpdated)
+				p->PreUpdate();
+
 			p->Update();
 			quadField.MovedProjectile(p);
 
@@ -425,6 +467,23 @@ static bool CheckProjectileCollisionFlags(const CProjectile* p, const CUnit* u)
 }
 
 
+// indices (in order) of the objects whose hit-test sphere the segment touches;
+// DetectHit can not succeed for the others, so they need not be tested
+template<typename T>
+static const std::vector<uint32_t>& GetHitTestCandidates(const std::vector<T*>& objects, const float3& p0, const float3& p1)
+{
+	static CollisionSphereBatch hitTestSpheres;
+	static std::vector<uint32_t> hitTestIndices;
+
+	hitTestSpheres.Clear();
+
+	for (const T* o: objects)
+		hitTestSpheres.Add(CCollisionHandler::GetHitTestSphere(o));
+
+	CCollisionHandler::SegmentSpheresOverlap(p0, p1, hitTestSpheres, hitTestIndices);
+	return hitTestIndices;
+}
+
 void CProjectileHandler::CheckUnitCollisions(
 	CProjectile* p,
 	std::vector<CUnit*>& tempUnits,
@@ -437,7 +496,8 @@ void CProjectileHandler::CheckUnitCollisions(
 
 	CollisionQuery cq;
 
-	for (CUnit* unit: tempUnits) {
+	for (const uint32_t unitIdx: GetHitTestCandidates(tempUnits, ppos0, ppos1)) {
+		CUnit* unit = tempUnits[unitIdx];
 		assert(unit != nullptr);
 
 		// if this unit fired this projectile, always ignore
@@ -482,7 +542,8 @@ void CProjectileHandler::CheckFeatureCollisions(
 
 	CollisionQuery cq;
 
-	for (CFeature* feature: tempFeatures) {
+	for (const uint32_t featureIdx: GetHitTestCandidates(tempFeatures, ppos0, ppos1)) {
+		CFeature* feature = tempFeatures[featureIdx];
 		assert(feature != nullptr);
 
 		if (!feature->HasCollidableStateBit(CSolidObject::CSTATE_BIT_PROJECTILES))
@@ -531,7 +592,7 @@ void CProjectileHandler::CheckShieldCollisions(
 
 	CollisionQuery cq;
 
-	for (CPlasmaRepulser* repulser: tempRepulsers) {
+	for (CPlasmaRepulser* repulser: (modInfo.shieldCoverageCache? GetCoveringShields(wpro): tempRepulsers)) {
 		assert(repulser != nullptr);
 
 		if (!repulser->CanIntercept(interceptType, projAllyTeam))
@@ -560,6 +621,55 @@ void CProjectileHandler::CheckShieldCollisions(
 	}
 }
 
+const std::vector<CPlasmaRepulser*>& CProjectileHandler::GetCoveringShields(CWeaponProjectile* p)
+{
+	RECOIL_DETAILED_TRACY_ZONE;
+	static std::vector<CPlasmaRepulser*> coveringShields;
+
+	const float radius = p->speed.w + p->radius;
+	const uint64_t coverageKey = quadField.GetQuadRectKey(p->pos, radius);
+	const unsigned int numRepulserChanges = quadField.GetNumRepulserChanges();
+
+	if (shieldCoverageChanges != numRepulserChanges) {
+		// shields entered or left quads, every set is rebuilt on demand
+		shieldCoverageIndices.clear();
+
+		numShieldCoverageSets = 0;
+		shieldCoverageChanges = numRepulserChanges;
+	}
+
+	// only look the set up again if the projectile reaches into other quads
+	if (p->shieldCoverageIdx < 0 || p->shieldCoverageKey != coverageKey || p->shieldCoverageChanges != numRepulserChanges) {
+		auto iter = shieldCoverageIndices.find(coverageKey);
+
+		if (iter == shieldCoverageIndices.end()) {
+			if (numShieldCoverageSets == shieldCoverageSets.size())
+				shieldCoverageSets.emplace_back();
+
+			quadField.GetQuadRectRepulsers(coverageKey, shieldCoverageSets[numShieldCoverageSets]);
+			iter = shieldCoverageIndices.emplace(coverageKey, numShieldCoverageSets++).first;
+		}
+
+		p->shieldCoverageKey = coverageKey;
+		p->shieldCoverageIdx = iter->second;
+		p->shieldCoverageChanges = numRepulserChanges;
+	}
+
+	coveringShields.clear();
+
+	// same range test as GetUnitsAndFeaturesColVol
+	for (CPlasmaRepulser* r: shieldCoverageSets[p->shieldCoverageIdx]) {
+		const float totRad = radius + r->collisionVolume.GetBoundingRadius();
+
+		if (p->pos.SqDistance(r->weaponMuzzlePos) >= (totRad * totRad))
+			continue;
+
+		coveringShields.push_back(r);
+	}
+
+	return coveringShields;
+}
+
 void CProjectileHandler::CheckUnitFeatureCollisions(bool synced)
 {
 	RECOIL_DETAILED_TRACY_ZONE;
@@ -567,6 +677,33 @@ void CProjectileHandler::CheckUnitFeatureCollisions(bool synced)
 	static std::vector<CFeature*> tempFeatures;
 	static std::vector<CPlasmaRepulser*> tempRepulsers;
 
+	// gather the broadphase candidates of all projectiles that exist now up front
+	// on the thread-pool; ones created by a collision below still query serially.
+	// the hit-tests and their consequences run in container order as before, but
+	// see candidates as of the start of the pass (hence synced-only and optional)
+	const size_t numGathered = (synced && modInfo.projectileCollisionMT)? projectiles[synced].size(): 0;
+	// shields come from GetCoveringShields instead
+	const bool shieldCoverage = modInfo.shieldCoverageCache;
+
+	if (numGathered > 0) {
+		SCOPED_TIMER("Sim::Projectiles::Collisions::GatherMT");
+		collisionCandidates.resize(std::max(collisionCandidates.size(), numGathered));
+
+		for_mt_chunk(0, numGathered, [this, shieldCoverage](int i) {
+			const CProjectile* p = projectiles[true][i];
+			CollisionCandidates& cc = collisionCandidates[i];
+
+			cc.units.clear();
+			cc.features.clear();
+			cc.repulsers.clear();
+
+			if (!p->checkCol) return;
+			if ( p->deleteMe) return;
+
+			quadField.GetUnitsAndFeaturesColVol(p->pos, p->speed.w + p->radius, cc.units, cc.features, shieldCoverage? nullptr: &cc.repulsers, ThreadPool::GetThreadNum());
+		});
+	}
+
 	//can't use iterators here, because instructions inside the loop modify projectiles[synced]
 	for (size_t i = 0; i < projectiles[synced].size(); ++i) {
 		CProjectile* p = projectiles[synced][i];
@@ -578,7 +715,16 @@ void CProjectileHandler::CheckUnitFeatureCollisions(bool synced)
 		const float3 ppos1 = p->pos + p->speed;
 		// const float3 ppos1 = p->pos + p->dir * (p->speed.w + p->radius);
 
-		quadField.GetUnitsAndFeaturesColVol(p->pos, p->speed.w + p->radius, tempUnits, tempFeatures, &tempRepulsers);
+		if (i < numGathered) {
+			CollisionCandidates& cc = collisionCandidates[i];
+
+			CheckShieldCollisions (p, cc.repulsers, ppos0, ppos1);
+			CheckUnitCollisions   (p, cc.units    , ppos0, ppos1);
+			CheckFeatureCollisions(p, cc.features , ppos0, ppos1);
+			continue;
+		}
+
+		quadField.GetUnitsAndFeaturesColVol(p->pos, p->speed.w + p->radius, tempUnits, tempFeatures, shieldCoverage? nullptr: &tempRepulsers);
 
 		CheckShieldCollisions (p, tempRepulsers, ppos0, ppos1); tempRepulsers.clear();
 		CheckUnitCollisions   (p, tempUnits    , ppos0, ppos1); tempUnits.clear();
@@ -635,10 +781,15 @@ void CProjectileHandler::CheckCollisions()
 {
 	SCOPED_TIMER("Sim::Projectiles::Collisions");
 
+	helper->BeginExplosionBatch();
+
 	CheckUnitFeatureCollisions(true ); // changes simulation state
 	CheckUnitFeatureCollisions(false); // does not change simulation state
 
 	CheckGroundCollisions(true ); // changes simulation state
+
+	helper->EndExplosionBatch();
+
 	CheckGroundCollisions(false); // does not change simulation state
 }
 
@@ -667,6 +818,10 @@ void CProjectileHandler::AddNanoParticle(
 	bool highPriority
 ) {
 	RECOIL_DETAILED_TRACY_ZONE;
+	#ifdef HEADLESS
+	return;
+	#endif
+
 	const float priority = mix(NORMAL_NANO_PRIO, HIGH_NANO_PRIO, highPriority);
 	const float emitProb = 1.0f - GetNanoParticleSaturation(priority);
 
@@ -705,6 +860,10 @@ void CProjectileHandler::AddNanoParticle(
 	bool highPriority
 ) {
 	RECOIL_DETAILED_TRACY_ZONE;
+	#ifdef HEADLESS
+	return;
+	#endif
+
 	const float priority = mix(NORMAL_NANO_PRIO, HIGH_NANO_PRIO, highPriority);
 	const float emitProb = 1.0f - GetNanoParticleSaturation(priority);
 
@@ -10,12 +10,14 @@
 #include "Rendering/Env/Particles/Classes/FlyingPiece.h"
 #include "System/float3.h"
 #include "System/FreeListMap.h"
+#include "System/UnorderedMap.hpp"
 
 
 // bypass id and event handling for unsynced projectiles (faster)
 #define PH_UNSYNCED_PROJECTILE_EVENTS 0
 
 class CProjectile;
+class CWeaponProjectile;
 class CUnit;
 class CFeature;
 class CPlasmaRepulser;
@@ -46,6 +48,8 @@ public:
 	void CheckUnitCollisions(CProjectile*, std::vector<CUnit*>&, const float3, const float3);
 	void CheckFeatureCollisions(CProjectile*, std::vector<CFeature*>&, const float3, const float3);
 	void CheckShieldCollisions(CProjectile*, std::vector<CPlasmaRepulser*>&, const float3, const float3);
+	/// shields within collision range of <p>, as GetUnitsAndFeaturesColVol would return them
+	const std::vector<CPlasmaRepulser*>& GetCoveringShields(CWeaponProjectile* p);
 	void CheckUnitFeatureCollisions(bool synced);
 	void CheckGroundCollisions(bool synced);
 	void CheckCollisions();
@@ -111,10 +115,26 @@ private:
 	}
 
 private:
+	struct CollisionCandidates {
+		std::vector<CUnit*> units;
+		std::vector<CFeature*> features;
+		std::vector<CPlasmaRepulser*> repulsers;
+	};
+
 	// [0] contains only projectiles that can not change simulation state
 	// [1] contains only projectiles that can     change simulation state
 	spring::FreeListMapCompact<CProjectile*, int> projectiles[2];
 
+	// per synced projectile, filled by CheckUnitFeatureCollisions if projectileCollisionMT
+	std::vector<CollisionCandidates> collisionCandidates;
+
+	// shield coverage sets (modInfo.shieldCoverageCache), keyed by quad rectangle
+	std::vector<std::vector<CPlasmaRepulser*>> shieldCoverageSets;
+	spring::unordered_map<uint64_t, int> shieldCoverageIndices;
+
+	size_t numShieldCoverageSets = 0;
+	unsigned int shieldCoverageChanges = 0;
+
 	static uint32_t UnsyncedRandInt(uint32_t N);
 	static uint32_t   SyncedRandInt(uint32_t N);
 
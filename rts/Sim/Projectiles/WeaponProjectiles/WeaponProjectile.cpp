@@ -42,6 +42,10 @@ CR_REG_METADATA(CWeaponProjectile,(
 	CR_MEMBER(bounces),
 	CR_MEMBER(weaponNum),
 
+	CR_IGNORED(shieldCoverageKey),
+	CR_IGNORED(shieldCoverageIdx),
+	CR_IGNORED(shieldCoverageChanges),
+
 	CR_POSTLOAD(PostLoad)
 ))
 
@@ -50,6 +54,9 @@ CWeaponProjectile::CWeaponProjectile(const ProjectileParams& params)
 	: CProjectile(params.pos, params.speed, params.owner, true, true, false, false)
 
 	, damages(nullptr)
+	, shieldCoverageKey(0)
+	, shieldCoverageIdx(-1)
+	, shieldCoverageChanges(0)
 	, weaponDef(params.weaponDef)
 	, target(params.target)
 
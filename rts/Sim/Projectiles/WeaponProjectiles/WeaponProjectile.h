@@ -76,6 +76,11 @@ public:
 
 	const DynDamageArray* damages;
 
+	/// coverage set (quad rectangle and index) of the last shield test, see CProjectileHandler::GetCoveringShields
+	uint64_t shieldCoverageKey;
+	int shieldCoverageIdx;
+	unsigned int shieldCoverageChanges;
+
 protected:
 	CWeaponProjectile() { }
 	void UpdateInterception();
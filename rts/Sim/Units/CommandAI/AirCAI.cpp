@@ -2,11 +2,13 @@
 
 
 #include "AirCAI.h"
+#include "Components/CommandAIComponents.h"
 #include "Game/GameHelper.h"
 #include "Game/GlobalUnsynced.h"
 #include "Game/SelectedUnitsHandler.h"
 #include "Map/Ground.h"
 #include "Map/ReadMap.h"
+#include "Sim/Ecs/Registry.h"
 #include "Sim/Misc/ModInfo.h"
 #include "Sim/Misc/TeamHandler.h"
 #include "Sim/MoveTypes/StrafeAirMoveType.h"
@@ -69,6 +71,9 @@ CAirCAI::CAirCAI(CUnit* owner)
 {
 	cancelDistance = 16000;
 
+	// has its own ExecuteMove, no use for the precomputed goal checks
+	Sim::registry.remove<CommandAI::MobileCAIGoalCheck>(owner->entityReference);
+
 	if (owner->unitDef->canAttack) {
 		SCommandDescription c;
 
@@ -1405,9 +1405,8 @@ int CBuilderCAI::FindReclaimTarget(const float3& pos, float radius, unsigned cha
 
 	if (recUnits || recEnemy || recEnemyOnly) {
 		QuadFieldQuery qfQuery;
-		quadField.GetUnitsExact(qfQuery, pos, radius, false);
 
-		for (const CUnit* u: *qfQuery.units) {
+		for (const CUnit* u: CBuilderCaches::GetAreaUnits(qfQuery, pos, radius)) {
 			if (u == owner)
 				continue;
 			if (!u->unitDef->reclaimable)
@@ -1445,10 +1444,9 @@ int CBuilderCAI::FindReclaimTarget(const float3& pos, float radius, unsigned cha
 		best = nullptr;
 		const CTeam* team = teamHandler.Team(owner->team);
 		QuadFieldQuery qfQuery;
-		quadField.GetFeaturesExact(qfQuery, pos, radius, false);
 		bool metal = false;
 
-		for (const CFeature* f: *qfQuery.features) {
+		for (const CFeature* f: CBuilderCaches::GetAreaFeatures(qfQuery, pos, radius)) {
 			if (!f->def->reclaimable)
 				continue;
 			if (!recSpecial && !f->def->autoreclaim)
@@ -1523,12 +1521,11 @@ bool CBuilderCAI::FindResurrectableFeatureAndResurrect(
 ) {
 	RECOIL_DETAILED_TRACY_ZONE;
 	QuadFieldQuery qfQuery;
-	quadField.GetFeaturesExact(qfQuery, pos, radius, false);
 
 	const CFeature* best = nullptr;
 	float bestDist = 1.0e30f;
 
-	for (const CFeature* f: *qfQuery.features) {
+	for (const CFeature* f: CBuilderCaches::GetAreaFeatures(qfQuery, pos, radius)) {
 		if (f->udef == nullptr)
 			continue;
 
@@ -1627,7 +1624,6 @@ bool CBuilderCAI::FindRepairTargetAndRepair(
 ) {
 	RECOIL_DETAILED_TRACY_ZONE;
 	QuadFieldQuery qfQuery;
-	quadField.GetUnitsExact(qfQuery, pos, radius, false);
 	const CUnit* bestUnit = nullptr;
 
 	const float maxSpeed = owner->moveType->GetMaxSpeed();
@@ -1638,7 +1634,7 @@ bool CBuilderCAI::FindRepairTargetAndRepair(
 	bool trySelfRepair = false;
 	bool stationary = false;
 
-	for (const CUnit* unit: *qfQuery.units) {
+	for (const CUnit* unit: CBuilderCaches::GetAreaUnits(qfQuery, pos, radius)) {
 		if (teamHandler.Ally(owner->allyteam, unit->allyteam)) {
 			if (!haveEnemy && (unit->health < unit->maxHealth)) {
 				// don't help allies build unless set on roam
@@ -1,5 +1,6 @@
 /* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
 #include "Sim/Units/CommandAI/BuilderCaches.h"
+#include "Sim/Misc/QuadField.h"
 #include "Sim/Misc/TeamHandler.h"
 #include "Sim/Units/UnitHandler.h"
 #include "Sim/Units/Unit.h"
@@ -11,11 +12,19 @@ spring::unordered_set<int> CBuilderCaches::resurrecters;
 
 std::vector<int> CBuilderCaches::removees;
 
+// only filled between Begin- and EndAreaCaching, never part of a savegame
+spring::unordered_map<CBuilderCaches::AreaKey, std::vector<CUnit*>, CBuilderCaches::AreaKeyHash> CBuilderCaches::areaUnits;
+spring::unordered_map<CBuilderCaches::AreaKey, std::vector<CFeature*>, CBuilderCaches::AreaKeyHash> CBuilderCaches::areaFeatures;
+
+bool CBuilderCaches::areaCaching = false;
+
 void CBuilderCaches::InitStatic()
 {
 	spring::clear_unordered_set(reclaimers);
 	spring::clear_unordered_set(featureReclaimers);
 	spring::clear_unordered_set(resurrecters);
+
+	EndAreaCaching();
 }
 
 void CBuilderCaches::AddUnitToReclaimers(CUnit* unit) { reclaimers.insert(unit->id); }
@@ -146,3 +155,63 @@ bool CBuilderCaches::IsFeatureBeingResurrected(int featureId, const CUnit* frien
 
 
 
+
+
+
+uint32_t CBuilderCaches::AreaKeyHash::operator () (const AreaKey& k) const
+{
+	return (spring::LiteHash(&k, sizeof(k), 0));
+}
+
+void CBuilderCaches::BeginAreaCaching() { areaCaching = true; }
+void CBuilderCaches::EndAreaCaching()
+{
+	// the next slice runs after units moved, died or were created
+	areaUnits.clear();
+	areaFeatures.clear();
+
+	areaCaching = false;
+}
+
+/**
+ * All builders executing an area command (and builders re-checking their
+ * target from one, see ExecuteReclaim) search the same circle; with large
+ * fleets on one area most of the SlowUpdate time went into these queries.
+ * Only the candidates are shared, scoring depends on each builder.
+ *
+ * Entries never outlive the SlowUpdate slice that created them (objects
+ * move, die and spawn outside of it) and none are made outside of a slice,
+ * so a client that just loaded a snapshot between two frames gets the same
+ * lists as everyone else.
+ */
+const std::vector<CUnit*>& CBuilderCaches::GetAreaUnits(QuadFieldQuery& qfQuery, const float3& pos, float radius)
+{
+	if (!areaCaching) {
+		quadField.GetUnitsExact(qfQuery, pos, radius, false);
+		return *qfQuery.units;
+	}
+
+	const auto it = areaUnits.find({pos, radius});
+
+	if (it != areaUnits.end())
+		return it->second;
+
+	quadField.GetUnitsExact(qfQuery, pos, radius, false);
+	return (areaUnits[{pos, radius}] = *qfQuery.units);
+}
+
+const std::vector<CFeature*>& CBuilderCaches::GetAreaFeatures(QuadFieldQuery& qfQuery, const float3& pos, float radius)
+{
+	if (!areaCaching) {
+		quadField.GetFeaturesExact(qfQuery, pos, radius, false);
+		return *qfQuery.features;
+	}
+
+	const auto it = areaFeatures.find({pos, radius});
+
+	if (it != areaFeatures.end())
+		return it->second;
+
+	quadField.GetFeaturesExact(qfQuery, pos, radius, false);
+	return (areaFeatures[{pos, radius}] = *qfQuery.features);
+}
@@ -3,11 +3,15 @@
 #ifndef _BUILDER_CACHES_H_
 #define _BUILDER_CACHES_H_
 
+#include "System/float3.h"
+#include "System/UnorderedMap.hpp"
 #include "System/UnorderedSet.hpp"
 
 #include <vector>
 
 class CUnit;
+class CFeature;
+struct QuadFieldQuery;
 
 class CBuilderCaches
 {
@@ -36,6 +40,35 @@ public:
 	/// fix for patrolling cons reclaiming stuff that is being resurrected
 	static void AddUnitToResurrecters(CUnit*);
 	static void RemoveUnitFromResurrecters(CUnit*);
+
+	/**
+	 * Candidates for area reclaim, repair and resurrect, i.e. the result of
+	 * quadField.Get{Units,Features}Exact(pos, radius, false). Builders given
+	 * the same area command share one query while a SlowUpdate slice runs;
+	 * outside of it (or if the slice ended) the query is done into qfQuery.
+	 */
+	static const std::vector<CUnit*>& GetAreaUnits(QuadFieldQuery& qfQuery, const float3& pos, float radius);
+	static const std::vector<CFeature*>& GetAreaFeatures(QuadFieldQuery& qfQuery, const float3& pos, float radius);
+
+	/// entries only live for one slice, nothing ever has to be invalidated
+	static void BeginAreaCaching();
+	static void EndAreaCaching();
+
+private:
+	struct AreaKey {
+		bool operator == (const AreaKey& k) const { return (pos == k.pos && radius == k.radius); }
+
+		float3 pos;
+		float radius;
+	};
+	struct AreaKeyHash {
+		uint32_t operator () (const AreaKey& k) const;
+	};
+
+	static spring::unordered_map<AreaKey, std::vector<CUnit*>, AreaKeyHash> areaUnits;
+	static spring::unordered_map<AreaKey, std::vector<CFeature*>, AreaKeyHash> areaFeatures;
+
+	static bool areaCaching;
 };
 
 #endif // _BUILDER_CACHES_H_
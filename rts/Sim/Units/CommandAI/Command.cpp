@@ -10,12 +10,12 @@ CR_REG_METADATA(Command, (
 	CR_MEMBER(id),
 
 	CR_MEMBER(timeOut),
-	CR_IGNORED(pageIndex),
-	CR_MEMBER(numParams),
 	CR_MEMBER(tag),
+	CR_MEMBER(numParams),
 	CR_MEMBER(options),
 
 	CR_IGNORED(params),
+	CR_IGNORED(pageIndex),
 	CR_SERIALIZER(Serialize)
 ))
 
@@ -65,16 +65,20 @@ bool Command::PushParam(float param) {
 		return true;
 	}
 
+	if (numParams >= MAX_COMMAND_PARAMS_POOLED)
+		return false;
+
 	if (!IsPooledCommand()) {
 		// not in the pool, reserve an entry and fill it
-		pageIndex = cmdParamsPool.AcquirePage();
+		const unsigned int poolPageIndex = cmdParamsPool.AcquirePage();
 
 		for (unsigned int i = 0; i < numParams; i++) {
-			cmdParamsPool.Push(pageIndex, params[i]);
+			cmdParamsPool.Push(poolPageIndex, params[i]);
 		}
 
+		// overwrites the inline params
 		memset(&params[0], 0, sizeof(params));
-		assert(IsPooledCommand());
+		pageIndex = poolPageIndex;
 	}
 
 	// add new parameter
@@ -87,7 +91,6 @@ void Command::CopyParams(const Command& c) {
 	if (IsPooledCommand())
 		cmdParamsPool.ReleasePage(pageIndex);
 
-	pageIndex = -1u;
 	numParams = 0;
 
 	assert(IsEmptyCommand());
@@ -95,6 +95,8 @@ static constexpr uint8_t ALT_KEY         = (1 << 7); // 128
 
 // maximum number of inline parameters for any (default and custom) command type
 static constexpr uint32_t MAX_COMMAND_PARAMS = 8;
+// maximum number of (pooled) parameters, far beyond what fits into a network packet
+static constexpr uint32_t MAX_COMMAND_PARAMS_POOLED = 0xFFFF;
 
 
 #if defined(BUILDING_AI)
@@ -233,7 +235,7 @@ public:
 		rc.id[1]   = id[1];
 		rc.timeOut = timeOut;
 
-		rc.pageIndex = pageIndex;
+		rc.pageIndex = IsPooledCommand()? pageIndex: -1u;
 		rc.numParams = numParams;
 		rc.tag       = tag;
 		rc.options   = options;
@@ -243,7 +245,6 @@ public:
 	}
 
 	void FromRawCommand(const RawCommand& rc) {
-		pageIndex = rc.pageIndex;
 		numParams = rc.numParams;
 
 		memcpy(&id[0], &rc.id[0], sizeof(id));
@@ -253,7 +254,8 @@ public:
 
 		if (IsPooledCommand()) {
 			// actual params should still be in pool, original command exists on AI side
-			assert(numParams > MAX_COMMAND_PARAMS);
+			assert(rc.pageIndex != -1u);
+			pageIndex = rc.pageIndex;
 			return;
 		}
 
@@ -369,7 +371,7 @@ public:
 
 	bool IsBuildCommand() const { return (GetID() < 0); }
 	bool IsEmptyCommand() const { return (numParams == 0); }
-	bool IsPooledCommand() const { return (pageIndex != -1u); } // implies numParams > MAX_COMMAND_PARAMS
+	bool IsPooledCommand() const { return (numParams > MAX_COMMAND_PARAMS); }
 	bool IsInternalOrder() const { return ((options & INTERNAL_ORDER) != 0); }
 
 	int GetID(bool idx = false) const { return id[idx]; }
@@ -439,18 +441,22 @@ private:
 	 */
 	int timeOut = INT_MAX;
 
-	/// page-index for cmdParamsPool, valid iff numParams > MAX_COMMAND_PARAMS
-	unsigned int pageIndex = -1u;
-	unsigned int numParams = 0;
-
 	/// unique id within a CCommandQueue
 	unsigned int tag = 0;
 
+	uint16_t numParams = 0;
+
 	/// option bits (RIGHT_MOUSE_KEY, ...)
 	unsigned char options = 0;
 
-	/// inline command parameters, used if numParams <= MAX_COMMAND_PARAMS
-	float params[MAX_COMMAND_PARAMS];
+	// commands are stored by value in every unit's queue, so the pool page
+	// shares its storage with the inline parameters it replaces
+	union {
+		/// inline command parameters, used if numParams <= MAX_COMMAND_PARAMS
+		float params[MAX_COMMAND_PARAMS];
+		/// page-index for cmdParamsPool, valid iff numParams > MAX_COMMAND_PARAMS
+		unsigned int pageIndex;
+	};
 };
 
 #endif // COMMAND_H
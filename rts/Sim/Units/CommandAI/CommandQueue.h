@@ -23,6 +23,8 @@ class CCommandQueue {
 		};
 
 		inline QueueType GetType() const { return queueType; }
+		/// changes whenever a command is added to the queue
+		inline int GetLastTag() const { return tagCounter; }
 
 	public:
 		/// limit to a float's integer range
@@ -0,0 +1,52 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#ifndef COMMAND_AI_COMPONENTS_H__
+#define COMMAND_AI_COMPONENTS_H__
+
+#include <cstdint>
+
+#include "System/float3.h"
+
+namespace CommandAI {
+
+enum MobileCAIGoalState : uint8_t {
+    GOAL_UNCHECKED = 0, // no usable result, ExecuteMove runs in full
+    GOAL_MOVING    = 1, // still moving towards the goal, ExecuteMove is a no-op
+    GOAL_REACHED   = 2,
+    GOAL_FAILED    = 3,
+};
+
+// Result of the ExecuteMove goal checks for the front command of a CMobileCAI,
+// written by MobileCAIGoalSystem on the thread-pool. The snapshot of the state
+// it was derived from lets the serial SlowUpdate reject results that were made
+// stale by earlier SlowUpdate's in the same frame.
+struct MobileCAIGoalCheck {
+    float3 cmdPos;
+    float3 ownPos;
+    float3 goalPos;
+
+    int unitId = -1;
+    int frameNum = -1;
+
+    unsigned int cmdTag = 0;
+    unsigned int queueSize = 0;
+    int queueLastTag = 0;
+
+    uint8_t progressState = 0;
+    uint8_t state = GOAL_UNCHECKED;
+};
+
+// results never survive a frame, only the owner needs to be stored
+template<class Archive>
+void serialize(Archive &ar, MobileCAIGoalCheck &c) { ar(c.unitId); }
+
+template<class Archive, class Snapshot>
+void serializeComponents(Archive &archive, Snapshot &snapshot) {
+    snapshot.template component
+        < MobileCAIGoalCheck
+        >(archive);
+}
+
+}
+
+#endif
@@ -2,11 +2,13 @@
 
 
 #include "MobileCAI.h"
+#include "Components/CommandAIComponents.h"
 #include "ExternalAI/EngineOutHandler.h"
 #include "Game/GameHelper.h"
 #include "Game/GlobalUnsynced.h"
 #include "Game/SelectedUnitsHandler.h"
 #include "Map/Ground.h"
+#include "Sim/Ecs/Registry.h"
 #include "Sim/Misc/GlobalSynced.h"
 #include "Sim/Misc/LosHandler.h"
 #include "Sim/Misc/ModInfo.h"
@@ -113,6 +115,8 @@ CMobileCAI::CMobileCAI(CUnit* owner):
 {
 	CalculateCancelDistance();
 
+	Sim::registry.emplace_or_replace<CommandAI::MobileCAIGoalCheck>(owner->entityReference).unitId = owner->id;
+
 	{
 		SCommandDescription c;
 
@@ -256,6 +260,9 @@ CMobileCAI::CMobileCAI(CUnit* owner):
 CMobileCAI::~CMobileCAI()
 {
 	SetTransportee(nullptr);
+
+	if (owner != nullptr && Sim::registry.valid(owner->entityReference))
+		Sim::registry.remove<CommandAI::MobileCAIGoalCheck>(owner->entityReference);
 }
 
 
@@ -396,6 +403,26 @@ void CMobileCAI::ExecuteMove(Command& c)
 
 	const float sqGoalDist = cmdPos.SqDistance2D(ownPos);
 
+	// results of MobileCAIGoalSystem, if still valid
+	switch (GetPrecomputedMoveGoalState(c)) {
+		case CommandAI::GOAL_MOVING: {
+			return;
+		}
+		case CommandAI::GOAL_REACHED: {
+			if (!HasMoreMoveCommands())
+				StopMove();
+
+			FinishCommand();
+			return;
+		}
+		case CommandAI::GOAL_FAILED: {
+			StopMoveAndFinishCommand();
+			return;
+		}
+		default: {
+		} break;
+	}
+
 	// this check is important to process failed orders properly
 	// NB: only works if the *non-extended* goal radius is passed
 	if (!moveType->IsMovingTowards(cmdPos, moveType->GetGoalRadius(0.0f), false))
@@ -426,6 +453,83 @@ void CMobileCAI::ExecuteMove(Command& c)
 	FinishCommand();
 }
 
+void CMobileCAI::PrecomputeMoveGoalState(CommandAI::MobileCAIGoalCheck& check) const
+{
+	check.frameNum = gs->frameNum;
+	check.state = CommandAI::GOAL_UNCHECKED;
+
+	if (gs->paused || commandQue.empty())
+		return;
+
+	const Command& c = commandQue.front();
+	const AMoveType* moveType = owner->moveType;
+
+	if (c.GetTimeOut() < gs->frameNum)
+		return;
+
+	// ExecuteFight falls through to ExecuteMove if no enemy was found; if it
+	// pushes an attack-command instead the queue snapshot no longer matches
+	if (c.GetID() != CMD_MOVE && (c.GetID() != CMD_FIGHT || c.GetNumParams() < 3))
+		return;
+
+	const float3& cmdPos = c.GetPos(0);
+	const float3& ownPos = owner->pos;
+
+	const float sqGoalDist = cmdPos.SqDistance2D(ownPos);
+
+	check.cmdPos = cmdPos;
+	check.ownPos = ownPos;
+	check.goalPos = moveType->goalPos;
+
+	check.cmdTag = c.GetTag();
+	check.queueSize = commandQue.size();
+	check.queueLastTag = commandQue.GetLastTag();
+
+	check.progressState = moveType->progressState;
+
+	// same sequence of tests as ExecuteMove, minus the side-effects
+	if (!moveType->IsMovingTowards(cmdPos, moveType->GetGoalRadius(0.0f), false))
+		return;
+
+	if (sqGoalDist < Square(moveType->GetGoalRadius(1.0f)) || moveType->IsAtGoal()) {
+		check.state = CommandAI::GOAL_REACHED;
+		return;
+	}
+
+	if (moveType->progressState == AMoveType::Failed) {
+		check.state = CommandAI::GOAL_FAILED;
+		return;
+	}
+
+	if (sqGoalDist >= cancelDistance || (c.IsInternalOrder() && !c.IsAttackCommand()) || !HasMoreMoveCommands())
+		check.state = CommandAI::GOAL_MOVING;
+}
+
+uint8_t CMobileCAI::GetPrecomputedMoveGoalState(const Command& c) const
+{
+	if (!modInfo.mobileCAIGoalCheckMT)
+		return CommandAI::GOAL_UNCHECKED;
+
+	const auto* check = Sim::registry.try_get<CommandAI::MobileCAIGoalCheck>(owner->entityReference);
+
+	if (check == nullptr || check->frameNum != gs->frameNum || check->state == CommandAI::GOAL_UNCHECKED)
+		return CommandAI::GOAL_UNCHECKED;
+
+	// ExecutePatrol passes a temporary copy
+	if (commandQue.empty() || &c != &commandQue.front())
+		return CommandAI::GOAL_UNCHECKED;
+
+	// reject results made stale by SlowUpdate's that ran earlier this frame
+	if (check->cmdTag != c.GetTag() || check->queueSize != commandQue.size() || check->queueLastTag != commandQue.GetLastTag())
+		return CommandAI::GOAL_UNCHECKED;
+	if (check->cmdPos != c.GetPos(0) || check->ownPos != owner->pos)
+		return CommandAI::GOAL_UNCHECKED;
+	if (check->goalPos != owner->moveType->goalPos || check->progressState != owner->moveType->progressState)
+		return CommandAI::GOAL_UNCHECKED;
+
+	return check->state;
+}
+
 void CMobileCAI::ExecuteLoadOnto(Command& c) {
 	CUnit* transport = unitHandler.GetUnit(c.GetParam(0));
 
@@ -14,6 +14,10 @@ class CFeature;
 class CWeapon;
 struct Command;
 
+namespace CommandAI {
+	struct MobileCAIGoalCheck;
+}
+
 class CMobileCAI : public CCommandAI
 {
 public:
@@ -59,6 +63,10 @@ public:
 
 	int GetCancelDistance() { return cancelDistance; }
 
+	/// read-only evaluation of the ExecuteMove goal checks for the front
+	/// command, safe to call from the thread-pool (see MobileCAIGoalSystem)
+	void PrecomputeMoveGoalState(CommandAI::MobileCAIGoalCheck& check) const;
+
 	virtual bool IsValidTarget(const CUnit* enemy, CWeapon* weapon) const;
 	virtual bool CanWeaponAutoTarget(const CWeapon* weapon) const override;
 
@@ -125,6 +133,8 @@ protected:
 	void CalculateCancelDistance();
 
 private:
+	uint8_t GetPrecomputedMoveGoalState(const Command& c) const;
+
 	void ExecuteObjectAttack(Command& c);
 	void ExecuteGroundAttack(Command& c);
 
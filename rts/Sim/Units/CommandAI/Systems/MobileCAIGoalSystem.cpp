@@ -0,0 +1,32 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#include "MobileCAIGoalSystem.h"
+
+#include "Sim/Ecs/Registry.h"
+#include "Sim/Units/CommandAI/Components/CommandAIComponents.h"
+#include "Sim/Units/CommandAI/MobileCAI.h"
+#include "Sim/Units/Unit.h"
+#include "Sim/Units/UnitHandler.h"
+
+#include "System/Threading/ThreadPool.h"
+
+#include "System/Misc/TracyDefs.h"
+
+using namespace CommandAI;
+
+void MobileCAIGoalSystem::Update(size_t idxBeg, size_t idxEnd) {
+    RECOIL_DETAILED_TRACY_ZONE;
+    const auto& activeUnits = unitHandler.GetActiveUnits();
+
+    // read-only access to the sim state; no components are added or removed
+    // while the pool is running so concurrent try_get's are safe
+    for_mt(idxBeg, idxEnd, [&activeUnits](const int i) {
+        const CUnit* unit = activeUnits[i];
+        MobileCAIGoalCheck* check = Sim::registry.try_get<MobileCAIGoalCheck>(unit->entityReference);
+
+        if (check == nullptr)
+            return;
+
+        static_cast<const CMobileCAI*>(unit->commandAI)->PrecomputeMoveGoalState(*check);
+    });
+}
@@ -0,0 +1,14 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#ifndef MOBILE_CAI_GOAL_SYSTEM_H__
+#define MOBILE_CAI_GOAL_SYSTEM_H__
+
+#include <cstddef>
+
+class MobileCAIGoalSystem {
+public:
+    // evaluates the goal checks of the activeUnits in [idxBeg, idxEnd)
+    static void Update(size_t idxBeg, size_t idxEnd);
+};
+
+#endif
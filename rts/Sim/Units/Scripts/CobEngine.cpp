@@ -5,7 +5,9 @@
 #include "CobThread.h"
 #include "CobFile.h"
 
+#include <algorithm>
 #include <cstdint>
+#include "System/FrameArena.h"
 #include "System/Misc/TracyDefs.h"
 
 CR_BIND(CCobEngine, )
@@ -15,12 +17,18 @@ CR_REG_METADATA(CCobEngine, (
 	CR_MEMBER(tickAddedThreads),
 	CR_MEMBER(tickRemovedThreads),
 	CR_MEMBER(runningThreadIDs),
+	CR_MEMBER(sleepWheel),
 	CR_MEMBER(sleepingThreadIDs),
+	// always empty/false when saving
+	CR_IGNORED(wakingThreadIDs),
+	CR_IGNORED(inWakeSleepingThreads),
 	// always null/empty when saving
 	CR_IGNORED(waitingThreadIDs),
 
 	CR_IGNORED(curThread),
 
+	CR_MEMBER(sleepWheelSlot),
+
 	CR_MEMBER(currentTime),
 	CR_MEMBER(threadCounter)
 ))
@@ -93,7 +101,7 @@ void CCobEngine::ScheduleThread(const CCobThread* thread)
 			waitingThreadIDs.push_back(thread->GetID());
 		} break;
 		case CCobThread::Sleep: {
-			sleepingThreadIDs.push(SleepingThread{thread->GetID(), thread->GetWakeTime()});
+			AddSleepingThread(SleepingThread{thread->GetID(), thread->GetWakeTime()});
 		} break;
 		default: {
 			LOG_L(L_ERROR, "[COBEngine::%s] unknown state %d for thread %d", __func__, thread->GetState(), thread->GetID());
@@ -129,27 +137,93 @@ void CCobEngine::TickThread(CCobThread* thread)
 	curThread = nullptr;
 }
 
+void CCobEngine::AddSleepingThread(const SleepingThread& zzz)
+{
+	// (negative) sleeps that already expired while waking others must still
+	// run in this Tick, in the same order as if there were a single queue
+	if (zzz.wt < currentTime && inWakeSleepingThreads) {
+		wakingThreadIDs.push(zzz);
+		return;
+	}
+
+	const int slot = std::max(zzz.wt >> SLEEP_SLOT_SHIFT, sleepWheelSlot);
+
+	if (slot >= (sleepWheelSlot + SLEEP_WHEEL_SIZE)) {
+		sleepingThreadIDs.push(zzz);
+		return;
+	}
+
+	sleepWheel[slot & (SLEEP_WHEEL_SIZE - 1)].push_back(zzz);
+}
+
+void CCobEngine::GatherWakingThreads()
+{
+	// a sleeper is due once its waketime lies strictly in the past
+	const int lastSlot = (currentTime - 1) >> SLEEP_SLOT_SHIFT;
+	const int stopSlot = std::min(lastSlot, sleepWheelSlot + SLEEP_WHEEL_SIZE - 1);
+
+	for (int slot = sleepWheelSlot; slot <= stopSlot; slot++) {
+		auto& sleepers = sleepWheel[slot & (SLEEP_WHEEL_SIZE - 1)];
+
+		// the last slot can also hold threads that wake up later
+		const auto pred = [&](const SleepingThread& zzz) {
+			if (zzz.wt >= currentTime)
+				return false;
+
+			wakingThreadIDs.push(zzz);
+			return true;
+		};
+
+		sleepers.erase(std::remove_if(sleepers.begin(), sleepers.end(), pred), sleepers.end());
+	}
+
+	sleepWheelSlot = std::max(sleepWheelSlot, lastSlot);
+
+	while (!sleepingThreadIDs.empty() && (sleepingThreadIDs.top()).wt < currentTime) {
+		wakingThreadIDs.push(sleepingThreadIDs.top());
+		sleepingThreadIDs.pop();
+	}
+}
+
 void CCobEngine::WakeSleepingThreads()
 {
 	ZoneScoped;
+	GatherWakingThreads();
+
+	inWakeSleepingThreads = true;
+
 	// check on the sleeping threads, remove any whose owner died
-	while (!sleepingThreadIDs.empty()) {
-		CCobThread* zzzThread = GetThread((sleepingThreadIDs.top()).id);
+	while (!wakingThreadIDs.empty()) {
+		CCobThread* zzzThread = GetThread((wakingThreadIDs.top()).id);
 
 		if (zzzThread == nullptr) {
-			sleepingThreadIDs.pop();
+			wakingThreadIDs.pop();
 			continue;
 		}
 
 		// not yet time to execute this thread or any subsequent sleepers
-		if (zzzThread->GetWakeTime() >= currentTime)
+		if (zzzThread->GetWakeTime() >= currentTime) {
+			// put them back, they will be examined again next Tick
+			inWakeSleepingThreads = false;
+
+			FrameVector<SleepingThread> sleepers;
+			sleepers.reserve(wakingThreadIDs.size());
+
+			for (; !wakingThreadIDs.empty(); wakingThreadIDs.pop()) {
+				sleepers.push_back(wakingThreadIDs.top());
+			}
+			for (const SleepingThread& zzz: sleepers) {
+				AddSleepingThread(zzz);
+			}
+
 			break;
+		}
 
 		// remove executing thread from the queue
-		sleepingThreadIDs.pop();
+		wakingThreadIDs.pop();
 
 		// wake up the thread and tick it (if not dead)
-		// this can quite possibly re-add the thread to <sleepingThreadIDs>
+		// this can quite possibly re-add the thread to the sleepers
 		// again, but any thread is guaranteed to sleep for at least 1 tick
 		switch (zzzThread->GetState()) {
 			case CCobThread::Sleep: {
@@ -164,6 +238,30 @@ void CCobEngine::WakeSleepingThreads()
 			} break;
 		}
 	}
+
+	inWakeSleepingThreads = false;
+}
+
+std::vector<CCobEngine::SleepingThread> CCobEngine::GetSleepingThreadIDs() const
+{
+	std::vector<SleepingThread> sleepers;
+
+	for (const auto& slot: sleepWheel) {
+		sleepers.insert(sleepers.end(), slot.begin(), slot.end());
+	}
+
+	auto zzzThreads = sleepingThreadIDs; //copied on purpose
+
+	for (; !zzzThreads.empty(); zzzThreads.pop()) {
+		sleepers.push_back(zzzThreads.top());
+	}
+
+	// same order the threads would be woken in
+	std::sort(sleepers.begin(), sleepers.end(), [](const SleepingThread& a, const SleepingThread& b) {
+		return CCobThreadComp{}(b, a);
+	});
+
+	return sleepers;
 }
 
 void CCobEngine::TickRunningThreads()
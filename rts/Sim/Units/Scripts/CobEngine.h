@@ -8,6 +8,7 @@
  * It also manages reading and caching of the actual .cob files.
  */
 
+#include <array>
 #include <vector>
 
 #include "CobThread.h"
@@ -48,10 +49,17 @@ public:
 		runningThreadIDs.reserve(512);
 		waitingThreadIDs.reserve(512);
 
+		for (auto& slot: sleepWheel) {
+			slot.clear();
+		}
+
 		sleepingThreadIDs = {};
+		wakingThreadIDs = {};
 
 		curThread = nullptr;
 
+		sleepWheelSlot = 0;
+
 		currentTime = 0;
 		threadCounter = 0;
 	}
@@ -64,9 +72,16 @@ public:
 		runningThreadIDs.clear();
 		waitingThreadIDs.clear();
 
+		for (auto& slot: sleepWheel) {
+			slot.clear();
+		}
+
 		while (!sleepingThreadIDs.empty()) {
 			sleepingThreadIDs.pop();
 		}
+		while (!wakingThreadIDs.empty()) {
+			wakingThreadIDs.pop();
+		}
 	}
 
 	void Tick(int deltaTime);
@@ -98,13 +113,16 @@ public:
 //	const auto& GetTickRemovedThreads() const { return tickRemovedThreads; }
 //	const auto& GetRunningThreadIDs() const { return runningThreadIDs; }
 	const auto& GetWaitingThreadIDs() const { return waitingThreadIDs; }
-	const auto& GetSleepingThreadIDs() const { return sleepingThreadIDs; }
+	/// all sleepers in wake-up order, for sync dumps
+	std::vector<SleepingThread> GetSleepingThreadIDs() const;
 	const auto  GetCurrTime() const { return currentTime; }
 	const auto  GetThreadCounter() const { return threadCounter; }
 	const auto  GetCurrCounter() const { return threadCounter; }
 private:
 	void TickThread(CCobThread* thread);
 
+	void AddSleepingThread(const SleepingThread& zzz);
+	void GatherWakingThreads();
 	void WakeSleepingThreads();
 	void TickRunningThreads();
 
@@ -119,9 +137,24 @@ private:
 	std::vector<int> runningThreadIDs;
 	std::vector<int> waitingThreadIDs;
 
+	// a COB sleep rarely lasts more than a few seconds, so sleepers go into a
+	// timer wheel of SLEEP_WHEEL_SIZE slots of (1 << SLEEP_SLOT_SHIFT) ms each
+	// and a Tick only looks at the slots that expired; the few longer sleeps
+	// overflow into <sleepingThreadIDs>
+	static constexpr int SLEEP_SLOT_SHIFT = 5;
+	static constexpr int SLEEP_WHEEL_SIZE = 256;
+
 	// stores <id, waketime> pairs s.t. after waking up the ID can be checked
 	// for validity; thread owner might get removed while a thread is sleeping
+	std::array<std::vector<SleepingThread>, SLEEP_WHEEL_SIZE> sleepWheel;
 	std::priority_queue<SleepingThread, std::vector<SleepingThread>, CCobThreadComp> sleepingThreadIDs;
+	// sleepers due in the current Tick, woken in <waketime, id> order
+	std::priority_queue<SleepingThread, std::vector<SleepingThread>, CCobThreadComp> wakingThreadIDs;
+
+	// absolute index (time >> SLEEP_SLOT_SHIFT) of the oldest non-expired slot
+	int sleepWheelSlot = 0;
+
+	bool inWakeSleepingThreads = false;
 
 	CCobThread* curThread = nullptr;
 
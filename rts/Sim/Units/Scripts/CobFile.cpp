@@ -3,6 +3,7 @@
 
 #include "Sim/Misc/GlobalConstants.h"
 #include "CobFile.h"
+#include "CobOpcodes.h"
 #include "System/FileSystem/FileHandler.h"
 #include "System/Log/ILog.h"
 #include "System/Sound/ISound.h"
@@ -162,6 +163,13 @@ CCobFile::CCobFile(CFileHandler& in, const std::string& scriptName)
 		swabDWordInPlace(code[i]);
 	}
 
+	// pre-decode every word, not only those at instruction boundaries; the
+	// entries for operand words are never looked at so no need to parse
+	opIndices.resize(codeWords);
+	for (int i = 0; i < codeWords; i++) {
+		opIndices[i] = GetCobOpIndex(code[i]);
+	}
+
 	numStaticVars = ch.NumberOfStaticVars;
 
 	// if this is a TA:K script, read the sound names
@@ -4,6 +4,7 @@
 #define COB_FILE_H
 
 #include <array>
+#include <cstdint>
 #include <vector>
 #include <string>
 
@@ -23,6 +24,7 @@ public:
 		numStaticVars = f.numStaticVars;
 
 		code = std::move(f.code);
+		opIndices = std::move(f.opIndices);
 		scriptNames = std::move(f.scriptNames);
 		scriptOffsets = std::move(f.scriptOffsets);
 
@@ -43,6 +45,8 @@ public:
 	int numStaticVars = 0;
 
 	std::vector<int> code;
+	/// CobOpIndex of every word in code, see CobOpcodes.h
+	std::vector<uint8_t> opIndices;
 	std::vector<std::string> scriptNames;
 	std::vector<int> scriptOffsets;
 	/// Assumes that the scripts are sorted by offset in the file
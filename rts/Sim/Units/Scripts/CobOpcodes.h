@@ -0,0 +1,224 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#ifndef COB_OPCODES_H
+#define COB_OPCODES_H
+
+#include <cstdint>
+
+// Command documentation from http://visualta.tauniverse.com/Downloads/cob-commands.txt
+// And some information from basm0.8 source (basm ops.txt)
+
+// Model interaction
+static constexpr int MOVE       = 0x10001000;
+static constexpr int TURN       = 0x10002000;
+static constexpr int SPIN       = 0x10003000;
+static constexpr int STOP_SPIN  = 0x10004000;
+static constexpr int SHOW       = 0x10005000;
+static constexpr int HIDE       = 0x10006000;
+static constexpr int CACHE      = 0x10007000;
+static constexpr int DONT_CACHE = 0x10008000;
+static constexpr int MOVE_NOW   = 0x1000B000;
+static constexpr int TURN_NOW   = 0x1000C000;
+static constexpr int SHADE      = 0x1000D000;
+static constexpr int DONT_SHADE = 0x1000E000;
+static constexpr int EMIT_SFX   = 0x1000F000;
+
+// Blocking operations
+static constexpr int WAIT_TURN  = 0x10011000;
+static constexpr int WAIT_MOVE  = 0x10012000;
+static constexpr int SLEEP      = 0x10013000;
+
+// Stack manipulation
+static constexpr int PUSH_CONSTANT    = 0x10021001;
+static constexpr int PUSH_LOCAL_VAR   = 0x10021002;
+static constexpr int PUSH_STATIC      = 0x10021004;
+static constexpr int CREATE_LOCAL_VAR = 0x10022000;
+static constexpr int POP_LOCAL_VAR    = 0x10023002;
+static constexpr int POP_STATIC       = 0x10023004;
+static constexpr int POP_STACK        = 0x10024000; ///< Not sure what this is supposed to do
+
+// Arithmetic operations
+static constexpr int ADD         = 0x10031000;
+static constexpr int SUB         = 0x10032000;
+static constexpr int MUL         = 0x10033000;
+static constexpr int DIV         = 0x10034000;
+static constexpr int MOD		  = 0x10034001; ///< spring specific
+static constexpr int BITWISE_AND = 0x10035000;
+static constexpr int BITWISE_OR  = 0x10036000;
+static constexpr int BITWISE_XOR = 0x10037000;
+static constexpr int BITWISE_NOT = 0x10038000;
+
+// Native function calls
+static constexpr int RAND           = 0x10041000;
+static constexpr int GET_UNIT_VALUE = 0x10042000;
+static constexpr int GET            = 0x10043000;
+
+// Comparison
+static constexpr int SET_LESS             = 0x10051000;
+static constexpr int SET_LESS_OR_EQUAL    = 0x10052000;
+static constexpr int SET_GREATER          = 0x10053000;
+static constexpr int SET_GREATER_OR_EQUAL = 0x10054000;
+static constexpr int SET_EQUAL            = 0x10055000;
+static constexpr int SET_NOT_EQUAL        = 0x10056000;
+static constexpr int LOGICAL_AND          = 0x10057000;
+static constexpr int LOGICAL_OR           = 0x10058000;
+static constexpr int LOGICAL_XOR          = 0x10059000;
+static constexpr int LOGICAL_NOT          = 0x1005A000;
+
+// Flow control
+static constexpr int START           = 0x10061000;
+static constexpr int CALL            = 0x10062000; ///< converted when executed
+static constexpr int REAL_CALL       = 0x10062001; ///< spring custom
+static constexpr int LUA_CALL        = 0x10062002; ///< spring custom
+static constexpr int JUMP            = 0x10064000;
+static constexpr int RETURN          = 0x10065000;
+static constexpr int JUMP_NOT_EQUAL  = 0x10066000;
+static constexpr int SIGNAL          = 0x10067000;
+static constexpr int SET_SIGNAL_MASK = 0x10068000;
+
+// Piece destruction
+static constexpr int EXPLODE    = 0x10071000;
+static constexpr int PLAY_SOUND = 0x10072000;
+
+// Special functions
+static constexpr int SET    = 0x10082000;
+static constexpr int ATTACH = 0x10083000;
+static constexpr int DROP   = 0x10084000;
+
+
+// Dense opcode indices, CCobFile pre-decodes every code word into one of these
+// at load time so that CCobThread::Tick can dispatch through a jump table
+// instead of comparing against the sparse raw values above.
+enum CobOpIndex: uint8_t {
+	OP_UNKNOWN = 0,
+	OP_MOVE,
+	OP_TURN,
+	OP_SPIN,
+	OP_STOP_SPIN,
+	OP_SHOW,
+	OP_HIDE,
+	OP_CACHE,
+	OP_DONT_CACHE,
+	OP_MOVE_NOW,
+	OP_TURN_NOW,
+	OP_SHADE,
+	OP_DONT_SHADE,
+	OP_EMIT_SFX,
+	OP_WAIT_TURN,
+	OP_WAIT_MOVE,
+	OP_SLEEP,
+	OP_PUSH_CONSTANT,
+	OP_PUSH_LOCAL_VAR,
+	OP_PUSH_STATIC,
+	OP_CREATE_LOCAL_VAR,
+	OP_POP_LOCAL_VAR,
+	OP_POP_STATIC,
+	OP_POP_STACK,
+	OP_ADD,
+	OP_SUB,
+	OP_MUL,
+	OP_DIV,
+	OP_MOD,
+	OP_BITWISE_AND,
+	OP_BITWISE_OR,
+	OP_BITWISE_XOR,
+	OP_BITWISE_NOT,
+	OP_RAND,
+	OP_GET_UNIT_VALUE,
+	OP_GET,
+	OP_SET_LESS,
+	OP_SET_LESS_OR_EQUAL,
+	OP_SET_GREATER,
+	OP_SET_GREATER_OR_EQUAL,
+	OP_SET_EQUAL,
+	OP_SET_NOT_EQUAL,
+	OP_LOGICAL_AND,
+	OP_LOGICAL_OR,
+	OP_LOGICAL_XOR,
+	OP_LOGICAL_NOT,
+	OP_START,
+	OP_CALL,
+	OP_REAL_CALL,
+	OP_LUA_CALL,
+	OP_JUMP,
+	OP_RETURN,
+	OP_JUMP_NOT_EQUAL,
+	OP_SIGNAL,
+	OP_SET_SIGNAL_MASK,
+	OP_EXPLODE,
+	OP_PLAY_SOUND,
+	OP_SET,
+	OP_ATTACH,
+	OP_DROP,
+	OP_COUNT
+};
+
+constexpr uint8_t GetCobOpIndex(int opcode)
+{
+	switch (opcode) {
+		case MOVE: return OP_MOVE;
+		case TURN: return OP_TURN;
+		case SPIN: return OP_SPIN;
+		case STOP_SPIN: return OP_STOP_SPIN;
+		case SHOW: return OP_SHOW;
+		case HIDE: return OP_HIDE;
+		case CACHE: return OP_CACHE;
+		case DONT_CACHE: return OP_DONT_CACHE;
+		case MOVE_NOW: return OP_MOVE_NOW;
+		case TURN_NOW: return OP_TURN_NOW;
+		case SHADE: return OP_SHADE;
+		case DONT_SHADE: return OP_DONT_SHADE;
+		case EMIT_SFX: return OP_EMIT_SFX;
+		case WAIT_TURN: return OP_WAIT_TURN;
+		case WAIT_MOVE: return OP_WAIT_MOVE;
+		case SLEEP: return OP_SLEEP;
+		case PUSH_CONSTANT: return OP_PUSH_CONSTANT;
+		case PUSH_LOCAL_VAR: return OP_PUSH_LOCAL_VAR;
+		case PUSH_STATIC: return OP_PUSH_STATIC;
+		case CREATE_LOCAL_VAR: return OP_CREATE_LOCAL_VAR;
+		case POP_LOCAL_VAR: return OP_POP_LOCAL_VAR;
+		case POP_STATIC: return OP_POP_STATIC;
+		case POP_STACK: return OP_POP_STACK;
+		case ADD: return OP_ADD;
+		case SUB: return OP_SUB;
+		case MUL: return OP_MUL;
+		case DIV: return OP_DIV;
+		case MOD: return OP_MOD;
+		case BITWISE_AND: return OP_BITWISE_AND;
+		case BITWISE_OR: return OP_BITWISE_OR;
+		case BITWISE_XOR: return OP_BITWISE_XOR;
+		case BITWISE_NOT: return OP_BITWISE_NOT;
+		case RAND: return OP_RAND;
+		case GET_UNIT_VALUE: return OP_GET_UNIT_VALUE;
+		case GET: return OP_GET;
+		case SET_LESS: return OP_SET_LESS;
+		case SET_LESS_OR_EQUAL: return OP_SET_LESS_OR_EQUAL;
+		case SET_GREATER: return OP_SET_GREATER;
+		case SET_GREATER_OR_EQUAL: return OP_SET_GREATER_OR_EQUAL;
+		case SET_EQUAL: return OP_SET_EQUAL;
+		case SET_NOT_EQUAL: return OP_SET_NOT_EQUAL;
+		case LOGICAL_AND: return OP_LOGICAL_AND;
+		case LOGICAL_OR: return OP_LOGICAL_OR;
+		case LOGICAL_XOR: return OP_LOGICAL_XOR;
+		case LOGICAL_NOT: return OP_LOGICAL_NOT;
+		case START: return OP_START;
+		case CALL: return OP_CALL;
+		case REAL_CALL: return OP_REAL_CALL;
+		case LUA_CALL: return OP_LUA_CALL;
+		case JUMP: return OP_JUMP;
+		case RETURN: return OP_RETURN;
+		case JUMP_NOT_EQUAL: return OP_JUMP_NOT_EQUAL;
+		case SIGNAL: return OP_SIGNAL;
+		case SET_SIGNAL_MASK: return OP_SET_SIGNAL_MASK;
+		case EXPLODE: return OP_EXPLODE;
+		case PLAY_SOUND: return OP_PLAY_SOUND;
+		case SET: return OP_SET;
+		case ATTACH: return OP_ATTACH;
+		case DROP: return OP_DROP;
+		default: break;
+	}
+
+	return OP_UNKNOWN;
+}
+
+#endif // COB_OPCODES_H
@@ -5,8 +5,10 @@
 #include "CobFile.h"
 #include "CobInstance.h"
 #include "CobEngine.h"
+#include "CobOpcodes.h"
 #include "Sim/Misc/GlobalConstants.h"
 #include "Sim/Misc/GlobalSynced.h"
+#include "System/ScriptSampler.h"
 
 #include "System/Misc/TracyDefs.h"
 
@@ -226,86 +228,6 @@ void CCobThread::InitStack(unsigned int n, CCobThread* t)
 
 
 
-// Command documentation from http://visualta.tauniverse.com/Downloads/cob-commands.txt
-// And some information from basm0.8 source (basm ops.txt)
-
-// Model interaction
-static constexpr int MOVE       = 0x10001000;
-static constexpr int TURN       = 0x10002000;
-static constexpr int SPIN       = 0x10003000;
-static constexpr int STOP_SPIN  = 0x10004000;
-static constexpr int SHOW       = 0x10005000;
-static constexpr int HIDE       = 0x10006000;
-static constexpr int CACHE      = 0x10007000;
-static constexpr int DONT_CACHE = 0x10008000;
-static constexpr int MOVE_NOW   = 0x1000B000;
-static constexpr int TURN_NOW   = 0x1000C000;
-static constexpr int SHADE      = 0x1000D000;
-static constexpr int DONT_SHADE = 0x1000E000;
-static constexpr int EMIT_SFX   = 0x1000F000;
-
-// Blocking operations
-static constexpr int WAIT_TURN  = 0x10011000;
-static constexpr int WAIT_MOVE  = 0x10012000;
-static constexpr int SLEEP      = 0x10013000;
-
-// Stack manipulation
-static constexpr int PUSH_CONSTANT    = 0x10021001;
-static constexpr int PUSH_LOCAL_VAR   = 0x10021002;
-static constexpr int PUSH_STATIC      = 0x10021004;
-static constexpr int CREATE_LOCAL_VAR = 0x10022000;
-static constexpr int POP_LOCAL_VAR    = 0x10023002;
-static constexpr int POP_STATIC       = 0x10023004;
-static constexpr int POP_STACK        = 0x10024000; ///< Not sure what this is supposed to do
-
-// Arithmetic operations
-static constexpr int ADD         = 0x10031000;
-static constexpr int SUB         = 0x10032000;
-static constexpr int MUL         = 0x10033000;
-static constexpr int DIV         = 0x10034000;
-static constexpr int MOD		  = 0x10034001; ///< spring specific
-static constexpr int BITWISE_AND = 0x10035000;
-static constexpr int BITWISE_OR  = 0x10036000;
-static constexpr int BITWISE_XOR = 0x10037000;
-static constexpr int BITWISE_NOT = 0x10038000;
-
-// Native function calls
-static constexpr int RAND           = 0x10041000;
-static constexpr int GET_UNIT_VALUE = 0x10042000;
-static constexpr int GET            = 0x10043000;
-
-// Comparison
-static constexpr int SET_LESS             = 0x10051000;
-static constexpr int SET_LESS_OR_EQUAL    = 0x10052000;
-static constexpr int SET_GREATER          = 0x10053000;
-static constexpr int SET_GREATER_OR_EQUAL = 0x10054000;
-static constexpr int SET_EQUAL            = 0x10055000;
-static constexpr int SET_NOT_EQUAL        = 0x10056000;
-static constexpr int LOGICAL_AND          = 0x10057000;
-static constexpr int LOGICAL_OR           = 0x10058000;
-static constexpr int LOGICAL_XOR          = 0x10059000;
-static constexpr int LOGICAL_NOT          = 0x1005A000;
-
-// Flow control
-static constexpr int START           = 0x10061000;
-static constexpr int CALL            = 0x10062000; ///< converted when executed
-static constexpr int REAL_CALL       = 0x10062001; ///< spring custom
-static constexpr int LUA_CALL        = 0x10062002; ///< spring custom
-static constexpr int JUMP            = 0x10064000;
-static constexpr int RETURN          = 0x10065000;
-static constexpr int JUMP_NOT_EQUAL  = 0x10066000;
-static constexpr int SIGNAL          = 0x10067000;
-static constexpr int SET_SIGNAL_MASK = 0x10068000;
-
-// Piece destruction
-static constexpr int EXPLODE    = 0x10071000;
-static constexpr int PLAY_SOUND = 0x10072000;
-
-// Special functions
-static constexpr int SET    = 0x10082000;
-static constexpr int ATTACH = 0x10083000;
-static constexpr int DROP   = 0x10084000;
-
 // Indices for SET, GET, and GET_UNIT_VALUE for LUA return values
 static constexpr int LUA0 = 110; // (LUA0 returns the lua call status, 0 or 1)
 static constexpr int LUA1 = 111;
@@ -419,14 +341,18 @@ bool CCobThread::Tick()
 	int r1, r2, r3, r4, r5, r6;
 
 	while (state == Run) {
+		if (scriptSampler.SampleDue(CScriptSampler::SOURCE_COB))
+			AddSample();
+
 		const int opcode = GET_LONG_PC();
 
-		switch (opcode) {
-			case PUSH_CONSTANT: {
+		// dense index, pre-decoded by CCobFile (jump-table dispatch)
+		switch (cobFile->opIndices[pc - 1]) {
+			case OP_PUSH_CONSTANT: {
 				r1 = GET_LONG_PC();
 				PushDataStack(r1);
 			} break;
-			case SLEEP: {
+			case OP_SLEEP: {
 				r1 = PopDataStack();
 				wakeTime = cobEngine->GetCurrTime() + r1;
 				state = Sleep;
@@ -434,21 +360,21 @@ bool CCobThread::Tick()
 				cobEngine->ScheduleThread(this);
 				return true;
 			} break;
-			case SPIN: {
+			case OP_SPIN: {
 				r1 = GET_LONG_PC();
 				r2 = GET_LONG_PC();
 				r3 = PopDataStack();         // speed
 				r4 = PopDataStack();         // accel
 				cobInst->Spin(r1, r2, r3, r4);
 			} break;
-			case STOP_SPIN: {
+			case OP_STOP_SPIN: {
 				r1 = GET_LONG_PC();
 				r2 = GET_LONG_PC();
 				r3 = PopDataStack();         // decel
 
 				cobInst->StopSpin(r1, r2, r3);
 			} break;
-			case RETURN: {
+			case OP_RETURN: {
 				retCode = PopDataStack();
 
 				if (LocalReturnAddr() == -1) {
@@ -468,35 +394,37 @@ bool CCobThread::Tick()
 			} break;
 
 
-			case SHADE: {
+			case OP_SHADE: {
 				r1 = GET_LONG_PC();
 			} break;
-			case DONT_SHADE: {
+			case OP_DONT_SHADE: {
 				r1 = GET_LONG_PC();
 			} break;
-			case CACHE: {
+			case OP_CACHE: {
 				r1 = GET_LONG_PC();
 			} break;
-			case DONT_CACHE: {
+			case OP_DONT_CACHE: {
 				r1 = GET_LONG_PC();
 			} break;
 
 
-			case CALL: {
+			case OP_CALL: {
 				r1 = GET_LONG_PC();
 				pc--;
 
 				if (cobFile->scriptNames[r1].find("lua_") == 0) {
 					cobFile->code[pc - 1] = LUA_CALL;
+					cobFile->opIndices[pc - 1] = OP_LUA_CALL;
 					LuaCall();
 					break;
 				}
 
 				cobFile->code[pc - 1] = REAL_CALL;
+				cobFile->opIndices[pc - 1] = OP_REAL_CALL;
 
 				// fall-through
 			}
-			case REAL_CALL: {
+			case OP_REAL_CALL: {
 				r1 = GET_LONG_PC();
 				r2 = GET_LONG_PC();
 
@@ -514,24 +442,24 @@ bool CCobThread::Tick()
 				// call cobFile->scriptNames[r1]
 				pc = cobFile->scriptOffsets[r1];
 			} break;
-			case LUA_CALL: {
+			case OP_LUA_CALL: {
 				LuaCall();
 			} break;
 
 
-			case POP_STATIC: {
+			case OP_POP_STATIC: {
 				r1 = GET_LONG_PC();
 				r2 = PopDataStack();
 
 				if (static_cast<size_t>(r1) < cobInst->staticVars.size())
 					cobInst->staticVars[r1] = r2;
 			} break;
-			case POP_STACK: {
+			case OP_POP_STACK: {
 				PopDataStack();
 			} break;
 
 
-			case START: {
+			case OP_START: {
 				r1 = GET_LONG_PC();
 				r2 = GET_LONG_PC();
 
@@ -549,14 +477,14 @@ bool CCobThread::Tick()
 				cobEngine->QueueAddThread(std::move(t));
 			} break;
 
-			case CREATE_LOCAL_VAR: {
+			case OP_CREATE_LOCAL_VAR: {
 				if (paramCount == 0) {
 					PushDataStack(0);
 				} else {
 					paramCount--;
 				}
 			} break;
-			case GET_UNIT_VALUE: {
+			case OP_GET_UNIT_VALUE: {
 				r1 = PopDataStack();
 				if ((r1 >= LUA0) && (r1 <= LUA9)) {
 					PushDataStack(luaArgs[r1 - LUA0]);
@@ -567,7 +495,7 @@ bool CCobThread::Tick()
 			} break;
 
 
-			case JUMP_NOT_EQUAL: {
+			case OP_JUMP_NOT_EQUAL: {
 				r1 = GET_LONG_PC();
 				r2 = PopDataStack();
 
@@ -575,7 +503,7 @@ bool CCobThread::Tick()
 					pc = r1;
 
 			} break;
-			case JUMP: {
+			case OP_JUMP: {
 				r1 = GET_LONG_PC();
 				// this seem to be an error in the docs..
 				//r2 = cobFile->scriptOffsets[LocalFunctionID()] + r1;
@@ -583,125 +511,125 @@ bool CCobThread::Tick()
 			} break;
 
 
-			case POP_LOCAL_VAR: {
+			case OP_POP_LOCAL_VAR: {
 				r1 = GET_LONG_PC();
 				r2 = PopDataStack();
 				dataStack[LocalStackFrame() + r1] = r2;
 			} break;
-			case PUSH_LOCAL_VAR: {
+			case OP_PUSH_LOCAL_VAR: {
 				r1 = GET_LONG_PC();
 				r2 = dataStack[LocalStackFrame() + r1];
 				PushDataStack(r2);
 			} break;
 
 
-			case BITWISE_AND: {
+			case OP_BITWISE_AND: {
 				r1 = PopDataStack();
 				r2 = PopDataStack();
 				PushDataStack(r1 & r2);
 			} break;
-			case BITWISE_OR: {
+			case OP_BITWISE_OR: {
 				r1 = PopDataStack();
 				r2 = PopDataStack();
 				PushDataStack(r1 | r2);
 			} break;
-			case BITWISE_XOR: {
+			case OP_BITWISE_XOR: {
 				r1 = PopDataStack();
 				r2 = PopDataStack();
 				PushDataStack(r1 ^ r2);
 			} break;
-			case BITWISE_NOT: {
+			case OP_BITWISE_NOT: {
 				r1 = PopDataStack();
 				PushDataStack(~r1);
 			} break;
 
-			case EXPLODE: {
+			case OP_EXPLODE: {
 				r1 = GET_LONG_PC();
 				r2 = PopDataStack();
 				cobInst->Explode(r1, r2);
 			} break;
 
-			case PLAY_SOUND: {
+			case OP_PLAY_SOUND: {
 				r1 = GET_LONG_PC();
 				r2 = PopDataStack();
 				cobInst->PlayUnitSound(r1, r2);
 			} break;
 
-			case PUSH_STATIC: {
+			case OP_PUSH_STATIC: {
 				r1 = GET_LONG_PC();
 
 				if (static_cast<size_t>(r1) < cobInst->staticVars.size())
 					PushDataStack(cobInst->staticVars[r1]);
 			} break;
 
-			case SET_NOT_EQUAL: {
+			case OP_SET_NOT_EQUAL: {
 				r1 = PopDataStack();
 				r2 = PopDataStack();
 
 				PushDataStack(int(r1 != r2));
 			} break;
-			case SET_EQUAL: {
+			case OP_SET_EQUAL: {
 				r1 = PopDataStack();
 				r2 = PopDataStack();
 
 				PushDataStack(int(r1 == r2));
 			} break;
 
-			case SET_LESS: {
+			case OP_SET_LESS: {
 				r2 = PopDataStack();
 				r1 = PopDataStack();
 
 				PushDataStack(int(r1 < r2));
 			} break;
-			case SET_LESS_OR_EQUAL: {
+			case OP_SET_LESS_OR_EQUAL: {
 				r2 = PopDataStack();
 				r1 = PopDataStack();
 
 				PushDataStack(int(r1 <= r2));
 			} break;
 
-			case SET_GREATER: {
+			case OP_SET_GREATER: {
 				r2 = PopDataStack();
 				r1 = PopDataStack();
 
 				PushDataStack(int(r1 > r2));
 			} break;
-			case SET_GREATER_OR_EQUAL: {
+			case OP_SET_GREATER_OR_EQUAL: {
 				r2 = PopDataStack();
 				r1 = PopDataStack();
 
 				PushDataStack(int(r1 >= r2));
 			} break;
 
-			case RAND: {
+			case OP_RAND: {
 				r2 = PopDataStack();
 				r1 = PopDataStack();
 				r3 = gsRNG.NextInt(r2 - r1 + 1) + r1;
 				PushDataStack(r3);
 			} break;
-			case EMIT_SFX: {
+			case OP_EMIT_SFX: {
 				r1 = PopDataStack();
 				r2 = GET_LONG_PC();
 				cobInst->EmitSfx(r1, r2);
 			} break;
-			case MUL: {
+			case OP_MUL: {
 				r1 = PopDataStack();
 				r2 = PopDataStack();
 				PushDataStack(r1 * r2);
 			} break;
 
 
-			case SIGNAL: {
+			case OP_SIGNAL: {
 				r1 = PopDataStack();
 				cobInst->Signal(r1);
 			} break;
-			case SET_SIGNAL_MASK: {
+			case OP_SET_SIGNAL_MASK: {
 				r1 = PopDataStack();
 				signalMask = r1;
 			} break;
 
 
-			case TURN: {
+			case OP_TURN: {
 				r2 = PopDataStack();
 				r1 = PopDataStack();
 				r3 = GET_LONG_PC(); // piece
@@ -709,7 +637,7 @@ bool CCobThread::Tick()
 
 				cobInst->Turn(r3, r4, r1, r2);
 			} break;
-			case GET: {
+			case OP_GET: {
 				r5 = PopDataStack();
 				r4 = PopDataStack();
 				r3 = PopDataStack();
@@ -722,19 +650,19 @@ bool CCobThread::Tick()
 				r6 = cobInst->GetUnitVal(r1, r2, r3, r4, r5);
 				PushDataStack(r6);
 			} break;
-			case ADD: {
+			case OP_ADD: {
 				r2 = PopDataStack();
 				r1 = PopDataStack();
 				PushDataStack(r1 + r2);
 			} break;
-			case SUB: {
+			case OP_SUB: {
 				r2 = PopDataStack();
 				r1 = PopDataStack();
 				r3 = r1 - r2;
 				PushDataStack(r3);
 			} break;
 
-			case DIV: {
+			case OP_DIV: {
 				r2 = PopDataStack();
 				r1 = PopDataStack();
 
@@ -746,7 +674,7 @@ bool CCobThread::Tick()
 				}
 				PushDataStack(r3);
 			} break;
-			case MOD: {
+			case OP_MOD: {
 				r2 = PopDataStack();
 				r1 = PopDataStack();
 
@@ -759,20 +687,20 @@ bool CCobThread::Tick()
 			} break;
 
 
-			case MOVE: {
+			case OP_MOVE: {
 				r1 = GET_LONG_PC();
 				r2 = GET_LONG_PC();
 				r4 = PopDataStack();
 				r3 = PopDataStack();
 				cobInst->Move(r1, r2, r3, r4);
 			} break;
-			case MOVE_NOW: {
+			case OP_MOVE_NOW: {
 				r1 = GET_LONG_PC();
 				r2 = GET_LONG_PC();
 				r3 = PopDataStack();
 				cobInst->MoveNow(r1, r2, r3);
 			} break;
-			case TURN_NOW: {
+			case OP_TURN_NOW: {
 				r1 = GET_LONG_PC();
 				r2 = GET_LONG_PC();
 				r3 = PopDataStack();
@@ -780,7 +708,7 @@ bool CCobThread::Tick()
 			} break;
 
 
-			case WAIT_TURN: {
+			case OP_WAIT_TURN: {
 				r1 = GET_LONG_PC();
 				r2 = GET_LONG_PC();
 
@@ -791,7 +719,7 @@ bool CCobThread::Tick()
 					return true;
 				}
 			} break;
-			case WAIT_MOVE: {
+			case OP_WAIT_MOVE: {
 				r1 = GET_LONG_PC();
 				r2 = GET_LONG_PC();
 
@@ -804,7 +732,7 @@ bool CCobThread::Tick()
 			} break;
 
 
-			case SET: {
+			case OP_SET: {
 				r2 = PopDataStack();
 				r1 = PopDataStack();
 
@@ -817,45 +745,45 @@ bool CCobThread::Tick()
 			} break;
 
 
-			case ATTACH: {
+			case OP_ATTACH: {
 				r3 = PopDataStack();
 				r2 = PopDataStack();
 				r1 = PopDataStack();
 				cobInst->AttachUnit(r2, r1);
 			} break;
-			case DROP: {
+			case OP_DROP: {
 				r1 = PopDataStack();
 				cobInst->DropUnit(r1);
 			} break;
 
 			// like bitwise ops, but only on values 1 and 0
-			case LOGICAL_NOT: {
+			case OP_LOGICAL_NOT: {
 				r1 = PopDataStack();
 				PushDataStack(int(r1 == 0));
 			} break;
-			case LOGICAL_AND: {
+			case OP_LOGICAL_AND: {
 				r1 = PopDataStack();
 				r2 = PopDataStack();
 				PushDataStack(int(r1 && r2));
 			} break;
-			case LOGICAL_OR: {
+			case OP_LOGICAL_OR: {
 				r1 = PopDataStack();
 				r2 = PopDataStack();
 				PushDataStack(int(r1 || r2));
 			} break;
-			case LOGICAL_XOR: {
+			case OP_LOGICAL_XOR: {
 				r1 = PopDataStack();
 				r2 = PopDataStack();
 				PushDataStack(int((!!r1) ^ (!!r2)));
 			} break;
 
 
-			case HIDE: {
+			case OP_HIDE: {
 				r1 = GET_LONG_PC();
 				cobInst->SetVisibility(r1, false);
 			} break;
 
-			case SHOW: {
+			case OP_SHOW: {
 				r1 = GET_LONG_PC();
 
 				int i;
@@ -912,6 +840,18 @@ void CCobThread::ShowError(const char* msg)
 	LOG_L(L_ERROR, "[COBThread::%s] %s (in %s:%s at %x)", __func__, msg, name, func, pc - 1);
 }
 
+void CCobThread::AddSample() const
+{
+	std::string stack = "COB;" + cobFile->name;
+
+	for (const CallInfo& ci: callStack) {
+		stack += ";";
+		stack += cobFile->scriptNames[ci.functionId];
+	}
+
+	scriptSampler.AddSample(stack);
+}
+
 
 void CCobThread::LuaCall()
 {
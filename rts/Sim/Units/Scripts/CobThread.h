@@ -74,6 +74,8 @@ public:
 	 * interpreter.
 	 */
 	void ShowError(const char* msg);
+	/// records the current call stack with the script sampler
+	void AddSample() const;
 	void AnimFinished(CUnitScript::AnimType type, int piece, int axis);
 
 	const std::string& GetName();
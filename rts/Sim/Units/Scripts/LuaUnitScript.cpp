@@ -17,6 +17,7 @@
 #include "Lua/LuaHandleSynced.h"
 #include "Lua/LuaRules.h"
 #include "Lua/LuaUtils.h"
+#include "Sim/Misc/GlobalSynced.h"
 #include "Sim/Projectiles/ExplosionGenerator.h"
 #include "Sim/Units/UnitHandler.h"
 #include "Sim/Units/Unit.h"
@@ -35,6 +36,8 @@ CR_REG_METADATA(CLuaUnitScript, (
 	CR_MEMBER(scriptIndex),
 	CR_MEMBER(scriptNames),
 	CR_IGNORED(inKilled),
+	CR_IGNORED(batchedWeaponPieces),
+	CR_IGNORED(batchedWeaponPiecesFrame),
 	CR_SERIALIZER(Serialize),
 	CR_POSTLOAD(PostLoad),
 	CR_PREALLOC(GetUnit)
@@ -221,6 +224,15 @@ Spring.UnitScript.UpdateCallIn(number unitID, string fname[, function callIn]) -
 	new functionID is returned.  If callIn isn't given or is nil, the callIn is
 	nilled, returns true if it was removed, or false if the callin didn't exist.
 	See also Spring.UnitScript.CreateScript.
+
+Spring.UnitScript.SetBatchQueryWeapons([function batchQuery]) -> nil
+	Opt-in: before the SlowUpdate of a batch of units the engine calls
+	batchQuery(unitIDs, weaponNums) once, with one entry per weapon of every
+	unit in the batch that has a QueryWeapon or AimFromWeapon callIn.  It must
+	return two arrays (queryPieces, aimFromPieces) of the same length; these
+	answer the next QueryWeapon resp. AimFromWeapon call for that weapon in
+	the same frame, a nil entry falls back to the regular callIn.
+	Without arguments the batch function is removed.
 */
 
 
@@ -237,6 +249,8 @@ Spring.UnitScript.UpdateCallIn(number unitID, string fname[, function callIn]) -
 CUnit* CLuaUnitScript::activeUnit;
 CUnitScript* CLuaUnitScript::activeScript;
 
+std::vector<std::pair<CLuaHandle*, int>> CLuaUnitScript::batchQueryWeaponsRefs;
+
 
 /******************************************************************************/
 /******************************************************************************/
@@ -301,6 +315,129 @@ void CLuaUnitScript::HandleFreed(CLuaHandle* handle)
 
 		spring::SafeDestruct(script);
 	}
+
+	const auto pred = [handle](const std::pair<CLuaHandle*, int>& p) { return (p.first == handle); };
+	const auto iter = std::remove_if(batchQueryWeaponsRefs.begin(), batchQueryWeaponsRefs.end(), pred);
+
+	batchQueryWeaponsRefs.erase(iter, batchQueryWeaponsRefs.end());
+}
+
+
+void CLuaUnitScript::BatchQueryWeapons(const std::vector<CUnit*>& units, size_t idxBeg, size_t idxEnd)
+{
+	if (batchQueryWeaponsRefs.empty())
+		return;
+
+	ZoneScoped;
+
+	static std::vector<CLuaUnitScript*> scripts;
+
+	for (size_t n = 0; n < batchQueryWeaponsRefs.size(); n++) {
+		CLuaHandle* handle = batchQueryWeaponsRefs[n].first;
+		lua_State* L = handle->GetLuaState();
+
+		int numEntries = 0;
+
+		scripts.clear();
+
+		for (size_t i = idxBeg; i < idxEnd; i++) {
+			CLuaUnitScript* luaScript = dynamic_cast<CLuaUnitScript*>(units[i]->script);
+
+			if (luaScript == nullptr || luaScript->handle != handle || luaScript->unit->weapons.empty())
+				continue;
+			if (!luaScript->HasFunction(LUAFN_QueryWeapon) && !luaScript->HasFunction(LUAFN_AimFromWeapon))
+				continue;
+
+			scripts.push_back(luaScript);
+			numEntries += luaScript->unit->weapons.size();
+		}
+
+		if (scripts.empty())
+			continue;
+
+		LUA_CALL_IN_CHECK(L);
+		lua_checkstack(L, 5);
+		lua_rawgeti(L, LUA_REGISTRYINDEX, batchQueryWeaponsRefs[n].second);
+
+		lua_createtable(L, numEntries, 0);
+		lua_createtable(L, numEntries, 0);
+
+		for (int k = 1; const CLuaUnitScript* luaScript: scripts) {
+			for (size_t w = 0, nw = luaScript->unit->weapons.size(); w < nw; w++, k++) {
+				lua_pushnumber(L, luaScript->unit->id);
+				lua_rawseti(L, -3, k);
+				lua_pushnumber(L, w + LUA_WEAPON_BASE_INDEX);
+				lua_rawseti(L, -2, k);
+			}
+		}
+
+		std::string err;
+
+		CUnit* oldActiveUnit = activeUnit;
+		CUnitScript* oldActiveScript = activeScript;
+
+		// no single unit is active during the batch call
+		activeUnit = nullptr;
+		activeScript = nullptr;
+
+		const int error = handle->RunCallInLUS(L, &err, 2, 2);
+
+		activeUnit = oldActiveUnit;
+		activeScript = oldActiveScript;
+
+		if (error != 0) {
+			LOG_L(L_ERROR, "[LuaUnitScript::%s][%s] error=%i trace=%s", __func__, handle->GetName().c_str(), error, err.c_str());
+
+			// stop batching for this handle, callins are used as normal
+			luaL_unref(L, LUA_REGISTRYINDEX, batchQueryWeaponsRefs[n].second);
+			batchQueryWeaponsRefs.erase(batchQueryWeaponsRefs.begin() + n--);
+			continue;
+		}
+
+		const bool haveQueryPieces = lua_istable(L, -2);
+		const bool haveAimFromPieces = lua_istable(L, -1);
+
+		const auto ToPiece = [L](int tableIdx, int k) {
+			lua_rawgeti(L, tableIdx, k);
+			// -2 means "not batched", -1 is an invalid piece as usual
+			const int piece = lua_isnumber(L, -1)? (lua_toint(L, -1) - 1): -2;
+			lua_pop(L, 1);
+			return piece;
+		};
+
+		for (int k = 1; CLuaUnitScript* luaScript: scripts) {
+			auto& pieces = luaScript->batchedWeaponPieces;
+
+			pieces.clear();
+			pieces.resize(luaScript->unit->weapons.size(), {-2, -2});
+
+			for (auto& p: pieces) {
+				p.first  = haveQueryPieces  ? ToPiece(-2, k): -2;
+				p.second = haveAimFromPieces? ToPiece(-1, k): -2;
+				k++;
+			}
+
+			luaScript->batchedWeaponPiecesFrame = gs->frameNum;
+		}
+
+		lua_pop(L, 2);
+	}
+}
+
+
+int CLuaUnitScript::PopBatchedWeaponPiece(int weaponNum, bool aimFrom)
+{
+	if (batchedWeaponPiecesFrame != gs->frameNum)
+		return -2;
+	if (static_cast<size_t>(weaponNum) >= batchedWeaponPieces.size())
+		return -2;
+
+	int& piece = aimFrom? batchedWeaponPieces[weaponNum].second: batchedWeaponPieces[weaponNum].first;
+	const int ret = piece;
+
+	// later calls this frame (e.g. after Shot) have to ask the script again
+	piece = -2;
+	return ret;
 }
 
 
@@ -835,6 +972,9 @@ int CLuaUnitScript::QueryBuildInfo()
 int CLuaUnitScript::QueryWeapon(int weaponNum)
 {
 	ZoneScoped;
+	if (const int piece = PopBatchedWeaponPiece(weaponNum, false); piece != -2)
+		return piece;
+
 	return RunQueryCallIn(LUAFN_QueryWeapon, weaponNum + LUA_WEAPON_BASE_INDEX);
 }
 
@@ -856,6 +996,9 @@ void  CLuaUnitScript::AimShieldWeapon(CPlasmaRepulser* weapon)
 int CLuaUnitScript::AimFromWeapon(int weaponNum)
 {
 	ZoneScoped;
+	if (const int piece = PopBatchedWeaponPiece(weaponNum, true); piece != -2)
+		return piece;
+
 	return RunQueryCallIn(LUAFN_AimFromWeapon, weaponNum + LUA_WEAPON_BASE_INDEX);
 }
 
@@ -1014,6 +1157,7 @@ bool CLuaUnitScript::PushEntries(lua_State* L)
 	REGISTER_LUA_CFUNC(CreateScript);
 	REGISTER_LUA_CFUNC(UpdateCallIn);
 	REGISTER_LUA_CFUNC(CallAsUnit);
+	REGISTER_LUA_CFUNC(SetBatchQueryWeapons);
 
 	REGISTER_LUA_CFUNC(GetUnitValue);
 	REGISTER_LUA_CFUNC(SetUnitValue);
@@ -1167,6 +1311,31 @@ int CLuaUnitScript::UpdateCallIn(lua_State* L)
 }
 
 
+int CLuaUnitScript::SetBatchQueryWeapons(lua_State* L)
+{
+	RECOIL_DETAILED_TRACY_ZONE;
+	CLuaHandle* handle = CLuaHandle::GetHandle(L);
+
+	if (!lua_isfunction(L, 1) && !lua_isnoneornil(L, 1))
+		luaL_error(L, "Incorrect arguments to %s()", __func__);
+
+	const auto pred = [handle](const std::pair<CLuaHandle*, int>& p) { return (p.first == handle); };
+	const auto iter = std::find_if(batchQueryWeaponsRefs.begin(), batchQueryWeaponsRefs.end(), pred);
+
+	if (iter != batchQueryWeaponsRefs.end()) {
+		luaL_unref(L, LUA_REGISTRYINDEX, iter->second);
+		batchQueryWeaponsRefs.erase(iter);
+	}
+
+	if (!lua_isfunction(L, 1))
+		return 0;
+
+	lua_settop(L, 1);
+	batchQueryWeaponsRefs.emplace_back(handle, luaL_ref(L, LUA_REGISTRYINDEX));
+	return 0;
+}
+
+
 int CLuaUnitScript::CallAsUnit(lua_State* L)
 {
 	RECOIL_DETAILED_TRACY_ZONE;
@@ -36,6 +36,14 @@ private:
 	// used to enforce SetDeathScriptFinished can only be used inside Killed
 	bool inKilled = false;
 
+	// {QueryWeapon, AimFromWeapon} answers per weapon from the batch call of
+	// batchedWeaponPiecesFrame, each consumed by the first matching callin
+	std::vector<std::pair<int, int>> batchedWeaponPieces;
+	int batchedWeaponPiecesFrame = -1;
+
+	// functions registered via SetBatchQueryWeapons, per handle
+	static std::vector<std::pair<CLuaHandle*, int>> batchQueryWeaponsRefs;
+
 public:
 	// for creg use only
 	CLuaUnitScript() : CUnitScript(nullptr) {}
@@ -139,9 +147,16 @@ public:
 	static void HandleFreed(CLuaHandle* handle);
 	static bool PushEntries(lua_State* L);
 
+	/// answers the QueryWeapon and AimFromWeapon callins of all weapons of
+	/// units[idxBeg, idxEnd) with one Lua call per handle that opted in
+	static void BatchQueryWeapons(const std::vector<CUnit*>& units, size_t idxBeg, size_t idxEnd);
+
 private:
+	int PopBatchedWeaponPiece(int weaponNum, bool aimFrom);
+
 	static int CreateScript(lua_State* L);
 	static int UpdateCallIn(lua_State* L);
+	static int SetBatchQueryWeapons(lua_State* L);
 
 	// other call-outs are stateful
 	static int CallAsUnit(lua_State* L);
@@ -42,6 +42,7 @@
 #include "Sim/Weapons/WeaponDef.h"
 #include "System/FastMath.h"
 #include "System/SpringMath.h"
+#include "System/XSimdOps.hpp"
 #include "System/Log/ILog.h"
 #include "System/StringUtil.h"
 #include "System/Sound/ISoundChannels.h"
@@ -179,31 +180,109 @@ void CUnitScript::TickAllAnims(int deltaTime)
 {
 	ZoneScoped;
 
-	// tick-functions; these never change address
-	static constexpr std::array<TickAnimFunc, ACount> TICK_ANIM_FUNCS = { &CUnitScript::TickTurnAnim, &CUnitScript::TickSpinAnim, &CUnitScript::TickMoveAnim };
-
 	const int tickRate = 1000 / deltaTime;
 
+	// every anim of a type touches a distinct (piece, axis) pair, so stepping
+	// them all before removing the finished ones gives the same result as the
+	// interleaved loop (including the order of doneAnims)
+	for (AnimInfo& ai: anims[ATurn]) {
+		ai.done |= TickTurnAnim(tickRate, *pieces[ai.piece], ai);
+	}
+	for (AnimInfo& ai: anims[ASpin]) {
+		ai.done |= TickSpinAnim(tickRate, *pieces[ai.piece], ai);
+	}
+
+	TickMoveAnims(tickRate);
+
 	for (int animType = ATurn; animType < ACount; animType++) {
-		auto& currAnims = anims[animType];
-		const auto& currFunc = TICK_ANIM_FUNCS[animType];
-		auto& currDoneAnims = doneAnims[animType];
+		GatherDoneAnims(static_cast<AnimType>(animType));
+	}
+}
+
+/**
+* @brief Batched MoveToward for all move anims; turn and spin anims use
+		(streflop) fmod via ClampRad and stay scalar to remain in sync.
+		+speed and -speed are exact, so this matches the scalar results
+		bit for bit.
+*/
+void CUnitScript::TickMoveAnims(int tickRate)
+{
+	using FloatBatch = xsimd::simd_type<float>;
+
+	static constexpr size_t CHUNK_SIZE = 64;
+	static_assert((CHUNK_SIZE % FloatBatch::size) == 0);
+
+	auto& moveAnims = anims[AMove];
+
+	alignas(64) std::array<float, CHUNK_SIZE> curVals;
+	alignas(64) std::array<float, CHUNK_SIZE> dstVals;
+	alignas(64) std::array<float, CHUNK_SIZE> spdVals;
+	alignas(64) std::array<float, CHUNK_SIZE> endVals;
+
+	for (size_t chunkBeg = 0; chunkBeg < moveAnims.size(); chunkBeg += CHUNK_SIZE) {
+		const size_t chunkLen = std::min(moveAnims.size() - chunkBeg, CHUNK_SIZE);
+		const size_t batchLen = AlignUp(chunkLen, FloatBatch::size);
+
+		for (size_t j = 0; j < chunkLen; j++) {
+			const AnimInfo& ai = moveAnims[chunkBeg + j];
 
-		for (size_t i = 0; i < currAnims.size(); ) {
-			AnimInfo& ai = currAnims[i];
+			curVals[j] = pieces[ai.piece]->GetPosition()[ai.axis];
+			dstVals[j] = ai.dest;
+			spdVals[j] = ai.speed / tickRate;
+		}
+		for (size_t j = chunkLen; j < batchLen; j++) {
+			curVals[j] = 0.0f;
+			dstVals[j] = 0.0f;
+			spdVals[j] = 0.0f;
+		}
+
+		for (size_t j = 0; j < batchLen; j += FloatBatch::size) {
+			const FloatBatch cur = xsimd::load_aligned(&curVals[j]);
+			const FloatBatch dst = xsimd::load_aligned(&dstVals[j]);
+			const FloatBatch spd = xsimd::load_aligned(&spdVals[j]);
+
+			const FloatBatch delta = dst - cur;
+			const auto reached = (xsimd::abs(delta) <= spd);
+
+			// Sign(delta) treats zero as negative
+			const FloatBatch step = xsimd::select(delta > FloatBatch(0.0f), spd, -spd);
+
+			xsimd::store_aligned(&curVals[j], xsimd::select(reached, dst, cur + step));
+			xsimd::store_aligned(&endVals[j], xsimd::select(reached, FloatBatch(1.0f), FloatBatch(0.0f)));
+		}
+
+		// note: must copy-and-set here (LMP dirty flag, etc)
+		for (size_t j = 0; j < chunkLen; j++) {
+			AnimInfo& ai = moveAnims[chunkBeg + j];
 			LocalModelPiece& lmp = *pieces[ai.piece];
 
-			if ((ai.done |= std::invoke(currFunc, this, tickRate, lmp, ai))) {
-				if (ai.hasWaiting)
-					currDoneAnims.emplace_back(ai);
+			float3 pos = lmp.GetPosition();
+			pos[ai.axis] = curVals[j];
+			lmp.SetPosition(pos);
 
-				ai = std::move(currAnims.back());
-				currAnims.pop_back();
-				continue;
-			}
+			ai.done |= (endVals[j] != 0.0f);
+		}
+	}
+}
+
+void CUnitScript::GatherDoneAnims(AnimType type)
+{
+	auto& currAnims = anims[type];
+	auto& currDoneAnims = doneAnims[type];
+
+	for (size_t i = 0; i < currAnims.size(); ) {
+		AnimInfo& ai = currAnims[i];
 
-			++i;
+		if (ai.done) {
+			if (ai.hasWaiting)
+				currDoneAnims.emplace_back(ai);
+
+			ai = std::move(currAnims.back());
+			currAnims.pop_back();
+			continue;
 		}
+
+		++i;
 	}
 }
 
@@ -46,8 +46,6 @@ protected:
 	typedef std::vector<AnimInfo> AnimContainerType;
 	typedef AnimContainerType::iterator AnimContainerTypeIt;
 
-	typedef bool(CUnitScript::*TickAnimFunc)(int, LocalModelPiece&, AnimInfo&);
-
 	std::array<AnimContainerType, ACount> anims;
 	std::array<AnimContainerType, ACount> doneAnims;
 
@@ -59,6 +57,9 @@ protected:
 	bool TurnToward(float& cur, float dest, float speed);
 	bool DoSpin(float& cur, float dest, float& speed, float accel, int divisor);
 
+	void TickMoveAnims(int tickRate);
+	void GatherDoneAnims(AnimType type);
+
 	AnimContainerTypeIt FindAnim(AnimType type, int piece, int axis);
 	void RemoveAnim(AnimType type, const AnimContainerTypeIt& animInfoIt);
 	void AddAnim(AnimType type, int piece, int axis, float speed, float dest, float accel);
@@ -656,6 +656,12 @@ void CUnit::DisableScriptMoveType()
 
 
 void CUnit::Update()
+{
+	RECOIL_DETAILED_TRACY_ZONE;
+	UpdateLocal();
+}
+
+void CUnit::UpdateLocal()
 {
 	RECOIL_DETAILED_TRACY_ZONE;
 	ASSERT_SYNCED(pos);
@@ -84,6 +84,12 @@ public:
 	virtual void Update();
 	virtual void SlowUpdate();
 
+	// the part of Update that only touches this unit (no events, no
+	// quadfield moves, no synced RNG); safe to call from worker threads
+	void UpdateLocal();
+	// false for unit types whose Update has side effects on other objects
+	virtual bool HasLocalUpdate() const { return true; }
+
 	const SolidObjectDef* GetDef() const { return ((const SolidObjectDef*) unitDef); }
 
 	virtual void DoDamage(const DamageArray& damages, const float3& impulse, CUnit* attacker, int weaponDefID, int projectileID);
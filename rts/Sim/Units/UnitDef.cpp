@@ -804,15 +804,15 @@ void UnitDef::CreateYardMap(std::string&& yardMapStr)
 	unsigned int ymReadIdx = highResMap;
 	unsigned int ymCopyIdx = 0;
 
-	std::array<YardMapStatus, 256 * 256> defYardMap;
-
-	if (ymSize > defYardMap.size()) {
+	if (ymSize > (256 * 256)) {
 		LOG_L(L_WARNING, "[%s] %s: footprint{x=%u,z=%u} too large to create %s-res yardmap", __func__, name.c_str(), xsize, zsize, highResMap? "high": "low");
 		return;
 	}
 
+	// only as large as the footprint, most buildings need a few dozen squares
+	std::vector<YardMapStatus> defYardMap(ymSize, YARDMAP_BLOCKED);
+
 	yardmap.resize(xsize * zsize);
-	defYardMap.fill(YARDMAP_BLOCKED);
 
 	// read the yardmap from the LuaDef string
 	while (ymReadIdx < yardMapStr.size()) {
@@ -247,3 +247,48 @@ void CUnitDefHandler::SanitizeUnitDefs()
 		}
 	}
 }
+
+std::vector<int> CUnitDefHandler::GetReachableUnitDefIDs(const std::vector<std::string>& rootNames) const
+{
+	RECOIL_DETAILED_TRACY_ZONE;
+	std::vector<bool> reached(unitDefsVector.size(), false);
+	std::vector<int> reachedIDs;
+	std::vector<int> pendingIDs;
+
+	const auto AddUnitDefID = [&](int id) {
+		if (!IsValidUnitDefID(id) || reached[id])
+			return;
+
+		reached[id] = true;
+		pendingIDs.push_back(id);
+	};
+	const auto AddUnitDefName = [&](const std::string& name) {
+		const auto it = unitDefIDs.find(StringToLower(name));
+
+		if (it == unitDefIDs.end())
+			return;
+
+		AddUnitDefID(it->second);
+	};
+
+	for (const std::string& name: rootNames) {
+		AddUnitDefName(name);
+	}
+
+	while (!pendingIDs.empty()) {
+		const UnitDef& ud = unitDefsVector[pendingIDs.back()];
+
+		pendingIDs.pop_back();
+		reachedIDs.push_back(ud.id);
+
+		for (const auto& buildOpt: ud.buildOptions) {
+			AddUnitDefName(buildOpt.second);
+		}
+
+		if (ud.decoyDef != nullptr)
+			AddUnitDefID(ud.decoyDef->id);
+	}
+
+	std::sort(reachedIDs.begin(), reachedIDs.end());
+	return reachedIDs;
+}
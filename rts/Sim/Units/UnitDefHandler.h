@@ -60,6 +60,9 @@ public:
 
 	void SanitizeUnitDefs();
 
+	/// IDs of the named units, everything they can build (also indirectly) and the decoys' real defs
+	std::vector<int> GetReachableUnitDefIDs(const std::vector<std::string>& rootNames) const;
+
 protected:
 	void UnitDefLoadSounds(UnitDef*, const LuaTable&);
 	void LoadSounds(const LuaTable&, GuiSoundSet&, const std::string& soundName);
@@ -11,18 +11,26 @@
 #include "UnitTypes/Factory.h"
 
 #include "CommandAI/BuilderCAI.h"
+#include "CommandAI/BuilderCaches.h"
+#include "CommandAI/Systems/MobileCAIGoalSystem.h"
+#include "Game/GameHelper.h"
 #include "Sim/Ecs/Registry.h"
 #include "Sim/Misc/GlobalSynced.h"
 #include "Sim/Misc/ModInfo.h"
 #include "Sim/Misc/TeamHandler.h"
 #include "Sim/MoveTypes/MoveType.h"
+#include "Sim/MoveTypes/Systems/AirMoveSystem.h"
 #include "Sim/MoveTypes/Systems/GeneralMoveSystem.h"
 #include "Sim/MoveTypes/Systems/GroundMoveSystem.h"
 #include "Sim/MoveTypes/Systems/UnitTrapCheckSystem.h"
 #include "Sim/Path/IPathManager.h"
+#include "Sim/Units/Scripts/LuaUnitScript.h"
+#include "Sim/Weapons/HitscanQueue.h"
 #include "Sim/Weapons/Weapon.h"
 #include "System/EventHandler.h"
+#include "System/FrameArena.h"
 #include "System/Log/ILog.h"
+#include "System/MemPoolStats.h"
 #include "System/SpringMath.h"
 #include "System/Threading/ThreadPool.h"
 #include "System/TimeProfiler.h"
@@ -35,6 +43,7 @@
 #include "System/Config/ConfigHandler.h"
 CONFIG(bool, UpdateWeaponVectorsMT).deprecated(true);
 CONFIG(bool, UpdateBoundingVolumeMT).deprecated(true);
+CONFIG(bool, ProfileSlowUpdateByUnitDef).defaultValue(false).description("Report the SlowUpdate time of every UnitDef as a separate time profiler entry.");
 
 
 CR_BIND(CUnitHandler, )
@@ -52,6 +61,9 @@ CR_REG_METADATA(CUnitHandler, (
 	CR_MEMBER(activeSlowUpdateUnit),
 	CR_MEMBER(activeUpdateUnit),
 
+	CR_MEMBER(slowUpdateCycleCost),
+	CR_MEMBER(slowUpdateCostDone),
+
 	CR_MEMBER(maxUnits),
 	CR_MEMBER(maxUnitRadius),
 
@@ -61,6 +73,7 @@ CR_REG_METADATA(CUnitHandler, (
 
 
 UnitMemPool unitMemPool;
+static MemPoolRegistrar unitMemPoolRegistrar("Units", unitMemPool);
 
 CUnitHandler unitHandler;
 
@@ -96,6 +109,7 @@ CUnit* CUnitHandler::NewUnit(const UnitDef* ud)
 void CUnitHandler::Init() {
 	RECOIL_DETAILED_TRACY_ZONE;
 	GroundMoveSystem::Init();
+	AirMoveSystem::Init();
 	GeneralMoveSystem::Init();
 	UnitTrapCheckSystem::Init();
 
@@ -113,11 +127,19 @@ void CUnitHandler::Init() {
 	{
 		activeSlowUpdateUnit = 0;
 		activeUpdateUnit = 0;
+
+		slowUpdateCycleCost = 0;
+		slowUpdateCostDone = 0;
+
+		profileSlowUpdateDefs = configHandler->GetBool("ProfileSlowUpdateByUnitDef");
+		slowUpdateDefTimes.clear();
 	}
 	{
 		units.resize(maxUnits, nullptr);
 		activeUnits.reserve(maxUnits);
 
+		transformCache.Init(maxUnits);
+
 		unitMemPool.reserve(128);
 
 		// id's are used as indices, so they must lie in [0, units.size() - 1]
@@ -145,6 +167,7 @@ void CUnitHandler::Kill()
 		unitMemPool.clear();
 
 		units.clear();
+		transformCache.Kill();
 
 		for (int teamNum = 0; teamNum < MAX_TEAMS; teamNum++) {
 			// reuse inner vectors when reloading
@@ -318,6 +341,7 @@ void CUnitHandler::DeleteUnit(CUnit* delUnit)
 	idPool.FreeID(delUnit->id, true);
 
 	units[delUnit->id] = nullptr;
+	transformCache.Clear(delUnit->id);
 
 	entt::entity delUnitEntity = delUnit->entityReference;
 
@@ -334,6 +358,7 @@ void CUnitHandler::UpdateUnitMoveTypes()
 	SCOPED_TIMER("Sim::Unit::MoveType");
 
 	GroundMoveSystem::Update();
+	AirMoveSystem::Update();
 	GeneralMoveSystem::Update();
 	UnitTrapCheckSystem::Update();
 }
@@ -355,49 +380,164 @@ void CUnitHandler::SlowUpdateUnits()
 
 	assert(activeSlowUpdateUnit >= 0);
 
+	const int cyclePhase = gs->frameNum % UNIT_SLOWUPDATE_RATE;
+
 	// reset the iterator every <UNIT_SLOWUPDATE_RATE> frames
-	if ((gs->frameNum % UNIT_SLOWUPDATE_RATE) == 0)
+	if (cyclePhase == 0) {
 		activeSlowUpdateUnit = 0;
 
+		if (modInfo.unitSlowUpdateByCost) {
+			slowUpdateCycleCost = 0;
+			slowUpdateCostDone = 0;
+
+			for (const CUnit* unit: activeUnits) {
+				slowUpdateCycleCost += GetSlowUpdateCost(unit);
+			}
+		}
+	}
+
+	// stagger the SlowUpdate's; the slice is fixed here before any unit runs
 	const size_t idxBeg = activeSlowUpdateUnit;
-	const size_t maximumCnt = activeUnits.size() - idxBeg;
-	const size_t logicalCnt = (activeUnits.size() / UNIT_SLOWUPDATE_RATE) + 1;
-	const size_t indCnt = logicalCnt > maximumCnt ? maximumCnt : logicalCnt;
-	const size_t idxEnd = idxBeg + indCnt;
+	const size_t idxEnd = modInfo.unitSlowUpdateByCost? GetSlowUpdateSliceEndByCost(idxBeg, cyclePhase): GetSlowUpdateSliceEnd(idxBeg);
 
 	activeSlowUpdateUnit = idxEnd;
-	// stagger the SlowUpdate's
 
-	static std::vector<CUnit*> updateBoundingVolumeList;
-	updateBoundingVolumeList.clear();
+	if (modInfo.weaponTargetMT) {
+		ZoneScopedN("Sim::Unit::SlowUpdateTargetsMT");
+		helper->PrefetchWeaponTargets(activeUnits, idxBeg, idxEnd);
+	}
+	if (modInfo.mobileCAIGoalCheckMT) {
+		ZoneScopedN("Sim::Unit::SlowUpdateGoalsMT");
+		MobileCAIGoalSystem::Update(idxBeg, idxEnd);
+	}
+	{
+		// no-op unless a synced Lua handle registered a batch function
+		CLuaUnitScript::BatchQueryWeapons(activeUnits, idxBeg, idxEnd);
+	}
+
+	FrameVector<CUnit*> updateBoundingVolumeList;
 	{
 		ZoneScopedN("Sim::Unit::SlowUpdateST");
+
+		CBuilderCaches::BeginAreaCaching();
+
+		// unsynced wall-clock measurements, never fed back into the schedule
+		const bool profileDefs = profileSlowUpdateDefs && CTimeProfiler::GetInstance().IsEnabled();
+
 		for (size_t i = idxBeg; i < idxEnd; ++i) {
 			CUnit* unit = activeUnits[i];
 
+			const spring_time t0 = profileDefs? spring_gettime(): spring_notime;
+
 			unit->SanityCheck();
 			unit->SlowUpdate();
 			unit->SlowUpdateWeapons();
 			unit->SanityCheck();
 
+			if (profileDefs)
+				AddSlowUpdateDefTime(unit->unitDef, t0, spring_gettime() - t0);
+
 			if (!unit->isDead && unit->localModel.GetBoundariesNeedsRecalc())
 				updateBoundingVolumeList.emplace_back(unit);
 		}
+
+		if (profileDefs)
+			ReportSlowUpdateDefTimes();
+
+		// unconsumed candidates would be stale by the next AutoTarget call
+		helper->ClearPrefetchedWeaponTargets();
+		CBuilderCaches::EndAreaCaching();
 	}
 	// Since the bounding volumes are calculated from the maximum piecematrix-offset piece vertices
 	// They dont have much of an effect if updated late-ish.
 	{
 		ZoneScopedN("Sim::Unit::SlowUpdateMT");
-		for_mt(0, updateBoundingVolumeList.size(), [](int i) {
+		for_mt(0, updateBoundingVolumeList.size(), [&updateBoundingVolumeList](int i) {
 			updateBoundingVolumeList[i]->localModel.UpdateBoundingVolume();
 		});
 	}
 }
 
+uint32_t CUnitHandler::GetSlowUpdateCost(const CUnit* unit)
+{
+	// synced estimate, must only depend on synced state
+	const UnitDef* ud = unit->unitDef;
+
+	uint32_t cost = 1;
+	cost += unit->weapons.size();
+	cost += 2 * (ud->IsMobileBuilderUnit() || ud->IsStaticBuilderUnit());
+	cost += 1 * (ud->IsFactoryUnit());
+	cost += 1 * (ud->canmove);
+
+	return cost;
+}
+
+size_t CUnitHandler::GetSlowUpdateSliceEnd(size_t idxBeg) const
+{
+	const size_t maximumCnt = activeUnits.size() - idxBeg;
+	const size_t logicalCnt = (activeUnits.size() / UNIT_SLOWUPDATE_RATE) + 1;
+
+	return (idxBeg + std::min(logicalCnt, maximumCnt));
+}
+
+size_t CUnitHandler::GetSlowUpdateSliceEndByCost(size_t idxBeg, int cyclePhase)
+{
+	// units created during the cycle are not part of slowUpdateCycleCost,
+	// the final frame of each cycle sweeps up whatever is left over
+	if (cyclePhase == (UNIT_SLOWUPDATE_RATE - 1))
+		return activeUnits.size();
+
+	const uint64_t costTarget = (slowUpdateCycleCost * (cyclePhase + 1)) / UNIT_SLOWUPDATE_RATE;
+
+	size_t idxEnd = idxBeg;
+
+	while (idxEnd < activeUnits.size() && slowUpdateCostDone < costTarget) {
+		slowUpdateCostDone += GetSlowUpdateCost(activeUnits[idxEnd++]);
+	}
+
+	return idxEnd;
+}
+
+void CUnitHandler::AddSlowUpdateDefTime(const UnitDef* ud, spring_time t0, spring_time dt)
+{
+	if (static_cast<size_t>(ud->id) >= slowUpdateDefTimes.size())
+		slowUpdateDefTimes.resize(ud->id + 1, {0, spring_notime, spring_notime});
+
+	auto& [nameHash, startTime, deltaTime] = slowUpdateDefTimes[ud->id];
+
+	if (nameHash == 0) {
+		const std::string timerName = "Sim::Unit::SlowUpdate::" + ud->name;
+
+		nameHash = hashString(timerName.c_str());
+		CTimeProfiler::RegisterTimer(timerName.c_str());
+	}
+
+	if (!deltaTime.isDuration())
+		startTime = t0;
+
+	deltaTime += dt;
+}
+
+void CUnitHandler::ReportSlowUpdateDefTimes()
+{
+	for (auto& [nameHash, startTime, deltaTime]: slowUpdateDefTimes) {
+		if (!deltaTime.isDuration())
+			continue;
+
+		CTimeProfiler::GetInstance().AddTime(nameHash, startTime, deltaTime);
+		deltaTime = spring_notime;
+	}
+}
+
 void CUnitHandler::UpdateUnits()
 {
 	SCOPED_TIMER("Sim::Unit::Update");
 
+	if (modInfo.unitUpdateMT) {
+		UpdateUnitsMT();
+		return;
+	}
+
 	size_t activeUnitCount = activeUnits.size();
 	for (size_t i = 0; i < activeUnitCount; ++i) {
 		CUnit* unit = activeUnits[i];
@@ -413,6 +553,61 @@ void CUnitHandler::UpdateUnits()
 	}
 }
 
+void CUnitHandler::UpdateUnitsMT()
+{
+	// per-unit deferred side effects, indexed like activeUnits so they are
+	// applied in the same order no matter which thread produced them
+	enum {
+		UPDATE_SERIAL  = 1,
+		UPDATE_QUADMAP = 2,
+	};
+
+	static std::vector<uint8_t> deferredUpdates;
+	deferredUpdates.clear();
+	deferredUpdates.resize(activeUnits.size(), 0);
+
+	{
+		ZoneScopedN("Sim::Unit::UpdateMT");
+		for_mt_chunk(0, activeUnits.size(), [&](const int i) {
+			CUnit* unit = activeUnits[i];
+
+			// units with cross-object side effects are updated in full below
+			if (!unit->HasLocalUpdate()) {
+				deferredUpdates[i] = UPDATE_SERIAL;
+				return;
+			}
+
+			unit->SanityCheck();
+			unit->UpdateLocal();
+			unit->SanityCheck();
+
+			deferredUpdates[i] = UPDATE_QUADMAP * unit->moveType->WantCollisionMapUpdate();
+		});
+	}
+	{
+		ZoneScopedN("Sim::Unit::UpdateST");
+		for (size_t i = 0, n = activeUnits.size(); i < n; ++i) {
+			CUnit* unit = activeUnits[i];
+
+			switch (deferredUpdates[i]) {
+				case UPDATE_SERIAL: {
+					unit->SanityCheck();
+					unit->Update();
+					unit->moveType->UpdateCollisionMap();
+					unit->SanityCheck();
+				} break;
+				case UPDATE_QUADMAP: {
+					unit->moveType->UpdateCollisionMap(true);
+				} break;
+				default: {
+				} break;
+			}
+
+			assert(activeUnits[i] == unit);
+		}
+	}
+}
+
 void CUnitHandler::UpdateUnitWeapons()
 {
 	{
@@ -425,9 +620,13 @@ void CUnitHandler::UpdateUnitWeapons()
 	}
 	{
 		SCOPED_TIMER("Sim::Unit::Weapon");
+		CHitscanQueue::Begin();
+
 		for (activeUpdateUnit = 0; activeUpdateUnit < activeUnits.size(); ++activeUpdateUnit) {
 			activeUnits[activeUpdateUnit]->UpdateWeapons();
 		}
+
+		CHitscanQueue::Flush();
 	}
 }
 
@@ -436,9 +635,10 @@ void CUnitHandler::UpdatePreFrame()
 	SCOPED_TIMER("Sim::Unit::UpdatePreFrame");
 	inUpdateCall = true;
 
-	for (CUnit* unit : activeUnits) {
-		unit->UpdatePrevFrameTransform();
-	}
+	// only touches per-unit state (incl. the unit's own piece tree)
+	for_mt_chunk(0, activeUnits.size(), [this](const int i) {
+		activeUnits[i]->UpdatePrevFrameTransform();
+	});
 
 	inUpdateCall = false;
 }
@@ -453,6 +653,14 @@ void CUnitHandler::UpdatePostFrame()
 	}
 	unitsJustAdded.clear();
 
+	// not serialized, rebuilt here after loading
+	if (transformCache.Size() != units.size())
+		transformCache.Init(units.size());
+
+	for_mt_chunk(0, activeUnits.size(), [this](const int i) {
+		transformCache.Store(activeUnits[i]);
+	});
+
 	inUpdateCall = false;
 }
 
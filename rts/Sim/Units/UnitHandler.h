@@ -4,10 +4,13 @@
 #define UNITHANDLER_H
 
 #include <array>
+#include <tuple>
 #include <vector>
 
 #include "Sim/Misc/GlobalConstants.h"
 #include "Sim/Misc/SimObjectIDPool.h"
+#include "Sim/Objects/SolidObjectTransformCache.h"
+#include "System/Misc/SpringTime.h"
 #include "System/creg/STL_Map.h"
 
 struct UnitDef;
@@ -52,6 +55,10 @@ public:
 
 	/// Returns true if a unit of type unitID can be built, false otherwise
 	bool CanBuildUnit(const UnitDef* unitdef, int team) const;
+
+	/// synced relative cost estimate of one SlowUpdate, used by the unitSlowUpdateByCost scheduler
+	static uint32_t GetSlowUpdateCost(const CUnit* unit);
+
 	bool GarbageCollectUnit(unsigned int id);
 
 	void AddBuilderCAI(CBuilderCAI*);
@@ -77,6 +84,9 @@ public:
 
 	const spring::unordered_map<unsigned int, CBuilderCAI*>& GetBuilderCAIs() const { return builderCAIs; }
 
+	/// end-of-frame copies of unit transforms, unsynced readers only
+	const CSolidObjectTransformCache& GetTransformCache() const { return transformCache; }
+
 private:
 	void InsertActiveUnit(CUnit* unit);
 	bool QueueDeleteUnit(CUnit* unit);
@@ -84,10 +94,15 @@ private:
 	void DeleteUnit(CUnit* unit);
 	void DeleteUnits();
 	void SlowUpdateUnits();
+	size_t GetSlowUpdateSliceEnd(size_t idxBeg) const;
+	size_t GetSlowUpdateSliceEndByCost(size_t idxBeg, int cyclePhase);
+	void AddSlowUpdateDefTime(const UnitDef* ud, spring_time t0, spring_time dt);
+	void ReportSlowUpdateDefTimes();
 	void UpdateUnitPathing(const size_t idxBeg, const size_t idxEnd);
 	void UpdateUnitMoveTypes();
 	void UpdateUnitLosStates();
 	void UpdateUnits();
+	void UpdateUnitsMT();
 	void UpdateUnitWeapons();
 
 	void GetUnitsWithPathRequests(std::vector<CUnit*>& unitsToMove, const size_t idxBeg, const size_t idxEnd);
@@ -106,10 +121,19 @@ private:
 
 	spring::unordered_map<unsigned int, CBuilderCAI*> builderCAIs;
 
+	CSolidObjectTransformCache transformCache;
+
 
 	size_t activeSlowUpdateUnit = 0;  ///< first unit of batch that will be SlowUpdate'd this frame
 	size_t activeUpdateUnit = 0;      ///< first unit of batch that will be SlowUpdate'd this frame
 
+	uint64_t slowUpdateCycleCost = 0; ///< summed GetSlowUpdateCost of activeUnits at the start of the cycle
+	uint64_t slowUpdateCostDone = 0;  ///< summed GetSlowUpdateCost of the units SlowUpdate'd so far this cycle
+
+	///< unsynced; per-UnitDef {timer-hash, start, accumulated} SlowUpdate time of the current frame
+	std::vector<std::tuple<unsigned, spring_time, spring_time>> slowUpdateDefTimes;
+	bool profileSlowUpdateDefs = false;
+
 
 	///< global unit-limit (derived from the per-team limit)
 	///< units.size() is equal to this and constant at runtime
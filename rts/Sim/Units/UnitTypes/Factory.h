@@ -28,6 +28,7 @@ public:
 	unsigned int QueueBuild(const UnitDef* buildeeDef, const Command& buildCmd);
 
 	void Update();
+	bool HasLocalUpdate() const override { return false; }
 
 	void DependentDied(CObject* o);
 	void CreateNanoParticle(bool highPriority = false);
@@ -1,6 +1,7 @@
 /* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
 
 #include "BeamLaser.h"
+#include "HitscanQueue.h"
 #include "PlasmaRepulser.h"
 #include "WeaponDef.h"
 #include "Game/GameHelper.h"
@@ -274,8 +275,6 @@ void CBeamLaser::FireImpl(const bool scriptCall)
 void CBeamLaser::FireInternal(float3 curDir)
 {
 	RECOIL_DETAILED_TRACY_ZONE;
-	float actualRange = range;
-
 	/* FPS mode targeting essentially behaves as if with targetBorder=1,
 	 * even for units without this property. The practical effect is that
 	 * you can FPS a beamlaser turret and shoot units (esp. enemy turrets
@@ -290,23 +289,7 @@ void CBeamLaser::FireInternal(float3 curDir)
     	 * mode (embrace or deprecate) but for now it doesn't hurt too much
        	 * to keep this. */
 	float rangeMod = 1.0f - (0.05f * owner->UnderFirstPersonControl());
-
-	bool tryAgain = true;
-	bool doDamage = true;
-
 	float maxLength = range * rangeMod;
-	float curLength = 0.0f;
-
-	float3 curPos = weaponMuzzlePos;
-	float3 hitPos;
-	float3 newDir;
-
-	// objects at the end of the beam
-	CUnit* hitUnit = nullptr;
-	CFeature* hitFeature = nullptr;
-	CPlasmaRepulser* hitShield = nullptr;
-	static std::vector<TraceRay::SShieldDist> hitShields;
-	CollisionQuery hitColQuery;
 
 	if (!sweepFireState.IsSweepFiring()) {
 		curDir += (gsRNG.NextVector() * SprayAngleExperience());
@@ -329,8 +312,44 @@ void CBeamLaser::FireInternal(float3 curDir)
 		maxLength = std::min(maxLength, sweepFireState.GetTargetDist3D() * 1.125f);
 	}
 
+	if (CHitscanQueue::IsActive()) {
+		CHitscanQueue::AddShot(this, weaponMuzzlePos, curDir, maxLength, collisionFlags);
+		return;
+	}
+
+	FireBeam(curDir, maxLength, nullptr);
+}
+
+void CBeamLaser::FireBeam(float3 curDir, float maxLength, const TraceRay::SRayCandidates* candidates)
+{
+	RECOIL_DETAILED_TRACY_ZONE;
+	float actualRange = range;
+
+	bool tryAgain = true;
+	bool doDamage = true;
+
+	float curLength = 0.0f;
+
+	float3 curPos = weaponMuzzlePos;
+	float3 hitPos;
+	float3 newDir;
+
+	// objects at the end of the beam
+	CUnit* hitUnit = nullptr;
+	CFeature* hitFeature = nullptr;
+	CPlasmaRepulser* hitShield = nullptr;
+	static std::vector<TraceRay::SShieldDist> hitShields;
+	CollisionQuery hitColQuery;
+
 	for (int tries = 0; tries < 5 && tryAgain; ++tries) {
-		float beamLength = TraceRay::TraceRay(curPos, curDir, maxLength - curLength, collisionFlags, owner, hitUnit, hitFeature, &hitColQuery);
+		float beamLength = 0.0f;
+
+		// candidates were gathered for the first segment, reflections trace from scratch
+		if (tries == 0 && candidates != nullptr) {
+			beamLength = TraceRay::TraceRayCandidates(curPos, curDir, maxLength, collisionFlags, owner, *candidates, hitUnit, hitFeature, &hitColQuery);
+		} else {
+			beamLength = TraceRay::TraceRay(curPos, curDir, maxLength - curLength, collisionFlags, owner, hitUnit, hitFeature, &hitColQuery);
+		}
 
 		if (hitUnit != nullptr && teamHandler.AlliedTeams(hitUnit->team, owner->team)) {
 			if (sweepFireState.IsSweepFiring() && !sweepFireState.DamageAllies()) {
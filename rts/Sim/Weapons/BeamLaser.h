@@ -16,6 +16,8 @@ public:
 	void Update() override final;
 	void Init() override final;
 
+	void FireQueuedHitscan(const float3& dir, float length, const TraceRay::SRayCandidates* candidates) override final { FireBeam(dir, length, candidates); }
+
 private:
 	float3 GetFireDir(bool sweepFire, bool scriptCall);
 
@@ -24,6 +26,7 @@ private:
 	void UpdateSweep();
 
 	void FireInternal(float3 curDir);
+	void FireBeam(float3 curDir, float maxLength, const TraceRay::SRayCandidates* candidates);
 	void FireImpl(const bool scriptCall) override final;
 
 private:
@@ -0,0 +1,71 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#include "HitscanQueue.h"
+#include "Weapon.h"
+#include "Sim/Misc/ModInfo.h"
+#include "Sim/Misc/QuadField.h"
+#include "System/Threading/ThreadPool.h"
+#include "System/TimeProfiler.h"
+
+#include "System/Misc/TracyDefs.h"
+
+std::vector<CHitscanQueue::Shot> CHitscanQueue::shots;
+size_t CHitscanQueue::numShots = 0;
+
+bool CHitscanQueue::active = false;
+
+
+void CHitscanQueue::Begin()
+{
+	assert(numShots == 0);
+	active = modInfo.hitscanBatching;
+}
+
+void CHitscanQueue::AddShot(CWeapon* weapon, const float3& pos, const float3& dir, float length, int traceFlags)
+{
+	assert(active);
+
+	if (numShots == shots.size())
+		shots.emplace_back();
+
+	Shot& shot = shots[numShots++];
+
+	shot.weapon = weapon;
+	shot.pos = pos;
+	shot.dir = dir;
+	shot.length = length;
+	shot.traceFlags = traceFlags;
+}
+
+void CHitscanQueue::Flush()
+{
+	RECOIL_DETAILED_TRACY_ZONE;
+	// anything fired while completing the shots (e.g. from Lua) is traced directly
+	active = false;
+
+	if (numShots == 0)
+		return;
+
+	{
+		SCOPED_TIMER("Sim::Unit::Weapon::HitscanGather");
+
+		// nothing moves until the serial pass below
+		for_mt(0, numShots, [](const int i) {
+			Shot& shot = shots[i];
+			TraceRay::GatherRayCandidates(shot.pos, shot.dir, shot.length, shot.traceFlags, shot.weapon->owner, shot.candidates, ThreadPool::GetThreadNum());
+		});
+	}
+
+	// completed shots can kill, create or move objects; once any of them
+	// entered or left a quad, the remaining shots trace from scratch
+	const unsigned int numQuadChanges = quadField.GetNumQuadChanges();
+
+	for (size_t i = 0; i < numShots; i++) {
+		const Shot& shot = shots[i];
+		const bool validCandidates = (quadField.GetNumQuadChanges() == numQuadChanges);
+
+		shot.weapon->FireQueuedHitscan(shot.dir, shot.length, validCandidates? &shot.candidates: nullptr);
+	}
+
+	numShots = 0;
+}
@@ -0,0 +1,50 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#ifndef _HITSCAN_QUEUE_H_
+#define _HITSCAN_QUEUE_H_
+
+#include "Game/TraceRay.h"
+#include "System/float3.h"
+
+#include <vector>
+
+class CWeapon;
+
+/**
+ * Defers the traces of hit-scan weapons (modInfo.hitscanBatching) fired
+ * during the weapon update. The weapons pick their direction when firing
+ * and queue the shot; Flush gathers the candidate objects of all queued
+ * rays in parallel and then lets the weapons complete their shots (hits,
+ * shields, damage) serially in the order they fired.
+ */
+class CHitscanQueue
+{
+public:
+	/// shots are only queued between Begin and Flush, never part of a savegame
+	static void Begin();
+	static void Flush();
+
+	static bool IsActive() { return active; }
+
+	static void AddShot(CWeapon* weapon, const float3& pos, const float3& dir, float length, int traceFlags);
+
+private:
+	struct Shot {
+		CWeapon* weapon;
+
+		float3 pos;
+		float3 dir;
+		float length;
+		int traceFlags;
+
+		TraceRay::SRayCandidates candidates;
+	};
+
+	// kept (with the candidate vectors' capacity) between frames
+	static std::vector<Shot> shots;
+	static size_t numShots;
+
+	static bool active;
+};
+
+#endif // _HITSCAN_QUEUE_H_
@@ -1,6 +1,7 @@
 /* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
 
 #include "LightningCannon.h"
+#include "HitscanQueue.h"
 #include "PlasmaRepulser.h"
 #include "WeaponDef.h"
 #include "Game/GameHelper.h"
@@ -31,17 +32,35 @@ CLightningCannon::CLightningCannon(CUnit* owner, const WeaponDef* def): CWeapon(
 void CLightningCannon::FireImpl(const bool scriptCall)
 {
 	RECOIL_DETAILED_TRACY_ZONE;
-	float3 curPos = weaponMuzzlePos;
 	float3 curDir = (currentTargetPos - weaponMuzzlePos).SafeNormalize();
 
 	curDir += (gsRNG.NextVector() * SprayAngleExperience() + SalvoErrorExperience());
 	curDir.Normalize();
 
+	if (CHitscanQueue::IsActive()) {
+		CHitscanQueue::AddShot(this, weaponMuzzlePos, curDir, range, collisionFlags);
+		return;
+	}
+
+	FireQueuedHitscan(curDir, range, nullptr);
+}
+
+void CLightningCannon::FireQueuedHitscan(const float3& curDir, float boltRange, const TraceRay::SRayCandidates* candidates)
+{
+	RECOIL_DETAILED_TRACY_ZONE;
+	const float3 curPos = weaponMuzzlePos;
+
 	CUnit* hitUnit = nullptr;
 	CFeature* hitFeature = nullptr;
 	CollisionQuery hitColQuery;
 
-	float boltLength = TraceRay::TraceRay(curPos, curDir, range, collisionFlags, owner, hitUnit, hitFeature, &hitColQuery);
+	float boltLength = 0.0f;
+
+	if (candidates != nullptr) {
+		boltLength = TraceRay::TraceRayCandidates(curPos, curDir, boltRange, collisionFlags, owner, *candidates, hitUnit, hitFeature, &hitColQuery);
+	} else {
+		boltLength = TraceRay::TraceRay(curPos, curDir, boltRange, collisionFlags, owner, hitUnit, hitFeature, &hitColQuery);
+	}
 
 	if (!weaponDef->waterweapon) {
 		// terminate bolt at water surface if necessary
@@ -54,7 +73,7 @@ void CLightningCannon::FireImpl(const bool scriptCall)
 
 	static std::vector<TraceRay::SShieldDist> hitShields;
 	hitShields.clear();
-	TraceRay::TraceRayShields(this, curPos, curDir, range, hitShields);
+	TraceRay::TraceRayShields(this, curPos, curDir, boltRange, hitShields);
 	for (const TraceRay::SShieldDist& sd: hitShields) {
 		if (sd.dist < boltLength && sd.rep->IncomingBeam(this, curPos, curPos + (curDir * sd.dist), 1.0f)) {
 			boltLength = sd.dist;
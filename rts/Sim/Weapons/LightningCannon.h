@@ -11,6 +11,8 @@ class CLightningCannon: public CWeapon
 public:
 	CLightningCannon(CUnit* owner = nullptr, const WeaponDef* def = nullptr);
 
+	void FireQueuedHitscan(const float3& curDir, float boltRange, const TraceRay::SRayCandidates* candidates) override final;
+
 private:
 	void FireImpl(const bool scriptCall) override final;
 	float GetPredictedImpactTime(float3 p) const override final { return 0.0f; }
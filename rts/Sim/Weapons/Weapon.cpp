@@ -105,6 +105,7 @@ CR_REG_METADATA(CWeapon, (
 
 	CR_MEMBER(currentTarget),
 	CR_MEMBER(currentTargetPos),
+	CR_IGNORED(lineOfFireCache),
 
 	CR_MEMBER(incomingProjectileIDs),
 
@@ -721,11 +722,17 @@ bool CWeapon::AutoTarget()
 
 	auto& targetPairs = helper->targetPairs;
 
+	// candidates might already have been gathered in parallel during this SlowUpdate
+	const auto* prefetched = helper->GetPrefetchedWeaponTargets(this, avoidUnit);
+	const size_t numTargets = (prefetched != nullptr)?
+		CGameHelper::CommitWeaponTargets(this, *prefetched, targetPairs):
+		CGameHelper::GenerateWeaponTargets(this, avoidUnit, targetPairs);
+
 	// NOTE:
 	//   GenerateWeaponTargets sorts by INCREASING order of priority, so lower equals better
 	//   <targetPairs> is normally sorted such that all bad TargetCategory units live at the
 	//   end, but Lua can mess with the ordering arbitrarily
-	for (size_t i = 0, n = CGameHelper::GenerateWeaponTargets(this, avoidUnit, targetPairs); i < n; i++, assert(n == targetPairs.size())) {
+	for (size_t i = 0, n = numTargets; i < n; i++, assert(n == targetPairs.size())) {
 		CUnit* unit = targetPairs[i].second;
 
 		// save the "best" bad target in case we have no other
@@ -953,7 +960,49 @@ bool CWeapon::TryTarget(const float3 tgtPos, const SWeaponTarget& trg, bool preF
 		return false;
 
 	// TODO: add a forcedUserTarget (forced-fire mode enabled with CTRL e.g.) and skip the tests below
-	return (HaveFreeLineOfFire(GetAimFromPos(preFire), tgtPos, trg));
+	return (HaveCachedFreeLineOfFire(GetAimFromPos(preFire), tgtPos, trg));
+}
+
+bool CWeapon::HaveCachedFreeLineOfFire(const float3 srcPos, const float3 tgtPos, const SWeaponTarget& trg) const
+{
+	RECOIL_DETAILED_TRACY_ZONE;
+	const int cacheFrames = modInfo.weaponLineOfFireCacheFrames;
+
+	if (cacheFrames <= 0)
+		return (HaveFreeLineOfFire(srcPos, tgtPos, trg));
+
+	LineOfFireCache& cache = lineOfFireCache;
+
+	const float spread = AccuracyExperience() + SprayAngleExperience();
+
+	// reuse the last result while the ray and target are unchanged, no unit or feature
+	// entered or left (and no terrain changed in) the quads around the ray since then,
+	// and it is not older than <cacheFrames>; objects moving inside a quad are missed
+	if (cache.frameNum >= 0 && (gs->frameNum - cache.frameNum) < cacheFrames) {
+		bool sameInputs = true;
+
+		sameInputs &= (cache.srcPos == srcPos && cache.tgtPos == tgtPos);
+		sameInputs &= (cache.target == trg);
+		sameInputs &= (cache.spread == spread && cache.avoidFlags == avoidFlags);
+
+		if (sameInputs && !quadField.QuadsChangedSince(cache.areaMins, cache.areaMaxs, cache.frameNum))
+			return cache.result;
+	}
+
+	// the cone tests widen by <spread> per elmo, ballistic trajectories stay within it in XZ
+	const float3 areaPad = OnesVector * (srcPos.distance(tgtPos) * spread + SQUARE_SIZE);
+
+	cache.target = trg;
+	cache.srcPos = srcPos;
+	cache.tgtPos = tgtPos;
+	cache.areaMins = float3::min(srcPos, tgtPos) - areaPad;
+	cache.areaMaxs = float3::max(srcPos, tgtPos) + areaPad;
+	cache.spread = spread;
+	cache.avoidFlags = avoidFlags;
+	cache.frameNum = gs->frameNum;
+	cache.result = HaveFreeLineOfFire(srcPos, tgtPos, trg);
+
+	return cache.result;
 }
 
 
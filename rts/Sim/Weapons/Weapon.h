@@ -16,6 +16,10 @@ class CUnit;
 class CWeaponProjectile;
 struct WeaponDef;
 
+namespace TraceRay {
+	struct SRayCandidates;
+}
+
 
 class CWeapon : public CObject
 {
@@ -85,6 +89,8 @@ public:
 	bool AutoTarget();
 	void AimReady(const int value);
 	void Fire(const bool scriptCall);
+	/// completes a shot queued in CHitscanQueue, <candidates> is null if they can be stale
+	virtual void FireQueuedHitscan(const float3& dir, float length, const TraceRay::SRayCandidates* candidates) {}
 
 	float ExperienceErrorScale() const;
 	float MoveErrorExperience() const;
@@ -126,6 +132,7 @@ private:
 	void HoldIfTargetInvalid();
 
 	bool TryTarget(const float3 tgtPos, const SWeaponTarget& trg, bool preFire = false) const;
+	bool HaveCachedFreeLineOfFire(const float3 srcPos, const float3 tgtPos, const SWeaponTarget& trg) const;
 
 public:
 	CUnit* owner;
@@ -214,6 +221,25 @@ protected:
 	// projectiles that are on the way to our interception zone
 	// (eg. nuke toward a repulsor, or missile toward a shield)
 	std::vector<int> incomingProjectileIDs;
+
+private:
+	// inputs and result of the last line-of-fire test made by TryTarget
+	struct LineOfFireCache {
+		SWeaponTarget target;
+
+		float3 srcPos;
+		float3 tgtPos;
+		float3 areaMins;
+		float3 areaMaxs;
+
+		float spread = 0.0f;
+		unsigned int avoidFlags = 0;
+
+		int frameNum = -1;
+		bool result = false;
+	};
+
+	mutable LineOfFireCache lineOfFireCache;
 };
 
 #endif /* WEAPON_H */
@@ -12,6 +12,7 @@
 
 #include <cstdio>
 #include <cstring>
+#include <sstream>
 
 #include <stdexcept>
 
@@ -57,10 +58,33 @@ protected:
 	void AddObserver(ConfigNotifyCallback callback, void* observer, const std::vector<std::string>& configs) override;
 	void RemoveObserver(void* observer) override;
 
+	ParsedValue GetParsedValue(const std::string& key, bool required) const override;
+
 private:
+	struct CachedValue {
+		ParsedValue parsed;
+		std::string value;
+	};
+
 	void RemoveDefaults();
 	void RemoveDeprecated();
 
+	CachedValue ResolveValue(const std::string& key) const;
+
+	template<typename F>
+	auto ReadCachedValue(const std::string& key, F&& read) const {
+		std::lock_guard<spring::mutex> lck(cacheMutex);
+
+		auto it = cachedValues.find(key);
+
+		if (it == cachedValues.end())
+			it = cachedValues.emplace(key, ResolveValue(key)).first;
+
+		return read(it->second);
+	}
+
+	void ClearCachedValues();
+
 	OverlayConfigSource* overlay;
 	FileConfigSource* writableSource;
 	std::vector<ReadOnlyConfigSource*> sources;
@@ -71,10 +95,23 @@ private:
 	spring::mutex observerMutex;
 	StringMap changedValues;
 	bool writingEnabled;
+
+	// values resolved through all sources, dropped whenever any source changes
+	mutable spring::unsynced_map<std::string, CachedValue> cachedValues;
+	mutable spring::mutex cacheMutex;
 };
 
 /******************************************************************************/
 
+template<typename T>
+static T ParseValue(const std::string& value)
+{
+	std::istringstream buf(value);
+	T temp;
+	buf >> temp;
+	return temp;
+}
+
 
 /**
  * @brief Fills the list of sources based on locations.
@@ -140,6 +177,7 @@ void ConfigHandlerImpl::FinalizeLoad()
 		RemoveDefaults();
 
 	RemoveDeprecated();
+	ClearCachedValues();
 }
 
 /**
@@ -243,15 +281,13 @@ void ConfigHandlerImpl::Delete(const std::string& key)
 
 		rwcs->Delete(key);
 	}
+
+	ClearCachedValues();
 }
 
 bool ConfigHandlerImpl::IsSet(const std::string& key) const
 {
-	for (const ReadOnlyConfigSource* s: sources) {
-		if (s->IsSet(key)) return true;
-	}
-
-	return false;
+	return (ReadCachedValue(key, [](const CachedValue& cv) { return cv.parsed.isSet; }));
 }
 
 bool ConfigHandlerImpl::IsReadOnly(const std::string& key) const
@@ -274,21 +310,60 @@ bool ConfigHandlerImpl::IsDeprecated(const std::string& key) const
 	return meta->GetDeprecated().Get();
 }
 
-std::string ConfigHandlerImpl::GetString(const std::string& key) const
+ConfigHandlerImpl::CachedValue ConfigHandlerImpl::ResolveValue(const std::string& key) const
 {
 	const ConfigVariableMetaData* meta = ConfigVariable::GetMetaData(key);
 
+	CachedValue cv;
+
 	for (const ReadOnlyConfigSource* s: sources) {
-		if (s->IsSet(key)) {
-			std::string value = s->GetString(key);
+		if (!s->IsSet(key))
+			continue;
 
-			if (meta != nullptr)
-				value = meta->Clamp(value);
+		cv.value = s->GetString(key);
 
-			return value;
-		}
+		if (meta != nullptr)
+			cv.value = meta->Clamp(cv.value);
+
+		cv.parsed.isSet = true;
+		cv.parsed.boolValue = StringToBool(cv.value);
+		cv.parsed.intValue = ParseValue<int>(cv.value);
+		cv.parsed.unsignedValue = ParseValue<unsigned int>(cv.value);
+		cv.parsed.floatValue = ParseValue<float>(cv.value);
+		break;
 	}
 
+	return cv;
+}
+
+void ConfigHandlerImpl::ClearCachedValues()
+{
+	std::lock_guard<spring::mutex> lck(cacheMutex);
+	cachedValues.clear();
+}
+
+ConfigHandler::ParsedValue ConfigHandlerImpl::GetParsedValue(const std::string& key, bool required) const
+{
+	const ParsedValue parsed = ReadCachedValue(key, [](const CachedValue& cv) { return cv.parsed; });
+
+	if (required && !parsed.isSet)
+		GetString(key);
+
+	return parsed;
+}
+
+std::string ConfigHandlerImpl::GetString(const std::string& key) const
+{
+	std::string value;
+
+	const bool isSet = ReadCachedValue(key, [&value](const CachedValue& cv) {
+		value = cv.value;
+		return cv.parsed.isSet;
+	});
+
+	if (isSet)
+		return value;
+
 	throw std::runtime_error("ConfigHandler: Error: Key does not exist: " + key +
 			"\nPlease add the key to the list of allowed configuration values.");
 }
@@ -315,6 +390,8 @@ void ConfigHandlerImpl::SetString(const std::string& key, const std::string& val
 	if (!useOverlay)
 		overlay->Delete(key);
 
+	ClearCachedValues();
+
 	// Don't do anything if value didn't change.
 	if (IsSet(key) && GetString(key) == value)
 		return;
@@ -349,6 +426,8 @@ void ConfigHandlerImpl::SetString(const std::string& key, const std::string& val
 		}
 	}
 
+	ClearCachedValues();
+
 	std::lock_guard<spring::mutex> lck(observerMutex);
 
 	if (notify)
@@ -444,10 +523,4 @@ void ConfigHandler::Deallocate()
 	spring::SafeDelete(configHandler);
 }
 
-bool ConfigHandler::Get(const std::string& key) const
-{
-	return StringToBool(GetString(key));
-}
-
-
 /******************************************************************************/
\ No newline at end of file
@@ -70,17 +70,17 @@ public:
 	}
 
 	/// @brief Get bool, throw if key not present
-	bool GetBool(const std::string& key) const { return (Get<bool>(key)); }
+	bool GetBool(const std::string& key) const { return (GetParsedValue(key, true).boolValue); }
 	/// @brief Get int, throw if key not present
-	int GetInt(const std::string& key) const { return (Get<int>(key)); }
+	int GetInt(const std::string& key) const { return (GetParsedValue(key, true).intValue); }
 	/// @brief Get int, throw if key not present
-	int GetUnsigned(const std::string& key) const { return (Get<unsigned>(key)); }
+	int GetUnsigned(const std::string& key) const { return (GetParsedValue(key, true).unsignedValue); }
 	/// @brief Get float, throw if key not present
-	float GetFloat(const std::string& key) const { return (Get<float>(key)); }
+	float GetFloat(const std::string& key) const { return (GetParsedValue(key, true).floatValue); }
 
-	bool GetBoolSafe(const std::string& key, bool def) const { return (IsSet(key)? GetBool(key): def); }
-	int GetIntSafe(const std::string& key, int def) const { return (IsSet(key)? GetInt(key): def); }
-	float GetFloatSafe(const std::string& key, float def) const { return (IsSet(key)? GetFloat(key): def); }
+	bool GetBoolSafe(const std::string& key, bool def) const { const ParsedValue v = GetParsedValue(key, false); return (v.isSet? v.boolValue: def); }
+	int GetIntSafe(const std::string& key, int def) const { const ParsedValue v = GetParsedValue(key, false); return (v.isSet? v.intValue: def); }
+	float GetFloatSafe(const std::string& key, float def) const { const ParsedValue v = GetParsedValue(key, false); return (v.isSet? v.floatValue: def); }
 	std::string GetStringSafe(const std::string& key, const std::string& def) const { return (IsSet(key)? GetString(key): def); }
 
 public:
@@ -163,23 +163,20 @@ public:
 protected:
 	typedef std::function<void(const std::string&, const std::string&)> ConfigNotifyCallback;
 
+	/// value of a key in all supported types, parsed once after each change
+	struct ParsedValue {
+		bool isSet = false;
+		bool boolValue = false;
+		int intValue = 0;
+		unsigned int unsignedValue = 0;
+		float floatValue = 0.0f;
+	};
+
 	virtual void AddObserver(ConfigNotifyCallback callback, void* observer, const std::vector<std::string>& configs) = 0;
 	virtual void RemoveObserver(void* observer) = 0;
 
-private:
-	/// @see GetString
-	template<typename T>
-	T Get(const std::string& key) const
-	{
-		std::istringstream buf(GetString(key));
-		T temp;
-		buf >> temp;
-		return temp;
-	}
-
-	/// @see Get
-	/// @brief <bool> specialization of Get<> (we cannot use template spezialization here, so just overload it)
-	bool Get(const std::string& key) const;
+	/// @param required if true, throws like GetString when the key is not present
+	virtual ParsedValue GetParsedValue(const std::string& key, bool required) const = 0;
 };
 
 extern ConfigHandler* configHandler;
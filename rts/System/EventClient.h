@@ -72,7 +72,9 @@ class CEventClient
 		// used by the eventHandler to route certain event types
 		virtual int  GetReadAllyTeam() const { return NoAccessTeam; }
 		virtual bool GetFullRead()     const { return GetReadAllyTeam() == AllAccessTeam; }
-		inline bool CanReadAllyTeam(int allyTeam) {
+		// tested per client for every routed event; clients that can answer
+		// without the two calls above (full readers, Lua) override it
+		virtual bool CanReadAllyTeam(int allyTeam) const {
 			return (GetFullRead() || (GetReadAllyTeam() == allyTeam));
 		}
 
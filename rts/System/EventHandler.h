@@ -584,10 +584,8 @@ inline void CEventHandler::UnitLoaded(const CUnit* unit,
 
 	for (size_t i = 0; i < count; i++) {
 		CEventClient* ec = listUnitLoaded[i];
-		const int ecAllyTeam = ec->GetReadAllyTeam();
-		if (ec->GetFullRead() ||
-		    (ecAllyTeam == unit->allyteam) ||
-		    (ecAllyTeam == transport->allyteam)) {
+
+		if (ec->CanReadAllyTeam(unit->allyteam) || ec->CanReadAllyTeam(transport->allyteam)) {
 			ec->UnitLoaded(unit, transport);
 		}
 	}
@@ -601,10 +599,8 @@ inline void CEventHandler::UnitUnloaded(const CUnit* unit,
 
 	for (size_t i = 0; i < count; i++) {
 		CEventClient* ec = listUnitUnloaded[i];
-		const int ecAllyTeam = ec->GetReadAllyTeam();
-		if (ec->GetFullRead() ||
-		    (ecAllyTeam == unit->allyteam) ||
-		    (ecAllyTeam == transport->allyteam)) {
+
+		if (ec->CanReadAllyTeam(unit->allyteam) || ec->CanReadAllyTeam(transport->allyteam)) {
 			ec->UnitUnloaded(unit, transport);
 		}
 	}
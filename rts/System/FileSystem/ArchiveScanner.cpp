@@ -27,6 +27,7 @@
 #include "System/StringUtil.h"
 #include "System/Exceptions.h"
 #include "System/Threading/ThreadPool.h"
+#include "System/Platform/Threading.h"
 #include "System/FileSystem/RapidHandler.h"
 #include "System/FileSystem/Archives/PoolArchive.h"
 #include "System/Log/ILog.h"
@@ -472,8 +473,6 @@ void CArchiveScanner::ScanDirs(const std::vector<std::string>& scanDirs)
 	std::lock_guard<decltype(scannerMutex)> lck(scannerMutex);
 	std::deque<std::string> foundArchives;
 
-	isDirty = true;
-
 	// scan for all archives
 	for (const std::string& dir: scanDirs) {
 		if (!FileSystem::DirExists(dir))
@@ -499,12 +498,32 @@ void CArchiveScanner::ScanDirs(const std::vector<std::string>& scanDirs)
 		}
 	}*/
 
-	// Create archiveInfos etc. if not in cache already
+	// Create archiveInfos etc. if not in cache already; the cache lookups are
+	// cheap but modify the index so they run serially, while opening the new
+	// or changed archives and executing their {map,mod}info.lua is spread out
+	std::vector<ArchiveScanResult> scanResults;
+
 	for (const std::string& archive: foundArchives) {
-		ScanArchive(archive, false);
-	#if !defined(DEDICATED) && !defined(UNITSYNC)
-		Watchdog::ClearTimer();
-	#endif
+		uint32_t modifiedTime = 0;
+
+		if (CheckCachedData(archive, modifiedTime, false))
+			continue;
+
+		scanResults.emplace_back();
+		scanResults.back().fullName = archive;
+		scanResults.back().modified = modifiedTime;
+	}
+
+	AnalyzeArchives(scanResults);
+
+	for (ArchiveScanResult& result: scanResults) {
+		uint32_t modifiedTime = 0;
+
+		// same name as an archive stored by an earlier result, which takes precedence
+		if (CheckCachedData(result.fullName, modifiedTime, false))
+			continue;
+
+		StoreScanResult(result, false);
 	}
 
 	// Now we'll have to parse the replaces-stuff found in the mods
@@ -515,8 +534,12 @@ void CArchiveScanner::ScanDirs(const std::vector<std::string>& scanDirs)
 			const std::string& lcReplaceName = StringToLower(replaceName);
 
 			// Overwrite the info for this archive with a replaced pointer
+			isDirty |= (archiveInfosIndex.find(lcReplaceName) == archiveInfosIndex.end());
+
 			ArchiveInfo& ai = GetAddArchiveInfo(lcReplaceName);
 
+			isDirty |= (ai.replaced != lcOriginalName || !ai.path.empty());
+
 			ai.path = "";
 			ai.origName = replaceName;
 			ai.modified = 1;
@@ -525,6 +548,12 @@ void CArchiveScanner::ScanDirs(const std::vector<std::string>& scanDirs)
 			ai.replaced = lcOriginalName;
 		}
 	}
+
+	// archives that disappeared since the cache was written will be dropped from it;
+	// new or changed ones already flagged isDirty in ScanArchive. This keeps every
+	// (e.g. dedicated server) process start from rewriting an unchanged cache.
+	isDirty |= std::any_of(archiveInfos.begin(), archiveInfos.end(), [](const ArchiveInfo& ai) { return (!ai.updated); });
+	isDirty |= std::any_of(brokenArchives.begin(), brokenArchives.end(), [](const BrokenArchive& ba) { return (!ba.updated); });
 }
 
 
@@ -699,7 +728,6 @@ void CArchiveScanner::ScanArchive(const std::string& fullName, bool doChecksum)
 	if (CheckCachedData(fullName, modifiedTime, doChecksum))
 		return;
 
-	isDirty = true;
 	isInScan = true;
 
 	struct ScanScope {
@@ -711,6 +739,57 @@ void CArchiveScanner::ScanArchive(const std::string& fullName, bool doChecksum)
 
 	const ScanScope scanScope(&isInScan);
 
+	ArchiveScanResult result;
+	result.fullName = fullName;
+	result.modified = modifiedTime;
+
+	AnalyzeArchive(result);
+	StoreScanResult(result, doChecksum);
+}
+
+
+void CArchiveScanner::AnalyzeArchives(std::vector<ArchiveScanResult>& scanResults)
+{
+	if (scanResults.empty())
+		return;
+
+	std::atomic<size_t> nextResult = {0};
+
+	// archives are independent of each other and every worker opens its own
+	// IArchive instances, so this only needs a shared cursor into the results
+	const auto AnalyzeLoop = [&](bool isMainThread) {
+		for (size_t i = nextResult.fetch_add(1); i < scanResults.size(); i = nextResult.fetch_add(1)) {
+			AnalyzeArchive(scanResults[i]);
+
+		#if !defined(DEDICATED) && !defined(UNITSYNC)
+			if (isMainThread)
+				Watchdog::ClearTimer();
+		#endif
+		}
+	};
+
+	const size_t numWorkers = std::min(scanResults.size(), static_cast<size_t>(std::max(Threading::GetLogicalCpuCores(), 1)));
+
+	std::vector<spring::thread> workers;
+	workers.reserve(numWorkers - 1);
+
+	for (size_t n = 1; n < numWorkers; n++) {
+		workers.emplace_back([&]() {
+			Threading::SetThreadName("archivescan");
+			AnalyzeLoop(false);
+		});
+	}
+
+	AnalyzeLoop(true);
+
+	for (spring::thread& worker: workers) {
+		worker.join();
+	}
+}
+
+void CArchiveScanner::AnalyzeArchive(ArchiveScanResult& result)
+{
+	const std::string& fullName = result.fullName;
 	const std::string& fname = FileSystem::GetFilename(fullName);
 	const std::string& fpath = FileSystem::GetDirectory(fullName);
 	const std::string& lcfn  = StringToLower(fname);
@@ -721,15 +800,16 @@ void CArchiveScanner::ScanArchive(const std::string& fullName, bool doChecksum)
 		LOG_L(L_WARNING, "[AS::%s] unable to open archive \"%s\"", __func__, fullName.c_str());
 
 		// record it as broken, so we don't need to look inside everytime
-		BrokenArchive& ba = GetAddBrokenArchive(lcfn);
+		BrokenArchive& ba = result.brokenArchive;
 		ba.name = lcfn;
 		ba.path = fpath;
-		ba.modified = modifiedTime;
+		ba.modified = result.modified;
 		ba.updated = true;
 		ba.problem = "Unable to open archive";
 
 		// does not count as a scan
-		// numScannedArchives += 1;
+		result.broken = true;
+		result.counted = false;
 		return;
 	}
 
@@ -742,7 +822,7 @@ void CArchiveScanner::ScanArchive(const std::string& fullName, bool doChecksum)
 	const bool hasMapInfo = ar->FileExists("mapinfo.lua");
 
 
-	ArchiveInfo ai;
+	ArchiveInfo& ai = result.archiveInfo;
 	ArchiveData& ad = ai.archiveData;
 
 	// execute the respective .lua, otherwise assume this archive is a map
@@ -765,15 +845,16 @@ void CArchiveScanner::ScanArchive(const std::string& fullName, bool doChecksum)
 		LOG_L(L_WARNING, "[AS::%s] failed to scan \"%s\" (%s)", __func__, fullName.c_str(), error.c_str());
 
 		// mark archive as broken, so we don't need to look inside everytime
-		BrokenArchive& ba = GetAddBrokenArchive(lcfn);
+		BrokenArchive& ba = result.brokenArchive;
 		ba.name = lcfn;
 		ba.path = fpath;
-		ba.modified = modifiedTime;
+		ba.modified = result.modified;
 		ba.updated = true;
 		ba.problem = error;
 
 		// does count as a scan
-		numScannedArchives += 1;
+		result.broken = true;
+		result.counted = true;
 		return;
 	}
 
@@ -805,7 +886,7 @@ void CArchiveScanner::ScanArchive(const std::string& fullName, bool doChecksum)
 	}
 
 	ai.path = fpath;
-	ai.modified = modifiedTime;
+	ai.modified = result.modified;
 
 	// Store modinfo.lua/mapinfo.lua modified timestamp for directory archives, as only they can change.
 	if (ar->GetType() == ARCHIVE_TYPE_SDD && !luaInfoFile.empty()) {
@@ -815,12 +896,27 @@ void CArchiveScanner::ScanArchive(const std::string& fullName, bool doChecksum)
 
 	ai.origName = fname;
 	ai.updated = true;
-	ai.hashed = doChecksum && GetArchiveChecksum(fullName, ai);
 
-	archiveInfosIndex.emplace(lcfn, archiveInfos.size());
-	archiveInfos.emplace_back(std::move(ai));
+	result.broken = false;
+	result.counted = true;
+}
+
+void CArchiveScanner::StoreScanResult(ArchiveScanResult& result, bool doChecksum)
+{
+	isDirty = true;
+	numScannedArchives += result.counted;
+
+	if (result.broken) {
+		BrokenArchive& ba = GetAddBrokenArchive(result.brokenArchive.name);
+		ba = std::move(result.brokenArchive);
+		return;
+	}
+
+	ArchiveInfo& ai = result.archiveInfo;
+	ai.hashed = doChecksum && GetArchiveChecksum(result.fullName, ai);
 
-	numScannedArchives += 1;
+	archiveInfosIndex.emplace(StringToLower(ai.origName), archiveInfos.size());
+	archiveInfos.emplace_back(std::move(ai));
 }
 
 
@@ -1022,10 +1118,16 @@ bool CArchiveScanner::GetArchiveChecksum(const std::string& archiveName, Archive
 		if (it == archiveInfo.filesInfo.end())
 			it = archiveInfo.filesInfo.emplace(fi.fileName, {}).first;
 
-		if (fi.modTime != it->second.modTime || fi.size != it->second.size) {
+		// pool files are named after the md5 of their content, so a known pool file only
+		// gets a new modTime if it was copied or downloaded again and need not be rehashed
+		const bool knownPoolFile = sdpArchive && fi.size == it->second.size && it->second.checksum != sha512::NULL_RAW_DIGEST;
+
+		if (fi.size != it->second.size || (fi.modTime != it->second.modTime && !knownPoolFile)) {
 			it->second.modTime = fi.modTime;
 			it->second.size = fi.size;
 			it->second.checksum = sha512::NULL_RAW_DIGEST;
+		} else {
+			it->second.modTime = fi.modTime;
 		}
 
 		fileNames.emplace_back(std::move(fi.fileName));
@@ -195,6 +195,17 @@ private:
 		uint32_t modified = 0;
 		bool updated = false;
 	};
+	struct ArchiveScanResult {
+		std::string fullName;
+
+		ArchiveInfo archiveInfo;
+		BrokenArchive brokenArchive;
+
+		uint32_t modified = 0;
+
+		bool broken = false;
+		bool counted = false; // whether this counts towards numScannedArchives
+	};
 
 private:
 	void ReadCache();
@@ -205,6 +216,16 @@ private:
 	void ScanDirs(const std::vector<std::string>& dirs);
 	void ScanDir(const std::string& curPath, std::deque<std::string>& foundArchives);
 
+	/// runs AnalyzeArchive over all results on a pool of worker threads
+	void AnalyzeArchives(std::vector<ArchiveScanResult>& scanResults);
+	/**
+	 * Opens the archive named by result.fullName and extracts its info.
+	 * Does not touch any scanner state, so multiple archives can be
+	 * analyzed concurrently; StoreScanResult adds the outcome afterwards.
+	 */
+	void AnalyzeArchive(ArchiveScanResult& result);
+	void StoreScanResult(ArchiveScanResult& result, bool doChecksum);
+
 	/// scan mapinfo / modinfo lua files
 	bool ScanArchiveLua(IArchive* ar, const std::string& fileName, ArchiveInfo& ai, std::string& err);
 
@@ -4,6 +4,7 @@
 #include "System/GlobalConfig.h"
 #include "System/MainDefines.h"
 #include "System/Log/ILog.h"
+#include "System/Threading/ThreadPool.h"
 
 #include <cassert>
 
@@ -62,6 +63,21 @@ bool CBufferedArchive::GetFile(uint32_t fid, std::vector<std::uint8_t>& buffer)
 		return true;
 	}
 
+	if (!fileData.empty()) {
+		prefetchedBytes -= fileData.size();
+
+		// prefetched; keep it around only if it would have been cached by now
+		if (numAccessed == 2) {
+			buffer.assign(fileData.begin(), fileData.end());
+			gotBuffered = true;
+		} else {
+			buffer = std::move(fileData);
+			fileData = {};
+		}
+
+		return true;
+	}
+
 	if ((ret = GetFileImpl(fid, buffer)) != 1)
 		LOG_L(L_ERROR, "[BufferedArchive::%s(fid=%u)][noCache=%d,vfsCache=%d] name=%s ret=%d size=" _STPF_, __func__, fid, static_cast<int>(noCache), static_cast<int>(globalConfig.vfsCacheArchiveFiles), archiveFile.c_str(), ret, buffer.size());
 
@@ -72,3 +88,61 @@ bool CBufferedArchive::GetFile(uint32_t fid, std::vector<std::uint8_t>& buffer)
 	
 	return (ret == 1);
 }
+
+void CBufferedArchive::PrefetchFiles(const std::vector<uint32_t>& fids)
+{
+	if (!globalConfig.vfsCacheArchiveFiles || noCache)
+		return;
+
+	// nothing to gain if files can not be read concurrently, and solid
+	// archives would have to unpack everything in front of each file
+	if (parallelAccessNum <= 1 || CheckForSolid())
+		return;
+
+	{
+		std::scoped_lock lck(mutex);
+		if (fileCache.empty())
+			fileCache.resize(NumFiles());
+	}
+
+	std::vector<uint32_t> pendingFids;
+	pendingFids.reserve(fids.size());
+
+	size_t pendingBytes = prefetchedBytes;
+
+	for (const uint32_t fid: fids) {
+		assert(IsFileId(fid));
+
+		const auto& [numAccessed, gotBuffered, fileData] = fileCache[fid];
+
+		if (gotBuffered || !fileData.empty())
+			continue;
+
+		const int32_t fileSize = FileSize(fid);
+
+		// skip files that do not fit, smaller ones further down the list still might
+		if (fileSize <= 0 || (pendingBytes + fileSize) > MAX_PREFETCHED_BYTES)
+			continue;
+
+		pendingBytes += fileSize;
+		pendingFids.push_back(fid);
+	}
+
+	if (pendingFids.empty())
+		return;
+
+	// each fid is touched by one thread only, and callers do not read them until we return
+	for_mt(0, pendingFids.size(), [&](const int i) {
+		auto scopedSemAcq = AcquireSemaphoreScoped();
+		auto& fileData = std::get<2>(fileCache[pendingFids[i]]);
+
+		if (GetFileImpl(pendingFids[i], fileData) != 1)
+			fileData.clear();
+	});
+
+	for (const uint32_t fid: pendingFids) {
+		prefetchedBytes += std::get<2>(fileCache[fid]).size();
+	}
+
+	LOG_L(L_DEBUG, "[BufferedArchive::%s][name=%s] prefetched %u files (" _STPF_ " bytes pending)", __func__, archiveFile.c_str(), static_cast<uint32_t>(pendingFids.size()), prefetchedBytes.load());
+}
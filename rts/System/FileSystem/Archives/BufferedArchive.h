@@ -3,6 +3,7 @@
 #ifndef _BUFFERED_ARCHIVE_H
 #define _BUFFERED_ARCHIVE_H
 
+#include <atomic>
 #include <tuple>
 
 #include "IArchive.h"
@@ -24,14 +25,20 @@ public:
 	int GetType() const override { return ARCHIVE_TYPE_BUF; }
 
 	bool GetFile(uint32_t fid, std::vector<std::uint8_t>& buffer) override;
+	void PrefetchFiles(const std::vector<uint32_t>& fids) override;
 
 protected:
 	virtual int GetFileImpl(uint32_t fid, std::vector<std::uint8_t>& buffer) = 0;
 
-	// indexed by file-id
+	// indexed by file-id; entries that are not buffered but hold data were
+	// prefetched and get handed out (moved) by the next GetFile call
 	std::vector<std::tuple<uint32_t, bool, std::vector<uint8_t>>> fileCache = {};
 private:
+	// upper bound for prefetched data not yet handed out by GetFile
+	static constexpr size_t MAX_PREFETCHED_BYTES = 128 * 1024 * 1024;
+
 	spring::spinlock mutex;
+	std::atomic<size_t> prefetchedBytes = {0};
 	bool noCache = false;
 };
 
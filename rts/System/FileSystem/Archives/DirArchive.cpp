@@ -3,7 +3,7 @@
 #include "DirArchive.h"
 
 #include <assert.h>
-#include <fstream>
+#include <cstdio>
 
 #include "System/FileSystem/DataDirsAccess.h"
 #include "System/FileSystem/FileSystem.h"
@@ -57,20 +57,25 @@ bool CDirArchive::GetFile(uint32_t fid, std::vector<std::uint8_t>& buffer)
 
 	auto scopedSemAcq = AcquireSemaphoreScoped();
 
-	std::ifstream ifs(files[fid].rawFileName.c_str(), std::ios::in | std::ios::binary);
+	// plain stdio, the caller's buffer is filled by a single fread without stream overhead
+	FILE* file = fopen(files[fid].rawFileName.c_str(), "rb");
 
-	if (ifs.bad() || !ifs.is_open())
+	if (file == nullptr)
 		return false;
 
-	ifs.seekg(0, std::ios_base::end);
-	buffer.resize(ifs.tellg());
-	ifs.seekg(0, std::ios_base::beg);
-	ifs.clear();
+	bool success = (fseek(file, 0, SEEK_END) == 0);
+	const long fileSize = success? ftell(file): -1;
 
-	if (!buffer.empty())
-		ifs.read((char*)&buffer[0], buffer.size());
+	if ((success = (fileSize >= 0) && (fseek(file, 0, SEEK_SET) == 0))) {
+		buffer.resize(fileSize);
+		files[fid].size = fileSize;
 
-	return true;
+		if (!buffer.empty())
+			success = (fread(buffer.data(), buffer.size(), 1, file) == 1);
+	}
+
+	fclose(file);
+	return success;
 }
 
 const std::string& CDirArchive::FileName(uint32_t fid) const
@@ -3,6 +3,7 @@
 #ifndef _ARCHIVE_BASE_H
 #define _ARCHIVE_BASE_H
 
+#include <algorithm>
 #include <string>
 #include <vector>
 #include <cinttypes>
@@ -89,6 +90,25 @@ public:
 	 * @see GetFile(uint32_t fid, std::vector<std::uint8_t>& buffer)
 	 */
 	bool GetFile(const std::string& name, std::vector<std::uint8_t>& buffer);
+	/**
+	 * Hints that the given files are about to be read, such that archives
+	 * which have to uncompress them can do so ahead of time in parallel.
+	 * @param fids file IDs in [0, NumFiles())
+	 */
+	virtual void PrefetchFiles(const std::vector<uint32_t>& fids) {}
+
+	/**
+	 * Returns a key by which files sort into the order in which they are
+	 * cheapest to read, e.g. grouped by the solid block holding them.
+	 */
+	virtual uint64_t FileReadOrder(uint32_t fid) const { return fid; }
+	/**
+	 * Sorts file IDs by FileReadOrder, callers reading many files at once
+	 * should do so in this order.
+	 */
+	void SortByReadOrder(std::vector<uint32_t>& fids) const {
+		std::sort(fids.begin(), fids.end(), [this](uint32_t a, uint32_t b) { return (FileReadOrder(a) < FileReadOrder(b)); });
+	}
 
 	uint32_t ExtractedSize() const {
 		uint32_t size = 0;
@@ -11,6 +11,8 @@
 #include <7zCrc.h>
 
 #include "System/CRC.h"
+#include "System/GlobalConfig.h"
+#include "System/MainDefines.h"
 #include "System/StringUtil.h"
 #include "System/Platform/Misc.h"
 #include "System/Threading/ThreadPool.h"
@@ -158,14 +160,18 @@ CSevenZipArchive::CSevenZipArchive(const std::string& name)
 	}
 
 	// for truly solid archive, one call to SzArEx_Extract() extract all files in one huge buffer,
-	// makes no sense to MT access as calls to SzArEx_Extract() are really expensive in terms of RAM and CPU
-	// for truly non-solid archive each call to SzArEx_Extract() extracts one file,
-	// can MT as calls to SzArEx_Extract() are relatively inexpensive
+	// for truly non-solid archive each call to SzArEx_Extract() extracts one file
 	// Now there is a grey area 7z approach with blocks of certain fixed size.
 	// It's not clear how to get the block size information, so we will use another heuristic to consider the archive solid
 	considerSolid = (db.db.NumFolders == 1) || (fileEntries.size() > db.db.NumFolders && db.db.NumFolders < ThreadPool::GetNumThreads());
 
-	parallelAccessNum = !CheckForSolid() ? ThreadPool::GetNumThreads() : 1; // allow parallel access, but only for non-solid archives
+	// solid blocks are extracted once into the block cache, so threads only need
+	// their own archive handle when they are extracting different blocks at once
+	parallelAccessNum = !CheckForSolid() ? ThreadPool::GetNumThreads() : std::clamp<uint32_t>(db.db.NumFolders, 1, ThreadPool::GetNumThreads());
+
+	if (CheckForSolid())
+		blockLocks = std::make_unique<spring::mutex[]>(db.db.NumFolders);
+
 	sem = std::make_unique<decltype(sem)::element_type>(parallelAccessNum);
 	const auto maxBitMask = (1u << parallelAccessNum) - 1;
 	afi.SetMaxBitsMask(maxBitMask);
@@ -174,6 +180,16 @@ CSevenZipArchive::CSevenZipArchive(const std::string& name)
 
 CSevenZipArchive::~CSevenZipArchive()
 {
+	if (CheckForSolid()) {
+		LOG_L(L_INFO, "[%s][name=%s] %u solid blocks extracted, " _STPF_ " bytes in %u blocks cached",
+			__func__, archiveFile.c_str(),
+			numBlockExtracts, blockCacheBytes, static_cast<uint32_t>(blockCache.size())
+		);
+	}
+
+	// blocks must be released while allocImp is still around
+	blockCache.clear();
+
 	std::scoped_lock lck(archiveLock); //not needed?
 
 	for (size_t i = 0; i < ThreadPool::GetNumThreads(); ++i) {
@@ -202,9 +218,40 @@ int CSevenZipArchive::GetFileImpl(uint32_t fid, std::vector<std::uint8_t>& buffe
 {
 	assert(IsFileId(fid));
 
+	if (CheckForSolid()) {
+		// file metadata is identical across handles and never written to after opening
+		const auto& db = perThreadData[0]->db;
+		const uint32_t fp = fileEntries[fid].fp;
+
+		// empty files do not belong to any block
+		if (db.FileToFolder[fp] == 0xFFFFFFFF) {
+			buffer.clear();
+			return 1;
+		}
+
+		size_t blockSize = 0;
+		const auto block = GetBlock(fp, blockSize);
+
+		if (block == nullptr)
+			return 0;
+
+		const size_t offset = db.UnpackPositions[fp] - db.UnpackPositions[db.FolderToFile[db.FileToFolder[fp]]];
+		const size_t size = db.UnpackPositions[fp + 1] - db.UnpackPositions[fp];
+
+		if ((offset + size) > blockSize) {
+			LOG_L(L_ERROR, "[%s] error reading \"%s\": file %u out of block bounds", __func__, archiveFile.c_str(), fid);
+			return 0;
+		}
+
+		buffer.resize(size);
+		if (size > 0) {
+			memcpy(buffer.data(), block.get() + offset, size);
+		}
+		return 1;
+	}
+
 	// see CZipArchive::GetFileImpl() why we do the thing below
 	const auto tnum = afi.AcquireScoped();
-	assert(!considerSolid || tnum == 0);
 	assert(tnum < parallelAccessNum);
 
 	if (!perThreadData[tnum])
@@ -232,6 +279,134 @@ int CSevenZipArchive::GetFileImpl(uint32_t fid, std::vector<std::uint8_t>& buffe
 	return 1;
 }
 
+std::shared_ptr<const Byte> CSevenZipArchive::GetBlock(uint32_t fp, size_t& blockSize)
+{
+	const uint32_t blockIndex = perThreadData[0]->db.FileToFolder[fp];
+	const auto blockPred = [blockIndex](const CachedBlock& cb) { return (cb.blockIndex == blockIndex); };
+
+	// threads wanting the same block wait here for the first one to extract it
+	std::scoped_lock blockLck(blockLocks[blockIndex]);
+
+	{
+		std::scoped_lock lck(blockCacheMutex);
+
+		if (const auto it = std::find_if(blockCache.begin(), blockCache.end(), blockPred); it != blockCache.end()) {
+			it->lastAccess = ++blockAccessCount;
+			blockSize = it->size;
+			return it->data;
+		}
+	}
+
+	const auto tnum = afi.AcquireScoped();
+	assert(tnum < parallelAccessNum);
+
+	if (!perThreadData[tnum])
+		OpenArchive(tnum);
+
+	auto& db         = perThreadData[tnum]->db;
+	auto& lookStream = perThreadData[tnum]->lookStream;
+
+	// extract into a fresh buffer which is then owned by the cache
+	UInt32 extractedIndex = 0xFFFFFFFF;
+	Byte* outBuffer = nullptr;
+	size_t outBufferSize = 0;
+	size_t offset = 0;
+	size_t outSizeProcessed = 0;
+
+	if (auto res = SzArEx_Extract(&db, &lookStream.vt, fp, &extractedIndex, &outBuffer, &outBufferSize, &offset, &outSizeProcessed, &allocImp, &allocTempImp); res != SZ_OK) {
+		LOG_L(L_ERROR, "[%s] error opening \"%s\": %s", __func__, archiveFile.c_str(), GetErrorStr(res));
+
+		if (outBuffer != nullptr)
+			IAlloc_Free(&allocImp, outBuffer);
+
+		return nullptr;
+	}
+
+	assert(extractedIndex == blockIndex);
+
+	std::shared_ptr<const Byte> data(outBuffer, [this](const Byte* p) { IAlloc_Free(&allocImp, const_cast<Byte*>(p)); });
+
+	std::scoped_lock lck(blockCacheMutex);
+
+	blockCache.emplace_back(blockIndex, ++blockAccessCount, outBufferSize, data);
+	blockCacheBytes += outBufferSize;
+	numBlockExtracts += 1;
+
+	// evict least recently used blocks; readers still holding one keep it alive
+	while (blockCacheBytes > MAX_BLOCK_CACHE_BYTES && blockCache.size() > 1) {
+		const auto lruPred = [](const CachedBlock& a, const CachedBlock& b) { return (a.lastAccess < b.lastAccess); };
+		const auto it = std::min_element(blockCache.begin(), blockCache.end(), lruPred);
+
+		blockCacheBytes -= it->size;
+		blockCache.erase(it);
+	}
+
+	blockSize = outBufferSize;
+	return data;
+}
+
+void CSevenZipArchive::PrefetchFiles(const std::vector<uint32_t>& fids)
+{
+	if (!CheckForSolid()) {
+		CBufferedArchive::PrefetchFiles(fids);
+		return;
+	}
+
+	if (!globalConfig.vfsCacheArchiveFiles || parallelAccessNum <= 1)
+		return;
+
+	const auto& db = perThreadData[0]->db;
+
+	// one file-index per block, in block order; blocks that would not fit
+	// into the cache together are left to be extracted on first access
+	std::vector<uint32_t> blockFps;
+	std::vector<uint32_t> sortedFids = fids;
+
+	SortByReadOrder(sortedFids);
+
+	uint64_t blockBytes = 0;
+	uint32_t lastIndex = 0xFFFFFFFF;
+
+	for (const uint32_t fid: sortedFids) {
+		assert(IsFileId(fid));
+
+		const uint32_t fp = fileEntries[fid].fp;
+		const uint32_t blockIndex = db.FileToFolder[fp];
+
+		if (blockIndex == 0xFFFFFFFF || blockIndex == lastIndex)
+			continue;
+
+		lastIndex = blockIndex;
+
+		if ((blockBytes += SzAr_GetFolderUnpackSize(&db.db, blockIndex)) > MAX_BLOCK_CACHE_BYTES)
+			break;
+
+		blockFps.push_back(fp);
+	}
+
+	if (blockFps.size() <= 1)
+		return;
+
+	for_mt(0, blockFps.size(), [&](const int i) {
+		auto scopedSemAcq = AcquireSemaphoreScoped();
+		size_t blockSize = 0;
+		GetBlock(blockFps[i], blockSize);
+	});
+
+	LOG_L(L_DEBUG, "[SevenZipArchive::%s][name=%s] prefetched %u solid blocks", __func__, archiveFile.c_str(), static_cast<uint32_t>(blockFps.size()));
+}
+
+uint64_t CSevenZipArchive::FileReadOrder(uint32_t fid) const
+{
+	assert(IsFileId(fid));
+
+	const auto& db = perThreadData[0]->db;
+	const uint32_t fp = fileEntries[fid].fp;
+
+	// files are stored in index order within their block
+	return ((static_cast<uint64_t>(db.FileToFolder[fp]) << 32) | fp);
+}
+
 const std::string& CSevenZipArchive::FileName(uint32_t fid) const
 {
 	assert(IsFileId(fid));
@@ -8,6 +8,7 @@
 #include <string>
 #include <optional>
 #include <bitset>
+#include <memory>
 
 #include <7z.h>
 #include <7zFile.h>
@@ -48,6 +49,9 @@ public:
 	SFileInfo FileInfo(uint32_t fid) const override;
 
 	bool CheckForSolid() const override { return considerSolid; }
+	uint64_t FileReadOrder(uint32_t fid) const override;
+
+	void PrefetchFiles(const std::vector<uint32_t>& fids) override;
 protected:
 	int GetFileImpl(uint32_t fid, std::vector<std::uint8_t>& buffer) override;
 private:
@@ -66,6 +70,12 @@ private:
 
 	void OpenArchive(int tnum);
 
+	/**
+	 * Returns the uncompressed solid block holding file-index fp,
+	 * extracting it into the block cache if not yet present.
+	 */
+	std::shared_ptr<const Byte> GetBlock(uint32_t fp, size_t& blockSize);
+
 	static inline spring::mutex archiveLock;
 	static constexpr size_t INPUT_BUF_SIZE = (size_t)1 << 18;
 
@@ -86,6 +96,26 @@ private:
 	ISzAlloc allocImp;
 	ISzAlloc allocTempImp;
 
+	struct CachedBlock {
+		uint32_t blockIndex;
+		uint64_t lastAccess;
+		size_t size;
+		std::shared_ptr<const Byte> data;
+	};
+
+	// upper bound for uncompressed solid blocks kept around; the most
+	// recently used block is always kept, even if larger than this
+	static constexpr size_t MAX_BLOCK_CACHE_BYTES = 256 * 1024 * 1024;
+
+	std::vector<CachedBlock> blockCache;
+	// one per solid block, serializes extraction of the same block
+	std::unique_ptr<spring::mutex[]> blockLocks;
+	spring::mutex blockCacheMutex;
+
+	size_t blockCacheBytes = 0;
+	uint64_t blockAccessCount = 0;
+	uint32_t numBlockExtracts = 0;
+
 	std::bitset<MAX_THREADS> isOpen = { false };
 	bool considerSolid = false;
 };
@@ -180,10 +180,7 @@ bool CVFSHandler::AddArchive(const std::string& archiveName, bool overwrite)
 		const auto size = ar->FileSize(fid);
 
 		if (!overwrite) {
-			const auto pred = [](const FileEntry& a, const FileEntry& b) { return (a.first < b.first); };
-			const auto iter = std::lower_bound(files[rawSection].begin(), files[rawSection].end(), FileEntry{name, FileData{}}, pred);
-
-			if (iter != files[rawSection].end() && iter->first == name) {
+			if (fileIndex[rawSection].find(name) != fileIndex[rawSection].end()) {
 				LOG_L(L_DEBUG, "[%s::%s<this=%p>] skipping \"%s\", exists", vfsName, __func__, this, name.c_str());
 				continue;
 			}
@@ -195,7 +192,7 @@ bool CVFSHandler::AddArchive(const std::string& archiveName, bool overwrite)
 
 		// can not add directly to files[section], would break lower_bound
 		// note: this means an archive can *internally* contain duplicates
-		files[Section::Temp].emplace_back(name, FileData{ ar, size });
+		files[Section::Temp].emplace_back(name, FileData{ ar, size, fid });
 	}
 
 	for (FileEntry& fileEntry: files[Section::Temp]) {
@@ -203,6 +200,7 @@ bool CVFSHandler::AddArchive(const std::string& archiveName, bool overwrite)
 	}
 
 	std::stable_sort(files[rawSection].begin(), files[rawSection].end(), [](const FileEntry& a, const FileEntry& b) { return (a.first < b.first); });
+	IndexFiles(rawSection);
 	return true;
 }
 
@@ -271,6 +269,7 @@ bool CVFSHandler::RemoveArchive(const std::string& archiveName)
 
 		// wipe entries belonging to the to-be-deleted archive
 		files[section].erase(pos, end);
+		IndexFiles(section);
 	}
 
 
@@ -309,6 +308,7 @@ void CVFSHandler::DeleteArchives(Section section)
 
 	archives[section].clear();
 	files[section].clear();
+	fileIndex[section].clear();
 }
 
 void CVFSHandler::ReserveArchives()
@@ -325,6 +325,7 @@ void CVFSHandler::ReserveArchives()
 
 		files[section].clear();
 		files[section].reserve(2048);
+		fileIndex[section].clear();
 	}
 
 	// preload universal dependencies
@@ -346,6 +347,10 @@ void CVFSHandler::UnMapArchives(bool reload)
 		// menu persists reload, but controller is always reset
 		files[Section::Menu].clear();
 
+		fileIndex[Section::Mod ].clear();
+		fileIndex[Section::Map ].clear();
+		fileIndex[Section::Menu].clear();
+
 		// stash archives when reloading from game to menu
 		for (const auto& pair: archives[Section::Mod]) {
 			archives[Section::TempMod ].insert(pair);
@@ -364,10 +369,16 @@ void CVFSHandler::UnMapArchives(bool reload)
 		std::swap(files[Section::Mod ], files[Section::TempMod ]);
 		std::swap(files[Section::Map ], files[Section::TempMap ]);
 		std::swap(files[Section::Menu], files[Section::TempMenu]);
+		std::swap(fileIndex[Section::Mod ], fileIndex[Section::TempMod ]);
+		std::swap(fileIndex[Section::Map ], fileIndex[Section::TempMap ]);
+		std::swap(fileIndex[Section::Menu], fileIndex[Section::TempMenu]);
 
 		files[Section::Mod ].clear();
 		files[Section::Map ].clear();
 		files[Section::Menu].clear();
+		fileIndex[Section::Mod ].clear();
+		fileIndex[Section::Map ].clear();
+		fileIndex[Section::Menu].clear();
 	}
 }
 
@@ -383,10 +394,16 @@ void CVFSHandler::ReMapArchives(bool reload)
 		std::swap(files[Section::Mod ], files[Section::TempMod ]);
 		std::swap(files[Section::Map ], files[Section::TempMap ]);
 		std::swap(files[Section::Menu], files[Section::TempMenu]);
+		std::swap(fileIndex[Section::Mod ], fileIndex[Section::TempMod ]);
+		std::swap(fileIndex[Section::Map ], fileIndex[Section::TempMap ]);
+		std::swap(fileIndex[Section::Menu], fileIndex[Section::TempMenu]);
 
 		files[Section::TempMod ].clear();
 		files[Section::TempMap ].clear();
 		files[Section::TempMenu].clear();
+		fileIndex[Section::TempMod ].clear();
+		fileIndex[Section::TempMap ].clear();
+		fileIndex[Section::TempMenu].clear();
 	}
 }
 
@@ -397,8 +414,22 @@ void CVFSHandler::SwapArchiveSections(Section src, Section dst)
 
 	LOG_L(L_INFO, "[%s::%s<this=%p>(src=%d dst=%d)]", vfsName, __func__, this, src, dst);
 
-	std::swap(   files[src],    files[dst]);
-	std::swap(archives[src], archives[dst]);
+	std::swap(    files[src],     files[dst]);
+	std::swap(fileIndex[src], fileIndex[dst]);
+	std::swap( archives[src],  archives[dst]);
+}
+
+void CVFSHandler::IndexFiles(Section section)
+{
+	auto& index = fileIndex[section];
+
+	index.clear();
+	index.reserve(files[section].size());
+
+	// files are sorted stably, so the first entry per path is the one lower_bound used to find
+	for (const FileEntry& entry: files[section]) {
+		index.emplace(entry.first, entry.second);
+	}
 }
 
 
@@ -416,30 +447,14 @@ CVFSHandler::FileData CVFSHandler::GetFileData(const std::string& normalizedFile
 	assert(section < Section::Count);
 	std::lock_guard<decltype(vfsMutex)> lck(vfsMutex);
 
-	const auto& vect = files[section];
-	const auto  cbeg = vect.cbegin();
-	const auto  cend = vect.cend();
-	const auto  file = FileEntry{normalizedFilePath, FileData{}};
-	const auto  sane = [&]() -> bool {
-		for (size_t i = 1, n = vect.size(); i < n; i++) {
-			if (vect[i - 1].first > vect[i].first)
-				return false;
-		}
-		return true;
-	};
+	const auto& index = fileIndex[section];
+	const auto  iter = index.find(normalizedFilePath);
 
-	{
-		assert(sane());
-
-		const auto pred = [ ](const FileEntry& a, const FileEntry& b) { return (a.first < b.first); };
-		const auto iter = std::lower_bound(cbeg, cend, file, pred);
-
-		if (iter != cend && iter->first == normalizedFilePath)
-			return {iter->second.ar, iter->second.size};
-	}
+	if (iter != index.end())
+		return iter->second;
 
 	// file does not exist in the VFS
-	return {nullptr, 0};
+	return {nullptr, 0, 0};
 }
 
 
@@ -455,7 +470,53 @@ int CVFSHandler::LoadFile(const std::string& filePath, std::vector<std::uint8_t>
 		return -1;
 
 	// 0 or 1
-	return (fileData.ar->GetFile(normalizedPath, buffer));
+	return (fileData.ar->GetFile(fileData.fid, buffer));
+}
+
+void CVFSHandler::PrefetchFiles(const std::vector<std::string>& rawDirs, Section section)
+{
+	assert(section < Section::Count);
+
+	std::vector<std::pair<IArchive*, std::vector<uint32_t>>> archiveFiles;
+
+	{
+		std::lock_guard<decltype(vfsMutex)> lck(vfsMutex);
+
+		const auto filesPred = [](const FileEntry& a, const FileEntry& b) { return (a.first < b.first); };
+		const auto& filesVec = files[section];
+
+		for (const std::string& rawDir: rawDirs) {
+			std::string dir = GetNormalizedPath(rawDir);
+
+			if (dir.empty())
+				continue;
+			if (dir.back() != '/')
+				dir += "/";
+
+			// same range as GetFilesInDir, sub-directories included
+			auto filesBeg = std::lower_bound(filesVec.begin(), filesVec.end(), FileEntry{dir, FileData{}}, filesPred); dir.back() += 1;
+			auto filesEnd = std::upper_bound(filesVec.begin(), filesVec.end(), FileEntry{dir, FileData{}}, filesPred); dir.back() -= 1;
+
+			for (; filesBeg != filesEnd; ++filesBeg) {
+				IArchive* ar = filesBeg->second.ar;
+
+				const auto pred = [ar](const std::pair<IArchive*, std::vector<uint32_t>>& p) { return (p.first == ar); };
+				auto iter = std::find_if(archiveFiles.begin(), archiveFiles.end(), pred);
+
+				if (iter == archiveFiles.end())
+					iter = archiveFiles.emplace(archiveFiles.end(), ar, std::vector<uint32_t>{});
+
+				iter->second.push_back(filesBeg->second.fid);
+			}
+		}
+	}
+
+	LOG_L(L_DEBUG, "[%s::%s<this=%p>(#dirs=%u, section=%d)] #archives=%u", vfsName, __func__, this, static_cast<uint32_t>(rawDirs.size()), section, static_cast<uint32_t>(archiveFiles.size()));
+
+	for (auto& [ar, fids]: archiveFiles) {
+		ar->SortByReadOrder(fids);
+		ar->PrefetchFiles(fids);
+	}
 }
 
 int CVFSHandler::FileExists(const std::string& filePath, Section section)
@@ -468,8 +529,8 @@ int CVFSHandler::FileExists(const std::string& filePath, Section section)
 	if (fileData.ar == nullptr)
 		return -1;
 
-	// 0 or 1
-	return (fileData.ar->FileExists(normalizedPath));
+	// the index only holds files of mounted archives
+	return 1;
 }
 
 std::string CVFSHandler::GetFileAbsolutePath(const std::string& filePath, Section section)
@@ -479,7 +540,7 @@ std::string CVFSHandler::GetFileAbsolutePath(const std::string& filePath, Sectio
 	const std::string& normalizedPath = GetNormalizedPath(filePath);
 	const FileData& fileData = GetFileData(normalizedPath, section);
 
-	if (fileData.ar->GetType() != ARCHIVE_TYPE_SDD)
+	if (fileData.ar == nullptr || fileData.ar->GetType() != ARCHIVE_TYPE_SDD)
 		return "";
 
 	// Only directory archives have an absolute path on disk
@@ -495,6 +556,10 @@ std::string CVFSHandler::GetFileArchiveName(const std::string& filePath, Section
 
 	const std::string& normalizedPath = GetNormalizedPath(filePath);
 	const auto& fileData = GetFileData(normalizedPath, section);
+
+	if (fileData.ar == nullptr)
+		return "";
+
 	const auto& archiveFile = fileData.ar->GetArchiveFile();
 	const auto& baseName = FileSystem::GetFilename(archiveFile);
 	const auto& archiveName = archiveScanner->NameFromArchive(baseName);
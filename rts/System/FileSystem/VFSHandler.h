@@ -104,6 +104,15 @@ public:
 	 */
 	int LoadFile(const std::string& filePath, std::vector<std::uint8_t>& buffer, Section section);
 
+	/**
+	 * Lets the archives uncompress all files in the given (virtual)
+	 * directories, including sub-directories, in parallel ahead of
+	 * the LoadFile calls for them.
+	 * @param dirs raw directory paths, for example "units/",
+	 *   case-insensitive
+	 */
+	void PrefetchFiles(const std::vector<std::string>& dirs, Section section);
+
 
 	/**
 	 * Returns all the files in the given (virtual) directory without the
@@ -162,14 +171,20 @@ private:
 	struct FileData {
 		IArchive* ar;
 		int size;
+		uint32_t fid;
 	};
 	typedef std::pair<std::string, FileData> FileEntry;
 
 	std::string GetNormalizedPath(const std::string& rawPath);
 	FileData GetFileData(const std::string& normalizedFilePath, Section section) const;
 
+	void IndexFiles(Section section);
+
 private:
+	// sorted by path for directory listings
 	std::array<std::vector<FileEntry>, Section::Count> files;
+	// path lookups; first entry per path in files[section], rebuilt when files change
+	std::array<spring::unordered_map<std::string, FileData>, Section::Count> fileIndex;
 	std::array<spring::unordered_map<std::string, IArchive*>, Section::Count> archives;
 
 	const char* vfsName = "";
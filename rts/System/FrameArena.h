@@ -0,0 +1,208 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#ifndef FRAME_ARENA_H
+#define FRAME_ARENA_H
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+#include "System/Threading/SpringThreading.h"
+
+/**
+ * Per-thread bump allocator for transient data that never outlives the
+ * current sim or draw frame, e.g. temporary vectors in hot loops. Every
+ * call to NewFrame (made at sim- and draw-frame boundaries) invalidates
+ * everything allocated before it; each thread's arena rewinds lazily on
+ * its next allocation. Deallocation is a no-op unless it undoes the most
+ * recent allocation.
+ *
+ * Memory comes in chunks which are kept across frames, so after warm-up
+ * there is no malloc traffic. Overflowing the chunks of a frame allocates
+ * a new one; the next rewind folds them into one chunk of the peak size.
+ */
+class CFrameArena {
+public:
+	struct Stats {
+		size_t usedBytes = 0;     // allocated since the arena's last rewind
+		size_t peakBytes = 0;     // max. usedBytes over all frames
+		size_t reservedBytes = 0; // chunk memory held
+		size_t numChunks = 0;
+		size_t numArenas = 0;
+	};
+
+	static constexpr size_t CHUNK_SIZE = 256 * 1024;
+
+public:
+	CFrameArena() {
+		std::lock_guard<spring::mutex> lck(GetRegistryMutex());
+		GetRegistry().push_back(this);
+	}
+	~CFrameArena() {
+		std::lock_guard<spring::mutex> lck(GetRegistryMutex());
+		auto& registry = GetRegistry();
+		registry.erase(std::find(registry.begin(), registry.end(), this));
+	}
+
+	CFrameArena(const CFrameArena&) = delete;
+	CFrameArena& operator = (const CFrameArena&) = delete;
+
+	/// the calling thread's arena
+	static CFrameArena& Get() {
+		static thread_local CFrameArena arena;
+		return arena;
+	}
+
+	/// marks a frame boundary, invalidates all frame-arena memory of every thread
+	static void NewFrame() { frameNum.fetch_add(1, std::memory_order_release); }
+
+	static Stats GetStats() {
+		Stats stats;
+
+		std::lock_guard<spring::mutex> lck(GetRegistryMutex());
+
+		for (const CFrameArena* arena: GetRegistry()) {
+			stats.usedBytes     += arena->usedBytes.load(std::memory_order_relaxed);
+			stats.peakBytes     += arena->peakBytes.load(std::memory_order_relaxed);
+			stats.reservedBytes += arena->reservedBytes.load(std::memory_order_relaxed);
+			stats.numChunks     += arena->numChunks.load(std::memory_order_relaxed);
+			stats.numArenas     += 1;
+		}
+
+		return stats;
+	}
+
+	void* Allocate(size_t size, size_t align) {
+		if (arenaFrameNum != frameNum.load(std::memory_order_acquire))
+			Rewind();
+
+		uintptr_t ptr = (curPos + (align - 1)) & ~uintptr_t(align - 1);
+
+		if ((ptr + size) > curEnd || curEnd == 0) {
+			AddChunk(std::max(size + align, CHUNK_SIZE));
+			ptr = (curPos + (align - 1)) & ~uintptr_t(align - 1);
+		}
+
+		lastPos = curPos;
+		curPos = ptr + size;
+
+		UpdateUsedBytes(size + (ptr - lastPos));
+		return reinterpret_cast<void*>(ptr);
+	}
+
+	void Deallocate(void* p, size_t size) {
+		// only the latest allocation can be taken back
+		if ((reinterpret_cast<uintptr_t>(p) + size) != curPos)
+			return;
+		if (lastPos > reinterpret_cast<uintptr_t>(p))
+			return;
+
+		usedBytes.fetch_sub(curPos - lastPos, std::memory_order_relaxed);
+		curPos = lastPos;
+	}
+
+private:
+	struct FreeDeleter { void operator () (uint8_t* p) const { std::free(p); } };
+	typedef std::unique_ptr<uint8_t, FreeDeleter> ChunkPtr;
+
+	static std::vector<CFrameArena*>& GetRegistry() {
+		static std::vector<CFrameArena*> registry;
+		return registry;
+	}
+	static spring::mutex& GetRegistryMutex() {
+		static spring::mutex mutex;
+		return mutex;
+	}
+
+	void AddChunk(size_t size) {
+		chunks.emplace_back(static_cast<uint8_t*>(std::malloc(size)), size);
+		assert(chunks.back().first != nullptr);
+
+		curPos = reinterpret_cast<uintptr_t>(chunks.back().first.get());
+		curEnd = curPos + size;
+
+		numChunks.store(chunks.size(), std::memory_order_relaxed);
+		reservedBytes.fetch_add(size, std::memory_order_relaxed);
+	}
+
+	void Rewind() {
+		arenaFrameNum = frameNum.load(std::memory_order_acquire);
+
+		// fold an overflowing frame's chunks into a single one
+		if (chunks.size() > 1) {
+			const size_t size = std::max(peakBytes.load(std::memory_order_relaxed), reservedBytes.load(std::memory_order_relaxed));
+
+			chunks.clear();
+			reservedBytes.store(0, std::memory_order_relaxed);
+
+			AddChunk(size);
+		}
+
+		if (!chunks.empty()) {
+			curPos = reinterpret_cast<uintptr_t>(chunks.front().first.get());
+			curEnd = curPos + chunks.front().second;
+		}
+
+		lastPos = curPos;
+		usedBytes.store(0, std::memory_order_relaxed);
+	}
+
+	void UpdateUsedBytes(size_t size) {
+		const size_t used = usedBytes.fetch_add(size, std::memory_order_relaxed) + size;
+
+		if (used > peakBytes.load(std::memory_order_relaxed))
+			peakBytes.store(used, std::memory_order_relaxed);
+	}
+
+private:
+	static inline std::atomic<uint64_t> frameNum = {0};
+
+	std::vector<std::pair<ChunkPtr, size_t>> chunks;
+
+	uintptr_t curPos = 0;
+	uintptr_t curEnd = 0;
+	uintptr_t lastPos = 0;
+
+	uint64_t arenaFrameNum = 0;
+
+	// written by the owning thread only, atomic for GetStats
+	std::atomic<size_t> usedBytes = {0};
+	std::atomic<size_t> peakBytes = {0};
+	std::atomic<size_t> reservedBytes = {0};
+	std::atomic<size_t> numChunks = {0};
+};
+
+
+/**
+ * STL allocator on top of the CFrameArena of the thread constructing it,
+ * containers using it must not outlive the current frame.
+ */
+template<typename T>
+class FrameArenaAllocator {
+public:
+	typedef T value_type;
+
+	FrameArenaAllocator(): arena(&CFrameArena::Get()) {}
+	template<typename U> FrameArenaAllocator(const FrameArenaAllocator<U>& a): arena(a.arena) {}
+
+	T* allocate(size_t n) { return static_cast<T*>(arena->Allocate(n * sizeof(T), alignof(T))); }
+	void deallocate(T* p, size_t n) { arena->Deallocate(p, n * sizeof(T)); }
+
+	template<typename U> bool operator == (const FrameArenaAllocator<U>& a) const { return (arena == a.arena); }
+	template<typename U> bool operator != (const FrameArenaAllocator<U>& a) const { return (arena != a.arena); }
+
+private:
+	template<typename U> friend class FrameArenaAllocator;
+
+	CFrameArena* arena;
+};
+
+template<typename T>
+using FrameVector = std::vector<T, FrameArenaAllocator<T>>;
+
+#endif
@@ -0,0 +1,118 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#include <algorithm>
+#include <cstdio>
+#include <mutex>
+
+#include "System/FrameTelemetry.h"
+#include "System/TimeUtil.h"
+#include "System/FileSystem/DataDirsAccess.h"
+#include "System/FileSystem/FileQueryFlags.h"
+#include "System/FileSystem/FileSystem.h"
+#include "System/Log/ILog.h"
+
+
+static std::vector<CFrameTelemetry*> gTelemetryRings;
+static spring::spinlock gTelemetryRingsLock;
+
+
+CFrameTelemetry::CFrameTelemetry(const char* _name): name(_name)
+{
+	records.resize(NUM_RECORDS);
+
+	std::lock_guard<spring::spinlock> lck(gTelemetryRingsLock);
+	gTelemetryRings.push_back(this);
+}
+
+CFrameTelemetry::~CFrameTelemetry()
+{
+	std::lock_guard<spring::spinlock> lck(gTelemetryRingsLock);
+	gTelemetryRings.erase(std::find(gTelemetryRings.begin(), gTelemetryRings.end(), this));
+}
+
+
+void CFrameTelemetry::Push(const Record& record)
+{
+	std::lock_guard<spring::spinlock> lck(ringLock);
+	records[(numPushed++) % NUM_RECORDS] = record;
+}
+
+size_t CFrameTelemetry::GetRecent(Record* recent, size_t count) const
+{
+	std::lock_guard<spring::spinlock> lck(ringLock);
+
+	count = std::min(count, GetNumRecords());
+
+	for (size_t i = 0; i < count; i++) {
+		recent[i] = records[(numPushed - count + i) % NUM_RECORDS];
+	}
+
+	return count;
+}
+
+
+std::string CFrameTelemetry::Dump(const char* reason) const
+{
+	std::lock_guard<spring::spinlock> lck(ringLock);
+	return (WriteDump(reason));
+}
+
+void CFrameTelemetry::DumpAll(const char* reason)
+{
+	// we may have crashed while holding either lock; skip rather than hang
+	if (!gTelemetryRingsLock.try_lock())
+		return;
+
+	for (const CFrameTelemetry* ring: gTelemetryRings) {
+		if (!ring->ringLock.try_lock())
+			continue;
+
+		const std::string path = ring->WriteDump(reason);
+
+		ring->ringLock.unlock();
+
+		if (!path.empty())
+			LOG_L(L_ERROR, "[FrameTelemetry::%s] %s telemetry written to \"%s\"", __func__, ring->name, path.c_str());
+	}
+
+	gTelemetryRingsLock.unlock();
+}
+
+
+std::string CFrameTelemetry::WriteDump(const char* reason) const
+{
+	const size_t numRecords = GetNumRecords();
+
+	if (numRecords == 0)
+		return "";
+
+	const std::string fileName = std::string("telemetry/") + name + "_" + reason + "_" + CTimeUtil::GetCurrentTimeStr() + ".rtl";
+	const std::string filePath = dataDirsAccess.LocateFile(fileName, FileQueryFlags::WRITE | FileQueryFlags::CREATE_DIRS);
+
+	FILE* file = fopen(filePath.c_str(), "wb");
+
+	if (file == nullptr)
+		return "";
+
+	const uint32_t header[] = {VERSION, sizeof(Record), static_cast<uint32_t>(numRecords), NUM_COUNTERS, NUM_STAGES};
+
+	fwrite("RCTL", 4, 1, file);
+	fwrite(header, sizeof(header), 1, file);
+
+	for (const std::string& slotName: counterNames) {
+		fwrite(slotName.c_str(), slotName.size() + 1, 1, file);
+	}
+	for (const std::string& slotName: stageNames) {
+		fwrite(slotName.c_str(), slotName.size() + 1, 1, file);
+	}
+
+	// oldest first; the ring has wrapped once numPushed exceeds its size
+	const size_t first = (numPushed - numRecords) % NUM_RECORDS;
+	const size_t tail = std::min(numRecords, NUM_RECORDS - first);
+
+	fwrite(&records[first], sizeof(Record), tail, file);
+	fwrite(&records[0], sizeof(Record), numRecords - tail, file);
+	fclose(file);
+
+	return filePath;
+}
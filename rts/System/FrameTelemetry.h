@@ -0,0 +1,96 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#ifndef FRAME_TELEMETRY_H
+#define FRAME_TELEMETRY_H
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "System/Threading/SpringThreading.h"
+
+/**
+ * Always-on ring of compact per-frame records (64 bytes each), kept by the
+ * client for every sim frame and by the server for every tick that creates
+ * frames. The meaning of the counter and stage slots is set by the owner
+ * and stored in the dump header, so dumps are self-describing.
+ *
+ * Dumped to <writedir>/telemetry/ on desync, lag spikes and crashes; the
+ * server can also stream its records to the autohost.
+ *
+ * Dump format (little endian):
+ *   char[4] magic "RCTL", uint32 version, uint32 recordSize, uint32 numRecords,
+ *   uint32 NUM_COUNTERS, uint32 NUM_STAGES,
+ *   (NUM_COUNTERS + NUM_STAGES) zero-terminated slot names,
+ *   Record[numRecords] (oldest first)
+ */
+class CFrameTelemetry {
+public:
+	static constexpr size_t NUM_RECORDS = 8192; // ~4.5 minutes at 30Hz
+	static constexpr size_t NUM_COUNTERS = 4;
+	static constexpr size_t NUM_STAGES = 16;
+
+	static constexpr uint32_t VERSION = 1;
+
+	// stage times are stored in units of 10us, saturating at ~655ms
+	static constexpr float STAGE_TIME_UNIT_MS = 0.01f;
+
+	struct Record {
+		int32_t frameNum = 0;
+		float frameTimeMs = 0.0f;
+
+		// since the previous record
+		uint32_t netBytesIn = 0;
+		uint32_t netBytesOut = 0;
+
+		std::array<uint32_t, NUM_COUNTERS> counters = {};
+		std::array<uint16_t, NUM_STAGES> stageTimes = {};
+	};
+
+	static_assert(sizeof(Record) == 64, "");
+
+public:
+	CFrameTelemetry(const char* name);
+	~CFrameTelemetry();
+
+	CFrameTelemetry(const CFrameTelemetry&) = delete;
+	CFrameTelemetry& operator = (const CFrameTelemetry&) = delete;
+
+	void SetCounterName(size_t i, const char* name) { counterNames[i] = name; }
+	void SetStageName(size_t i, const char* name) { stageNames[i] = name; }
+
+	static uint16_t ToStageTime(float ms) {
+		return static_cast<uint16_t>(std::min(ms / STAGE_TIME_UNIT_MS + 0.5f, 65535.0f));
+	}
+
+	void Push(const Record& record);
+
+	/// copies the <count> most recent records (oldest first), returns how many there were
+	size_t GetRecent(Record* records, size_t count) const;
+	size_t GetNumRecords() const { return std::min(numPushed, NUM_RECORDS); }
+
+	/// writes the ring to telemetry/<name>_<reason>_<time>.rtl, returns the path or an empty string
+	std::string Dump(const char* reason) const;
+
+	/// dumps every live ring; called by the crash handlers, never blocks
+	static void DumpAll(const char* reason);
+
+private:
+	std::string WriteDump(const char* reason) const;
+
+private:
+	const char* name;
+
+	std::array<std::string, NUM_COUNTERS> counterNames;
+	std::array<std::string, NUM_STAGES> stageNames;
+
+	std::vector<Record> records;
+	size_t numPushed = 0;
+
+	mutable spring::spinlock ringLock;
+};
+
+#endif
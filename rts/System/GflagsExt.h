@@ -26,23 +26,23 @@
   DEFINE_VARIABLE_EX(bool, B, name, external_name, val, txt)
 
 
-#define DEFINE_int32_EX(name, val, txt) \
+#define DEFINE_int32_EX(name, external_name, val, txt) \
    DEFINE_VARIABLE_EX(GFLAGS_NAMESPACE::int32, I, \
                    name, external_name, val, txt)
 
-#define DEFINE_uint32_EX(name,val, txt) \
+#define DEFINE_uint32_EX(name, external_name, val, txt) \
    DEFINE_VARIABLE_EX(GFLAGS_NAMESPACE::uint32, U, \
                    name, external_name, val, txt)
 
-#define DEFINE_int64_EX(name, val, txt) \
+#define DEFINE_int64_EX(name, external_name, val, txt) \
    DEFINE_VARIABLE_EX(GFLAGS_NAMESPACE::int64, I64, \
                    name, external_name, val, txt)
 
-#define DEFINE_uint64_EX(name,val, txt) \
+#define DEFINE_uint64_EX(name, external_name, val, txt) \
    DEFINE_VARIABLE_EX(GFLAGS_NAMESPACE::uint64, U64, \
                    name, external_name, val, txt)
 
-#define DEFINE_double_EX(name, val, txt) \
+#define DEFINE_double_EX(name, external_name, val, txt) \
    DEFINE_VARIABLE_EX(double, D, name, external_name, val, txt)
 
 #define DEFINE_string_EX(name, external_name, val, txt)                     \
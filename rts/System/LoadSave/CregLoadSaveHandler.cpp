@@ -12,6 +12,7 @@
 #include "Game/GameVersion.h"
 #include "Game/GlobalUnsynced.h"
 #include "Game/WaitCommandsAI.h"
+#include "Game/Players/PlayerHandler.h"
 #include "Game/SelectedUnitsHandler.h"
 #include "Game/UI/Groups/GroupHandler.h"
 #include "Lua/LuaGaia.h"
@@ -40,6 +41,7 @@
 #include "Sim/Units/Scripts/NullUnitScript.h"
 #include "Sim/Weapons/PlasmaRepulser.h"
 #include "System/SafeUtil.h"
+#include "System/StringUtil.h"
 #include "System/Platform/errorhandler.h"
 #include "System/FileSystem/DataDirsAccess.h"
 #include "System/FileSystem/FileQueryFlags.h"
@@ -116,6 +118,28 @@ void CGameStateCollector::Serialize(creg::ISerializer* s)
 }
 
 
+class CPlayerStateCollector
+{
+	CR_DECLARE_STRUCT(CPlayerStateCollector)
+
+public:
+	CPlayerStateCollector() = default;
+
+	void Serialize(creg::ISerializer* s);
+};
+
+CR_BIND(CPlayerStateCollector, )
+CR_REG_METADATA(CPlayerStateCollector, (
+	CR_SERIALIZER(Serialize)
+))
+
+
+void CPlayerStateCollector::Serialize(creg::ISerializer* s)
+{
+	s->SerializeObjectInstance(&playerHandler, playerHandler.GetClass());
+}
+
+
 class CLuaStateCollector
 {
 	CR_DECLARE_STRUCT(CLuaStateCollector)
@@ -251,18 +275,21 @@ static void LoadLuaState(CSplitLuaHandle* handle, creg::CInputStreamSerializer&
 }
 
 
-void CCregLoadSaveHandler::SaveGame(const std::string& path)
+bool CCregLoadSaveHandler::SaveState(std::stringstream& oss, bool snapshot)
 {
 #ifdef USING_CREG
-	LOG("[LSH::%s] saving game to \"%s\"", __func__, path.c_str());
+	// snapshots are taken on behalf of a rejoining player, restore our own selection afterwards
+	const std::vector<int> selectedUnitIDs = snapshot?
+		std::vector<int>(selectedUnitsHandler.selectedUnits.begin(), selectedUnitsHandler.selectedUnits.end()):
+		std::vector<int>();
 
 	// NB: Selection leaves CObject reference as Unit's listener,
 	//     But isn't serialized - leak on load.
 	selectedUnitsHandler.ClearSelected();
 
-	try {
-		std::stringstream oss;
+	bool ret = false;
 
+	try {
 		// write our own header. SavePackage() will add its own
 		WriteString(oss, SpringVersion::GetSync());
 		WriteString(oss, gameSetup->setupText);
@@ -287,13 +314,20 @@ void CCregLoadSaveHandler::SaveGame(const std::string& path)
 			os.SavePackage(&oss, &gsc, gsc.GetClass());
 			PrintSize("Game", ((int)oss.tellp()) - gameStart);
 
+			if (snapshot) {
+				CPlayerStateCollector psc;
+				os.SavePackage(&oss, &psc, psc.GetClass());
+			}
+
 
-			// save AI state
+			// save AI state; AIs only run on their host, the snapshot taker has no data for remote ones
 			const int aiStart = oss.tellp();
 
 			for (const auto& ai: skirmishAIHandler.GetAllSkirmishAIs()) {
 				std::stringstream aiData;
-				eoh->Save(&aiData, ai.first);
+
+				if (!snapshot)
+					eoh->Save(&aiData, ai.first);
 
 				std::uint64_t aiSize = aiData.tellp();
 				creg::WriteUInt(&oss, aiSize);
@@ -303,27 +337,7 @@ void CCregLoadSaveHandler::SaveGame(const std::string& path)
 			PrintSize("AIs", ((int)oss.tellp()) - aiStart);
 		}
 
-		{
-			gzFile file = gzopen(dataDirsAccess.LocateFile(path, FileQueryFlags::WRITE).c_str(), "wb5");
-
-			if (file == nullptr) {
-				LOG_L(L_ERROR, "[LSH::%s] could not open save-file", __func__);
-				return;
-			}
-
-			std::string data = oss.str();
-			std::function<void(gzFile, std::string&&)> func = [](gzFile file, std::string&& data) {
-				gzwrite(file, data.c_str(), data.size());
-				gzflush(file, Z_FINISH);
-				gzclose(file);
-			};
-
-			// gzFile is just a plain typedef (struct gzFile_s {}* gzFile), can be copied
-			// need to keep a reference to the future around or its destructor will block
-			ThreadPool::AddExtJob(std::move(std::async(std::launch::async, std::move(func), file, std::move(data))));
-		}
-
-		//FIXME add lua state
+		ret = true;
 	} catch (const content_error& ex) {
 		LOG_L(L_ERROR, "[LSH::%s] content error \"%s\"", __func__, ex.what());
 	} catch (const std::exception& ex) {
@@ -335,48 +349,127 @@ void CCregLoadSaveHandler::SaveGame(const std::string& path)
 	} catch (...) {
 		LOG_L(L_ERROR, "[LSH::%s] unknown error", __func__);
 	}
+
+	for (const int unitID: selectedUnitIDs) {
+		CUnit* unit = unitHandler.GetUnit(unitID);
+
+		if (unit != nullptr)
+			selectedUnitsHandler.AddUnit(unit);
+	}
+
+	return ret;
 #else //USING_CREG
 	LOG_L(L_ERROR, "[LSH::%s] creg is disabled", __func__);
+	return false;
 #endif //USING_CREG
 }
 
-/// loads the data (map&mod-name,setup-script) needed by PreGame
-bool CCregLoadSaveHandler::LoadGameStartInfo(const std::string& path)
+
+void CCregLoadSaveHandler::SaveGame(const std::string& path)
 {
-	CGZFileHandler saveFile(dataDirsAccess.LocateFile(FindSaveFile(path)), SPRING_VFS_RAW_FIRST);
+	LOG("[LSH::%s] saving game to \"%s\"", __func__, path.c_str());
 
-	std::stringbuf* sbuf = iss.rdbuf();
+	std::stringstream oss;
+
+	if (!SaveState(oss, false))
+		return;
+
+	gzFile file = gzopen(dataDirsAccess.LocateFile(path, FileQueryFlags::WRITE).c_str(), "wb5");
+
+	if (file == nullptr) {
+		LOG_L(L_ERROR, "[LSH::%s] could not open save-file", __func__);
+		return;
+	}
+
+	// move the buffer out instead of copying it, late-game saves can be huge
+	std::string data = std::move(oss).str();
+	std::function<void(gzFile, std::string&&)> func = [](gzFile file, std::string&& data) {
+		gzwrite(file, data.c_str(), data.size());
+		gzflush(file, Z_FINISH);
+		gzclose(file);
+	};
+
+	// gzFile is just a plain typedef (struct gzFile_s {}* gzFile), can be copied
+	// need to keep a reference to the future around or its destructor will block
+	ThreadPool::AddExtJob(std::move(std::async(std::launch::async, std::move(func), file, std::move(data))));
+}
+
+
+std::vector<std::uint8_t> CCregLoadSaveHandler::SaveSnapshot()
+{
+	std::stringstream oss;
+
+	SaveInfo(gameSetup->mapName, gameSetup->modName);
+
+	if (!SaveState(oss, true))
+		return {};
+
+	const std::string data = std::move(oss).str();
+	return (zlib::deflate(reinterpret_cast<const std::uint8_t*>(data.data()), data.size()));
+}
+
+bool CCregLoadSaveHandler::LoadSnapshot(const std::vector<std::uint8_t>& data)
+{
+	const std::vector<std::uint8_t> buffer = zlib::inflate(data);
+
+	if (buffer.empty())
+		return false;
+
+	iss.rdbuf()->sputn(reinterpret_cast<const char*>(buffer.data()), buffer.size());
+	isSnapshot = true;
+
+	// unlike saves, a snapshot from an incompatible engine can not be loaded at all
+	return (ReadHeader("<snapshot>"));
+}
+
+
+bool CCregLoadSaveHandler::ReadHeader(const std::string& name)
+{
 	std::string saveVersion;
 	std::string syncVersion = SpringVersion::GetSync();
 
-	char buf[4096];
-	int len;
-	while ((len = saveFile.Read(buf, sizeof(buf))) > 0)
-		sbuf->sputn(buf, len);
-
 	ReadString(iss, saveVersion);
 
 	// check saved engine version against current build
 	// in general these will *not* be binary-compatible
 	// (so prefer to terminate loading from PreGame)
 	if (saveVersion != syncVersion)
-		LOG_L(L_WARNING, "[LSH::%s][release=%d] file \"%s\" saved by engine version \"%s\" incompatible with \"%s\"", __func__, SpringVersion::IsRelease(), path.c_str(), saveVersion.c_str(), syncVersion.c_str());
+		LOG_L(L_WARNING, "[LSH::%s][release=%d] file \"%s\" saved by engine version \"%s\" incompatible with \"%s\"", __func__, SpringVersion::IsRelease(), name.c_str(), saveVersion.c_str(), syncVersion.c_str());
 
 	// read our own header
 	ReadString(iss, scriptText);
 	ReadString(iss, modName);
 	ReadString(iss, mapName);
 
-	CGameSetup::LoadSavedScript(path, scriptText);
 	return (saveVersion == syncVersion);
 }
 
+/// loads the data (map&mod-name,setup-script) needed by PreGame
+bool CCregLoadSaveHandler::LoadGameStartInfo(const std::string& path)
+{
+	CGZFileHandler saveFile(dataDirsAccess.LocateFile(FindSaveFile(path)), SPRING_VFS_RAW_FIRST);
+
+	std::stringbuf* sbuf = iss.rdbuf();
+
+	char buf[4096];
+	int len;
+	while ((len = saveFile.Read(buf, sizeof(buf))) > 0)
+		sbuf->sputn(buf, len);
+
+	const bool ret = ReadHeader(path);
+
+	CGameSetup::LoadSavedScript(path, scriptText);
+	return ret;
+}
+
 /// this should be called on frame 0 when the game has started
 void CCregLoadSaveHandler::LoadGame()
 {
 #ifdef USING_CREG
 	ENTER_SYNCED_CODE();
 	{
+		const int myPlayerNum = gu->myPlayerNum;
+
 		Sim::LoadComponents(iss);
 
 		creg::CInputStreamSerializer inputStream;
@@ -395,6 +488,24 @@ void CCregLoadSaveHandler::LoadGame()
 		// the only job of gsc is to collect gamestate data
 		CGameStateCollector* gsc = static_cast<CGameStateCollector*>(pGSC);
 		spring::SafeDelete(gsc);
+
+		if (isSnapshot) {
+			void* pPSC = nullptr;
+			creg::Class* psccls = nullptr;
+
+			inputStream.LoadPackage(&iss, pPSC, psccls);
+			assert(pPSC && psccls == CPlayerStateCollector::StaticClass());
+
+			CPlayerStateCollector* psc = static_cast<CPlayerStateCollector*>(pPSC);
+			spring::SafeDelete(psc);
+
+			for (int i = 0; i < playerHandler.ActivePlayers(); i++) {
+				playerHandler.Player(i)->fpsController.SetControllerPlayer(playerHandler.Player(i));
+			}
+
+			// gu was overwritten with the snapshot taker's view
+			gu->SetMyPlayer(myPlayerNum);
+		}
 	}
 
 	LEAVE_SYNCED_CODE();
@@ -425,6 +536,12 @@ void CCregLoadSaveHandler::LoadAIData()
 	// cleanup
 	iss.str("");
 
+	// snapshots continue where the game is, paused or not
+	if (isSnapshot) {
+		LEAVE_SYNCED_CODE();
+		return;
+	}
+
 	gs->paused = false;
 	if (gameServer != nullptr) {
 		gameServer->isPaused = false;
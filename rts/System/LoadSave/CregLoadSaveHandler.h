@@ -3,8 +3,10 @@
 #ifndef CREG_LOAD_SAVE_HANDLER_H
 #define CREG_LOAD_SAVE_HANDLER_H
 
+#include <cstdint>
 #include <string>
 #include <sstream>
+#include <vector>
 #include "LoadSaveHandler.h"
 
 class CCregLoadSaveHandler : public ILoadSaveHandler
@@ -18,8 +20,23 @@ public:
 	void LoadAIData() override;
 	void SaveGame(const std::string& path) override;
 
+	/**
+	 * Rejoin snapshots are regular saves kept in memory, plus the player
+	 * state (which saves take from the start-script instead) and without
+	 * AI data. LoadSnapshot replaces LoadGameStartInfo; the setup-script
+	 * is the one received from the server.
+	 */
+	std::vector<std::uint8_t> SaveSnapshot();
+	bool LoadSnapshot(const std::vector<std::uint8_t>& data);
+
+protected:
+	bool SaveState(std::stringstream& oss, bool snapshot);
+	bool ReadHeader(const std::string& name);
+
 protected:
 	std::stringstream iss;
+
+	bool isSnapshot = false;
 };
 
 #endif // CREG_LOAD_SAVE_HANDLER_H
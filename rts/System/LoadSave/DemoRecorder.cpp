@@ -1,9 +1,11 @@
 /* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
 
+#include <atomic>
 #include <cassert>
 #include <cerrno>
 #include <cstring>
 #include <memory>
+#include <zlib.h>
 
 #include "DemoRecorder.h"
 #include "base64.h"
@@ -27,11 +29,87 @@
 #endif
 
 
-// server and client memory-streams
+// uncompressed data is handed to the pool in blocks of this size
+static constexpr size_t DEMO_BLOCK_SIZE = 1024 * 1024;
+// bounds the memory held by blocks that still await compression
+static constexpr size_t MAX_PENDING_BLOCKS = 4;
+
+// server and client memory-streams (data of the current block)
 static std::string demoStreams[2];
 static spring::mutex demoMutex;
 
 
+// compresses <size> bytes into a single self-contained gzip member; members
+// can be concatenated, gzread and CGZFileHandler read them as one stream
+static std::string CompressMember(const char* data, size_t size, int level)
+{
+	std::string buf;
+	z_stream strm;
+
+	memset(&strm, 0, sizeof(strm));
+	deflateInit2(&strm, level, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY);
+
+	buf.resize(deflateBound(&strm, size) + 32);
+
+	strm.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data));
+	strm.avail_in = size;
+
+	while (true) {
+		strm.next_out = reinterpret_cast<Bytef*>(&buf[strm.total_out]);
+		strm.avail_out = buf.size() - strm.total_out;
+
+		if (deflate(&strm, Z_FINISH) == Z_STREAM_END)
+			break;
+
+		buf.resize(buf.size() * 2);
+	}
+
+	buf.resize(strm.total_out);
+	deflateEnd(&strm);
+	return buf;
+}
+
+
+struct DemoBlock {
+public:
+	// runs on a pool thread, or on the owner's if no worker claimed it yet
+	void Compress() {
+		int expected = STATE_QUEUED;
+
+		if (!state.compare_exchange_strong(expected, STATE_COMPRESSING))
+			return;
+
+		compressed = CompressMember(data.data(), data.size(), 9);
+		data = {};
+
+		state.store(STATE_DONE, std::memory_order_release);
+	}
+
+	const std::string& Finish() {
+		Compress();
+
+		while (!IsDone())
+			spring::this_thread::yield();
+
+		return compressed;
+	}
+
+	bool IsDone() const { return (state.load(std::memory_order_acquire) == STATE_DONE); }
+
+public:
+	enum {
+		STATE_QUEUED      = 0,
+		STATE_COMPRESSING = 1,
+		STATE_DONE        = 2,
+	};
+
+	std::string data;
+	std::string compressed;
+
+	std::atomic<int> state = {STATE_QUEUED};
+};
+
+
 CDemoRecorder::CDemoRecorder(const std::string& mapName, const std::string& modName, bool serverDemo): isServerDemo(serverDemo)
 {
 	std::lock_guard<spring::mutex> lock(demoMutex);
@@ -39,9 +117,11 @@ CDemoRecorder::CDemoRecorder(const std::string& mapName, const std::string& modN
 	SetStream();
 	SetName(mapName, modName);
 	SetFileHeader();
-	WriteFileHeader(false);
 
-	file = gzopen(demoName.c_str(), "wb9");
+	if ((file = fopen(demoName.c_str(), "wb")) == nullptr)
+		return;
+
+	WriteFileHeader(false);
 }
 
 CDemoRecorder::~CDemoRecorder()
@@ -60,7 +140,7 @@ CDemoRecorder::~CDemoRecorder()
 void CDemoRecorder::SetStream()
 {
 	demoStreams[isServerDemo].clear();
-	demoStreams[isServerDemo].reserve(8 * 1024 * 1024);
+	demoStreams[isServerDemo].reserve(DEMO_BLOCK_SIZE + 64 * 1024);
 }
 
 void CDemoRecorder::SetFileHeader()
@@ -79,29 +159,69 @@ void CDemoRecorder::SetFileHeader()
 
 void CDemoRecorder::WriteDemoFile()
 {
-	// zlib FAQ claims the lib is thread-safe, "however any library routines that zlib uses and
-	// any application-provided memory allocation routines must also be thread-safe. zlib's gz*
-	// functions use stdio library routines, and most of zlib's functions use the library memory
-	// allocation routines by default" (so code below should be OK)
-	// gz* should usually be finished before ctor runs again when reloading, but take no chances
-	std::string& data = demoStreams[isServerDemo];
-	std::function<void(gzFile, std::string&)> func = [](gzFile file, std::string& data) {
+	// the remaining data only consists of the last block and the stats, but
+	// writing it still has to wait for the blocks queued before it; do both
+	// on a separate thread so ending the game does not stall (workers might
+	// already be gone at this point, so queued blocks are finished inline)
+	// writes should usually be finished before ctor runs again when reloading, but take no chances
+	std::function<void(FILE*, std::deque< std::shared_ptr<DemoBlock> >, std::string)> func = [](FILE* file, std::deque< std::shared_ptr<DemoBlock> > blocks, std::string data) {
 		std::lock_guard<spring::mutex> lock(demoMutex);
 
-		gzwrite(file, data.c_str(), data.size());
-		gzflush(file, Z_FINISH);
-		gzclose(file);
+		for (const std::shared_ptr<DemoBlock>& block: blocks) {
+			const std::string& buf = block->Finish();
+			fwrite(buf.data(), buf.size(), 1, file);
+		}
+
+		const std::string buf = CompressMember(data.data(), data.size(), 9);
+
+		fwrite(buf.data(), buf.size(), 1, file);
+		fclose(file);
 	};
 
-	LOG("[DemoRecorder::%s] writing %s-demo \"%s\" (" _STPF_ " bytes)", __func__, (isServerDemo? "server": "client"), demoName.c_str(), data.size());
+	LOG("[DemoRecorder::%s] writing %s-demo \"%s\" (%d bytes)", __func__, (isServerDemo? "server": "client"), demoName.c_str(), fileHeader.demoStreamSize);
+
+	std::string data = std::move(demoStreams[isServerDemo]);
 
 	#ifndef _WIN32
 	// NOTE: can not use ThreadPool for this directly here, workers are already gone
 	// FIXME: does not currently (august 2017) compile on Windows mingw buildbots
-	ThreadPool::AddExtJob(spring::thread(std::move(func), file, std::ref(data)));
+	ThreadPool::AddExtJob(spring::thread(std::move(func), file, std::move(pendingBlocks), std::move(data)));
 	#else
-	ThreadPool::AddExtJob(std::move(std::async(std::launch::async, std::move(func), file, std::ref(data))));
+	ThreadPool::AddExtJob(std::move(std::async(std::launch::async, std::move(func), file, std::move(pendingBlocks), std::move(data))));
 	#endif
+
+	demoStreams[isServerDemo].clear();
+	pendingBlocks.clear();
+	file = nullptr;
+}
+
+void CDemoRecorder::FlushBlock()
+{
+	std::shared_ptr<DemoBlock> block = std::make_shared<DemoBlock>();
+
+	std::swap(block->data, demoStreams[isServerDemo]);
+	SetStream();
+
+	pendingBlocks.push_back(block);
+	ThreadPool::Enqueue([block]() { block->Compress(); });
+
+	WriteBlocks(MAX_PENDING_BLOCKS);
+}
+
+void CDemoRecorder::WriteBlocks(size_t maxPending)
+{
+	// blocks have to be appended in order, a finished one waits for all before it
+	while (!pendingBlocks.empty()) {
+		const std::shared_ptr<DemoBlock>& block = pendingBlocks.front();
+
+		if (!block->IsDone() && pendingBlocks.size() <= maxPending)
+			break;
+
+		const std::string& buf = block->Finish();
+
+		fwrite(buf.data(), buf.size(), 1, file);
+		pendingBlocks.pop_front();
+	}
 }
 
 void CDemoRecorder::WriteSetupText(const std::string& text)
@@ -133,6 +253,9 @@ void CDemoRecorder::SaveToDemo(const unsigned char* buf, const unsigned length,
 	demoStreams[isServerDemo].append(reinterpret_cast<const char*>(&chunkHeader), sizeof(chunkHeader));
 	demoStreams[isServerDemo].append(reinterpret_cast<const char*>(buf), length);
 	fileHeader.demoStreamSize += (length + sizeof(chunkHeader));
+
+	if (file != nullptr && demoStreams[isServerDemo].size() >= DEMO_BLOCK_SIZE)
+		FlushBlock();
 }
 
 void CDemoRecorder::SetName(const std::string& mapName, const std::string& modName)
@@ -207,17 +330,24 @@ void CDemoRecorder::SetPlayerStats(int playerNum, const PlayerStatistics& stats)
 	playerStats[playerNum] = stats;
 }
 
-/** @brief Set (overwrite) the TeamStatistics history for team teamNum */
+/**
+ * @brief Set the TeamStatistics history for team teamNum
+ *
+ * Can be called repeatedly while the game runs; all entries but the newest
+ * (which is still being accumulated) are final, so only that one and those
+ * added since the previous call are copied.
+ */
 void CDemoRecorder::SetTeamStats(int teamNum, const std::vector<TeamStatistics>& stats)
 {
-	assert((unsigned)teamNum < teamStats.size()); //FIXME
+	if (teamNum >= teamStats.size())
+		teamStats.resize(teamNum + 1);
 
-	teamStats[teamNum].clear();
-	teamStats[teamNum].reserve(stats.size());
+	std::vector<TeamStatistics>& history = teamStats[teamNum];
 
-	for (const auto& stat: stats) {
-		teamStats[teamNum].push_back(stat);
-	}
+	if (!history.empty())
+		history.pop_back();
+
+	history.insert(history.end(), stats.begin() + std::min(history.size(), stats.size()), stats.end());
 }
 
 
@@ -230,7 +360,9 @@ void CDemoRecorder::SetWinningAllyTeams(const std::vector<unsigned char>& winnin
 
 /** @brief Write DemoFileHeader
 Write the DemoFileHeader at the start of the file and restores the original
-position in the file afterwards. */
+position in the file afterwards. The header is stored uncompressed in its own
+gzip member, which always has the same size and can therefore be overwritten
+after the blocks following it were appended. */
 unsigned int CDemoRecorder::WriteFileHeader(bool updateStreamLength)
 {
 	DemoFileHeader tmpHeader;
@@ -242,14 +374,19 @@ unsigned int CDemoRecorder::WriteFileHeader(bool updateStreamLength)
 	// to little endian
 	tmpHeader.swab();
 
-	if (demoStreams[isServerDemo].empty()) {
-		demoStreams[isServerDemo].append(reinterpret_cast<const char*>(&tmpHeader), sizeof(tmpHeader));
-	} else {
-		assert(demoStreams[isServerDemo].size() >= sizeof(tmpHeader));
-		memcpy(&demoStreams[isServerDemo][0], reinterpret_cast<const char*>(&tmpHeader), sizeof(tmpHeader)); // no non-const .data() until C++17
-	}
+	if (file == nullptr)
+		return 0;
+
+	const std::string buf = CompressMember(reinterpret_cast<const char*>(&tmpHeader), sizeof(tmpHeader), Z_NO_COMPRESSION);
+	const long pos = ftell(file);
 
-	return (demoStreams[isServerDemo].size());
+	fseek(file, 0, SEEK_SET);
+	fwrite(buf.data(), buf.size(), 1, file);
+
+	if (pos > 0)
+		fseek(file, pos, SEEK_SET);
+
+	return (buf.size());
 }
 
 /** @brief Write the CPlayer::Statistics at the current position in the file. */
@@ -293,6 +430,10 @@ void CDemoRecorder::WriteTeamStats()
 {
 	const size_t pos = demoStreams[isServerDemo].size();
 
+	// history may have been recorded for a game that never ended, in which
+	// case InitializeStats was not called and no teams are in the header
+	teamStats.resize(fileHeader.numTeams);
+
 	// Write array of dwords indicating number of TeamStatistics per team.
 	for (std::vector<TeamStatistics>& history: teamStats) {
 		unsigned int c = swabDWord(history.size());
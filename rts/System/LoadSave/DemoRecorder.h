@@ -3,17 +3,26 @@
 #ifndef DEMO_RECORDER
 #define DEMO_RECORDER
 
+#include <cstdio>
+#include <deque>
+#include <memory>
 #include <vector>
 #include <sstream>
-#include <zlib.h>
 
 #include "Demo.h"
 #include "Game/Players/PlayerStatistics.h"
 #include "Sim/Misc/TeamStatistics.h"
 
 
+struct DemoBlock;
+
 /**
  * @brief Used to record demos
+ *
+ * The file is streamed as a sequence of gzip members: the header goes into
+ * an uncompressed member of fixed size (so it can be rewritten in place) and
+ * the remaining data is cut into blocks which are compressed by the thread
+ * pool and appended in order.
  */
 class CDemoRecorder : public CDemo
 {
@@ -33,6 +42,7 @@ public:
 		memset(&r.fileHeader, 0, sizeof(fileHeader));
 
 		std::swap(file, r.file);
+		std::swap(pendingBlocks, r.pendingBlocks);
 
 		std::swap(demoName, r.demoName);
 		std::swap(playerStats, r.playerStats);
@@ -70,8 +80,14 @@ private:
 	void WriteWinnerList();
 	void WriteDemoFile();
 
+	void FlushBlock();
+	void WriteBlocks(size_t maxPending);
+
 private:
-	gzFile file = nullptr;
+	FILE* file = nullptr;
+
+	// blocks handed to the thread pool but not yet written, oldest first
+	std::deque< std::shared_ptr<DemoBlock> > pendingBlocks;
 
 	std::vector<PlayerStatistics> playerStats;
 	std::vector< std::vector<TeamStatistics> > teamStats;
@@ -10,9 +10,16 @@
 
 #include <cassert>
 #include <cstdio>
+#include <cstring>
 #include <string>
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
 #include <vector>
 
 
@@ -54,6 +61,9 @@ namespace log_file {
 	 */
 	bool validTracker = true;
 
+	/// lowest flush-level of any file, records at or above it wake the writer thread
+	int minFlushLevel = LOG_LEVEL_NONE;
+
 
 	/**
 	 * This class allows us to stop logging cleanly, when the application exits,
@@ -120,10 +130,7 @@ namespace log_file {
 		return (!getLogFiles().empty());
 	}
 
-	void writeToFile(FILE* outStream, const char* record, bool flush) {
-		char framePrefix[128] = {'\0'};
-		log_framePrefixer_createPrefix(framePrefix, sizeof(framePrefix));
-
+	void writeToFile(FILE* outStream, const char* framePrefix, const char* record, bool flush) {
 		FPRINTF(outStream, "%s%s\n", framePrefix, record);
 
 		if (flush)
@@ -132,19 +139,35 @@ namespace log_file {
 
 	/**
 	 * Writes to the individual log files, if they do want to log the section.
+	 * Returns true if any of them wanted the record flushed, without flushing
+	 * when deferFlush is set.
 	 */
-	void writeToFiles(int level, const char* section, const char* record)
+	bool writeToFiles(int level, const char* section, const char* framePrefix, const char* record, bool deferFlush = false)
 	{
 		const auto& logFiles = getLogFiles();
 
+		bool flush = false;
+
 		for (const auto& p: logFiles) {
 			if (!p.second.IsLogging(level, section))
 				continue;
 			if (p.second.GetOutStream() == nullptr)
 				continue;
 
-			writeToFile(p.second.GetOutStream(), record, p.second.FlushOnWrite(level));
+			flush |= p.second.FlushOnWrite(level);
+
+			writeToFile(p.second.GetOutStream(), framePrefix, record, p.second.FlushOnWrite(level) && !deferFlush);
 		}
+
+		return flush;
+	}
+
+	bool writeToFiles(int level, const char* section, const char* record)
+	{
+		char framePrefix[128] = {'\0'};
+		log_framePrefixer_createPrefix(framePrefix, sizeof(framePrefix));
+
+		return (writeToFiles(level, section, framePrefix, record));
 	}
 
 	/**
@@ -184,6 +207,249 @@ namespace log_file {
 
 		logRecords.emplace_back(level, section, record);
 	}
+
+
+	/**
+	 * Bounded lock-free queue of formatted records; any thread can push, only
+	 * the holder of the writer mutex pops. Records that do not fit (too many,
+	 * or too many bytes) are dropped and counted instead of blocking the
+	 * logging thread.
+	 */
+	class RecordQueue {
+	public:
+		static constexpr size_t NUM_SLOTS = 4096;
+		static constexpr size_t MAX_QUEUED_BYTES = 4 * 1024 * 1024;
+		// slots holding larger records give their memory back once written
+		static constexpr size_t MAX_SLOT_CAPACITY = 4096;
+
+		struct Slot {
+			std::atomic<size_t> seq = {0};
+
+			int level = 0;
+
+			std::string section;
+			std::string record; // frame-prefix included
+		};
+
+	public:
+		void Init() {
+			if (slots != nullptr)
+				return;
+
+			slots = std::make_unique<Slot[]>(NUM_SLOTS);
+
+			for (size_t i = 0; i < NUM_SLOTS; i++) {
+				slots[i].seq.store(i, std::memory_order_relaxed);
+			}
+		}
+
+		/// @return the number of records pushed so far, or 0 if this one was dropped
+		size_t Push(int level, const char* section, const char* framePrefix, const char* record) {
+			const size_t numBytes = strlen(framePrefix) + strlen(record);
+
+			if (queuedBytes.fetch_add(numBytes, std::memory_order_relaxed) + numBytes > MAX_QUEUED_BYTES) {
+				queuedBytes.fetch_sub(numBytes, std::memory_order_relaxed);
+				return 0;
+			}
+
+			size_t pos = pushPos.load(std::memory_order_relaxed);
+			Slot* slot = nullptr;
+
+			while (true) {
+				slot = &slots[pos % NUM_SLOTS];
+
+				const size_t seq = slot->seq.load(std::memory_order_acquire);
+
+				if (seq == pos) {
+					if (pushPos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+						break;
+
+					continue;
+				}
+
+				// slot still holds a record from the previous lap, queue is full
+				if (seq < pos) {
+					queuedBytes.fetch_sub(numBytes, std::memory_order_relaxed);
+					return 0;
+				}
+
+				pos = pushPos.load(std::memory_order_relaxed);
+			}
+
+			slot->level = level;
+			slot->section.assign(section);
+			slot->record.assign(framePrefix);
+			slot->record.append(record);
+			slot->seq.store(pos + 1, std::memory_order_release);
+			return (pos + 1);
+		}
+
+		template<typename F> size_t Pop(F&& func) {
+			size_t numPopped = 0;
+
+			while (slots != nullptr) {
+				Slot& slot = slots[popPos % NUM_SLOTS];
+
+				if (slot.seq.load(std::memory_order_acquire) != (popPos + 1))
+					break;
+
+				func(slot);
+
+				queuedBytes.fetch_sub(slot.record.size(), std::memory_order_relaxed);
+
+				if (slot.record.capacity() > MAX_SLOT_CAPACITY)
+					std::string().swap(slot.record);
+
+				slot.seq.store(popPos + NUM_SLOTS, std::memory_order_release);
+
+				popPos += 1;
+				numPopped += 1;
+			}
+
+			return numPopped;
+		}
+
+	private:
+		std::unique_ptr<Slot[]> slots;
+
+		std::atomic<size_t> pushPos = {0};
+		std::atomic<size_t> queuedBytes = {0};
+
+		// only touched with the writer mutex held
+		size_t popPos = 0;
+	};
+
+
+	/**
+	 * Moves file IO off the logging threads; records are queued by the sink
+	 * and written out in batches by a dedicated thread, which only flushes
+	 * once per batch. Cleanup (which crash handlers call) and requests for
+	 * a raw stream write everything still queued synchronously.
+	 */
+	struct LogFileWriter {
+	public:
+		~LogFileWriter() { Stop(); }
+
+		void Start() {
+			if (IsActive())
+				return;
+
+			// thread might still be around after StopAsync
+			Stop();
+
+			queue.Init();
+
+			quit.store(false);
+			active.store(true);
+
+			thread = std::thread(&LogFileWriter::WriteLoop, this);
+		}
+
+		void Stop() {
+			StopAsync();
+
+			if (!thread.joinable())
+				return;
+
+			thread.join();
+			thread = {};
+		}
+
+		/// routes subsequent records through the synchronous path, without joining
+		void StopAsync() {
+			if (!active.exchange(false))
+				return;
+
+			quit.store(true);
+			cond.notify_one();
+
+			WriteQueued();
+		}
+
+		bool IsActive() const { return active.load(std::memory_order_relaxed); }
+
+		void Push(int level, const char* section, const char* record, bool flush) {
+			char framePrefix[128] = {'\0'};
+			log_framePrefixer_createPrefix(framePrefix, sizeof(framePrefix));
+
+			const size_t numPushed = queue.Push(level, section, framePrefix, record);
+
+			if (numPushed == 0) {
+				numDropped.fetch_add(1, std::memory_order_relaxed);
+				flush = true;
+			}
+
+			// also wake the writer early under heavy spam, before the queue fills up
+			if (flush || (numPushed % (RecordQueue::NUM_SLOTS / 4)) == 0)
+				cond.notify_one();
+		}
+
+		/// writes out all queued records; gives up if the writer mutex is not obtainable
+		void WriteQueued() {
+			std::unique_lock<std::mutex> lock(mutex, std::defer_lock);
+
+			// a crashed writer thread might never release it
+			for (int i = 0; i < 100 && !lock.try_lock(); i++) {
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			}
+
+			if (!lock.owns_lock())
+				return;
+
+			WriteBatch();
+		}
+
+	private:
+		void WriteLoop() {
+			std::unique_lock<std::mutex> lock(mutex);
+
+			while (!quit.load()) {
+				cond.wait_for(lock, std::chrono::milliseconds(50));
+				WriteBatch();
+			}
+
+			WriteBatch();
+		}
+
+		/// mutex must be held
+		void WriteBatch() {
+			bool flush = false;
+
+			queue.Pop([&](const RecordQueue::Slot& slot) {
+				flush |= writeToFiles(slot.level, slot.section.c_str(), "", slot.record.c_str(), true);
+			});
+
+			if (const size_t dropped = numDropped.exchange(0, std::memory_order_relaxed); dropped > 0) {
+				char framePrefix[128] = {'\0'};
+				char record[128] = {'\0'};
+
+				log_framePrefixer_createPrefix(framePrefix, sizeof(framePrefix));
+				SNPRINTF(record, sizeof(record), "[LogFileWriter] dropped %u log records (queue full)", static_cast<unsigned int>(dropped));
+
+				flush |= writeToFiles(LOG_LEVEL_WARNING, LOG_SECTION_DEFAULT, framePrefix, record, true);
+			}
+
+			if (flush)
+				flushFiles();
+		}
+
+	private:
+		RecordQueue queue;
+
+		// plain std types, the sink does not depend on the engine's threading code
+		std::thread thread;
+		std::mutex mutex;
+		std::condition_variable cond;
+
+		std::atomic<size_t> numDropped = {0};
+
+		std::atomic<bool> active = {false};
+		std::atomic<bool> quit = {true};
+	};
+
+
+	// not a function-local static; has to outlive LogFilesContainer, which stops it
+	LogFileWriter logFileWriter;
 }
 
 
@@ -199,6 +465,9 @@ void log_file_addLogFile(
 ) {
 	assert(filePath != nullptr);
 
+	// the writer thread iterates the files without locking
+	log_file::logFileWriter.Stop();
+
 	auto& logFiles = log_file::getLogFiles();
 
 	const std::string sectionsStr = (sections == nullptr) ? "" : sections;
@@ -222,6 +491,8 @@ void log_file_addLogFile(
 
 	logFiles.emplace_back(filePathStr, log_file::LogFileDetails(tmpStream, sectionsStr, minLevel, flushLevel));
 
+	log_file::minFlushLevel = std::min(log_file::minFlushLevel, flushLevel);
+
 	// swap into position; only a handful of files are ever added
 	for (size_t i = logFiles.size() - 1; i > 0; i--) {
 		if (logFiles[i - 1].first < logFiles[i].first)
@@ -234,6 +505,8 @@ void log_file_addLogFile(
 void log_file_removeLogFile(const char* filePath) {
 	assert(filePath != nullptr);
 
+	log_file::logFileWriter.Stop();
+
 	auto& logFiles = log_file::getLogFiles();
 
 	const auto pred = [](const log_file::LogFilePair& a, const log_file::LogFilePair& b) { return (a.first < b.first); };
@@ -256,6 +529,8 @@ void log_file_removeLogFile(const char* filePath) {
 }
 
 void log_file_removeAllLogFiles() {
+	log_file::logFileWriter.Stop();
+
 	auto& logFiles = log_file::getLogFiles();
 
 	for (auto& logFilePair: logFiles) {
@@ -266,7 +541,24 @@ void log_file_removeAllLogFiles() {
 }
 
 
+void log_file_startWriterThread() {
+	if (!log_file::isActivelyLogging())
+		return;
+
+	// anything buffered before the first file was added goes out first
+	log_file::writeBufferToFiles();
+	log_file::logFileWriter.Start();
+}
+
+void log_file_stopWriterThread() {
+	log_file::logFileWriter.Stop();
+}
+
+
 FILE* log_file_getLogFileStream(const char* filePath) {
+	// callers write to the stream directly, keep the order of their output
+	log_file::logFileWriter.StopAsync();
+
 	const auto& logFiles = log_file::getLogFiles();
 
 	for (const auto& p: logFiles) {
@@ -290,6 +582,11 @@ FILE* log_file_getLogFileStream(const char* filePath) {
 /// Records a log entry
 static void log_sink_record_file(int level, const char* section, const char* record)
 {
+	if (log_file::logFileWriter.IsActive()) {
+		log_file::logFileWriter.Push(level, section, record, level >= log_file::minFlushLevel);
+		return;
+	}
+
 	if (log_file::validTracker && log_file::isActivelyLogging()) {
 		// write buffer to log file
 		log_file::writeBufferToFiles();
@@ -307,6 +604,10 @@ static void log_sink_cleanup_file() {
 	if (!log_file::isActivelyLogging())
 		return;
 
+	// write out whatever the writer thread did not get to yet
+	if (log_file::logFileWriter.IsActive())
+		log_file::logFileWriter.WriteQueued();
+
 	// flush the log buffers to files
 	log_file::flushFiles();
 }
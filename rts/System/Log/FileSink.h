@@ -35,6 +35,21 @@ extern "C" {
 void log_file_addLogFile(const char* filePath, const char* sections = NULL,
 		int minLevel = LOG_LEVEL_ALL, int flushLevel = LOG_LEVEL_ERROR);
 
+/**
+ * Moves writing to the log files onto a dedicated thread, which writes the
+ * queued records in batches. Logging threads never wait for disk IO; when
+ * the queue is full records are dropped, and their number is logged.
+ * Adding or removing log files stops the thread again.
+ * Cleanup (LOG_CLEANUP) still writes out everything queued synchronously.
+ */
+void log_file_startWriterThread();
+void log_file_stopWriterThread();
+
+/**
+ * Returns the stream of a log file, for writing to it directly.
+ * Records still queued for the writer thread are written out first, and
+ * later ones synchronously.
+ */
 FILE* log_file_getLogFileStream(const char* filePath);
 
 void log_file_removeLogFile(const char* filePath);
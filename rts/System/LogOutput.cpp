@@ -40,6 +40,10 @@ CONFIG(int, LogFlushLevel)
 	.defaultValue(LOG_LEVEL_ERROR)
 	.description("Flush the logfile when a message's level exceeds this value. ERROR is flushed by default, WARNING is not.");
 
+CONFIG(bool, LogAsyncWrites)
+	.defaultValue(true)
+	.description("Write the logfile from a dedicated thread, so logging never waits for the disk. Records are dropped (and counted) when too many queue up.");
+
 CONFIG(int, LogRepeatLimit)
 	.defaultValue(0)
 	.description("Allow at most this many consecutive identical messages to be logged. Set to 0 to disable the limit.");
@@ -174,6 +178,9 @@ void CLogOutput::Initialize()
 	log_filter_setRepeatLimit(configHandler->GetInt("LogRepeatLimit")); // all sinks
 	log_file_addLogFile(filePath.c_str(), nullptr, LOG_LEVEL_ALL, configHandler->GetInt("LogFlushLevel"));
 
+	if (configHandler->GetBool("LogAsyncWrites"))
+		log_file_startWriterThread();
+
 	LOG("LogOutput initialized. Logging to %s", filePath.c_str());
 }
 
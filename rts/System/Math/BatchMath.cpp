@@ -0,0 +1,202 @@
+/* This file is part of the Recoil engine (GPL v2 or later), see LICENSE.html */
+
+#include "BatchMath.h"
+
+#include <algorithm>
+
+#include <xmmintrin.h>
+#include <emmintrin.h>
+
+#include "System/MainDefines.h"
+
+// Cephes single precision constants
+static constexpr float FOPI = 1.27323954473516f; // 4/PI
+static constexpr float PI = 3.14159265358979f;
+static constexpr float PIO2 = 1.57079632679490f;
+static constexpr float PIO4 = 0.785398163397448f;
+static constexpr float TAN_PIO8 = 0.414213562373095f;
+
+static constexpr float DP1 = 0.78515625f;
+static constexpr float DP2 = 2.4187564849853515625e-4f;
+static constexpr float DP3 = 3.77489497744594108e-8f;
+
+static constexpr float SINCOF_P0 = -1.9515295891e-4f;
+static constexpr float SINCOF_P1 =  8.3321608736e-3f;
+static constexpr float SINCOF_P2 = -1.6666654611e-1f;
+
+static constexpr float COSCOF_P0 =  2.443315711809948e-5f;
+static constexpr float COSCOF_P1 = -1.388731625493765e-3f;
+static constexpr float COSCOF_P2 =  4.166664568298827e-2f;
+
+static constexpr float ATANCOF_P0 =  8.05374449538e-2f;
+static constexpr float ATANCOF_P1 = -1.38776856032e-1f;
+static constexpr float ATANCOF_P2 =  1.99777106478e-1f;
+static constexpr float ATANCOF_P3 = -3.33329491539e-1f;
+
+
+static inline __m128 Select(__m128 mask, __m128 a, __m128 b) { return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b)); }
+static inline __m128 SignMask() { return _mm_castsi128_ps(_mm_set1_epi32(static_cast<int>(0x80000000u))); }
+
+
+__FORCE_ALIGN_STACK__
+static inline void SinCos4(__m128 x, __m128* sinOut, __m128* cosOut)
+{
+	const __m128 signMask = SignMask();
+	const __m128 sinSign = _mm_and_ps(x, signMask);
+
+	x = _mm_andnot_ps(signMask, x);
+
+	// octant, rounded up to even
+	__m128i j = _mm_cvttps_epi32(_mm_mul_ps(x, _mm_set1_ps(FOPI)));
+	j = _mm_add_epi32(j, _mm_set1_epi32(1));
+	j = _mm_and_si128(j, _mm_set1_epi32(~1));
+
+	const __m128 y = _mm_cvtepi32_ps(j);
+
+	// extended precision modular arithmetic
+	x = _mm_add_ps(x, _mm_mul_ps(y, _mm_set1_ps(-DP1)));
+	x = _mm_add_ps(x, _mm_mul_ps(y, _mm_set1_ps(-DP2)));
+	x = _mm_add_ps(x, _mm_mul_ps(y, _mm_set1_ps(-DP3)));
+
+	const __m128 z = _mm_mul_ps(x, x);
+
+	__m128 cosPoly = _mm_set1_ps(COSCOF_P0);
+	cosPoly = _mm_add_ps(_mm_mul_ps(cosPoly, z), _mm_set1_ps(COSCOF_P1));
+	cosPoly = _mm_add_ps(_mm_mul_ps(cosPoly, z), _mm_set1_ps(COSCOF_P2));
+	cosPoly = _mm_mul_ps(_mm_mul_ps(cosPoly, z), z);
+	cosPoly = _mm_sub_ps(cosPoly, _mm_mul_ps(z, _mm_set1_ps(0.5f)));
+	cosPoly = _mm_add_ps(cosPoly, _mm_set1_ps(1.0f));
+
+	__m128 sinPoly = _mm_set1_ps(SINCOF_P0);
+	sinPoly = _mm_add_ps(_mm_mul_ps(sinPoly, z), _mm_set1_ps(SINCOF_P1));
+	sinPoly = _mm_add_ps(_mm_mul_ps(sinPoly, z), _mm_set1_ps(SINCOF_P2));
+	sinPoly = _mm_mul_ps(_mm_mul_ps(sinPoly, z), x);
+	sinPoly = _mm_add_ps(sinPoly, x);
+
+	// octants 2 and 6 (after rounding) swap the polynomials
+	const __m128 polyMask = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(j, _mm_set1_epi32(2)), _mm_setzero_si128()));
+
+	const __m128 sinSwap = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(j, _mm_set1_epi32(4)), 29));
+	const __m128 cosSwap = _mm_castsi128_ps(_mm_slli_epi32(_mm_andnot_si128(_mm_sub_epi32(j, _mm_set1_epi32(2)), _mm_set1_epi32(4)), 29));
+
+	if (sinOut != nullptr)
+		*sinOut = _mm_xor_ps(Select(polyMask, sinPoly, cosPoly), _mm_xor_ps(sinSign, sinSwap));
+	if (cosOut != nullptr)
+		*cosOut = _mm_xor_ps(Select(polyMask, cosPoly, sinPoly), cosSwap);
+}
+
+__FORCE_ALIGN_STACK__
+static inline __m128 Atan2_4(__m128 y, __m128 x)
+{
+	const __m128 signMask = SignMask();
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 one = _mm_set1_ps(1.0f);
+
+	const __m128 ax = _mm_andnot_ps(signMask, x);
+	const __m128 ay = _mm_andnot_ps(signMask, y);
+
+	const __m128 mx = _mm_max_ps(ax, ay);
+	const __m128 mn = _mm_min_ps(ax, ay);
+
+	// ratio in [0, 1]; atan2(0, 0) becomes 0 instead of NaN
+	const __m128 a = _mm_andnot_ps(_mm_cmpeq_ps(mx, zero), _mm_div_ps(mn, mx));
+
+	const __m128 big = _mm_cmpgt_ps(a, _mm_set1_ps(TAN_PIO8));
+	const __m128 t = Select(big, _mm_div_ps(_mm_sub_ps(a, one), _mm_add_ps(a, one)), a);
+	const __m128 z = _mm_mul_ps(t, t);
+
+	__m128 r = _mm_set1_ps(ATANCOF_P0);
+	r = _mm_add_ps(_mm_mul_ps(r, z), _mm_set1_ps(ATANCOF_P1));
+	r = _mm_add_ps(_mm_mul_ps(r, z), _mm_set1_ps(ATANCOF_P2));
+	r = _mm_add_ps(_mm_mul_ps(r, z), _mm_set1_ps(ATANCOF_P3));
+	r = _mm_mul_ps(_mm_mul_ps(r, z), t);
+	r = _mm_add_ps(r, t);
+	r = _mm_add_ps(_mm_and_ps(big, _mm_set1_ps(PIO4)), r);
+
+	// unfold the octant
+	r = Select(_mm_cmpgt_ps(ay, ax), _mm_sub_ps(_mm_set1_ps(PIO2), r), r);
+	r = Select(_mm_cmplt_ps(x, zero), _mm_sub_ps(_mm_set1_ps(PI), r), r);
+	r = _mm_xor_ps(r, _mm_and_ps(_mm_cmplt_ps(y, zero), signMask));
+	return r;
+}
+
+__FORCE_ALIGN_STACK__
+static inline __m128 Sqrt4(__m128 x) { return _mm_sqrt_ps(x); }
+__FORCE_ALIGN_STACK__
+static inline __m128 ISqrt4(__m128 x) { return _mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(x)); }
+
+
+// runs func over groups of four; the tail is padded so it takes the same path
+template<typename F>
+static inline void Apply(const float* xs, float* out, size_t count, F&& func)
+{
+	size_t i = 0;
+
+	for (; (i + 4) <= count; i += 4) {
+		_mm_storeu_ps(out + i, func(_mm_loadu_ps(xs + i)));
+	}
+
+	if (i == count)
+		return;
+
+	float tmp[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+
+	std::copy(xs + i, xs + count, tmp);
+	_mm_storeu_ps(tmp, func(_mm_loadu_ps(tmp)));
+	std::copy(tmp, tmp + (count - i), out + i);
+}
+
+
+namespace batchmath {
+	void sqrt(const float* xs, float* out, size_t count) { Apply(xs, out, count, Sqrt4); }
+	void isqrt(const float* xs, float* out, size_t count) { Apply(xs, out, count, ISqrt4); }
+
+	void sin(const float* xs, float* out, size_t count) {
+		Apply(xs, out, count, [](__m128 x) { __m128 s; SinCos4(x, &s, nullptr); return s; });
+	}
+	void cos(const float* xs, float* out, size_t count) {
+		Apply(xs, out, count, [](__m128 x) { __m128 c; SinCos4(x, nullptr, &c); return c; });
+	}
+
+	void sincos(const float* xs, float* sins, float* coss, size_t count) {
+		size_t i = 0;
+
+		for (; (i + 4) <= count; i += 4) {
+			__m128 s;
+			__m128 c;
+
+			SinCos4(_mm_loadu_ps(xs + i), &s, &c);
+			_mm_storeu_ps(sins + i, s);
+			_mm_storeu_ps(coss + i, c);
+		}
+
+		for (; i < count; i++) {
+			// scalar overloads share the SIMD path
+			const float x = xs[i];
+
+			sins[i] = batchmath::sin(x);
+			coss[i] = batchmath::cos(x);
+		}
+	}
+
+	void atan2(const float* ys, const float* xs, float* out, size_t count) {
+		size_t i = 0;
+
+		for (; (i + 4) <= count; i += 4) {
+			_mm_storeu_ps(out + i, Atan2_4(_mm_loadu_ps(ys + i), _mm_loadu_ps(xs + i)));
+		}
+
+		for (; i < count; i++) {
+			out[i] = batchmath::atan2(ys[i], xs[i]);
+		}
+	}
+
+
+	float sqrt(float x) { return _mm_cvtss_f32(Sqrt4(_mm_set1_ps(x))); }
+	float isqrt(float x) { return _mm_cvtss_f32(ISqrt4(_mm_set1_ps(x))); }
+
+	float sin(float x) { __m128 s; SinCos4(_mm_set1_ps(x), &s, nullptr); return _mm_cvtss_f32(s); }
+	float cos(float x) { __m128 c; SinCos4(_mm_set1_ps(x), nullptr, &c); return _mm_cvtss_f32(c); }
+
+	float atan2(float y, float x) { return _mm_cvtss_f32(Atan2_4(_mm_set1_ps(y), _mm_set1_ps(x))); }
+}
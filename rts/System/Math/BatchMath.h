@@ -0,0 +1,42 @@
+/* This file is part of the Recoil engine (GPL v2 or later), see LICENSE.html */
+
+#pragma once
+
+#include <cstddef>
+
+/**
+ * @brief Sync-safe math over arrays of floats
+ *
+ * Every function only uses IEEE add, sub, mul, div and sqrt (no rcp/rsqrt
+ * estimates, no libm), and evaluates the same operations in the same order
+ * for each element, whether it ends up in a 4-wide SSE2 lane or in the
+ * scalar tail. Results therefore only depend on the input value, and are
+ * identical on every x86-64 CPU as long as the build does not contract
+ * multiplies and adds into FMA (which synced builds must not do anyway).
+ *
+ * The scalar overloads give the same results as the array versions, code
+ * mixing both stays consistent.
+ *
+ * sqrt and isqrt are correctly rounded (sqrt matches math::sqrt bit for
+ * bit; isqrt is 1/sqrt(x), more accurate than the approximation behind
+ * math::isqrt). sin, cos and atan2 use Cephes' single precision polynomials;
+ * they are within a few ulp of streflop but do not match it exactly.
+ * sin and cos expect |x| < 8192, atan2 expects finite inputs and returns
+ * 0 for atan2(0, 0).
+ */
+namespace batchmath {
+	void sqrt(const float* xs, float* out, size_t count);
+	void isqrt(const float* xs, float* out, size_t count);
+
+	void sin(const float* xs, float* out, size_t count);
+	void cos(const float* xs, float* out, size_t count);
+	void sincos(const float* xs, float* sins, float* coss, size_t count);
+
+	void atan2(const float* ys, const float* xs, float* out, size_t count);
+
+	float sqrt(float x);
+	float isqrt(float x);
+	float sin(float x);
+	float cos(float x);
+	float atan2(float y, float x);
+}
@@ -472,6 +472,50 @@ float4 CMatrix44f::operator* (const float4 v) const
 	#endif
 }
 
+__FORCE_ALIGN_STACK__
+void CMatrix44f::Mul(const float3* vs, float3* outs, size_t count) const
+{
+	const __m128 c0 = _mm_load_ps(&md[0][0]);
+	const __m128 c1 = _mm_load_ps(&md[1][0]);
+	const __m128 c2 = _mm_load_ps(&md[2][0]);
+	const __m128 c3 = _mm_load_ps(&md[3][0]);
+
+	for (size_t i = 0; i < count; i++) {
+		const float3 v = vs[i];
+
+		__m128 out;
+		out =                 _mm_mul_ps(c0, _mm_set1_ps(v.x)) ;
+		out = _mm_add_ps(out, _mm_mul_ps(c1, _mm_set1_ps(v.y)));
+		out = _mm_add_ps(out, _mm_mul_ps(c2, _mm_set1_ps(v.z)));
+		out = _mm_add_ps(out, _mm_mul_ps(c3, _mm_set1_ps(1.0f)));
+
+		const float* fout = reinterpret_cast<float*>(&out);
+		outs[i] = {fout[0], fout[1], fout[2]};
+	}
+}
+
+__FORCE_ALIGN_STACK__
+void CMatrix44f::Mul(const float4* vs, float4* outs, size_t count) const
+{
+	const __m128 c0 = _mm_load_ps(&md[0][0]);
+	const __m128 c1 = _mm_load_ps(&md[1][0]);
+	const __m128 c2 = _mm_load_ps(&md[2][0]);
+	const __m128 c3 = _mm_load_ps(&md[3][0]);
+
+	for (size_t i = 0; i < count; i++) {
+		const float4 v = vs[i];
+
+		__m128 out;
+		out =                 _mm_mul_ps(c0, _mm_set1_ps(v.x)) ;
+		out = _mm_add_ps(out, _mm_mul_ps(c1, _mm_set1_ps(v.y)));
+		out = _mm_add_ps(out, _mm_mul_ps(c2, _mm_set1_ps(v.z)));
+		out = _mm_add_ps(out, _mm_mul_ps(c3, _mm_set1_ps(v.w)));
+
+		const float* fout = reinterpret_cast<float*>(&out);
+		outs[i] = {fout[0], fout[1], fout[2], fout[3]};
+	}
+}
+
 
 void CMatrix44f::SetUpVector(const float3& up)
 {
@@ -607,17 +651,59 @@ static inline T CalculateCofactor(const T m[4][4], const int ei, const int ej)
 	}
 }
 
+// computes all 16 cofactors, one row (4 lanes) at a time; every lane does
+// the same multiplies and subtractions in the same order as the scalar
+// CalculateCofactor so results are bit-identical, as synced code needs
+__FORCE_ALIGN_STACK__
+static inline void CalculateCofactors(const float m[4][4], float cofac[4][4])
+{
+	#if 0
+	for (int i = 0; i < 4; i++) {
+		for (int j = 0; j < 4; j++) {
+			cofac[i][j] = CalculateCofactor(m, i, j);
+		}
+	}
+	#else
+	// per lane j, {a,b,c}j are the three columns other than j in ascending order
+	__m128 a[4];
+	__m128 b[4];
+	__m128 c[4];
+
+	for (int i = 0; i < 4; i++) {
+		const __m128 r = _mm_loadu_ps(&m[i][0]);
+
+		a[i] = _mm_shuffle_ps(r, r, _MM_SHUFFLE(0, 0, 0, 1));
+		b[i] = _mm_shuffle_ps(r, r, _MM_SHUFFLE(1, 1, 2, 2));
+		c[i] = _mm_shuffle_ps(r, r, _MM_SHUFFLE(2, 3, 3, 3));
+	}
+
+	// sign of the cofactor is (-1)^(i+j)
+	const __m128 evenSigns = _mm_castsi128_ps(_mm_set_epi32(0x80000000, 0, 0x80000000, 0));
+	const __m128  oddSigns = _mm_castsi128_ps(_mm_set_epi32(0, 0x80000000, 0, 0x80000000));
+
+	static constexpr int rows[4][3] = {{1, 2, 3}, {0, 2, 3}, {0, 1, 3}, {0, 1, 2}};
+
+	for (int i = 0; i < 4; i++) {
+		const int ai = rows[i][0];
+		const int bi = rows[i][1];
+		const int ci = rows[i][2];
+
+		const __m128 t0 = _mm_mul_ps(a[ai], _mm_sub_ps(_mm_mul_ps(b[bi], c[ci]), _mm_mul_ps(c[bi], b[ci])));
+		const __m128 t1 = _mm_mul_ps(b[ai], _mm_sub_ps(_mm_mul_ps(c[bi], a[ci]), _mm_mul_ps(a[bi], c[ci])));
+		const __m128 t2 = _mm_mul_ps(c[ai], _mm_sub_ps(_mm_mul_ps(a[bi], b[ci]), _mm_mul_ps(b[bi], a[ci])));
+
+		_mm_storeu_ps(&cofac[i][0], _mm_xor_ps(_mm_add_ps(_mm_add_ps(t0, t1), t2), ((i & 1) == 0)? evenSigns: oddSigns));
+	}
+	#endif
+}
+
 
 //! generalized inverse for non-orthonormal 4x4 matrices
 //! A^-1 = (1 / det(A)) (C^T)_{ij} = (1 / det(A)) C_{ji}
 bool CMatrix44f::InvertInPlace()
 {
 	float cofac[4][4];
-	for (int i = 0; i < 4; i++) {
-		for (int j = 0; j < 4; j++) {
-			cofac[i][j] = CalculateCofactor(md, i, j);
-		}
-	}
+	CalculateCofactors(md, cofac);
 
 	const float det =
 		(md[0][0] * cofac[0][0]) +
@@ -651,11 +737,7 @@ CMatrix44f CMatrix44f::Invert(bool* status) const
 	CMatrix44f mat;
 	CMatrix44f& cofac = mat;
 
-	for (int i = 0; i < 4; i++) {
-		for (int j = 0; j < 4; j++) {
-			cofac.md[i][j] = CalculateCofactor(md, i, j);
-		}
-	}
+	CalculateCofactors(md, cofac.md);
 
 	const float det =
 		(md[0][0] * cofac.md[0][0]) +
@@ -100,6 +100,10 @@ public:
 	float3 Mul(const float3 v) const { return ((*this) * v); }
 	float4 Mul(const float4 v) const { return ((*this) * v); }
 
+	/// batched point (w=1) and vector multiply, results identical to the single-element versions
+	void Mul(const float3* vs, float3* outs, size_t count) const;
+	void Mul(const float4* vs, float4* outs, size_t count) const;
+
 	/// approximately equal
 	bool equals(const CMatrix44f& rhs) const;
 
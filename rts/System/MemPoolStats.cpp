@@ -0,0 +1,109 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#include <algorithm>
+#include <deque>
+#include <string>
+
+#include "System/MemPoolStats.h"
+#include "System/FrameArena.h"
+#include "System/Log/ILog.h"
+#include "System/Misc/TracyDefs.h"
+
+namespace {
+	struct PoolEntry {
+		const char* name;
+
+		MemPoolRegistry::StatsFunc func;
+
+		// Tracy keys plots by pointer, entries live in a deque so these stay put
+		std::string livePlotName;
+		std::string reservedPlotName;
+
+		size_t peakBytes;
+	};
+
+	std::deque<PoolEntry>& GetEntries() {
+		static std::deque<PoolEntry> entries;
+		return entries;
+	}
+	std::vector<MemPoolStats>& GetStatsCache() {
+		static std::vector<MemPoolStats> stats;
+		return stats;
+	}
+
+	MemPoolRegistrar frameArenaRegistrar("FrameArena", [](MemPoolStats& stats) {
+		const CFrameArena::Stats arenaStats = CFrameArena::GetStats();
+
+		stats.liveBytes = arenaStats.usedBytes;
+		stats.peakBytes = arenaStats.peakBytes;
+		stats.reservedBytes = arenaStats.reservedBytes;
+		stats.numPages = arenaStats.numChunks;
+	});
+}
+
+
+void MemPoolRegistry::Register(const char* name, StatsFunc&& func)
+{
+	const std::string plotName = std::string("MemPool::") + name;
+
+	GetEntries().push_back({name, std::move(func), plotName + " (live)", plotName + " (reserved)", 0});
+}
+
+void MemPoolRegistry::Update()
+{
+	RECOIL_DETAILED_TRACY_ZONE;
+
+	auto& entries = GetEntries();
+	auto& statsCache = GetStatsCache();
+
+	statsCache.clear();
+	statsCache.reserve(entries.size());
+
+	for (PoolEntry& entry: entries) {
+		MemPoolStats stats;
+
+		entry.func(stats);
+
+		// pools that do not track live bytes themselves report everything as in use
+		stats.name = entry.name;
+		stats.reservedBytes = std::max(stats.reservedBytes, stats.liveBytes);
+		stats.peakBytes = (entry.peakBytes = std::max({entry.peakBytes, stats.peakBytes, stats.liveBytes}));
+		stats.fragmentation = (stats.reservedBytes > 0)? 1.0f - (stats.liveBytes / static_cast<float>(stats.reservedBytes)): 0.0f;
+
+		statsCache.push_back(stats);
+
+		TracyPlotConfig(entry.livePlotName.c_str(), tracy::PlotFormatType::Memory, true, false, 0);
+		TracyPlotConfig(entry.reservedPlotName.c_str(), tracy::PlotFormatType::Memory, true, false, 0);
+		TracyPlot(entry.livePlotName.c_str(), static_cast<int64_t>(stats.liveBytes));
+		TracyPlot(entry.reservedPlotName.c_str(), static_cast<int64_t>(stats.reservedBytes));
+	}
+}
+
+const std::vector<MemPoolStats>& MemPoolRegistry::GetStats()
+{
+	return GetStatsCache();
+}
+
+void MemPoolRegistry::LogStats()
+{
+	Update();
+
+	size_t liveSum = 0;
+	size_t reservedSum = 0;
+
+	for (const MemPoolStats& stats: GetStatsCache()) {
+		LOG("[MemPoolRegistry::%s][%s] live=%.1fKB peak=%.1fKB reserved=%.1fKB pages=%u frag=%.1f%%", __func__,
+			stats.name,
+			stats.liveBytes / 1024.0f,
+			stats.peakBytes / 1024.0f,
+			stats.reservedBytes / 1024.0f,
+			static_cast<uint32_t>(stats.numPages),
+			stats.fragmentation * 100.0f
+		);
+
+		liveSum += stats.liveBytes;
+		reservedSum += stats.reservedBytes;
+	}
+
+	LOG("[MemPoolRegistry::%s] total live=%.1fMB reserved=%.1fMB", __func__, liveSum / 1024.0f / 1024.0f, reservedSum / 1024.0f / 1024.0f);
+}
@@ -0,0 +1,64 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#ifndef MEMPOOL_STATS_H
+#define MEMPOOL_STATS_H
+
+#include <cstddef>
+#include <functional>
+#include <utility>
+#include <vector>
+
+struct MemPoolStats {
+	const char* name = "";
+
+	size_t liveBytes = 0;     // handed out to users
+	size_t peakBytes = 0;     // max. liveBytes seen by the registry (or reported by the pool)
+	size_t reservedBytes = 0; // held by the pool, including free pages awaiting reuse
+	size_t numPages = 0;
+
+	// share of reserved memory not currently in use
+	float fragmentation = 0.0f;
+};
+
+/**
+ * Single view over the engine's memory pools. Each pool registers a
+ * callback (usually next to its definition) that fills in live/reserved
+ * bytes and page count; the registry derives fragmentation and tracks
+ * peaks between samples. Sampled once per second by the profiler job,
+ * exposed through /debuginfo mempools, the profile drawer and Tracy.
+ *
+ * Callbacks are invoked from the main thread.
+ */
+namespace MemPoolRegistry {
+	typedef std::function<void(MemPoolStats&)> StatsFunc;
+
+	void Register(const char* name, StatsFunc&& func);
+
+	/// samples every pool, updates peaks and Tracy plots
+	void Update();
+	/// stats as of the last Update
+	const std::vector<MemPoolStats>& GetStats();
+
+	void LogStats();
+
+	template<typename PoolType>
+	void GetPagedPoolStats(const PoolType& pool, MemPoolStats& stats) {
+		stats.reservedBytes = pool.alloc_size();
+		stats.liveBytes = stats.reservedBytes - pool.freed_size();
+		stats.numPages = stats.reservedBytes / PoolType::PAGE_SIZE();
+	}
+}
+
+/// static helper to register a pool from the translation unit that defines it
+struct MemPoolRegistrar {
+	MemPoolRegistrar(const char* name, MemPoolRegistry::StatsFunc&& func) {
+		MemPoolRegistry::Register(name, std::move(func));
+	}
+
+	template<typename PoolType, typename = decltype(std::declval<const PoolType&>().alloc_size())>
+	MemPoolRegistrar(const char* name, const PoolType& pool) {
+		MemPoolRegistry::Register(name, [&pool](MemPoolStats& stats) { MemPoolRegistry::GetPagedPoolStats(pool, stats); });
+	}
+};
+
+#endif
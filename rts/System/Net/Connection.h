@@ -61,6 +61,7 @@ public:
 	virtual bool CanReconnect() const = 0;
 	virtual bool NeedsReconnect() = 0;
 
+	unsigned int GetDataSent() const { return dataSent; }
 	unsigned int GetDataReceived() const { return dataRecv; }
 	unsigned int GetNumQueuedPings() const { return numPings; }
 	virtual unsigned int GetPacketQueueSize() const { return 0; }
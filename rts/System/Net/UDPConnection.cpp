@@ -96,8 +96,8 @@ public:
 		pos += sizeof(t);
 	}
 
-	void Unpack(std::vector<std::uint8_t>& t, unsigned unpackLength) {
-		std::copy(data + pos, data + pos + unpackLength, std::back_inserter(t));
+	void Unpack(std::uint8_t* t, unsigned unpackLength) {
+		std::copy(data + pos, data + pos + unpackLength, t);
 		pos += unpackLength;
 	}
 
@@ -129,6 +129,10 @@ public:
 		std::copy(_data.begin(), _data.end(), std::back_inserter(data));
 	}
 
+	void Pack(const std::uint8_t* _data, unsigned _length) {
+		data.insert(data.end(), _data, _data + _length);
+	}
+
 private:
 	std::vector<std::uint8_t>& data;
 };
@@ -140,8 +144,8 @@ void Chunk::UpdateChecksum(CRC& crc) const {
 	crc << chunkNumber;
 	crc << (unsigned int)chunkSize;
 
-	if (!data.empty()) {
-		crc.Update(&data[0], data.size());
+	if (chunkSize > 0) {
+		crc.Update(&data[0], chunkSize);
 	}
 }
 
@@ -171,15 +175,15 @@ Packet::Packet(const unsigned char* data, unsigned length)
 	chunks.reserve(buf.Remaining() / Chunk::headerSize);
 
 	while (buf.Remaining() > Chunk::headerSize) {
-		ChunkPtr temp(new Chunk);
+		ChunkPtr temp = std::make_shared<Chunk>();
 		buf.Unpack(temp->chunkNumber);
 		buf.Unpack(temp->chunkSize);
 
 		// defective, ignore
-		if (buf.Remaining() < temp->chunkSize)
+		if (buf.Remaining() < temp->chunkSize || temp->chunkSize > Chunk::maxSize)
 			break;
 
-		buf.Unpack(temp->data, temp->chunkSize);
+		buf.Unpack(temp->data.data(), temp->chunkSize);
 		chunks.push_back(temp);
 	}
 }
@@ -224,7 +228,7 @@ void Packet::Serialize(std::vector<std::uint8_t>& data)
 	for (auto ci = chunks.begin(); ci != chunks.end(); ++ci) {
 		buf.Pack((*ci)->chunkNumber);
 		buf.Pack((*ci)->chunkSize);
-		buf.Pack((*ci)->data);
+		buf.Pack((*ci)->data.data(), (*ci)->chunkSize);
 	}
 }
 
@@ -600,7 +604,7 @@ void UDPConnection::ProcessRawPacket(Packet& incoming)
 			continue;
 		}
 
-		waitingPackets.emplace_back(c->chunkNumber, RawPacket(&c->data[0], c->data.size()));
+		waitingPackets.emplace_back(c->chunkNumber, RawPacket(&c->data[0], c->chunkSize));
 		incomingChunkNums.insert(c->chunkNumber);
 	}
 
@@ -723,6 +727,11 @@ void UDPConnection::Flush(const bool forced)
 		bool partialPacket = false;
 		bool sendMore = true;
 
+		// bytes of the front packet already chunked; partial packets are always
+		// finished within one Flush, and keeping an offset into the (possibly
+		// broadcast-shared) packet avoids copying its remainder per fragment
+		unsigned packetPos = 0;
+
 		do {
 			sendMore  = (outgoing.GetAverage(true) <= globalConfig.linkOutgoingBandwidth);
 			sendMore |= ((globalConfig.linkOutgoingBandwidth <= 0) || partialPacket || forced);
@@ -737,22 +746,23 @@ void UDPConnection::Flush(const bool forced)
 					);
 					outgoingData.pop_front();
 				} else {
-					const unsigned numBytes = std::min((unsigned)maxChunkSize - pos, packet->length);
+					const unsigned numBytes = std::min((unsigned)maxChunkSize - pos, packet->length - packetPos);
 
 					assert(packet->length > 0);
-					memcpy(buffer + pos, packet->data, numBytes);
+					memcpy(buffer + pos, packet->data + packetPos, numBytes);
 
 					pos += numBytes;
 					sentOverhead += Packet::headerSize;
 
 					outgoing.DataSent(numBytes, true);
 
-					if ((partialPacket = (numBytes != packet->length))) {
+					if ((partialPacket = ((packetPos + numBytes) != packet->length))) {
 						// partially transferred
-						packet.reset(new RawPacket(packet->data + numBytes, packet->length - numBytes));
+						packetPos += numBytes;
 					} else {
 						// full packet copied
 						outgoingData.pop_front();
+						packetPos = 0;
 					}
 				}
 			}
@@ -835,10 +845,10 @@ void UDPConnection::SetMTU(unsigned mtu2)
 void UDPConnection::CreateChunk(const unsigned char* data, const unsigned length, const int packetNum)
 {
 	assert((length > 0) && (length < 255));
-	ChunkPtr buf(new Chunk);
+	ChunkPtr buf = std::make_shared<Chunk>();
 	buf->chunkNumber = packetNum;
 	buf->chunkSize = length;
-	std::copy(data, data + length, std::back_inserter(buf->data));
+	std::copy(data, data + length, buf->data.begin());
 	newChunks.push_back(buf);
 	lastChunkCreatedTime = spring_gettime();
 }
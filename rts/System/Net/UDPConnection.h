@@ -4,6 +4,7 @@
 #define _UDP_CONNECTION_H
 
 #include <asio/ip/udp.hpp>
+#include <array>
 #include <memory>
 #include <deque>
 
@@ -29,13 +30,14 @@ namespace netcode {
 class Chunk
 {
 public:
-	unsigned GetSize() const { return (data.size() + headerSize); }
+	unsigned GetSize() const { return (chunkSize + headerSize); }
 	void UpdateChecksum(CRC& crc) const;
 	static constexpr unsigned maxSize = 254;
 	static constexpr unsigned headerSize = 5;
 	std::int32_t chunkNumber;
 	std::uint8_t chunkSize;
-	std::vector<std::uint8_t> data;
+	// stored inline, so a chunk (allocated via make_shared) costs one allocation
+	std::array<std::uint8_t, maxSize> data;
 };
 typedef std::shared_ptr<Chunk> ChunkPtr;
 
@@ -7,11 +7,17 @@
 #endif
 #include "System/Misc/NonCopyable.h"
 
+#include <array>
 #include <memory>
 #include <asio.hpp>
 #include <cinttypes>
+#include <cstring>
 #include <queue>
 
+#ifdef __linux__
+	#include <sys/socket.h>
+#endif
+
 #include "ProtocolDef.h"
 #include "UDPConnection.h"
 #include "Socket.h"
@@ -108,6 +114,9 @@ std::string UDPListener::TryBindSocket(int port, std::shared_ptr<asio::ip::udp::
 void UDPListener::Update() {
 	netservice.poll();
 
+#ifdef __linux__
+	ReceiveBatched();
+#else
 	size_t bytesAvailable = 0;
 
 	while ((bytesAvailable = socket->available()) > 0) {
@@ -120,67 +129,127 @@ void UDPListener::Update() {
 
 		const size_t bytesReceived = socket->receive_from(asio::buffer(recvBuffer), udpEndPoint, msgFlags, err);
 
-		const auto ci = connMap.find(udpEndPoint);
-
-		// known connection but expired
-		if (ci != connMap.end() && ci->second.expired())
-			continue;
-
 		if (CheckErrorCode(err))
 			break;
 
-		if (bytesReceived < Packet::headerSize)
-			continue;
-
-		Packet data(&recvBuffer[0], bytesReceived);
+		ProcessDatagram(udpEndPoint, &recvBuffer[0], bytesReceived);
+	}
+#endif
 
-		if (ci != connMap.end()) {
-			ci->second.lock()->ProcessRawPacket(data);
+	for (auto i = connMap.cbegin(); i != connMap.cend(); ) {
+		if (i->second.expired()) {
+			LOG_L(L_DEBUG, "[UDPListener::%s] connection closed: [%s]:%i", __func__, i->first.address().to_string().c_str(), i->first.port());
+			i = connMap.erase(i);
 			continue;
 		}
+		i->second.lock()->Update();
+		++i;
+	}
+}
 
 
-		// unknown connection but still have the packet, maybe a new client wants to connect from sender's address
-		if (acceptNewConnections && data.lastContinuous == -1 && data.nakType == 0)	{
-			if (!data.chunks.empty() && (*data.chunks.begin())->chunkNumber == 0) {
-				std::shared_ptr<UDPConnection> incoming(new UDPConnection(socket, udpEndPoint));
-				waiting.push(incoming);
-				connMap[udpEndPoint] = incoming;
-				incoming->ProcessRawPacket(data);
-			}
+#ifdef __linux__
+void UDPListener::ReceiveBatched() {
+	// one recvmmsg call drains up to RECV_BATCH_SIZE datagrams, the generic
+	// path needs two syscalls (available and receive_from) per datagram
+	static constexpr unsigned RECV_BATCH_SIZE = 32;
+	// same as UDPConnection's maximum packet size, the MTU never exceeds it
+	static constexpr unsigned RECV_BUFFER_SIZE = 4096;
 
-			continue;
-		}
+	std::array<mmsghdr, RECV_BATCH_SIZE> msgs;
+	std::array<iovec, RECV_BATCH_SIZE> iovs;
+	std::array<sockaddr_storage, RECV_BATCH_SIZE> addrs;
 
+	recvBuffer.resize(RECV_BATCH_SIZE * RECV_BUFFER_SIZE);
 
-		const asio::ip::address& senderAddr = udpEndPoint.address();
-		const std::string& senderIP = senderAddr.to_string();
+	while (true) {
+		for (unsigned i = 0; i < RECV_BATCH_SIZE; i++) {
+			iovs[i].iov_base = &recvBuffer[i * RECV_BUFFER_SIZE];
+			iovs[i].iov_len = RECV_BUFFER_SIZE;
 
-		if (dropMap.find(senderIP) == dropMap.end()) {
-			LOG_L(L_DEBUG, "[UDPListener::%s] dropping packet from unknown IP: [%s]:%i", __func__, senderIP.c_str(), udpEndPoint.port());
-			dropMap[senderIP] = 0;
-		} else {
-			dropMap[senderIP] += 1;
+			msgs[i] = {};
+			msgs[i].msg_hdr.msg_name = &addrs[i];
+			msgs[i].msg_hdr.msg_namelen = sizeof(addrs[i]);
+			msgs[i].msg_hdr.msg_iov = &iovs[i];
+			msgs[i].msg_hdr.msg_iovlen = 1;
 		}
 
-	#ifdef DEBUG
-		std::string conns;
-		for (auto it = connMap.cbegin(); it != connMap.cend(); ++it) {
-			conns += spring::format(" [%s]:%i;", it->first.address().to_string().c_str(),it->first.port());
+		const int numMsgs = recvmmsg(socket->native_handle(), msgs.data(), RECV_BATCH_SIZE, MSG_DONTWAIT, nullptr);
+
+		if (numMsgs <= 0) {
+			asio::error_code err((numMsgs < 0)? errno: 0, asio::error::get_system_category());
+			CheckErrorCode(err);
+			break;
 		}
-		LOG_L(L_DEBUG, "[UDPListener::%s] open connections: %s", __func__, conns.c_str());
-	#endif
+
+		for (int i = 0; i < numMsgs; i++) {
+			const msghdr& hdr = msgs[i].msg_hdr;
+
+			// larger than any packet a peer can send
+			if ((hdr.msg_flags & MSG_TRUNC) != 0)
+				continue;
+
+			ip::udp::endpoint udpEndPoint;
+			std::memcpy(udpEndPoint.data(), hdr.msg_name, std::min<size_t>(hdr.msg_namelen, udpEndPoint.capacity()));
+			udpEndPoint.resize(hdr.msg_namelen);
+
+			ProcessDatagram(udpEndPoint, &recvBuffer[i * RECV_BUFFER_SIZE], msgs[i].msg_len);
+		}
+
+		if (numMsgs < static_cast<int>(RECV_BATCH_SIZE))
+			break;
 	}
+}
+#endif
 
-	for (auto i = connMap.cbegin(); i != connMap.cend(); ) {
-		if (i->second.expired()) {
-			LOG_L(L_DEBUG, "[UDPListener::%s] connection closed: [%s]:%i", __func__, i->first.address().to_string().c_str(), i->first.port());
-			i = connMap.erase(i);
-			continue;
+void UDPListener::ProcessDatagram(const asio::ip::udp::endpoint& udpEndPoint, const std::uint8_t* buffer, size_t numBytes) {
+	const auto ci = connMap.find(udpEndPoint);
+
+	// known connection but expired
+	if (ci != connMap.end() && ci->second.expired())
+		return;
+
+	if (numBytes < Packet::headerSize)
+		return;
+
+	Packet data(buffer, numBytes);
+
+	if (ci != connMap.end()) {
+		ci->second.lock()->ProcessRawPacket(data);
+		return;
+	}
+
+
+	// unknown connection but still have the packet, maybe a new client wants to connect from sender's address
+	if (acceptNewConnections && data.lastContinuous == -1 && data.nakType == 0)	{
+		if (!data.chunks.empty() && (*data.chunks.begin())->chunkNumber == 0) {
+			std::shared_ptr<UDPConnection> incoming(new UDPConnection(socket, udpEndPoint));
+			waiting.push(incoming);
+			connMap[udpEndPoint] = incoming;
+			incoming->ProcessRawPacket(data);
 		}
-		i->second.lock()->Update();
-		++i;
+
+		return;
 	}
+
+
+	const asio::ip::address& senderAddr = udpEndPoint.address();
+	const std::string& senderIP = senderAddr.to_string();
+
+	if (dropMap.find(senderIP) == dropMap.end()) {
+		LOG_L(L_DEBUG, "[UDPListener::%s] dropping packet from unknown IP: [%s]:%i", __func__, senderIP.c_str(), udpEndPoint.port());
+		dropMap[senderIP] = 0;
+	} else {
+		dropMap[senderIP] += 1;
+	}
+
+#ifdef DEBUG
+	std::string conns;
+	for (auto it = connMap.cbegin(); it != connMap.cend(); ++it) {
+		conns += spring::format(" [%s]:%i;", it->first.address().to_string().c_str(),it->first.port());
+	}
+	LOG_L(L_DEBUG, "[UDPListener::%s] open connections: %s", __func__, conns.c_str());
+#endif
 }
 
 
@@ -75,6 +75,12 @@ public:
 	void RejectConnection() { waiting.pop(); }
 	void UpdateConnections(); // Updates connections when the endpoint has been reconnected
 
+private:
+#ifdef __linux__
+	void ReceiveBatched();
+#endif
+	void ProcessDatagram(const asio::ip::udp::endpoint& udpEndPoint, const std::uint8_t* buffer, size_t numBytes);
+
 private:
 	/**
 	 * @brief Do we accept packets from unknown sources?
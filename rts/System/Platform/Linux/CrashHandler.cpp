@@ -23,6 +23,7 @@
 
 #include "Game/GameVersion.h"
 #include "System/FileSystem/FileSystem.h"
+#include "System/FrameTelemetry.h"
 #include "System/SpringExitCode.h"
 #include "System/Log/ILog.h"
 #include "System/Log/LogSinkHandler.h"
@@ -997,6 +998,8 @@ namespace CrashHandler
 		CleanupStacktrace();
 
 		if (signal != SIGIO) {
+			CFrameTelemetry::DumpAll("crash");
+
 			char buf[8192];
 			char* ptr = buf;
 
@@ -7,6 +7,7 @@
 
 #include "System/Platform/CrashHandler.h"
 #include "System/Platform/errorhandler.h"
+#include "System/FrameTelemetry.h"
 #include "System/Log/ILog.h"
 #include "System/Log/FileSink.h"
 #include "System/Log/LogSinkHandler.h"
@@ -473,6 +474,8 @@ LONG CALLBACK ExceptionHandler(LPEXCEPTION_POINTERS e)
 	StacktraceInline(nullptr, e);
 	CleanupStacktrace();
 
+	CFrameTelemetry::DumpAll("crash");
+
 	// only the first crash is of any real interest
 	CrashHandler::Remove();
 
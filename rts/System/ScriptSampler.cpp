@@ -0,0 +1,107 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+
+#include "ScriptSampler.h"
+#include "System/FileSystem/DataDirsAccess.h"
+#include "System/FileSystem/FileQueryFlags.h"
+#include "System/Log/ILog.h"
+#include "System/Platform/Threading.h"
+
+CScriptSampler scriptSampler;
+
+
+void CScriptSampler::Start(int _intervalUs)
+{
+	if (IsEnabled())
+		Stop();
+
+	intervalUs = std::max(_intervalUs, 100);
+	maxSampleAge = intervalUs * 4;
+
+	enabled.store(true, std::memory_order_release);
+	clockThread = spring::thread(&CScriptSampler::ClockLoop, this);
+}
+
+void CScriptSampler::Stop()
+{
+	if (!enabled.exchange(false, std::memory_order_acq_rel))
+		return;
+
+	if (clockThread.joinable())
+		clockThread.join();
+
+	for (auto& due: sampleDue) {
+		due.store(false, std::memory_order_relaxed);
+	}
+}
+
+void CScriptSampler::Reset()
+{
+	std::lock_guard<spring::mutex> lock(mutex);
+	stacks.clear();
+	numSamples.store(0, std::memory_order_relaxed);
+}
+
+
+void CScriptSampler::ClockLoop()
+{
+	Threading::SetThreadName("scriptsampler");
+
+	while (enabled.load(std::memory_order_acquire)) {
+		std::this_thread::sleep_for(std::chrono::microseconds(intervalUs));
+
+		const int64_t now = spring_gettime().toMicroSecsi();
+
+		for (int src = 0; src < SOURCE_COUNT; src++) {
+			raiseTimes[src].store(now, std::memory_order_relaxed);
+			sampleDue[src].store(true, std::memory_order_release);
+		}
+	}
+}
+
+
+void CScriptSampler::AddSample(const std::string& stack)
+{
+	std::lock_guard<spring::mutex> lock(mutex);
+	stacks[stack] += 1;
+	numSamples.fetch_add(1, std::memory_order_relaxed);
+}
+
+std::vector<std::pair<std::string, uint64_t>> CScriptSampler::GetSamples() const
+{
+	std::vector<std::pair<std::string, uint64_t>> samples;
+
+	{
+		std::lock_guard<spring::mutex> lock(mutex);
+		samples.reserve(stacks.size());
+
+		for (const auto& [stack, count]: stacks) {
+			samples.emplace_back(stack, count);
+		}
+	}
+
+	std::sort(samples.begin(), samples.end(), [](const auto& a, const auto& b) { return (a.second > b.second); });
+	return samples;
+}
+
+bool CScriptSampler::DumpToFile(const std::string& fileName) const
+{
+	const std::string filePath = dataDirsAccess.LocateFile(fileName, FileQueryFlags::WRITE);
+	FILE* file = fopen(filePath.c_str(), "w");
+
+	if (file == nullptr) {
+		LOG_L(L_WARNING, "[ScriptSampler::%s] could not open \"%s\" for writing", __func__, filePath.c_str());
+		return false;
+	}
+
+	// folded-stack format, one "frame;frame;frame count" line per distinct stack
+	for (const auto& [stack, count]: GetSamples()) {
+		fprintf(file, "%s %lu\n", stack.c_str(), static_cast<unsigned long>(count));
+	}
+
+	fclose(file);
+	return true;
+}
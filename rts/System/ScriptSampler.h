@@ -0,0 +1,88 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#ifndef SCRIPT_SAMPLER_H
+#define SCRIPT_SAMPLER_H
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "System/Misc/SpringTime.h"
+#include "System/Threading/SpringThreading.h"
+#include "System/UnorderedMap.hpp"
+
+/**
+ * Statistical profiler for script code. A clock thread raises one flag per
+ * source (Lua, COB) every interval; the interpreters poll their flag (Lua
+ * through a count hook, COB once per opcode) and, when it is up, record the
+ * stack they are currently executing. Stacks are aggregated as "folded"
+ * lines (frames root-first, separated by ';') which flamegraph.pl and most
+ * flamegraph viewers read directly.
+ *
+ * A flag that nobody consumed within a few intervals is dropped, so idle
+ * time does not get attributed to whatever script runs next.
+ */
+class CScriptSampler {
+public:
+	enum Source {
+		SOURCE_LUA = 0,
+		SOURCE_COB = 1,
+		SOURCE_COUNT,
+	};
+
+	static constexpr int DEFAULT_INTERVAL_US = 1000;
+	/// number of Lua VM instructions between two polls of the sample flag
+	static constexpr int LUA_HOOK_COUNT = 1000;
+
+public:
+	~CScriptSampler() { Stop(); }
+
+	bool IsEnabled() const { return enabled.load(std::memory_order_relaxed); }
+
+	void Start(int intervalUs = DEFAULT_INTERVAL_US);
+	void Stop();
+	void Reset();
+
+	/// true at most once per raised flag; the no-sample path is a single relaxed load
+	bool SampleDue(Source src) {
+		if (!sampleDue[src].load(std::memory_order_relaxed))
+			return false;
+		if (!sampleDue[src].exchange(false, std::memory_order_acquire))
+			return false;
+
+		return ((spring_gettime().toMicroSecsi() - raiseTimes[src].load(std::memory_order_relaxed)) <= maxSampleAge);
+	}
+
+	void AddSample(const std::string& stack);
+
+	/// (stack, count) pairs, most frequent first
+	std::vector<std::pair<std::string, uint64_t>> GetSamples() const;
+	uint64_t GetNumSamples() const { return numSamples.load(std::memory_order_relaxed); }
+
+	bool DumpToFile(const std::string& fileName) const;
+
+private:
+	void ClockLoop();
+
+private:
+	std::atomic<bool> enabled = {false};
+	std::atomic<bool> sampleDue[SOURCE_COUNT] = {};
+	std::atomic<int64_t> raiseTimes[SOURCE_COUNT] = {}; // microseconds
+
+	std::atomic<uint64_t> numSamples = {0};
+
+	int64_t intervalUs = DEFAULT_INTERVAL_US;
+	int64_t maxSampleAge = DEFAULT_INTERVAL_US * 4;
+
+	spring::thread clockThread;
+
+	mutable spring::mutex mutex;
+
+	spring::unordered_map<std::string, uint64_t> stacks;
+};
+
+extern CScriptSampler scriptSampler;
+
+#endif
@@ -68,6 +68,7 @@ public:
 
 protected:
 	virtual void FindSourceAndPlay(size_t id, const float3& p, const float3& velocity, float volume, bool relative) = 0;
+	virtual void SoundSourceStarted(CSoundSource* sndSource) = 0;
 	virtual void SoundSourceFinished(CSoundSource* sndSource) = 0;
 
 	friend class CSoundSource;
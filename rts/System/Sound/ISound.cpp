@@ -38,6 +38,8 @@ CONFIG(int, snd_volui).defaultValue(100).minimumValue(0).maximumValue(200).descr
 CONFIG(int, snd_volmusic).defaultValue(100).minimumValue(0).maximumValue(200).description("Volume for \"music\" sound channel.");
 CONFIG(float, snd_airAbsorption).defaultValue(0.1f);
 
+CONFIG(int, snd_decodecachesize).defaultValue(128).minimumValue(0).description("Maximum size (in MB) of decoded sound data kept in memory for creating sound buffers without decoding them again.");
+
 CONFIG(std::string, snd_device).defaultValue("").description("Sets the used output device. See \"Available Devices\" section in infolog.txt.");
 
 
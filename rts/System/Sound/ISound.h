@@ -10,6 +10,7 @@
 class float3;
 class LuaParser;
 class CSoundSource;
+class IAudioChannel;
 class SoundItem;
 
 
@@ -33,6 +34,8 @@ public:
 
 	virtual bool HasSoundItem(const std::string& name) const = 0;
 	virtual bool PreloadSoundItem(const std::string& name) = 0;
+	/// starts decoding the file of a sound item or a raw sound file in the background
+	virtual void PreDecodeSound(const std::string& name) = 0;
 	virtual size_t GetDefSoundId(const std::string& name) = 0;
 	virtual size_t GetSoundId(const std::string& name) = 0;
 
@@ -43,6 +46,12 @@ public:
 	 * the one with the lowest priority otherwise.
 	 */
 	virtual CSoundSource* GetNextBestSource(bool lock = true) = 0;
+	/**
+	 * Keeps track of a positional play request that found no free source,
+	 * it gets bound to one if a source frees up before the sound would have
+	 * ended. Identical requests made at about the same time are merged.
+	 */
+	virtual void AddVirtualVoice(IAudioChannel* channel, size_t id, const float3& pos, const float3& velocity, float volume) = 0;
 
 
 	virtual void UpdateListener(const float3& camPos, const float3& camDir, const float3& camUp) = 0;
@@ -75,6 +84,9 @@ public:
 public:
 	unsigned numEmptyPlayRequests = 0;
 	unsigned numAbortedPlays = 0;
+	unsigned numVirtualPlays = 0;
+	unsigned numMergedPlays = 0;
+	unsigned numPromotedPlays = 0;
 
 private:
 	virtual bool LoadSoundDefsImpl(LuaParser* defsParser) = 0;
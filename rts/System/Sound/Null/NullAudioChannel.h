@@ -31,6 +31,7 @@ public:
 
 protected:
 	void FindSourceAndPlay(size_t id, const float3& p, const float3& velocity, float volume, bool relative) override {}
+	void SoundSourceStarted(CSoundSource* sndSource) override {}
 	void SoundSourceFinished(CSoundSource* sndSource) override {}
 
 	friend class CSoundSource;
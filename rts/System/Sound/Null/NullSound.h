@@ -20,11 +20,13 @@ public:
 
 	bool HasSoundItem(const std::string& name) const override { return false; }
 	bool PreloadSoundItem(const std::string& name) override { return false; }
+	void PreDecodeSound(const std::string& name) override {}
 	size_t GetDefSoundId(const std::string& name) override { return 0; }
 	size_t GetSoundId(const std::string& name) override { return 0; }
 
 	SoundItem* GetSoundItem(size_t id) override { return nullptr; }
 	CSoundSource* GetNextBestSource(bool lock = true) override { return nullptr; }
+	void AddVirtualVoice(IAudioChannel* channel, size_t id, const float3& pos, const float3& velocity, float volume) override {}
 
 	void UpdateListener(const float3& campos, const float3& camdir, const float3& camup) override {}
 	void NewFrame() override {}
@@ -46,6 +46,12 @@ void AudioChannel::Enable(bool newState)
 }
 
 
+void AudioChannel::SoundSourceStarted(CSoundSource* sndSource)
+{
+	// sources bound to virtual voices are not handed out by FindSourceAndPlay
+	curSources.insert(sndSource);
+}
+
 void AudioChannel::SoundSourceFinished(CSoundSource* sndSource)
 {
 	// FIXME broken queue
@@ -90,6 +96,17 @@ void AudioChannel::FindSourceAndPlay(size_t id, const float3& pos, const float3&
 		LOG("[AudioChannel::%s] maximum distance ignored for relative playback of sound-item \"%s\"", __func__, (sndItem->Name()).c_str());
 	}
 
+	// fold into an identical request that has not started playing yet
+	if (!relative) {
+		for (CSoundSource* src: curSources) {
+			if (!src->MergeAsync(id, pos, volume))
+				continue;
+
+			sound->numMergedPlays++;
+			return;
+		}
+	}
+
 	// don't spam to many sounds per frame
 	if (emitsThisFrame >= emitsPerFrame)
 		return;
@@ -122,6 +139,11 @@ void AudioChannel::FindSourceAndPlay(size_t id, const float3& pos, const float3&
 
 	if (sndSource == nullptr || (sndSource->GetCurrentPriority() >= sndItem->GetPriority())) {
 		LOG_L(L_DEBUG, "[AudioChannel::%s] no source found for sound-item %s", __func__, (sndItem->Name()).c_str());
+
+		// UI and unit-reply sounds are useless when late, only keep positional ones
+		if (!relative)
+			sound->AddVirtualVoice(this, id, pos, velocity, volume);
+
 		return;
 	}
 	if (sndSource->IsPlaying())
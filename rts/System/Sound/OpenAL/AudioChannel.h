@@ -51,6 +51,7 @@ public:
 
 protected:
 	void FindSourceAndPlay(size_t id, const float3& pos, const float3& velocity, float volume, bool relative) override;
+	void SoundSourceStarted(CSoundSource* sndSource) override;
 	void SoundSourceFinished(CSoundSource* sndSource) override;
 
 private:
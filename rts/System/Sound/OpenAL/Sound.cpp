@@ -47,6 +47,13 @@
 
 spring::recursive_mutex soundMutex;
 
+// requests for the same item closer than this in space and time are merged
+static constexpr float VOICE_MERGE_DIST = 64.0f;
+static constexpr int VOICE_MERGE_TIME = 1000 / GAME_SPEED;
+// not worth a source anymore if less than this (ms) is left
+static constexpr int VOICE_MIN_REMAINING = 100;
+static constexpr float VOICE_REFERENCE_DIST = 200.0f;
+
 
 CSound::CSound()
 {
@@ -91,6 +98,7 @@ void CSound::Init()
 	}
 	{
 		SoundBuffer::Initialise();
+		decodeCache.Init(size_t(configHandler->GetInt("snd_decodecachesize")) * 1024 * 1024);
 
 		soundMap.clear();
 		soundMap.reserve(256);
@@ -121,6 +129,7 @@ void CSound::Kill()
 			soundThread.join();
 	}
 
+	decodeCache.Kill();
 	SoundBuffer::Deinitialise();
 }
 
@@ -173,6 +182,32 @@ bool CSound::PreloadSoundItem(const std::string& name)
 	#endif
 }
 
+void CSound::PreDecodeSound(const std::string& name)
+{
+	std::lock_guard<spring::recursive_mutex> lck(soundMutex);
+
+	if (soundMap.find(name) != soundMap.end())
+		return;
+
+	std::string path = name;
+
+	const auto itemDefIt = soundItemDefsMap.find(StringToLower(name));
+
+	if (itemDefIt != soundItemDefsMap.end()) {
+		const auto fileIt = itemDefIt->second.find("file");
+
+		if (fileIt == itemDefIt->second.end())
+			return;
+
+		path = fileIt->second;
+	}
+
+	if (SoundBuffer::GetId(path) > 0 || failureSet.find(path) != failureSet.end())
+		return;
+
+	decodeCache.Enqueue(path);
+}
+
 
 size_t CSound::GetDefSoundId(const std::string& name)
 {
@@ -259,6 +294,108 @@ CSoundSource* CSound::GetNextBestSource(bool lock)
 	return bestSrc;
 }
 
+float CSound::GetVoiceScore(const SoundItem* item, const float3& pos, float volume) const
+{
+	// inverse-distance falloff like the sources use, squashed into [0, 1) so
+	// it only orders sounds of equal priority
+	const float loudness = volume * item->GetBaseGain() * VOICE_REFERENCE_DIST / (VOICE_REFERENCE_DIST + pos.distance(myPos));
+
+	return (item->GetPriority() + loudness / (1.0f + loudness));
+}
+
+void CSound::AddVirtualVoice(IAudioChannel* channel, size_t id, const float3& pos, const float3& velocity, float volume)
+{
+	std::lock_guard<spring::recursive_mutex> lck(soundMutex);
+
+	const SoundItem* item = GetSoundItem(id);
+
+	// loops have no natural end to resume against
+	if (item == nullptr || item->GetLoopTime() > 0)
+		return;
+
+	const SoundBuffer& buffer = SoundBuffer::GetById(item->GetSoundBufferID());
+	const spring_time now = spring_gettime();
+
+	for (VirtualVoice& voice: virtualVoices) {
+		if (voice.itemID != id || voice.channel != channel)
+			continue;
+		if ((now - voice.startTime) > spring_msecs(VOICE_MERGE_TIME))
+			continue;
+		if (voice.pos.SqDistance(pos) > (VOICE_MERGE_DIST * VOICE_MERGE_DIST))
+			continue;
+
+		voice.volume = std::max(voice.volume, volume);
+		numMergedPlays++;
+		return;
+	}
+
+	VirtualVoice voice;
+	voice.channel = channel;
+	voice.itemID = id;
+	voice.pos = pos;
+	voice.velocity = velocity;
+	voice.volume = volume;
+	voice.score = GetVoiceScore(item, pos, volume);
+	voice.startTime = now;
+	voice.endTime = now + spring_msecs(int(buffer.GetLength() * 1000.0f));
+
+	numVirtualPlays++;
+
+	if (virtualVoices.size() < MAX_VIRTUAL_VOICES) {
+		virtualVoices.push_back(voice);
+		return;
+	}
+
+	// full, replace the least important voice if the new one beats it
+	const auto pred = [](const VirtualVoice& a, const VirtualVoice& b) { return (a.score < b.score); };
+	const auto iter = std::min_element(virtualVoices.begin(), virtualVoices.end(), pred);
+
+	if (iter->score < voice.score)
+		*iter = voice;
+}
+
+void CSound::UpdateVirtualVoices()
+{
+	if (virtualVoices.empty())
+		return;
+
+	const spring_time now = spring_gettime();
+
+	const auto expired = [&](const VirtualVoice& voice) {
+		if ((voice.endTime - now) < spring_msecs(VOICE_MIN_REMAINING))
+			return true;
+		if (!voice.channel->IsEnabled())
+			return true;
+
+		return (voice.pos.distance(myPos) > soundItems[voice.itemID].MaxDistance());
+	};
+
+	virtualVoices.erase(std::remove_if(virtualVoices.begin(), virtualVoices.end(), expired), virtualVoices.end());
+
+	// the listener may have moved since the voices were added
+	for (VirtualVoice& voice: virtualVoices) {
+		voice.score = GetVoiceScore(&soundItems[voice.itemID], voice.pos, voice.volume);
+	}
+
+	std::sort(virtualVoices.begin(), virtualVoices.end(), [](const VirtualVoice& a, const VirtualVoice& b) { return (a.score > b.score); });
+
+	size_t numPromoted = 0;
+
+	for (CSoundSource& source: soundSources) {
+		if (numPromoted >= virtualVoices.size())
+			break;
+		if (source.IsPlaying(false))
+			continue;
+
+		const VirtualVoice& voice = virtualVoices[numPromoted++];
+
+		source.Play(voice.channel, &soundItems[voice.itemID], voice.pos, voice.velocity, voice.volume, false, (now - voice.startTime).toSecsf());
+	}
+
+	virtualVoices.erase(virtualVoices.begin(), virtualVoices.begin() + numPromoted);
+	numPromotedPlays += numPromoted;
+}
+
 void CSound::PitchAdjust(const float newPitch)
 {
 	std::lock_guard<spring::recursive_mutex> lck(soundMutex);
@@ -734,6 +871,7 @@ void CSound::UpdateThread(int cfgMaxSounds)
 		LOG("[Sound::%s][3] #sources=%u #items=%u", __func__, uint32_t(soundSources.size()), uint32_t(soundItems.size()));
 
 		// destruct items before context cleanup
+		virtualVoices.clear();
 		soundSources.clear();
 		soundItems.clear();
 
@@ -762,9 +900,15 @@ void CSound::Update()
 	}
 
 	for (CSoundSource& source: soundSources) {
+		// idle sources have nothing to update
+		if (!source.IsPlaying(false))
+			continue;
+
 		source.Update();
 	}
 
+	UpdateVirtualVoices();
+
 	CheckError("[Sound::Update]");
 	UpdateListenerReal();
 }
@@ -844,7 +988,10 @@ void CSound::PrintDebugInfo()
 	LOG_L(L_DEBUG, "# reserved for buffers: %i kB", (int)(SoundBuffer::AllocedSize() / 1024));
 	LOG_L(L_DEBUG, "# PlayRequests for empty sound: %i", numEmptyPlayRequests);
 	LOG_L(L_DEBUG, "# Samples disrupted: %i", numAbortedPlays);
+	LOG_L(L_DEBUG, "# Samples virtualized: %i (promoted: %i, pending: %i)", numVirtualPlays, numPromotedPlays, (int)virtualVoices.size());
+	LOG_L(L_DEBUG, "# Samples merged: %i", numMergedPlays);
 	LOG_L(L_DEBUG, "# SoundItems: %i", (int)soundItems.size());
+	LOG_L(L_DEBUG, "# decoded sounds: %i (cache hits: %i, cached: %i kB)", (int)decodeCache.GetNumDecoded(), (int)decodeCache.GetNumHits(), (int)(decodeCache.GetUsedBytes() / 1024));
 }
 
 bool CSound::LoadSoundDefsImpl(LuaParser* defsParser)
@@ -938,41 +1085,17 @@ size_t CSound::LoadSoundBuffer(const std::string& path)
 	if (failureSet.find(path) != failureSet.end())
 		return 0;
 
-	CFileHandler file("", "");
+	// normally decoded in the background already, only needs the upload
+	const CSoundDecodeCache::DecodedSoundPtr decodedSound = decodeCache.Get(path);
 
-	loadBuffer.clear();
-	loadBuffer.reserve(1024 * 1024);
-
-	file.GetBuffer() = std::move(loadBuffer);
-	file.Open(path, SPRING_VFS_RAW_FIRST);
-
-	// steal back
-	loadBuffer = std::move(file.GetBuffer());
-
-	if (!file.FileExists()) {
-		LOG_L(L_ERROR, "[%s] unable to open audio file \"%s\"", __func__, path.c_str());
+	if (decodedSound == nullptr) {
+		LOG_L(L_WARNING, "[%s] failed to load file \"%s\"", __func__, path.c_str());
 		failureSet.insert(path);
 		return 0;
 	}
 
-	if (loadBuffer.empty()) {
-		// copy file into buffer manually if not in VFS
-		loadBuffer.resize(file.FileSize());
-		file.Read(loadBuffer.data(), loadBuffer.size());
-	}
-
-
 	SoundBuffer soundBuf;
-	const std::string& soundExt = file.GetFileExt();
-
-	switch (soundExt[0]) {
-		case 'w': { soundBuf.LoadWAV   (path, loadBuffer); } break; // wav
-		case 'o': { soundBuf.LoadVorbis(path, loadBuffer); } break; // ogg
-		case 'm': { soundBuf.LoadMp3   (path, loadBuffer); } break; // mp3
-		default : {
-			LOG_L(L_WARNING, "[%s] unknown audio format \"%s\"", __func__, soundExt.c_str());
-		} break;
-	}
+	soundBuf.Load(path, *decodedSound);
 
 	CheckError("[Sound::LoadSoundBuffer]");
 
@@ -11,10 +11,12 @@
 
 #include "System/Sound/ISound.h"
 #include "System/float3.h"
+#include "System/Misc/SpringTime.h"
 #include "System/UnorderedMap.hpp"
 #include "System/UnorderedSet.hpp"
 #include "System/Threading/SpringThreading.h"
 
+#include "SoundDecodeCache.h"
 #include "SoundItem.h"
 
 class CSoundSource;
@@ -33,11 +35,13 @@ public:
 
 	bool HasSoundItem(const std::string& name) const override;
 	bool PreloadSoundItem(const std::string& name) override;
+	void PreDecodeSound(const std::string& name) override;
 	size_t GetDefSoundId(const std::string& name) override;
 	size_t GetSoundId(const std::string& name) override;
 
 	SoundItem* GetSoundItem(size_t id);
 	CSoundSource* GetNextBestSource(bool lock = true) override;
+	void AddVirtualVoice(IAudioChannel* channel, size_t id, const float3& pos, const float3& velocity, float volume) override;
 
 	void NewFrame() override;
 	void UpdateListener(const float3& campos, const float3& camdir, const float3& camup) override {
@@ -76,6 +80,24 @@ private:
 	typedef spring::unordered_map<std::string, std::string> SoundItemNameMap;
 	typedef spring::unordered_map<std::string, SoundItemNameMap> SoundItemDefsMap;
 
+	/// a play request that is tracked without holding an OpenAL source
+	struct VirtualVoice {
+		IAudioChannel* channel = nullptr;
+
+		size_t itemID = 0;
+
+		float3 pos;
+		float3 velocity;
+
+		float volume = 0.0f;
+		float score = 0.0f;
+
+		spring_time startTime;
+		spring_time endTime;
+	};
+
+	static constexpr size_t MAX_VIRTUAL_VOICES = 1024;
+
 private:
 	void Cleanup();
 	void OpenOpenALDevice(const std::string& deviceName);
@@ -86,6 +108,10 @@ private:
 
 	void Update();
 	void UpdateListenerReal();
+	void UpdateVirtualVoices();
+
+	/// priority first, then loudness at the listener
+	float GetVoiceScore(const SoundItem* item, const float3& pos, float volume) const;
 
 	int GetMaxMonoSources(ALCdevice* device, int cfgMaxSounds);
 	void GenSources(int alMaxSounds);
@@ -108,8 +134,9 @@ private:
 
 	std::vector<SoundItem> soundItems;
 	std::vector<CSoundSource> soundSources; // fixed-size
+	std::vector<VirtualVoice> virtualVoices;
 
-	std::vector<std::uint8_t> loadBuffer;
+	CSoundDecodeCache decodeCache;
 
 	SoundItemNameMap defaultItemNameMap;
 	SoundItemDefsMap soundItemDefsMap; // parsed from sounds.lua
@@ -19,9 +19,6 @@
 SoundBuffer::bufferMapT SoundBuffer::bufferMap;
 SoundBuffer::bufferVecT SoundBuffer::buffers;
 
-static std::vector<std::uint8_t> decodeBuffer;
-
-
 #pragma pack(push, 1)
 // Header copied from WavLib by Michael McTernan
 struct WAVHeader
@@ -42,11 +39,37 @@ struct WAVHeader
 #pragma pack(pop)
 
 
-bool SoundBuffer::LoadWAV(const std::string& file, const std::vector<std::uint8_t>& buffer)
+bool SoundBuffer::Decode(const std::string& file, const std::string& fileExt, std::vector<std::uint8_t>& buffer, DecodedSound& sound)
+{
+	switch (fileExt.empty()? 0: fileExt[0]) {
+		case 'w': { return (DecodeWAV   (file, buffer, sound)); } break; // wav
+		case 'o': { return (DecodeVorbis(file, buffer, sound)); } break; // ogg
+		case 'm': { return (DecodeMp3   (file, buffer, sound)); } break; // mp3
+		default : {
+			LOG_L(L_WARNING, "[%s(%s)] unknown audio format \"%s\"", __func__, file.c_str(), fileExt.c_str());
+		} break;
+	}
+
+	return false;
+}
+
+bool SoundBuffer::Load(const std::string& file, const DecodedSound& sound)
+{
+	if (sound.data.empty() || !AlGenBuffer(file, sound.format, sound.data.data(), sound.data.size(), sound.rate))
+		LOG_L(L_WARNING, "[%s(%s)] failed generating buffer", __func__, file.c_str());
+
+	filename = file;
+	channels = sound.channels;
+	length   = sound.length;
+	return true;
+}
+
+
+bool SoundBuffer::DecodeWAV(const std::string& file, std::vector<std::uint8_t>& buffer, DecodedSound& sound)
 {
 	WAVHeader* header = (WAVHeader*)(&buffer[0]);
 
-	if ((buffer.empty()) || memcmp(header->riff, "RIFF", 4) || memcmp(header->wavefmt, "WAVEfmt", 7)) {
+	if ((buffer.size() < sizeof(WAVHeader)) || memcmp(header->riff, "RIFF", 4) || memcmp(header->wavefmt, "WAVEfmt", 7)) {
 		LOG_L(L_ERROR, "[%s(%s)] invalid header", __func__, file.c_str());
 		return false;
 	}
@@ -99,31 +122,20 @@ bool SoundBuffer::LoadWAV(const std::string& file, const std::vector<std::uint8_
 				__func__, file.c_str(), header->datalen,
 				(int)(buffer.size() - sizeof(WAVHeader)));
 
-//		LOG_L(L_WARNING, "OpenAL: size %d\n", size);
-//		LOG_L(L_WARNING, "OpenAL: sizeof(WAVHeader) %d\n", sizeof(WAVHeader));
-//		LOG_L(L_WARNING, "OpenAL: format_tag %d\n", header->format_tag);
-//		LOG_L(L_WARNING, "OpenAL: channels %d\n", header->channels);
-//		LOG_L(L_WARNING, "OpenAL: BlockAlign %d\n", header->BlockAlign);
-//		LOG_L(L_WARNING, "OpenAL: BitsPerSample %d\n", header->BitsPerSample);
-//		LOG_L(L_WARNING, "OpenAL: totalLength %d\n", header->totalLength);
-//		LOG_L(L_WARNING, "OpenAL: length %d\n", header->length);
-//		LOG_L(L_WARNING, "OpenAL: SamplesPerSec %d\n", header->SamplesPerSec);
-//		LOG_L(L_WARNING, "OpenAL: AvgBytesPerSec %d\n", header->AvgBytesPerSec);
-
 		header->datalen = std::uint32_t(buffer.size() - sizeof(WAVHeader))&(~std::uint32_t((header->BitsPerSample*header->channels)/8 -1));
 	}
 
-	if (header->datalen <= 0 || !AlGenBuffer(file, format, &buffer[sizeof(WAVHeader)], header->datalen, header->SamplesPerSec))
-		LOG_L(L_WARNING, "[%s(%s)] failed generating buffer", __func__, file.c_str());
-
-	filename = file;
-	channels = header->channels;
-	length   = float(header->datalen) / (header->channels * header->SamplesPerSec * header->BitsPerSample);
+	if (header->datalen > 0)
+		sound.data.assign(buffer.begin() + sizeof(WAVHeader), buffer.begin() + sizeof(WAVHeader) + header->datalen);
 
+	sound.format   = format;
+	sound.rate     = header->SamplesPerSec;
+	sound.channels = header->channels;
+	sound.length   = float(header->datalen) / (header->channels * header->SamplesPerSec * (header->BitsPerSample / 8));
 	return true;
 }
 
-bool SoundBuffer::LoadVorbis(const std::string& file, const std::vector<std::uint8_t>& buffer)
+bool SoundBuffer::DecodeVorbis(const std::string& file, const std::vector<std::uint8_t>& buffer, DecodedSound& sound)
 {
 	OggDecoder decoder;
 	const bool loaded = decoder.LoadData(buffer.data(), buffer.size());
@@ -142,6 +154,8 @@ bool SoundBuffer::LoadVorbis(const std::string& file, const std::vector<std::uin
 		}
 	}
 
+	std::vector<std::uint8_t>& decodeBuffer = sound.data;
+
 	size_t pos = 0;
 	int section = 0;
 	long read = 0;
@@ -169,16 +183,17 @@ bool SoundBuffer::LoadVorbis(const std::string& file, const std::vector<std::uin
 		pos += read;
 	} while (read > 0); // read == 0 indicated EOF, read < 0 is error
 
-	if (!AlGenBuffer(file, format, &decodeBuffer[0], pos, decoder.GetRate()))
-		LOG_L(L_WARNING, "[%s(%s)] failed generating buffer", __func__, file.c_str());
+	decodeBuffer.resize(pos);
+	decodeBuffer.shrink_to_fit();
 
-	filename = file;
-	channels = decoder.GetChannels();
-	length   = decoder.GetTotalTime();
+	sound.format   = format;
+	sound.rate     = decoder.GetRate();
+	sound.channels = decoder.GetChannels();
+	sound.length   = decoder.GetTotalTime();
 	return true;
 }
 
-bool SoundBuffer::LoadMp3(const std::string& file, const std::vector<std::uint8_t>& buffer)
+bool SoundBuffer::DecodeMp3(const std::string& file, const std::vector<std::uint8_t>& buffer, DecodedSound& sound)
 {
 	auto decoder = Mp3Decoder();
 	const bool loaded = decoder.LoadData(buffer.data(), buffer.size());
@@ -197,6 +212,8 @@ bool SoundBuffer::LoadMp3(const std::string& file, const std::vector<std::uint8_
 		}
 	}
 
+	std::vector<std::uint8_t>& decodeBuffer = sound.data;
+
 	size_t pos = 0;
 	long read = 0;
 
@@ -214,12 +231,13 @@ bool SoundBuffer::LoadMp3(const std::string& file, const std::vector<std::uint8_
 		pos += read;
 	} while (read > 0); // read == 0 indicated EOF, read < 0 is error
 
-	if (!AlGenBuffer(file, format, &decodeBuffer[0], pos, decoder.GetRate()))
-		LOG_L(L_WARNING, "[%s(%s)] failed generating buffer", __func__, file.c_str());
+	decodeBuffer.resize(pos);
+	decodeBuffer.shrink_to_fit();
 
-	filename = file;
-	channels = decoder.GetChannels();
-	length   = decoder.GetTotalTime();
+	sound.format   = format;
+	sound.rate     = decoder.GetRate();
+	sound.channels = decoder.GetChannels();
+	sound.length   = decoder.GetTotalTime();
 	return true;
 }
 
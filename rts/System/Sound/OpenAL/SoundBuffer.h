@@ -12,6 +12,18 @@
 #include "System/UnorderedMap.hpp"
 #include "System/Misc/NonCopyable.h"
 
+/// decoded PCM data of a sound file, ready to be handed to OpenAL
+struct DecodedSound {
+	std::vector<std::uint8_t> data;
+
+	ALenum format = 0;
+	int rate = 0;
+	int channels = 0;
+
+	/// seconds
+	float length = 0.0f;
+};
+
 /**
  * @brief A buffer holding a sound
  *
@@ -37,9 +49,10 @@ public:
 		return *this;
 	}
 
-	bool LoadWAV(const std::string& file, const std::vector<std::uint8_t>& buffer);
-	bool LoadVorbis(const std::string& file, const std::vector<std::uint8_t>& buffer);
-	bool LoadMp3(const std::string& file, const std::vector<std::uint8_t>& buffer);
+	/// does not touch OpenAL, safe to call from any thread
+	static bool Decode(const std::string& file, const std::string& fileExt, std::vector<std::uint8_t>& buffer, DecodedSound& sound);
+
+	bool Load(const std::string& file, const DecodedSound& sound);
 	bool Release();
 
 	const std::string& GetFilename() const { return filename; }
@@ -68,6 +81,10 @@ public:
 	static size_t Insert(SoundBuffer&& buffer);
 
 private:
+	static bool DecodeWAV(const std::string& file, std::vector<std::uint8_t>& buffer, DecodedSound& sound);
+	static bool DecodeVorbis(const std::string& file, const std::vector<std::uint8_t>& buffer, DecodedSound& sound);
+	static bool DecodeMp3(const std::string& file, const std::vector<std::uint8_t>& buffer, DecodedSound& sound);
+
 	bool AlGenBuffer(const std::string& file, ALenum format, const std::uint8_t* data, size_t datalength, int rate);
 
 	std::string filename;
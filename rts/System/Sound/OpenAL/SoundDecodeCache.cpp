@@ -0,0 +1,252 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#include "SoundDecodeCache.h"
+
+#include <algorithm>
+
+#include "System/FileSystem/FileHandler.h"
+#include "System/Platform/Threading.h"
+#include "System/Sound/SoundLog.h"
+#include "lib/xxhash/xxh3.h"
+
+
+void CSoundDecodeCache::Init(size_t _maxBytes)
+{
+	Kill();
+
+	maxBytes = _maxBytes;
+	quit = false;
+
+	decodeThread = spring::thread(&CSoundDecodeCache::DecodeLoop, this);
+}
+
+void CSoundDecodeCache::Kill()
+{
+	{
+		std::lock_guard<spring::mutex> lck(mutex);
+
+		if (quit)
+			return;
+
+		quit = true;
+	}
+
+	cond.notify_all();
+
+	if (decodeThread.joinable())
+		decodeThread.join();
+
+	decodeQueue.clear();
+	pending.clear();
+	pathHashes.clear();
+	entries.clear();
+	failures.clear();
+
+	usedBytes.store(0, std::memory_order_relaxed);
+}
+
+
+void CSoundDecodeCache::Enqueue(const std::string& path)
+{
+	{
+		std::lock_guard<spring::mutex> lck(mutex);
+
+		if (quit)
+			return;
+		if (pending.find(path) != pending.end() || failures.find(path) != failures.end())
+			return;
+
+		const auto hashIt = pathHashes.find(path);
+
+		if (hashIt != pathHashes.end() && entries.find(hashIt->second) != entries.end())
+			return;
+
+		pending[path] = DECODE_QUEUED;
+		decodeQueue.push_back(path);
+	}
+
+	cond.notify_one();
+}
+
+CSoundDecodeCache::DecodedSoundPtr CSoundDecodeCache::Get(const std::string& path)
+{
+	{
+		std::unique_lock<spring::mutex> lck(mutex);
+
+		// wait out a decode that is already in progress rather than duplicating it
+		cond.wait(lck, [&]() {
+			const auto it = pending.find(path);
+			return (it == pending.end() || it->second != DECODE_ACTIVE);
+		});
+
+		if (failures.find(path) != failures.end())
+			return nullptr;
+
+		const auto hashIt = pathHashes.find(path);
+
+		if (hashIt != pathHashes.end()) {
+			const auto entryIt = entries.find(hashIt->second);
+
+			if (entryIt != entries.end()) {
+				entryIt->second.lastUse = ++useCounter;
+				numHits.fetch_add(1, std::memory_order_relaxed);
+				return entryIt->second.sound;
+			}
+		}
+
+		// claim it if still queued, the background thread skips claimed paths
+		pending.erase(path);
+	}
+
+	uint64_t hash = 0;
+	bool skipped = false;
+
+	DecodedSoundPtr sound = ReadAndDecode(path, false, hash, skipped);
+
+	std::lock_guard<spring::mutex> lck(mutex);
+
+	if (sound == nullptr) {
+		failures.insert(path);
+		return nullptr;
+	}
+
+	return (Insert(path, hash, std::move(sound)));
+}
+
+
+void CSoundDecodeCache::DecodeLoop()
+{
+	Threading::SetThreadName("sounddecode");
+
+	while (true) {
+		std::string path;
+
+		{
+			std::unique_lock<spring::mutex> lck(mutex);
+
+			cond.wait(lck, [&]() { return (quit || !decodeQueue.empty()); });
+
+			if (quit)
+				return;
+
+			path = std::move(decodeQueue.front());
+			decodeQueue.pop_front();
+
+			const auto it = pending.find(path);
+
+			// claimed by Get in the meantime
+			if (it == pending.end() || it->second != DECODE_QUEUED)
+				continue;
+
+			it->second = DECODE_ACTIVE;
+		}
+
+		uint64_t hash = 0;
+		bool skipped = false;
+
+		DecodedSoundPtr sound = ReadAndDecode(path, true, hash, skipped);
+
+		{
+			std::lock_guard<spring::mutex> lck(mutex);
+
+			pending.erase(path);
+
+			if (sound != nullptr) {
+				Insert(path, hash, std::move(sound));
+			} else if (!skipped) {
+				failures.insert(path);
+			}
+		}
+
+		cond.notify_all();
+	}
+}
+
+
+CSoundDecodeCache::DecodedSoundPtr CSoundDecodeCache::ReadAndDecode(const std::string& path, bool skipLarge, uint64_t& hash, bool& skipped)
+{
+	CFileHandler file(path, SPRING_VFS_RAW_FIRST);
+
+	if (!file.FileExists()) {
+		LOG_L(L_ERROR, "[SoundDecodeCache::%s] unable to open audio file \"%s\"", __func__, path.c_str());
+		return nullptr;
+	}
+
+	if (skipLarge && file.FileSize() > int(MAX_PREDECODE_FILE_SIZE)) {
+		skipped = true;
+		return nullptr;
+	}
+
+	std::vector<std::uint8_t> buffer = std::move(file.GetBuffer());
+
+	if (buffer.empty()) {
+		// copy file into buffer manually if not in VFS
+		buffer.resize(file.FileSize());
+		file.Read(buffer.data(), buffer.size());
+	}
+
+	// hash before decoding, the WAV decoder byte-swaps the header in place
+	hash = XXH3_64bits(buffer.data(), buffer.size());
+
+	{
+		std::lock_guard<spring::mutex> lck(mutex);
+
+		const auto entryIt = entries.find(hash);
+
+		// same content under another name
+		if (entryIt != entries.end())
+			return entryIt->second.sound;
+	}
+
+	std::shared_ptr<DecodedSound> sound = std::make_shared<DecodedSound>();
+
+	if (!SoundBuffer::Decode(path, file.GetFileExt(), buffer, *sound))
+		return nullptr;
+
+	numDecoded.fetch_add(1, std::memory_order_relaxed);
+	return sound;
+}
+
+CSoundDecodeCache::DecodedSoundPtr CSoundDecodeCache::Insert(const std::string& path, uint64_t hash, DecodedSoundPtr sound)
+{
+	pathHashes[path] = hash;
+
+	const auto entryIt = entries.find(hash);
+
+	if (entryIt != entries.end()) {
+		entryIt->second.lastUse = ++useCounter;
+		return entryIt->second.sound;
+	}
+
+	// too large to keep resident, the caller still gets it once
+	if (sound->data.size() > (maxBytes / 4))
+		return sound;
+
+	entries[hash] = {sound, ++useCounter};
+	usedBytes.fetch_add(sound->data.size(), std::memory_order_relaxed);
+
+	Evict(hash);
+	return sound;
+}
+
+void CSoundDecodeCache::Evict(uint64_t keepHash)
+{
+	while (usedBytes.load(std::memory_order_relaxed) > maxBytes) {
+		auto lruIt = entries.end();
+
+		for (auto it = entries.begin(); it != entries.end(); ++it) {
+			if (it->first == keepHash)
+				continue;
+			if (lruIt != entries.end() && lruIt->second.lastUse <= it->second.lastUse)
+				continue;
+
+			lruIt = it;
+		}
+
+		if (lruIt == entries.end())
+			break;
+
+		usedBytes.fetch_sub(lruIt->second.sound->data.size(), std::memory_order_relaxed);
+		entries.erase(lruIt);
+	}
+}
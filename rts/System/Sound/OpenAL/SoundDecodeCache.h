@@ -0,0 +1,99 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#ifndef SOUND_DECODE_CACHE_H
+#define SOUND_DECODE_CACHE_H
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <string>
+
+#include "SoundBuffer.h"
+#include "System/UnorderedMap.hpp"
+#include "System/UnorderedSet.hpp"
+#include "System/Threading/SpringThreading.h"
+
+/**
+ * @brief Decoded PCM data of sound files, shared by content hash
+ *
+ * Files can be queued for decoding on a background thread (e.g. all sounds
+ * referenced by unit- and weapon-defs during loading), so creating their
+ * buffer on first play only needs the OpenAL upload. Files with identical
+ * content are decoded once. The least recently used data is dropped when
+ * the cache grows beyond its size limit.
+ *
+ * Files larger than MAX_PREDECODE_FILE_SIZE (long ambient tracks) are not
+ * decoded in the background, and decoded data taking more than a quarter
+ * of the size limit is handed out once but never kept resident.
+ */
+class CSoundDecodeCache
+{
+public:
+	typedef std::shared_ptr<const DecodedSound> DecodedSoundPtr;
+
+	static constexpr size_t MAX_PREDECODE_FILE_SIZE = 1024 * 1024;
+
+public:
+	~CSoundDecodeCache() { Kill(); }
+
+	void Init(size_t maxBytes);
+	void Kill();
+
+	/// queues path for background decoding, no-op if it is known already
+	void Enqueue(const std::string& path);
+
+	/**
+	 * Returns the decoded data for path, decoding it on the calling thread
+	 * if the background thread did not get to it yet; nullptr on failure.
+	 */
+	DecodedSoundPtr Get(const std::string& path);
+
+	size_t GetUsedBytes() const { return usedBytes.load(std::memory_order_relaxed); }
+	size_t GetNumDecoded() const { return numDecoded.load(std::memory_order_relaxed); }
+	size_t GetNumHits() const { return numHits.load(std::memory_order_relaxed); }
+
+private:
+	enum DecodeState {
+		DECODE_QUEUED = 0,
+		DECODE_ACTIVE = 1,
+	};
+
+	struct CacheEntry {
+		DecodedSoundPtr sound;
+		uint64_t lastUse = 0;
+	};
+
+	void DecodeLoop();
+
+	/// reads and decodes path; skipLarge leaves files above MAX_PREDECODE_FILE_SIZE alone
+	DecodedSoundPtr ReadAndDecode(const std::string& path, bool skipLarge, uint64_t& hash, bool& skipped);
+
+	/// mutex must be held
+	DecodedSoundPtr Insert(const std::string& path, uint64_t hash, DecodedSoundPtr sound);
+	void Evict(uint64_t keepHash);
+
+private:
+	spring::thread decodeThread;
+
+	mutable spring::mutex mutex;
+	spring::condition_variable_any cond;
+
+	std::deque<std::string> decodeQueue;
+
+	spring::unordered_map<std::string, DecodeState> pending;
+	spring::unordered_map<std::string, uint64_t> pathHashes;
+	spring::unordered_map<uint64_t, CacheEntry> entries;
+	spring::unordered_set<std::string> failures;
+
+	uint64_t useCounter = 0;
+	size_t maxBytes = 0;
+
+	std::atomic<size_t> usedBytes = {0};
+	std::atomic<size_t> numDecoded = {0};
+	std::atomic<size_t> numHits = {0};
+
+	bool quit = true;
+};
+
+#endif
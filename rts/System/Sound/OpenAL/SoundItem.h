@@ -37,6 +37,10 @@ public:
 	float MaxDistance() const { return maxDist; }
 	const std::string& Name() const { return name; }
 	int GetPriority() const { return priority; }
+	unsigned GetLoopTime() const { return loopTime; }
+
+	/// gain without the random modifier
+	float GetBaseGain() const { return gain; }
 
 	float GetGain() const;
 	float GetPitch() const;
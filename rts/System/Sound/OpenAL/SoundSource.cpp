@@ -23,6 +23,8 @@
 
 static constexpr float ROLLOFF_FACTOR = 5.0f;
 static constexpr float REFERENCE_DIST = 200.0f;
+// requests for the same item closer than this are heard as one sound
+static constexpr float MERGE_DIST = 64.0f;
 
 
 // used to adjust the pitch to the GameSpeed (optional)
@@ -200,7 +202,7 @@ void CSoundSource::Stop()
 	CheckError("CSoundSource::Stop");
 }
 
-void CSoundSource::Play(IAudioChannel* channel, SoundItem* item, float3 pos, float3 velocity, float volume, bool relative)
+void CSoundSource::Play(IAudioChannel* channel, SoundItem* item, float3 pos, float3 velocity, float volume, bool relative, float offset)
 {
 	assert(!curStream);
 	assert(channel);
@@ -215,6 +217,7 @@ void CSoundSource::Play(IAudioChannel* channel, SoundItem* item, float3 pos, flo
 	curVolume = volume;
 	curPlayingItem = {item->soundItemID,  item->loopTime, item->priority,  item->GetGain(), item->rolloff};
 	curChannel = channel;
+	curChannel->SoundSourceStarted(this);
 
 	alSourcei(id, AL_BUFFER, itemBuffer.GetId());
 	alSourcef(id, AL_GAIN, volume * item->GetGain() * channel->volume);
@@ -280,6 +283,11 @@ void CSoundSource::Play(IAudioChannel* channel, SoundItem* item, float3 pos, flo
 #endif
 
 	}
+
+	// virtual voices resume where they would be by now
+	if (offset > 0.0f)
+		alSourcef(id, AL_SEC_OFFSET, offset);
+
 	alSourcePlay(id);
 
 	if (itemBuffer.GetId() == 0)
@@ -304,6 +312,18 @@ void CSoundSource::PlayAsync(IAudioChannel* channel, size_t id, float3 pos, floa
 }
 
 
+bool CSoundSource::MergeAsync(size_t id, const float3& pos, float volume)
+{
+	if (asyncPlayItem.id != id || asyncPlayItem.relative)
+		return false;
+	if (asyncPlayItem.position.SqDistance(pos) > (MERGE_DIST * MERGE_DIST))
+		return false;
+
+	asyncPlayItem.volume = std::max(asyncPlayItem.volume, volume);
+	return true;
+}
+
+
 void CSoundSource::PlayStream(IAudioChannel* channel, const std::string& file, float volume)
 {
 	// stop any current playback
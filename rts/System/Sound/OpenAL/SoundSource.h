@@ -44,8 +44,10 @@ public:
 	void Stop();
 
 	/// will stop a currently playing sound, if any
-	void Play(IAudioChannel* channel, SoundItem* item, float3 pos, float3 velocity, float volume, bool relative = false);
+	void Play(IAudioChannel* channel, SoundItem* item, float3 pos, float3 velocity, float volume, bool relative = false, float offset = 0.0f);
 	void PlayAsync(IAudioChannel* channel, size_t id, float3 pos, float3 velocity, float volume, float priority, bool relative = false);
+	/// raises the volume of a pending PlayAsync request for the same item near pos, if any
+	bool MergeAsync(size_t id, const float3& pos, float volume);
 	void PlayStream(IAudioChannel* channel, const std::string& file, float volume);
 	void StreamStop();
 	void StreamPause();
@@ -35,6 +35,7 @@
 #include "Game/Game.h"
 #include "Game/GlobalUnsynced.h"
 #include "Game/PreGame.h"
+#include "Game/SimBenchmark.h"
 #include "Game/UI/KeyBindings.h"
 #include "Game/UI/KeyCodes.h"
 #include "Game/UI/ScanCodes.h"
@@ -156,6 +157,10 @@ DEFINE_string_EX(calc_checksum,      "calc-checksum",      "",    "Calculate nam
  * the same port number is heavily reused across many replays. Forcing onlyLocal solves this. */
 DEFINE_bool_EX  (onlyLocal,              "only-local",     false, "Force OnlyLocal mode (no network listening sockets). Use for parallelized watching of multiplayer replays");
 
+DEFINE_int32_EX (benchmark_frames,   "benchmark-frames",   0,                "Run the game at maximum speed for this many sim frames, write a profiling report and quit");
+DEFINE_string_EX(benchmark_output,   "benchmark-output",   "benchmark.json", "File the --benchmark-frames report is written to");
+DEFINE_string_EX(benchmark_commands, "benchmark-commands", "",               "File with actions (one per line, e.g. cheat or give) issued when a --benchmark-frames run starts");
+
 
 
 int spring::exitCode = spring::EXIT_CODE_SUCCESS;
@@ -573,6 +578,7 @@ void SpringApp::ParseCmdLine(int argc, char* argv[])
 	CTextureAtlas::SetDebug(FLAGS_textureatlas);
 
 	CGameSetup::forceOnlyLocal = FLAGS_onlyLocal;
+	CSimBenchmark::SetParams(FLAGS_benchmark_frames, FLAGS_benchmark_output, FLAGS_benchmark_commands);
 
 	// if this fails, configHandler remains null
 	// logOutput's init depends on configHandler
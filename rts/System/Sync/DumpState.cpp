@@ -2,6 +2,7 @@
 
 #include <string>
 #include <fstream>
+#include <sstream>
 #include <vector>
 #include <list>
 
@@ -45,6 +46,68 @@
 
 static bool onlyHash = true;
 
+
+// offsets of the sections and objects within the text of one dumped frame
+struct DumpStateIndex {
+public:
+	enum {
+		OBJECT_UNIT       = 0,
+		OBJECT_FEATURE    = 1,
+		OBJECT_PROJECTILE = 2,
+		OBJECT_COUNT      = 3,
+	};
+
+	void AddSection(const char* name, std::ostringstream& s) { sections.emplace_back(name, size_t(s.tellp())); }
+	void AddObject(int type, int id, std::ostringstream& s) { objects[type].emplace_back(id, size_t(s.tellp())); }
+
+	void Write(std::ostream& out, const std::string& text) const {
+		constexpr const char* objectNames[OBJECT_COUNT] = {"unitHashes", "featureHashes", "projectileHashes"};
+
+		out << "\tsectionHashes:";
+
+		for (size_t i = 0; i < sections.size(); i++) {
+			out << " " << sections[i].first << "=" << HashRange(text, sections[i].second, SectionEnd(sections[i].second, text));
+		}
+
+		out << "\n";
+
+		for (int type = 0; type < OBJECT_COUNT; type++) {
+			if (objects[type].empty())
+				continue;
+
+			out << "\t" << objectNames[type] << ":";
+
+			// an object ends where the next one starts, the last one at the end of its section
+			for (size_t i = 0; i < objects[type].size(); i++) {
+				const size_t beg = objects[type][i].second;
+				const size_t end = (i + 1 < objects[type].size())? objects[type][i + 1].second: SectionEnd(beg, text);
+
+				out << " " << objects[type][i].first << ":" << HashRange(text, beg, end);
+			}
+
+			out << "\n";
+		}
+	}
+
+private:
+	size_t SectionEnd(size_t pos, const std::string& text) const {
+		for (const auto& section: sections) {
+			if (section.second > pos)
+				return section.second;
+		}
+
+		return text.size();
+	}
+
+	static uint32_t HashRange(const std::string& text, size_t beg, size_t end) {
+		return spring::LiteHash(text.data() + beg, end - beg);
+	}
+
+private:
+	std::vector<std::pair<const char*, size_t>> sections;
+	std::vector<std::pair<int, size_t>> objects[OBJECT_COUNT];
+};
+
 namespace {
 	inline std::string TapFloats(const float v) {
 		std::ostringstream str;
@@ -116,7 +179,7 @@ void DumpState(int newMinFrameNum, int newMaxFrameNum, int newFramePeriod, std::
 	if (outputFloats.has_value())
 		onlyHash = !outputFloats.value();
 
-	static std::fstream file;
+	static std::fstream dumpFile;
 	static int gMinFrameNum = -1;
 	static int gMaxFrameNum = -1;
 	static int gFramePeriod =  1;
@@ -139,9 +202,9 @@ void DumpState(int newMinFrameNum, int newMaxFrameNum, int newFramePeriod, std::
 	if ((gMinFrameNum != oldMinFrameNum) || (gMaxFrameNum != oldMaxFrameNum)) {
 		LOG("[%s] dumping state (from %d to %d step %d)", __func__, gMinFrameNum, gMaxFrameNum, gFramePeriod);
 		// bounds changed, open a new file
-		if (file.is_open()) {
-			file.flush();
-			file.close();
+		if (dumpFile.is_open()) {
+			dumpFile.flush();
+			dumpFile.close();
 		}
 
 		gHistoryFrame = historyFrame.value_or(-1);
@@ -155,24 +218,24 @@ void DumpState(int newMinFrameNum, int newMaxFrameNum, int newFramePeriod, std::
 		name += IntToString(gMaxFrameNum);
 		name += "].txt";
 
-		file.open(name.c_str(), std::ios::out);
-
-		if (file.is_open()) {
-			file << " mapName: " << gameSetup->mapName << "\n";
-			file << " modName: " << gameSetup->modName << "\n";
-			file << "minFrame: " << gMinFrameNum << "\n";
-			file << "maxFrame: " << gMaxFrameNum << "\n";
-			file << "randSeed: " << gsRNG.GetLastSeed() << "\n";
-			file << "initSeed: " << gsRNG.GetInitSeed() << "\n";
-			file << "genState: " << gsRNG.GetGenState() << "\n";
-			file << "  gameID: " << DumpGameID(game->gameID) << "\n";
-			file << " syncVer: " << SpringVersion::GetSync() << "\n";
+		dumpFile.open(name.c_str(), std::ios::out);
+
+		if (dumpFile.is_open()) {
+			dumpFile << " mapName: " << gameSetup->mapName << "\n";
+			dumpFile << " modName: " << gameSetup->modName << "\n";
+			dumpFile << "minFrame: " << gMinFrameNum << "\n";
+			dumpFile << "maxFrame: " << gMaxFrameNum << "\n";
+			dumpFile << "randSeed: " << gsRNG.GetLastSeed() << "\n";
+			dumpFile << "initSeed: " << gsRNG.GetInitSeed() << "\n";
+			dumpFile << "genState: " << gsRNG.GetGenState() << "\n";
+			dumpFile << "  gameID: " << DumpGameID(game->gameID) << "\n";
+			dumpFile << " syncVer: " << SpringVersion::GetSync() << "\n";
 		}
 
 		LOG("[%s] using dump-file \"%s\"", __func__, name.c_str());
 	}
 
-	if (file.bad() || !file.is_open())
+	if (dumpFile.bad() || !dumpFile.is_open())
 		return;
 	// check if the CURRENT frame lies within the bounds
 	if (gs->frameNum < gMinFrameNum)
@@ -187,7 +250,16 @@ void DumpState(int newMinFrameNum, int newMaxFrameNum, int newFramePeriod, std::
 	const auto& activeFeatureIDs = featureHandler.GetActiveFeatureIDs();
 	const auto& projectiles = projectileHandler.GetActiveProjectiles(true);
 
-	file << "frame: " << gs->frameNum << ", seed: " << gsRNG.GetLastSeed() << "\n";
+	// the frame is assembled in memory such that an index of section and object
+	// hashes can be written in front of it; comparing the index lines of client
+	// and server dumps points at the first differing section and object without
+	// having to diff the full text
+	const auto frameSeed = gsRNG.GetLastSeed();
+
+	std::ostringstream file;
+	DumpStateIndex index;
+
+	index.AddSection("setup", file);
 
 	#define DUMP_MATH_CONST
 	#define DUMP_MODEL_DATA
@@ -326,10 +398,13 @@ void DumpState(int newMinFrameNum, int newMaxFrameNum, int newFramePeriod, std::
 	}
 	#endif
 
+	index.AddSection("units", file);
 	file << "\tunits: " << activeUnits.size() << "\n";
 
 	#ifdef DUMP_UNIT_DATA
 	for (const CUnit* u: activeUnits) {
+		index.AddObject(DumpStateIndex::OBJECT_UNIT, u->id, file);
+
 		const std::vector<CWeapon*>& weapons = u->weapons;
 		const LocalModel& lm = u->localModel;
 		const std::vector<LocalModelPiece>& pieces = lm.pieces;
@@ -452,6 +527,7 @@ void DumpState(int newMinFrameNum, int newMaxFrameNum, int newFramePeriod, std::
 		}
 		#endif
 	}
+	index.AddSection("unitsRemovedAndScripts", file);
 	file << "\tunitsToBeRemoved: " << unitHandler.GetUnitsToBeRemoved().size() << "\n";
 	for (auto* u : unitHandler.GetUnitsToBeRemoved()) {
 		file << "\t\tunitID: " << u->id << " (name: " << u->unitDef->name << ")\n";
@@ -477,24 +553,25 @@ void DumpState(int newMinFrameNum, int newMaxFrameNum, int newFramePeriod, std::
 		}
 		file << "\n";
 
-		auto zzzThreads = cobEngine->GetSleepingThreadIDs(); //copied on purpose
+		const auto zzzThreads = cobEngine->GetSleepingThreadIDs();
 		file << "\t\tSleepingThreads: " << zzzThreads.size();
 		file << "\t\t\twts|ids:";
-		while (!zzzThreads.empty()) {
-			const auto& zt = zzzThreads.top();
+		for (const auto& zt: zzzThreads) {
 			file << " " << zt.wt << "|" << zt.id;
-			zzzThreads.pop();
 		}
 		file << "\n";
 	}
 	#endif
 
+	index.AddSection("features", file);
 	file << "\tfeatures: " << activeFeatureIDs.size() << "\n";
 
 	#ifdef DUMP_FEATURE_DATA
 	for (const int featureID: activeFeatureIDs) {
 		const CFeature* f = featureHandler.GetFeature(featureID);
 
+		index.AddObject(DumpStateIndex::OBJECT_FEATURE, f->id, file);
+
 		const auto& pos  = f->pos;
 		const auto& xdir = f->rightdir;
 		const auto& ydir = f->updir;
@@ -515,10 +592,12 @@ void DumpState(int newMinFrameNum, int newMaxFrameNum, int newFramePeriod, std::
 	}
 	#endif
 
+	index.AddSection("projectiles", file);
 	file << "\tprojectiles: " << projectiles.size() << "\n";
 
 	#ifdef DUMP_PROJECTILE_DATA
 	for (const CProjectile* p: projectiles) {
+		index.AddObject(DumpStateIndex::OBJECT_PROJECTILE, p->id, file);
 		file << "\t\tprojectileID: " << p->id << "\n";
 		file << "\t\t\tpos: <" << TapFloats(p->pos);
 		file << "\t\t\tdir: <" << TapFloats(p->dir);
@@ -528,6 +607,7 @@ void DumpState(int newMinFrameNum, int newMaxFrameNum, int newFramePeriod, std::
 	}
 	#endif
 
+	index.AddSection("teams", file);
 	file << "\tteams: " << teamHandler.ActiveTeams() << "\n";
 
 	#ifdef DUMP_TEAM_DATA
@@ -585,6 +665,8 @@ void DumpState(int newMinFrameNum, int newMaxFrameNum, int newFramePeriod, std::
 	}
 	#endif
 
+	index.AddSection("map", file);
+
 	const auto heightmap = readMap->GetCornerHeightMapSynced();
 	const auto centerNormals = readMap->GetCenterNormalsSynced();
 	const auto faceNormals = readMap->GetFaceNormalsSynced();
@@ -658,11 +740,19 @@ void DumpState(int newMinFrameNum, int newMaxFrameNum, int newFramePeriod, std::
 	file << "\tsmoothMesh checksum as uint32t: " << smCs << "\n";
 	#endif
 
-	file.flush();
+	{
+		const std::string frameText = file.str();
+
+		dumpFile << "frame: " << gs->frameNum << ", seed: " << frameSeed << "\n";
+		index.Write(dumpFile, frameText);
+		dumpFile << frameText;
+	}
+
+	dumpFile.flush();
 	if (gs->frameNum == gMaxFrameNum) {
 		if (gHistoryFrame > -1)
-			DumpHistory(file, gHistoryFrame, serverRequest);
-		file.close();
+			DumpHistory(dumpFile, gHistoryFrame, serverRequest);
+		dumpFile.close();
 	}
 
 	gMinFrameNum = -1;
@@ -35,7 +35,24 @@ class CSyncChecker {
 		static unsigned GetChecksum() { return g_checksum; }
 		static void NewFrame();
 		static void debugSyncCheckThreading();
-		static void Sync(const void* p, unsigned size);
+
+		/**
+		 * Called for every assignment to a synced variable, so kept inline:
+		 * sizes are mostly compile-time constants (sizeof a SyncedPrimitive)
+		 * which lets XXH3 reduce to its short-input path without a call.
+		 */
+		static void Sync(const void* p, unsigned size) {
+		#ifdef DEBUG_SYNC_MT_CHECK
+			// Sync calls should not be occurring in multi-threaded sections
+			debugSyncCheckThreading();
+		#endif
+			// simple xor is not enough to detect multiple zeroes, e.g.
+			g_checksum = spring::LiteHash(p, size, g_checksum);
+
+		#ifdef SYNC_HISTORY
+			LogHistory();
+		#endif // SYNC_HISTORY
+		}
 		#ifdef SYNC_HISTORY
 		static std::tuple<unsigned, unsigned, unsigned*> GetFrameHistory(unsigned rewindFrames);
 		static std::pair<unsigned, unsigned*> GetHistory() { return std::make_pair(nextHistoryIndex, logs.data()); };
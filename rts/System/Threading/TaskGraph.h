@@ -0,0 +1,131 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#ifndef _TASK_GRAPH_H
+#define _TASK_GRAPH_H
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <vector>
+
+#include "System/Misc/SpringTime.h"
+#include "System/Threading/ThreadPool.h"
+
+/**
+ * Runs a fixed list of stages that declare which subsystems they read and
+ * write (as caller-defined bitmasks). Two stages conflict if either writes
+ * something the other one touches; conflicting stages always run in the
+ * order they were added, the others may overlap. The outcome is therefore
+ * the same as running all stages in order, provided the declarations hold.
+ *
+ * Stages that call into Lua, use (non-MT) profiler timers or GL have to be
+ * marked as main-thread stages, those run on the calling thread in order.
+ */
+class CTaskGraph {
+public:
+	typedef uint32_t AccessMask;
+
+	static constexpr AccessMask ACCESS_ALL = ~AccessMask(0);
+
+	struct Stage {
+		std::function<void()> func;
+
+		const char* name;
+
+		AccessMask reads;
+		AccessMask writes;
+
+		bool mainThread;
+	};
+
+public:
+	void AddStage(const char* name, AccessMask reads, AccessMask writes, bool mainThread, std::function<void()>&& func) {
+		stages.push_back({std::move(func), name, reads, writes, mainThread});
+		stageTimes.push_back(0.0f);
+		levels.clear();
+	}
+
+	void Clear() {
+		stages.clear();
+		stageTimes.clear();
+		levels.clear();
+	}
+
+	void Run() {
+		if (levels.empty())
+			BuildLevels();
+
+		for (const std::vector<size_t>& level: levels) {
+			workerTasks.clear();
+
+			// push worker stages first so they can start while we run ours
+			for (const size_t i: level) {
+				if (stages[i].mainThread)
+					continue;
+
+				workerTasks.push_back(ThreadPool::Enqueue([this, i]() { RunStage(i); }));
+			}
+
+			for (const size_t i: level) {
+				if (!stages[i].mainThread)
+					continue;
+
+				RunStage(i);
+			}
+
+			// also rethrows any exception a worker stage raised
+			for (auto& task: workerTasks) {
+				task.get();
+			}
+		}
+	}
+
+	const std::vector<Stage>& GetStages() const { return stages; }
+	size_t GetNumLevels() const { return levels.size(); }
+
+	/// wall-time the stage took during the last Run
+	float GetStageTime(size_t i) const { return stageTimes[i]; }
+
+private:
+	void RunStage(size_t i) {
+		const spring_time t0 = spring_gettime();
+		stages[i].func();
+		stageTimes[i] = (spring_gettime() - t0).toMilliSecsf();
+	}
+
+	static bool Conflicts(const Stage& a, const Stage& b) {
+		return (((a.writes & (b.reads | b.writes)) | (b.writes & a.reads)) != 0);
+	}
+
+	// each stage goes into the level after the last earlier stage it conflicts with
+	void BuildLevels() {
+		std::vector<size_t> stageLevels(stages.size(), 0);
+
+		for (size_t i = 0; i < stages.size(); i++) {
+			for (size_t j = 0; j < i; j++) {
+				if (!Conflicts(stages[i], stages[j]))
+					continue;
+
+				stageLevels[i] = std::max(stageLevels[i], stageLevels[j] + 1);
+			}
+
+			if (stageLevels[i] >= levels.size())
+				levels.resize(stageLevels[i] + 1);
+
+			levels[stageLevels[i]].push_back(i);
+		}
+	}
+
+private:
+	std::vector<Stage> stages;
+	std::vector<std::vector<size_t>> levels;
+
+	// each slot is written by the thread running its stage only
+	std::vector<float> stageTimes;
+
+	std::vector<std::shared_future<void>> workerTasks;
+};
+
+#endif
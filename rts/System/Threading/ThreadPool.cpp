@@ -17,6 +17,7 @@
 #include "System/Platform/CpuTopology.h"
 #include "System/Platform/Threading.h"
 #include "System/Threading/SpringThreading.h"
+#include "System/Threading/WorkStealingDeque.h"
 
 #ifdef   likely
 #undef   likely
@@ -26,6 +27,7 @@
 #include <utility>
 #include <functional>
 #include <cinttypes>
+#include <deque>
 
 #define USE_TASK_STATS_TRACKING
 
@@ -58,6 +60,23 @@ struct ThreadStats {
 
 
 
+// accumulated by each (non-async) pool thread for itself, sampled by UpdateLoadStats
+struct alignas(64) ThreadLoadCounters {
+	std::atomic<uint64_t> busyTime = {0}; // ns
+	std::atomic<uint64_t> stealTime = {0};
+	std::atomic<uint64_t> spinTime = {0};
+	std::atomic<uint64_t> sleepTime = {0};
+};
+
+struct ThreadLoadSample {
+	uint64_t busyTime = 0;
+	uint64_t stealTime = 0;
+	uint64_t spinTime = 0;
+	uint64_t sleepTime = 0;
+};
+
+
+
 // external background threads which are only joined on exit
 static std::vector< spring::thread > extThreads;
 static std::vector< std::future<void> > extFutures;
@@ -73,12 +92,29 @@ static std::array<boost::lockfree::queue<ITaskGroup*>, ThreadPool::MAX_THREADS>
 static std::array<moodycamel::ConcurrentQueue<ITaskGroup*>, ThreadPool::MAX_THREADS> taskQueues[2];
 #endif
 
+// per-thread Chase-Lev deques for (sync) slice-tasks that any thread may help
+// execute, see PushStealableTaskGroup; every thread not in the pool also has
+// id 0, so owner-side access to the main deque is serialized by a lock
+static std::array<WorkStealingDeque<ITaskGroup>, ThreadPool::MAX_THREADS> stealQueues;
+static spring::spinlock mainStealQueueLock;
+
 static std::vector<void*> workerThreads[2];
 static std::array<bool, ThreadPool::MAX_THREADS> exitFlags;
 static std::array<ThreadStats, ThreadPool::MAX_THREADS> threadStats[2];
 static spring::signal newTasksSignal[2];
 
 static _threadlocal int threadnum(0);
+// >0 while the thread is running a task; waits nested in tasks count as busy
+static _threadlocal int taskDepth(0);
+
+static std::array<ThreadLoadCounters, ThreadPool::MAX_THREADS> threadLoadCounters;
+static std::array<ThreadLoadSample, ThreadPool::MAX_THREADS> threadLoadSamples;
+static std::array<ThreadPool::ThreadLoad, ThreadPool::MAX_THREADS> threadLoads;
+static spring_time lastLoadSampleTime;
+static size_t lastQueueDepth = 0;
+
+static std::deque<ThreadPool::ForSiteStats> forSiteStats;
+static spring::spinlock forSiteStatsLock;
 
 #ifndef UNITSYNC
 // if enabled, allows OpenGL calls from ThreadPool tasks
@@ -133,6 +169,40 @@ bool HasThreads() { return !workerThreads[false].empty(); }
 
 
 
+static void PushStealQueue(int tid, ITaskGroup* tg)
+{
+	tg->numStealRefs.fetch_add(1, std::memory_order_relaxed);
+
+	if (tid != 0) {
+		stealQueues[tid].Push(tg);
+		return;
+	}
+
+	std::lock_guard<spring::spinlock> lck(mainStealQueueLock);
+	stealQueues[0].Push(tg);
+}
+
+static ITaskGroup* PopStealQueue(int tid)
+{
+	if (tid != 0)
+		return (stealQueues[tid].Pop());
+
+	std::lock_guard<spring::spinlock> lck(mainStealQueueLock);
+	return (stealQueues[0].Pop());
+}
+
+static uint64_t RunTaskGroup(int tid, bool async, ITaskGroup* tg, std::atomic<uint64_t> ThreadLoadCounters::* loadTime)
+{
+	taskDepth += 1;
+	const uint64_t edt = tg->ExecuteLoop(tid, false);
+	taskDepth -= 1;
+
+	if (!async && taskDepth == 0)
+		(threadLoadCounters[tid].*loadTime).fetch_add(edt, std::memory_order_relaxed);
+
+	return edt;
+}
+
 static bool DoTask(int tid, bool async)
 {
 	#ifndef UNIT_TEST
@@ -162,7 +232,7 @@ static bool DoTask(int tid, bool async)
 
 			#ifdef USE_TASK_STATS_TRACKING
 			const uint64_t wdt = tg->GetDeltaTime(spring_now());
-			const uint64_t edt = tg->ExecuteLoop(tid, false);
+			const uint64_t edt = RunTaskGroup(tid, async, tg, &ThreadLoadCounters::busyTime);
 
 			threadStats[async][tid].numTasksRun += 1;
 			threadStats[async][tid].sumExecTime += edt;
@@ -172,7 +242,7 @@ static bool DoTask(int tid, bool async)
 			threadStats[async][tid].minWaitTime  = std::min(threadStats[async][tid].minWaitTime, wdt);
 			threadStats[async][tid].maxWaitTime  = std::max(threadStats[async][tid].maxWaitTime, wdt);
 			#else
-			tg->ExecuteLoop(tid, false);
+			RunTaskGroup(tid, async, tg, &ThreadLoadCounters::busyTime);
 			#endif
 		}
 
@@ -185,7 +255,7 @@ static bool DoTask(int tid, bool async)
 
 			#ifdef USE_TASK_STATS_TRACKING
 			const uint64_t wdt = tg->GetDeltaTime(spring_now());
-			const uint64_t edt = tg->ExecuteLoop(tid, false);
+			const uint64_t edt = RunTaskGroup(tid, async, tg, &ThreadLoadCounters::busyTime);
 
 			threadStats[async][tid].numTasksRun += 1;
 			threadStats[async][tid].sumExecTime += edt;
@@ -195,13 +265,48 @@ static bool DoTask(int tid, bool async)
 			threadStats[async][tid].minWaitTime  = std::min(threadStats[async][tid].minWaitTime, wdt);
 			threadStats[async][tid].maxWaitTime  = std::max(threadStats[async][tid].maxWaitTime, wdt);
 			#else
-			tg->ExecuteLoop(tid, false);
+			RunTaskGroup(tid, async, tg, &ThreadLoadCounters::busyTime);
 			#endif
 		}
 	}
 
-	// if true, queue contained at least one element
-	return (tg != nullptr);
+	if (tg != nullptr || async)
+		return (tg != nullptr);
+
+	// no queued work, help with stealable groups instead (own deque first)
+	const bool stolen = ((tg = PopStealQueue(tid)) == nullptr);
+
+	if (stolen) {
+		const int numThreads = GetNumThreads();
+
+		for (int i = 1; i < numThreads && tg == nullptr; i++) {
+			tg = stealQueues[(tid + i) % numThreads].Steal();
+		}
+	}
+
+	if (tg == nullptr)
+		return false;
+
+	// republish while slices remain s.t. further idle threads can steal from us
+	if (tg->HasUnclaimedSteps()) {
+		PushStealQueue(tid, tg);
+		NotifyWorkerThreads(true, false);
+	}
+
+	#ifdef USE_TASK_STATS_TRACKING
+	const uint64_t edt = RunTaskGroup(tid, async, tg, stolen? &ThreadLoadCounters::stealTime: &ThreadLoadCounters::busyTime);
+
+	threadStats[async][tid].numTasksRun += 1;
+	threadStats[async][tid].sumExecTime += edt;
+	threadStats[async][tid].minExecTime  = std::min(threadStats[async][tid].minExecTime, edt);
+	threadStats[async][tid].maxExecTime  = std::max(threadStats[async][tid].maxExecTime, edt);
+	#else
+	RunTaskGroup(tid, async, tg, stolen? &ThreadLoadCounters::stealTime: &ThreadLoadCounters::busyTime);
+	#endif
+
+	// only now may the owner recycle the group
+	tg->numStealRefs.fetch_sub(1, std::memory_order_release);
+	return true;
 }
 
 
@@ -222,15 +327,29 @@ static void WorkerLoop(int tid, bool async)
 	const auto ourSpinTime = spring_time::fromMicroSecs(30 * (tid == 1));
 	const auto maxSleepTime = spring_time::fromMilliSecs(30);
 
+	ThreadLoadCounters& loadCounters = threadLoadCounters[tid];
+
 	while (!exitFlags[tid]) {
 		const auto spinlockEnd = spring_now() + ourSpinTime;
 		      auto sleepTime   = spring_time::fromMicroSecs(1);
+		      auto pollTime    = spring_now();
 
 		while (!DoTask(tid, async) && !exitFlags[tid]) {
-			if (spring_now() < spinlockEnd)
+			const auto curTime = spring_now();
+
+			if (!async)
+				loadCounters.spinTime.fetch_add((curTime - pollTime).toNanoSecsi(), std::memory_order_relaxed);
+
+			pollTime = curTime;
+
+			if (curTime < spinlockEnd)
 				continue;
 
 			newTasksSignal[async].wait_for(sleepTime = std::min(sleepTime * 1.25f, maxSleepTime));
+			pollTime = spring_now();
+
+			if (!async)
+				loadCounters.sleepTime.fetch_add((pollTime - curTime).toNanoSecsi(), std::memory_order_relaxed);
 		}
 	}
 }
@@ -251,7 +370,12 @@ void WaitForFinished(std::shared_ptr<ITaskGroup>&& taskGroup)
 
 		assert(!taskGroup->IsAsyncTask());
 		assert(!taskGroup->SelfDelete());
-		taskGroup->ExecuteLoop(tid, true);
+
+		// the caller's own slices
+		const uint64_t edt = taskGroup->ExecuteLoop(tid, true);
+
+		if (taskDepth == 0)
+			threadLoadCounters[tid].busyTime.fetch_add(edt, std::memory_order_relaxed);
 	}
 
 	// NOTE:
@@ -261,7 +385,7 @@ void WaitForFinished(std::shared_ptr<ITaskGroup>&& taskGroup)
 	//   under that condition could cause the group to be deleted
 	//   or reassigned prematurely) --> wait
 	if (taskGroup->IsFinished()) {
-		while (taskGroup->IsInJobQueue()) {
+		while (taskGroup->IsInJobQueue() || taskGroup->IsInStealQueue()) {
 			DoTask(tid, false);
 		}
 
@@ -273,6 +397,11 @@ void WaitForFinished(std::shared_ptr<ITaskGroup>&& taskGroup)
 	// task hasn't completed yet, use waiting time to execute other tasks
 	NotifyWorkerThreads(true, false);
 
+	ThreadLoadCounters& loadCounters = threadLoadCounters[tid];
+
+	const auto waitStartTime = spring_now();
+	const uint64_t waitStartWork = loadCounters.busyTime.load(std::memory_order_relaxed) + loadCounters.stealTime.load(std::memory_order_relaxed);
+
 	do {
 		const auto spinlockEnd = spring_now() + spring_time::fromMilliSecs(500);
 
@@ -286,7 +415,16 @@ void WaitForFinished(std::shared_ptr<ITaskGroup>&& taskGroup)
 		}
 	} while (!taskGroup->IsFinished() && !exitFlags[tid]);
 
-	while (taskGroup->IsInJobQueue()) {
+	// whatever part of the wait was not spent running other tasks was spent spinning
+	if (taskDepth == 0) {
+		const uint64_t waitTime = (spring_now() - waitStartTime).toNanoSecsi();
+		const uint64_t waitWork = loadCounters.busyTime.load(std::memory_order_relaxed) + loadCounters.stealTime.load(std::memory_order_relaxed) - waitStartWork;
+
+		loadCounters.spinTime.fetch_add(waitTime - std::min(waitTime, waitWork), std::memory_order_relaxed);
+	}
+
+	// stale deque entries must be drained (by whichever thread) before reuse
+	while (taskGroup->IsInJobQueue() || taskGroup->IsInStealQueue()) {
 		DoTask(tid, false);
 	}
 
@@ -329,6 +467,122 @@ void PushTaskGroup(ITaskGroup* taskGroup)
 	#endif
 }
 
+// only for slice-tasks (for_mt) whose ExecuteLoop may run concurrently on
+// any number of threads; the group stays alive until WaitForFinished has
+// seen all of its deque entries executed
+void PushStealableTaskGroup(ITaskGroup* taskGroup)
+{
+	assert(taskGroup->IsSliceTask());
+	assert(!taskGroup->IsAsyncTask());
+
+	taskGroup->SetTimeStamp(spring_now());
+
+	PushStealQueue(GetThreadNum(), taskGroup);
+	NotifyWorkerThreads(false, false);
+}
+
+ForSiteStats& RegisterForSite(const std::source_location& loc)
+{
+	std::lock_guard<spring::spinlock> lck(forSiteStatsLock);
+	return (forSiteStats.emplace_back(loc));
+}
+
+void UpdateLoadStats()
+{
+	// Tracy keys plots by pointer
+	static std::array<std::array<std::string, 4>, MAX_THREADS> plotNames;
+
+	const spring_time curTime = spring_now();
+	const float invTime = 1.0f / std::max((curTime - lastLoadSampleTime).toNanoSecsf(), 1.0f);
+
+	const auto SampleDelta = [invTime](std::atomic<uint64_t>& counter, uint64_t& sample) {
+		const uint64_t value = counter.load(std::memory_order_relaxed);
+		const float delta = std::min((value - sample) * invTime, 1.0f);
+
+		sample = value;
+		return delta;
+	};
+
+	for (int i = 0, n = GetNumThreads(); i < n; i++) {
+		ThreadLoadCounters& counters = threadLoadCounters[i];
+		ThreadLoadSample& sample = threadLoadSamples[i];
+		ThreadLoad& load = threadLoads[i];
+
+		load.busy  = SampleDelta(counters.busyTime , sample.busyTime );
+		load.steal = SampleDelta(counters.stealTime, sample.stealTime);
+		load.spin  = SampleDelta(counters.spinTime , sample.spinTime );
+		load.sleep = SampleDelta(counters.sleepTime, sample.sleepTime);
+
+		if (plotNames[i][0].empty()) {
+			plotNames[i][0] = IntToString(i, "ThreadPool::Thread%i (busy)");
+			plotNames[i][1] = IntToString(i, "ThreadPool::Thread%i (steal)");
+			plotNames[i][2] = IntToString(i, "ThreadPool::Thread%i (spin)");
+			plotNames[i][3] = IntToString(i, "ThreadPool::Thread%i (sleep)");
+
+			for (const std::string& plotName: plotNames[i]) {
+				TracyPlotConfig(plotName.c_str(), tracy::PlotFormatType::Percentage, false, true, 0);
+			}
+		}
+
+		TracyPlot(plotNames[i][0].c_str(), load.busy  * 100.0f);
+		TracyPlot(plotNames[i][1].c_str(), load.steal * 100.0f);
+		TracyPlot(plotNames[i][2].c_str(), load.spin  * 100.0f);
+		TracyPlot(plotNames[i][3].c_str(), load.sleep * 100.0f);
+	}
+
+	lastQueueDepth = 0;
+
+	for (int i = 0, n = GetNumThreads(); i < n; i++) {
+		lastQueueDepth += stealQueues[i].Size();
+		#ifndef USE_BOOST_LOCKFREE_QUEUE
+		lastQueueDepth += taskQueues[false][i].size_approx();
+		#endif
+	}
+
+	TracyPlot("ThreadPool::QueueDepth", static_cast<int64_t>(lastQueueDepth));
+
+	lastLoadSampleTime = curTime;
+}
+
+void LogLoadStats()
+{
+	LOG("[ThreadPool::%s] threads=%d queued=%u", __func__, GetNumThreads(), static_cast<uint32_t>(lastQueueDepth));
+
+	for (int i = 0, n = GetNumThreads(); i < n; i++) {
+		const ThreadLoad& load = threadLoads[i];
+
+		LOG("\tthread=%2d busy=%5.1f%% steal=%5.1f%% spin=%5.1f%% sleep=%5.1f%%", i, load.busy * 100.0f, load.steal * 100.0f, load.spin * 100.0f, load.sleep * 100.0f);
+	}
+
+	std::lock_guard<spring::spinlock> lck(forSiteStatsLock);
+
+	for (const ForSiteStats& site: forSiteStats) {
+		const uint64_t numCalls = site.numCalls.load(std::memory_order_relaxed);
+
+		if (numCalls == 0)
+			continue;
+
+		std::string hist;
+
+		// "<1us" column first, then one per doubling
+		for (const auto& bucket: site.timeBuckets) {
+			hist += IntToString(bucket.load(std::memory_order_relaxed), " %i");
+		}
+
+		LOG(
+			"\t%s:%u calls=%" PRIu64 " {avg}{iters,time}={%.1f, %.1fus} hist(us,log2)={%s }",
+			site.file, site.line, numCalls,
+			site.sumIters.load(std::memory_order_relaxed) * 1.0f / numCalls,
+			site.sumTime.load(std::memory_order_relaxed) * 1.0f / numCalls,
+			hist.c_str()
+		);
+	}
+}
+
+ThreadLoad GetThreadLoad(int tid) { return threadLoads[tid]; }
+size_t GetQueueDepth() { return lastQueueDepth; }
+
+
 void NotifyWorkerThreads(bool force, bool async)
 {
 	// OPTIMIZATION
@@ -411,6 +665,11 @@ static void KillThreads(int wantedNumThreads, int curNumThreads)
 		while (taskQueues[false][i].try_dequeue(tg));
 		while (taskQueues[ true][i].try_dequeue(tg));
 		#endif
+
+		// owner has been joined, safe to pop from here
+		while ((tg = stealQueues[i].Pop()) != nullptr) {
+			tg->numStealRefs.fetch_sub(1, std::memory_order_release);
+		}
 	}
 
 	assert((wantedNumThreads != 0) || workerThreads[false].empty());
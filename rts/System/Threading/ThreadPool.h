@@ -3,6 +3,10 @@
 #ifndef _THREADPOOL_H
 #define _THREADPOOL_H
 
+#include <algorithm>
+#include <iterator>
+#include <vector>
+
 #ifndef THREADPOOL
 #include <functional>
 #include <future>
@@ -29,6 +33,18 @@ namespace ThreadPool {
 	static inline void NotifyWorkerThreads(bool force, bool async) {}
 	static inline bool HasThreads() { return false; }
 
+	struct ThreadLoad {
+		float busy = 0.0f;
+		float steal = 0.0f;
+		float spin = 0.0f;
+		float sleep = 0.0f;
+	};
+
+	static inline void UpdateLoadStats() {}
+	static inline void LogLoadStats() {}
+	static inline ThreadLoad GetThreadLoad(int tid) { return {}; }
+	static inline size_t GetQueueDepth() { return 0; }
+
 	static constexpr int MAX_THREADS = 1;
 }
 
@@ -73,6 +89,8 @@ static inline auto parallel_reduce(F&& f, G&& g) -> std::invoke_result_t<F>
 #include <vector>
 #include <numeric>
 #include <atomic>
+#include <bit>
+#include <source_location>
 
 #undef gt
 #include <memory>
@@ -96,6 +114,7 @@ namespace ThreadPool {
 
 	void PushTaskGroup(ITaskGroup* taskGroup);
 	void PushTaskGroup(std::shared_ptr<ITaskGroup>&& taskGroup);
+	void PushStealableTaskGroup(ITaskGroup* taskGroup);
 	void WaitForFinished(std::shared_ptr<ITaskGroup>&& taskGroup);
 
 	template<typename T>
@@ -115,6 +134,54 @@ namespace ThreadPool {
 	extern bool inMultiThreadedSection;
 
 	static constexpr int MAX_THREADS = 32;
+
+	/// fractions of wall-time over the last UpdateLoadStats interval
+	struct ThreadLoad {
+		float busy = 0.0f;  ///< running tasks taken from a queue or the own deque
+		float steal = 0.0f; ///< running slices stolen from another thread's deque
+		float spin = 0.0f;  ///< polling for work (workers) or for a group to finish (WaitForFinished)
+		float sleep = 0.0f; ///< blocked on the new-tasks signal
+	};
+
+	/**
+	 * Per-call-site for_mt statistics; timeBuckets[i] counts the calls that
+	 * took less than 2^i microseconds (and at least 2^(i-1)), the last one
+	 * also counts everything longer.
+	 */
+	struct ForSiteStats {
+		static constexpr size_t NUM_BUCKETS = 16;
+
+		ForSiteStats(const std::source_location& loc): file(loc.file_name()), line(loc.line()) {}
+
+		void AddCall(int numIters, spring_time dt) {
+			const uint64_t us = dt.toMicroSecsi();
+			const size_t bucket = std::min(static_cast<size_t>(std::bit_width(us)), NUM_BUCKETS - 1);
+
+			numCalls.fetch_add(1, std::memory_order_relaxed);
+			sumIters.fetch_add(numIters, std::memory_order_relaxed);
+			sumTime.fetch_add(us, std::memory_order_relaxed);
+			timeBuckets[bucket].fetch_add(1, std::memory_order_relaxed);
+		}
+
+		const char* file;
+		uint32_t line;
+
+		std::atomic<uint64_t> numCalls = {0};
+		std::atomic<uint64_t> sumIters = {0};
+		std::atomic<uint64_t> sumTime = {0}; // us
+
+		std::array<std::atomic<uint32_t>, NUM_BUCKETS> timeBuckets = {};
+	};
+
+	ForSiteStats& RegisterForSite(const std::source_location& loc);
+
+	/// samples the per-thread counters and queue depths, feeds Tracy; called once per second
+	void UpdateLoadStats();
+	void LogLoadStats();
+
+	ThreadLoad GetThreadLoad(int tid);
+	/// tasks in the global queue and all work-stealing deques at the last update
+	size_t GetQueueDepth();
 }
 
 
@@ -135,6 +202,7 @@ public:
 	virtual bool IsSliceTask() const { return false; }
 	virtual bool ExecuteStep() = 0;
 	virtual bool SelfDelete() const { return false; }
+	virtual bool HasUnclaimedSteps() const { return !IsFinished(); }
 
 	uint64_t ExecuteLoop(int tid, bool wffCall) {
 		const spring_time t0 = spring_now();
@@ -174,12 +242,13 @@ public:
 
 	bool IsFinished() const { assert(remainingTasks.load() >= 0); return (remainingTasks.load(std::memory_order_relaxed) == 0); }
 	bool IsInJobQueue() const { return (inTaskQueue.load(std::memory_order_relaxed)); }
+	bool IsInStealQueue() const { return (numStealRefs.load(std::memory_order_acquire) != 0); }
 	bool IsInTaskPool() const { return ((taskPoolMask.load(std::memory_order_relaxed) & (1 << 0)) != 0); }
 	bool IsInPoolUse() const { return ((taskPoolMask.load(std::memory_order_relaxed) & (1 << 1)) != 0); }
 
 	bool ExecLoopDone() const { return (execLoopDone.load(std::memory_order_relaxed)); }
 	// pooled tasks are deleted only when their pool dies (on exit) which is always allowed
-	bool AllowDelete() const { return (IsFinished() && ((!IsInJobQueue() && ExecLoopDone()) || IsInTaskPool())); }
+	bool AllowDelete() const { return (IsFinished() && !IsInStealQueue() && ((!IsInJobQueue() && ExecLoopDone()) || IsInTaskPool())); }
 
 	int RemainingTasks() const { return remainingTasks; }
 	int WantedThread() const { return wantedThread; }
@@ -197,6 +266,8 @@ public:
 	void SetTimeStamp(const spring_time t) { ts = t.toNanoSecsi(); }
 
 	void ResetState(bool queued, bool pooled, bool inuse) {
+		assert(!IsInStealQueue());
+
 		remainingTasks.store(0);
 		wantedThread.store(0);
 		taskPoolMask.store(((1 * pooled) << 0) + ((1 * inuse) << 1));
@@ -213,6 +284,8 @@ public:
 	std::atomic_bool inTaskQueue; // whether this task is still in a thread's queue
 	std::atomic_bool execLoopDone; // whether the thread running this task is about to exit ExecLoop
 
+	std::atomic_int numStealRefs = {0}; // number of work-stealing deque entries not yet executed
+
 private:
 	static std::atomic_uint lastId;
 
@@ -619,6 +692,7 @@ public:
 	}
 
 	bool IsSliceTask() const override { return true; }
+	bool HasUnclaimedSteps() const override { return ((from + (step * ctr.load(std::memory_order_relaxed))) < to); }
 	bool ExecuteStep() override
 	{
 		const int i = from + (step * ctr.fetch_add(1, std::memory_order_relaxed));
@@ -674,7 +748,7 @@ struct TaskPool {
 
 
 template <typename F>
-static inline void for_mt(int start, int end, int step, F&& f)
+static inline void for_mt(int start, int end, int step, F&& f, const std::source_location& loc = std::source_location::current())
 {
 	ThreadPool::inMultiThreadedSection = true;
 
@@ -686,6 +760,10 @@ static inline void for_mt(int start, int end, int step, F&& f)
 	else {
 		SCOPED_MT_TIMER("ThreadPool::AddTask");
 
+		// one entry per instantiation, i.e. per lambda and thus (mostly) per call-site
+		static ThreadPool::ForSiteStats& siteStats = ThreadPool::RegisterForSite(loc);
+		const spring_time t0 = spring_now();
+
 		// static, so TaskGroup's are recycled
 		static TaskPool<ForTaskGroup, F> pool;
 		auto taskGroup = pool.GetTaskGroup();
@@ -696,30 +774,35 @@ static inline void for_mt(int start, int end, int step, F&& f)
 		assert(taskGroup->IsInJobQueue());
 
 		#if 0
-		ThreadPool::PushTaskGroup(taskGroup);
-		#else
 		// store the group in all worker queues s.t. each executes a slice
 		for (size_t i = 1; i < ThreadPool::GetNumThreads(); ++i) {
 			taskGroup->wantedThread.store(i);
 			ThreadPool::PushTaskGroup(taskGroup);
 		}
+		#else
+		// publish the group on our own deque; idle workers (and threads
+		// waiting on other groups, e.g. an outer for_mt) steal it and
+		// republish it on theirs so the slices spread over the pool
+		ThreadPool::PushStealableTaskGroup(taskGroup.get());
 		#endif
 
 		// make calling thread also run ExecuteLoop
 		ThreadPool::WaitForFinished(taskGroup);
+
+		siteStats.AddCall((end - start + step - 1) / step, spring_now() - t0);
 	}
 
 	ThreadPool::inMultiThreadedSection = false;
 }
 
 template <typename F>
-static inline void for_mt(int start, int end, F&& f)
+static inline void for_mt(int start, int end, F&& f, const std::source_location& loc = std::source_location::current())
 {
-	for_mt(start, end, 1, f);
+	for_mt(start, end, 1, f, loc);
 }
 
 template <typename F>
-static inline void for_mt_chunk(int b, int e, F&& f, int minChunkSize = 1, int maxChunkSize = std::numeric_limits<int>::max())
+static inline void for_mt_chunk(int b, int e, F&& f, int minChunkSize = 1, int maxChunkSize = std::numeric_limits<int>::max(), const std::source_location& loc = std::source_location::current())
 {
 	const int numElems = e - b;
 	if (numElems <= 0)
@@ -743,7 +826,7 @@ static inline void for_mt_chunk(int b, int e, F&& f, int minChunkSize = 1, int m
 
 		for (int i = bb; i < ee; ++i)
 			std::forward<F>(f)(i);
-	});
+	}, loc);
 }
 
 
@@ -847,5 +930,85 @@ namespace ThreadPool {
 }
 
 #endif
+
+
+
+/**
+ * Deterministic variants for synced code: [b, e) is cut into fixed chunks of
+ * chunkSize indices, independent of the number of threads, each chunk runs
+ * its indices in order and per-chunk results are merged in chunk order on
+ * the calling thread. Floating-point results are thus identical on every
+ * client, whichever threads ran which chunks.
+ */
+static constexpr int DET_CHUNK_SIZE = 64;
+
+template <typename F>
+static inline void for_mt_det(int b, int e, F&& f, int chunkSize = DET_CHUNK_SIZE)
+{
+	const int numChunks = std::max(e - b + chunkSize - 1, 0) / chunkSize;
+
+	for_mt(0, numChunks, [&f, b, e, chunkSize](const int chunk) {
+		const int bb = b + chunk * chunkSize;
+		const int ee = std::min(bb + chunkSize, e);
+
+		for (int i = bb; i < ee; ++i)
+			f(i);
+	});
+}
+
+/// f(T& acc, int i) folds one index into its chunk's partial (which starts as identity), g(T a, const T& b) merges two partials
+template <typename T, typename F, typename G>
+static inline T reduce_det(int b, int e, T identity, F&& f, G&& g, int chunkSize = DET_CHUNK_SIZE)
+{
+	const int numChunks = std::max(e - b + chunkSize - 1, 0) / chunkSize;
+
+	std::vector<T> partials(numChunks, identity);
+
+	for_mt(0, numChunks, [&f, &partials, b, e, chunkSize](const int chunk) {
+		const int bb = b + chunk * chunkSize;
+		const int ee = std::min(bb + chunkSize, e);
+
+		for (int i = bb; i < ee; ++i)
+			f(partials[chunk], i);
+	});
+
+	T result = std::move(identity);
+
+	for (const T& partial: partials) {
+		result = g(std::move(result), partial);
+	}
+
+	return result;
+}
+
+/// f(std::vector<T>& items, int i) appends any number of items for index i, these end up in out in index order
+template <typename T, typename F>
+static inline void collect_det(int b, int e, std::vector<T>& out, F&& f, int chunkSize = DET_CHUNK_SIZE)
+{
+	const int numChunks = std::max(e - b + chunkSize - 1, 0) / chunkSize;
+
+	std::vector<std::vector<T>> chunkItems(numChunks);
+
+	for_mt(0, numChunks, [&f, &chunkItems, b, e, chunkSize](const int chunk) {
+		const int bb = b + chunk * chunkSize;
+		const int ee = std::min(bb + chunkSize, e);
+
+		for (int i = bb; i < ee; ++i)
+			f(chunkItems[chunk], i);
+	});
+
+	size_t numItems = out.size();
+
+	for (const std::vector<T>& items: chunkItems) {
+		numItems += items.size();
+	}
+
+	out.reserve(numItems);
+
+	for (std::vector<T>& items: chunkItems) {
+		std::move(items.begin(), items.end(), std::back_inserter(out));
+	}
+}
+
 #endif
 
@@ -0,0 +1,140 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#ifndef _WORK_STEALING_DEQUE_H
+#define _WORK_STEALING_DEQUE_H
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ * Chase-Lev work-stealing deque of T*'s, following "Correct and Efficient
+ * Work-Stealing for Weak Memory Models" (Le, Pop, Cohen, Zappa Nardelli).
+ *
+ * Push and Pop work on the bottom end and may only be called by the owner
+ * (one thread at a time), Steal takes from the top end and may be called
+ * by any thread. The ring grows when full; retired rings are kept until
+ * the deque dies since thieves may still be reading from them.
+ */
+template<typename T>
+class WorkStealingDeque {
+private:
+	struct Ring {
+		Ring(int64_t cap): capacity(cap), mask(cap - 1), slots(new std::atomic<T*>[cap]) {
+			assert((cap & (cap - 1)) == 0);
+		}
+
+		T* Get(int64_t i) const { return slots[i & mask].load(std::memory_order_relaxed); }
+		void Put(int64_t i, T* item) { slots[i & mask].store(item, std::memory_order_relaxed); }
+
+		const int64_t capacity;
+		const int64_t mask;
+
+		std::unique_ptr<std::atomic<T*>[]> slots;
+	};
+
+public:
+	WorkStealingDeque(int64_t capacity = 256) {
+		rings.emplace_back(new Ring(capacity));
+		ring.store(rings.back().get(), std::memory_order_relaxed);
+	}
+
+	WorkStealingDeque(const WorkStealingDeque&) = delete;
+	WorkStealingDeque& operator = (const WorkStealingDeque&) = delete;
+
+	void Push(T* item) {
+		const int64_t b = bottom.load(std::memory_order_relaxed);
+		const int64_t t = top.load(std::memory_order_acquire);
+
+		Ring* r = ring.load(std::memory_order_relaxed);
+
+		if ((b - t) > (r->capacity - 1))
+			r = Grow(r, b, t);
+
+		r->Put(b, item);
+
+		std::atomic_thread_fence(std::memory_order_release);
+		bottom.store(b + 1, std::memory_order_relaxed);
+	}
+
+	T* Pop() {
+		const int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+
+		Ring* r = ring.load(std::memory_order_relaxed);
+
+		bottom.store(b, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+
+		int64_t t = top.load(std::memory_order_relaxed);
+
+		if (t > b) {
+			// empty
+			bottom.store(b + 1, std::memory_order_relaxed);
+			return nullptr;
+		}
+
+		T* item = r->Get(b);
+
+		if (t == b) {
+			// last item, race against thieves
+			if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+				item = nullptr;
+
+			bottom.store(b + 1, std::memory_order_relaxed);
+		}
+
+		return item;
+	}
+
+	T* Steal() {
+		int64_t t = top.load(std::memory_order_acquire);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		const int64_t b = bottom.load(std::memory_order_acquire);
+
+		if (t >= b)
+			return nullptr;
+
+		T* item = ring.load(std::memory_order_acquire)->Get(t);
+
+		// lost the race against the owner or another thief
+		if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+			return nullptr;
+
+		return item;
+	}
+
+	bool Empty() const {
+		return (bottom.load(std::memory_order_relaxed) <= top.load(std::memory_order_relaxed));
+	}
+	/// racy snapshot, for statistics only
+	int64_t Size() const {
+		return std::max(bottom.load(std::memory_order_relaxed) - top.load(std::memory_order_relaxed), int64_t(0));
+	}
+
+private:
+	Ring* Grow(Ring* r, int64_t b, int64_t t) {
+		rings.emplace_back(new Ring(r->capacity * 2));
+
+		Ring* g = rings.back().get();
+
+		for (int64_t i = t; i < b; i++) {
+			g->Put(i, r->Get(i));
+		}
+
+		ring.store(g, std::memory_order_release);
+		return g;
+	}
+
+private:
+	alignas(64) std::atomic<int64_t> top = {0};
+	alignas(64) std::atomic<int64_t> bottom = {0};
+	alignas(64) std::atomic<Ring*> ring = {nullptr};
+
+	// owner-only; every ring ever allocated
+	std::vector<std::unique_ptr<Ring>> rings;
+};
+
+#endif
@@ -407,6 +407,8 @@ void CTimeProfiler::AddTimeRaw(
 	// these are 0 if just created, works for both paths
 	p.total   += deltaTime;
 	p.current += deltaTime;
+	p.peak     = std::max(p.peak, deltaTime);
+	p.count   += 1;
 
 	p.newLagPeak = (p.stats.x > 0.0f && deltaTime.toMilliSecsf() > p.stats.x);
 	p.stats.x    = std::max(p.stats.x, deltaTime.toMilliSecsf());
@@ -425,6 +427,28 @@ void CTimeProfiler::AddTimeRaw(
 	}
 }
 
+std::vector<CTimeProfiler::TimeRecordPair> CTimeProfiler::GetProfilesSnapshot() const
+{
+	std::vector<TimeRecordPair> snapshot;
+
+	std::lock_guard<ProfileMutexType> profileLock(profileMutex);
+	std::lock_guard<HashNamMutexType> hashToNameLock(hashToNameMutex);
+
+	snapshot.reserve(profiles.size());
+
+	for (const auto& profile: profiles) {
+		const auto iter = hashToName.find(profile.first);
+
+		if (iter == hashToName.end())
+			continue;
+
+		snapshot.emplace_back(iter->second, profile.second);
+	}
+
+	std::sort(snapshot.begin(), snapshot.end(), SortingFunctions[ST_ALPHABETICAL]);
+	return snapshot;
+}
+
 void CTimeProfiler::PrintProfilingInfo() const
 {
 	if (sortedProfiles.empty())
@@ -4,6 +4,7 @@
 #define TIME_PROFILER_H
 
 #include <atomic>
+#include <cstdint>
 #include <string>
 #include <deque>
 #include <vector>
@@ -117,6 +118,10 @@ public:
 
 		spring_time total = spring_notime;
 		spring_time current = spring_notime;
+		// longest single dt, unlike stats.x this never decays
+		spring_time peak = spring_notime;
+		// number of AddTime calls
+		uint64_t count = 0;
 		std::array<spring_time, numFrames> frames;
 
 		// .x := maximum dt, .y := time-percentage, .z := peak-percentage
@@ -188,8 +193,12 @@ public:
 	void CleanupOldThreadProfiles();
 
 	void SetEnabled(bool b) { enabled = b; }
+	bool IsEnabled() const { return enabled; }
 	void PrintProfilingInfo() const;
 
+	/// named copies of all records, for benchmark reports
+	std::vector<TimeRecordPair> GetProfilesSnapshot() const;
+
 	void AddTime(
 		unsigned nameHash,
 		const spring_time startTime,
@@ -657,7 +657,8 @@ CR_REG_METADATA(creg_LG, (
 template<typename T, typename C>
 inline void SerializeCVector(creg::ISerializer* s, T** vecPtr, C count)
 {
-	std::unique_ptr<creg::IType> elemType = creg::DeduceType<T>::Get();
+	// called for every table and proto, only deduce the element type once
+	static const std::unique_ptr<creg::IType> elemType = creg::DeduceType<T>::Get();
 	T* vec;
 	if (!(s->IsWriting())) {
 		vec = (T*) luaContext.alloc(count * sizeof(T));
@@ -736,7 +737,7 @@ void creg_TValue::Serialize(creg::ISerializer* s)
 		case LUA_TSTRING: { SerializePtr(s, &value.gc); return; }
 		case LUA_TTABLE: { SerializePtr(s, &value.gc); return; }
 		case LUA_TFUNCTION: { SerializePtr(s, &value.gc); return; }
-		case LUA_TUSERDATA: { SerializePtr(s, &value.gc); }
+		case LUA_TUSERDATA: { SerializePtr(s, &value.gc); return; }
 		case LUA_TTHREAD: { SerializePtr(s, &value.gc); return; }
 		case LUA_TDEADKEY: { return; }
 		default: { assert(false); return; }
@@ -243,6 +243,7 @@ decltype(glad_glGetFramebufferAttachmentParameteriv) glad_glGetFramebufferAttach
 decltype(glad_glGetFramebufferParameteriv) glad_glGetFramebufferParameteriv = nullptr;
 decltype(glad_glGetIntegeri_v) glad_glGetIntegeri_v = nullptr;
 decltype(glad_glGetIntegerv) glad_glGetIntegerv = nullptr;
+decltype(glad_glGetProgramBinary) glad_glGetProgramBinary = nullptr;
 decltype(glad_glGetProgramInfoLog) glad_glGetProgramInfoLog = nullptr;
 decltype(glad_glGetProgramiv) glad_glGetProgramiv = nullptr;
 decltype(glad_glGetQueryObjectiv) glad_glGetQueryObjectiv = nullptr;
@@ -295,6 +296,7 @@ decltype(glad_glMemoryBarrier) glad_glMemoryBarrier = nullptr;
 decltype(glad_glMinSampleShading) glad_glMinSampleShading = nullptr;
 decltype(glad_glMultMatrixd) glad_glMultMatrixd = nullptr;
 decltype(glad_glMultMatrixf) glad_glMultMatrixf = nullptr;
+decltype(glad_glMultiDrawArrays) glad_glMultiDrawArrays = nullptr;
 decltype(glad_glMultiDrawElementsIndirect) glad_glMultiDrawElementsIndirect = nullptr;
 decltype(glad_glMultiTexCoord1f) glad_glMultiTexCoord1f = nullptr;
 decltype(glad_glMultiTexCoord2f) glad_glMultiTexCoord2f = nullptr;
@@ -319,6 +321,7 @@ decltype(glad_glPopAttrib) glad_glPopAttrib = nullptr;
 decltype(glad_glPopMatrix) glad_glPopMatrix = nullptr;
 decltype(glad_glPopName) glad_glPopName = nullptr;
 decltype(glad_glPrimitiveRestartIndex) glad_glPrimitiveRestartIndex = nullptr;
+decltype(glad_glProgramBinary) glad_glProgramBinary = nullptr;
 decltype(glad_glProgramParameteri) glad_glProgramParameteri = nullptr;
 decltype(glad_glPushAttrib) glad_glPushAttrib = nullptr;
 decltype(glad_glPushMatrix) glad_glPushMatrix = nullptr;
@@ -681,6 +684,7 @@ int gladLoadGL(void) {
     glad_glGetFramebufferParameteriv = MakeStubImpl(glad_glGetFramebufferParameteriv);
     glad_glGetIntegeri_v = MakeStubImpl(glad_glGetIntegeri_v);
     glad_glGetIntegerv = MakeStubImpl(glad_glGetIntegerv);
+    glad_glGetProgramBinary = MakeStubImpl(glad_glGetProgramBinary);
     glad_glGetProgramInfoLog = MakeStubImpl(glad_glGetProgramInfoLog);
     glad_glGetProgramiv = MakeStubImpl(glad_glGetProgramiv);
     glad_glGetQueryObjectiv = MakeStubImpl(glad_glGetQueryObjectiv);
@@ -733,6 +737,7 @@ int gladLoadGL(void) {
     glad_glMinSampleShading = MakeStubImpl(glad_glMinSampleShading);
     glad_glMultMatrixd = MakeStubImpl(glad_glMultMatrixd);
     glad_glMultMatrixf = MakeStubImpl(glad_glMultMatrixf);
+    glad_glMultiDrawArrays = MakeStubImpl(glad_glMultiDrawArrays);
     glad_glMultiDrawElementsIndirect = MakeStubImpl(glad_glMultiDrawElementsIndirect);
     glad_glMultiTexCoord1f = MakeStubImpl(glad_glMultiTexCoord1f);
     glad_glMultiTexCoord2f = MakeStubImpl(glad_glMultiTexCoord2f);
@@ -757,6 +762,7 @@ int gladLoadGL(void) {
     glad_glPopMatrix = MakeStubImpl(glad_glPopMatrix);
     glad_glPopName = MakeStubImpl(glad_glPopName);
     glad_glPrimitiveRestartIndex = MakeStubImpl(glad_glPrimitiveRestartIndex);
+    glad_glProgramBinary = MakeStubImpl(glad_glProgramBinary);
     glad_glProgramParameteri = MakeStubImpl(glad_glProgramParameteri);
     glad_glPushAttrib = MakeStubImpl(glad_glPushAttrib);
     glad_glPushMatrix = MakeStubImpl(glad_glPushMatrix);
@@ -233,7 +233,7 @@ const char* spring_lua_get_handle_name(lua_State* L)
 static constexpr const char* LUA_OOM_FMT_STR = "[%s][handle=%s][OOM] synced=%d {alloced,maximum}={" _STPF_ "," _STPF_ "}bytes\n";
 
 // tracks allocations across all states
-static SLuaAllocState gLuaAllocState = {{0}, {0}, {0}, {0}};
+static SLuaAllocState gLuaAllocState = {{0}, {0}, {0}, {0}, {0}};
 static SLuaAllocError gLuaAllocError = {};
 
 void spring_lua_alloc_log_error(const luaContextData* lcd)
@@ -263,6 +263,9 @@ void* spring_lua_alloc(void* ud, void* ptr, size_t osize, size_t nsize)
 	las->allocedBytes -= osize;
 	las->allocedBytes += nsize;
 
+	if (nsize > osize)
+		las->grossAllocedBytes += (nsize - osize);
+
 	if (nsize == 0) {
 		// deallocation; must return NULL
 		lmp->Free(ptr, osize);
@@ -9,6 +9,9 @@
 #include "System/Log/ILog.h"
 #include "System/SpringHash.h"
 
+#include <cstring>
+#include <vector>
+
 
 #define CATCH_CONFIG_MAIN
 #include <catch_amalgamated.hpp>
@@ -289,6 +292,121 @@ TEST_CASE("Matrix44MatrixMultiply")
 	}
 }
 
+// scalar reference for CMatrix44f::Invert, CalculateCofactor as it was before SSE
+static float RefCofactor(const float m[4][4], const int ei, const int ej)
+{
+	const int idx[4][3] = {{1, 2, 3}, {0, 2, 3}, {0, 1, 3}, {0, 1, 2}};
+	const int ai = idx[ei][0], bi = idx[ei][1], ci = idx[ei][2];
+	const int aj = idx[ej][0], bj = idx[ej][1], cj = idx[ej][2];
+
+	const float val =
+		(m[ai][aj] * ((m[bi][bj] * m[ci][cj]) - (m[bi][cj] * m[ci][bj]))) +
+		(m[ai][bj] * ((m[bi][cj] * m[ci][aj]) - (m[bi][aj] * m[ci][cj]))) +
+		(m[ai][cj] * ((m[bi][aj] * m[ci][bj]) - (m[bi][bj] * m[ci][aj])));
+
+	return ((((ei + ej) & 1) == 0)? val: -val);
+}
+
+static CMatrix44f RefInvert(const CMatrix44f& mat)
+{
+	CMatrix44f cofac;
+
+	for (int i = 0; i < 4; i++) {
+		for (int j = 0; j < 4; j++) {
+			cofac.md[i][j] = RefCofactor(mat.md, i, j);
+		}
+	}
+
+	const float det =
+		(mat.md[0][0] * cofac.md[0][0]) +
+		(mat.md[0][1] * cofac.md[0][1]) +
+		(mat.md[0][2] * cofac.md[0][2]) +
+		(mat.md[0][3] * cofac.md[0][3]);
+
+	cofac *= 1.0f / det;
+	cofac.Transpose();
+	return cofac;
+}
+
+TEST_CASE("Matrix44Invert")
+{
+	CMatrix44f mat;
+	mat.RotateEulerXYZ(float3(0.3f, -1.2f, 2.1f));
+	mat.Scale(float3(1.5f, 0.25f, 3.0f));
+	mat.SetPos(float3(100.0f, -20.0f, 3.5f));
+	mat[3] = 0.125f;
+	mat[7] = -0.5f;
+
+	const CMatrix44f ref = RefInvert(mat);
+
+	CMatrix44f inv = mat.Invert();
+	CHECK(memcmp(&inv, &ref, sizeof(CMatrix44f)) == 0);
+
+	inv = mat;
+	CHECK(inv.InvertInPlace());
+	CHECK(memcmp(&inv, &ref, sizeof(CMatrix44f)) == 0);
+
+	CHECK((mat * inv).equals(CMatrix44f()));
+
+	{
+		ScopedOnceTimer timer("Matrix-Invert: spring");
+		for (int i = 0; i < testRuns / 10; ++i) {
+			inv = inv.Invert();
+		}
+	}
+	{
+		ScopedOnceTimer timer("Matrix-Invert: fpu");
+		for (int i = 0; i < testRuns / 10; ++i) {
+			inv = RefInvert(inv);
+		}
+	}
+}
+
+TEST_CASE("Matrix44BatchMultiply")
+{
+	CMatrix44f mat;
+	mat.RotateEulerYXZ(float3(-0.7f, 0.4f, 1.9f));
+	mat.SetPos(float3(-12.0f, 640.0f, 33.0f));
+
+	std::vector<float3> points(4096);
+	std::vector<float3> pointsOut(points.size());
+	std::vector<float4> vecs(points.size());
+	std::vector<float4> vecsOut(points.size());
+
+	for (size_t i = 0; i < points.size(); ++i) {
+		points[i] = float3(i * 0.75f, i * -1.5f, 1000.0f / (i + 1));
+		vecs[i] = float4(points[i], (i & 1) * 1.0f);
+	}
+
+	mat.Mul(points.data(), pointsOut.data(), points.size());
+	mat.Mul(vecs.data(), vecsOut.data(), vecs.size());
+
+	for (size_t i = 0; i < points.size(); ++i) {
+		const float3 p = mat * points[i];
+		const float4 v = mat * vecs[i];
+
+		CHECK(memcmp(&p, &pointsOut[i], sizeof(float3)) == 0);
+		CHECK(memcmp(&v, &vecsOut[i], sizeof(float4)) == 0);
+	}
+
+	const int numRuns = testRuns / points.size();
+
+	{
+		ScopedOnceTimer timer("Matrix-Points-Mult: single");
+		for (int n = 0; n < numRuns; ++n) {
+			for (size_t i = 0; i < points.size(); ++i) {
+				pointsOut[i] = mat * points[i];
+			}
+		}
+	}
+	{
+		ScopedOnceTimer timer("Matrix-Points-Mult: batched");
+		for (int n = 0; n < numRuns; ++n) {
+			mat.Mul(points.data(), pointsOut.data(), points.size());
+		}
+	}
+}
+
 TEST_CASE("MatMult")
 {
 	BENCHMARK("MM")	{
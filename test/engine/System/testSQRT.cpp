@@ -6,6 +6,10 @@
 #include "System/TimeProfiler.h"
 #include "System/Misc/SpringTime.h"
 #include "System/FastMath.h"
+#include "System/Math/BatchMath.h"
+
+#include <cstring>
+#include <vector>
 
 
 #include <catch_amalgamated.hpp>
@@ -130,6 +134,112 @@ TEST_CASE("SinCos")
 }
 
 
+TEST_CASE("BatchMath")
+{
+	srand( 0 );
+	const size_t count = 0xFFFFF;
+
+	std::vector<float> xs(count);
+	std::vector<float> ys(count);
+	std::vector<float> out(count);
+	std::vector<float> out2(count);
+
+	for (size_t i = 0; i < count; ++i) {
+		xs[i] = RandFloat(-8000.f, 8000.f);
+		ys[i] = RandFloat(-100.f, 100.f);
+	}
+
+	// every tenth pair exercises the axes
+	for (size_t i = 0; i < count; i += 10) {
+		xs[i] *= (i & 1);
+		ys[i] *= ((i >> 1) & 1);
+	}
+
+	// batched and scalar versions agree bit for bit, tail included (count is odd)
+	const auto CheckScalar = [&](float (*func)(float), const std::vector<float>& batched) {
+		size_t numDiffs = 0;
+		for (size_t i = 0; i < count; ++i) {
+			const float r = func(xs[i]);
+			numDiffs += (memcmp(&r, &batched[i], sizeof(float)) != 0);
+		}
+		CHECK(numDiffs == 0);
+	};
+
+	{
+		ScopedOnceTimer foo("batchmath::sin");
+		batchmath::sin(xs.data(), out.data(), count);
+	}
+	{
+		ScopedOnceTimer foo("streflop::sin");
+		for (size_t i = 0; i < count; ++i) {
+			out2[i] = streflop::sin(xs[i]);
+		}
+	}
+	CheckScalar(batchmath::sin, out);
+
+	size_t numErrors = 0;
+	for (size_t i = 0; i < count; ++i) {
+		numErrors += (std::abs(out[i] - out2[i]) >= 1e-6f);
+	}
+	CHECK(numErrors == 0);
+
+	batchmath::sincos(xs.data(), out2.data(), out.data(), count);
+	CheckScalar(batchmath::cos, out);
+	CheckScalar(batchmath::sin, out2);
+	numErrors = 0;
+	for (size_t i = 0; i < count; ++i) {
+		numErrors += (std::abs(out[i] - streflop::cos(xs[i])) >= 1e-6f);
+	}
+	CHECK(numErrors == 0);
+
+	{
+		ScopedOnceTimer foo("batchmath::atan2");
+		batchmath::atan2(ys.data(), xs.data(), out.data(), count);
+	}
+	{
+		ScopedOnceTimer foo("streflop::atan2");
+		for (size_t i = 0; i < count; ++i) {
+			out2[i] = streflop::atan2(ys[i], xs[i]);
+		}
+	}
+	numErrors = 0;
+	for (size_t i = 0; i < count; ++i) {
+		const float r = batchmath::atan2(ys[i], xs[i]);
+		numErrors += (memcmp(&r, &out[i], sizeof(float)) != 0);
+		// streflop returns +-PI for (+-0, negative x), batchmath always +PI
+		if (ys[i] == 0.0f)
+			continue;
+		numErrors += (std::abs(out[i] - out2[i]) >= 1e-6f);
+	}
+	CHECK(numErrors == 0);
+	CHECK(batchmath::atan2(0.0f, 0.0f) == 0.0f);
+
+	for (size_t i = 0; i < count; ++i) {
+		xs[i] = std::abs(xs[i]);
+	}
+
+	{
+		ScopedOnceTimer foo("batchmath::sqrt");
+		batchmath::sqrt(xs.data(), out.data(), count);
+	}
+	{
+		ScopedOnceTimer foo("streflop::sqrt");
+		for (size_t i = 0; i < count; ++i) {
+			out2[i] = streflop::sqrt(xs[i]);
+		}
+	}
+	CHECK(memcmp(out.data(), out2.data(), count * sizeof(float)) == 0);
+
+	batchmath::isqrt(xs.data(), out.data(), count);
+	CheckScalar(batchmath::isqrt, out);
+	numErrors = 0;
+	for (size_t i = 0; i < count; ++i) {
+		numErrors += (out[i] != 1.0f / streflop::sqrt(xs[i]));
+	}
+	CHECK(numErrors == 0);
+}
+
+
 TEST_CASE("Floor")
 {
 	srand( 0 );
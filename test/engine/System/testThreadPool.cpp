@@ -337,6 +337,129 @@ TEST_CASE("test_parallel_gtn_cost")
 	LOG("[%s::test_parallel_gtn_cost] %.6fms (avg)", __func__, totalCost / threads);
 }
 
+TEST_CASE("test_for_mt_det")
+{
+	std::vector<int> hits(1000, 0);
+
+	for_mt_det(0, hits.size(), [&](const int i) {
+		hits[i] += 1;
+	});
+
+	for (int h: hits) {
+		SAFE_CHECK(h == 1);
+	}
+
+	// empty and partial ranges
+	for_mt_det(5, 5, [&](const int i) { hits[i] += 1; });
+	for_mt_det(990, 1000, [&](const int i) { hits[i] += 1; }, 7);
+
+	CHECK(hits[5] == 1);
+	CHECK(hits[989] == 1);
+	CHECK(hits[990] == 2);
+	CHECK(hits[999] == 2);
+}
+
+TEST_CASE("test_reduce_det")
+{
+	constexpr int NUM_VALUES = 100000;
+	constexpr int CHUNK_SIZE = 128;
+
+	std::vector<float> values(NUM_VALUES);
+	CGlobalUnsyncedRNG rng;
+
+	for (float& v: values) {
+		v = rng.NextFloat() * 1000.0f;
+	}
+
+	const auto AddValue = [&](float& acc, const int i) { acc += values[i]; };
+	const auto AddSums = [](float a, const float& b) { return (a + b); };
+
+	// the same fixed-chunk fold done sequentially; results must match bit for bit
+	float expected = 0.0f;
+
+	for (int b = 0; b < NUM_VALUES; b += CHUNK_SIZE) {
+		float partial = 0.0f;
+
+		for (int i = b; i < std::min(b + CHUNK_SIZE, NUM_VALUES); ++i)
+			partial += values[i];
+
+		expected += partial;
+	}
+
+	for (int run = 0; run < 20; ++run) {
+		CHECK(reduce_det(0, NUM_VALUES, 0.0f, AddValue, AddSums, CHUNK_SIZE) == expected);
+	}
+
+	CHECK(reduce_det(0, 0, 42.0f, AddValue, AddSums) == 42.0f);
+}
+
+TEST_CASE("test_collect_det")
+{
+	std::vector<int> out = {-1};
+
+	// odd indices emit themselves twice, even ones nothing
+	collect_det(0, 10000, out, [](std::vector<int>& items, const int i) {
+		if ((i & 1) == 0)
+			return;
+
+		items.push_back(i);
+		items.push_back(i);
+	}, 100);
+
+	REQUIRE(out.size() == (1 + 10000));
+	CHECK(out[0] == -1);
+
+	for (size_t j = 1; j < out.size(); j += 2) {
+		CHECK(out[j] == out[j + 1]);
+		CHECK(out[j] == int(j));
+	}
+}
+
+TEST_CASE("test_load_stats")
+{
+	ThreadPool::UpdateLoadStats();
+
+	for_mt(0, NUM_THREADS * 16, [](const int i) {
+		spring_sleep(spring_msecs(1));
+	});
+
+	ThreadPool::UpdateLoadStats();
+	ThreadPool::LogLoadStats();
+
+	float busy = 0.0f;
+
+	for (int i = 0; i < ThreadPool::GetNumThreads(); ++i) {
+		const ThreadPool::ThreadLoad load = ThreadPool::GetThreadLoad(i);
+
+		CHECK(load.busy >= 0.0f);
+		CHECK(load.busy <= 1.0f);
+		CHECK((load.busy + load.steal + load.spin + load.sleep) <= 1.05f);
+
+		busy += (load.busy + load.steal);
+	}
+
+	// every slice slept, someone must have been busy (without workers for_mt runs inline)
+	if (ThreadPool::HasThreads())
+		CHECK(busy > 0.0f);
+}
+
+TEST_CASE("test_for_site_stats")
+{
+	ThreadPool::ForSiteStats stats(std::source_location::current());
+
+	stats.AddCall(10, spring_time::fromMicroSecs(0));
+	stats.AddCall(10, spring_time::fromMicroSecs(1));
+	stats.AddCall(10, spring_time::fromMicroSecs(3));
+	stats.AddCall(10, spring_time::fromMicroSecs(1000000));
+
+	CHECK(stats.numCalls == 4);
+	CHECK(stats.sumIters == 40);
+	CHECK(stats.timeBuckets[0] == 1);
+	CHECK(stats.timeBuckets[1] == 1);
+	CHECK(stats.timeBuckets[2] == 1);
+	CHECK(stats.timeBuckets[ThreadPool::ForSiteStats::NUM_BUCKETS - 1] == 1);
+}
+
 TEST_CASE("Cleanup")
 {
 	ThreadPool::SetThreadCount(0);
@@ -0,0 +1,127 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#include "Lua/LuaMemPool.h"
+#include "System/Misc/SpringTime.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace {
+	InitSpringTime ist;
+
+	struct PoolSetup {
+		PoolSetup() { LuaMemPool::InitStatic(true); }
+		~PoolSetup() { LuaMemPool::KillStatic(); }
+	};
+
+	PoolSetup poolSetup;
+
+	// fixed allocation-size trace, weighted towards the small strings, closures
+	// and table parts a Lua state mostly allocates; a few sizes hit the slabs
+	const std::vector<uint32_t>& GetAllocSizes() {
+		static std::vector<uint32_t> sizes;
+
+		if (sizes.empty()) {
+			std::mt19937 rng(12345);
+			std::discrete_distribution<int> bucketDist({60, 25, 10, 4, 1});
+			std::uniform_int_distribution<uint32_t> offsetDist(0, 15);
+
+			constexpr uint32_t bucketSizes[] = {16, 48, 256, 1024, 8192};
+
+			sizes.resize(65536);
+
+			for (uint32_t& size: sizes) {
+				size = bucketSizes[bucketDist(rng)] + offsetDist(rng) * 8;
+			}
+		}
+
+		return sizes;
+	}
+}
+
+static void BenchLuaMemPoolAllocFree(benchmark::State& state) {
+	const auto& sizes = GetAllocSizes();
+	const size_t numLive = state.range(0);
+
+	LuaMemPool* pool = LuaMemPool::AcquirePtr(false, false);
+
+	std::vector<void*> ptrs(numLive, nullptr);
+	std::vector<uint32_t> ptrSizes(numLive, 0);
+
+	size_t n = 0;
+
+	// ring of <numLive> live blocks, each alloc replaces the oldest one
+	for (auto _ : state) {
+		const size_t i = n % numLive;
+		const uint32_t size = sizes[n % sizes.size()];
+
+		if (ptrs[i] != nullptr)
+			pool->Free(ptrs[i], ptrSizes[i]);
+
+		benchmark::DoNotOptimize(ptrs[i] = pool->Alloc(ptrSizes[i] = size));
+		n++;
+	}
+
+	for (size_t i = 0; i < numLive; i++) {
+		if (ptrs[i] != nullptr)
+			pool->Free(ptrs[i], ptrSizes[i]);
+	}
+
+	LuaMemPool::ReleasePtr(pool, nullptr);
+	state.SetItemsProcessed(state.iterations());
+}
+
+static void BenchLuaMemPoolRealloc(benchmark::State& state) {
+	LuaMemPool* pool = LuaMemPool::AcquirePtr(false, false);
+
+	// grows a buffer by doubling, as table arrays and string buffers do
+	for (auto _ : state) {
+		void* ptr = nullptr;
+		size_t size = 0;
+
+		for (size_t newSize = 16; newSize <= 16384; newSize *= 2) {
+			ptr = pool->Realloc(ptr, newSize, size);
+			size = newSize;
+		}
+
+		benchmark::DoNotOptimize(ptr);
+		pool->Free(ptr, size);
+	}
+
+	LuaMemPool::ReleasePtr(pool, nullptr);
+	state.SetItemsProcessed(state.iterations() * 11);
+}
+
+static void BenchMallocFree(benchmark::State& state) {
+	const auto& sizes = GetAllocSizes();
+	const size_t numLive = state.range(0);
+
+	std::vector<void*> ptrs(numLive, nullptr);
+
+	size_t n = 0;
+
+	// baseline for BenchLuaMemPoolAllocFree
+	for (auto _ : state) {
+		const size_t i = n % numLive;
+
+		std::free(ptrs[i]);
+		benchmark::DoNotOptimize(ptrs[i] = std::malloc(sizes[n % sizes.size()]));
+		n++;
+	}
+
+	for (void* p: ptrs) {
+		std::free(p);
+	}
+
+	state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BenchLuaMemPoolAllocFree)->Arg(256)->Arg(16384);
+BENCHMARK(BenchLuaMemPoolRealloc);
+BENCHMARK(BenchMallocFree)->Arg(256)->Arg(16384);
+
+BENCHMARK_MAIN();
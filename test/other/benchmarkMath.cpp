@@ -0,0 +1,139 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#include "System/Matrix44f.h"
+#include "System/float3.h"
+#include "System/float4.h"
+#include "System/MathConstants.h"
+#include "System/Misc/SpringTime.h"
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <vector>
+
+namespace {
+	InitSpringTime ist;
+
+	// fixed datasets so runs of different builds are comparable
+	const std::vector<float3>& GetVectors(size_t count) {
+		static std::vector<float3> vectors;
+
+		if (vectors.size() != count) {
+			std::mt19937 rng(12345);
+			std::uniform_real_distribution<float> dist(-1000.0f, 1000.0f);
+
+			vectors.resize(count);
+
+			for (float3& v: vectors) {
+				v = {dist(rng), dist(rng), dist(rng)};
+			}
+		}
+
+		return vectors;
+	}
+
+	const std::vector<CMatrix44f>& GetMatrices(size_t count) {
+		static std::vector<CMatrix44f> matrices;
+
+		if (matrices.size() != count) {
+			std::mt19937 rng(54321);
+			std::uniform_real_distribution<float> angleDist(-math::PI, math::PI);
+			std::uniform_real_distribution<float> posDist(-1000.0f, 1000.0f);
+
+			matrices.resize(count);
+
+			// model-space transforms, as used for pieces and units
+			for (CMatrix44f& m: matrices) {
+				m.LoadIdentity();
+				m.Translate(posDist(rng), posDist(rng), posDist(rng));
+				m.RotateEulerYXZ({angleDist(rng), angleDist(rng), angleDist(rng)});
+			}
+		}
+
+		return matrices;
+	}
+}
+
+static void BenchFloat3Normalize(benchmark::State& state) {
+	const auto& vectors = GetVectors(state.range(0));
+
+	for (auto _ : state) {
+		for (float3 v: vectors) {
+			benchmark::DoNotOptimize(v.SafeNormalize());
+		}
+	}
+
+	state.SetItemsProcessed(state.iterations() * vectors.size());
+}
+
+static void BenchFloat3DotCross(benchmark::State& state) {
+	const auto& vectors = GetVectors(state.range(0));
+
+	for (auto _ : state) {
+		for (size_t i = 1; i < vectors.size(); i++) {
+			benchmark::DoNotOptimize(vectors[i].dot(vectors[i - 1]));
+			benchmark::DoNotOptimize(vectors[i].cross(vectors[i - 1]));
+		}
+	}
+
+	state.SetItemsProcessed(state.iterations() * vectors.size());
+}
+
+static void BenchFloat3Distance(benchmark::State& state) {
+	const auto& vectors = GetVectors(state.range(0));
+
+	for (auto _ : state) {
+		for (size_t i = 1; i < vectors.size(); i++) {
+			benchmark::DoNotOptimize(vectors[i].SqDistance(vectors[i - 1]));
+			benchmark::DoNotOptimize(vectors[i].distance2D(vectors[i - 1]));
+		}
+	}
+
+	state.SetItemsProcessed(state.iterations() * vectors.size());
+}
+
+static void BenchMatrixMulMatrix(benchmark::State& state) {
+	const auto& matrices = GetMatrices(state.range(0));
+
+	for (auto _ : state) {
+		for (size_t i = 1; i < matrices.size(); i++) {
+			benchmark::DoNotOptimize(matrices[i] * matrices[i - 1]);
+		}
+	}
+
+	state.SetItemsProcessed(state.iterations() * matrices.size());
+}
+
+static void BenchMatrixMulVector(benchmark::State& state) {
+	const auto& matrices = GetMatrices(state.range(0));
+	const auto& vectors = GetVectors(state.range(0));
+
+	for (auto _ : state) {
+		for (size_t i = 0; i < matrices.size(); i++) {
+			benchmark::DoNotOptimize(matrices[i] * vectors[i]);
+		}
+	}
+
+	state.SetItemsProcessed(state.iterations() * matrices.size());
+}
+
+static void BenchMatrixInvertAffine(benchmark::State& state) {
+	const auto& matrices = GetMatrices(state.range(0));
+
+	for (auto _ : state) {
+		for (const CMatrix44f& m: matrices) {
+			benchmark::DoNotOptimize(m.InvertAffine());
+		}
+	}
+
+	state.SetItemsProcessed(state.iterations() * matrices.size());
+}
+
+BENCHMARK(BenchFloat3Normalize)->Arg(1024)->Arg(65536);
+BENCHMARK(BenchFloat3DotCross)->Arg(1024)->Arg(65536);
+BENCHMARK(BenchFloat3Distance)->Arg(1024)->Arg(65536);
+BENCHMARK(BenchMatrixMulMatrix)->Arg(1024)->Arg(65536);
+BENCHMARK(BenchMatrixMulVector)->Arg(1024)->Arg(65536);
+BENCHMARK(BenchMatrixInvertAffine)->Arg(1024)->Arg(65536);
+
+BENCHMARK_MAIN();
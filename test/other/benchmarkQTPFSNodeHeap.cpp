@@ -0,0 +1,142 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#include "Sim/Path/QTPFS/NodeHeap.h"
+
+#include <benchmark/benchmark.h>
+
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <queue>
+#include <random>
+#include <tuple>
+#include <vector>
+
+namespace {
+	// mirrors QTPFS::SearchQueueNode
+	struct QueueNode {
+		QueueNode(int index, float priority)
+			: nodeIndex(index)
+			, heapPriority(priority)
+			{}
+
+		uint64_t GetSortKey() const { return std::bit_cast<uint64_t>(*this); }
+
+		int nodeIndex;
+		float heapPriority;
+	};
+
+	struct QueueNodeCmp {
+		bool operator() (const QueueNode& lhs, const QueueNode& rhs) const {
+			return std::tie(lhs.heapPriority, lhs.nodeIndex) > std::tie(rhs.heapPriority, rhs.nodeIndex);
+		}
+	};
+
+	struct QueueNodeKey {
+		uint64_t operator() (const QueueNode& n) const { return n.GetSortKey(); }
+	};
+
+	// a push carries the node index and priority, a pop is stored as index -1
+	typedef std::vector<QueueNode> SearchTrace;
+
+	// Records the open-list operations of a Dijkstra search over a grid with
+	// random move costs, which mimics the access pattern of a QTPFS search
+	// (lazy decrease-key through duplicate pushes, stale entries skipped).
+	SearchTrace RecordSearchTrace(int gridSize) {
+		std::mt19937 rng(12345);
+		std::uniform_real_distribution<float> costDist(1.0f, 4.0f);
+
+		std::vector<float> moveCosts(gridSize * gridSize);
+		for (float& c: moveCosts)
+			c = costDist(rng);
+
+		std::vector<float> gCosts(gridSize * gridSize, std::numeric_limits<float>::infinity());
+		std::priority_queue<QueueNode, std::vector<QueueNode>, QueueNodeCmp> openNodes;
+		SearchTrace trace;
+
+		gCosts[0] = 0.0f;
+		openNodes.emplace(0, 0.0f);
+		trace.emplace_back(0, 0.0f);
+
+		constexpr int dx[] = {1, -1, 0, 0};
+		constexpr int dz[] = {0, 0, 1, -1};
+
+		while (!openNodes.empty()) {
+			const QueueNode cur = openNodes.top();
+			openNodes.pop();
+			trace.emplace_back(-1, 0.0f);
+
+			if (cur.heapPriority > gCosts[cur.nodeIndex])
+				continue;
+
+			const int x = cur.nodeIndex % gridSize;
+			const int z = cur.nodeIndex / gridSize;
+
+			for (int i = 0; i < 4; i++) {
+				const int nx = x + dx[i];
+				const int nz = z + dz[i];
+
+				if (nx < 0 || nz < 0 || nx >= gridSize || nz >= gridSize)
+					continue;
+
+				const int nxtIndex = nz * gridSize + nx;
+				const float nxtCost = cur.heapPriority + moveCosts[nxtIndex];
+
+				if (nxtCost >= gCosts[nxtIndex])
+					continue;
+
+				gCosts[nxtIndex] = nxtCost;
+				openNodes.emplace(nxtIndex, nxtCost);
+				trace.emplace_back(nxtIndex, nxtCost);
+			}
+		}
+
+		return trace;
+	}
+
+	const SearchTrace& GetSearchTrace() {
+		static const SearchTrace trace = RecordSearchTrace(256);
+		return trace;
+	}
+}
+
+template<typename THeap>
+static void ClearHeap(THeap& heap) {
+	if constexpr (requires { heap.clear(); }) {
+		heap.clear();
+	} else {
+		while (!heap.empty())
+			heap.pop();
+	}
+}
+
+template<typename THeap>
+static void BenchReplaySearchTrace(benchmark::State& state) {
+	const SearchTrace& trace = GetSearchTrace();
+	THeap heap;
+
+	for (auto _ : state) {
+		int64_t checksum = 0;
+
+		for (const QueueNode& op: trace) {
+			if (op.nodeIndex < 0) {
+				checksum += heap.top().nodeIndex;
+				heap.pop();
+			} else {
+				heap.emplace(op.nodeIndex, op.heapPriority);
+			}
+		}
+
+		benchmark::DoNotOptimize(checksum);
+		ClearHeap(heap);
+	}
+
+	state.SetItemsProcessed(state.iterations() * trace.size());
+}
+
+BENCHMARK(BenchReplaySearchTrace<std::priority_queue<QueueNode, std::vector<QueueNode>, QueueNodeCmp>>);
+BENCHMARK(BenchReplaySearchTrace<QTPFS::d_ary_heap<QueueNode, QueueNodeKey, 2>>);
+BENCHMARK(BenchReplaySearchTrace<QTPFS::d_ary_heap<QueueNode, QueueNodeKey, 4>>);
+BENCHMARK(BenchReplaySearchTrace<QTPFS::d_ary_heap<QueueNode, QueueNodeKey, 8>>);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,89 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#include "System/Threading/ThreadPool.h"
+#include "System/Platform/Threading.h"
+#include "System/Misc/SpringTime.h"
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+namespace {
+	struct PoolSetup {
+		PoolSetup() {
+			Threading::DetectCores(); // make GetMaxThreads() work
+			ThreadPool::SetThreadCount(ThreadPool::GetMaxThreads());
+		}
+		~PoolSetup() {
+			ThreadPool::SetThreadCount(0);
+		}
+	};
+
+	InitSpringTime ist;
+	PoolSetup poolSetup;
+
+	// trivial per-iteration work, the benchmarks measure scheduling overhead
+	std::vector<uint32_t>& GetData(size_t size) {
+		static std::vector<uint32_t> data;
+		data.resize(size);
+		return data;
+	}
+}
+
+static void BenchForMT(benchmark::State& state) {
+	const int numIters = static_cast<int>(state.range(0));
+	auto& data = GetData(numIters);
+
+	for (auto _ : state) {
+		for_mt(0, numIters, [&data](const int i) {
+			data[i] += i;
+		});
+
+		benchmark::ClobberMemory();
+	}
+
+	state.SetItemsProcessed(state.iterations() * numIters);
+}
+
+static void BenchForMTChunk(benchmark::State& state) {
+	const int numIters = static_cast<int>(state.range(0));
+	auto& data = GetData(numIters);
+
+	for (auto _ : state) {
+		for_mt_chunk(0, numIters, [&data](const int i) {
+			data[i] += i;
+		});
+
+		benchmark::ClobberMemory();
+	}
+
+	state.SetItemsProcessed(state.iterations() * numIters);
+}
+
+// outer loop over a few "layers" with a for_mt each, as QTPFS layer updates do
+static void BenchNestedForMT(benchmark::State& state) {
+	constexpr int numOuter = 16;
+
+	const int numInner = static_cast<int>(state.range(0)) / numOuter;
+	auto& data = GetData(numOuter * numInner);
+
+	for (auto _ : state) {
+		for_mt(0, numOuter, [&data, numInner](const int j) {
+			for_mt(0, numInner, [&data, numInner, j](const int i) {
+				data[j * numInner + i] += i;
+			});
+		});
+
+		benchmark::ClobberMemory();
+	}
+
+	state.SetItemsProcessed(state.iterations() * numOuter * numInner);
+}
+
+BENCHMARK(BenchForMT)->Arg(1000)->Arg(10000)->Arg(100000)->UseRealTime();
+BENCHMARK(BenchForMTChunk)->Arg(1000)->Arg(10000)->Arg(100000)->UseRealTime();
+BENCHMARK(BenchNestedForMT)->Arg(1000)->Arg(10000)->Arg(100000)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,130 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#include "System/UnorderedMap.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+	// fixed key sets; IDs spread over a range a few times the set size, like unit and feature IDs
+	const std::vector<uint32_t>& GetKeys(size_t count, uint32_t seed) {
+		static std::vector<uint32_t> keys[2];
+
+		std::vector<uint32_t>& k = keys[seed & 1];
+
+		if (k.size() != count) {
+			std::mt19937 rng(seed);
+			std::uniform_int_distribution<uint32_t> dist(0, count * 4);
+
+			k.resize(count);
+
+			for (uint32_t& key: k) {
+				key = dist(rng);
+			}
+		}
+
+		return k;
+	}
+
+	const std::vector<uint32_t>& GetHitKeys(size_t count) { return GetKeys(count, 12344); }
+	const std::vector<uint32_t>& GetMissKeys(size_t count) { return GetKeys(count, 12345); }
+
+	template<typename Map>
+	void FillMap(Map& map, const std::vector<uint32_t>& keys) {
+		map.clear();
+		map.reserve(keys.size());
+
+		for (const uint32_t key: keys) {
+			map[key] = key;
+		}
+	}
+}
+
+template<typename Map>
+static void BenchMapInsert(benchmark::State& state) {
+	const auto& keys = GetHitKeys(state.range(0));
+
+	Map map;
+
+	for (auto _ : state) {
+		map.clear();
+
+		for (const uint32_t key: keys) {
+			map[key] = key;
+		}
+
+		benchmark::DoNotOptimize(map.size());
+	}
+
+	state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+template<typename Map>
+static void BenchMapFindHit(benchmark::State& state) {
+	const auto& keys = GetHitKeys(state.range(0));
+
+	Map map;
+	FillMap(map, keys);
+
+	for (auto _ : state) {
+		for (const uint32_t key: keys) {
+			benchmark::DoNotOptimize(map.find(key));
+		}
+	}
+
+	state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+template<typename Map>
+static void BenchMapFindMiss(benchmark::State& state) {
+	const auto& keys = GetHitKeys(state.range(0));
+	const auto& missKeys = GetMissKeys(state.range(0));
+
+	Map map;
+	FillMap(map, keys);
+
+	// (mostly) misses, the random sets overlap somewhat
+	for (auto _ : state) {
+		for (const uint32_t key: missKeys) {
+			benchmark::DoNotOptimize(map.find(key));
+		}
+	}
+
+	state.SetItemsProcessed(state.iterations() * missKeys.size());
+}
+
+template<typename Map>
+static void BenchMapEraseInsert(benchmark::State& state) {
+	const auto& keys = GetHitKeys(state.range(0));
+
+	Map map;
+	FillMap(map, keys);
+
+	// steady-state churn, as objects die and get created
+	for (auto _ : state) {
+		for (const uint32_t key: keys) {
+			map.erase(key);
+			map[key] = key;
+		}
+	}
+
+	state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+using SpringMap = spring::unordered_map<uint32_t, uint32_t>;
+using StdMap = std::unordered_map<uint32_t, uint32_t>;
+
+BENCHMARK_TEMPLATE(BenchMapInsert, SpringMap)->Arg(1024)->Arg(32768);
+BENCHMARK_TEMPLATE(BenchMapInsert, StdMap)->Arg(1024)->Arg(32768);
+BENCHMARK_TEMPLATE(BenchMapFindHit, SpringMap)->Arg(1024)->Arg(32768);
+BENCHMARK_TEMPLATE(BenchMapFindHit, StdMap)->Arg(1024)->Arg(32768);
+BENCHMARK_TEMPLATE(BenchMapFindMiss, SpringMap)->Arg(1024)->Arg(32768);
+BENCHMARK_TEMPLATE(BenchMapFindMiss, StdMap)->Arg(1024)->Arg(32768);
+BENCHMARK_TEMPLATE(BenchMapEraseInsert, SpringMap)->Arg(1024)->Arg(32768);
+BENCHMARK_TEMPLATE(BenchMapEraseInsert, StdMap)->Arg(1024)->Arg(32768);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,97 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#include "System/FrameArena.h"
+
+#include <cstdint>
+#include <thread>
+
+#include <catch_amalgamated.hpp>
+
+TEST_CASE("FrameArena allocations are aligned and distinct")
+{
+	CFrameArena::NewFrame();
+
+	CFrameArena& arena = CFrameArena::Get();
+
+	auto* a = static_cast<uint8_t*>(arena.Allocate(3, 1));
+	auto* b = static_cast<uint64_t*>(arena.Allocate(sizeof(uint64_t), alignof(uint64_t)));
+
+	CHECK(reinterpret_cast<uintptr_t>(b) % alignof(uint64_t) == 0);
+	CHECK(reinterpret_cast<uint8_t*>(b) >= (a + 3));
+}
+
+TEST_CASE("FrameArena rewinds on a new frame")
+{
+	CFrameArena::NewFrame();
+
+	CFrameArena& arena = CFrameArena::Get();
+	void* first = arena.Allocate(64, 16);
+
+	CFrameArena::NewFrame();
+	CHECK(arena.Allocate(64, 16) == first);
+}
+
+TEST_CASE("FrameArena takes back the latest allocation only")
+{
+	CFrameArena::NewFrame();
+
+	CFrameArena& arena = CFrameArena::Get();
+
+	void* a = arena.Allocate(32, 8);
+	void* b = arena.Allocate(32, 8);
+
+	// not the latest, stays allocated
+	arena.Deallocate(a, 32);
+
+	void* c = arena.Allocate(32, 8);
+	CHECK(c != a);
+	CHECK(c != b);
+
+	// latest, next allocation reuses it
+	arena.Deallocate(c, 32);
+	CHECK(arena.Allocate(32, 8) == c);
+}
+
+TEST_CASE("FrameArena folds overflowing chunks")
+{
+	CFrameArena::NewFrame();
+
+	CFrameArena& arena = CFrameArena::Get();
+
+	for (size_t i = 0; i < 4; i++) {
+		arena.Allocate(CFrameArena::CHUNK_SIZE, 8);
+	}
+
+	CHECK(CFrameArena::GetStats().numChunks >= 4);
+
+	CFrameArena::NewFrame();
+	arena.Allocate(8, 8);
+
+	const CFrameArena::Stats stats = CFrameArena::GetStats();
+
+	CHECK(stats.numChunks == 1);
+	CHECK(stats.reservedBytes >= (4 * CFrameArena::CHUNK_SIZE));
+	CHECK(stats.peakBytes >= (4 * CFrameArena::CHUNK_SIZE));
+}
+
+TEST_CASE("FrameVector uses the constructing thread's arena")
+{
+	CFrameArena::NewFrame();
+
+	FrameVector<int> v;
+
+	for (int i = 0; i < 10000; i++) {
+		v.push_back(i);
+	}
+
+	CHECK(v.size() == 10000);
+	CHECK(v[9999] == 9999);
+
+	std::thread t([]() {
+		FrameVector<int> w(100, 1);
+		CHECK(CFrameArena::GetStats().numArenas == 2);
+	});
+	t.join();
+
+	CHECK(CFrameArena::GetStats().numArenas == 1);
+}
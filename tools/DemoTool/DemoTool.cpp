@@ -2,7 +2,14 @@
 
 #include <string>
 #include <map>
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <fstream>
 #include <iostream>
+#include <sstream>
+#include <thread>
+#include <vector>
 #include <gflags/gflags.h>
 #include <iomanip> //hex
 
@@ -17,6 +24,10 @@
 Usage:
 Start with the full! path to the demofile as the only argument
 
+With --statscsv any number of demofiles can be given, their teamstats are
+read concurrently and written as one csv file (one row per demo, team and
+stats period), which is meant for batch-processing large sets of replays.
+
 Please note that not all NETMSG's are implemented, expand if needed.
 
 When compiling for windows with MinGW, make sure to use the
@@ -32,10 +43,13 @@ no console output (you still could use this.exe > z.tzt though).
 	DEFINE_bool  (teamstats,    false, "Print teamstats");
 	DEFINE_int32 (team,         -1,    "Select team");
 	DEFINE_string(teamsstatcsv, "",    "Write teamstats in a csv file");
+	DEFINE_string(statscsv,     "",    "Write the teamstats of all teams of all given demos in one csv file");
+	DEFINE_int32 (jobs,         0,     "Number of demos read concurrently for statscsv (0 = one per core)");
 
 
 void TrafficDump(CDemoReader& reader, bool trafficStats);
 void WriteTeamstatHistory(CDemoReader& reader, unsigned team, const std::string& file);
+int WriteStatsCsv(const std::vector<std::string>& demoFiles, const std::string& file, int numJobs);
 
 int main (int argc, char* argv[])
 {
@@ -43,6 +57,14 @@ int main (int argc, char* argv[])
 
 	gflags::SetUsageMessage(std::string("Usage: ") + argv[0] + " [options] path_to_demo.sdfz");
 	gflags::ParseCommandLineFlags(&argc, &argv, true);
+	if (!FLAGS_statscsv.empty())
+	{
+		std::vector<std::string> demoFiles(argv + 1, argv + argc);
+		if (!FLAGS_demofile.empty())
+			demoFiles.insert(demoFiles.begin(), FLAGS_demofile);
+
+		return WriteStatsCsv(demoFiles, FLAGS_statscsv, FLAGS_jobs);
+	}
 	if (!FLAGS_demofile.empty()) {
 		filename = FLAGS_demofile;
 	} else if (argc >= 2) {
@@ -453,11 +475,41 @@ void TrafficDump(CDemoReader& reader, bool trafficStats)
 }
 
 template<typename T>
-void PrintSep(std::ofstream& file, T value)
+void PrintSep(std::ostream& file, T value)
 {
 	file << value << ";";
 }
 
+static const char* const TEAMSTATS_CSV_COLUMNS =
+	"MetalUsed;EnergyUsed;MetalProduced;EnergyProduced;MetalExcess;EnergyExcess;"
+	"MetalReceived;EnergyReceived;MetalSent;EnergySent;DamageDealt;DamageReceived;"
+	"UnitsProduced;UnitsDied;UnitsReceived;UnitsSent;UnitsCaptured;"
+	"UnitsOutCaptured;UnitsKilled";
+
+static void PrintTeamStatsRow(std::ostream& out, const TeamStatistics& stats)
+{
+	PrintSep(out, stats.metalUsed);
+	PrintSep(out, stats.energyUsed);
+	PrintSep(out, stats.metalProduced);
+	PrintSep(out, stats.energyProduced);
+	PrintSep(out, stats.metalExcess);
+	PrintSep(out, stats.energyExcess);
+	PrintSep(out, stats.metalReceived);
+	PrintSep(out, stats.energyReceived);
+	PrintSep(out, stats.metalSent);
+	PrintSep(out, stats.energySent);
+	PrintSep(out, stats.damageDealt);
+	PrintSep(out, stats.damageReceived);
+	PrintSep(out, stats.unitsProduced);
+	PrintSep(out, stats.unitsDied);
+	PrintSep(out, stats.unitsReceived);
+	PrintSep(out, stats.unitsSent);
+	PrintSep(out, stats.unitsCaptured);
+	PrintSep(out, stats.unitsOutCaptured);
+	PrintSep(out, stats.unitsKilled);
+	out << std::endl;
+}
+
 void WriteTeamstatHistory(CDemoReader& reader, unsigned team, const std::string& file)
 {
 	const DemoFileHeader header = reader.GetFileHeader();
@@ -467,33 +519,11 @@ void WriteTeamstatHistory(CDemoReader& reader, unsigned team, const std::string&
 		int time = 0;
 		std::ofstream out(file.c_str());
 		out << "Team Statistics for " << team << std::endl;
-		out << "Time[sec];MetalUsed;EnergyUsed;MetalProduced;EnergyProduced;MetalExcess;EnergyExcess;"
-		    << "EnergyReceived;MetalSent;EnergySent;DamageDealt;DamageReceived;"
-		    << "UnitsProduced;UnitsDied;UnitsReceived;UnitsSent;nitsCaptured;"
-		    << "UnitsOutCaptured;UnitsKilled" << std::endl;
+		out << "Time[sec];" << TEAMSTATS_CSV_COLUMNS << std::endl;
 		for (unsigned i = 0; i < statvec[team].size(); ++i)
 		{
 			PrintSep(out, time);
-			PrintSep(out, statvec[team][i].metalUsed);
-			PrintSep(out, statvec[team][i].energyUsed);
-			PrintSep(out, statvec[team][i].metalProduced);
-			PrintSep(out, statvec[team][i].energyProduced);
-			PrintSep(out, statvec[team][i].metalExcess);
-			PrintSep(out, statvec[team][i].energyExcess);
-			PrintSep(out, statvec[team][i].metalReceived);
-			PrintSep(out, statvec[team][i].energyReceived);
-			PrintSep(out, statvec[team][i].metalSent);
-			PrintSep(out, statvec[team][i].energySent);
-			PrintSep(out, statvec[team][i].damageDealt);
-			PrintSep(out, statvec[team][i].damageReceived);
-			PrintSep(out, statvec[team][i].unitsProduced);
-			PrintSep(out, statvec[team][i].unitsDied);
-			PrintSep(out, statvec[team][i].unitsReceived);
-			PrintSep(out, statvec[team][i].unitsSent);
-			PrintSep(out, statvec[team][i].unitsCaptured);
-			PrintSep(out, statvec[team][i].unitsOutCaptured);
-			PrintSep(out, statvec[team][i].unitsKilled);
-			out << std::endl;
+			PrintTeamStatsRow(out, statvec[team][i]);
 			time += header.teamStatPeriod;
 		}
 	}
@@ -503,3 +533,76 @@ void WriteTeamstatHistory(CDemoReader& reader, unsigned team, const std::string&
 		exit(1);
 	}
 };
+
+int WriteStatsCsv(const std::vector<std::string>& demoFiles, const std::string& file, int numJobs)
+{
+	if (demoFiles.empty())
+	{
+		std::cout << "statscsv requires at least one demofile" << std::endl;
+		return 1;
+	}
+
+	// demos are independent, so each worker claims the next unread one;
+	// rows are collected per demo to keep the output in argument order
+	std::vector<std::string> rows(demoFiles.size());
+	std::vector<std::string> errors(demoFiles.size());
+	std::atomic<size_t> nextDemo = {0};
+
+	const auto ReadDemos = [&]() {
+		for (size_t n = nextDemo++; n < demoFiles.size(); n = nextDemo++)
+		{
+			try {
+				CDemoReader reader(demoFiles[n], 0.0f);
+				reader.LoadStats();
+
+				const DemoFileHeader header = reader.GetFileHeader();
+				const std::vector< std::vector<TeamStatistics> >& statvec = reader.GetTeamStats();
+				std::ostringstream out;
+
+				for (unsigned team = 0; team < statvec.size(); ++team)
+				{
+					for (unsigned i = 0; i < statvec[team].size(); ++i)
+					{
+						PrintSep(out, demoFiles[n]);
+						PrintSep(out, team);
+						PrintSep(out, i * header.teamStatPeriod);
+						PrintTeamStatsRow(out, statvec[team][i]);
+					}
+				}
+
+				rows[n] = out.str();
+			} catch (const std::exception& e) {
+				errors[n] = e.what();
+			}
+		}
+	};
+
+	if (numJobs <= 0)
+		numJobs = std::max(1u, std::thread::hardware_concurrency());
+
+	std::vector<std::thread> workers;
+	for (int i = 1, n = std::min<int>(numJobs, demoFiles.size()); i < n; ++i)
+		workers.emplace_back(ReadDemos);
+
+	ReadDemos();
+
+	for (std::thread& worker: workers)
+		worker.join();
+
+	std::ofstream out(file.c_str());
+	out << "Demo;Team;Time[sec];" << TEAMSTATS_CSV_COLUMNS << std::endl;
+
+	int numFailed = 0;
+	for (size_t n = 0; n < demoFiles.size(); ++n)
+	{
+		out << rows[n];
+
+		if (errors[n].empty())
+			continue;
+
+		std::cout << "Skipped " << demoFiles[n] << ": " << errors[n] << std::endl;
+		numFailed += 1;
+	}
+
+	return (numFailed > 0);
+}
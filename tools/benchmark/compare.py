@@ -0,0 +1,67 @@
+#!/usr/bin/env python3
+"""
+Compares two benchmark reports written by --benchmark-frames (see
+run_scenario.sh), e.g. of two engine versions running the same scenario.
+
+Prints per-timer milliseconds per sim frame for both runs and the relative
+change; exits with status 1 if any timer regressed by more than the
+threshold (and at least --min-ms per frame, to ignore noise in tiny timers).
+
+Usage: compare.py base.json new.json [--threshold 0.05] [--min-ms 0.05]
+"""
+
+import argparse
+import json
+import sys
+
+
+def load(path):
+	with open(path) as f:
+		return json.load(f)
+
+
+def main():
+	parser = argparse.ArgumentParser(description="compare two benchmark reports")
+	parser.add_argument("base")
+	parser.add_argument("new")
+	parser.add_argument("--threshold", type=float, default=0.05, help="relative slowdown counted as regression")
+	parser.add_argument("--min-ms", type=float, default=0.05, help="ignore timers below this many ms per frame")
+	args = parser.parse_args()
+
+	base = load(args.base)
+	new = load(args.new)
+
+	print("base: %s (%s, %s), %d frames, %.1f frames/s" % (base["engine"], base["game"], base["map"], base["frames"], base["simFramesPerSecond"]))
+	print("new:  %s (%s, %s), %d frames, %.1f frames/s" % (new["engine"], new["game"], new["map"], new["frames"], new["simFramesPerSecond"]))
+	print()
+
+	regressions = []
+	names = sorted(set(base["timers"]) | set(new["timers"]))
+
+	print("%-48s %12s %12s %9s" % ("timer", "base ms/f", "new ms/f", "change"))
+
+	for name in names:
+		b = base["timers"].get(name, {}).get("perFrameMs", 0.0)
+		n = new["timers"].get(name, {}).get("perFrameMs", 0.0)
+
+		if max(b, n) < args.min_ms:
+			continue
+
+		change = (n - b) / b if b > 0.0 else float("inf")
+		flag = ""
+
+		if change > args.threshold:
+			flag = " <-"
+			regressions.append(name)
+
+		print("%-48s %12.3f %12.3f %+8.1f%%%s" % (name, b, n, change * 100.0, flag))
+
+	if regressions:
+		print("\n%d timer(s) regressed by more than %.1f%%" % (len(regressions), args.threshold * 100.0))
+		return 1
+
+	return 0
+
+
+if __name__ == "__main__":
+	sys.exit(main())
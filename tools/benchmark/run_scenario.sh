@@ -0,0 +1,54 @@
+#!/bin/bash
+#
+# Runs a benchmark scenario with a headless engine and writes its JSON report.
+#
+# A scenario is a directory with
+#   script.txt    start script (map, game, AIs; may also reference a demo)
+#   commands.txt  optional actions issued at game start, e.g. cheat + give
+#   frames        optional number of sim frames to run (default 9000)
+#
+# Usage: run_scenario.sh <spring-headless> <scenario-dir> [report.json]
+# Environment: MAP, GAME override the start script's map and game,
+#              FRAMES overrides the scenario's frame count.
+#
+# Compare two reports (e.g. of different engine versions) with compare.py.
+
+set -e
+
+if [ $# -lt 2 ]; then
+	echo "Usage: $0 <spring-headless> <scenario-dir> [report.json]"
+	exit 1
+fi
+
+ENGINE=$(realpath "$1")
+SCENARIO=$(realpath "$2")
+REPORT=$(realpath "${3:-$(basename "$SCENARIO").json}")
+
+if [ -z "$FRAMES" ]; then
+	FRAMES=9000
+	if [ -s "$SCENARIO/frames" ]; then
+		FRAMES=$(cat "$SCENARIO/frames")
+	fi
+fi
+
+TMPDIR=$(mktemp -d)
+trap 'rm -rf "$TMPDIR"' EXIT
+
+SCRIPT="$TMPDIR/script.txt"
+cp "$SCENARIO/script.txt" "$SCRIPT"
+
+if [ -n "$MAP" ]; then
+	sed -i "s/^\(\s*\)Mapname=.*;/\1Mapname=$MAP;/" "$SCRIPT"
+fi
+if [ -n "$GAME" ]; then
+	sed -i "s/^\(\s*\)GameType=.*;/\1GameType=$GAME;/" "$SCRIPT"
+fi
+
+ARGS=(--benchmark-frames "$FRAMES" --benchmark-output "$REPORT")
+if [ -s "$SCENARIO/commands.txt" ]; then
+	ARGS+=(--benchmark-commands "$SCENARIO/commands.txt")
+fi
+
+echo "Running $(basename "$SCENARIO") for $FRAMES frames"
+"$ENGINE" "${ARGS[@]}" "$SCRIPT"
+echo "Report: $REPORT"
@@ -0,0 +1,98 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#include "MapInfoCache.h"
+
+#include <cstdio>
+#include <cstring>
+
+#include "System/FileSystem/FileSystem.h"
+#include "System/Log/ILog.h"
+
+static constexpr std::uint32_t CACHE_ITEM_MAGIC = 0x43494d55; // "UMIC"
+static constexpr std::uint32_t CACHE_ITEM_VERSION = 1;
+
+// half of the digest is plenty to tell map versions apart and keeps paths short
+static constexpr size_t CACHE_KEY_LENGTH = sha512::SHA_LEN;
+
+struct CacheItemHeader {
+	std::uint32_t magic;
+	std::uint32_t version;
+	std::uint64_t size;
+};
+
+
+std::string CMapInfoCache::GetKey(const sha512::raw_digest& checksum)
+{
+	if (checksum == sha512::NULL_RAW_DIGEST)
+		return "";
+
+	return (sha512::dump_digest(checksum).substr(0, CACHE_KEY_LENGTH));
+}
+
+std::string CMapInfoCache::GetItemPath(const std::string& key, const std::string& item)
+{
+	return (FileSystem::EnsurePathSepAtEnd(FileSystem::GetCacheDir()) + "maps/" + key + "/" + item + ".bin");
+}
+
+
+bool CMapInfoCache::Load(const std::string& key, const std::string& item, std::vector<std::uint8_t>& data) const
+{
+	if (key.empty())
+		return false;
+
+	FILE* file = fopen(GetItemPath(key, item).c_str(), "rb");
+
+	if (file == nullptr)
+		return false;
+
+	CacheItemHeader header;
+	bool ret = false;
+
+	if (fread(&header, sizeof(header), 1, file) == 1 && header.magic == CACHE_ITEM_MAGIC && header.version == CACHE_ITEM_VERSION) {
+		data.resize(header.size);
+		ret = (data.empty() || fread(data.data(), data.size(), 1, file) == 1);
+	}
+
+	fclose(file);
+
+	if (!ret)
+		data.clear();
+
+	return ret;
+}
+
+bool CMapInfoCache::Store(const std::string& key, const std::string& item, const void* data, size_t size) const
+{
+	if (key.empty())
+		return false;
+
+	const std::string itemPath = GetItemPath(key, item);
+	const std::string tempPath = itemPath + ".tmp";
+
+	if (!FileSystem::CreateDirectory(FileSystem::GetDirectory(itemPath)))
+		return false;
+
+	FILE* file = fopen(tempPath.c_str(), "wb");
+
+	if (file == nullptr) {
+		LOG_L(L_WARNING, "[MapInfoCache::%s] could not open \"%s\" for writing", __func__, tempPath.c_str());
+		return false;
+	}
+
+	const CacheItemHeader header = {CACHE_ITEM_MAGIC, CACHE_ITEM_VERSION, size};
+
+	bool ret = (fwrite(&header, sizeof(header), 1, file) == 1);
+	ret = ret && (size == 0 || fwrite(data, size, 1, file) == 1);
+	ret = (fclose(file) == 0) && ret;
+
+	// written to a temporary first so an aborted writer never leaves a truncated item;
+	// rename does not replace existing files on Windows, hence the explicit remove
+	std::remove(itemPath.c_str());
+
+	if (!ret || std::rename(tempPath.c_str(), itemPath.c_str()) != 0) {
+		std::remove(tempPath.c_str());
+		return false;
+	}
+
+	return true;
+}
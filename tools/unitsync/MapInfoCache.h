@@ -0,0 +1,33 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#ifndef UNITSYNC_MAP_INFO_CACHE_H
+#define UNITSYNC_MAP_INFO_CACHE_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "System/Sync/SHA512.hpp"
+
+/**
+ * @brief On-disk cache of data extracted from maps
+ *
+ * Parsed map info, minimaps and infomaps are stored next to the archive
+ * cache, in one directory per map named after the map's checksum. Lobbies
+ * listing all maps therefore only pay for opening the archives (and e.g.
+ * decompressing the minimap) once per map version, not on every start.
+ */
+class CMapInfoCache
+{
+public:
+	/// @return an empty key if the checksum is unknown, which disables caching
+	static std::string GetKey(const sha512::raw_digest& checksum);
+
+	bool Load(const std::string& key, const std::string& item, std::vector<std::uint8_t>& data) const;
+	bool Store(const std::string& key, const std::string& item, const void* data, size_t size) const;
+
+private:
+	static std::string GetItemPath(const std::string& key, const std::string& item);
+};
+
+#endif // UNITSYNC_MAP_INFO_CACHE_H
@@ -2,6 +2,7 @@
 
 #include "unitsync.h"
 #include "unitsync_api.h"
+#include "MapInfoCache.h"
 
 #include <algorithm>
 #include <cstring>
@@ -152,6 +153,7 @@ static std::vector<InfoItem> infoItems;
 static std::set<std::string> infoSet;
 static std::vector<GameDataUnitDef> unitDefs;
 static std::map<int, InternalMapInfo> mapInfos;
+static CMapInfoCache mapInfoCache;
 static std::map<int, IArchive*> openArchives;
 static std::map<int, CFileHandler*> openFiles;
 static std::vector<std::string> curFindFiles;
@@ -668,6 +670,105 @@ static bool internal_GetMapInfo(const char* mapName, InternalMapInfo* outInfo)
 
 
 
+static std::string GetMapCacheKey(const std::string& mapName)
+{
+	return (CMapInfoCache::GetKey(archiveScanner->GetArchiveCompleteChecksumBytes(mapName)));
+}
+
+static void SerializeMapInfo(const InternalMapInfo& mi, std::vector<std::uint8_t>& buf)
+{
+	const auto PushBytes = [&](const void* p, size_t n) { buf.insert(buf.end(), static_cast<const std::uint8_t*>(p), static_cast<const std::uint8_t*>(p) + n); };
+	const auto PushString = [&](const std::string& str) { const std::uint32_t n = str.size(); PushBytes(&n, sizeof(n)); PushBytes(str.data(), n); };
+	const auto PushFloats = [&](const std::vector<float>& vec) { const std::uint32_t n = vec.size(); PushBytes(&n, sizeof(n)); PushBytes(vec.data(), n * sizeof(float)); };
+
+	buf.clear();
+
+	PushString(mi.description);
+	PushString(mi.author);
+	PushBytes(&mi.tidalStrength, sizeof(mi.tidalStrength));
+	PushBytes(&mi.gravity, sizeof(mi.gravity));
+	PushBytes(&mi.maxMetal, sizeof(mi.maxMetal));
+	PushBytes(&mi.extractorRadius, sizeof(mi.extractorRadius));
+	PushBytes(&mi.minWind, sizeof(mi.minWind));
+	PushBytes(&mi.maxWind, sizeof(mi.maxWind));
+	PushBytes(&mi.width, sizeof(mi.width));
+	PushBytes(&mi.height, sizeof(mi.height));
+	PushFloats(mi.xPos);
+	PushFloats(mi.zPos);
+}
+
+static bool DeserializeMapInfo(const std::vector<std::uint8_t>& buf, InternalMapInfo& mi)
+{
+	size_t pos = 0;
+
+	const auto PopBytes = [&](void* p, size_t n) {
+		if ((pos + n) > buf.size())
+			return false;
+
+		std::memcpy(p, buf.data() + pos, n);
+		pos += n;
+		return true;
+	};
+	const auto PopString = [&](std::string& str) {
+		std::uint32_t n = 0;
+
+		if (!PopBytes(&n, sizeof(n)) || (pos + n) > buf.size())
+			return false;
+
+		str.assign(reinterpret_cast<const char*>(buf.data() + pos), n);
+		pos += n;
+		return true;
+	};
+	const auto PopFloats = [&](std::vector<float>& vec) {
+		std::uint32_t n = 0;
+
+		if (!PopBytes(&n, sizeof(n)) || (pos + n * sizeof(float)) > buf.size())
+			return false;
+
+		vec.resize(n);
+		return PopBytes(vec.data(), n * sizeof(float));
+	};
+
+	bool ret = true;
+
+	ret = ret && PopString(mi.description);
+	ret = ret && PopString(mi.author);
+	ret = ret && PopBytes(&mi.tidalStrength, sizeof(mi.tidalStrength));
+	ret = ret && PopBytes(&mi.gravity, sizeof(mi.gravity));
+	ret = ret && PopBytes(&mi.maxMetal, sizeof(mi.maxMetal));
+	ret = ret && PopBytes(&mi.extractorRadius, sizeof(mi.extractorRadius));
+	ret = ret && PopBytes(&mi.minWind, sizeof(mi.minWind));
+	ret = ret && PopBytes(&mi.maxWind, sizeof(mi.maxWind));
+	ret = ret && PopBytes(&mi.width, sizeof(mi.width));
+	ret = ret && PopBytes(&mi.height, sizeof(mi.height));
+	ret = ret && PopFloats(mi.xPos);
+	ret = ret && PopFloats(mi.zPos);
+
+	return (ret && pos == buf.size());
+}
+
+/// like internal_GetMapInfo, but served from and added to the persistent map cache
+static bool internal_GetCachedMapInfo(const std::string& mapName, InternalMapInfo* outInfo)
+{
+	const std::string cacheKey = GetMapCacheKey(mapName);
+	std::vector<std::uint8_t> buf;
+
+	if (mapInfoCache.Load(cacheKey, "mapinfo", buf) && DeserializeMapInfo(buf, *outInfo))
+		return true;
+
+	// drop whatever a stale or truncated item left behind
+	*outInfo = {};
+
+	if (!internal_GetMapInfo(mapName.c_str(), outInfo))
+		return false;
+
+	SerializeMapInfo(*outInfo, buf);
+	mapInfoCache.Store(cacheKey, "mapinfo", buf.data(), buf.size());
+	return true;
+}
+
+
+
 EXPORT(int) GetMapCount()
 {
 	int count = -1;
@@ -726,7 +827,7 @@ static InternalMapInfo* internal_getMapInfo(int index)
 
 		try {
 			InternalMapInfo imi;
-			if (internal_GetMapInfo(mapNames[index].c_str(), &imi)) {
+			if (internal_GetCachedMapInfo(mapNames[index], &imi)) {
 				mapInfos[index] = imi;
 				return &(mapInfos[index]);
 			}
@@ -969,6 +1070,19 @@ EXPORT(unsigned short*) GetMinimap(const char* mapName, int mipLevel)
 			throw std::out_of_range("Miplevel must be between 0 and 8 (inclusive) in GetMinimap.");
 
 		const std::string mapFile = GetMapFile(mapName);
+		const std::string cacheKey = GetMapCacheKey(mapName);
+		const std::string cacheItem = IntToString(mipLevel, "minimap%i");
+
+		const size_t mipSize = 1024 >> mipLevel;
+		const size_t mipBytes = mipSize * mipSize * sizeof(imgbuf[0]);
+
+		std::vector<std::uint8_t> cached;
+
+		if (mapInfoCache.Load(cacheKey, cacheItem, cached) && cached.size() == mipBytes) {
+			std::memcpy(imgbuf, cached.data(), mipBytes);
+			return imgbuf;
+		}
+
 		ScopedMapLoader mapLoader(mapName, mapFile);
 
 		unsigned short* ret = nullptr;
@@ -979,6 +1093,9 @@ EXPORT(unsigned short*) GetMinimap(const char* mapName, int mipLevel)
 			ret = GetMinimapSM3(mapFile, mipLevel);
 		}
 
+		if (ret != nullptr)
+			mapInfoCache.Store(cacheKey, cacheItem, ret, mipBytes);
+
 		return ret;
 	}
 	UNITSYNC_CATCH_BLOCKS;
@@ -986,6 +1103,53 @@ EXPORT(unsigned short*) GetMinimap(const char* mapName, int mipLevel)
 }
 
 
+/**
+ * Reads infomap name of mapName in its native format (16 bits per pixel for
+ * "height", 8 otherwise) into data, or from the persistent map cache if it
+ * was extracted before. Returns false for unknown or unreadable infomaps.
+ */
+static bool GetCachedInfoMap(const char* mapName, const char* name, MapBitmapInfo& bmInfo, std::vector<std::uint8_t>& data)
+{
+	const std::string mapFile = GetMapFile(mapName);
+	const std::string cacheKey = GetMapCacheKey(mapName);
+	const std::string cacheItem = std::string("infomap_") + name;
+
+	const size_t pixelBytes = (strcmp(name, "height") == 0)? sizeof(unsigned short): sizeof(unsigned char);
+
+	// cached items are prefixed by the infomap dimensions
+	if (mapInfoCache.Load(cacheKey, cacheItem, data) && data.size() >= sizeof(bmInfo.width) * 2) {
+		std::memcpy(&bmInfo.width, data.data(), sizeof(bmInfo.width));
+		std::memcpy(&bmInfo.height, data.data() + sizeof(bmInfo.width), sizeof(bmInfo.height));
+
+		if (data.size() == (sizeof(bmInfo.width) * 2 + bmInfo.width * bmInfo.height * pixelBytes)) {
+			data.erase(data.begin(), data.begin() + sizeof(bmInfo.width) * 2);
+			return (bmInfo.width * bmInfo.height > 0);
+		}
+	}
+
+	ScopedMapLoader mapLoader(mapName, mapFile);
+	CSMFMapFile file(mapFile);
+
+	file.GetInfoMapSize(name, &bmInfo);
+
+	if (bmInfo.width * bmInfo.height <= 0)
+		return false;
+
+	data.clear();
+	data.resize(sizeof(bmInfo.width) * 2 + bmInfo.width * bmInfo.height * pixelBytes);
+
+	std::memcpy(data.data(), &bmInfo.width, sizeof(bmInfo.width));
+	std::memcpy(data.data() + sizeof(bmInfo.width), &bmInfo.height, sizeof(bmInfo.height));
+
+	if (!file.ReadInfoMap(name, data.data() + sizeof(bmInfo.width) * 2))
+		return false;
+
+	mapInfoCache.Store(cacheKey, cacheItem, data.data(), data.size());
+	data.erase(data.begin(), data.begin() + sizeof(bmInfo.width) * 2);
+	return true;
+}
+
+
 EXPORT(int) GetInfoMapSize(const char* mapName, const char* name, int* width, int* height)
 {
 	try {
@@ -995,12 +1159,10 @@ EXPORT(int) GetInfoMapSize(const char* mapName, const char* name, int* width, in
 		CheckNull(width);
 		CheckNull(height);
 
-		const std::string mapFile = GetMapFile(mapName);
-		ScopedMapLoader mapLoader(mapName, mapFile);
-		CSMFMapFile file(mapFile);
 		MapBitmapInfo bmInfo;
+		std::vector<std::uint8_t> infoMap;
 
-		file.GetInfoMapSize(name, &bmInfo);
+		GetCachedInfoMap(mapName, name, bmInfo, infoMap);
 
 		*width = bmInfo.width;
 		*height = bmInfo.height;
@@ -1026,32 +1188,26 @@ EXPORT(int) GetInfoMap(const char* mapName, const char* name, unsigned char* dat
 		CheckNullOrEmpty(name);
 		CheckNull(data);
 
-		const std::string mapFile = GetMapFile(mapName);
-		ScopedMapLoader mapLoader(mapName, mapFile);
-		CSMFMapFile file(mapFile);
-
 		const int actualType = (strcmp(name, "height") == 0)? bm_grayscale_16 : bm_grayscale_8;
 
+		MapBitmapInfo bmInfo;
+		std::vector<std::uint8_t> infoMap;
+
 		if (actualType == typeHint) {
-			ret = file.ReadInfoMap(name, data);
+			if (GetCachedInfoMap(mapName, name, bmInfo, infoMap)) {
+				std::memcpy(data, infoMap.data(), infoMap.size());
+				ret = 1;
+			}
 		} else if (actualType == bm_grayscale_16 && typeHint == bm_grayscale_8) {
 			// convert from 16 bits per pixel to 8 bits per pixel
-			MapBitmapInfo bmInfo;
-			file.GetInfoMapSize(name, &bmInfo);
-
-			const int size = bmInfo.width * bmInfo.height;
-			if (size > 0) {
-				unsigned short* temp = new unsigned short[size];
-				if (file.ReadInfoMap(name, temp)) {
-					const unsigned short* inp = temp;
-					const unsigned short* inp_end = temp + size;
-					unsigned char* outp = data;
-					for (; inp < inp_end; ++inp, ++outp) {
-						*outp = *inp >> 8;
-					}
-					ret = 1;
+			if (GetCachedInfoMap(mapName, name, bmInfo, infoMap)) {
+				const unsigned short* inp = reinterpret_cast<const unsigned short*>(infoMap.data());
+				const unsigned short* inp_end = inp + bmInfo.width * bmInfo.height;
+				unsigned char* outp = data;
+				for (; inp < inp_end; ++inp, ++outp) {
+					*outp = *inp >> 8;
 				}
-				delete[] temp;
+				ret = 1;
 			}
 		} else if (actualType == bm_grayscale_8 && typeHint == bm_grayscale_16) {
 			throw content_error("converting from 8 bits per pixel to 16 bits per pixel is unsupported");
@@ -1459,6 +1615,25 @@ EXPORT(int) GetSkirmishAIInfoCount(int aiIndex) {
 	return -1;
 }
 
+static void AppendMapInfoItems(const InternalMapInfo* mapInfo)
+{
+	infoItems.emplace_back("description", "", mapInfo->description);
+	infoItems.emplace_back("author", "", mapInfo->author);
+	infoItems.emplace_back("tidalStrength", "", mapInfo->tidalStrength);
+	infoItems.emplace_back("gravity", "", mapInfo->gravity);
+	infoItems.emplace_back("maxMetal", "", mapInfo->maxMetal);
+	infoItems.emplace_back("extractorRadius", "", mapInfo->extractorRadius);
+	infoItems.emplace_back("minWind", "", mapInfo->minWind);
+	infoItems.emplace_back("maxWind", "", mapInfo->maxWind);
+	infoItems.emplace_back("width", "", mapInfo->width);
+	infoItems.emplace_back("height", "", mapInfo->height);
+	infoItems.emplace_back("resource", "", "Metal");
+	for (int i = 0; i < mapInfo->xPos.size() && i < mapInfo->zPos.size(); i++) {
+		infoItems.emplace_back("xPos", "", mapInfo->xPos[i]);
+		infoItems.emplace_back("zPos", "", mapInfo->zPos[i]);
+	}
+}
+
 EXPORT(int) GetMapInfoCount(int index) {
 	try{
 		infoItems.clear();
@@ -1467,21 +1642,42 @@ EXPORT(int) GetMapInfoCount(int index) {
 		if (mapInfo == nullptr)
 			return -1;
 
-		infoItems.emplace_back("description", "", mapInfo->description);
-		infoItems.emplace_back("author", "", mapInfo->author);
-		infoItems.emplace_back("tidalStrength", "", mapInfo->tidalStrength);
-		infoItems.emplace_back("gravity", "", mapInfo->gravity);
-		infoItems.emplace_back("maxMetal", "", mapInfo->maxMetal);
-		infoItems.emplace_back("extractorRadius", "", mapInfo->extractorRadius);
-		infoItems.emplace_back("minWind", "", mapInfo->minWind);
-		infoItems.emplace_back("maxWind", "", mapInfo->maxWind);
-		infoItems.emplace_back("width", "", mapInfo->width);
-		infoItems.emplace_back("height", "", mapInfo->height);
-		infoItems.emplace_back("resource", "", "Metal");
-		for (int i = 0; i < mapInfo->xPos.size() && i < mapInfo->zPos.size(); i++) {
-			infoItems.emplace_back("xPos", "", mapInfo->xPos[i]);
-			infoItems.emplace_back("zPos", "", mapInfo->zPos[i]);
+		AppendMapInfoItems(mapInfo);
+		return (int)infoItems.size();
+	}
+	UNITSYNC_CATCH_BLOCKS;
+
+	infoItems.clear();
+
+	return -1;
+}
+
+EXPORT(int) GetAllMapInfoCount() {
+	try{
+		CheckInit();
+
+		infoItems.clear();
+
+		// same as GetMapCount, callers need not have called it; indices
+		// may shift if maps were added, so also drop the per-index infos
+		internal_deleteMapInfos();
+		mapNames = archiveScanner->GetMaps();
+		std::sort(mapNames.begin(), mapNames.end());
+
+		for (int index = 0; index < mapNames.size(); index++) {
+			infoItems.emplace_back("name", "", mapNames[index]);
+
+			const InternalMapInfo* mapInfo = internal_getMapInfo(index);
+
+			if (mapInfo == nullptr) {
+				infoItems.emplace_back("error", "", "could not read map info");
+				continue;
+			}
+
+			infoItems.emplace_back("fileName", "", archiveScanner->MapNameToMapFile(mapNames[index]));
+			AppendMapInfoItems(mapInfo);
 		}
+
 		return (int)infoItems.size();
 	}
 	UNITSYNC_CATCH_BLOCKS;
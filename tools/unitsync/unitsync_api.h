@@ -245,6 +245,21 @@ EXPORT(int         ) GetMapCount();
  * Be sure to call GetMapCount() prior to using this function.
  */
 EXPORT(int         ) GetMapInfoCount(int index);
+/**
+ * @brief Retrieves the info items of all maps in one call
+ * @return negative integer (< 0) on error;
+ *   the total number of info items available (>= 0) on success
+ * @see GetMapInfoCount
+ * @see GetInfoKey
+ *
+ * Refreshes the map list like GetMapCount(), so map indices stay valid for
+ * the other map functions. Every map contributes a "name" item, followed by
+ * either an "error" item or a "fileName" item and the same items as returned
+ * by GetMapInfoCount(). Map info, minimaps and infomaps are cached on disk
+ * per map checksum, so only maps that are new or changed since the previous
+ * run need to be opened.
+ */
+EXPORT(int         ) GetAllMapInfoCount();
 /**
  * @brief Get the name of a map
  * @return NULL on error; the name of the map (e.g. "SmallDivide") on success